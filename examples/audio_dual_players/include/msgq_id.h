@@ -37,10 +37,10 @@
 #ifndef MSGQ_ID_H_INCLUDED
 #define MSGQ_ID_H_INCLUDED
 
-/* Message area size: 6072 bytes */
+/* Message area size: 6128 bytes */
 
 #define MSGQ_TOP_DRM 0xfd000
-#define MSGQ_END_DRM 0xfe7b8
+#define MSGQ_END_DRM 0xfe7f0
 
 /* Message area fill value after message poped */
 
@@ -71,104 +71,104 @@
 /* User defined constants */
 
 /************************************************************************/
-#define MSGQ_AUD_MGR_QUE_BLOCK_DRM 0xfd044
-#define MSGQ_AUD_MGR_N_QUE_DRM 0xfd3b8
+#define MSGQ_AUD_MGR_QUE_BLOCK_DRM 0xfd048
+#define MSGQ_AUD_MGR_N_QUE_DRM 0xfd3f0
 #define MSGQ_AUD_MGR_N_SIZE 88
 #define MSGQ_AUD_MGR_N_NUM 30
 #define MSGQ_AUD_MGR_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_MGR_H_SIZE 0
 #define MSGQ_AUD_MGR_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_APP_QUE_BLOCK_DRM 0xfd088
-#define MSGQ_AUD_APP_N_QUE_DRM 0xfde08
+#define MSGQ_AUD_APP_QUE_BLOCK_DRM 0xfd090
+#define MSGQ_AUD_APP_N_QUE_DRM 0xfde40
 #define MSGQ_AUD_APP_N_SIZE 64
 #define MSGQ_AUD_APP_N_NUM 2
 #define MSGQ_AUD_APP_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_APP_H_SIZE 0
 #define MSGQ_AUD_APP_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_DSP0_QUE_BLOCK_DRM 0xfd0cc
-#define MSGQ_AUD_DSP0_N_QUE_DRM 0xfde88
+#define MSGQ_AUD_DSP0_QUE_BLOCK_DRM 0xfd0d8
+#define MSGQ_AUD_DSP0_N_QUE_DRM 0xfdec0
 #define MSGQ_AUD_DSP0_N_SIZE 20
 #define MSGQ_AUD_DSP0_N_NUM 5
 #define MSGQ_AUD_DSP0_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_DSP0_H_SIZE 0
 #define MSGQ_AUD_DSP0_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_DSP1_QUE_BLOCK_DRM 0xfd110
-#define MSGQ_AUD_DSP1_N_QUE_DRM 0xfdeec
+#define MSGQ_AUD_DSP1_QUE_BLOCK_DRM 0xfd120
+#define MSGQ_AUD_DSP1_N_QUE_DRM 0xfdf24
 #define MSGQ_AUD_DSP1_N_SIZE 20
 #define MSGQ_AUD_DSP1_N_NUM 5
 #define MSGQ_AUD_DSP1_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_DSP1_H_SIZE 0
 #define MSGQ_AUD_DSP1_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_PLY0_QUE_BLOCK_DRM 0xfd154
-#define MSGQ_AUD_PLY0_N_QUE_DRM 0xfdf50
+#define MSGQ_AUD_PLY0_QUE_BLOCK_DRM 0xfd168
+#define MSGQ_AUD_PLY0_N_QUE_DRM 0xfdf88
 #define MSGQ_AUD_PLY0_N_SIZE 48
 #define MSGQ_AUD_PLY0_N_NUM 5
 #define MSGQ_AUD_PLY0_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_PLY0_H_SIZE 0
 #define MSGQ_AUD_PLY0_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_PFDSP0_QUE_BLOCK_DRM 0xfd198
-#define MSGQ_AUD_PFDSP0_N_QUE_DRM 0xfe040
+#define MSGQ_AUD_PFDSP0_QUE_BLOCK_DRM 0xfd1b0
+#define MSGQ_AUD_PFDSP0_N_QUE_DRM 0xfe078
 #define MSGQ_AUD_PFDSP0_N_SIZE 20
 #define MSGQ_AUD_PFDSP0_N_NUM 5
 #define MSGQ_AUD_PFDSP0_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_PFDSP0_H_SIZE 0
 #define MSGQ_AUD_PFDSP0_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_PFDSP1_QUE_BLOCK_DRM 0xfd1dc
-#define MSGQ_AUD_PFDSP1_N_QUE_DRM 0xfe0a4
+#define MSGQ_AUD_PFDSP1_QUE_BLOCK_DRM 0xfd1f8
+#define MSGQ_AUD_PFDSP1_N_QUE_DRM 0xfe0dc
 #define MSGQ_AUD_PFDSP1_N_SIZE 20
 #define MSGQ_AUD_PFDSP1_N_NUM 5
 #define MSGQ_AUD_PFDSP1_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_PFDSP1_H_SIZE 0
 #define MSGQ_AUD_PFDSP1_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_PLY1_QUE_BLOCK_DRM 0xfd220
-#define MSGQ_AUD_PLY1_N_QUE_DRM 0xfe108
+#define MSGQ_AUD_PLY1_QUE_BLOCK_DRM 0xfd240
+#define MSGQ_AUD_PLY1_N_QUE_DRM 0xfe140
 #define MSGQ_AUD_PLY1_N_SIZE 48
 #define MSGQ_AUD_PLY1_N_NUM 5
 #define MSGQ_AUD_PLY1_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_PLY1_H_SIZE 0
 #define MSGQ_AUD_PLY1_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_OUTPUT_MIX_QUE_BLOCK_DRM 0xfd264
-#define MSGQ_AUD_OUTPUT_MIX_N_QUE_DRM 0xfe1f8
+#define MSGQ_AUD_OUTPUT_MIX_QUE_BLOCK_DRM 0xfd288
+#define MSGQ_AUD_OUTPUT_MIX_N_QUE_DRM 0xfe230
 #define MSGQ_AUD_OUTPUT_MIX_N_SIZE 48
 #define MSGQ_AUD_OUTPUT_MIX_N_NUM 8
 #define MSGQ_AUD_OUTPUT_MIX_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_OUTPUT_MIX_H_SIZE 0
 #define MSGQ_AUD_OUTPUT_MIX_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_RND_PLY0_QUE_BLOCK_DRM 0xfd2a8
-#define MSGQ_AUD_RND_PLY0_N_QUE_DRM 0xfe378
+#define MSGQ_AUD_RND_PLY0_QUE_BLOCK_DRM 0xfd2d0
+#define MSGQ_AUD_RND_PLY0_N_QUE_DRM 0xfe3b0
 #define MSGQ_AUD_RND_PLY0_N_SIZE 32
 #define MSGQ_AUD_RND_PLY0_N_NUM 16
 #define MSGQ_AUD_RND_PLY0_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_RND_PLY0_H_SIZE 0
 #define MSGQ_AUD_RND_PLY0_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_RND_PLY0_SYNC_QUE_BLOCK_DRM 0xfd2ec
-#define MSGQ_AUD_RND_PLY0_SYNC_N_QUE_DRM 0xfe578
+#define MSGQ_AUD_RND_PLY0_SYNC_QUE_BLOCK_DRM 0xfd318
+#define MSGQ_AUD_RND_PLY0_SYNC_N_QUE_DRM 0xfe5b0
 #define MSGQ_AUD_RND_PLY0_SYNC_N_SIZE 16
 #define MSGQ_AUD_RND_PLY0_SYNC_N_NUM 2
 #define MSGQ_AUD_RND_PLY0_SYNC_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_RND_PLY0_SYNC_H_SIZE 0
 #define MSGQ_AUD_RND_PLY0_SYNC_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_RND_PLY1_QUE_BLOCK_DRM 0xfd330
-#define MSGQ_AUD_RND_PLY1_N_QUE_DRM 0xfe598
+#define MSGQ_AUD_RND_PLY1_QUE_BLOCK_DRM 0xfd360
+#define MSGQ_AUD_RND_PLY1_N_QUE_DRM 0xfe5d0
 #define MSGQ_AUD_RND_PLY1_N_SIZE 32
 #define MSGQ_AUD_RND_PLY1_N_NUM 16
 #define MSGQ_AUD_RND_PLY1_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_RND_PLY1_H_SIZE 0
 #define MSGQ_AUD_RND_PLY1_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_RND_PLY1_SYNC_QUE_BLOCK_DRM 0xfd374
-#define MSGQ_AUD_RND_PLY1_SYNC_N_QUE_DRM 0xfe798
+#define MSGQ_AUD_RND_PLY1_SYNC_QUE_BLOCK_DRM 0xfd3a8
+#define MSGQ_AUD_RND_PLY1_SYNC_N_QUE_DRM 0xfe7d0
 #define MSGQ_AUD_RND_PLY1_SYNC_N_SIZE 16
 #define MSGQ_AUD_RND_PLY1_SYNC_N_NUM 2
 #define MSGQ_AUD_RND_PLY1_SYNC_H_QUE_DRM 0xffffffff
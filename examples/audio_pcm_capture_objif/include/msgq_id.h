@@ -37,9 +37,9 @@
 #ifndef MSGQ_ID_H_INCLUDED
 #define MSGQ_ID_H_INCLUDED
 
-/* Message area size: 6256 bytes */
+/* Message area size: 6284 bytes */
 #define MSGQ_TOP_DRM 0xfd000
-#define MSGQ_END_DRM 0xfe870
+#define MSGQ_END_DRM 0xfe88c
 
 /* Message area fill value after message poped */
 #define MSG_FILL_VALUE_AFTER_POP 0x0
@@ -60,48 +60,48 @@
 /* User defined constants */
 
 /************************************************************************/
-#define MSGQ_AUD_APP_QUE_BLOCK_DRM 0xfd044
-#define MSGQ_AUD_APP_N_QUE_DRM 0xfd1dc
+#define MSGQ_AUD_APP_QUE_BLOCK_DRM 0xfd048
+#define MSGQ_AUD_APP_N_QUE_DRM 0xfd1f8
 #define MSGQ_AUD_APP_N_SIZE 64
 #define MSGQ_AUD_APP_N_NUM 32
 #define MSGQ_AUD_APP_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_APP_H_SIZE 0
 #define MSGQ_AUD_APP_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_MGR_QUE_BLOCK_DRM 0xfd088
-#define MSGQ_AUD_MGR_N_QUE_DRM 0xfd9dc
+#define MSGQ_AUD_MGR_QUE_BLOCK_DRM 0xfd090
+#define MSGQ_AUD_MGR_N_QUE_DRM 0xfd9f8
 #define MSGQ_AUD_MGR_N_SIZE 88
 #define MSGQ_AUD_MGR_N_NUM 30
 #define MSGQ_AUD_MGR_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_MGR_H_SIZE 0
 #define MSGQ_AUD_MGR_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_CAP_QUE_BLOCK_DRM 0xfd0cc
-#define MSGQ_AUD_CAP_N_QUE_DRM 0xfe42c
+#define MSGQ_AUD_CAP_QUE_BLOCK_DRM 0xfd0d8
+#define MSGQ_AUD_CAP_N_QUE_DRM 0xfe448
 #define MSGQ_AUD_CAP_N_SIZE 24
 #define MSGQ_AUD_CAP_N_NUM 16
 #define MSGQ_AUD_CAP_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_CAP_H_SIZE 0
 #define MSGQ_AUD_CAP_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_CAP_SYNC_QUE_BLOCK_DRM 0xfd110
-#define MSGQ_AUD_CAP_SYNC_N_QUE_DRM 0xfe5ac
+#define MSGQ_AUD_CAP_SYNC_QUE_BLOCK_DRM 0xfd120
+#define MSGQ_AUD_CAP_SYNC_N_QUE_DRM 0xfe5c8
 #define MSGQ_AUD_CAP_SYNC_N_SIZE 16
 #define MSGQ_AUD_CAP_SYNC_N_NUM 8
 #define MSGQ_AUD_CAP_SYNC_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_CAP_SYNC_H_SIZE 0
 #define MSGQ_AUD_CAP_SYNC_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_FRONTEND_QUE_BLOCK_DRM 0xfd154
-#define MSGQ_AUD_FRONTEND_N_QUE_DRM 0xfe62c
+#define MSGQ_AUD_FRONTEND_QUE_BLOCK_DRM 0xfd168
+#define MSGQ_AUD_FRONTEND_N_QUE_DRM 0xfe648
 #define MSGQ_AUD_FRONTEND_N_SIZE 48
 #define MSGQ_AUD_FRONTEND_N_NUM 10
 #define MSGQ_AUD_FRONTEND_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_FRONTEND_H_SIZE 0
 #define MSGQ_AUD_FRONTEND_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_PREDSP_QUE_BLOCK_DRM 0xfd198
-#define MSGQ_AUD_PREDSP_N_QUE_DRM 0xfe80c
+#define MSGQ_AUD_PREDSP_QUE_BLOCK_DRM 0xfd1b0
+#define MSGQ_AUD_PREDSP_N_QUE_DRM 0xfe828
 #define MSGQ_AUD_PREDSP_N_SIZE 20
 #define MSGQ_AUD_PREDSP_N_NUM 5
 #define MSGQ_AUD_PREDSP_H_QUE_DRM 0xffffffff
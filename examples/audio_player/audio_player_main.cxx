@@ -43,6 +43,7 @@
 #include <fcntl.h>
 #include <time.h>
 #include <errno.h>
+#include <unistd.h>
 #include <asmp/mpshm.h>
 #include <arch/chip/pm.h>
 #include <arch/board/board.h>
@@ -60,6 +61,7 @@
 #ifdef CONFIG_AUDIOUTILS_PLAYLIST
 #include <audio/utilities/playlist.h>
 #endif
+#include <audio/utilities/player_file_source.h>
 #ifdef CONFIG_EXAMPLES_AUDIO_PLAYER_USEPOSTPROC
 #include "userproc_command.h"
 #endif /* CONFIG_EXAMPLES_AUDIO_PLAYER_USEPOSTPROC */
@@ -133,13 +135,20 @@ using namespace MemMgrLite;
 
 #define FIFO_ELEMENT_NUM  10
 
-/* The number of elements pushed to the FIFO Queue at a time depends
- * on the load of the system. If the number of elements is small,
- * we will underflow if application dispatching is delayed.
- * Define a sufficient maximum value.
+/* Priority and stack size of the thread which reads the file into
+ * the FIFO. The priority should be higher than the application.
  */
 
-#define PLAYER_FIFO_PUSH_NUM_MAX  5
+#define PLAYER_FILE_SOURCE_PRIORITY    PlayerFileSource::DefaultPriority
+#define PLAYER_FILE_SOURCE_STACK_SIZE  PlayerFileSource::DefaultStackSize
+
+/* Interval to check the play time and the end of file. */
+
+#define PLAYER_PROCESS_WAIT_MS  100
+
+/* Interval to switch the postprocess setting, in the play process. */
+
+#define PLAYER_POSTPROC_INTERVAL_MS  200
 
 /* Definition of content information to be used when not using playlist. */
 
@@ -184,13 +193,6 @@ using namespace MemMgrLite;
 #define FIFO_ELEMENT_SIZE  (FIFO_FRAME_SIZE * FIFO_FRAME_NUM)
 #define FIFO_QUEUE_SIZE    (FIFO_ELEMENT_SIZE * FIFO_ELEMENT_NUM)
 
-/* Local error code. */
-
-#define FIFO_RESULT_OK  0
-#define FIFO_RESULT_ERR 1
-#define FIFO_RESULT_EOF 2
-#define FIFO_RESULT_FUL 3
-
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -199,10 +201,8 @@ using namespace MemMgrLite;
 
 struct player_fifo_info_s
 {
-  CMN_SimpleFifoHandle          handle;
-  AsPlayerInputDeviceHdlrForRAM input_device;
+  PlayerFileSource source;
   uint32_t fifo_area[FIFO_QUEUE_SIZE/sizeof(uint32_t)];
-  uint8_t  read_buf[FIFO_ELEMENT_SIZE];
 };
 
 #ifndef CONFIG_AUDIOUTILS_PLAYLIST
@@ -388,92 +388,27 @@ static bool app_get_next_track(Track* track)
   return ret;
 }
 
-static void app_input_device_callback(uint32_t size)
-{
-    /* do nothing */
-}
-
 static bool app_init_simple_fifo(void)
 {
-  if (CMN_SimpleFifoInitialize(&s_player_info.fifo.handle,
-                               s_player_info.fifo.fifo_area,
-                               FIFO_QUEUE_SIZE,
-                               NULL) != 0)
-    {
-      printf("Error: Fail to initialize simple FIFO.");
-      return false;
-    }
-  CMN_SimpleFifoClear(&s_player_info.fifo.handle);
-
-  s_player_info.fifo.input_device.simple_fifo_handler = (void*)(&s_player_info.fifo.handle);
-  s_player_info.fifo.input_device.callback_function = app_input_device_callback;
-
-  return true;
-}
-
-static int app_push_simple_fifo(int fd)
-{
-  int ret;
-
-  ret = read(fd, &s_player_info.fifo.read_buf, FIFO_ELEMENT_SIZE);
-  if (ret < 0)
-    {
-      printf("Error: Fail to read file. errno:%d\n", get_errno());
-      return FIFO_RESULT_ERR;
-    }
-
-  if (CMN_SimpleFifoOffer(&s_player_info.fifo.handle, (const void*)(s_player_info.fifo.read_buf), ret) == 0)
-    {
-      return FIFO_RESULT_FUL;
-    }
-  s_player_info.file.size = (s_player_info.file.size - ret);
-  if (s_player_info.file.size == 0)
-    {
-      return FIFO_RESULT_EOF;
-    }
-  return FIFO_RESULT_OK;
-}
-
-static bool app_first_push_simple_fifo(int fd)
-{
-  int i;
-  int ret = 0;
-
-  for(i = 0; i < FIFO_ELEMENT_NUM - 1; i++)
-    {
-      if ((ret = app_push_simple_fifo(fd)) != FIFO_RESULT_OK)
-        {
-          break;
-        }
-    }
-
-  return (ret != FIFO_RESULT_ERR) ? true : false;
-}
+  /* The file source reads the file into the FIFO by its own thread,
+   * one element at a time.
+   */
 
-static bool app_refill_simple_fifo(int fd)
-{
-  int32_t ret = FIFO_RESULT_OK;
-  size_t  vacant_size;
+  PlayerFileSource::Param param;
 
-  vacant_size = CMN_SimpleFifoGetVacantSize(&s_player_info.fifo.handle);
+  param.buffer      = s_player_info.fifo.fifo_area;
+  param.buffer_size = FIFO_QUEUE_SIZE;
+  param.read_size   = FIFO_ELEMENT_SIZE;
+  param.priority    = PLAYER_FILE_SOURCE_PRIORITY;
+  param.stack_size  = PLAYER_FILE_SOURCE_STACK_SIZE;
 
-  if ((vacant_size != 0) && (vacant_size > FIFO_ELEMENT_SIZE))
+  if (!s_player_info.fifo.source.init(param))
     {
-      int push_cnt = vacant_size / FIFO_ELEMENT_SIZE;
-
-      push_cnt = (push_cnt >= PLAYER_FIFO_PUSH_NUM_MAX) ?
-                  PLAYER_FIFO_PUSH_NUM_MAX : push_cnt;
-
-      for (int i = 0; i < push_cnt; i++)
-        {
-          if ((ret = app_push_simple_fifo(fd)) != FIFO_RESULT_OK)
-            {
-              break;
-            }
-        }
+      printf("Error: Fail to initialize file source.\n");
+      return false;
     }
 
-  return (ret == FIFO_RESULT_OK) ? true : false;
+  return true;
 }
 
 static bool printAudCmdResult(uint8_t command_code, AudioResult& result)
@@ -684,7 +619,8 @@ static bool app_set_player_status(void)
     command.header.sub_code = 0x00;
     command.set_player_sts_param.active_player         = AS_ACTPLAYER_MAIN;
     command.set_player_sts_param.player0.input_device  = AS_SETPLAYER_INPUTDEVICE_RAM;
-    command.set_player_sts_param.player0.ram_handler   = &s_player_info.fifo.input_device;
+    command.set_player_sts_param.player0.ram_handler   =
+      s_player_info.fifo.source.getInputDeviceHdlr();
     command.set_player_sts_param.player0.output_device = PLAYER_OUTPUT_DEV;
 #ifdef CONFIG_EXAMPLES_AUDIO_PLAYER_USEPOSTPROC
     command.set_player_sts_param.post0_enable          = PostFilterEnable;
@@ -969,12 +905,12 @@ static bool app_open_next_play_file(void)
       return false;
     }
 
-  /* Push data to simple fifo */
+  /* Start to read the file. The FIFO is filled before return. */
 
-  if (!app_first_push_simple_fifo(s_player_info.file.fd))
+  if (!s_player_info.fifo.source.open(s_player_info.file.fd))
     {
-      printf("Error: app_first_push_simple_fifo() failure.\n");
-      CMN_SimpleFifoClear(&s_player_info.fifo.handle);
+      printf("Error: Fail to read %s.\n", full_path);
+      s_player_info.fifo.source.close();
       close(s_player_info.file.fd);
       return false;
     }
@@ -984,14 +920,14 @@ static bool app_open_next_play_file(void)
 
 static bool app_close_play_file(void)
 {
+  s_player_info.fifo.source.close();
+
   if (close(s_player_info.file.fd) != 0)
     {
       printf("Error: close() failure.\n");
       return false;
     }
 
-  CMN_SimpleFifoClear(&s_player_info.fifo.handle);
-
   return true;
 }
 
@@ -1032,7 +968,8 @@ static bool app_stop(void)
    * Otherwise, stop immediate reproduction.(select AS_STOPPLAYER_NORMAL)
    */
 
-  int  stop_mode = (s_player_info.file.size != 0) ?
+  int  stop_mode = (!s_player_info.fifo.source.isEof() ||
+                   s_player_info.fifo.source.hasError()) ?
                     AS_STOPPLAYER_NORMAL : AS_STOPPLAYER_ESEND;
 
   if (!app_stop_player(stop_mode))
@@ -1060,17 +997,20 @@ void app_play_process(uint32_t play_time)
 
   do
     {
-      /* Check the FIFO every 2 ms and fill if there is space. */
+      /* The FIFO is filled by the file source.
+       * Stop when the whole file is read.
+       */
 
-      usleep(2 * 1000);
-      if (!app_refill_simple_fifo(s_player_info.file.fd))
+      if (s_player_info.fifo.source.isEof())
         {
           break;
         }
 
+      usleep(PLAYER_PROCESS_WAIT_MS * 1000);
+
 #ifdef CONFIG_EXAMPLES_AUDIO_PLAYER_USEPOSTPROC
       static int cnt = 0;
-      if (cnt++ > 100)
+      if (++cnt >= PLAYER_POSTPROC_INTERVAL_MS / PLAYER_PROCESS_WAIT_MS)
         {
           app_send_setpostproc_command();
           cnt = 0;
@@ -1355,6 +1295,8 @@ errout_set_ready_status:
 errout_set_clkmode:
 errout_set_player_status:
 errout_amp_mute_control:
+  s_player_info.fifo.source.deinit();
+
   if (AS_MNG_STATUS_READY != app_get_status())
     {
       if (!app_set_ready())
@@ -37,10 +37,10 @@
 #ifndef MSGQ_ID_H_INCLUDED
 #define MSGQ_ID_H_INCLUDED
 
-/* Message area size: 6096 bytes */
+/* Message area size: 6148 bytes */
 
 #define MSGQ_TOP_DRM 0xfd000
-#define MSGQ_END_DRM 0xfe7d0
+#define MSGQ_END_DRM 0xfe804
 
 /* Message area fill value after message poped */
 
@@ -70,96 +70,96 @@
 /* User defined constants */
 
 /************************************************************************/
-#define MSGQ_AUD_MNG_QUE_BLOCK_DRM 0xfd044
-#define MSGQ_AUD_MNG_N_QUE_DRM 0xfd374
+#define MSGQ_AUD_MNG_QUE_BLOCK_DRM 0xfd048
+#define MSGQ_AUD_MNG_N_QUE_DRM 0xfd3a8
 #define MSGQ_AUD_MNG_N_SIZE 88
 #define MSGQ_AUD_MNG_N_NUM 30
 #define MSGQ_AUD_MNG_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_MNG_H_SIZE 0
 #define MSGQ_AUD_MNG_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_APP_QUE_BLOCK_DRM 0xfd088
-#define MSGQ_AUD_APP_N_QUE_DRM 0xfddc4
+#define MSGQ_AUD_APP_QUE_BLOCK_DRM 0xfd090
+#define MSGQ_AUD_APP_N_QUE_DRM 0xfddf8
 #define MSGQ_AUD_APP_N_SIZE 64
 #define MSGQ_AUD_APP_N_NUM 2
 #define MSGQ_AUD_APP_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_APP_H_SIZE 0
 #define MSGQ_AUD_APP_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_DSP_QUE_BLOCK_DRM 0xfd0cc
-#define MSGQ_AUD_DSP_N_QUE_DRM 0xfde44
+#define MSGQ_AUD_DSP_QUE_BLOCK_DRM 0xfd0d8
+#define MSGQ_AUD_DSP_N_QUE_DRM 0xfde78
 #define MSGQ_AUD_DSP_N_SIZE 20
 #define MSGQ_AUD_DSP_N_NUM 5
 #define MSGQ_AUD_DSP_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_DSP_H_SIZE 0
 #define MSGQ_AUD_DSP_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_PFDSP0_QUE_BLOCK_DRM 0xfd110
-#define MSGQ_AUD_PFDSP0_N_QUE_DRM 0xfdea8
+#define MSGQ_AUD_PFDSP0_QUE_BLOCK_DRM 0xfd120
+#define MSGQ_AUD_PFDSP0_N_QUE_DRM 0xfdedc
 #define MSGQ_AUD_PFDSP0_N_SIZE 20
 #define MSGQ_AUD_PFDSP0_N_NUM 5
 #define MSGQ_AUD_PFDSP0_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_PFDSP0_H_SIZE 0
 #define MSGQ_AUD_PFDSP0_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_PFDSP1_QUE_BLOCK_DRM 0xfd154
-#define MSGQ_AUD_PFDSP1_N_QUE_DRM 0xfdf0c
+#define MSGQ_AUD_PFDSP1_QUE_BLOCK_DRM 0xfd168
+#define MSGQ_AUD_PFDSP1_N_QUE_DRM 0xfdf40
 #define MSGQ_AUD_PFDSP1_N_SIZE 20
 #define MSGQ_AUD_PFDSP1_N_NUM 5
 #define MSGQ_AUD_PFDSP1_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_PFDSP1_H_SIZE 0
 #define MSGQ_AUD_PFDSP1_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_PLY0_QUE_BLOCK_DRM 0xfd198
-#define MSGQ_AUD_PLY0_N_QUE_DRM 0xfdf70
+#define MSGQ_AUD_PLY0_QUE_BLOCK_DRM 0xfd1b0
+#define MSGQ_AUD_PLY0_N_QUE_DRM 0xfdfa4
 #define MSGQ_AUD_PLY0_N_SIZE 48
 #define MSGQ_AUD_PLY0_N_NUM 5
 #define MSGQ_AUD_PLY0_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_PLY0_H_SIZE 0
 #define MSGQ_AUD_PLY0_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_PLY1_QUE_BLOCK_DRM 0xfd1dc
-#define MSGQ_AUD_PLY1_N_QUE_DRM 0xfe060
+#define MSGQ_AUD_PLY1_QUE_BLOCK_DRM 0xfd1f8
+#define MSGQ_AUD_PLY1_N_QUE_DRM 0xfe094
 #define MSGQ_AUD_PLY1_N_SIZE 48
 #define MSGQ_AUD_PLY1_N_NUM 5
 #define MSGQ_AUD_PLY1_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_PLY1_H_SIZE 0
 #define MSGQ_AUD_PLY1_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_OUTPUT_MIX_QUE_BLOCK_DRM 0xfd220
-#define MSGQ_AUD_OUTPUT_MIX_N_QUE_DRM 0xfe150
+#define MSGQ_AUD_OUTPUT_MIX_QUE_BLOCK_DRM 0xfd240
+#define MSGQ_AUD_OUTPUT_MIX_N_QUE_DRM 0xfe184
 #define MSGQ_AUD_OUTPUT_MIX_N_SIZE 48
 #define MSGQ_AUD_OUTPUT_MIX_N_NUM 8
 #define MSGQ_AUD_OUTPUT_MIX_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_OUTPUT_MIX_H_SIZE 0
 #define MSGQ_AUD_OUTPUT_MIX_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_RND_PLY0_QUE_BLOCK_DRM 0xfd264
-#define MSGQ_AUD_RND_PLY0_N_QUE_DRM 0xfe2d0
+#define MSGQ_AUD_RND_PLY0_QUE_BLOCK_DRM 0xfd288
+#define MSGQ_AUD_RND_PLY0_N_QUE_DRM 0xfe304
 #define MSGQ_AUD_RND_PLY0_N_SIZE 32
 #define MSGQ_AUD_RND_PLY0_N_NUM 16
 #define MSGQ_AUD_RND_PLY0_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_RND_PLY0_H_SIZE 0
 #define MSGQ_AUD_RND_PLY0_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_RND_PLY0_SYNC_QUE_BLOCK_DRM 0xfd2a8
-#define MSGQ_AUD_RND_PLY0_SYNC_N_QUE_DRM 0xfe4d0
+#define MSGQ_AUD_RND_PLY0_SYNC_QUE_BLOCK_DRM 0xfd2d0
+#define MSGQ_AUD_RND_PLY0_SYNC_N_QUE_DRM 0xfe504
 #define MSGQ_AUD_RND_PLY0_SYNC_N_SIZE 16
 #define MSGQ_AUD_RND_PLY0_SYNC_N_NUM 8
 #define MSGQ_AUD_RND_PLY0_SYNC_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_RND_PLY0_SYNC_H_SIZE 0
 #define MSGQ_AUD_RND_PLY0_SYNC_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_RND_PLY1_QUE_BLOCK_DRM 0xfd2ec
-#define MSGQ_AUD_RND_PLY1_N_QUE_DRM 0xfe550
+#define MSGQ_AUD_RND_PLY1_QUE_BLOCK_DRM 0xfd318
+#define MSGQ_AUD_RND_PLY1_N_QUE_DRM 0xfe584
 #define MSGQ_AUD_RND_PLY1_N_SIZE 32
 #define MSGQ_AUD_RND_PLY1_N_NUM 16
 #define MSGQ_AUD_RND_PLY1_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_RND_PLY1_H_SIZE 0
 #define MSGQ_AUD_RND_PLY1_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_RND_PLY1_SYNC_QUE_BLOCK_DRM 0xfd330
-#define MSGQ_AUD_RND_PLY1_SYNC_N_QUE_DRM 0xfe750
+#define MSGQ_AUD_RND_PLY1_SYNC_QUE_BLOCK_DRM 0xfd360
+#define MSGQ_AUD_RND_PLY1_SYNC_N_QUE_DRM 0xfe784
 #define MSGQ_AUD_RND_PLY1_SYNC_N_SIZE 16
 #define MSGQ_AUD_RND_PLY1_SYNC_N_NUM 8
 #define MSGQ_AUD_RND_PLY1_SYNC_H_QUE_DRM 0xffffffff
@@ -42,14 +42,14 @@
 extern const MsgQueDef MsgqPoolDefs[NUM_MSGQ_POOLS] = {
    /* n_drm, n_size, n_num, h_drm, h_size, h_num */
   { 0x00000000, 0, 0, 0x00000000, 0, 0, 0 }, /* MSGQ_NULL */
-  { 0xfd264, 64, 2, 0xffffffff, 0, 0 }, /* MSGQ_AUD_APP */
-  { 0xfd2e4, 88, 30, 0xffffffff, 0, 0 }, /* MSGQ_AUD_MNG */
-  { 0xfdd34, 48, 10, 0xffffffff, 0, 0 }, /* MSGQ_AUD_FRONTEND */
-  { 0xfdf14, 48, 5, 0xffffffff, 0, 0 }, /* MSGQ_AUD_RECOGNIZER */
-  { 0xfe004, 24, 16, 0xffffffff, 0, 0 }, /* MSGQ_AUD_CAP */
-  { 0xfe184, 16, 8, 0xffffffff, 0, 0 }, /* MSGQ_AUD_CAP_SYNC */
-  { 0xfe204, 20, 5, 0xffffffff, 0, 0 }, /* MSGQ_AUD_PREDSP */
-  { 0xfe268, 20, 5, 0xffffffff, 0, 0 }, /* MSGQ_AUD_RCGDSP */
+  { 0xfd288, 64, 2, 0xffffffff, 0, 0 }, /* MSGQ_AUD_APP */
+  { 0xfd308, 88, 30, 0xffffffff, 0, 0 }, /* MSGQ_AUD_MNG */
+  { 0xfdd58, 48, 10, 0xffffffff, 0, 0 }, /* MSGQ_AUD_FRONTEND */
+  { 0xfdf38, 48, 5, 0xffffffff, 0, 0 }, /* MSGQ_AUD_RECOGNIZER */
+  { 0xfe028, 24, 16, 0xffffffff, 0, 0 }, /* MSGQ_AUD_CAP */
+  { 0xfe1a8, 16, 8, 0xffffffff, 0, 0 }, /* MSGQ_AUD_CAP_SYNC */
+  { 0xfe228, 20, 5, 0xffffffff, 0, 0 }, /* MSGQ_AUD_PREDSP */
+  { 0xfe28c, 20, 5, 0xffffffff, 0, 0 }, /* MSGQ_AUD_RCGDSP */
 };
 
 #endif /* MSGQ_POOL_H_INCLUDED */
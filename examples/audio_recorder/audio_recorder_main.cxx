@@ -45,6 +45,7 @@
 #include <fcntl.h>
 #include <time.h>
 #include <errno.h>
+#include <unistd.h>
 #include <asmp/mpshm.h>
 #include <sys/stat.h>
 
@@ -54,6 +55,7 @@
 #include "memutils/message/Message.h"
 #include "audio/audio_high_level_api.h"
 #include <audio/utilities/wav_containerformat.h>
+#include <audio/utilities/recorder_file_sink.h>
 #include <audio/utilities/frame_samples.h>
 #include "include/msgq_id.h"
 #include "include/mem_layout.h"
@@ -97,9 +99,16 @@ using namespace MemMgrLite;
 #define SIMPLE_FIFO_FRAME_NUM 60
 #define SIMPLE_FIFO_BUF_SIZE  (READ_SIMPLE_FIFO_SIZE * SIMPLE_FIFO_FRAME_NUM)
 
-/* For line buffer mode. */
+/* Size of one write to the recording file, and the number of writes
+ * between the updates of WAV header.
+ */
+
+#define RECFILE_WRITE_SIZE       RecorderFileSink::DefaultWriteSize
+#define RECFILE_HEADER_INTERVAL  RecorderFileSink::DefaultHeaderInterval
 
-#define STDIO_BUFFER_SIZE 4096
+/* Interval to check the recording time. */
+
+#define RECORDER_PROCESS_WAIT_MS  100
 
 /* Length of recording file name */
 
@@ -121,10 +130,8 @@ using namespace MemMgrLite;
 
 struct recorder_fifo_info_s
 {
-  CMN_SimpleFifoHandle        handle;
-  AsRecorderOutputDeviceHdlr  output_device;
+  RecorderFileSink sink;
   uint32_t fifo_area[SIMPLE_FIFO_BUF_SIZE/sizeof(uint32_t)];
-  uint8_t  write_buf[READ_SIMPLE_FIFO_SIZE];
 };
 
 struct recorder_file_info_s
@@ -134,9 +141,8 @@ struct recorder_file_info_s
   uint8_t   bitwidth;
   uint8_t   codec_type;
   uint16_t  format_type;
-  uint32_t  size;
   DIR      *dirp;
-  FILE     *fd;
+  int       fd;
 };
 
 struct recorder_info_s
@@ -207,50 +213,10 @@ static recorder_info_s s_recorder_info;
 static mpshm_t s_shm;
 
 static WavContainerFormat* s_container_format = NULL;
-static WAVHEADER  s_wav_header;
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
-static void outputDeviceCallback(uint32_t size)
-{
-    /* do nothing */
-}
-
-static bool app_update_wav_file_size(void)
-{
-  fseek(s_recorder_info.file.fd, 0, SEEK_SET);
-
-  s_container_format->getHeader(&s_wav_header, s_recorder_info.file.size);
-
-  size_t ret = fwrite((const void *)&s_wav_header,
-                      1,
-                      sizeof(WAVHEADER),
-                      s_recorder_info.file.fd);
-  if (ret != sizeof(WAVHEADER))
-    {
-      printf("Fail to write file(wav header)\n");
-      return false;
-    }
-  return true;
-}
-
-static bool app_write_wav_header(void)
-{
-  s_container_format->getHeader(&s_wav_header, 0);
-
-  size_t ret = fwrite((const void *)&s_wav_header,
-                      1,
-                      sizeof(WAVHEADER),
-                      s_recorder_info.file.fd);
-  if (ret != sizeof(WAVHEADER))
-    {
-      printf("Fail to write file(wav header)\n");
-      return false;
-    }
-  return true;
-}
-
 static bool app_init_wav_header(void)
 {
   return s_container_format->init(FORMAT_ID_PCM,
@@ -324,94 +290,95 @@ static bool app_open_output_file(void)
       return false;
     }
 
-  s_recorder_info.file.fd = fopen(fname, "w");
-  if (s_recorder_info.file.fd == 0)
+  s_recorder_info.file.fd = open(fname, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (s_recorder_info.file.fd < 0)
     {
       printf("open err(%s)\n", fname);
       return false;
     }
-  setvbuf(s_recorder_info.file.fd, NULL, _IOLBF, STDIO_BUFFER_SIZE);
   printf("Record data to %s.\n", &fname[0]);
 
+  WavContainerFormat *container = NULL;
+
   if (s_recorder_info.file.format_type == FORMAT_TYPE_WAV)
     {
       if (!app_init_wav_header())
       {
         printf("Error: app_init_wav_header() failure.\n");
+        close(s_recorder_info.file.fd);
         return false;
       }
 
-      if (!app_write_wav_header())
-      {
-        printf("Error: app_write_wav_header() failure.\n");
-        return false;
-      }
+      container = s_container_format;
   }
-  return true;
-}
 
-static void app_close_output_file(void)
-{
-  fclose(s_recorder_info.file.fd);
-}
+  /* The size of LPCM is known in advance. Allocate the file not to
+   * search free clusters while recording.
+   */
 
-static void app_write_output_file(uint32_t size)
-{
-  ssize_t ret;
+  uint32_t prealloc_size = 0;
 
-  if (size == 0 || CMN_SimpleFifoGetOccupiedSize(&s_recorder_info.fifo.handle) == 0)
+  if (s_recorder_info.file.codec_type == AS_CODECTYPE_LPCM)
     {
-      return;
+      prealloc_size = s_recorder_info.file.sampling_rate *
+                      s_recorder_info.file.channel_number *
+                      (s_recorder_info.file.bitwidth / 8) *
+                      RECORDER_REC_TIME;
     }
 
-  if (CMN_SimpleFifoPoll(&s_recorder_info.fifo.handle,
-                        (void*)s_recorder_info.fifo.write_buf,
-                        size) == 0)
+  if (!s_recorder_info.fifo.sink.open(s_recorder_info.file.fd,
+                                      container,
+                                      prealloc_size))
     {
-      printf("ERROR: Fail to get data from simple FIFO.\n");
-      return;
+      printf("Error: Fail to prepare %s.\n", fname);
+      close(s_recorder_info.file.fd);
+      return false;
     }
 
-  ret = fwrite(s_recorder_info.fifo.write_buf, 1, size, s_recorder_info.file.fd);
-  if (ret < 0) {
-    printf("ERROR: Cannot write recorded data to output file.\n");
-    app_close_output_file();
-    return;
-  }
-  s_recorder_info.file.size += size;
+  return true;
 }
 
-static bool app_init_simple_fifo(void)
+static void app_close_output_file(void)
 {
-  if (CMN_SimpleFifoInitialize(&s_recorder_info.fifo.handle,
-                               s_recorder_info.fifo.fifo_area,
-                               SIMPLE_FIFO_BUF_SIZE, NULL) != 0)
+  RecorderFileSink::Stats stats;
+
+  if (!s_recorder_info.fifo.sink.close())
     {
-      printf("Error: Fail to initialize simple FIFO.");
-      return false;
+      printf("ERROR: Cannot write recorded data to output file.\n");
     }
-  CMN_SimpleFifoClear(&s_recorder_info.fifo.handle);
 
-  s_recorder_info.fifo.output_device.simple_fifo_handler =
-    (void*)(&s_recorder_info.fifo.handle);
-  s_recorder_info.fifo.output_device.callback_function = outputDeviceCallback;
+  s_recorder_info.fifo.sink.getStats(&stats);
+  printf("Wrote %u bytes: %u writes, %u bytes/sec, max %u us\n",
+         s_recorder_info.fifo.sink.getDataSize(),
+         stats.write_count,
+         stats.bandwidth,
+         stats.max_write_time_us);
 
-  return true;
+  close(s_recorder_info.file.fd);
 }
 
-static void app_pop_simple_fifo(void)
+static bool app_init_simple_fifo(void)
 {
-  size_t occupied_simple_fifo_size =
-    CMN_SimpleFifoGetOccupiedSize(&s_recorder_info.fifo.handle);
-  uint32_t output_size = 0;
+  /* The file sink writes the data in the FIFO to the file by its own
+   * thread.
+   */
+
+  RecorderFileSink::Param param;
 
-  while (occupied_simple_fifo_size > 0)
+  param.buffer          = s_recorder_info.fifo.fifo_area;
+  param.buffer_size     = SIMPLE_FIFO_BUF_SIZE;
+  param.write_size      = RECFILE_WRITE_SIZE;
+  param.header_interval = RECFILE_HEADER_INTERVAL;
+  param.priority        = RecorderFileSink::DefaultPriority;
+  param.stack_size      = RecorderFileSink::DefaultStackSize;
+
+  if (!s_recorder_info.fifo.sink.init(param))
     {
-      output_size = (occupied_simple_fifo_size > READ_SIMPLE_FIFO_SIZE) ?
-        READ_SIMPLE_FIFO_SIZE : occupied_simple_fifo_size;
-      app_write_output_file(output_size);
-      occupied_simple_fifo_size -= output_size;
+      printf("Error: Fail to initialize file sink.\n");
+      return false;
     }
+
+  return true;
 }
 
 static bool printAudCmdResult(uint8_t command_code, AudioResult& result)
@@ -669,7 +636,8 @@ static bool app_set_recorder_status(void)
   command.set_recorder_status_param.input_device          = AS_SETRECDR_STS_INPUTDEVICE_MIC;
   command.set_recorder_status_param.input_device_handler  = 0x00;
   command.set_recorder_status_param.output_device         = AS_SETRECDR_STS_OUTPUTDEVICE_RAM;
-  command.set_recorder_status_param.output_device_handler = &s_recorder_info.fifo.output_device;
+  command.set_recorder_status_param.output_device_handler =
+    s_recorder_info.fifo.sink.getOutputDeviceHdlr();
   AS_SendAudioCommand(&command);
 
   AudioResult result;
@@ -769,12 +737,10 @@ static bool app_init_recorder(codec_type_e codec_type,
 
 static bool app_start_recorder(void)
 {
-  s_recorder_info.file.size = 0;
   if (!app_open_output_file())
     {
       return false;
     }
-  CMN_SimpleFifoClear(&s_recorder_info.fifo.handle);
 
   AudioCommand command;
   command.header.packet_length = LENGTH_START_RECORDER;
@@ -802,24 +768,7 @@ static bool app_stop_recorder(void)
       return false;
     }
 
-  size_t occupied_simple_fifo_size = CMN_SimpleFifoGetOccupiedSize(&s_recorder_info.fifo.handle);
-  uint32_t output_size = 0;
-
-  while (occupied_simple_fifo_size > 0)
-    {
-      output_size = (occupied_simple_fifo_size > READ_SIMPLE_FIFO_SIZE) ?
-        READ_SIMPLE_FIFO_SIZE : occupied_simple_fifo_size;
-      app_write_output_file(output_size);
-      occupied_simple_fifo_size = CMN_SimpleFifoGetOccupiedSize(&s_recorder_info.fifo.handle);
-    }
-
-  if (s_recorder_info.file.format_type == FORMAT_TYPE_WAV)
-    {
-      if (!app_update_wav_file_size())
-        {
-          printf("Error: app_write_wav_header() failure.\n");
-        }
-    }
+  /* The rest of the data and the WAV header are written by the sink. */
 
   app_close_output_file();
   return true;
@@ -1039,10 +988,9 @@ void app_recorde_process(uint32_t rec_time)
 
   do
     {
-      /* Check the FIFO every 5 ms and fill if there is space. */
+      /* The FIFO is written out by the file sink. */
 
-      usleep(5 * 1000);
-      app_pop_simple_fifo();
+      usleep(RECORDER_PROCESS_WAIT_MS * 1000);
 
     } while((time(&cur_time) - start_time) < rec_time);
 }
@@ -1190,6 +1138,8 @@ extern "C" int audio_recorder_main(int argc, char *argv[])
       return 1;
     }
 
+  s_recorder_info.fifo.sink.deinit();
+
   /* Close directory of recording file. */
 
   if (!app_close_file_dir())
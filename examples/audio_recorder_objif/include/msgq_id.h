@@ -37,9 +37,9 @@
 #ifndef MSGQ_ID_H_INCLUDED
 #define MSGQ_ID_H_INCLUDED
 
-/* Message area size: 4812 bytes */
+/* Message area size: 4848 bytes */
 #define MSGQ_TOP_DRM 0xfd000
-#define MSGQ_END_DRM 0xfe2cc
+#define MSGQ_END_DRM 0xfe2f0
 
 /* Message area fill value after message poped */
 #define MSG_FILL_VALUE_AFTER_POP 0x0
@@ -62,64 +62,64 @@
 /* User defined constants */
 
 /************************************************************************/
-#define MSGQ_AUD_MGR_QUE_BLOCK_DRM 0xfd044
-#define MSGQ_AUD_MGR_N_QUE_DRM 0xfd264
+#define MSGQ_AUD_MGR_QUE_BLOCK_DRM 0xfd048
+#define MSGQ_AUD_MGR_N_QUE_DRM 0xfd288
 #define MSGQ_AUD_MGR_N_SIZE 88
 #define MSGQ_AUD_MGR_N_NUM 30
 #define MSGQ_AUD_MGR_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_MGR_H_SIZE 0
 #define MSGQ_AUD_MGR_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_APP_QUE_BLOCK_DRM 0xfd088
-#define MSGQ_AUD_APP_N_QUE_DRM 0xfdcb4
+#define MSGQ_AUD_APP_QUE_BLOCK_DRM 0xfd090
+#define MSGQ_AUD_APP_N_QUE_DRM 0xfdcd8
 #define MSGQ_AUD_APP_N_SIZE 64
 #define MSGQ_AUD_APP_N_NUM 2
 #define MSGQ_AUD_APP_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_APP_H_SIZE 0
 #define MSGQ_AUD_APP_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_DSP_QUE_BLOCK_DRM 0xfd0cc
-#define MSGQ_AUD_DSP_N_QUE_DRM 0xfdd34
+#define MSGQ_AUD_DSP_QUE_BLOCK_DRM 0xfd0d8
+#define MSGQ_AUD_DSP_N_QUE_DRM 0xfdd58
 #define MSGQ_AUD_DSP_N_SIZE 20
 #define MSGQ_AUD_DSP_N_NUM 5
 #define MSGQ_AUD_DSP_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_DSP_H_SIZE 0
 #define MSGQ_AUD_DSP_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_RECORDER_QUE_BLOCK_DRM 0xfd110
-#define MSGQ_AUD_RECORDER_N_QUE_DRM 0xfdd98
+#define MSGQ_AUD_RECORDER_QUE_BLOCK_DRM 0xfd120
+#define MSGQ_AUD_RECORDER_N_QUE_DRM 0xfddbc
 #define MSGQ_AUD_RECORDER_N_SIZE 48
 #define MSGQ_AUD_RECORDER_N_NUM 5
 #define MSGQ_AUD_RECORDER_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_RECORDER_H_SIZE 0
 #define MSGQ_AUD_RECORDER_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_CAP_QUE_BLOCK_DRM 0xfd154
-#define MSGQ_AUD_CAP_N_QUE_DRM 0xfde88
+#define MSGQ_AUD_CAP_QUE_BLOCK_DRM 0xfd168
+#define MSGQ_AUD_CAP_N_QUE_DRM 0xfdeac
 #define MSGQ_AUD_CAP_N_SIZE 24
 #define MSGQ_AUD_CAP_N_NUM 16
 #define MSGQ_AUD_CAP_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_CAP_H_SIZE 0
 #define MSGQ_AUD_CAP_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_CAP_SYNC_QUE_BLOCK_DRM 0xfd198
-#define MSGQ_AUD_CAP_SYNC_N_QUE_DRM 0xfe008
+#define MSGQ_AUD_CAP_SYNC_QUE_BLOCK_DRM 0xfd1b0
+#define MSGQ_AUD_CAP_SYNC_N_QUE_DRM 0xfe02c
 #define MSGQ_AUD_CAP_SYNC_N_SIZE 16
 #define MSGQ_AUD_CAP_SYNC_N_NUM 8
 #define MSGQ_AUD_CAP_SYNC_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_CAP_SYNC_H_SIZE 0
 #define MSGQ_AUD_CAP_SYNC_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_FRONTEND_QUE_BLOCK_DRM 0xfd1dc
-#define MSGQ_AUD_FRONTEND_N_QUE_DRM 0xfe088
+#define MSGQ_AUD_FRONTEND_QUE_BLOCK_DRM 0xfd1f8
+#define MSGQ_AUD_FRONTEND_N_QUE_DRM 0xfe0ac
 #define MSGQ_AUD_FRONTEND_N_SIZE 48
 #define MSGQ_AUD_FRONTEND_N_NUM 10
 #define MSGQ_AUD_FRONTEND_H_QUE_DRM 0xffffffff
 #define MSGQ_AUD_FRONTEND_H_SIZE 0
 #define MSGQ_AUD_FRONTEND_H_NUM 0
 /************************************************************************/
-#define MSGQ_AUD_PREDSP_QUE_BLOCK_DRM 0xfd220
-#define MSGQ_AUD_PREDSP_N_QUE_DRM 0xfe268
+#define MSGQ_AUD_PREDSP_QUE_BLOCK_DRM 0xfd240
+#define MSGQ_AUD_PREDSP_N_QUE_DRM 0xfe28c
 #define MSGQ_AUD_PREDSP_N_SIZE 20
 #define MSGQ_AUD_PREDSP_N_NUM 5
 #define MSGQ_AUD_PREDSP_H_QUE_DRM 0xffffffff
@@ -36,9 +36,9 @@
 #ifndef MSGQ_ID_H_INCLUDED
 #define MSGQ_ID_H_INCLUDED
 
-/* Message area size: 684 bytes */
+/* Message area size: 696 bytes */
 #define MSGQ_TOP_DRM	0xc0000
-#define MSGQ_END_DRM	0xc02ac
+#define MSGQ_END_DRM	0xc02b8
 
 /* Message area fill value after message poped */
 #define MSG_FILL_VALUE_AFTER_POP	0x0
@@ -55,16 +55,16 @@
 /* User defined constants */
 
 /************************************************************************/
-#define MSGQ_AUD_MGR_QUE_BLOCK_DRM	0xc0044
-#define MSGQ_AUD_MGR_N_QUE_DRM	0xc00cc
+#define MSGQ_AUD_MGR_QUE_BLOCK_DRM	0xc0048
+#define MSGQ_AUD_MGR_N_QUE_DRM	0xc00d8
 #define MSGQ_AUD_MGR_N_SIZE	88
 #define MSGQ_AUD_MGR_N_NUM	4
 #define MSGQ_AUD_MGR_H_QUE_DRM	0xffffffff
 #define MSGQ_AUD_MGR_H_SIZE	0
 #define MSGQ_AUD_MGR_H_NUM	0
 /************************************************************************/
-#define MSGQ_AUD_APP_QUE_BLOCK_DRM	0xc0088
-#define MSGQ_AUD_APP_N_QUE_DRM	0xc022c
+#define MSGQ_AUD_APP_QUE_BLOCK_DRM	0xc0090
+#define MSGQ_AUD_APP_N_QUE_DRM	0xc0238
 #define MSGQ_AUD_APP_N_SIZE	64
 #define MSGQ_AUD_APP_N_NUM	2
 #define MSGQ_AUD_APP_H_QUE_DRM	0xffffffff
@@ -41,8 +41,8 @@
 extern const MsgQueDef MsgqPoolDefs[NUM_MSGQ_POOLS] = {
    /* n_drm, n_size, n_num, h_drm, h_size, h_num */
   { 0x00000000, 0, 0, 0x00000000, 0, 0, 0 }, /* MSGQ_NULL */
-  { 0xc00cc, 88, 4, 0xffffffff, 0, 0 }, /* MSGQ_AUD_MGR */
-  { 0xc022c, 64, 2, 0xffffffff, 0, 0 }, /* MSGQ_AUD_APP */
+  { 0xc00d8, 88, 4, 0xffffffff, 0, 0 }, /* MSGQ_AUD_MGR */
+  { 0xc0238, 64, 2, 0xffffffff, 0, 0 }, /* MSGQ_AUD_APP */
 };
 
 #endif /* MSGQ_POOL_H_INCLUDED */
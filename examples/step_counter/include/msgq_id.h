@@ -37,9 +37,9 @@
 #ifndef MSGQ_ID_H_INCLUDED
 #define MSGQ_ID_H_INCLUDED
 
-/* Message area size: 456 bytes */
+/* Message area size: 464 bytes */
 #define MSGQ_TOP_DRM 0xfe000
-#define MSGQ_END_DRM 0xfe1c8
+#define MSGQ_END_DRM 0xfe1d0
 
 /* Message area fill value after message poped */
 #define MSG_FILL_VALUE_AFTER_POP 0x0
@@ -55,8 +55,8 @@
 /* User defined constants */
 
 /************************************************************************/
-#define MSGQ_SEN_MGR_QUE_BLOCK_DRM 0xfe044
-#define MSGQ_SEN_MGR_N_QUE_DRM 0xfe088
+#define MSGQ_SEN_MGR_QUE_BLOCK_DRM 0xfe048
+#define MSGQ_SEN_MGR_N_QUE_DRM 0xfe090
 #define MSGQ_SEN_MGR_N_SIZE 40
 #define MSGQ_SEN_MGR_N_NUM 8
 #define MSGQ_SEN_MGR_H_QUE_DRM 0xffffffff
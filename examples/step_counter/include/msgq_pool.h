@@ -42,7 +42,7 @@
 extern const MsgQueDef MsgqPoolDefs[NUM_MSGQ_POOLS] = {
    /* n_drm, n_size, n_num, h_drm, h_size, h_num */
   { 0x00000000, 0, 0, 0x00000000, 0, 0, 0 }, /* MSGQ_NULL */
-  { 0xfe088, 40, 8, 0xffffffff, 0, 0 }, /* MSGQ_SEN_MGR */
+  { 0xfe090, 40, 8, 0xffffffff, 0, 0 }, /* MSGQ_SEN_MGR */
 };
 
 #endif /* MSGQ_POOL_H_INCLUDED */
@@ -45,7 +45,9 @@
 #include <debug.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/clock.h>
 #include <arch/board/board.h>
+#include <arch/chip/cxd56_hrtime.h>
 
 #include "nvic.h"
 #include "clock/clock.h"
@@ -203,3 +205,44 @@ int cxd56_timerisr_initialize(void)
 
   return 0;
 }
+
+/****************************************************************************
+ * Name: cxd56_hrtime_us
+ *
+ * Description:
+ *   Free running time in microseconds with sub-tick resolution.
+ *
+ ****************************************************************************/
+
+uint32_t cxd56_hrtime_us(void)
+{
+  irqstate_t flags;
+  uint32_t ticks;
+  uint32_t reload;
+  uint32_t current;
+
+  flags = enter_critical_section();
+
+  ticks   = (uint32_t)clock_systimer();
+  reload  = g_systrvr;
+  current = getreg32(NVIC_SYSTICK_CURRENT);
+
+  /* SysTick may have reloaded while interrupts are disabled here. Then
+   * its tick is not counted by clock_systimer() yet, and the current
+   * value read above may be the one before the reload.
+   */
+
+  if (getreg32(NVIC_INTCTRL) & NVIC_INTCTRL_PENDSTSET)
+    {
+      ticks++;
+      current = getreg32(NVIC_SYSTICK_CURRENT);
+    }
+
+  leave_critical_section(flags);
+
+  /* SysTick counts down from reload to 0 in a tick. */
+
+  return ticks * CONFIG_USEC_PER_TICK +
+         (uint32_t)((uint64_t)(reload - current) * CONFIG_USEC_PER_TICK /
+                    (reload + 1));
+}
@@ -926,6 +926,8 @@ bool CaptureComponent::init(const CaptureComponentParam& param)
   init_param.fade_en        = false;
   init_param.p_error_func   = m_dma_err_cb;
   init_param.p_dmadone_func = m_dma_done_cb;
+  init_param.ready_que_num  = CONFIG_AUDIOUTILS_CAPTURE_READY_QUEUE_NUM;
+  init_param.underflow_sample = 0;  /* Not used for input */
 
   m_callback = param.init_param.callback;
   m_err_callback = param.init_param.err_callback;
@@ -68,6 +68,12 @@ __WIEN2_BEGIN_NAMESPACE
 /* Equals to Max number of DMAC resource */
 #define MAX_CAPTURE_COMP_INSTANCE_NUM  CONFIG_AUDIOUTILS_CAPTURE_CH_NUM
 
+/* Depth of DMA ready queue. 0 means the default of the DMA driver. */
+
+#ifndef CONFIG_AUDIOUTILS_CAPTURE_READY_QUEUE_NUM
+#define CONFIG_AUDIOUTILS_CAPTURE_READY_QUEUE_NUM 0
+#endif
+
 #define MAX_CAPTURE_MIC_CH  CXD56_AUDIO_MIC_CH_MAX
 
 /* General types */
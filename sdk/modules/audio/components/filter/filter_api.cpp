@@ -176,6 +176,20 @@ bool AS_filter_recv_done(FilterComponent *p_ins)
   return p_ins->recv_done();
 }
 
+/*--------------------------------------------------------------------*/
+ComponentBase *AS_filter_create_src(PoolId apu_pool_id, MsgQueId apu_dtq)
+{
+  /* Sampling rate converter runs on the SRC DSP, or on this core
+   * without loading DSP.
+   */
+
+#ifdef CONFIG_AUDIOUTILS_SRC_SOFTWARE
+  return new SoftSRCComponent();
+#else
+  return new SRCComponent(apu_pool_id, apu_dtq);
+#endif
+}
+
 } /* extern "C" */
 
 __WIEN2_END_NAMESPACE
@@ -42,8 +42,10 @@
 #include "memutils/memory_manager/MemHandle.h"
 #include "memutils/message/Message.h"
 
+#include "filter_component.h"
 #include "packing_component.h"
 #include "src_filter_component.h"
+#include "soft_src_component.h"
 #ifdef CONFIG_AUDIOUTILS_MFE
 #include "mfe_filter_component.h"
 #endif
@@ -71,6 +73,8 @@ bool AS_filter_setparam(SetFilterParam *, FilterComponent *);
 bool AS_filter_tuning(TuningFilterParam *, FilterComponent *);
 bool AS_filter_recv_done(FilterComponent *p_ins);
 
+ComponentBase *AS_filter_create_src(PoolId apu_pool_id, MsgQueId apu_dtq);
+
 } /* extern "C" */
 
 __WIEN2_END_NAMESPACE
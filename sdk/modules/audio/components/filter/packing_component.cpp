@@ -37,6 +37,24 @@
 
 __WIEN2_BEGIN_NAMESPACE
 
+/*--------------------------------------------------------------------*/
+/* Supported conversions */
+/*--------------------------------------------------------------------*/
+static const struct
+{
+  uint16_t    in_bitwidth;
+  uint16_t    out_bitwidth;
+  PcmPackFunc func;
+} s_packing_table[] =
+{
+  { BitWidth32bit, BitWidth24bit, PcmPack32to24 },
+  { BitWidth24bit, BitWidth32bit, PcmPack24to32 },
+  { BitWidth32bit, BitWidth16bit, PcmPack32to16 },
+  { BitWidth16bit, BitWidth32bit, PcmPack16to32 },
+  { BitWidth24bit, BitWidth16bit, PcmPack24to16 },
+  { BitWidth16bit, BitWidth24bit, PcmPack16to24 },
+};
+
 /*--------------------------------------------------------------------*/
 /* Methods of PackingComponent class */
 /*--------------------------------------------------------------------*/
@@ -69,6 +87,28 @@ uint32_t PackingComponent::init(const InitComponentParam& param)
 
   m_in_bitwidth  = param.fixparam.in_bitlength;
   m_out_bitwidth = param.fixparam.out_bitlength;
+  m_convfunc     = NULL;
+
+  for (uint32_t i = 0;
+       i < sizeof(s_packing_table) / sizeof(s_packing_table[0]); i++)
+    {
+      if ((s_packing_table[i].in_bitwidth == m_in_bitwidth)
+       && (s_packing_table[i].out_bitwidth == m_out_bitwidth))
+        {
+          m_convfunc = s_packing_table[i].func;
+          break;
+        }
+    }
+
+  /* Bit widths without a kernel, including the same width, can not be
+   * converted.
+   */
+
+  if (m_convfunc == NULL)
+    {
+      FILTER_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
+      return AS_ECODE_COMMAND_PARAM_BIT_LENGTH;
+    }
 
   /* Hold dummy. */
 
@@ -104,7 +144,7 @@ bool PackingComponent::set(const SetComponentParam& param)
 /*--------------------------------------------------------------------*/
 bool PackingComponent::exec(const ExecComponentParam& param)
 {
-  void (PackingComponent::*convfunc)(uint32_t, int8_t *, int8_t *);
+  uint32_t samples = 0;
   uint32_t outsize = 0;
   bool result = false;
 
@@ -119,28 +159,19 @@ bool PackingComponent::exec(const ExecComponentParam& param)
 
   /* Execute packing */
 
-  if ((m_in_bitwidth == BitWidth32bit) && (m_out_bitwidth == BitWidth24bit))
-    {
-      convfunc = &PackingComponent::cnv32to24;
-      outsize  = param.input.size * BitWidth24bit / BitWidth32bit;
-    }
-  else if ((m_in_bitwidth == BitWidth24bit) && (m_out_bitwidth == BitWidth32bit))
-    {
-      convfunc = &PackingComponent::cnv24to32;
-      outsize  = param.input.size * BitWidth32bit / BitWidth24bit;
-    }
-  else
+  if (m_convfunc == NULL)
     {
       return false;
     }
 
+  samples = param.input.size / (m_in_bitwidth / 8);
+  outsize = samples * (m_out_bitwidth / 8);
+
   /* Excec convert */
 
   if (outsize <= param.output_mh.getSize())
     {
-      (this->*convfunc)(param.input.size / (m_in_bitwidth / 8),
-                        reinterpret_cast<int8_t *>(param.input.mh.getPa()),
-                        reinterpret_cast<int8_t *>(param.output_mh.getPa()));
+      m_convfunc(samples, param.input.mh.getPa(), param.output_mh.getPa());
       result = true;
     }
  
@@ -231,45 +262,6 @@ bool PackingComponent::recv_done(void)
   return true;
 }
 
-/*--------------------------------------------------------------------*/
-void PackingComponent::cnv32to24(uint32_t samples, int8_t *in, int8_t *out)
-{
-  /** For Little endian data ! **/
-
-  uint32_t *p_in  = (uint32_t *)in;
-  uint32_t *p_out = (uint32_t *)out;
-
-  for (uint32_t cnt = 0; cnt < samples / 4; cnt++)
-    {
-      *(p_out+0) = (uint32_t)(((*(p_in+0) & 0xFFFFFF00) >> 8 ) + ((*(p_in+1) & 0x0000FF00) << 16));
-      *(p_out+1) = (uint32_t)(((*(p_in+1) & 0xFFFF0000) >> 16) + ((*(p_in+2) & 0x00FFFF00) << 8 ));
-      *(p_out+2) = (uint32_t)(((*(p_in+2) & 0xFF000000) >> 24) + ((*(p_in+3) & 0xFFFFFF00) >> 0 ));
-
-      p_out +=3;
-      p_in  +=4;
-    }
-}
-
-/*--------------------------------------------------------------------*/
-void PackingComponent::cnv24to32(uint32_t samples, int8_t *in, int8_t *out)
-{
-  /** For Little endian data ! **/
-
-  uint32_t *p_in  = (uint32_t *)in;
-  uint32_t *p_out = (uint32_t *)out;
-
-  for (uint32_t cnt = 0; cnt < samples / 4; cnt++)
-    {
-      *(p_out+0) = (uint32_t)( (*(p_in+0) & 0x00FFFFFF) << 8 );
-      *(p_out+1) = (uint32_t)(((*(p_in+0) & 0xFF000000) >> 16) + ((*(p_in+1) & 0x0000FFFF) << 16));
-      *(p_out+2) = (uint32_t)(((*(p_in+1) & 0xFFFF0000) >> 8 ) + ((*(p_in+2) & 0x000000FF) << 24));
-      *(p_out+3) = (uint32_t)(  *(p_in+2) & 0xFFFFFF00);
-
-      p_out +=4;
-      p_in  +=3;
-    }
-}
-
 /*--------------------------------------------------------------------*/
 void PackingComponent::send_resp(ComponentEventType evt, bool result)
 {
@@ -41,6 +41,7 @@
 #include "debug/dbg_log.h"
 #include "memutils/s_stl/queue.h"
 #include "components/common/component_base.h"
+#include "components/filter/pcm_packing.h"
 
 __WIEN2_BEGIN_NAMESPACE
 using namespace MemMgrLite;
@@ -48,6 +49,7 @@ using namespace MemMgrLite;
 /*--------------------------------------------------------------------*/
 enum BitWidth
 {
+  BitWidth16bit = 16,
   BitWidth24bit = 24,
   BitWidth32bit = 32,
 };
@@ -77,8 +79,8 @@ private:
   uint16_t m_in_bitwidth;
   uint16_t m_out_bitwidth;
 
-  void cnv32to24(uint32_t samples, int8_t *in, int8_t *out);
-  void cnv24to32(uint32_t samples, int8_t *in, int8_t *out);
+  PcmPackFunc m_convfunc;
+
   void send_resp(ComponentEventType evt, bool result);
 
 public:
@@ -86,6 +88,7 @@ public:
   PackingComponent() :
       m_in_bitwidth(32)
     , m_out_bitwidth(24)
+    , m_convfunc(NULL)
     {}
   ~PackingComponent() {}
 
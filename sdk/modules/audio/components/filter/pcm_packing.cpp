@@ -0,0 +1,525 @@
+/****************************************************************************
+ * modules/audio/components/filter/pcm_packing.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "components/filter/pcm_packing.h"
+
+__WIEN2_BEGIN_NAMESPACE
+
+/*--------------------------------------------------------------------*/
+/* Halfword packing                                                   */
+/*   pkhbt(lo, hi) : lo[15:0]  | hi[15:0]  << 16                      */
+/*   pkhtb(hi, lo) : hi[31:16] | lo[31:16] >> 16                      */
+/*--------------------------------------------------------------------*/
+#if defined(__ARM_FEATURE_DSP)
+static inline uint32_t pkhbt(uint32_t lo, uint32_t hi)
+{
+  uint32_t result;
+  __asm__ ("pkhbt %0, %1, %2, lsl #16" : "=r" (result) : "r" (lo), "r" (hi));
+  return result;
+}
+
+static inline uint32_t pkhtb(uint32_t hi, uint32_t lo)
+{
+  uint32_t result;
+  __asm__ ("pkhtb %0, %1, %2, asr #16" : "=r" (result) : "r" (hi), "r" (lo));
+  return result;
+}
+#else
+static inline uint32_t pkhbt(uint32_t lo, uint32_t hi)
+{
+  return (lo & 0x0000FFFF) | (hi << 16);
+}
+
+static inline uint32_t pkhtb(uint32_t hi, uint32_t lo)
+{
+  return (hi & 0xFFFF0000) | (lo >> 16);
+}
+#endif
+
+/*--------------------------------------------------------------------*/
+void PcmPack32to24(uint32_t samples, const void *in, void *out)
+{
+  const uint32_t *p_in  = static_cast<const uint32_t *>(in);
+  uint32_t       *p_out = static_cast<uint32_t *>(out);
+
+  for (uint32_t cnt = samples / 4; cnt > 0; cnt--)
+    {
+      uint32_t w0 = p_in[0];
+      uint32_t w1 = p_in[1];
+      uint32_t w2 = p_in[2];
+      uint32_t w3 = p_in[3];
+
+      p_out[0] = (w0 >> 8)  | ((w1 & 0x0000FF00) << 16);
+      p_out[1] = (w1 >> 16) | ((w2 & 0x00FFFF00) << 8);
+      p_out[2] = (w2 >> 24) | (w3 & 0xFFFFFF00);
+
+      p_out += 3;
+      p_in  += 4;
+    }
+
+  /* Tail */
+
+  uint8_t *p_out8 = reinterpret_cast<uint8_t *>(p_out);
+
+  for (uint32_t cnt = samples % 4; cnt > 0; cnt--)
+    {
+      uint32_t w = *p_in++;
+
+      p_out8[0] = static_cast<uint8_t>(w >> 8);
+      p_out8[1] = static_cast<uint8_t>(w >> 16);
+      p_out8[2] = static_cast<uint8_t>(w >> 24);
+      p_out8 += 3;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void PcmPack24to32(uint32_t samples, const void *in, void *out)
+{
+  const uint32_t *p_in  = static_cast<const uint32_t *>(in);
+  uint32_t       *p_out = static_cast<uint32_t *>(out);
+
+  for (uint32_t cnt = samples / 4; cnt > 0; cnt--)
+    {
+      uint32_t w0 = p_in[0];
+      uint32_t w1 = p_in[1];
+      uint32_t w2 = p_in[2];
+
+      p_out[0] = w0 << 8;
+      p_out[1] = ((w0 >> 16) & 0x0000FF00) | (w1 << 16);
+      p_out[2] = ((w1 >> 8)  & 0x00FFFF00) | (w2 << 24);
+      p_out[3] = w2 & 0xFFFFFF00;
+
+      p_out += 4;
+      p_in  += 3;
+    }
+
+  /* Tail */
+
+  const uint8_t *p_in8 = reinterpret_cast<const uint8_t *>(p_in);
+
+  for (uint32_t cnt = samples % 4; cnt > 0; cnt--)
+    {
+      *p_out++ = (static_cast<uint32_t>(p_in8[0]) << 8)
+               | (static_cast<uint32_t>(p_in8[1]) << 16)
+               | (static_cast<uint32_t>(p_in8[2]) << 24);
+      p_in8 += 3;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void PcmPack32to16(uint32_t samples, const void *in, void *out)
+{
+  const uint32_t *p_in  = static_cast<const uint32_t *>(in);
+  uint32_t       *p_out = static_cast<uint32_t *>(out);
+
+  for (uint32_t cnt = samples / 4; cnt > 0; cnt--)
+    {
+      p_out[0] = pkhtb(p_in[1], p_in[0]);
+      p_out[1] = pkhtb(p_in[3], p_in[2]);
+
+      p_out += 2;
+      p_in  += 4;
+    }
+
+  /* Tail */
+
+  uint16_t *p_out16 = reinterpret_cast<uint16_t *>(p_out);
+
+  for (uint32_t cnt = samples % 4; cnt > 0; cnt--)
+    {
+      *p_out16++ = static_cast<uint16_t>(*p_in++ >> 16);
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void PcmPack16to32(uint32_t samples, const void *in, void *out)
+{
+  const uint32_t *p_in  = static_cast<const uint32_t *>(in);
+  uint32_t       *p_out = static_cast<uint32_t *>(out);
+
+  for (uint32_t cnt = samples / 4; cnt > 0; cnt--)
+    {
+      uint32_t w0 = p_in[0];
+      uint32_t w1 = p_in[1];
+
+      p_out[0] = w0 << 16;
+      p_out[1] = w0 & 0xFFFF0000;
+      p_out[2] = w1 << 16;
+      p_out[3] = w1 & 0xFFFF0000;
+
+      p_out += 4;
+      p_in  += 2;
+    }
+
+  /* Tail */
+
+  const uint16_t *p_in16 = reinterpret_cast<const uint16_t *>(p_in);
+
+  for (uint32_t cnt = samples % 4; cnt > 0; cnt--)
+    {
+      *p_out++ = static_cast<uint32_t>(*p_in16++) << 16;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void PcmPack24to16(uint32_t samples, const void *in, void *out)
+{
+  const uint32_t *p_in  = static_cast<const uint32_t *>(in);
+  uint32_t       *p_out = static_cast<uint32_t *>(out);
+
+  for (uint32_t cnt = samples / 4; cnt > 0; cnt--)
+    {
+      uint32_t w0 = p_in[0];
+      uint32_t w1 = p_in[1];
+      uint32_t w2 = p_in[2];
+
+      /* Upper 2 bytes of each sample are bytes 1-2, 4-5, 7-8, 10-11. */
+
+      p_out[0] = pkhbt(w0 >> 8, w1);
+      p_out[1] = pkhbt((w1 >> 24) | (w2 << 8), w2 >> 16);
+
+      p_out += 2;
+      p_in  += 3;
+    }
+
+  /* Tail */
+
+  const uint8_t *p_in8   = reinterpret_cast<const uint8_t *>(p_in);
+  uint16_t      *p_out16 = reinterpret_cast<uint16_t *>(p_out);
+
+  for (uint32_t cnt = samples % 4; cnt > 0; cnt--)
+    {
+      *p_out16++ = static_cast<uint16_t>(p_in8[1] | (p_in8[2] << 8));
+      p_in8 += 3;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void PcmPack16to24(uint32_t samples, const void *in, void *out)
+{
+  const uint32_t *p_in  = static_cast<const uint32_t *>(in);
+  uint32_t       *p_out = static_cast<uint32_t *>(out);
+
+  for (uint32_t cnt = samples / 4; cnt > 0; cnt--)
+    {
+      uint32_t w0 = p_in[0];
+      uint32_t w1 = p_in[1];
+
+      p_out[0] = (w0 & 0x0000FFFF) << 8;
+      p_out[1] = (w0 >> 16) | (w1 << 24);
+      p_out[2] = ((w1 >> 8) & 0x000000FF) | (w1 & 0xFFFF0000);
+
+      p_out += 3;
+      p_in  += 2;
+    }
+
+  /* Tail */
+
+  const uint16_t *p_in16 = reinterpret_cast<const uint16_t *>(p_in);
+  uint8_t        *p_out8 = reinterpret_cast<uint8_t *>(p_out);
+
+  for (uint32_t cnt = samples % 4; cnt > 0; cnt--)
+    {
+      uint16_t s = *p_in16++;
+
+      p_out8[0] = 0;
+      p_out8[1] = static_cast<uint8_t>(s);
+      p_out8[2] = static_cast<uint8_t>(s >> 8);
+      p_out8 += 3;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void PcmInterleave16(uint32_t frames,
+                     const void *in_l,
+                     const void *in_r,
+                     void *out)
+{
+  const uint32_t *p_l   = static_cast<const uint32_t *>(in_l);
+  const uint32_t *p_r   = static_cast<const uint32_t *>(in_r);
+  uint32_t       *p_out = static_cast<uint32_t *>(out);
+
+  for (uint32_t cnt = frames / 4; cnt > 0; cnt--)
+    {
+      uint32_t l0 = p_l[0];
+      uint32_t r0 = p_r[0];
+      uint32_t l1 = p_l[1];
+      uint32_t r1 = p_r[1];
+
+      p_out[0] = pkhbt(l0, r0);
+      p_out[1] = pkhtb(r0, l0);
+      p_out[2] = pkhbt(l1, r1);
+      p_out[3] = pkhtb(r1, l1);
+
+      p_out += 4;
+      p_l   += 2;
+      p_r   += 2;
+    }
+
+  /* Tail */
+
+  const uint16_t *p_l16 = reinterpret_cast<const uint16_t *>(p_l);
+  const uint16_t *p_r16 = reinterpret_cast<const uint16_t *>(p_r);
+
+  for (uint32_t cnt = frames % 4; cnt > 0; cnt--)
+    {
+      *p_out++ = pkhbt(*p_l16++, *p_r16++);
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void PcmDeinterleave16(uint32_t frames,
+                       const void *in,
+                       void *out_l,
+                       void *out_r)
+{
+  const uint32_t *p_in = static_cast<const uint32_t *>(in);
+  uint32_t       *p_l  = static_cast<uint32_t *>(out_l);
+  uint32_t       *p_r  = static_cast<uint32_t *>(out_r);
+
+  for (uint32_t cnt = frames / 4; cnt > 0; cnt--)
+    {
+      uint32_t w0 = p_in[0];
+      uint32_t w1 = p_in[1];
+      uint32_t w2 = p_in[2];
+      uint32_t w3 = p_in[3];
+
+      p_l[0] = pkhbt(w0, w1);
+      p_r[0] = pkhtb(w1, w0);
+      p_l[1] = pkhbt(w2, w3);
+      p_r[1] = pkhtb(w3, w2);
+
+      p_in += 4;
+      p_l  += 2;
+      p_r  += 2;
+    }
+
+  /* Tail */
+
+  uint16_t *p_l16 = reinterpret_cast<uint16_t *>(p_l);
+  uint16_t *p_r16 = reinterpret_cast<uint16_t *>(p_r);
+
+  for (uint32_t cnt = frames % 4; cnt > 0; cnt--)
+    {
+      uint32_t w = *p_in++;
+
+      *p_l16++ = static_cast<uint16_t>(w);
+      *p_r16++ = static_cast<uint16_t>(w >> 16);
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void PcmInterleave24(uint32_t frames,
+                     const void *in_l,
+                     const void *in_r,
+                     void *out)
+{
+  const uint32_t *p_l   = static_cast<const uint32_t *>(in_l);
+  const uint32_t *p_r   = static_cast<const uint32_t *>(in_r);
+  uint32_t       *p_out = static_cast<uint32_t *>(out);
+
+  for (uint32_t cnt = frames / 4; cnt > 0; cnt--)
+    {
+      uint32_t l0 = p_l[0];
+      uint32_t l1 = p_l[1];
+      uint32_t l2 = p_l[2];
+      uint32_t r0 = p_r[0];
+      uint32_t r1 = p_r[1];
+      uint32_t r2 = p_r[2];
+
+      /* 4 packed samples of each channel are in 3 words. */
+
+      p_out[0] = (l0 & 0x00FFFFFF) | (r0 << 24);
+      p_out[1] = ((r0 >> 8) & 0x0000FFFF) | ((l0 >> 8) & 0x00FF0000)
+               | (l1 << 24);
+      p_out[2] = ((l1 >> 8) & 0x000000FF) | ((r0 >> 16) & 0x0000FF00)
+               | (r1 << 16);
+      p_out[3] = (l1 >> 16) | ((l2 & 0x000000FF) << 16)
+               | ((r1 & 0x00FF0000) << 8);
+      p_out[4] = (r1 >> 24) | ((r2 & 0x000000FF) << 8)
+               | ((l2 << 8) & 0xFFFF0000);
+      p_out[5] = (l2 >> 24) | (r2 & 0xFFFFFF00);
+
+      p_out += 6;
+      p_l   += 3;
+      p_r   += 3;
+    }
+
+  /* Tail */
+
+  const uint8_t *p_l8   = reinterpret_cast<const uint8_t *>(p_l);
+  const uint8_t *p_r8   = reinterpret_cast<const uint8_t *>(p_r);
+  uint8_t       *p_out8 = reinterpret_cast<uint8_t *>(p_out);
+
+  for (uint32_t cnt = frames % 4; cnt > 0; cnt--)
+    {
+      p_out8[0] = p_l8[0];
+      p_out8[1] = p_l8[1];
+      p_out8[2] = p_l8[2];
+      p_out8[3] = p_r8[0];
+      p_out8[4] = p_r8[1];
+      p_out8[5] = p_r8[2];
+
+      p_out8 += 6;
+      p_l8   += 3;
+      p_r8   += 3;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void PcmDeinterleave24(uint32_t frames,
+                       const void *in,
+                       void *out_l,
+                       void *out_r)
+{
+  const uint32_t *p_in = static_cast<const uint32_t *>(in);
+  uint32_t       *p_l  = static_cast<uint32_t *>(out_l);
+  uint32_t       *p_r  = static_cast<uint32_t *>(out_r);
+
+  for (uint32_t cnt = frames / 4; cnt > 0; cnt--)
+    {
+      uint32_t w0 = p_in[0];
+      uint32_t w1 = p_in[1];
+      uint32_t w2 = p_in[2];
+      uint32_t w3 = p_in[3];
+      uint32_t w4 = p_in[4];
+      uint32_t w5 = p_in[5];
+
+      p_l[0] = (w0 & 0x00FFFFFF) | ((w1 & 0x00FF0000) << 8);
+      p_l[1] = (w1 >> 24) | ((w2 & 0x000000FF) << 8) | (w3 << 16);
+      p_l[2] = ((w3 >> 16) & 0x000000FF) | ((w4 >> 8) & 0x00FFFF00)
+             | (w5 << 24);
+      p_r[0] = (w0 >> 24) | ((w1 & 0x0000FFFF) << 8)
+             | ((w2 & 0x0000FF00) << 16);
+      p_r[1] = (w2 >> 16) | ((w3 >> 8) & 0x00FF0000) | (w4 << 24);
+      p_r[2] = ((w4 >> 8) & 0x000000FF) | (w5 & 0xFFFFFF00);
+
+      p_in += 6;
+      p_l  += 3;
+      p_r  += 3;
+    }
+
+  /* Tail */
+
+  const uint8_t *p_in8 = reinterpret_cast<const uint8_t *>(p_in);
+  uint8_t       *p_l8  = reinterpret_cast<uint8_t *>(p_l);
+  uint8_t       *p_r8  = reinterpret_cast<uint8_t *>(p_r);
+
+  for (uint32_t cnt = frames % 4; cnt > 0; cnt--)
+    {
+      p_l8[0] = p_in8[0];
+      p_l8[1] = p_in8[1];
+      p_l8[2] = p_in8[2];
+      p_r8[0] = p_in8[3];
+      p_r8[1] = p_in8[4];
+      p_r8[2] = p_in8[5];
+
+      p_in8 += 6;
+      p_l8  += 3;
+      p_r8  += 3;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void PcmInterleave32(uint32_t frames,
+                     const void *in_l,
+                     const void *in_r,
+                     void *out)
+{
+  const uint32_t *p_l   = static_cast<const uint32_t *>(in_l);
+  const uint32_t *p_r   = static_cast<const uint32_t *>(in_r);
+  uint32_t       *p_out = static_cast<uint32_t *>(out);
+
+  for (uint32_t cnt = frames / 4; cnt > 0; cnt--)
+    {
+      p_out[0] = p_l[0];
+      p_out[1] = p_r[0];
+      p_out[2] = p_l[1];
+      p_out[3] = p_r[1];
+      p_out[4] = p_l[2];
+      p_out[5] = p_r[2];
+      p_out[6] = p_l[3];
+      p_out[7] = p_r[3];
+
+      p_out += 8;
+      p_l   += 4;
+      p_r   += 4;
+    }
+
+  /* Tail */
+
+  for (uint32_t cnt = frames % 4; cnt > 0; cnt--)
+    {
+      *p_out++ = *p_l++;
+      *p_out++ = *p_r++;
+    }
+}
+
+/*--------------------------------------------------------------------*/
+void PcmDeinterleave32(uint32_t frames,
+                       const void *in,
+                       void *out_l,
+                       void *out_r)
+{
+  const uint32_t *p_in = static_cast<const uint32_t *>(in);
+  uint32_t       *p_l  = static_cast<uint32_t *>(out_l);
+  uint32_t       *p_r  = static_cast<uint32_t *>(out_r);
+
+  for (uint32_t cnt = frames / 4; cnt > 0; cnt--)
+    {
+      p_l[0] = p_in[0];
+      p_r[0] = p_in[1];
+      p_l[1] = p_in[2];
+      p_r[1] = p_in[3];
+      p_l[2] = p_in[4];
+      p_r[2] = p_in[5];
+      p_l[3] = p_in[6];
+      p_r[3] = p_in[7];
+
+      p_in += 8;
+      p_l  += 4;
+      p_r  += 4;
+    }
+
+  /* Tail */
+
+  for (uint32_t cnt = frames % 4; cnt > 0; cnt--)
+    {
+      *p_l++ = *p_in++;
+      *p_r++ = *p_in++;
+    }
+}
+
+__WIEN2_END_NAMESPACE
@@ -0,0 +1,101 @@
+/****************************************************************************
+ * modules/audio/components/filter/pcm_packing.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef PCM_PACKING_H
+#define PCM_PACKING_H
+
+#include "wien2_common_defs.h"
+
+__WIEN2_BEGIN_NAMESPACE
+
+/*--------------------------------------------------------------------*/
+/* PCM packing kernels                                                */
+/*                                                                    */
+/* Samples are little endian and signed. 24bit samples are packed    */
+/* (3 bytes), 32bit samples have the valid bits at MSB side.          */
+/* Narrowing conversions truncate the lower bits.                     */
+/*                                                                    */
+/* All buffers must be 4 bytes aligned. 4 samples (frames) are        */
+/* processed at once, and the rest is processed one by one, so any    */
+/* number of samples can be given.                                    */
+/* When Cortex-M4 DSP extension is available, the halfword packing    */
+/* is done by PKHBT/PKHTB.                                            */
+/*--------------------------------------------------------------------*/
+
+/* Bit width conversion. "samples" is the number of samples of
+ * all channels.
+ */
+
+typedef void (*PcmPackFunc)(uint32_t samples, const void *in, void *out);
+
+void PcmPack32to24(uint32_t samples, const void *in, void *out);
+void PcmPack24to32(uint32_t samples, const void *in, void *out);
+void PcmPack32to16(uint32_t samples, const void *in, void *out);
+void PcmPack16to32(uint32_t samples, const void *in, void *out);
+void PcmPack24to16(uint32_t samples, const void *in, void *out);
+void PcmPack16to24(uint32_t samples, const void *in, void *out);
+
+/* Stereo interleave (L/R planes -> LRLR...) and deinterleave.
+ * "frames" is the number of samples of one channel.
+ */
+
+void PcmInterleave16(uint32_t frames,
+                     const void *in_l,
+                     const void *in_r,
+                     void *out);
+void PcmDeinterleave16(uint32_t frames,
+                       const void *in,
+                       void *out_l,
+                       void *out_r);
+void PcmInterleave24(uint32_t frames,
+                     const void *in_l,
+                     const void *in_r,
+                     void *out);
+void PcmDeinterleave24(uint32_t frames,
+                       const void *in,
+                       void *out_l,
+                       void *out_r);
+void PcmInterleave32(uint32_t frames,
+                     const void *in_l,
+                     const void *in_r,
+                     void *out);
+void PcmDeinterleave32(uint32_t frames,
+                       const void *in,
+                       void *out_l,
+                       void *out_r);
+
+__WIEN2_END_NAMESPACE
+
+#endif /* PCM_PACKING_H */
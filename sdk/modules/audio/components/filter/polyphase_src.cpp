@@ -0,0 +1,404 @@
+/****************************************************************************
+ * modules/audio/components/filter/polyphase_src.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <string.h>
+#include <math.h>
+#include "components/filter/polyphase_src.h"
+
+#ifdef CONFIG_EXTERNALS_CMSIS_DSP
+#include <arm_math.h>
+#endif
+
+__WIEN2_BEGIN_NAMESPACE
+
+/*--------------------------------------------------------------------*/
+/* Filter design                                                      */
+/*                                                                    */
+/* Zero crossings of the sinc on each side, at the lower rate.        */
+/* With the Kaiser window of beta 7.2, the stopband is about -75dB    */
+/* and the transition band is about 0.2 of the lower rate. The cutoff */
+/* is set below the Nyquist frequency so that the aliases fall above  */
+/* 0.445 of the lower rate.                                           */
+/*--------------------------------------------------------------------*/
+
+#define SRC_ZERO_CROSSINGS  12
+#define SRC_KAISER_BETA     7.2
+#define SRC_CUTOFF          0.45
+
+/*--------------------------------------------------------------------*/
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+  while (b != 0)
+    {
+      uint32_t r = a % b;
+
+      a = b;
+      b = r;
+    }
+
+  return a;
+}
+
+/*--------------------------------------------------------------------*/
+static double bessel_i0(double x)
+{
+  double sum  = 1.0;
+  double term = 1.0;
+
+  for (int k = 1; k < 50; k++)
+    {
+      term *= (x / (2.0 * k)) * (x / (2.0 * k));
+      sum  += term;
+
+      if (term < sum * 1e-12)
+        {
+          break;
+        }
+    }
+
+  return sum;
+}
+
+/*--------------------------------------------------------------------*/
+static inline float to_float(int16_t x)
+{
+  return (float)x;
+}
+
+static inline float to_float(int32_t x)
+{
+  return (float)x;
+}
+
+/*--------------------------------------------------------------------*/
+static inline void from_float(float y, int16_t *x)
+{
+  if (y >= 32767.0f)
+    {
+      *x = 32767;
+    }
+  else if (y <= -32768.0f)
+    {
+      *x = -32768;
+    }
+  else
+    {
+      *x = (int16_t)((y >= 0.0f) ? (y + 0.5f) : (y - 0.5f));
+    }
+}
+
+/*--------------------------------------------------------------------*/
+static inline void from_float(float y, int32_t *x)
+{
+  /* 2147483520 is the largest float below 2^31. */
+
+  if (y >= 2147483520.0f)
+    {
+      *x = 2147483647;
+    }
+  else if (y <= -2147483648.0f)
+    {
+      *x = (-2147483647 - 1);
+    }
+  else
+    {
+      *x = (int32_t)((y >= 0.0f) ? (y + 0.5f) : (y - 0.5f));
+    }
+}
+
+/*--------------------------------------------------------------------*/
+static inline float dot_prod(const float *h, const float *x, uint32_t taps)
+{
+#ifdef CONFIG_EXTERNALS_CMSIS_DSP
+  float32_t result;
+
+  arm_dot_prod_f32(h, x, taps, &result);
+
+  return result;
+#else
+  /* Taps are multiple of 4. */
+
+  float acc0 = 0.0f;
+  float acc1 = 0.0f;
+  float acc2 = 0.0f;
+  float acc3 = 0.0f;
+
+  for (uint32_t i = 0; i < taps; i += 4)
+    {
+      acc0 += h[i]     * x[i];
+      acc1 += h[i + 1] * x[i + 1];
+      acc2 += h[i + 2] * x[i + 2];
+      acc3 += h[i + 3] * x[i + 3];
+    }
+
+  return (acc0 + acc1) + (acc2 + acc3);
+#endif
+}
+
+/*--------------------------------------------------------------------*/
+/* Methods of PolyphaseSrc class */
+/*--------------------------------------------------------------------*/
+void PolyphaseSrc::clear(void)
+{
+  m_up        = 1;
+  m_down      = 1;
+  m_taps      = 0;
+  m_phase     = 0;
+  m_pos       = 0;
+  m_ch_num    = 0;
+  m_bytewidth = 0;
+}
+
+/*--------------------------------------------------------------------*/
+bool PolyphaseSrc::init(uint32_t in_fs,
+                        uint32_t out_fs,
+                        uint8_t  ch_num,
+                        uint8_t  bytewidth)
+{
+  release();
+
+  if ((in_fs == 0) || (out_fs == 0)
+   || (ch_num == 0) || (ch_num > POLYPHASE_SRC_MAX_CH)
+   || ((bytewidth != 2) && (bytewidth != 4)))
+    {
+      return false;
+    }
+
+  uint32_t div  = gcd(in_fs, out_fs);
+  uint32_t up   = out_fs / div;
+  uint32_t down = in_fs / div;
+  uint32_t high = (up > down) ? up : down;
+
+  /* Taps of one phase cover the zero crossings at the lower rate,
+   * rounded up to multiple of 4 for the dot product.
+   */
+
+  uint32_t taps = (2 * SRC_ZERO_CROSSINGS * high + up - 1) / up;
+
+  taps = (taps + 3) & ~3;
+
+  if ((up > POLYPHASE_SRC_MAX_PHASES) || (taps > POLYPHASE_SRC_MAX_TAPS))
+    {
+      return false;
+    }
+
+  m_coef   = new float[up * taps];
+  m_window = new float[ch_num * (taps - 1 + POLYPHASE_SRC_BLOCK)];
+
+  if ((m_coef == NULL) || (m_window == NULL))
+    {
+      release();
+      return false;
+    }
+
+  m_up        = up;
+  m_down      = down;
+  m_taps      = taps;
+  m_ch_num    = ch_num;
+  m_bytewidth = bytewidth;
+
+  design();
+  reset();
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+void PolyphaseSrc::release(void)
+{
+  delete [] m_coef;
+  delete [] m_window;
+
+  m_coef   = NULL;
+  m_window = NULL;
+
+  clear();
+}
+
+/*--------------------------------------------------------------------*/
+void PolyphaseSrc::reset(void)
+{
+  if (m_window != NULL)
+    {
+      memset(m_window, 0, sizeof(float) * m_ch_num *
+                          (m_taps - 1 + POLYPHASE_SRC_BLOCK));
+    }
+
+  m_phase = 0;
+  m_pos   = (m_taps > 0) ? (m_taps - 1) : 0;
+}
+
+/*--------------------------------------------------------------------*/
+void PolyphaseSrc::design(void)
+{
+  /* Prototype at L times of the input rate, h[j * L + p] is the
+   * coefficient of phase p for the input j samples before. It is
+   * stored in time order (oldest first), so the dot product runs
+   * forward on the window.
+   */
+
+  uint32_t high   = (m_up > m_down) ? m_up : m_down;
+  uint32_t length = m_up * m_taps;
+  double   center = (double)(length - 1) / 2.0;
+  double   fc     = SRC_CUTOFF / (double)high;
+  double   i0beta = bessel_i0(SRC_KAISER_BETA);
+
+  for (uint32_t p = 0; p < m_up; p++)
+    {
+      float *coef = m_coef + p * m_taps;
+      double sum  = 0.0;
+
+      for (uint32_t i = 0; i < m_taps; i++)
+        {
+          uint32_t n = (m_taps - 1 - i) * m_up + p;
+          double   t = (double)n - center;
+          double   r = t / (center + 0.5);
+          double   sinc = (t == 0.0) ?
+                            1.0 : sin(2.0 * M_PI * fc * t) / (2.0 * M_PI * fc * t);
+          double   win = (r * r < 1.0) ?
+                           bessel_i0(SRC_KAISER_BETA * sqrt(1.0 - r * r)) / i0beta : 0.0;
+
+          coef[i] = (float)(sinc * win);
+          sum    += sinc * win;
+        }
+
+      /* Make DC gain of each phase 1. */
+
+      for (uint32_t i = 0; i < m_taps; i++)
+        {
+          coef[i] = (float)((double)coef[i] / sum);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------*/
+template <typename T>
+int32_t PolyphaseSrc::execImpl(const T *in,
+                               uint32_t samples,
+                               T *out,
+                               uint32_t max_samples)
+{
+  uint32_t width   = m_taps - 1 + POLYPHASE_SRC_BLOCK;
+  uint32_t written = 0;
+
+  while (samples > 0)
+    {
+      uint32_t n = (samples < POLYPHASE_SRC_BLOCK) ?
+                     samples : POLYPHASE_SRC_BLOCK;
+
+      /* Deinterleave the block after the history. */
+
+      for (uint32_t ch = 0; ch < m_ch_num; ch++)
+        {
+          float   *w = m_window + ch * width + m_taps - 1;
+          const T *x = in + ch;
+
+          for (uint32_t i = 0; i < n; i++)
+            {
+              w[i] = to_float(*x);
+              x   += m_ch_num;
+            }
+        }
+
+      /* Outputs whose newest input is in the window. Outputs never
+       * pass the unread input when the rate is not raised.
+       */
+
+      uint32_t filled = m_taps - 1 + n;
+
+      while (m_pos < filled)
+        {
+          if (written >= max_samples)
+            {
+              return -1;
+            }
+
+          const float *h = m_coef + m_phase * m_taps;
+          T *y = out + written * m_ch_num;
+
+          for (uint32_t ch = 0; ch < m_ch_num; ch++)
+            {
+              const float *w = m_window + ch * width + m_pos - (m_taps - 1);
+
+              from_float(dot_prod(h, w, m_taps), &y[ch]);
+            }
+
+          written++;
+
+          m_phase += m_down;
+          m_pos   += m_phase / m_up;
+          m_phase %= m_up;
+        }
+
+      /* Keep the last taps - 1 samples as history. */
+
+      for (uint32_t ch = 0; ch < m_ch_num; ch++)
+        {
+          float *w = m_window + ch * width;
+
+          memmove(w, w + n, sizeof(float) * (m_taps - 1));
+        }
+
+      m_pos   -= n;
+      in      += n * m_ch_num;
+      samples -= n;
+    }
+
+  return (int32_t)written;
+}
+
+/*--------------------------------------------------------------------*/
+int32_t PolyphaseSrc::exec(const void *in,
+                           uint32_t samples,
+                           void *out,
+                           uint32_t max_samples)
+{
+  if (m_coef == NULL)
+    {
+      return -1;
+    }
+
+  if (m_bytewidth == 2)
+    {
+      return execImpl(static_cast<const int16_t *>(in), samples,
+                      static_cast<int16_t *>(out), max_samples);
+    }
+
+  return execImpl(static_cast<const int32_t *>(in), samples,
+                  static_cast<int32_t *>(out), max_samples);
+}
+
+__WIEN2_END_NAMESPACE
@@ -0,0 +1,152 @@
+/****************************************************************************
+ * modules/audio/components/filter/polyphase_src.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#ifndef POLYPHASE_SRC_H
+#define POLYPHASE_SRC_H
+
+#include "wien2_common_defs.h"
+
+__WIEN2_BEGIN_NAMESPACE
+
+/*--------------------------------------------------------------------*/
+/* Polyphase sampling rate converter                                  */
+/*                                                                    */
+/* The ratio out_fs/in_fs is reduced to L/M, and each output sample   */
+/* is the dot product of one of L phases of a Kaiser windowed sinc    */
+/* and the last "taps" input samples. So only the outputs are         */
+/* calculated, not the L times upsampled signal. The DC gain of each  */
+/* phase is exactly 1.                                                */
+/*                                                                    */
+/* Samples are interleaved, int16_t for 16bit and int32_t (valid bits */
+/* at MSB side) for 24bit and 32bit. The output can be written over   */
+/* the input when the rate is not raised.                             */
+/* When CMSIS-DSP is enabled, the dot product is arm_dot_prod_f32().  */
+/*--------------------------------------------------------------------*/
+
+/* Maximum number of phases. 147 is for 48kHz to 44.1kHz. */
+
+#define POLYPHASE_SRC_MAX_PHASES  160
+
+/* Maximum taps of one phase. 144 is for 48kHz to 8kHz. */
+
+#define POLYPHASE_SRC_MAX_TAPS    192
+
+#define POLYPHASE_SRC_MAX_CH      8
+
+/* Number of input samples (per channel) processed at once. */
+
+#define POLYPHASE_SRC_BLOCK       64
+
+class PolyphaseSrc
+{
+public:
+  PolyphaseSrc()
+    : m_coef(NULL)
+    , m_window(NULL)
+  {
+    clear();
+  }
+
+  ~PolyphaseSrc()
+  {
+    release();
+  }
+
+  /* Design the filter and allocate the buffers.
+   * "bytewidth" is 2 or 4. Return false if the ratio or the format
+   * is not supported or memory is short.
+   */
+
+  bool init(uint32_t in_fs,
+            uint32_t out_fs,
+            uint8_t  ch_num,
+            uint8_t  bytewidth);
+
+  void release(void);
+
+  /* Clear the history. */
+
+  void reset(void);
+
+  /* Convert "samples" (per channel) in "in" to "out", which can hold
+   * "max_samples". Return the number of output samples, or -1 if
+   * "out" is short.
+   */
+
+  int32_t exec(const void *in,
+               uint32_t samples,
+               void *out,
+               uint32_t max_samples);
+
+  /* Maximum output samples for "samples" input samples. */
+
+  uint32_t get_max_output(uint32_t samples) const
+  {
+    return (uint32_t)(((uint64_t)samples * m_up + m_down - 1) / m_down) + 1;
+  }
+
+  /* Bytes of one sample of all channels. */
+
+  uint32_t get_frame_size(void) const { return m_ch_num * m_bytewidth; }
+
+  bool is_upsampling(void) const { return m_up > m_down; }
+  uint32_t get_up(void) const { return m_up; }
+  uint32_t get_down(void) const { return m_down; }
+  uint32_t get_taps(void) const { return m_taps; }
+
+private:
+  float   *m_coef;    /* [m_up][m_taps], taps in time order */
+  float   *m_window;  /* [m_ch_num][m_taps - 1 + POLYPHASE_SRC_BLOCK] */
+
+  uint32_t m_up;      /* L */
+  uint32_t m_down;    /* M */
+  uint32_t m_taps;
+  uint32_t m_phase;   /* Phase of the next output, 0 to L-1 */
+  uint32_t m_pos;     /* Newest input of the next output in window */
+  uint8_t  m_ch_num;
+  uint8_t  m_bytewidth;
+
+  void clear(void);
+  void design(void);
+
+  template <typename T>
+  int32_t execImpl(const T *in, uint32_t samples,
+                   T *out, uint32_t max_samples);
+};
+
+__WIEN2_END_NAMESPACE
+
+#endif /* POLYPHASE_SRC_H */
@@ -0,0 +1,276 @@
+/****************************************************************************
+ * modules/audio/components/filter/soft_src_component.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "components/filter/soft_src_component.h"
+
+__WIEN2_BEGIN_NAMESPACE
+
+/*--------------------------------------------------------------------*/
+/* Methods of SoftSRCComponent class */
+/*--------------------------------------------------------------------*/
+uint32_t SoftSRCComponent::activate(ComponentCallback callback,
+                                    const char *image_name,
+                                    void *p_requester,
+                                    uint32_t *dsp_inf)
+{
+  FILTER_DBG("ACT SOFT SRC:\n");
+
+  /* No DSP is loaded, so "image_name" is not used. */
+
+  m_p_requester = p_requester;
+  m_callback = callback;
+
+  *dsp_inf = 0;
+
+  return AS_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------*/
+bool SoftSRCComponent::deactivate(void)
+{
+  FILTER_DBG("DEACT SOFT SRC:\n");
+
+  m_src.release();
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+uint32_t SoftSRCComponent::init(const InitComponentParam& param)
+{
+  FILTER_DBG("INIT SOFT SRC: sample num %d, fs <in %d/out %d>, "
+             "byte len <in %d/out %d>, ch num %d\n",
+             param.fixparam.samples, param.fixparam.in_fs,
+             param.fixparam.out_fs,
+             param.fixparam.in_bitlength,
+             param.fixparam.out_bitlength, param.fixparam.ch_num);
+
+  /* Hold dummy, which is taken by recv_done() after init. */
+
+  AsPcmDataParam dummy;
+
+  if (!m_req_que.push(dummy))
+    {
+      return AS_ECODE_QUEUE_OPERATION_ERROR;
+    }
+
+  /* The bit length is not converted. 24bit is in 4 bytes. */
+
+  if (param.fixparam.in_bitlength != param.fixparam.out_bitlength)
+    {
+      return AS_ECODE_COMMAND_PARAM_BIT_LENGTH;
+    }
+
+  if ((param.fixparam.ch_num == 0)
+   || (param.fixparam.ch_num > POLYPHASE_SRC_MAX_CH))
+    {
+      return AS_ECODE_COMMAND_PARAM_CHANNEL_NUMBER;
+    }
+
+  uint8_t bytewidth = (param.fixparam.in_bitlength == AS_BITLENGTH_16) ?
+                        2 : 4;
+
+  if (!m_src.init(param.fixparam.in_fs,
+                  param.fixparam.out_fs,
+                  param.fixparam.ch_num,
+                  bytewidth))
+    {
+      FILTER_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
+      return AS_ECODE_FILTER_LIB_INITIALIZE_ERROR;
+    }
+
+  return AS_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------*/
+bool SoftSRCComponent::set(const SetComponentParam& param)
+{
+  /* Hold dummy */
+
+  AsPcmDataParam dummy;
+
+  if (!m_req_que.push(dummy))
+    {
+      return false;
+    }
+
+  /* Call reply callback function */
+
+  send_resp(ComponentSet, true);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+bool SoftSRCComponent::exec(const ExecComponentParam& param)
+{
+  int32_t out_samples = -1;
+
+  /* Filter data area check */
+
+  if ((param.input.mh.getPa() == NULL)
+   || (param.output_mh.getPa() == NULL))
+    {
+      FILTER_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
+      return false;
+    }
+
+  /* Upsampling can not be done in place, because the output passes
+   * the input which is not read yet.
+   */
+
+  uint32_t frame_size = m_src.get_frame_size();
+
+  if (m_src.is_upsampling()
+   && (param.input.mh.getPa() == param.output_mh.getPa()))
+    {
+      FILTER_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
+    }
+  else if (frame_size > 0)
+    {
+      out_samples = m_src.exec(param.input.mh.getPa(),
+                               param.input.size / frame_size,
+                               param.output_mh.getPa(),
+                               param.output_mh.getSize() / frame_size);
+    }
+
+  bool result = (out_samples >= 0);
+
+  /* Hold result */
+
+  AsPcmDataParam output = param.input;
+
+  output.mh       = param.output_mh;
+  output.sample   = (result) ? out_samples : 0;
+  output.size     = output.sample * frame_size;
+  output.is_valid = result;
+
+  if (!m_req_que.push(output))
+    {
+      FILTER_ERR(AS_ATTENTION_SUB_CODE_QUEUE_PUSH_ERROR);
+      return false;
+    }
+
+  /* Send response */
+
+  send_resp(ComponentExec, result);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+bool SoftSRCComponent::flush(const FlushComponentParam& param)
+{
+  FILTER_DBG("FLUSH SOFT SRC:\n");
+
+  /* The samples in the filter are not output. Clear the history for
+   * the next start.
+   */
+
+  m_src.reset();
+
+  /* Hold result */
+
+  AsPcmDataParam output;
+
+  output.mh       = param.output_mh;
+  output.sample   = 0;
+  output.size     = 0;
+  output.is_valid = true;
+
+  if (!m_req_que.push(output))
+    {
+      FILTER_ERR(AS_ATTENTION_SUB_CODE_QUEUE_PUSH_ERROR);
+      return false;
+    }
+
+  /* Send response */
+
+  send_resp(ComponentFlush, true);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+bool SoftSRCComponent::recv_done(ComponentCmpltParam *cmplt)
+{
+  /* Set output pcm parameters (even if is not there) */
+
+  cmplt->output = m_req_que.top();
+
+  /* Set result */
+
+  cmplt->result = cmplt->output.is_valid;
+
+  if (!m_req_que.pop())
+    {
+      FILTER_ERR(AS_ATTENTION_SUB_CODE_QUEUE_POP_ERROR);
+      return false;
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+bool SoftSRCComponent::recv_done(ComponentInformParam *info)
+{
+  return recv_done();
+}
+
+/*--------------------------------------------------------------------*/
+bool SoftSRCComponent::recv_done(void)
+{
+  if (!m_req_que.pop())
+    {
+      FILTER_ERR(AS_ATTENTION_SUB_CODE_QUEUE_POP_ERROR);
+      return false;
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+void SoftSRCComponent::send_resp(ComponentEventType evt, bool result)
+{
+  ComponentCbParam cbpram;
+
+  cbpram.event_type = evt;
+  cbpram.result     = result;
+
+  m_callback(&cbpram, m_p_requester);
+}
+
+__WIEN2_END_NAMESPACE
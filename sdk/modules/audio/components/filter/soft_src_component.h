@@ -0,0 +1,98 @@
+/****************************************************************************
+ * modules/audio/components/filter/soft_src_component.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#ifndef SOFT_SRC_COMPONENT_H
+#define SOFT_SRC_COMPONENT_H
+
+
+#include "wien2_common_defs.h"
+#include "debug/dbg_log.h"
+#include "memutils/s_stl/queue.h"
+#include "components/common/component_base.h"
+#include "components/filter/polyphase_src.h"
+
+__WIEN2_BEGIN_NAMESPACE
+using namespace MemMgrLite;
+
+/*--------------------------------------------------------------------*/
+/* Data structure definitions                                         */
+/*--------------------------------------------------------------------*/
+
+
+/*--------------------------------------------------------------------*/
+/* Class definitions                                                  */
+/*--------------------------------------------------------------------*/
+
+/* Sampling rate converter which runs on the calling core.
+ * It is used in place of SRCComponent, and no DSP is loaded.
+ */
+
+class SoftSRCComponent : public ComponentBase
+{
+private:
+
+  /* Request queue */
+
+  static const uint32_t ReqQueueSize = 7;
+
+  s_std::Queue<AsPcmDataParam, ReqQueueSize> m_req_que;
+
+  PolyphaseSrc m_src;
+
+  void send_resp(ComponentEventType evt, bool result);
+
+public:
+
+  SoftSRCComponent() {}
+  ~SoftSRCComponent() {}
+
+  virtual uint32_t init(const InitComponentParam& param);
+  virtual bool exec(const ExecComponentParam& param);
+  virtual bool flush(const FlushComponentParam& param);
+  virtual bool set(const SetComponentParam& param);
+  virtual bool recv_done(ComponentCmpltParam *cmplt);
+  virtual bool recv_done(ComponentInformParam *info);
+  virtual bool recv_done(void);
+  virtual uint32_t activate(ComponentCallback callback,
+                            const char *image_name,
+                            void *p_requester,
+                            uint32_t *dsp_inf);
+  virtual bool deactivate();
+};
+
+__WIEN2_END_NAMESPACE
+
+#endif /* SOFT_SRC_COMPONENT_H */
@@ -0,0 +1,363 @@
+/****************************************************************************
+ * modules/audio/components/filter/tool/host/packing_bench.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Bit-exact test and benchmark of the PCM packing kernels on the host.
+ *
+ * Each kernel is compared with a per-sample reference conversion for
+ * 0 to TEST_MAX_SAMPLES samples (all tail lengths), and the bytes after
+ * the output are checked not to be written. Then the time of one
+ * 192kHz stereo frame (1024 samples/ch) is measured for the kernels,
+ * the reference and the former 4-samples loop of PackingComponent.
+ * "packing_bench -t" runs only the test.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "components/filter/pcm_packing.h"
+
+using namespace Wien2;
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TEST_MAX_SAMPLES  67
+#define TEST_GUARD_BYTES  16
+#define TEST_GUARD_VALUE  0xa5
+
+#define BENCH_FRAME_SAMPLES  (1024 * 2)
+#define BENCH_REPEAT         20000
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint32_t s_in[BENCH_FRAME_SAMPLES + 4];
+static uint32_t s_in2[BENCH_FRAME_SAMPLES + 4];
+static uint32_t s_out[BENCH_FRAME_SAMPLES * 2 + TEST_GUARD_BYTES / 4];
+static uint32_t s_out2[BENCH_FRAME_SAMPLES * 2 + TEST_GUARD_BYTES / 4];
+static uint32_t s_ref[BENCH_FRAME_SAMPLES * 2 + TEST_GUARD_BYTES / 4];
+static uint32_t s_ref2[BENCH_FRAME_SAMPLES * 2 + TEST_GUARD_BYTES / 4];
+
+/****************************************************************************
+ * Reference conversions
+ ****************************************************************************/
+
+/* Sample at index as a MSB aligned 32bit value. */
+
+static uint32_t ref_get(int bits, const void *buf, uint32_t index)
+{
+  const uint8_t *p = static_cast<const uint8_t *>(buf) + index * (bits / 8);
+
+  switch (bits)
+    {
+      case 16:
+        return (uint32_t)p[0] << 16 | (uint32_t)p[1] << 24;
+      case 24:
+        return (uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 24;
+      default:
+        return (uint32_t)p[0] | (uint32_t)p[1] << 8 |
+               (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+    }
+}
+
+static void ref_put(int bits, void *buf, uint32_t index, uint32_t value)
+{
+  uint8_t *p = static_cast<uint8_t *>(buf) + index * (bits / 8);
+
+  for (int i = 0; i < bits / 8; i++)
+    {
+      p[i] = (uint8_t)(value >> (32 - bits + i * 8));
+    }
+}
+
+static void ref_pack(int in_bits, int out_bits, uint32_t samples,
+                     const void *in, void *out)
+{
+  for (uint32_t i = 0; i < samples; i++)
+    {
+      ref_put(out_bits, out, i, ref_get(in_bits, in, i));
+    }
+}
+
+static void ref_interleave(int bits, uint32_t frames,
+                           const void *in_l, const void *in_r, void *out)
+{
+  for (uint32_t i = 0; i < frames; i++)
+    {
+      ref_put(bits, out, i * 2,     ref_get(bits, in_l, i));
+      ref_put(bits, out, i * 2 + 1, ref_get(bits, in_r, i));
+    }
+}
+
+static void ref_deinterleave(int bits, uint32_t frames,
+                             const void *in, void *out_l, void *out_r)
+{
+  for (uint32_t i = 0; i < frames; i++)
+    {
+      ref_put(bits, out_l, i, ref_get(bits, in, i * 2));
+      ref_put(bits, out_r, i, ref_get(bits, in, i * 2 + 1));
+    }
+}
+
+/* Former PackingComponent::cnv32to24(). The tail is not converted. */
+
+static void old_cnv32to24(uint32_t samples, int8_t *in, int8_t *out)
+{
+  uint32_t *p_in  = (uint32_t *)in;
+  uint32_t *p_out = (uint32_t *)out;
+
+  for (uint32_t cnt = 0; cnt < samples / 4; cnt++)
+    {
+      *(p_out+0) = (uint32_t)(((*(p_in+0) & 0xFFFFFF00) >> 8 ) + ((*(p_in+1) & 0x0000FF00) << 16));
+      *(p_out+1) = (uint32_t)(((*(p_in+1) & 0xFFFF0000) >> 16) + ((*(p_in+2) & 0x00FFFF00) << 8 ));
+      *(p_out+2) = (uint32_t)(((*(p_in+2) & 0xFF000000) >> 24) + ((*(p_in+3) & 0xFFFFFF00) >> 0 ));
+
+      p_out +=3;
+      p_in  +=4;
+    }
+}
+
+/****************************************************************************
+ * Test
+ ****************************************************************************/
+
+static void fill_random(void *buf, size_t size)
+{
+  uint8_t *p = static_cast<uint8_t *>(buf);
+
+  for (size_t i = 0; i < size; i++)
+    {
+      p[i] = (uint8_t)rand();
+    }
+}
+
+static bool check(const char *name, uint32_t n, const void *out,
+                  const void *ref, size_t size)
+{
+  const uint8_t *p = static_cast<const uint8_t *>(out);
+
+  if (memcmp(out, ref, size) != 0)
+    {
+      printf("NG: %s n=%u differs from reference\n", name, n);
+      return false;
+    }
+
+  for (size_t i = size; i < size + TEST_GUARD_BYTES; i++)
+    {
+      if (p[i] != TEST_GUARD_VALUE)
+        {
+          printf("NG: %s n=%u writes beyond output\n", name, n);
+          return false;
+        }
+    }
+
+  return true;
+}
+
+static int test_pack(const char *name, int in_bits, int out_bits,
+                     PcmPackFunc func)
+{
+  int errors = 0;
+
+  for (uint32_t n = 0; n <= TEST_MAX_SAMPLES; n++)
+    {
+      size_t out_size = n * (out_bits / 8);
+
+      fill_random(s_in, sizeof(s_in));
+      memset(s_out, TEST_GUARD_VALUE, sizeof(s_out));
+      memset(s_ref, TEST_GUARD_VALUE, sizeof(s_ref));
+
+      func(n, s_in, s_out);
+      ref_pack(in_bits, out_bits, n, s_in, s_ref);
+
+      errors += check(name, n, s_out, s_ref, out_size) ? 0 : 1;
+    }
+
+  printf("%-20s %s\n", name, errors ? "NG" : "OK");
+  return errors;
+}
+
+static int test_interleave(const char *name, int bits, bool deinterleave)
+{
+  int errors = 0;
+
+  for (uint32_t n = 0; n <= TEST_MAX_SAMPLES; n++)
+    {
+      size_t size = n * (bits / 8);
+
+      fill_random(s_in, sizeof(s_in));
+      fill_random(s_in2, sizeof(s_in2));
+      memset(s_out, TEST_GUARD_VALUE, sizeof(s_out));
+      memset(s_out2, TEST_GUARD_VALUE, sizeof(s_out2));
+      memset(s_ref, TEST_GUARD_VALUE, sizeof(s_ref));
+      memset(s_ref2, TEST_GUARD_VALUE, sizeof(s_ref2));
+
+      if (deinterleave)
+        {
+          if (bits == 16)
+            {
+              PcmDeinterleave16(n, s_in, s_out, s_out2);
+            }
+          else if (bits == 24)
+            {
+              PcmDeinterleave24(n, s_in, s_out, s_out2);
+            }
+          else
+            {
+              PcmDeinterleave32(n, s_in, s_out, s_out2);
+            }
+
+          ref_deinterleave(bits, n, s_in, s_ref, s_ref2);
+
+          errors += check(name, n, s_out, s_ref, size) ? 0 : 1;
+          errors += check(name, n, s_out2, s_ref2, size) ? 0 : 1;
+        }
+      else
+        {
+          if (bits == 16)
+            {
+              PcmInterleave16(n, s_in, s_in2, s_out);
+            }
+          else if (bits == 24)
+            {
+              PcmInterleave24(n, s_in, s_in2, s_out);
+            }
+          else
+            {
+              PcmInterleave32(n, s_in, s_in2, s_out);
+            }
+
+          ref_interleave(bits, n, s_in, s_in2, s_ref);
+
+          errors += check(name, n, s_out, s_ref, size * 2) ? 0 : 1;
+        }
+    }
+
+  printf("%-20s %s\n", name, errors ? "NG" : "OK");
+  return errors;
+}
+
+/****************************************************************************
+ * Benchmark
+ ****************************************************************************/
+
+static uint64_t now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+#define BENCH(label, expr) \
+  do \
+    { \
+      uint64_t start = now_ns(); \
+      for (int i = 0; i < BENCH_REPEAT; i++) \
+        { \
+          expr; \
+          __asm__ __volatile__ ("" : : "r" (s_out) : "memory"); \
+        } \
+      uint64_t elapsed = now_ns() - start; \
+      printf("%-20s %8.3f ns/sample\n", label, \
+             (double)elapsed / BENCH_REPEAT / BENCH_FRAME_SAMPLES); \
+    } \
+  while (0)
+
+static void bench(void)
+{
+  const uint32_t n = BENCH_FRAME_SAMPLES;
+
+  fill_random(s_in, sizeof(s_in));
+  fill_random(s_in2, sizeof(s_in2));
+
+  printf("\n%u samples x %d\n", n, BENCH_REPEAT);
+
+  BENCH("old cnv32to24", old_cnv32to24(n, (int8_t *)s_in, (int8_t *)s_out));
+  BENCH("ref 32to24",    ref_pack(32, 24, n, s_in, s_out));
+  BENCH("PcmPack32to24", PcmPack32to24(n, s_in, s_out));
+  BENCH("PcmPack24to32", PcmPack24to32(n, s_in, s_out));
+  BENCH("PcmPack32to16", PcmPack32to16(n, s_in, s_out));
+  BENCH("PcmPack16to32", PcmPack16to32(n, s_in, s_out));
+  BENCH("PcmPack24to16", PcmPack24to16(n, s_in, s_out));
+  BENCH("PcmPack16to24", PcmPack16to24(n, s_in, s_out));
+  BENCH("ref interleave16",  ref_interleave(16, n / 2, s_in, s_in2, s_out));
+  BENCH("PcmInterleave16",   PcmInterleave16(n / 2, s_in, s_in2, s_out));
+  BENCH("PcmDeinterleave16", PcmDeinterleave16(n / 2, s_in, s_out, s_out2));
+  BENCH("PcmInterleave24",   PcmInterleave24(n / 2, s_in, s_in2, s_out));
+  BENCH("PcmDeinterleave24", PcmDeinterleave24(n / 2, s_in, s_out, s_out2));
+  BENCH("PcmInterleave32",   PcmInterleave32(n / 2, s_in, s_in2, s_out));
+  BENCH("PcmDeinterleave32", PcmDeinterleave32(n / 2, s_in, s_out, s_out2));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  int errors = 0;
+
+  srand(1);
+
+  errors += test_pack("PcmPack32to24", 32, 24, PcmPack32to24);
+  errors += test_pack("PcmPack24to32", 24, 32, PcmPack24to32);
+  errors += test_pack("PcmPack32to16", 32, 16, PcmPack32to16);
+  errors += test_pack("PcmPack16to32", 16, 32, PcmPack16to32);
+  errors += test_pack("PcmPack24to16", 24, 16, PcmPack24to16);
+  errors += test_pack("PcmPack16to24", 16, 24, PcmPack16to24);
+  errors += test_interleave("PcmInterleave16",   16, false);
+  errors += test_interleave("PcmDeinterleave16", 16, true);
+  errors += test_interleave("PcmInterleave24",   24, false);
+  errors += test_interleave("PcmDeinterleave24", 24, true);
+  errors += test_interleave("PcmInterleave32",   32, false);
+  errors += test_interleave("PcmDeinterleave32", 32, true);
+
+  if (errors)
+    {
+      printf("%d errors\n", errors);
+      return 1;
+    }
+
+  if (argc < 2 || strcmp(argv[1], "-t") != 0)
+    {
+      bench();
+    }
+
+  return 0;
+}
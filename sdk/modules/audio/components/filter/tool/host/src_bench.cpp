@@ -0,0 +1,625 @@
+/****************************************************************************
+ * modules/audio/components/filter/tool/host/src_bench.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/* Test and benchmark of the polyphase sampling rate converter on the
+ * host.
+ *
+ * For each conversion, the output of PolyphaseSrc is compared with the
+ * textbook way (zero stuffing, FIR at L times of the input rate, and
+ * decimation) with the same prototype filter, and THD+N of a 1kHz tone,
+ * the passband gain, the rejection of a tone above the output Nyquist
+ * frequency, the DC gain and the number of output samples are checked.
+ * Frames of random size must give the same output as one frame, and
+ * in-place conversion the same output as out-of-place one.
+ * Then CPU time per second of stereo audio is measured for both ways.
+ * "src_bench -t" runs only the test.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <vector>
+
+#include "components/filter/polyphase_src.h"
+
+using namespace Wien2;
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CH_NUM            2
+#define FRAME_SAMPLES     1024    /* Input samples of one frame */
+#define TEST_SEC          1.0
+#define BENCH_SEC         10.0
+
+#define TONE_HZ           1000.0
+#define TONE_AMP          16000.0
+
+#define THDN_LIMIT_DB     (-75.0)
+#define REJECT_LIMIT_DB   (-65.0)
+#define PASSBAND_LIMIT_DB 0.1
+
+/* Same as polyphase_src.cpp */
+
+#define SRC_KAISER_BETA   7.2
+#define SRC_CUTOFF        0.45
+
+#define CHECK(cond) \
+  do \
+    { \
+      if (!(cond)) \
+        { \
+          printf("  NG: %s (line %d)\n", #cond, __LINE__); \
+          return 1; \
+        } \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct Conversion
+{
+  uint32_t in_fs;
+  uint32_t out_fs;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const Conversion s_conversions[] =
+{
+  {  48000, 16000 },
+  {  48000,  8000 },
+  {  48000, 32000 },
+  {  48000, 44100 },
+  { 192000, 48000 },
+  {  16000, 48000 },
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static std::vector<int16_t> make_tone(uint32_t fs,
+                                      double freq,
+                                      double amp,
+                                      uint32_t samples)
+{
+  std::vector<int16_t> pcm(samples * CH_NUM);
+
+  for (uint32_t i = 0; i < samples; i++)
+    {
+      int16_t v = (int16_t)lrint(amp * sin(2.0 * M_PI * freq * i / fs));
+
+      pcm[i * CH_NUM]     = v;
+      pcm[i * CH_NUM + 1] = (int16_t)-v;
+    }
+
+  return pcm;
+}
+
+/*--------------------------------------------------------------------------*/
+static std::vector<int16_t> convert(PolyphaseSrc &src,
+                                    const std::vector<int16_t> &in,
+                                    uint32_t frame)
+{
+  uint32_t samples = in.size() / CH_NUM;
+  std::vector<int16_t> out;
+  std::vector<int16_t> buf(src.get_max_output(frame) * CH_NUM);
+
+  for (uint32_t pos = 0; pos < samples; pos += frame)
+    {
+      uint32_t n = (samples - pos < frame) ? (samples - pos) : frame;
+      int32_t  m = src.exec(&in[pos * CH_NUM], n,
+                            &buf[0], src.get_max_output(n));
+
+      if (m < 0)
+        {
+          out.clear();
+          break;
+        }
+
+      out.insert(out.end(), buf.begin(), buf.begin() + m * CH_NUM);
+    }
+
+  return out;
+}
+
+/*--------------------------------------------------------------------------*/
+static double bessel_i0(double x)
+{
+  double sum  = 1.0;
+  double term = 1.0;
+
+  for (int k = 1; k < 50; k++)
+    {
+      term *= (x / (2.0 * k)) * (x / (2.0 * k));
+      sum  += term;
+    }
+
+  return sum;
+}
+
+/*--------------------------------------------------------------------------*/
+static void design_reference(PolyphaseSrc &src, std::vector<double> *h)
+{
+  /* The prototype of polyphase_src.cpp, indexed by the delay at L
+   * times of the input rate, with each phase normalized.
+   */
+
+  uint32_t up     = src.get_up();
+  uint32_t down   = src.get_down();
+  uint32_t taps   = src.get_taps();
+  uint32_t high   = (up > down) ? up : down;
+  uint32_t length = up * taps;
+  double   center = (double)(length - 1) / 2.0;
+  double   fc     = SRC_CUTOFF / high;
+  std::vector<double> sum(up, 0.0);
+
+  h->resize(length);
+
+  for (uint32_t n = 0; n < length; n++)
+    {
+      double t = (double)n - center;
+      double r = t / (center + 0.5);
+      double sinc = (t == 0.0) ?
+                      1.0 : sin(2.0 * M_PI * fc * t) / (2.0 * M_PI * fc * t);
+      double win = (r * r < 1.0) ?
+                     bessel_i0(SRC_KAISER_BETA * sqrt(1.0 - r * r)) /
+                     bessel_i0(SRC_KAISER_BETA) : 0.0;
+
+      (*h)[n] = sinc * win;
+      sum[n % up] += (*h)[n];
+    }
+
+  for (uint32_t n = 0; n < length; n++)
+    {
+      (*h)[n] /= sum[n % up];
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static std::vector<int16_t> convert_reference(PolyphaseSrc &src,
+                                              const std::vector<double> &h,
+                                              const std::vector<int16_t> &in)
+{
+  /* Textbook way. Output k is at k * M of the zero stuffed signal,
+   * and all the taps are calculated including zeros.
+   */
+
+  uint32_t up      = src.get_up();
+  uint32_t down    = src.get_down();
+  uint64_t samples = in.size() / CH_NUM;
+  uint64_t stuffed = samples * up;
+  std::vector<int16_t> out;
+
+  for (uint64_t pos = 0; pos < stuffed; pos += down)
+    {
+      for (uint32_t ch = 0; ch < CH_NUM; ch++)
+        {
+          double acc = 0.0;
+
+          for (uint32_t m = 0; m < h.size() && m <= pos; m++)
+            {
+              uint64_t u = pos - m;
+              double   v = (u % up == 0) ? in[(u / up) * CH_NUM + ch] : 0.0;
+
+              acc += h[m] * v;
+            }
+
+          out.push_back((int16_t)lrint(acc));
+        }
+    }
+
+  return out;
+}
+
+/*--------------------------------------------------------------------------*/
+static double fit_residual_db(const std::vector<int16_t> &x,
+                              uint32_t skip,
+                              double freq,
+                              double *amp)
+{
+  /* Least squares fit of a*cos + b*sin + c at "freq" [cycle/sample] to
+   * the left channel, return the residual relative to the tone.
+   */
+
+  double m[3][4] = { { 0 } };
+  size_t n = x.size() / CH_NUM;
+
+  for (size_t i = skip; i < n; i++)
+    {
+      double w = 2.0 * M_PI * freq * (double)i;
+      double v[3] = { cos(w), sin(w), 1.0 };
+
+      for (int r = 0; r < 3; r++)
+        {
+          for (int c = 0; c < 3; c++)
+            {
+              m[r][c] += v[r] * v[c];
+            }
+
+          m[r][3] += v[r] * x[i * CH_NUM];
+        }
+    }
+
+  for (int p = 0; p < 3; p++)
+    {
+      for (int r = 0; r < 3; r++)
+        {
+          if (r != p)
+            {
+              double k = m[r][p] / m[p][p];
+
+              for (int c = p; c < 4; c++)
+                {
+                  m[r][c] -= k * m[p][c];
+                }
+            }
+        }
+    }
+
+  double a = m[0][3] / m[0][0];
+  double b = m[1][3] / m[1][1];
+  double c0 = m[2][3] / m[2][2];
+  double res = 0.0;
+
+  for (size_t i = skip; i < n; i++)
+    {
+      double w = 2.0 * M_PI * freq * (double)i;
+      double e = x[i * CH_NUM] - (a * cos(w) + b * sin(w) + c0);
+
+      res += e * e;
+    }
+
+  *amp = sqrt(a * a + b * b);
+
+  return 10.0 * log10(res / ((a * a + b * b) / 2.0 * (double)(n - skip)));
+}
+
+/*--------------------------------------------------------------------------*/
+static double rms_db(const std::vector<int16_t> &x, uint32_t skip, double ref)
+{
+  double sum = 0.0;
+  size_t n = x.size() / CH_NUM;
+
+  for (size_t i = skip; i < n; i++)
+    {
+      sum += (double)x[i * CH_NUM] * x[i * CH_NUM];
+    }
+
+  return 10.0 * log10(sum / (double)(n - skip) / (ref * ref / 2.0));
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_conversion(const Conversion &cnv)
+{
+  PolyphaseSrc src;
+  uint32_t in_samples = (uint32_t)(cnv.in_fs * TEST_SEC);
+  uint32_t lower = (cnv.in_fs < cnv.out_fs) ? cnv.in_fs : cnv.out_fs;
+
+  CHECK(src.init(cnv.in_fs, cnv.out_fs, CH_NUM, sizeof(int16_t)));
+
+  /* Outputs until the history is filled. */
+
+  uint32_t skip = src.get_max_output(src.get_taps());
+
+  /* 1kHz tone. */
+
+  std::vector<int16_t> tone = make_tone(cnv.in_fs, TONE_HZ, TONE_AMP,
+                                        in_samples);
+  std::vector<int16_t> out = convert(src, tone, FRAME_SAMPLES);
+  double amp;
+  double thdn = fit_residual_db(out, skip, TONE_HZ / cnv.out_fs, &amp);
+
+  /* Number of outputs is ceil(in * L / M). */
+
+  uint64_t expect = ((uint64_t)in_samples * src.get_up() +
+                     src.get_down() - 1) / src.get_down();
+
+  CHECK(out.size() / CH_NUM == expect);
+  CHECK(thdn < THDN_LIMIT_DB);
+
+  /* Right channel is inverted left. */
+
+  for (size_t i = 0; i < out.size(); i += CH_NUM)
+    {
+      CHECK(abs(out[i] + out[i + 1]) <= 1);
+    }
+
+  /* Random frame sizes. */
+
+  src.reset();
+
+  std::vector<int16_t> out2;
+
+  for (uint32_t pos = 0; pos < in_samples; )
+    {
+      uint32_t n = 1 + rand() % (FRAME_SAMPLES * 2);
+      std::vector<int16_t> part;
+
+      n = (in_samples - pos < n) ? (in_samples - pos) : n;
+      part.assign(tone.begin() + pos * CH_NUM,
+                  tone.begin() + (pos + n) * CH_NUM);
+
+      std::vector<int16_t> conv = convert(src, part, n);
+
+      out2.insert(out2.end(), conv.begin(), conv.end());
+      pos += n;
+    }
+
+  CHECK(out2 == out);
+
+  /* In place, when the rate is not raised. */
+
+  if (!src.is_upsampling())
+    {
+      std::vector<int16_t> buf = tone;
+      uint32_t written = 0;
+
+      src.reset();
+
+      for (uint32_t pos = 0; pos < in_samples; pos += FRAME_SAMPLES)
+        {
+          uint32_t n = (in_samples - pos < FRAME_SAMPLES) ?
+                         (in_samples - pos) : FRAME_SAMPLES;
+          int16_t *frame = &buf[pos * CH_NUM];
+          int32_t  m = src.exec(frame, n, frame, n);
+
+          CHECK(m >= 0);
+          CHECK(memcmp(frame, &out[written * CH_NUM],
+                       m * CH_NUM * sizeof(int16_t)) == 0);
+          written += m;
+        }
+    }
+
+  /* Textbook way with the same filter, for a short part. */
+
+  std::vector<double> h;
+
+  design_reference(src, &h);
+
+  std::vector<int16_t> head(tone.begin(),
+                            tone.begin() + FRAME_SAMPLES * CH_NUM);
+  std::vector<int16_t> ref = convert_reference(src, h, head);
+
+  src.reset();
+
+  std::vector<int16_t> out3 = convert(src, head, FRAME_SAMPLES);
+
+  CHECK(ref.size() == out3.size());
+
+  for (size_t i = 0; i < ref.size(); i++)
+    {
+      CHECK(abs(ref[i] - out3[i]) <= 1);
+    }
+
+  /* Passband gain at 0.3 of the lower rate. */
+
+  double pass_hz = lower * 0.3;
+
+  src.reset();
+  out = convert(src, make_tone(cnv.in_fs, pass_hz, TONE_AMP, in_samples),
+                FRAME_SAMPLES);
+  fit_residual_db(out, skip, pass_hz / cnv.out_fs, &amp);
+
+  double pass_db = 20.0 * log10(amp / TONE_AMP);
+
+  CHECK(fabs(pass_db) < PASSBAND_LIMIT_DB);
+
+  /* Tone above the output Nyquist frequency is rejected, if it is in
+   * the stopband and the input can have it.
+   */
+
+  double reject_db = -200.0;
+
+  if (cnv.out_fs * 0.6 < cnv.in_fs * 0.5)
+    {
+      src.reset();
+      out = convert(src, make_tone(cnv.in_fs, cnv.out_fs * 0.6, TONE_AMP,
+                                   in_samples),
+                    FRAME_SAMPLES);
+      reject_db = rms_db(out, skip, TONE_AMP);
+
+      CHECK(reject_db < REJECT_LIMIT_DB);
+    }
+
+  /* DC gain is exactly 1. */
+
+  std::vector<int16_t> dc(in_samples * CH_NUM, 12345);
+
+  src.reset();
+  out = convert(src, dc, FRAME_SAMPLES);
+
+  for (size_t i = skip * CH_NUM; i < out.size(); i++)
+    {
+      CHECK(out[i] == 12345);
+    }
+
+  printf("  %6u -> %6u: L/M %3u/%3u, taps %3u, THD+N %6.1f dB, "
+         "passband %+.3f dB, ",
+         cnv.in_fs, cnv.out_fs, src.get_up(), src.get_down(),
+         src.get_taps(), thdn, pass_db);
+
+  if (reject_db > -200.0)
+    {
+      printf("rejection %6.1f dB\n", reject_db);
+    }
+  else
+    {
+      printf("rejection -\n");
+    }
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_int32(void)
+{
+  /* 24bit in 32bit (MSB side) gives the same result as 16bit. */
+
+  PolyphaseSrc src16;
+  PolyphaseSrc src32;
+  uint32_t samples = FRAME_SAMPLES * 4;
+
+  CHECK(src16.init(48000, 16000, CH_NUM, sizeof(int16_t)));
+  CHECK(src32.init(48000, 16000, CH_NUM, sizeof(int32_t)));
+
+  std::vector<int16_t> in16 = make_tone(48000, TONE_HZ, TONE_AMP, samples);
+  std::vector<int32_t> in32(in16.size());
+  std::vector<int16_t> out16(src16.get_max_output(samples) * CH_NUM);
+  std::vector<int32_t> out32(src32.get_max_output(samples) * CH_NUM);
+
+  for (size_t i = 0; i < in16.size(); i++)
+    {
+      in32[i] = (int32_t)in16[i] << 16;
+    }
+
+  int32_t n16 = src16.exec(&in16[0], samples, &out16[0], out16.size() / CH_NUM);
+  int32_t n32 = src32.exec(&in32[0], samples, &out32[0], out32.size() / CH_NUM);
+
+  CHECK(n16 > 0);
+  CHECK(n16 == n32);
+
+  for (int32_t i = 0; i < n16 * CH_NUM; i++)
+    {
+      CHECK(abs((out32[i] >> 16) - out16[i]) <= 1);
+    }
+
+  /* Short output buffer. */
+
+  CHECK(src16.exec(&in16[0], samples, &out16[0], 10) < 0);
+
+  /* Not supported. */
+
+  CHECK(!src16.init(192000, 8000, CH_NUM, sizeof(int16_t)));
+  CHECK(!src16.init(48000, 16000, POLYPHASE_SRC_MAX_CH + 1, sizeof(int16_t)));
+  CHECK(!src16.init(48000, 16000, CH_NUM, 3));
+
+  printf("  24bit and parameters: OK\n");
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static double now_sec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/*--------------------------------------------------------------------------*/
+static void bench(void)
+{
+  printf("bench (stereo 16bit, CPU time per second of audio):\n");
+
+  for (size_t i = 0; i < sizeof(s_conversions) / sizeof(s_conversions[0]); i++)
+    {
+      const Conversion &cnv = s_conversions[i];
+      PolyphaseSrc src;
+
+      src.init(cnv.in_fs, cnv.out_fs, CH_NUM, sizeof(int16_t));
+
+      std::vector<int16_t> tone =
+        make_tone(cnv.in_fs, TONE_HZ, TONE_AMP, (uint32_t)(cnv.in_fs * BENCH_SEC));
+
+      double start = now_sec();
+      std::vector<int16_t> out = convert(src, tone, FRAME_SAMPLES);
+      double poly = (now_sec() - start) / BENCH_SEC;
+
+      /* Textbook way takes long, so only 0.1 second. */
+
+      std::vector<double> h;
+      std::vector<int16_t> part(tone.begin(),
+                                tone.begin() + cnv.in_fs / 10 * CH_NUM);
+
+      design_reference(src, &h);
+      start = now_sec();
+      out = convert_reference(src, h, part);
+
+      double textbook = (now_sec() - start) / 0.1;
+
+      printf("  %6u -> %6u: polyphase %7.3f ms (%5.2f MMAC), "
+             "textbook %8.1f ms\n",
+             cnv.in_fs, cnv.out_fs, poly * 1000.0,
+             (double)src.get_taps() * cnv.out_fs * CH_NUM / 1e6,
+             textbook * 1000.0);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  srand(1);
+
+  printf("conversions:\n");
+
+  for (size_t i = 0; i < sizeof(s_conversions) / sizeof(s_conversions[0]); i++)
+    {
+      if (test_conversion(s_conversions[i]))
+        {
+          printf("Test NG\n");
+          return 1;
+        }
+    }
+
+  if (test_int32())
+    {
+      printf("Test NG\n");
+      return 1;
+    }
+
+  printf("All tests OK\n");
+
+  if (argc < 2 || strcmp(argv[1], "-t") != 0)
+    {
+      bench();
+    }
+
+  return 0;
+}
@@ -48,6 +48,17 @@ __WIEN2_BEGIN_NAMESPACE
 /* Equals to the Max. number of available DMAC resources. */
 #define MAX_RENDER_COMP_INSTANCE_NUM  CONFIG_AUDIOUTILS_RENDERER_CH_NUM
 
+/* Depth of DMA ready queue, and silent samples inserted at underflow.
+ * 0 means the default of the DMA driver.
+ */
+
+#ifndef CONFIG_AUDIOUTILS_RENDERER_READY_QUEUE_NUM
+#define CONFIG_AUDIOUTILS_RENDERER_READY_QUEUE_NUM 0
+#endif
+#ifndef CONFIG_AUDIOUTILS_RENDERER_UNDERFLOW_SAMPLE
+#define CONFIG_AUDIOUTILS_RENDERER_UNDERFLOW_SAMPLE 0
+#endif
+
 class RenderCompFactory
 {
 public:
@@ -781,6 +792,8 @@ bool RendererComponent::init(const RendererComponentParam& param)
   init_param.p_error_func   = m_dma_err_cb;
   init_param.fade_en        = true;
   init_param.p_dmadone_func = m_dma_done_cb;
+  init_param.ready_que_num  = CONFIG_AUDIOUTILS_RENDERER_READY_QUEUE_NUM;
+  init_param.underflow_sample = CONFIG_AUDIOUTILS_RENDERER_UNDERFLOW_SAMPLE;
 
   m_callback    = param.init_render_param.callback;
   m_p_requester = param.init_render_param.p_requester;
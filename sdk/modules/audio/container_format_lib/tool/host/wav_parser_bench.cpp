@@ -0,0 +1,581 @@
+/****************************************************************************
+ * modules/audio/container_format_lib/tool/host/wav_parser_bench.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test and benchmark of WavContainerFormatParser.
+ *
+ * WAV files with fmt variations, metadata chunks before and after the
+ * data chunk, odd chunk sizes, not updated sizes and broken headers
+ * are made in the working directory, and each is parsed both from the
+ * file and from memory. Then the time to open a WAV file which has a
+ * large LIST chunk before the data is measured, with the former way
+ * to skip a chunk (fread() of 1 byte each) as reference.
+ * "wav_parser_bench -t" runs only the test.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <vector>
+
+#include "audio/utilities/wav_containerformat_parser.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TEST_FILE   "wav_parser_test.wav"
+#define BENCH_FILE  "wav_parser_bench.wav"
+
+#define BENCH_META_SIZE  (8 * 1024 * 1024)
+#define BENCH_REPEAT     20
+
+#define CHECK(cond) \
+  do \
+    { \
+      if (!(cond)) \
+        { \
+          printf("  NG: %s (line %d)\n", #cond, __LINE__); \
+          return 1; \
+        } \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+typedef std::vector<uint8_t> Bytes;
+
+/****************************************************************************
+ * WAV builder
+ ****************************************************************************/
+
+static void put32(Bytes &b, uint32_t v)
+{
+  for (int i = 0; i < 4; i++)
+    {
+      b.push_back((uint8_t)(v >> (i * 8)));
+    }
+}
+
+static void put16(Bytes &b, uint16_t v)
+{
+  b.push_back((uint8_t)v);
+  b.push_back((uint8_t)(v >> 8));
+}
+
+static void add_chunk(Bytes &b, uint32_t id, const Bytes &body,
+                      uint32_t size_field)
+{
+  put32(b, id);
+  put32(b, size_field);
+  b.insert(b.end(), body.begin(), body.end());
+  if (body.size() & 1)
+    {
+      b.push_back(0);
+    }
+}
+
+static void add_chunk(Bytes &b, uint32_t id, const Bytes &body)
+{
+  add_chunk(b, id, body, body.size());
+}
+
+static Bytes make_fmt(uint16_t ch, uint32_t rate, uint16_t bit,
+                      uint32_t fmt_size)
+{
+  Bytes b;
+  uint16_t block = ch * bit / 8;
+
+  put16(b, WAVE_FORMAT_PCM);
+  put16(b, ch);
+  put32(b, rate);
+  put32(b, rate * block);
+  put16(b, block);
+  put16(b, bit);
+  while (b.size() < fmt_size)
+    {
+      b.push_back(0x5a);
+    }
+  return b;
+}
+
+static Bytes make_bytes(uint32_t size, uint32_t seed)
+{
+  Bytes b(size);
+
+  for (uint32_t i = 0; i < size; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      b[i] = (uint8_t)(seed >> 16);
+    }
+  return b;
+}
+
+static Bytes make_riff(const Bytes &chunks, uint32_t size_field)
+{
+  Bytes b;
+
+  put32(b, CHUNKID_RIFF);
+  put32(b, size_field);
+  put32(b, FORMAT_WAVE);
+  b.insert(b.end(), chunks.begin(), chunks.end());
+  return b;
+}
+
+static Bytes make_riff(const Bytes &chunks)
+{
+  return make_riff(chunks, chunks.size() + 4);
+}
+
+static bool write_file(const char *path, const Bytes &b)
+{
+  FILE *fp = fopen(path, "wb");
+
+  if (fp == NULL)
+    {
+      return false;
+    }
+
+  bool ret = (fwrite(b.data(), 1, b.size(), fp) == b.size());
+  fclose(fp);
+  return ret;
+}
+
+/****************************************************************************
+ * Test
+ ****************************************************************************/
+
+/* Parse from the file or from memory. The memory is kept in s_wav
+ * until the next call, so one handle can be used at a time.
+ */
+
+static Bytes s_wav;
+
+static handel_wav_parser open_wav(WavContainerFormatParser &parser,
+                                  const Bytes &wav,
+                                  bool from_mem,
+                                  fmt_chunk_t *fmt)
+{
+  if (from_mem)
+    {
+      s_wav = wav;
+      return parser.parseChunk(s_wav.data(), s_wav.size(), fmt);
+    }
+
+  if (!write_file(TEST_FILE, wav))
+    {
+      return NULL;
+    }
+  return parser.parseChunk(TEST_FILE, fmt);
+}
+
+static Bytes read_data(WavContainerFormatParser &parser,
+                       handel_wav_parser handle)
+{
+  Bytes b;
+  int8_t buf[1000];
+  int32_t ret;
+
+  while ((ret = parser.getDataChunk(handle, WAVE_FORMAT_PCM,
+                                    buf, sizeof(buf))) > 0)
+    {
+      b.insert(b.end(), buf, buf + ret);
+    }
+  return b;
+}
+
+static int test_basic(bool from_mem)
+{
+  WavContainerFormatParser parser;
+  fmt_chunk_t fmt;
+  Bytes data = make_bytes(4001 * 4, 1);
+  Bytes chunks;
+
+  add_chunk(chunks, SUBCHUNKID_FMT, make_fmt(2, 48000, 16, 16));
+  add_chunk(chunks, SUBCHUNKID_DATA, data);
+
+  handel_wav_parser h = open_wav(parser, make_riff(chunks), from_mem, &fmt);
+  CHECK(h != NULL);
+  CHECK(fmt.format == WAVE_FORMAT_PCM);
+  CHECK(fmt.channel == 2 && fmt.rate == 48000 && fmt.bit == 16);
+  CHECK(fmt.block == 4 && fmt.extended_size == 0);
+
+  chunk_list_t list;
+  CHECK(parser.getChunkList(h, &list));
+  CHECK(list.cnt == 2);
+  CHECK(list.chunk[1].chunk_id == SUBCHUNKID_DATA);
+  CHECK(list.chunk[1].size == (int32_t)data.size());
+
+  CHECK(read_data(parser, h) == data);
+
+  parser.resetParser(h);
+  return 0;
+}
+
+static int test_metadata(bool from_mem)
+{
+  /* Odd sized metadata around fmt and data, fmt with extension. */
+
+  WavContainerFormatParser parser;
+  fmt_chunk_t fmt;
+  Bytes meta  = make_bytes(3 * 1024 * 1024 + 1, 2);
+  Bytes junk  = make_bytes(27, 3);
+  Bytes data  = make_bytes(3 * 2001, 4);
+  Bytes trail = make_bytes(99, 5);
+  Bytes chunks;
+
+  add_chunk(chunks, SUBCHUNKID_LIST, meta);
+  add_chunk(chunks, SUBCHUNKID_FMT, make_fmt(1, 44100, 24, 18));
+  add_chunk(chunks, SUBCHUNKID_JUNK, junk);
+  add_chunk(chunks, SUBCHUNKID_DATA, data);
+  add_chunk(chunks, SUBCHUNKID_ID3, trail);
+
+  handel_wav_parser h = open_wav(parser, make_riff(chunks), from_mem, &fmt);
+  CHECK(h != NULL);
+  CHECK(fmt.channel == 1 && fmt.rate == 44100 && fmt.bit == 24);
+  CHECK(fmt.block == 3);
+
+  chunk_list_t list;
+  CHECK(parser.getChunkList(h, &list));
+  CHECK(list.cnt == 5);
+  CHECK(list.chunk[0].chunk_id == SUBCHUNKID_LIST);
+  CHECK(list.chunk[0].size == (int32_t)meta.size());
+  CHECK(list.chunk[4].chunk_id == SUBCHUNKID_ID3);
+
+  /* getChunk() does not move the read position of data. */
+
+  Bytes buf(meta.size());
+  int8_t first[100];
+  CHECK(parser.getDataChunk(h, WAVE_FORMAT_PCM, first, 3) == 3);
+  CHECK(parser.getChunk(h, SUBCHUNKID_LIST, (int8_t *)buf.data()));
+  CHECK(buf == meta);
+  buf.resize(trail.size());
+  CHECK(parser.getChunk(h, SUBCHUNKID_ID3, (int8_t *)buf.data()));
+  CHECK(buf == trail);
+  CHECK(!parser.getChunk(h, SUBCHUNKID_CUE, (int8_t *)buf.data()));
+
+  Bytes rest = read_data(parser, h);
+  CHECK(memcmp(first, data.data(), 3) == 0);
+  CHECK(rest == Bytes(data.begin() + 3, data.end()));
+
+  parser.resetParser(h);
+  return 0;
+}
+
+static int test_extensible(bool from_mem)
+{
+  /* WAVE_FORMAT_EXTENSIBLE style fmt (40 bytes) is larger than
+   * fmt_chunk_t.
+   */
+
+  WavContainerFormatParser parser;
+  fmt_chunk_t fmt[2];
+  Bytes data = make_bytes(8 * 10, 6);
+  Bytes chunks;
+
+  memset(fmt, 0xcc, sizeof(fmt));
+  add_chunk(chunks, SUBCHUNKID_FMT, make_fmt(2, 96000, 32, 40));
+  add_chunk(chunks, SUBCHUNKID_DATA, data);
+
+  handel_wav_parser h = open_wav(parser, make_riff(chunks), from_mem, fmt);
+  CHECK(h != NULL);
+  CHECK(fmt[0].rate == 96000 && fmt[0].block == 8);
+
+  Bytes guard(sizeof(fmt_chunk_t), 0xcc);
+  CHECK(memcmp(&fmt[1], guard.data(), sizeof(fmt_chunk_t)) == 0);
+  CHECK(read_data(parser, h) == data);
+
+  parser.resetParser(h);
+  return 0;
+}
+
+static int test_seek(bool from_mem)
+{
+  WavContainerFormatParser parser;
+  fmt_chunk_t fmt;
+  Bytes data = make_bytes(4 * 1000, 7);
+  Bytes chunks;
+
+  add_chunk(chunks, SUBCHUNKID_FMT, make_fmt(2, 48000, 16, 16));
+  add_chunk(chunks, SUBCHUNKID_DATA, data);
+  add_chunk(chunks, SUBCHUNKID_LIST, make_bytes(50, 8));
+
+  handel_wav_parser h = open_wav(parser, make_riff(chunks), from_mem, &fmt);
+  CHECK(h != NULL);
+
+  static const uint32_t samples[] = { 999, 0, 517, 1, 1000 };
+
+  for (size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++)
+    {
+      CHECK(parser.seekDataChunk(h, samples[i]));
+      CHECK(parser.tellDataChunk(h) == samples[i]);
+      CHECK(read_data(parser, h) ==
+            Bytes(data.begin() + samples[i] * 4, data.end()));
+      CHECK(parser.tellDataChunk(h) == 1000);
+    }
+
+  CHECK(!parser.seekDataChunk(h, 1001));
+  CHECK(parser.tellDataChunk(h) == 1000);
+
+  parser.resetParser(h);
+  return 0;
+}
+
+static int test_not_updated(bool from_mem)
+{
+  /* Sizes left 0 by an interrupted recording, and data size over the
+   * end of the file. Data up to the end of the file is read.
+   */
+
+  WavContainerFormatParser parser;
+  fmt_chunk_t fmt;
+  Bytes data = make_bytes(4 * 300, 9);
+
+  for (int i = 0; i < 2; i++)
+    {
+      Bytes chunks;
+
+      add_chunk(chunks, SUBCHUNKID_FMT, make_fmt(2, 16000, 16, 16));
+      add_chunk(chunks, SUBCHUNKID_DATA, data, (i == 0) ? 0 : 0x7ffffff0);
+
+      handel_wav_parser h =
+        open_wav(parser, make_riff(chunks, 0), from_mem, &fmt);
+      CHECK(h != NULL);
+      CHECK(read_data(parser, h) == data);
+      parser.resetParser(h);
+    }
+
+  return 0;
+}
+
+static int test_broken(bool from_mem)
+{
+  WavContainerFormatParser parser;
+  fmt_chunk_t fmt;
+  Bytes fmt_body = make_fmt(2, 48000, 16, 16);
+  Bytes data = make_bytes(64, 10);
+
+  /* Not RIFF. */
+
+  Bytes chunks;
+  add_chunk(chunks, SUBCHUNKID_FMT, fmt_body);
+  add_chunk(chunks, SUBCHUNKID_DATA, data);
+  Bytes wav = make_riff(chunks);
+  wav[0] = 'X';
+  CHECK(open_wav(parser, wav, from_mem, &fmt) == NULL);
+
+  /* Too short. */
+
+  CHECK(open_wav(parser, Bytes(wav.begin(), wav.begin() + 6),
+                 from_mem, &fmt) == NULL);
+
+  /* No data chunk. */
+
+  chunks.clear();
+  add_chunk(chunks, SUBCHUNKID_FMT, fmt_body);
+  add_chunk(chunks, SUBCHUNKID_LIST, data);
+  CHECK(open_wav(parser, make_riff(chunks), from_mem, &fmt) == NULL);
+
+  /* No fmt chunk. */
+
+  chunks.clear();
+  add_chunk(chunks, SUBCHUNKID_DATA, data);
+  CHECK(open_wav(parser, make_riff(chunks), from_mem, &fmt) == NULL);
+
+  /* fmt chunk cut by the end of file. */
+
+  chunks.clear();
+  add_chunk(chunks, SUBCHUNKID_LIST, data);
+  add_chunk(chunks, SUBCHUNKID_FMT, fmt_body);
+  wav = make_riff(chunks);
+  wav.resize(wav.size() - 10);
+  CHECK(open_wav(parser, wav, from_mem, &fmt) == NULL);
+
+  /* More chunks than MAX_CHUNK_LIST before data. */
+
+  chunks.clear();
+  add_chunk(chunks, SUBCHUNKID_FMT, fmt_body);
+  for (int i = 0; i < MAX_CHUNK_LIST; i++)
+    {
+      add_chunk(chunks, SUBCHUNKID_JUNK, make_bytes(i, i));
+    }
+  add_chunk(chunks, SUBCHUNKID_DATA, data);
+  CHECK(open_wav(parser, make_riff(chunks), from_mem, &fmt) == NULL);
+
+  return 0;
+}
+
+static int run_test(const char *name, int (*func)(bool))
+{
+  int errors = 0;
+
+  for (int i = 0; i < 2; i++)
+    {
+      bool from_mem = (i == 1);
+      int ret = func(from_mem);
+
+      printf("%-16s %-6s %s\n", name, from_mem ? "memory" : "file",
+             ret ? "NG" : "OK");
+      errors += ret;
+    }
+
+  return errors;
+}
+
+/****************************************************************************
+ * Benchmark
+ ****************************************************************************/
+
+static double now_ms(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/* Former way to skip the body of a chunk. */
+
+static bool legacy_open(const char *path)
+{
+  FILE *fd = fopen(path, "r");
+
+  if (fd == NULL)
+    {
+      return false;
+    }
+  setvbuf(fd, NULL, _IOLBF, STDIO_BUFFER_SIZE);
+
+  riff_chunk_t riff_chunk;
+  chunk_t chunk;
+  bool ret = false;
+
+  if (fread(&riff_chunk, 1, sizeof(riff_chunk), fd) == sizeof(riff_chunk))
+    {
+      while (fread(&chunk, 1, sizeof(chunk), fd) == sizeof(chunk))
+        {
+          if (chunk.chunk_id == SUBCHUNKID_DATA)
+            {
+              ret = true;
+              break;
+            }
+
+          int8_t data;
+          for (int32_t i = 0; i < chunk.size; i++)
+            {
+              if (fread(&data, 1, 1, fd) != 1)
+                {
+                  break;
+                }
+            }
+        }
+    }
+
+  fclose(fd);
+  return ret;
+}
+
+static void bench(void)
+{
+  WavContainerFormatParser parser;
+  fmt_chunk_t fmt;
+  Bytes chunks;
+
+  add_chunk(chunks, SUBCHUNKID_LIST, make_bytes(BENCH_META_SIZE, 11));
+  add_chunk(chunks, SUBCHUNKID_FMT, make_fmt(2, 48000, 16, 16));
+  add_chunk(chunks, SUBCHUNKID_DATA, make_bytes(48000 * 4, 12));
+  if (!write_file(BENCH_FILE, make_riff(chunks)))
+    {
+      printf("Cannot write %s\n", BENCH_FILE);
+      return;
+    }
+
+  double start = now_ms();
+  for (int i = 0; i < BENCH_REPEAT; i++)
+    {
+      handel_wav_parser h = parser.parseChunk(BENCH_FILE, &fmt);
+      if (h == NULL)
+        {
+          printf("parseChunk failed\n");
+          return;
+        }
+      parser.resetParser(h);
+    }
+  double parse_ms = (now_ms() - start) / BENCH_REPEAT;
+
+  start = now_ms();
+  legacy_open(BENCH_FILE);
+  double legacy_ms = now_ms() - start;
+
+  printf("\nopen with %d MiB LIST chunk\n", BENCH_META_SIZE >> 20);
+  printf("  parseChunk        %10.3f ms\n", parse_ms);
+  printf("  byte-wise skip    %10.3f ms\n", legacy_ms);
+
+  remove(BENCH_FILE);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  int errors = 0;
+
+  errors += run_test("basic",       test_basic);
+  errors += run_test("metadata",    test_metadata);
+  errors += run_test("extensible",  test_extensible);
+  errors += run_test("seek",        test_seek);
+  errors += run_test("not_updated", test_not_updated);
+  errors += run_test("broken",      test_broken);
+
+  remove(TEST_FILE);
+
+  if (errors)
+    {
+      printf("%d errors\n", errors);
+      return 1;
+    }
+
+  if (argc < 2 || strcmp(argv[1], "-t") != 0)
+    {
+      bench();
+    }
+
+  return 0;
+}
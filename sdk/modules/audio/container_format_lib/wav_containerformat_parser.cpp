@@ -38,6 +38,133 @@
 #include <stdlib.h>
 #include "audio/utilities/wav_containerformat_parser.h"
 
+/*--------------------------------------------------------------------------*/
+static bool read_at(handel_wav_parser_t* wav_parser,
+                    uint32_t             offset,
+                    void*                buffer,
+                    uint32_t             size)
+{
+  if (wav_parser->mem != NULL)
+    {
+      if (offset > wav_parser->mem_size ||
+          size > wav_parser->mem_size - offset)
+        {
+          return false;
+        }
+      memcpy(buffer, wav_parser->mem + offset, size);
+      return true;
+    }
+
+  if (fseek(wav_parser->fd, offset, SEEK_SET) != 0)
+    {
+      return false;
+    }
+  return (fread(buffer, 1, size, wav_parser->fd) == size);
+}
+
+/*--------------------------------------------------------------------------*/
+static bool parse(handel_wav_parser_t* wav_parser,
+                  uint32_t             total_size,
+                  fmt_chunk_t*         fmt)
+{
+  riff_chunk_t riff_chunk;
+  if (!read_at(wav_parser, 0, &riff_chunk, sizeof(riff_chunk_t)) ||
+      riff_chunk.chunk.chunk_id != CHUNKID_RIFF)
+    {
+      return false;
+    }
+  wav_parser->file_size = riff_chunk.chunk.size;
+
+  /* Only the chunk headers are read. The bodies are skipped by
+   * the offset, so the time to parse does not depend on the size of
+   * metadata. The sizes in RIFF header may be left 0 by an interrupted
+   * recording, so the real size of the file is used as the limit.
+   */
+
+  bool     has_fmt  = false;
+  bool     has_data = false;
+  uint32_t offset   = sizeof(riff_chunk_t);
+  chunk_t  chunk;
+
+  while (total_size - offset >= sizeof(chunk_t) &&
+         wav_parser->chunk_list.cnt < MAX_CHUNK_LIST)
+    {
+      if (!read_at(wav_parser, offset, &chunk, sizeof(chunk_t)))
+        {
+          break;
+        }
+      offset += sizeof(chunk_t);
+
+      uint32_t size = (uint32_t)chunk.size;
+      uint32_t rest = total_size - offset;
+
+      switch (chunk.chunk_id)
+        {
+          case SUBCHUNKID_FMT:
+            {
+              uint32_t read_size = (size < sizeof(fmt_chunk_t)) ?
+                                    size : sizeof(fmt_chunk_t);
+              memset(fmt, 0, sizeof(fmt_chunk_t));
+              if (!read_at(wav_parser, offset, fmt, read_size))
+                {
+                  return false;
+                }
+              wav_parser->block = fmt->block;
+              has_fmt = true;
+            }
+            break;
+
+          case SUBCHUNKID_DATA:
+            if (!has_data)
+              {
+                /* Size 0 or over the file means it was not updated. */
+
+                if (size == 0 || size > rest)
+                  {
+                    size = rest;
+                  }
+                wav_parser->data_offset = offset;
+                wav_parser->data_size   = size;
+                has_data = true;
+              }
+            break;
+
+          default:
+            break;
+        }
+
+      wav_parser->chunk_list.chunk[wav_parser->chunk_list.cnt].chunk_id =
+        chunk.chunk_id;
+      wav_parser->chunk_list.chunk[wav_parser->chunk_list.cnt].size = size;
+      wav_parser->chunk_offset[wav_parser->chunk_list.cnt] = offset;
+      wav_parser->chunk_list.cnt++;
+
+      /* Chunks are aligned to 2 bytes. */
+
+      if (size >= rest)
+        {
+          break;
+        }
+      offset += size + (size & 1);
+    }
+
+  if (!has_fmt || !has_data)
+    {
+      return false;
+    }
+
+  wav_parser->cur_offset = wav_parser->data_offset;
+  wav_parser->read_size  = wav_parser->data_size;
+
+  if (wav_parser->fd != NULL &&
+      fseek(wav_parser->fd, wav_parser->cur_offset, SEEK_SET) != 0)
+    {
+      return false;
+    }
+
+  return true;
+}
+
 /*--------------------------------------------------------------------------*/
 handel_wav_parser WavContainerFormatParser::parseChunk(const char* file_path,
                                                        fmt_chunk_t* fmt)
@@ -57,84 +184,52 @@ handel_wav_parser WavContainerFormatParser::parseChunk(const char* file_path,
       return NULL;
     }
   setvbuf(fd, NULL, _IOLBF, STDIO_BUFFER_SIZE);
+  wav_parser->fd = fd;
 
-  int ret;
-  riff_chunk_t riff_chunk;
-  ret = fread((void*)&riff_chunk, 1, sizeof(riff_chunk_t), fd);
-  if (ret < 0 || sizeof(riff_chunk_t) != ret)
+  long total_size = -1;
+  if (fseek(fd, 0, SEEK_END) == 0)
+    {
+      total_size = ftell(fd);
+    }
+
+  if (total_size < 0 || !parse(wav_parser, (uint32_t)total_size, fmt))
     {
       fclose(fd);
       free((void *)wav_parser);
       return NULL;
     }
-  if (riff_chunk.chunk.chunk_id == CHUNKID_RIFF)
+
+  return (handel_wav_parser)wav_parser;
+}
+
+/*--------------------------------------------------------------------------*/
+handel_wav_parser WavContainerFormatParser::parseChunk(const uint8_t* buffer,
+                                                       uint32_t size,
+                                                       fmt_chunk_t* fmt)
+{
+  if (buffer == NULL)
     {
-      uint32_t offset = sizeof(riff_chunk_t);
-      wav_parser->file_size = riff_chunk.chunk.size;
-      chunk_t chunk;
-      while (1)
-        {
-          ret = fread((void*)&chunk, 1, sizeof(chunk_t), fd);
-          if (ret < 0 || sizeof(chunk_t) != ret)
-             {
-               fclose(fd);
-               free((void *)wav_parser);
-               return NULL;
-             }
-
-          wav_parser->chunk_list.chunk[wav_parser->chunk_list.cnt].chunk_id =
-            chunk.chunk_id;
-          wav_parser->chunk_list.chunk[wav_parser->chunk_list.cnt].size =
-            chunk.size;
-          wav_parser->chunk_offset[wav_parser->chunk_list.cnt] =
-            offset + sizeof(chunk_t);
-          wav_parser->chunk_list.cnt++;
-          offset += sizeof(chunk_t);
-          switch (chunk.chunk_id)
-            {
-              case SUBCHUNKID_FMT:
-                {
-                  fmt_chunk_t  fmt_chunk;
-                  ret = fread((void*)&fmt_chunk, 1, chunk.size, fd);
-                  if (ret < 0 || ret != chunk.size)
-                    {
-                      fclose(fd);
-                      free((void *)wav_parser);
-                      return NULL;
-                    }
-                  offset += chunk.size;
-                  memcpy(fmt, &fmt_chunk, sizeof(fmt_chunk_t));
-                  if ((int32_t)sizeof(fmt_chunk_t) > chunk.size)
-                    {
-                      fmt->extended_size = 0;
-                    }
-                }
-                break;
+      return NULL;
+    }
 
-              case SUBCHUNKID_DATA:
-                wav_parser->data_offset = offset;
-                wav_parser->data_size = chunk.size;
-                wav_parser->cur_offset = offset;
-                wav_parser->read_size = chunk.size;
-                wav_parser->fd = fd;
-                return (handel_wav_parser)wav_parser;
-
-              default:
-                int8_t data;
-                for (int32_t i = 0; i < chunk.size; i++)
-                 {
-                   ret = fread((void*)&data, 1, 1, fd);
-                 }
-                offset += chunk.size;
-                break;
-            }
-        }
+  handel_wav_parser_t* wav_parser =
+    (handel_wav_parser_t*)malloc(sizeof(handel_wav_parser_t));
+  if (wav_parser == NULL)
+    {
+      return NULL;
     }
+  memset((void *)wav_parser, 0, sizeof(handel_wav_parser_t));
 
-  fclose(fd);
-  free((void *)wav_parser);
+  wav_parser->mem      = buffer;
+  wav_parser->mem_size = size;
 
-  return NULL;
+  if (!parse(wav_parser, size, fmt))
+    {
+      free((void *)wav_parser);
+      return NULL;
+    }
+
+  return (handel_wav_parser)wav_parser;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -171,16 +266,18 @@ bool WavContainerFormatParser::getChunk(handel_wav_parser handel,
     {
       if (wav_parser->chunk_list.chunk[i].chunk_id == chunk_id)
         {
-          int ret;
-          fseek(wav_parser->fd, wav_parser->chunk_offset[i], 0);
-          ret = fread(buffer, 1, wav_parser->chunk_list.chunk[i].size,
-                      wav_parser-> fd);
-          fseek(wav_parser->fd, wav_parser->cur_offset, 0);
-          if (ret < 0 || ret != wav_parser->chunk_list.chunk[i].size)
+          bool ret = read_at(wav_parser,
+                             wav_parser->chunk_offset[i],
+                             buffer,
+                             wav_parser->chunk_list.chunk[i].size);
+
+          /* Back to the read position of data chunk. */
+
+          if (wav_parser->fd != NULL)
             {
-              return false;
+              fseek(wav_parser->fd, wav_parser->cur_offset, SEEK_SET);
             }
-          return true;
+          return ret;
         }
     }
 
@@ -218,10 +315,19 @@ int32_t WavContainerFormatParser::getDataChunk(handel_wav_parser handel,
               read_size = wav_parser->read_size;
             }
 
-          ret = fread(buffer, 1, read_size, wav_parser->fd);
-          if (ret < 0)
+          if (wav_parser->mem != NULL)
+            {
+              memcpy(buffer, wav_parser->mem + wav_parser->cur_offset,
+                     read_size);
+              ret = read_size;
+            }
+          else
             {
-              return -1;
+              ret = fread(buffer, 1, read_size, wav_parser->fd);
+              if (ret < 0)
+                {
+                  return -1;
+                }
             }
           wav_parser->cur_offset += ret;
           wav_parser->read_size -= ret;
@@ -233,9 +339,64 @@ int32_t WavContainerFormatParser::getDataChunk(handel_wav_parser handel,
   return ret;
 }
 
+/*--------------------------------------------------------------------------*/
+bool WavContainerFormatParser::seekDataChunk(handel_wav_parser handel,
+                                             uint32_t          sample)
+{
+  if (handel == NULL)
+    {
+      return false;
+    }
+  handel_wav_parser_t* wav_parser = (handel_wav_parser_t *)handel;
+
+  if (wav_parser->block == 0)
+    {
+      return false;
+    }
+
+  uint64_t pos = (uint64_t)sample * wav_parser->block;
+  if (pos > wav_parser->data_size)
+    {
+      return false;
+    }
+
+  uint32_t offset = wav_parser->data_offset + (uint32_t)pos;
+  if (wav_parser->fd != NULL &&
+      fseek(wav_parser->fd, offset, SEEK_SET) != 0)
+    {
+      return false;
+    }
+
+  wav_parser->cur_offset = offset;
+  wav_parser->read_size  = wav_parser->data_size - (uint32_t)pos;
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t WavContainerFormatParser::tellDataChunk(handel_wav_parser handel)
+{
+  if (handel == NULL)
+    {
+      return 0;
+    }
+  handel_wav_parser_t* wav_parser = (handel_wav_parser_t *)handel;
+
+  if (wav_parser->block == 0)
+    {
+      return 0;
+    }
+
+  return (wav_parser->cur_offset - wav_parser->data_offset) /
+         wav_parser->block;
+}
+
 /*--------------------------------------------------------------------------*/
 void WavContainerFormatParser::resetParser(handel_wav_parser handel)
 {
-  fclose(((handel_wav_parser_t *)handel)->fd);
+  if (((handel_wav_parser_t *)handel)->fd != NULL)
+    {
+      fclose(((handel_wav_parser_t *)handel)->fd);
+    }
   free(handel);
 }
@@ -78,6 +78,7 @@ E_AS dmaDrvDeactive(cxd56_audio_dma_t dmacId)
     }
 
   delete s_dma_drv_instance[dmacId];
+  s_dma_drv_instance[dmacId] = NULL;
 
   return E_AS_OK;
 }
@@ -240,3 +241,38 @@ E_AS_BB AS_AudioDrvDmaNofifyCmplt(cxd56_audio_dma_t dmacId, CXD56_AUDIO_ECODE co
   return E_AS_BB_DMA_ILLEGAL;
 }
 
+
+/*--------------------------------------------------------------------*/
+E_AS_BB AS_AudioDrvDmaGetStats(cxd56_audio_dma_t dmac_id,
+                               FAR asDmacStats *pStats)
+{
+  if (s_dma_drv_instance[dmac_id]->parse(AsDmaDrv::EvtGetStats,
+                                         (void *)pStats))
+    {
+      return E_AS_BB_DMA_OK;
+    }
+
+  return E_AS_BB_DMA_ILLEGAL;
+}
+
+/*--------------------------------------------------------------------*/
+E_AS_BB AS_AudioDrvDmaClearStats(cxd56_audio_dma_t dmac_id)
+{
+  if (s_dma_drv_instance[dmac_id]->parse(AsDmaDrv::EvtClearStats, NULL))
+    {
+      return E_AS_BB_DMA_OK;
+    }
+
+  return E_AS_BB_DMA_ILLEGAL;
+}
+
+/*--------------------------------------------------------------------*/
+void AS_AudioDrvDmaStampInt(cxd56_audio_dma_t dmac_id)
+{
+  /* Called from interrupt handler, so don't go through the state table. */
+
+  if (s_dma_drv_instance[dmac_id] != NULL)
+    {
+      s_dma_drv_instance[dmac_id]->stampInt();
+    }
+}
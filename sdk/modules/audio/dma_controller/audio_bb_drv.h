@@ -60,6 +60,8 @@ typedef struct AudioDrvDmaInitParam_
   uint8_t           dma_byte_len;
   uint8_t           ch_num;
   bool              fade_en;
+  uint16_t          ready_que_num;
+  uint16_t          underflow_sample;
 } AudioDrvDmaInitParam;
 
 typedef struct AudioDrvDmaRunParam_
@@ -102,6 +104,9 @@ E_AS_BB AS_AudioDrvDmaStop(AudioDrvDmaStopParam*);
 E_AS_BB AS_AudioDrvDmaGetInfo(cxd56_audio_dma_t, AudioDrvDmaInfo*);
 E_AS_BB AS_AudioDrvDmaStart(cxd56_audio_dma_t);
 E_AS_BB AS_AudioDrvDmaNofifyCmplt(cxd56_audio_dma_t, CXD56_AUDIO_ECODE);
+E_AS_BB AS_AudioDrvDmaGetStats(cxd56_audio_dma_t, asDmacStats*);
+E_AS_BB AS_AudioDrvDmaClearStats(cxd56_audio_dma_t);
+void    AS_AudioDrvDmaStampInt(cxd56_audio_dma_t);
 
 E_AS_BB dmaDrvTaskActive(cxd56_audio_dma_t dmacId);
 E_AS_BB dmaDrvTaskDeactive(cxd56_audio_dma_t dmacId);
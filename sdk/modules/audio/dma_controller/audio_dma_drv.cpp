@@ -35,6 +35,7 @@
 
 #include <nuttx/kmalloc.h>
 #include <debug.h>
+#include <string.h>
 #include <arch/chip/cxd56_audio.h>
 
 #include "memutils/os_utils/chateau_osal.h"
@@ -193,6 +194,36 @@ AsDmaDrv::dmaDrvFuncTbl AsDmaDrv::m_func_tbl[] =
       &AsDmaDrv::ignore,         /*   AS_DMA_STATE_ERROR   */
       &AsDmaDrv::ignore          /*   AS_DMA_STATE_TERMINATE */
     }
+  },
+
+  {
+    EvtGetStats,
+
+    {                            /* DmaController status:  */
+      &AsDmaDrv::illegal,        /*   AS_DMA_STATE_BOOTED  */
+      &AsDmaDrv::getStats,       /*   AS_DMA_STATE_STOP    */
+      &AsDmaDrv::getStats,       /*   AS_DMA_STATE_READY   */
+      &AsDmaDrv::getStats,       /*   AS_DMA_STATE_PREPARE */
+      &AsDmaDrv::getStats,       /*   AS_DMA_STATE_RUN     */
+      &AsDmaDrv::getStats,       /*   AS_DMA_STATE_FLUSH   */
+      &AsDmaDrv::getStats,       /*   AS_DMA_STATE_ERROR   */
+      &AsDmaDrv::getStats        /*   AS_DMA_STATE_TERMINATE */
+    }
+  },
+
+  {
+    EvtClearStats,
+
+    {                            /* DmaController status:  */
+      &AsDmaDrv::illegal,        /*   AS_DMA_STATE_BOOTED  */
+      &AsDmaDrv::clearStats,     /*   AS_DMA_STATE_STOP    */
+      &AsDmaDrv::clearStats,     /*   AS_DMA_STATE_READY   */
+      &AsDmaDrv::clearStats,     /*   AS_DMA_STATE_PREPARE */
+      &AsDmaDrv::clearStats,     /*   AS_DMA_STATE_RUN     */
+      &AsDmaDrv::clearStats,     /*   AS_DMA_STATE_FLUSH   */
+      &AsDmaDrv::clearStats,     /*   AS_DMA_STATE_ERROR   */
+      &AsDmaDrv::clearStats      /*   AS_DMA_STATE_TERMINATE */
+    }
   }
 };
 
@@ -261,6 +292,15 @@ bool AsDmaDrv::parse(ExternalEvent event, void *p_param)
   return (this->*(p_tbl->p_func[m_state.get()]))(p_param);
 }
 
+/*--------------------------------------------------------------------*/
+void AsDmaDrv::stampInt(void)
+{
+  /* Called from interrupt handler at transfer completion. */
+
+  m_int_time[m_int_wr % RUNNING_QUEUE_NUM] = Chateau_GetTimeUs();
+  m_int_wr++;
+}
+
 /*--------------------------------------------------------------------*/
 bool AsDmaDrv::illegal(void *p_param)
 {
@@ -289,6 +329,14 @@ bool AsDmaDrv::init(void *p_param)
   m_ch_num = initParam->ch_num;
   m_dmadone_func = initParam->p_dmadone_func;
 
+  m_ready_que_num = (initParam->ready_que_num == 0) ?
+    READY_QUEUE_NUM : initParam->ready_que_num;
+  m_underflow_sample = (initParam->underflow_sample == 0) ?
+    AS_DMAC_UNDERFLOW_SAMPLE_MAX : initParam->underflow_sample;
+
+  m_int_rd = m_int_wr;
+  clearStats(NULL);
+
   drv_ret = cxd56_audio_init_dma(initParam->dmac_id,
                                  initParam->format,
                                  &m_ch_num);
@@ -483,9 +531,10 @@ bool AsDmaDrv::pushRequest(void *p_param, bool use_callback)
 
   dmaParam.overlap_cnt = size1_cnt + size2_cnt;
 
-  if ((m_ready_que.size() + dmaParam.overlap_cnt) > READY_QUEUE_NUM)
+  if ((m_ready_que.size() + dmaParam.overlap_cnt) > m_ready_que_num)
     {
       _info("OVERFLOW(%d) rdy(%d)\n", m_dmac_id, m_ready_que.size());
+      m_stats.overflow_cnt++;
       dmaErrCb(E_AS_BB_DMA_OVERFLOW);
     }
   else
@@ -497,6 +546,8 @@ bool AsDmaDrv::pushRequest(void *p_param, bool use_callback)
       runDmaSplitRequest(&dmaParam,
                          dmaParam.run_dmac_param.addr2,
                          dmaParam.run_dmac_param.size2);
+
+      updateReadyPeak();
     }
 
   return true;
@@ -617,6 +668,27 @@ bool AsDmaDrv::startDma(void *p_param)
 void AsDmaDrv::dmaCmplt(void)
 {
   const AudioDrvDmaRunParam& dmaParam = m_running_que.top();
+  uint32_t int_time = 0;
+  bool     stamped  = false;
+  bool     enqueued = false;
+
+  /* Take the time of the interrupt of this completion.
+   * If some completions were not notified, their time is dropped.
+   */
+
+  if (m_int_rd != m_int_wr)
+    {
+      if ((m_int_wr - m_int_rd) > RUNNING_QUEUE_NUM)
+        {
+          m_int_rd = m_int_wr - RUNNING_QUEUE_NUM;
+        }
+
+      int_time = m_int_time[m_int_rd % RUNNING_QUEUE_NUM];
+      stamped  = true;
+      m_int_rd++;
+    }
+
+  m_stats.transfer_cnt++;
 
   if (((m_ch_num % 2) == 1) && (m_dma_byte_len == AS_DMAC_BYTE_WT_16BIT))
     {
@@ -674,6 +746,13 @@ void AsDmaDrv::dmaCmplt(void)
                 false);
 
       readyQuePop();
+
+      enqueued = true;
+    }
+
+  if (stamped && enqueued)
+    {
+      updateLatency(Chateau_GetTimeUs() - int_time);
     }
 }
 
@@ -691,7 +770,7 @@ bool AsDmaDrv::dmaCmpltOnRun(void *p_param)
       asWriteDmacParam dmac_param;
       dmac_param.dmacId = m_dmac_id;
       dmac_param.addr = (uint32_t)&under_data[0];
-      dmac_param.size = UNDERFLOW_INSERT_SAMPLE;
+      dmac_param.size = m_underflow_sample;
       dmac_param.addr2 = 0;
       dmac_param.size2 = 0;
       dmac_param.validity = false;
@@ -708,6 +787,9 @@ bool AsDmaDrv::dmaCmpltOnRun(void *p_param)
 
       readyQuePop();
 
+      m_stats.underflow_cnt++;
+      m_stats.insert_sample += m_underflow_sample;
+
       dmaErrCb(E_AS_BB_DMA_UNDERFLOW);
     }
 #endif  /* CONFIG_AUDIOUTILS_RENDERER_UNDERFLOW */
@@ -716,6 +798,8 @@ bool AsDmaDrv::dmaCmpltOnRun(void *p_param)
     {
       cxd56_audio_stop_dma(m_dmac_id);
 
+      m_stats.underflow_cnt++;
+
       dmaErrCb(E_AS_BB_DMA_UNDERFLOW);
 
       m_state = AS_DMA_STATE_ERROR;
@@ -935,12 +1019,62 @@ bool AsDmaDrv::getInfo(void *p_param)
   dmaInfo->running_wait  = m_running_que.size();
   dmaInfo->running_empty = RUNNING_QUEUE_NUM - dmaInfo->running_wait;
   dmaInfo->ready_wait    = m_ready_que.size();
-  dmaInfo->ready_empty   = READY_QUEUE_NUM - dmaInfo->ready_wait;
+  dmaInfo->ready_empty   = m_ready_que_num - dmaInfo->ready_wait;
   dmaInfo->state         = m_state.get();
 
   return true;
 }
 
+/*--------------------------------------------------------------------*/
+bool AsDmaDrv::getStats(void *p_param)
+{
+  asDmacStats *stats = reinterpret_cast<asDmacStats*>(p_param);
+
+  *stats = m_stats;
+
+  stats->ready_que_num = m_ready_que_num;
+  stats->latency_avg   = (m_stats.latency_cnt == 0) ?
+    0 : (uint32_t)(m_latency_sum / m_stats.latency_cnt);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+bool AsDmaDrv::clearStats(void *p_param)
+{
+  memset(&m_stats, 0, sizeof(m_stats));
+  m_latency_sum = 0;
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+void AsDmaDrv::updateLatency(uint32_t latency)
+{
+  if ((m_stats.latency_cnt == 0) || (latency < m_stats.latency_min))
+    {
+      m_stats.latency_min = latency;
+    }
+
+  if (latency > m_stats.latency_max)
+    {
+      m_stats.latency_max = latency;
+    }
+
+  m_stats.latency_last = latency;
+  m_stats.latency_cnt++;
+  m_latency_sum += latency;
+}
+
+/*--------------------------------------------------------------------*/
+void AsDmaDrv::updateReadyPeak(void)
+{
+  if (m_ready_que.size() > m_stats.ready_peak)
+    {
+      m_stats.ready_peak = m_ready_que.size();
+    }
+}
+
 /*--------------------------------------------------------------------*/
 void AsDmaDrv::allocDmaBuffer(cxd56_audio_dma_t dmac_id)
 {
@@ -73,9 +73,12 @@ E_AS AS_DeactivateDmac(cxd56_audio_dma_t dmacId);
 #endif /* __cplusplus */
 
 #ifdef CONFIG_AUDIOUTILS_RENDERER_UNDERFLOW
-/* Number of silent insertion samples at dmac underflow */
+/* Number of silent insertion samples at dmac underflow.
+ * This is the default, and can be changed by asInitDmacParam
+ * up to AS_DMAC_UNDERFLOW_SAMPLE_MAX.
+ */
 
-# define UNDERFLOW_INSERT_SAMPLE 1024  /* 21ms */
+# define UNDERFLOW_INSERT_SAMPLE AS_DMAC_UNDERFLOW_SAMPLE_MAX
 #endif  /* CONFIG_AUDIOUTILS_RENDERER_UNDERFLOW */
 
 /* Definition of size of DMA ReadyQueue.
@@ -84,9 +87,15 @@ E_AS AS_DeactivateDmac(cxd56_audio_dma_t dmacId);
  * Assume that the number of Segment is 10 maximum.
  * The maximum number of DMA transfers in 1 segment is 3.
  * (192000/882000 * 1024sample / 1024(DMA MAX) = 2.17)
+ * This is the capacity and the default depth. The depth can be made
+ * smaller by asInitDmacParam.
+ *
+ * RunningQueue is not configurable. Its size is the depth of
+ * the DMA command FIFO, and the underflow detection assumes that
+ * one more transfer is queued behind the running one.
  */
 
-#define READY_QUEUE_NUM 30
+#define READY_QUEUE_NUM AS_DMAC_READY_QUEUE_MAX
 #define RUNNING_QUEUE_NUM 2
 #define PREPARE_SAVE_NUM RUNNING_QUEUE_NUM
 
@@ -105,6 +114,8 @@ public:
     EvtDmaErr,
     EvtBusErr,
     EvtStart,
+    EvtGetStats,
+    EvtClearStats,
     ExternalEventNum
   };
 
@@ -115,9 +126,14 @@ public:
       , m_dma_buf_cnt(0)
       , m_min_size(0)
       , m_fade_required_sample(0)
+      , m_ready_que_num(READY_QUEUE_NUM)
+      , m_underflow_sample(AS_DMAC_UNDERFLOW_SAMPLE_MAX)
+      , m_int_wr(0)
+      , m_int_rd(0)
   {
     m_ready_que.clear();
     m_running_que.clear();
+    clearStats(NULL);
     allocDmaBuffer(dmac_id);
   }
 
@@ -128,6 +144,7 @@ public:
 
   void run(void);
   bool parse(ExternalEvent event, void *p_param);
+  void stampInt(void);
 
   LevelCtrl m_level_ctrl;
 
@@ -160,6 +177,20 @@ private:
   Queue<AudioDrvDmaRunParam, READY_QUEUE_NUM> m_ready_que;
   Queue<AudioDrvDmaRunParam, RUNNING_QUEUE_NUM> m_running_que;
 
+  uint32_t    m_ready_que_num;
+  uint32_t    m_underflow_sample;
+
+  /* Time of completion interrupts, which are not processed yet.
+   * Written by stampInt() in interrupt context, and read by dmaCmplt().
+   */
+
+  uint32_t          m_int_time[RUNNING_QUEUE_NUM];
+  volatile uint32_t m_int_wr;
+  uint32_t          m_int_rd;
+
+  asDmacStats m_stats;
+  uint64_t    m_latency_sum;
+
   static dmaDrvFuncTbl  m_func_tbl[];
 
   static uint32_t     m_funcTblNum;
@@ -195,6 +226,10 @@ private:
   bool stop(void*);
   bool stopOnRun(void*);
   bool getInfo(void*);
+  bool getStats(void*);
+  bool clearStats(void*);
+  void updateLatency(uint32_t);
+  void updateReadyPeak(void);
   void dmaErrCb(E_AS_BB);
   void allocDmaBuffer(cxd56_audio_dma_t);
   void freeDmaBuffer(cxd56_audio_dma_t);
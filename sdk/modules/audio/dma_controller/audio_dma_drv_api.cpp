@@ -44,6 +44,23 @@
 
 static uint16_t dmacMinimumSize[5] = {0};
 
+static cxd56_audio_dma_cb_t dmacIntCb[5] = {NULL};
+
+/*--------------------------------------------------------------------*/
+static void dmaIntHandler(cxd56_audio_dma_t dmacId, uint32_t code)
+{
+  /* Stamp the time of completion for the latency statistics,
+   * then pass the interrupt to the registered callback.
+   */
+
+  if (code == CXD56_AUDIO_ECODE_DMA_CMPLT)
+    {
+      AS_AudioDrvDmaStampInt(dmacId);
+    }
+
+  (*dmacIntCb[dmacId])(dmacId, code);
+}
+
 /*--------------------------------------------------------------------*/
 static E_AS initDmac(asInitDmacParam *pInitDmacParam)
 {
@@ -51,6 +68,30 @@ static E_AS initDmac(asInitDmacParam *pInitDmacParam)
   E_AS_BB rtCodeBB = E_AS_BB_DMA_OK;
   AudioDrvDmaInitParam param;
 
+  /* Error check. 0 means the default. */
+
+  if ((pInitDmacParam->ready_que_num != 0)
+   && ((pInitDmacParam->ready_que_num < AS_DMAC_READY_QUEUE_MIN)
+    || (pInitDmacParam->ready_que_num > AS_DMAC_READY_QUEUE_MAX)))
+    {
+      DMAC_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
+      _err("ERR: dma(%d) ready queue(%d)\n",
+             pInitDmacParam->dmacId, pInitDmacParam->ready_que_num);
+
+      return E_AS_DMAC_QUEUE_NUM_PARAM;
+    }
+
+  if ((pInitDmacParam->underflow_sample != 0)
+   && ((pInitDmacParam->underflow_sample < AS_DMAC_UNDERFLOW_SAMPLE_MIN)
+    || (pInitDmacParam->underflow_sample > AS_DMAC_UNDERFLOW_SAMPLE_MAX)))
+    {
+      DMAC_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
+      _err("ERR: dma(%d) underflow sample(%d)\n",
+             pInitDmacParam->dmacId, pInitDmacParam->underflow_sample);
+
+      return E_AS_DMAC_UNDERFLOW_SAMPLE_PARAM;
+    }
+
   if (pInitDmacParam->p_dmadone_func != NULL)
     {
       dmacMinimumSize[pInitDmacParam->dmacId] = DMAC_MIN_SIZE_INT;
@@ -78,6 +119,9 @@ static E_AS initDmac(asInitDmacParam *pInitDmacParam)
 
   param.fade_en = pInitDmacParam->fade_en;
 
+  param.ready_que_num    = pInitDmacParam->ready_que_num;
+  param.underflow_sample = pInitDmacParam->underflow_sample;
+
   rtCodeBB = AS_AudioDrvDmaInit(&param);
 
   if (rtCodeBB != E_AS_BB_DMA_OK)
@@ -348,6 +392,47 @@ E_AS AS_GetReadyCmdNumDmac(cxd56_audio_dma_t dmacId, uint32_t *pResult)
   return rtCode;
 }
 
+/*--------------------------------------------------------------------*/
+E_AS AS_GetDmacStats(cxd56_audio_dma_t dmacId, asDmacStats *pStats)
+{
+  E_AS rtCode = E_AS_OK;
+  E_AS_BB rtCodeBB = E_AS_BB_DMA_OK;
+
+  if (pStats == NULL)
+    {
+      DMAC_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
+      return E_AS_GETSTATS_RESULT_NULL;
+    }
+
+  rtCodeBB = AS_AudioDrvDmaGetStats(dmacId, pStats);
+
+  if (rtCodeBB != E_AS_BB_DMA_OK)
+    {
+      return E_AS_DMAC_MSG_SEND_ERR;
+    }
+
+  _info("dma(%d) udf(%d) lat(%d,%d)\n", dmacId, pStats->underflow_cnt,
+        pStats->latency_avg, pStats->latency_max);
+
+  return rtCode;
+}
+
+/*--------------------------------------------------------------------*/
+E_AS AS_ClearDmacStats(cxd56_audio_dma_t dmacId)
+{
+  E_AS rtCode = E_AS_OK;
+  E_AS_BB rtCodeBB = E_AS_BB_DMA_OK;
+
+  rtCodeBB = AS_AudioDrvDmaClearStats(dmacId);
+
+  if (rtCodeBB != E_AS_BB_DMA_OK)
+    {
+      return E_AS_DMAC_MSG_SEND_ERR;
+    }
+
+  return rtCode;
+}
+
 /*--------------------------------------------------------------------*/
 E_AS AS_RegistDmaIntCb(cxd56_audio_dma_t dmacId,
                        cxd56_audio_dma_cb_t p_dmaIntCb)
@@ -361,7 +446,15 @@ E_AS AS_RegistDmaIntCb(cxd56_audio_dma_t dmacId,
       return E_AS_GETREADYCMD_RESULT_NULL;
     }
 
-  drv_ret = cxd56_audio_set_dmacb(dmacId, p_dmaIntCb);
+  if (dmacId > CXD56_AUDIO_DMAC_I2S1_DOWN)
+    {
+      DMAC_ERR(AS_ATTENTION_SUB_CODE_UNEXPECTED_PARAM);
+      return E_AS_DMAC_ID_PARAM;
+    }
+
+  dmacIntCb[dmacId] = p_dmaIntCb;
+
+  drv_ret = cxd56_audio_set_dmacb(dmacId, dmaIntHandler);
   if (CXD56_AUDIO_ECODE_OK != drv_ret)
     {
       _err("cxd56_audio_set_dmacb() is failer. err = 0x%x\n", drv_ret);
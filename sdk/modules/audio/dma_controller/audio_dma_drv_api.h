@@ -166,7 +166,11 @@ typedef enum
   E_AS_PATH_SEL_MIC_DMA_CHANNEL_PARAM,    /* 100 */
   E_AS_PATH_SEL_NOUSE_ERR,                /* 101 */
   E_AS_PATH_SEL_NULL,                     /* 102 */
-  E_AS_PATH_SEL_USED_ERR                  /* 103 */
+  E_AS_PATH_SEL_USED_ERR,                 /* 103 */
+  /* DMAC IF */
+  E_AS_DMAC_QUEUE_NUM_PARAM,              /* 104 */
+  E_AS_DMAC_UNDERFLOW_SAMPLE_PARAM,       /* 105 */
+  E_AS_GETSTATS_RESULT_NULL               /* 106 */
 } E_AS;
 
 /** DMAC interrupt notify code */
@@ -182,6 +186,19 @@ typedef enum
 #define DMAC_MIN_SIZE_INT 240
 
 
+/* Range of DMA ready queue depth.
+ * One request of DMAC_MAX_SIZE is split into 5 transfers at most,
+ * so the depth must be able to hold it.
+ */
+
+#define AS_DMAC_READY_QUEUE_MIN 5
+#define AS_DMAC_READY_QUEUE_MAX 30
+
+/* Range of silent samples inserted at underflow. */
+
+#define AS_DMAC_UNDERFLOW_SAMPLE_MIN DMAC_MIN_SIZE_INT
+#define AS_DMAC_UNDERFLOW_SAMPLE_MAX 1024 /* 21ms */
+
 #define AS_DMAC_BYTE_WT_24BIT 4
 #define AS_DMAC_BYTE_WT_16BIT 2
 
@@ -273,6 +290,10 @@ typedef struct
   AS_ErrorCb   p_error_func;     /* [in] DMAC transfer error callback */
   AS_DmaDoneCb p_dmadone_func;   /* [in] DMAC transfer done callback */
   bool         fade_en;          /* [in] auto fade mode, TRUE:ENABLE */
+  uint16_t     ready_que_num;    /* [in] ready queue depth, 0:default */
+  uint16_t     underflow_sample; /* [in] silent samples inserted at
+                                  *      underflow, 0:default
+                                  */
 } asInitDmacParam;
 
 /**
@@ -352,6 +373,46 @@ E_AS AS_StopDmac(cxd56_audio_dma_t dmacId, asDmacStopMode stopMode);
  */
 E_AS AS_GetReadyCmdNumDmac(cxd56_audio_dma_t dmacId, uint32_t *pResult);
 
+/** #AS_GetDmacStats function parameter */
+typedef struct
+{
+  uint32_t ready_que_num;   /* [out] ready queue depth */
+  uint32_t ready_peak;      /* [out] high-water mark of ready queue */
+  uint32_t transfer_cnt;    /* [out] number of completed transfers */
+  uint32_t underflow_cnt;   /* [out] number of underflows */
+  uint32_t overflow_cnt;    /* [out] number of requests lost by overflow */
+  uint32_t insert_sample;   /* [out] total silent samples inserted */
+  uint32_t latency_cnt;     /* [out] number of latency measurements */
+  uint32_t latency_last;    /* [out] last latency [us] */
+  uint32_t latency_min;     /* [out] minimum latency [us] */
+  uint32_t latency_max;     /* [out] maximum latency [us] */
+  uint32_t latency_avg;     /* [out] average latency [us] */
+} asDmacStats;
+
+/**
+ * @brief Get statistics of the DMAC
+ *
+ * Latency is the time from the transfer completion interrupt to
+ * the next transfer command set by the completion. It is measured
+ * only when the DMA interrupt callback is registered by
+ * #AS_RegistDmaIntCb and the ready queue has a request.
+ *
+ * @param[in] cxd56_audio_dma_t DMAC ID
+ * @param[out] asDmacStats* Statistics of the DMAC
+ *
+ * @retval E_AS return code
+ */
+E_AS AS_GetDmacStats(cxd56_audio_dma_t dmacId, asDmacStats *pStats);
+
+/**
+ * @brief Clear statistics of the DMAC
+ *
+ * @param[in] cxd56_audio_dma_t DMAC ID
+ *
+ * @retval E_AS return code
+ */
+E_AS AS_ClearDmacStats(cxd56_audio_dma_t dmacId);
+
 /**
  * @brief Regist DMA callback from interrupt handler
  *
@@ -0,0 +1,233 @@
+/****************************************************************************
+ * modules/audio/include/common/BitStreamReader.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_AUDIO_INCLUDE_COMMON_BITSTREAMREADER_H
+#define __MODULES_AUDIO_INCLUDE_COMMON_BITSTREAMREADER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define BITSTREAM_BIT_OF_BYTE   8
+#define BITSTREAM_BIT_OF_CACHE  64
+#define BITSTREAM_MAX_READ_BIT  32
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* MSB first bit stream reader.
+ *
+ * The bits are loaded to a 64bit cache, 4 bytes at a time while the
+ * buffer has them, so that a field is taken by one shift and one mask.
+ * Bits after the end of the buffer are read as 0, the buffer is never
+ * accessed out of "size".
+ */
+
+struct bitstream_reader_s
+{
+  const uint8_t *top;     /* Top of the buffer */
+  uint32_t       size;    /* Size of the buffer [byte] */
+  uint32_t       next;    /* Offset of the next byte to load to cache */
+  uint64_t       cache;   /* Loaded bits (MSB aligned) */
+  uint32_t       cached;  /* Number of valid bits in cache */
+};
+typedef struct bitstream_reader_s BitStreamReader;
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/*--------------------------------------------------------------------------*/
+static inline void BitStream_Init(BitStreamReader *ptr_reader,
+                                  const uint8_t *ptr_buff,
+                                  uint32_t size)
+{
+  ptr_reader->top    = ptr_buff;
+  ptr_reader->size   = size;
+  ptr_reader->next   = 0;
+  ptr_reader->cache  = 0;
+  ptr_reader->cached = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static inline void BitStream_Fill(BitStreamReader *ptr_reader)
+{
+  /* Load a word while 4 bytes are left, and the rest byte by byte.
+   * After this, at least 32 bits are in cache.
+   */
+
+  if (ptr_reader->next + 4 <= ptr_reader->size)
+    {
+      const uint8_t *p = ptr_reader->top + ptr_reader->next;
+      uint32_t word = ((uint32_t)p[0] << 24) |
+                      ((uint32_t)p[1] << 16) |
+                      ((uint32_t)p[2] << 8)  |
+                       (uint32_t)p[3];
+
+      ptr_reader->cache  |= (uint64_t)word << (32 - ptr_reader->cached);
+      ptr_reader->next   += 4;
+      ptr_reader->cached += 32;
+    }
+  else
+    {
+      while (ptr_reader->cached <= (BITSTREAM_BIT_OF_CACHE -
+                                    BITSTREAM_BIT_OF_BYTE))
+        {
+          uint64_t byte = (ptr_reader->next < ptr_reader->size) ?
+                            ptr_reader->top[ptr_reader->next] : 0;
+
+          ptr_reader->cache  |= byte << (BITSTREAM_BIT_OF_CACHE -
+                                         BITSTREAM_BIT_OF_BYTE -
+                                         ptr_reader->cached);
+          ptr_reader->next   += 1;
+          ptr_reader->cached += BITSTREAM_BIT_OF_BYTE;
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static inline uint32_t BitStream_Peek(BitStreamReader *ptr_reader,
+                                      uint32_t length_for_read)
+{
+  /* length_for_read is 1 to 32. */
+
+  if (ptr_reader->cached < length_for_read)
+    {
+      BitStream_Fill(ptr_reader);
+    }
+
+  return (uint32_t)(ptr_reader->cache >>
+                    (BITSTREAM_BIT_OF_CACHE - length_for_read));
+}
+
+/*--------------------------------------------------------------------------*/
+static inline uint32_t BitStream_Read(BitStreamReader *ptr_reader,
+                                      uint32_t length_for_read)
+{
+  /* length_for_read is 1 to 32. */
+
+  uint32_t rtn_value = BitStream_Peek(ptr_reader, length_for_read);
+
+  ptr_reader->cache  <<= length_for_read;
+  ptr_reader->cached  -= length_for_read;
+
+  return rtn_value;
+}
+
+/*--------------------------------------------------------------------------*/
+static inline uint32_t BitStream_GetPosition(const BitStreamReader *ptr_reader)
+{
+  /* Number of bits read from the top of the buffer. */
+
+  return (ptr_reader->next * BITSTREAM_BIT_OF_BYTE) - ptr_reader->cached;
+}
+
+/*--------------------------------------------------------------------------*/
+static inline void BitStream_Skip(BitStreamReader *ptr_reader,
+                                  uint32_t length_for_skip)
+{
+  if (length_for_skip <= ptr_reader->cached)
+    {
+      /* Shift of 64 bits is undefined, clear the cache instead. */
+
+      ptr_reader->cache = (length_for_skip < BITSTREAM_BIT_OF_CACHE) ?
+                            (ptr_reader->cache << length_for_skip) : 0;
+      ptr_reader->cached -= length_for_skip;
+      return;
+    }
+
+  /* Drop the cache, and move the load position directly. */
+
+  uint32_t position = BitStream_GetPosition(ptr_reader) + length_for_skip;
+
+  ptr_reader->next   = position / BITSTREAM_BIT_OF_BYTE;
+  ptr_reader->cache  = 0;
+  ptr_reader->cached = 0;
+
+  if (position % BITSTREAM_BIT_OF_BYTE)
+    {
+      BitStream_Read(ptr_reader, position % BITSTREAM_BIT_OF_BYTE);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static inline int32_t BitStream_FindSync(const uint8_t *ptr_buff,
+                                         uint32_t size,
+                                         uint16_t sync_word,
+                                         uint16_t sync_mask)
+{
+  /* Search a 16bit syncword on byte boundaries.
+   * The 1st byte must be fully given in sync_mask, so it is searched by
+   * memchr() and the 2nd byte is checked only at the candidates.
+   * Return the offset of the syncword, or -1 if not found.
+   */
+
+  uint8_t first = (uint8_t)(sync_word >> BITSTREAM_BIT_OF_BYTE);
+  uint8_t second = (uint8_t)sync_word;
+  uint8_t second_mask = (uint8_t)sync_mask;
+  const uint8_t *ptr = ptr_buff;
+  const uint8_t *last = ptr_buff + size - 1;
+
+  if (size < 2)
+    {
+      return -1;
+    }
+
+  while (ptr < last)
+    {
+      ptr = (const uint8_t *)memchr(ptr, first, last - ptr);
+      if (ptr == NULL)
+        {
+          break;
+        }
+      if ((ptr[1] & second_mask) == second)
+        {
+          return (int32_t)(ptr - ptr_buff);
+        }
+      ptr++;
+    }
+
+  return -1;
+}
+
+#endif /* __MODULES_AUDIO_INCLUDE_COMMON_BITSTREAMREADER_H */
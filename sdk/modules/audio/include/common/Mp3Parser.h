@@ -695,7 +695,7 @@ static const uint32_t mp3_parser_v1_sampling_frequency[4] =
 
 static const uint32_t mp3_parser_v2_sampling_frequency[4] =
 {
-  22500,
+  22050,
   24000,
   16000,
   0
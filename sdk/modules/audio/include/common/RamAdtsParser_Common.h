@@ -69,6 +69,8 @@
 
 #define ADTSPARSER_SYNCWORD_1    0xFF
 #define ADTSPARSER_SYNCWORD_2    0xF0
+#define ADTS_SYNCWORD            0xFFF  /* 12bit */
+#define ADTS_CHECK_SYNCWORD_SIZE 3      /* Least data to check syncword */
 
 /* check SYNCWORD */
 
@@ -81,6 +83,7 @@
 
 #define ADTS_MASK_PROFILE     0xC0    /* Mask [2] */
 #define ADTS_PROFILE_AACLC    0x40    /* profile=AAC-LC */
+#define ADTS_PROFILE_ID_AACLC 1       /* profile field value of AAC-LC */
 
 /*----- SamplingFrequency -----*/
 
@@ -109,7 +112,14 @@
           ((hdr4 & ADTS_MASK_FRAMELENGTH_4) << ADTS_LSHIFT_FRAMELENGTH_4) | \
           ((hdr5 & ADTS_MASK_FRAMELENGTH_5) >> ADTS_RSHIFT_FRAMELENGTH_5))
 
-#define ADTSPARSER_SYNCWORD_SEARCH_SIZE 3
+/* Syncword search
+ * (12bit syncword + id(MPEG-4) + layer(0) on byte boundary,
+ *  searched from the data peeked by the size below at once)
+ */
+
+#define ADTSPARSER_SYNCWORD_16BIT       0xFFF0
+#define ADTSPARSER_SYNCWORD_MASK        0xFFFE
+#define ADTSPARSER_SYNCWORD_SEARCH_SIZE 64
 
 /****************************************************************************
  * Public Types
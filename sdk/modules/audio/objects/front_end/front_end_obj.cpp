@@ -559,8 +559,8 @@ uint32_t MicFrontEndObject::loadComponent(AsMicFrontendPreProcType type, char *d
         break;
 
       case AsMicFrontendPreProcSrc:
-        m_p_preproc_instance = new SRCComponent(m_pool_id.dsp,
-                                                m_msgq_id.dsp);
+        m_p_preproc_instance = AS_filter_create_src(m_pool_id.dsp,
+                                                    m_msgq_id.dsp);
         break;
 
       default:
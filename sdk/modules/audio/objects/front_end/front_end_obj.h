@@ -51,7 +51,7 @@
 #include "components/capture/capture_component.h"
 #include "components/customproc/usercustom_component.h"
 #include "components/customproc/thruproc_component.h"
-#include "components/filter/src_filter_component.h"
+#include "components/filter/filter_api.h"
 
 __WIEN2_BEGIN_NAMESPACE
 
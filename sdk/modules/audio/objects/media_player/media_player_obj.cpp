@@ -69,6 +69,13 @@ using namespace MemMgrLite;
 
 #define SRC_WORK_BUF_SIZE 8192 /* 1024sample * 2ch * 4bytes */
 
+/* When ES pool is RingBuf type, ES buffer is allocated as 1/2 of
+ * the pool and shrunk to the read size. So the pool size should be
+ * twice of the maximum ES size.
+ */
+
+#define ES_RINGBUF_MAX_SIZE_DIV 2
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -1522,6 +1529,10 @@ void* PlayerObj::getEs(uint32_t* size)
 
   if (m_input_device_handler->getEs(mh.getVa(), size))
     {
+      /* Return the rest of the buffer to the pool. */
+
+      mh.shrinkSeg(*size);
+
       if (!m_es_buf_mh_que.push(mh))
         {
           MEDIA_PLAYER_ERR(AS_ATTENTION_SUB_CODE_QUEUE_PUSH_ERROR);
@@ -1613,8 +1624,16 @@ bool PlayerObj::checkAndSetMemPool()
       MEDIA_PLAYER_ERR(AS_ATTENTION_SUB_CODE_MEMHANDLE_ALLOC_ERROR);
       return false;
     }
-  m_max_es_buff_size = (MemMgrLite::Manager::getPoolSize(m_pool_id.es)) /
-    (MemMgrLite::Manager::getPoolNumSegs(m_pool_id.es));
+  if (MemMgrLite::Manager::getPoolType(m_pool_id.es) == MemMgrLite::RingBufType)
+    {
+      m_max_es_buff_size = (MemMgrLite::Manager::getPoolSize(m_pool_id.es)) /
+        ES_RINGBUF_MAX_SIZE_DIV;
+    }
+  else
+    {
+      m_max_es_buff_size = (MemMgrLite::Manager::getPoolSize(m_pool_id.es)) /
+        (MemMgrLite::Manager::getPoolNumSegs(m_pool_id.es));
+    }
 
   if (!MemMgrLite::Manager::isPoolAvailable(m_pool_id.pcm))
     {
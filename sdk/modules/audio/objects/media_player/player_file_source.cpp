@@ -0,0 +1,314 @@
+/****************************************************************************
+ * modules/audio/objects/media_player/player_file_source.cpp
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <unistd.h>
+#include <sched.h>
+#include "audio/utilities/player_file_source.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/*--------------------------------------------------------------------------*/
+void *PlayerFileSource::entry(void *arg)
+{
+  static_cast<PlayerFileSource *>(arg)->run();
+
+  return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerFileSource::notifySpace(void *arg,
+                                   CMN_SimpleFifoWatermarkEvent event,
+                                   size_t occupied)
+{
+  /* Called in the context of the player when the FIFO gets space
+   * for one read.
+   */
+
+  sem_post(static_cast<sem_t *>(arg));
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerFileSource::readDone(uint32_t size)
+{
+  /* Do nothing. The reader thread is woken by the watermark. */
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerFileSource::fill(void)
+{
+  /* Read the file directly into the FIFO while it has space for
+   * one read. Must be called with m_lock held.
+   */
+
+  CMN_SimpleFifoPeekHandle region;
+
+  while (m_fd >= 0 && !m_eof)
+    {
+      if (CMN_SimpleFifoReserve(&m_fifo, &region, m_read_size) < m_read_size)
+        {
+          break;
+        }
+
+      size_t total = 0;
+
+      for (int i = 0; i < 2 && region.m_szChunk[i] > 0; i++)
+        {
+          ssize_t ret = ::read(m_fd, region.m_pChunk[i], region.m_szChunk[i]);
+          if (ret < 0)
+            {
+              m_error = true;
+              m_eof   = true;
+              break;
+            }
+
+          total += ret;
+
+          if ((size_t)ret < region.m_szChunk[i])
+            {
+              m_eof = true;
+              break;
+            }
+        }
+
+      CMN_SimpleFifoCommit(&m_fifo, total);
+      m_read_total += total;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerFileSource::run(void)
+{
+  for (;;)
+    {
+      sem_wait(&m_space_sem);
+
+      pthread_mutex_lock(&m_lock);
+
+      if (m_quit)
+        {
+          pthread_mutex_unlock(&m_lock);
+          break;
+        }
+
+      fill();
+
+      pthread_mutex_unlock(&m_lock);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/*--------------------------------------------------------------------------*/
+bool PlayerFileSource::init(const Param &param)
+{
+  if (m_running)
+    {
+      return false;
+    }
+
+  if (param.buffer == NULL ||
+      param.read_size == 0 ||
+      param.buffer_size <= param.read_size)
+    {
+      return false;
+    }
+
+  if (CMN_SimpleFifoInitialize(&m_fifo,
+                               param.buffer,
+                               param.buffer_size,
+                               NULL) != 0)
+    {
+      return false;
+    }
+
+  /* Wake up the reader thread when the FIFO has space for one read. */
+
+  if (CMN_SimpleFifoSetWatermark(&m_fifo,
+                                 CMN_SIMPLE_FIFO_NO_WATERMARK,
+                                 param.buffer_size - 1 - param.read_size,
+                                 notifySpace,
+                                 &m_space_sem) != 0)
+    {
+      return false;
+    }
+
+  m_read_size  = param.read_size;
+  m_fd         = -1;
+  m_eof        = true;
+  m_error      = false;
+  m_quit       = false;
+  m_read_total = 0;
+
+  m_input_device.simple_fifo_handler         = &m_fifo;
+  m_input_device.callback_function           = readDone;
+  m_input_device.notification_threshold_size = 0;
+
+  pthread_mutex_init(&m_lock, NULL);
+  sem_init(&m_space_sem, 0, 0);
+
+  /* Create reader thread. */
+
+  pthread_attr_t attr;
+  struct sched_param sch_param;
+
+  pthread_attr_init(&attr);
+
+  sch_param.sched_priority = param.priority;
+  pthread_attr_setstacksize(&attr, param.stack_size);
+
+  pthread_attr_setschedparam(&attr, &sch_param);
+
+  int ret = pthread_create(&m_pid,
+                           &attr,
+                           (pthread_startroutine_t)entry,
+                           (pthread_addr_t)this);
+  if (ret != 0)
+    {
+      sem_destroy(&m_space_sem);
+      pthread_mutex_destroy(&m_lock);
+      return false;
+    }
+
+  m_running = true;
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerFileSource::deinit(void)
+{
+  if (!m_running)
+    {
+      return;
+    }
+
+  pthread_mutex_lock(&m_lock);
+  m_quit = true;
+  m_fd   = -1;
+  pthread_mutex_unlock(&m_lock);
+
+  sem_post(&m_space_sem);
+  pthread_join(m_pid, NULL);
+
+  sem_destroy(&m_space_sem);
+  pthread_mutex_destroy(&m_lock);
+
+  m_running = false;
+}
+
+/*--------------------------------------------------------------------------*/
+bool PlayerFileSource::open(int fd)
+{
+  if (!m_running || fd < 0)
+    {
+      return false;
+    }
+
+  pthread_mutex_lock(&m_lock);
+
+  m_fd         = fd;
+  m_eof        = false;
+  m_error      = false;
+  m_read_total = lseek(fd, 0, SEEK_CUR);
+  if (m_read_total < 0)
+    {
+      m_read_total = 0;
+    }
+
+  CMN_SimpleFifoClear(&m_fifo);
+
+  /* Fill the FIFO before the player starts. */
+
+  fill();
+
+  pthread_mutex_unlock(&m_lock);
+
+  return !m_error;
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerFileSource::close(void)
+{
+  if (!m_running)
+    {
+      return;
+    }
+
+  pthread_mutex_lock(&m_lock);
+
+  m_fd  = -1;
+  m_eof = true;
+
+  CMN_SimpleFifoClear(&m_fifo);
+
+  pthread_mutex_unlock(&m_lock);
+}
+
+/*--------------------------------------------------------------------------*/
+bool PlayerFileSource::seek(off_t offset)
+{
+  if (!m_running)
+    {
+      return false;
+    }
+
+  pthread_mutex_lock(&m_lock);
+
+  if (m_fd < 0 || lseek(m_fd, offset, SEEK_SET) != offset)
+    {
+      pthread_mutex_unlock(&m_lock);
+      return false;
+    }
+
+  m_eof        = false;
+  m_error      = false;
+  m_read_total = offset;
+
+  CMN_SimpleFifoClear(&m_fifo);
+
+  fill();
+
+  pthread_mutex_unlock(&m_lock);
+
+  return !m_error;
+}
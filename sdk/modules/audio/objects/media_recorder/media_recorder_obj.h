@@ -54,8 +54,7 @@
 #include "components/common/component_base.h"
 #include "components/encoder/encoder_component.h"
 #include "components/customproc/thruproc_component.h"
-#include "components/filter/src_filter_component.h"
-#include "components/filter/packing_component.h"
+#include "components/filter/filter_api.h"
 
 __WIEN2_BEGIN_NAMESPACE
 
@@ -101,7 +100,7 @@ public:
      * heap memory area leak.
      */
 
-    m_src_instance = new SRCComponent(m_pool_id.dsp, m_msgq_id.dsp);
+    m_src_instance = AS_filter_create_src(m_pool_id.dsp, m_msgq_id.dsp);
     m_packing_instance = new PackingComponent();
     m_thruproc_instance = new ThruProcComponent();
   }
@@ -141,7 +140,7 @@ private:
   AudioRecorderSink m_rec_sink;
 
   ComponentBase *m_filter_instance;
-  SRCComponent *m_src_instance;
+  ComponentBase *m_src_instance;
   PackingComponent *m_packing_instance;
   ThruProcComponent *m_thruproc_instance;
 
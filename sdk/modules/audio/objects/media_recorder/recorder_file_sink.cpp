@@ -0,0 +1,470 @@
+/****************************************************************************
+ * modules/audio/objects/media_recorder/recorder_file_sink.cpp
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include "memutils/os_utils/chateau_osal.h"
+#include "audio/utilities/recorder_file_sink.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/*--------------------------------------------------------------------------*/
+static bool write_all(int fd, const void *buf, size_t size)
+{
+  const uint8_t *p = static_cast<const uint8_t *>(buf);
+
+  while (size > 0)
+    {
+      ssize_t ret = ::write(fd, p, size);
+      if (ret <= 0)
+        {
+          return false;
+        }
+
+      p    += ret;
+      size -= ret;
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+void *RecorderFileSink::entry(void *arg)
+{
+  static_cast<RecorderFileSink *>(arg)->run();
+
+  return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+void RecorderFileSink::notifyData(void *arg,
+                                  CMN_SimpleFifoWatermarkEvent event,
+                                  size_t occupied)
+{
+  /* Called in the context of the recorder when the FIFO has data
+   * for one batch.
+   */
+
+  sem_post(static_cast<sem_t *>(arg));
+}
+
+/*--------------------------------------------------------------------------*/
+void RecorderFileSink::writeDone(uint32_t size)
+{
+  /* Do nothing. The writer thread is woken by the watermark. */
+}
+
+/*--------------------------------------------------------------------------*/
+bool RecorderFileSink::writeHeader(void)
+{
+  if (m_container == NULL)
+    {
+      return true;
+    }
+
+  WAVHEADER header;
+
+  m_container->getHeader(&header, m_data_size);
+
+  if (lseek(m_fd, 0, SEEK_SET) != 0 ||
+      !write_all(m_fd, &header, sizeof(header)))
+    {
+      return false;
+    }
+
+  /* Back to the end of the data. */
+
+  off_t pos = m_data_offset + m_data_size;
+
+  return (lseek(m_fd, pos, SEEK_SET) == pos);
+}
+
+/*--------------------------------------------------------------------------*/
+bool RecorderFileSink::writeBatch(size_t size)
+{
+  CMN_SimpleFifoPeekHandle region;
+  bool result = true;
+
+  /* Write the data directly from the FIFO. The data may be split at
+   * the end of the FIFO buffer.
+   */
+
+  CMN_SimpleFifoAcquire(&m_fifo, &region, size);
+
+  uint32_t start = Chateau_GetTimeUs();
+
+  for (int i = 0; i < 2 && region.m_szChunk[i] > 0; i++)
+    {
+      if (!write_all(m_fd, region.m_pChunk[i], region.m_szChunk[i]))
+        {
+          result = false;
+          break;
+        }
+    }
+
+  CMN_SimpleFifoRelease(&m_fifo, size);
+
+  if (result)
+    {
+      m_data_size += size;
+      m_batch_cnt++;
+
+      /* Make the data written so far playable. */
+
+      if (m_header_interval != 0 && (m_batch_cnt % m_header_interval) == 0)
+        {
+          result = writeHeader() && (fsync(m_fd) == 0);
+        }
+    }
+
+  uint32_t elapsed = Chateau_GetTimeUs() - start;
+
+  m_stats.write_count++;
+  m_stats.write_bytes   += size;
+  m_stats.write_time_us += elapsed;
+  if (m_stats.max_write_time_us < elapsed)
+    {
+      m_stats.max_write_time_us = elapsed;
+    }
+
+  return result;
+}
+
+/*--------------------------------------------------------------------------*/
+void RecorderFileSink::flush(bool all)
+{
+  /* Must be called with m_lock held. */
+
+  for (;;)
+    {
+      size_t occupied = CMN_SimpleFifoGetOccupiedSize(&m_fifo);
+
+      if (m_stats.max_occupied_size < occupied)
+        {
+          m_stats.max_occupied_size = occupied;
+        }
+
+      if (occupied == 0)
+        {
+          break;
+        }
+
+      if (m_error)
+        {
+          /* Discard the data not to stop the recorder. */
+
+          CMN_SimpleFifoRelease(&m_fifo, occupied);
+          break;
+        }
+
+      /* Write up to the next write_size boundary of the file, so that
+       * the writes after the header are aligned.
+       */
+
+      size_t size = m_write_size -
+                    ((m_data_offset + m_data_size) % m_write_size);
+
+      if (occupied < size)
+        {
+          if (!all)
+            {
+              break;
+            }
+
+          size = occupied;
+        }
+
+      if (!writeBatch(size))
+        {
+          m_error = true;
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+void RecorderFileSink::run(void)
+{
+  for (;;)
+    {
+      sem_wait(&m_data_sem);
+
+      pthread_mutex_lock(&m_lock);
+
+      if (m_quit)
+        {
+          pthread_mutex_unlock(&m_lock);
+          break;
+        }
+
+      if (m_fd >= 0)
+        {
+          flush(false);
+        }
+
+      pthread_mutex_unlock(&m_lock);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/*--------------------------------------------------------------------------*/
+bool RecorderFileSink::init(const Param &param)
+{
+  if (m_running)
+    {
+      return false;
+    }
+
+  if (param.buffer == NULL ||
+      param.write_size == 0 ||
+      param.buffer_size <= param.write_size)
+    {
+      return false;
+    }
+
+  if (CMN_SimpleFifoInitialize(&m_fifo,
+                               param.buffer,
+                               param.buffer_size,
+                               NULL) != 0)
+    {
+      return false;
+    }
+
+  /* Wake up the writer thread when the FIFO has data for one batch. */
+
+  if (CMN_SimpleFifoSetWatermark(&m_fifo,
+                                 param.write_size,
+                                 CMN_SIMPLE_FIFO_NO_WATERMARK,
+                                 notifyData,
+                                 &m_data_sem) != 0)
+    {
+      return false;
+    }
+
+  m_buffer          = param.buffer;
+  m_write_size      = param.write_size;
+  m_header_interval = param.header_interval;
+  m_fd              = -1;
+  m_error           = false;
+  m_quit            = false;
+
+  memset(&m_stats, 0, sizeof(m_stats));
+
+  m_output_device.simple_fifo_handler = &m_fifo;
+  m_output_device.callback_function   = writeDone;
+
+  pthread_mutex_init(&m_lock, NULL);
+  sem_init(&m_data_sem, 0, 0);
+
+  /* Create writer thread. */
+
+  pthread_attr_t attr;
+  struct sched_param sch_param;
+
+  pthread_attr_init(&attr);
+
+  sch_param.sched_priority = param.priority;
+  pthread_attr_setstacksize(&attr, param.stack_size);
+
+  pthread_attr_setschedparam(&attr, &sch_param);
+
+  int ret = pthread_create(&m_pid,
+                           &attr,
+                           (pthread_startroutine_t)entry,
+                           (pthread_addr_t)this);
+  if (ret != 0)
+    {
+      sem_destroy(&m_data_sem);
+      pthread_mutex_destroy(&m_lock);
+      return false;
+    }
+
+  m_running = true;
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+void RecorderFileSink::deinit(void)
+{
+  if (!m_running)
+    {
+      return;
+    }
+
+  pthread_mutex_lock(&m_lock);
+  m_quit = true;
+  m_fd   = -1;
+  pthread_mutex_unlock(&m_lock);
+
+  sem_post(&m_data_sem);
+  pthread_join(m_pid, NULL);
+
+  sem_destroy(&m_data_sem);
+  pthread_mutex_destroy(&m_lock);
+
+  m_running = false;
+}
+
+/*--------------------------------------------------------------------------*/
+bool RecorderFileSink::open(int fd,
+                            WavContainerFormat *container,
+                            uint32_t prealloc_size)
+{
+  if (!m_running || fd < 0)
+    {
+      return false;
+    }
+
+  pthread_mutex_lock(&m_lock);
+
+  m_container     = container;
+  m_error         = false;
+  m_batch_cnt     = 0;
+  m_data_size     = 0;
+  m_data_offset   = (container != NULL) ? sizeof(WAVHEADER) : 0;
+  m_prealloc_size = 0;
+
+  memset(&m_stats, 0, sizeof(m_stats));
+
+  CMN_SimpleFifoClear(&m_fifo);
+
+  /* Allocate the clusters in advance by writing zeros. The FIFO buffer
+   * is not used yet, so use it as the source.
+   */
+
+  bool result = true;
+
+  if (prealloc_size > 0)
+    {
+      memset(m_buffer, 0, m_write_size);
+
+      for (uint32_t pos = 0; result && pos < prealloc_size; )
+        {
+          uint32_t size = prealloc_size - pos;
+
+          size = (size > m_write_size) ? m_write_size : size;
+          result = write_all(fd, m_buffer, size);
+          pos += size;
+        }
+
+      m_prealloc_size = prealloc_size;
+
+      result = result && (lseek(fd, 0, SEEK_SET) == 0);
+    }
+
+  m_fd = fd;
+
+  /* Write the header with data size 0. It is updated while recording. */
+
+  result = result && writeHeader();
+
+  if (!result)
+    {
+      m_fd = -1;
+    }
+
+  pthread_mutex_unlock(&m_lock);
+
+  return result;
+}
+
+/*--------------------------------------------------------------------------*/
+bool RecorderFileSink::close(void)
+{
+  if (!m_running)
+    {
+      return false;
+    }
+
+  pthread_mutex_lock(&m_lock);
+
+  if (m_fd < 0)
+    {
+      pthread_mutex_unlock(&m_lock);
+      return false;
+    }
+
+  /* Write all data left in the FIFO. */
+
+  flush(true);
+
+  bool result = !m_error && writeHeader();
+
+  /* Cut the preallocated area which is not used. */
+
+  off_t end = m_data_offset + m_data_size;
+
+  if (result && m_prealloc_size > end)
+    {
+      result = (ftruncate(m_fd, end) == 0);
+    }
+
+  result = (fsync(m_fd) == 0) && result;
+
+  m_fd = -1;
+
+  pthread_mutex_unlock(&m_lock);
+
+  return result;
+}
+
+/*--------------------------------------------------------------------------*/
+void RecorderFileSink::getStats(Stats *stats)
+{
+  if (!m_running)
+    {
+      memset(stats, 0, sizeof(*stats));
+      return;
+    }
+
+  /* The writer thread updates the statistics with m_lock held. */
+
+  pthread_mutex_lock(&m_lock);
+  *stats = m_stats;
+  pthread_mutex_unlock(&m_lock);
+
+  stats->bandwidth = (stats->write_time_us == 0) ? 0 :
+    (uint32_t)((uint64_t)stats->write_bytes * 1000000 / stats->write_time_us);
+}
@@ -0,0 +1,434 @@
+/****************************************************************************
+ * modules/audio/objects/output_mixer/clock_drift_compensator.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <string.h>
+#include "clock_drift_compensator.h"
+
+__WIEN2_BEGIN_NAMESPACE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Time constant of the fill level smoothing [sample].
+ * About 8 seconds at 48kHz. The jitter of the arrival time must not
+ * reach the ratio, because the ratio noise is the phase noise of the
+ * output. It is still fast compared with the control loop below.
+ */
+
+#define DRIFT_LEVEL_TC       393216.0f
+
+/* Gains of the PI controller.
+ * Proportional gain is per sample of the level error, integral gain is
+ * per sample of the level error and per sample of time. They give
+ * the natural frequency of about 0.005Hz at 48kHz with critical
+ * damping, so the level moves less than 1 frame to follow 300ppm step.
+ */
+
+#define DRIFT_KP             1.3e-6f
+#define DRIFT_KI             4.3e-13f
+
+/* Time constant of the sink rate measurement [frame]. */
+
+#define DRIFT_RATE_TC        64
+
+#define DRIFT_MAX_CORRECTION ((float)DRIFT_MAX_PPM / 1000000.0f)
+
+#define Q32_ONE              4294967296.0
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline float to_float(int16_t x)
+{
+  return (float)x;
+}
+
+static inline float to_float(int32_t x)
+{
+  return (float)x;
+}
+
+/*--------------------------------------------------------------------------*/
+static inline void from_float(float y, int16_t *x)
+{
+  if (y >= 32767.0f)
+    {
+      *x = 32767;
+    }
+  else if (y <= -32768.0f)
+    {
+      *x = -32768;
+    }
+  else
+    {
+      *x = (int16_t)((y >= 0.0f) ? (y + 0.5f) : (y - 0.5f));
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static inline void from_float(float y, int32_t *x)
+{
+  /* 2147483520 is the largest float below 2^31. */
+
+  if (y >= 2147483520.0f)
+    {
+      *x = 2147483647;
+    }
+  else if (y <= -2147483648.0f)
+    {
+      *x = (-2147483647 - 1);
+    }
+  else
+    {
+      *x = (int32_t)((y >= 0.0f) ? (y + 0.5f) : (y - 0.5f));
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static inline float cubic(float xm1, float x0, float x1, float x2, float f)
+{
+  /* Catmull-Rom spline between x0 and x1. */
+
+  return x0 + 0.5f * f * ((x1 - xm1)
+                + f * ((2.0f * xm1 - 5.0f * x0 + 4.0f * x1 - x2)
+                + f * (3.0f * (x0 - x1) + x2 - xm1)));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/*--------------------------------------------------------------------------*/
+/* Methods of ClockDriftEstimator class */
+/*--------------------------------------------------------------------------*/
+void ClockDriftEstimator::reset(void)
+{
+  m_frames    = 0;
+  m_target    = 0.0f;
+  m_level     = 0.0f;
+  m_integral  = 0.0f;
+  m_ratio     = 1.0f;
+  m_done_cnt  = 0;
+  m_done_time = 0;
+  m_sink_rate = 0.0f;
+}
+
+/*--------------------------------------------------------------------------*/
+void ClockDriftEstimator::done(uint32_t samples, uint32_t time)
+{
+  if (m_done_cnt > 0)
+    {
+      uint32_t interval = time - m_done_time;
+
+      if (interval > 0)
+        {
+          float rate = (float)samples / (float)interval;
+
+          if (m_done_cnt == 1)
+            {
+              m_sink_rate = rate;
+            }
+          else
+            {
+              m_sink_rate += (rate - m_sink_rate) / DRIFT_RATE_TC;
+            }
+        }
+    }
+
+  m_done_time = time;
+  m_done_cnt++;
+}
+
+/*--------------------------------------------------------------------------*/
+float ClockDriftEstimator::update(uint32_t queued,
+                                  uint32_t samples,
+                                  uint32_t time)
+{
+  /* Take off the samples of the head frame which are already played. */
+
+  float fill = (float)queued;
+
+  int32_t elapsed = (int32_t)(time - m_done_time);
+
+  if ((m_done_cnt > 1) && (elapsed > 0))
+    {
+      float played = (float)elapsed * m_sink_rate;
+
+      fill = (played < fill) ? (fill - played) : 0.0f;
+    }
+
+  /* At first, take the average level as the target. */
+
+  if (m_frames < DRIFT_WARMUP_FRAMES)
+    {
+      /* Skip the 1st half, while the sink is being filled. */
+
+      if (m_frames >= DRIFT_WARMUP_FRAMES / 2)
+        {
+          m_target += fill;
+        }
+
+      m_frames++;
+
+      if (m_frames == DRIFT_WARMUP_FRAMES)
+        {
+          m_target /= (DRIFT_WARMUP_FRAMES - DRIFT_WARMUP_FRAMES / 2);
+          m_level   = m_target;
+        }
+
+      return m_ratio;
+    }
+
+  /* Smooth the level. */
+
+  float alpha = (float)samples / ((float)samples + DRIFT_LEVEL_TC);
+
+  m_level += alpha * (fill - m_level);
+
+  float error = m_level - m_target;
+
+  /* Integrate with anti-windup, the integral term alone must not
+   * exceed the limit.
+   */
+
+  m_integral += error * (float)samples;
+
+  if (m_integral * DRIFT_KI > DRIFT_MAX_CORRECTION)
+    {
+      m_integral = DRIFT_MAX_CORRECTION / DRIFT_KI;
+    }
+  else if (m_integral * DRIFT_KI < -DRIFT_MAX_CORRECTION)
+    {
+      m_integral = -DRIFT_MAX_CORRECTION / DRIFT_KI;
+    }
+
+  float correction = DRIFT_KP * error + DRIFT_KI * m_integral;
+
+  if (correction > DRIFT_MAX_CORRECTION)
+    {
+      correction = DRIFT_MAX_CORRECTION;
+    }
+  else if (correction < -DRIFT_MAX_CORRECTION)
+    {
+      correction = -DRIFT_MAX_CORRECTION;
+    }
+
+  /* More samples are waiting, more input samples are consumed for
+   * one output sample.
+   */
+
+  m_ratio = 1.0f + correction;
+
+  return m_ratio;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Methods of FractionalResampler class */
+/*--------------------------------------------------------------------------*/
+void FractionalResampler::reset(void)
+{
+  memset(m_window, 0, sizeof(m_window));
+  m_pos    = (uint64_t)1 << 32;
+  m_primed = false;
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t FractionalResampler::exec(int16_t *buf,
+                                   uint32_t samples,
+                                   uint32_t max_samples,
+                                   float ratio)
+{
+  return execImpl<int16_t>(buf, samples, max_samples, ratio);
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t FractionalResampler::exec(int32_t *buf,
+                                   uint32_t samples,
+                                   uint32_t max_samples,
+                                   float ratio)
+{
+  return execImpl<int32_t>(buf, samples, max_samples, ratio);
+}
+
+/*--------------------------------------------------------------------------*/
+template <typename T>
+uint32_t FractionalResampler::execImpl(T *buf,
+                                       uint32_t samples,
+                                       uint32_t max_samples,
+                                       float ratio)
+{
+  const float frac_scale = (float)(1.0 / Q32_ONE);
+  uint64_t step = (uint64_t)((double)ratio * Q32_ONE);
+  uint32_t read = 0;     /* Input samples taken into window */
+  uint32_t made = 0;     /* Output samples made */
+  uint32_t written = 0;  /* Output samples written to buf */
+
+  if (samples == 0)
+    {
+      return 0;
+    }
+
+  /* At the top of the stream, fill the history by the 1st sample. */
+
+  if (!m_primed)
+    {
+      for (int i = 0; i < 3; i++)
+        {
+          for (int ch = 0; ch < RESAMPLER_CH_NUM; ch++)
+            {
+              m_window[i][ch] = to_float(buf[ch]);
+            }
+        }
+
+      m_primed = true;
+    }
+
+  while (read < samples)
+    {
+      uint32_t n = samples - read;
+
+      if (n > RESAMPLER_BLOCK_SAMPLES)
+        {
+          n = RESAMPLER_BLOCK_SAMPLES;
+        }
+
+      /* Take next block. After this, buf[0 .. read) can be overwritten. */
+
+      const T *src = buf + (read * RESAMPLER_CH_NUM);
+
+      for (uint32_t i = 0; i < n; i++)
+        {
+          for (int ch = 0; ch < RESAMPLER_CH_NUM; ch++)
+            {
+              m_window[3 + i][ch] = to_float(src[i * RESAMPLER_CH_NUM + ch]);
+            }
+        }
+
+      read += n;
+
+      /* Write held outputs to the area which was just read. */
+
+      while ((written < made) && (written < read))
+        {
+          float *p = m_pending[written % RESAMPLER_PENDING_SAMPLES];
+
+          for (int ch = 0; ch < RESAMPLER_CH_NUM; ch++)
+            {
+              from_float(p[ch], &buf[written * RESAMPLER_CH_NUM + ch]);
+            }
+
+          written++;
+        }
+
+      /* Interpolate between m_window[ip] and m_window[ip + 1] while the
+       * 4 taps are in the window.
+       */
+
+      while ((uint32_t)(m_pos >> 32) <= n)
+        {
+          uint32_t ip = (uint32_t)(m_pos >> 32);
+          float f = (float)(uint32_t)m_pos * frac_scale;
+
+          if ((written == made) && (made < read))
+            {
+              T *dst = buf + (made * RESAMPLER_CH_NUM);
+
+              for (int ch = 0; ch < RESAMPLER_CH_NUM; ch++)
+                {
+                  from_float(cubic(m_window[ip - 1][ch],
+                                   m_window[ip][ch],
+                                   m_window[ip + 1][ch],
+                                   m_window[ip + 2][ch],
+                                   f),
+                             &dst[ch]);
+                }
+
+              written++;
+              made++;
+            }
+          else if ((made - written) < RESAMPLER_PENDING_SAMPLES)
+            {
+              float *p = m_pending[made % RESAMPLER_PENDING_SAMPLES];
+
+              for (int ch = 0; ch < RESAMPLER_CH_NUM; ch++)
+                {
+                  p[ch] = cubic(m_window[ip - 1][ch],
+                                m_window[ip][ch],
+                                m_window[ip + 1][ch],
+                                m_window[ip + 2][ch],
+                                f);
+                }
+
+              made++;
+            }
+          else
+            {
+              /* No room to hold, drop this sample. */
+            }
+
+          m_pos += step;
+        }
+
+      /* Keep last 3 samples as the history of next block. */
+
+      m_pos -= (uint64_t)n << 32;
+      memmove(m_window[0], m_window[n], sizeof(m_window[0]) * 3);
+    }
+
+  /* All input is read, write the rest up to the end of buffer. */
+
+  while ((written < made) && (written < max_samples))
+    {
+      float *p = m_pending[written % RESAMPLER_PENDING_SAMPLES];
+
+      for (int ch = 0; ch < RESAMPLER_CH_NUM; ch++)
+        {
+          from_float(p[ch], &buf[written * RESAMPLER_CH_NUM + ch]);
+        }
+
+      written++;
+    }
+
+  return written;
+}
+
+__WIEN2_END_NAMESPACE
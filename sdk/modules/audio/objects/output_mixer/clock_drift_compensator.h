@@ -0,0 +1,186 @@
+/****************************************************************************
+ * modules/audio/objects/output_mixer/clock_drift_compensator.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#ifndef __MODULES_AUDIO_OBJECTS_OUTPUT_MIXER_CLOCK_DRIFT_COMPENSATOR_H
+#define __MODULES_AUDIO_OBJECTS_OUTPUT_MIXER_CLOCK_DRIFT_COMPENSATOR_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include "wien2_common_defs.h"
+
+__WIEN2_BEGIN_NAMESPACE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Maximum correction of the rate ratio [ppm].
+ * Crystals of both ends are usually within +/-100ppm, so this has
+ * enough margin and still limits the pitch change to 1.7 cent.
+ */
+
+#define DRIFT_MAX_PPM             1000
+
+/* Number of frames to get the target fill level before correction. */
+
+#define DRIFT_WARMUP_FRAMES       16
+
+/* Number of samples processed at once by the resampler, and the number
+ * of output samples which can be held in it while the frame is being
+ * overwritten.
+ */
+
+#define RESAMPLER_BLOCK_SAMPLES   64
+#define RESAMPLER_PENDING_SAMPLES 32
+
+#define RESAMPLER_CH_NUM          2
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Estimator of the clock ratio of the source and the sink.
+ *
+ * The fill level is the number of samples queued to the sink, less the
+ * samples of the head frame which are already played. The latter is
+ * got from the time since the sink finished the previous frame, and
+ * the sink rate measured by the same way.
+ * If the source is faster than the sink, the level goes up, and if it
+ * is slower, the level goes down. The level is smoothed, and the
+ * difference from the level at the start is fed to a PI controller,
+ * whose output is the ratio of input samples per output sample.
+ * Times are in us, and only their differences are used.
+ */
+
+class ClockDriftEstimator
+{
+public:
+  ClockDriftEstimator()
+  {
+    reset();
+  }
+
+  void reset(void);
+
+  /* The sink finished a frame of "samples" at "time". */
+
+  void done(uint32_t samples, uint32_t time);
+
+  /* Update by the number of samples queued to the sink at "time",
+   * before a frame of "samples" is queued, and return the new ratio.
+   */
+
+  float update(uint32_t queued, uint32_t samples, uint32_t time);
+
+  float get_ratio(void) const { return m_ratio; }
+  float get_target(void) const { return m_target; }
+  float get_level(void) const { return m_level; }
+
+  int32_t get_ppm(void) const
+  {
+    return (int32_t)((m_ratio - 1.0f) * 1000000.0f);
+  }
+
+private:
+  uint32_t m_frames;
+  float    m_target;
+  float    m_level;
+  float    m_integral;
+  float    m_ratio;
+
+  uint32_t m_done_cnt;
+  uint32_t m_done_time;
+  float    m_sink_rate;   /* [sample/us] */
+};
+
+/* Fractional resampler of stereo interleaved PCM.
+ *
+ * The output is interpolated by Catmull-Rom cubic at a phase which
+ * advances by the ratio for each output sample. The phase and the
+ * last 3 input samples are carried to the next frame, so the output
+ * is continuous over frames. The delay is 2 samples.
+ *
+ * The output is written over the input. The input is read by blocks,
+ * and outputs which would overwrite unread input are held until it is
+ * read. So the buffer must have room for some samples more than the
+ * input when the ratio is below 1.
+ */
+
+class FractionalResampler
+{
+public:
+  FractionalResampler()
+  {
+    reset();
+  }
+
+  void reset(void);
+
+  /* Resample "samples" samples (per channel) in "buf" by "ratio".
+   * The buffer can hold "max_samples" samples. Return the number of
+   * output samples.
+   */
+
+  uint32_t exec(int16_t *buf,
+                uint32_t samples,
+                uint32_t max_samples,
+                float ratio);
+  uint32_t exec(int32_t *buf,
+                uint32_t samples,
+                uint32_t max_samples,
+                float ratio);
+
+private:
+  /* Input block with the last 3 samples of the previous block. */
+
+  float    m_window[3 + RESAMPLER_BLOCK_SAMPLES][RESAMPLER_CH_NUM];
+  float    m_pending[RESAMPLER_PENDING_SAMPLES][RESAMPLER_CH_NUM];
+  uint64_t m_pos;      /* Phase in m_window (Q32.32) */
+  bool     m_primed;
+
+  template <typename T>
+  uint32_t execImpl(T *buf,
+                    uint32_t samples,
+                    uint32_t max_samples,
+                    float ratio);
+};
+
+__WIEN2_END_NAMESPACE
+
+#endif /* __MODULES_AUDIO_OBJECTS_OUTPUT_MIXER_CLOCK_DRIFT_COMPENSATOR_H */
@@ -38,6 +38,7 @@
  ****************************************************************************/
 
 #include <arch/chip/cxd56_audio.h>
+#include "memutils/os_utils/chateau_osal.h"
 #include "output_mix_sink_device.h"
 #include "debug/dbg_log.h"
 
@@ -463,6 +464,11 @@ void OutputMixToHPI2S::input_data_on_ready(MsgPacket* msg)
       return;
     }
 
+  /* Automatic adjustment starts over at each play. */
+
+  m_drift_estimator.reset();
+  m_resampler.reset();
+
   m_state = Active;
 }
 
@@ -536,10 +542,21 @@ void OutputMixToHPI2S::postdone_on_active(MsgPacket* msg)
 
   if (check_sample(&cmplt.output) && cmplt.result)
     {
+      int8_t adjust = 0;
+
+      if (m_auto_adjust)
+        {
+          auto_adjust(&cmplt.output);
+        }
+      else
+        {
+          adjust = get_period_adjustment();
+        }
+
       send_renderer(m_render_comp_handler,
                     cmplt.output.mh.getPa(),
                     cmplt.output.size,
-                    get_period_adjustment(),
+                    adjust,
                     cmplt.output.is_valid,
                     cmplt.output.bit_length);
 
@@ -641,6 +658,21 @@ void OutputMixToHPI2S::done_on_active(MsgPacket* msg)
       return;
     }
 
+  /* The time when the frame is done gives the level of queue
+   * between the frames.
+   */
+
+  if (m_auto_adjust)
+    {
+      const AsPcmDataParam &top = m_render_data_queue.top();
+      uint32_t byte_size_per_sample = ((top.bit_length == AS_BITLENGTH_16) ?
+                                       BYTE_SIZE_PER_SAMPLE :
+                                       BYTE_SIZE_PER_SAMPLE_HIGHRES);
+
+      m_drift_estimator.done(top.size / byte_size_per_sample,
+                             Chateau_GetTimeUs());
+    }
+
   /* Reply */
 
   m_render_data_queue.top().callback(m_self_handle,
@@ -700,15 +732,31 @@ void OutputMixToHPI2S::clock_recovery(MsgPacket* msg)
   /* Check Paramete. */
 
   if (cmd.fterm_param.direction < OutputMixAdvance
-   || OutputMixDelay < cmd.fterm_param.direction)
+   || OutputMixAutoAdjust < cmd.fterm_param.direction)
     {
       return;
     }
 
   /* Set recovery parameters. */
 
-  m_adjust_direction = cmd.fterm_param.direction;
-  m_adjustment_times = cmd.fterm_param.times;
+  if (cmd.fterm_param.direction == OutputMixAutoAdjust)
+    {
+      if (!m_auto_adjust)
+        {
+          m_drift_estimator.reset();
+          m_resampler.reset();
+        }
+
+      m_auto_adjust      = true;
+      m_adjust_direction = OutputMixNoAdjust;
+      m_adjustment_times = 0;
+    }
+  else
+    {
+      m_auto_adjust      = false;
+      m_adjust_direction = cmd.fterm_param.direction;
+      m_adjustment_times = cmd.fterm_param.times;
+    }
 
   AsOutputMixDoneParam done_param;
 
@@ -764,6 +812,64 @@ int8_t OutputMixToHPI2S::get_period_adjustment(void)
   return adjust_sample;
 }
 
+/*--------------------------------------------------------------------------*/
+uint32_t OutputMixToHPI2S::get_queued_samples(void)
+{
+  uint32_t samples = 0;
+
+  for (int i = 0; i < m_render_data_queue.size(); i++)
+    {
+      const AsPcmDataParam &data = m_render_data_queue.at(i);
+      uint32_t byte_size_per_sample = ((data.bit_length == AS_BITLENGTH_16) ?
+                                       BYTE_SIZE_PER_SAMPLE :
+                                       BYTE_SIZE_PER_SAMPLE_HIGHRES);
+
+      samples += data.size / byte_size_per_sample;
+    }
+
+  return samples;
+}
+
+/*--------------------------------------------------------------------------*/
+void OutputMixToHPI2S::auto_adjust(AsPcmDataParam *data)
+{
+  /* Resample the frame in place by the ratio which keeps the level of
+   * render queue. The size of frame changes by the ratio, and it is
+   * kept in the room of memory segment.
+   */
+
+  uint32_t byte_size_per_sample = ((data->bit_length == AS_BITLENGTH_16) ?
+                                   BYTE_SIZE_PER_SAMPLE :
+                                   BYTE_SIZE_PER_SAMPLE_HIGHRES);
+  uint32_t in_samples  = data->size / byte_size_per_sample;
+  uint32_t max_samples = data->mh.getSize() / byte_size_per_sample;
+  uint32_t out_samples;
+
+  float ratio = m_drift_estimator.update(get_queued_samples(),
+                                         in_samples,
+                                         Chateau_GetTimeUs());
+
+  if (data->bit_length == AS_BITLENGTH_16)
+    {
+      out_samples =
+        m_resampler.exec(static_cast<int16_t *>(data->mh.getVa()),
+                         in_samples,
+                         max_samples,
+                         ratio);
+    }
+  else
+    {
+      out_samples =
+        m_resampler.exec(static_cast<int32_t *>(data->mh.getVa()),
+                         in_samples,
+                         max_samples,
+                         ratio);
+    }
+
+  data->size   = out_samples * byte_size_per_sample;
+  data->sample = out_samples;
+}
+
 /*--------------------------------------------------------------------------*/
 void OutputMixToHPI2S::init_postproc(MsgPacket* msg)
 {
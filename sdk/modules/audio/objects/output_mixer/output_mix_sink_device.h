@@ -54,6 +54,7 @@
 #include "components/customproc/thruproc_component.h"
 #include "objects/stream_parser/ram_lpcm_data_source.h"
 #include "objects/stream_parser/mp3_stream_mng.h"
+#include "objects/output_mixer/clock_drift_compensator.h"
 
 __WIEN2_BEGIN_NAMESPACE
 
@@ -112,6 +113,7 @@ public:
     , m_callback(NULL)
     , m_adjust_direction(OutputMixNoAdjust)
     , m_adjustment_times(0)
+    , m_auto_adjust(false)
   {}
 
   ~OutputMixToHPI2S()
@@ -160,6 +162,12 @@ private:
   int8_t m_adjust_direction;
   int32_t m_adjustment_times;
 
+  /* For OutputMixAutoAdjust. */
+
+  bool m_auto_adjust;
+  ClockDriftEstimator m_drift_estimator;
+  FractionalResampler m_resampler;
+
   uint32_t m_max_pcm_buff_size;
   uint32_t m_apucmd_pcm_buff_size;
 
@@ -192,6 +200,8 @@ private:
   void parseOutputMixRst(MsgPacket *msg);
 
   int8_t get_period_adjustment(void);
+  void auto_adjust(AsPcmDataParam *data);
+  uint32_t get_queued_samples(void);
   bool checkMemPool(void);
 };
 
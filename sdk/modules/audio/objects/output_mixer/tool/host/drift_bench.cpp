@@ -0,0 +1,570 @@
+/****************************************************************************
+ * modules/audio/objects/output_mixer/tool/host/drift_bench.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test and benchmark of ClockDriftEstimator and FractionalResampler.
+ *
+ * A source whose clock is off by a known ppm sends frames of a sine
+ * wave at jittered times, and a sink consumes them by whole frames like the DMA does.
+ * Each frame is resampled in place by the ratio from the fill level,
+ * as OutputMixToHPI2S does in the automatic clock recovery mode.
+ * The test checks that the fill level stays near the level at the
+ * start without underflow and overflow, that the estimated drift is
+ * near the given one, and THD+N of the output.
+ * The former way (add or drop one sample at the end of a frame,
+ * driven by the exact drift) is shown as reference.
+ * The same is run again with the times truncated to the system tick,
+ * as clock_gettime() gives them on NuttX without the SysTick based clock.
+ * The loop must stay stable there too, but THD+N is only shown because
+ * the error of the fill level modulates the ratio.
+ * "drift_bench -t" runs only the test.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include <deque>
+#include <vector>
+
+#include "objects/output_mixer/clock_drift_compensator.h"
+
+using namespace Wien2;
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SINK_FS        48000.0
+#define FRAME_SAMPLES  1024
+#define FRAME_ROOM     (FRAME_SAMPLES + RESAMPLER_PENDING_SAMPLES)
+#define TONE_HZ        1000.0
+#define TONE_AMP       16000.0
+#define PREFILL_FRAMES 4
+#define QUEUE_FRAMES   10      /* Depth of the render data queue */
+#define SRC_JITTER     0.002   /* Arrival time jitter of source [s] */
+#define MSG_LATENCY    0.0003  /* Latency of done message [s] */
+#define TICK_US        10000   /* Default CONFIG_USEC_PER_TICK */
+
+#define SIM_SEC        900.0
+#define SETTLE_SEC     300.0
+#define THD_SAMPLES    32768
+
+#define THDN_LIMIT_DB  (-70.0)
+#define FILL_RANGE     (2 * FRAME_SAMPLES)
+#define PPM_TOLERANCE  10
+
+#define CHECK(cond) \
+  do \
+    { \
+      if (!(cond)) \
+        { \
+          printf("  NG: %s (line %d)\n", #cond, __LINE__); \
+          return 1; \
+        } \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct SimResult
+{
+  int      underflow;
+  int      overflow;
+  double   target;
+  uint32_t fill_min;
+  uint32_t fill_max;
+  int32_t  ppm;
+  double   thdn_db;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static double jitter(double max)
+{
+  return max * (double)rand() / (double)RAND_MAX;
+}
+
+/*--------------------------------------------------------------------------*/
+static uint32_t to_us(double t, uint32_t tick_us)
+{
+  uint64_t us = (uint64_t)(t * 1e6);
+
+  return (uint32_t)(us - us % tick_us);
+}
+
+/*--------------------------------------------------------------------------*/
+static double sine_fit_residual(const std::vector<int16_t> &x,
+                                double freq,
+                                double *signal)
+{
+  /* Least squares fit of a*cos + b*sin + c at "freq" [cycle/sample],
+   * return the residual power.
+   */
+
+  double m[3][4] = { { 0 } };
+  size_t n = x.size();
+
+  for (size_t i = 0; i < n; i++)
+    {
+      double w = 2.0 * M_PI * freq * (double)i;
+      double v[3] = { cos(w), sin(w), 1.0 };
+
+      for (int r = 0; r < 3; r++)
+        {
+          for (int c = 0; c < 3; c++)
+            {
+              m[r][c] += v[r] * v[c];
+            }
+
+          m[r][3] += v[r] * x[i];
+        }
+    }
+
+  /* Gauss-Jordan elimination. */
+
+  for (int p = 0; p < 3; p++)
+    {
+      for (int r = 0; r < 3; r++)
+        {
+          if (r != p)
+            {
+              double k = m[r][p] / m[p][p];
+
+              for (int c = p; c < 4; c++)
+                {
+                  m[r][c] -= k * m[p][c];
+                }
+            }
+        }
+    }
+
+  double a = m[0][3] / m[0][0];
+  double b = m[1][3] / m[1][1];
+  double c0 = m[2][3] / m[2][2];
+  double res = 0.0;
+
+  for (size_t i = 0; i < n; i++)
+    {
+      double w = 2.0 * M_PI * freq * (double)i;
+      double e = x[i] - (a * cos(w) + b * sin(w) + c0);
+
+      res += e * e;
+    }
+
+  *signal = (a * a + b * b) / 2.0 * (double)n;
+
+  return res;
+}
+
+/*--------------------------------------------------------------------------*/
+static double thdn_db(const std::vector<int16_t> &x, double freq)
+{
+  /* Search the frequency which gives the least residual. */
+
+  double lo = freq * 0.995;
+  double hi = freq * 1.005;
+  double signal = 0.0;
+
+  for (int i = 0; i < 60; i++)
+    {
+      double m1 = lo + (hi - lo) * 0.382;
+      double m2 = lo + (hi - lo) * 0.618;
+
+      if (sine_fit_residual(x, m1, &signal) < sine_fit_residual(x, m2, &signal))
+        {
+          hi = m2;
+        }
+      else
+        {
+          lo = m1;
+        }
+    }
+
+  double res = sine_fit_residual(x, (lo + hi) / 2.0, &signal);
+
+  return 10.0 * log10(res / signal);
+}
+
+/*--------------------------------------------------------------------------*/
+static int simulate(double ppm,
+                    bool legacy,
+                    uint32_t tick_us,
+                    SimResult *result)
+{
+  ClockDriftEstimator estimator;
+  FractionalResampler resampler;
+  std::deque<std::vector<int16_t> > queue;
+  std::vector<int16_t> record;
+  double src_fs = SINK_FS * (1.0 + ppm * 1e-6);
+  double done_time = 0.0;     /* Time when the head of queue is done */
+  bool   running = false;
+  uint32_t fill = 0;          /* Samples in queue */
+  double debt = 0.0;          /* For the former way */
+  bool   settled = false;
+
+  memset(result, 0, sizeof(*result));
+  result->fill_min = UINT32_MAX;
+
+  for (uint64_t k = 0; ; k++)
+    {
+      double now = (double)(k * FRAME_SAMPLES) / src_fs + jitter(SRC_JITTER);
+
+      if (now > SIM_SEC)
+        {
+          break;
+        }
+
+      /* Sink consumes the frames which are done by now. */
+
+      while (running && done_time <= now)
+        {
+          if (settled && record.size() < THD_SAMPLES)
+            {
+              const std::vector<int16_t> &f = queue.front();
+
+              for (size_t i = 0; i < f.size() / 2; i++)
+                {
+                  record.push_back(f[i * 2]);
+                }
+            }
+
+          fill -= queue.front().size() / 2;
+          estimator.done(queue.front().size() / 2,
+                         to_us(done_time + jitter(MSG_LATENCY), tick_us));
+          queue.pop_front();
+
+          if (queue.empty())
+            {
+              running = false;
+              result->underflow++;
+            }
+          else
+            {
+              done_time += (double)(queue.front().size() / 2) / SINK_FS;
+            }
+        }
+
+      /* Source sends a frame. */
+
+      std::vector<int16_t> frame(FRAME_ROOM * 2);
+
+      for (uint32_t i = 0; i < FRAME_SAMPLES; i++)
+        {
+          double t = (double)(k * FRAME_SAMPLES + i) / src_fs;
+          int16_t v = (int16_t)lrint(TONE_AMP * sin(2.0 * M_PI * TONE_HZ * t));
+
+          frame[i * 2]     = v;
+          frame[i * 2 + 1] = v;
+        }
+
+      uint32_t out;
+
+      if (legacy)
+        {
+          /* Former way, same as send_renderer(). */
+
+          int adjust = 0;
+
+          debt += FRAME_SAMPLES * ppm * 1e-6;
+
+          if (debt >= 1.0)
+            {
+              adjust = -1;
+              debt -= 1.0;
+            }
+          else if (debt <= -1.0)
+            {
+              adjust = 1;
+              debt += 1.0;
+            }
+
+          if (adjust > 0)
+            {
+              memcpy(&frame[FRAME_SAMPLES * 2],
+                     &frame[(FRAME_SAMPLES - 1) * 2],
+                     sizeof(int16_t) * 2);
+            }
+
+          out = FRAME_SAMPLES + adjust;
+        }
+      else
+        {
+          float ratio = estimator.update(fill, FRAME_SAMPLES,
+                                         to_us(now, tick_us));
+
+          out = resampler.exec(&frame[0], FRAME_SAMPLES, FRAME_ROOM, ratio);
+        }
+
+      frame.resize(out * 2);
+
+      if (settled)
+        {
+          result->fill_min = (fill < result->fill_min) ? fill : result->fill_min;
+          result->fill_max = (fill > result->fill_max) ? fill : result->fill_max;
+        }
+
+      queue.push_back(frame);
+      fill += out;
+
+      if (queue.size() > QUEUE_FRAMES)
+        {
+          result->overflow++;
+        }
+
+      /* Start after prefill, and restart after underflow. */
+
+      if (!running && queue.size() >= PREFILL_FRAMES)
+        {
+          running = true;
+          done_time = now + (double)(queue.front().size() / 2) / SINK_FS;
+        }
+
+      if (!settled && now >= SETTLE_SEC)
+        {
+          settled = true;
+          result->underflow = 0;
+          result->overflow = 0;
+        }
+    }
+
+  result->target = estimator.get_target();
+  result->ppm = estimator.get_ppm();
+  result->thdn_db = thdn_db(record, TONE_HZ / src_fs);
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_resampler(void)
+{
+  /* Ratio 1 gives the input delayed by 2 samples, and any frame size
+   * gives the same output as one long frame.
+   */
+
+  printf("resampler:\n");
+
+  FractionalResampler whole;
+  FractionalResampler split;
+  std::vector<int16_t> in(4096 * 2);
+  std::vector<int16_t> a(in.size() + 64 * 2);
+  std::vector<int16_t> b;
+
+  for (size_t i = 0; i < in.size() / 2; i++)
+    {
+      in[i * 2]     = (int16_t)(rand() % 20000 - 10000);
+      in[i * 2 + 1] = (int16_t)(rand() % 20000 - 10000);
+    }
+
+  memcpy(&a[0], &in[0], in.size() * sizeof(int16_t));
+  CHECK(whole.exec(&a[0], 4096, 4096, 1.0f) == 4096);
+
+  for (size_t i = 2; i < 4096; i++)
+    {
+      CHECK(a[i * 2] == in[(i - 2) * 2]);
+      CHECK(a[i * 2 + 1] == in[(i - 2) * 2 + 1]);
+    }
+
+  /* Ratio below 1 makes more samples than the input. */
+
+  float ratio = 0.9995f;
+
+  whole.reset();
+  memcpy(&a[0], &in[0], in.size() * sizeof(int16_t));
+  uint32_t n = whole.exec(&a[0], 4096, 4096 + 64, ratio);
+
+  CHECK(n == 4098 || n == 4099);
+
+  uint32_t pos = 0;
+
+  while (pos < 4096)
+    {
+      uint32_t size = 1 + rand() % 700;
+
+      size = (pos + size > 4096) ? (4096 - pos) : size;
+
+      std::vector<int16_t> f(in.begin() + pos * 2,
+                             in.begin() + (pos + size) * 2);
+
+      f.resize((size + RESAMPLER_PENDING_SAMPLES) * 2);
+
+      uint32_t m = split.exec(&f[0], size,
+                              size + RESAMPLER_PENDING_SAMPLES, ratio);
+
+      b.insert(b.end(), f.begin(), f.begin() + m * 2);
+      pos += size;
+    }
+
+  CHECK(b.size() == n * 2);
+  CHECK(memcmp(&a[0], &b[0], b.size() * sizeof(int16_t)) == 0);
+
+  /* 32bit samples keep the precision of 24bit. */
+
+  FractionalResampler r32;
+  std::vector<int32_t> w(1024 * 2 + 64);
+
+  for (size_t i = 0; i < 1024; i++)
+    {
+      w[i * 2]     = (int32_t)(i << 8);
+      w[i * 2 + 1] = -(int32_t)(i << 8);
+    }
+
+  CHECK(r32.exec(&w[0], 1024, 1024 + 32, 1.0f) == 1024);
+  CHECK(w[100 * 2] == (98 << 8) && w[100 * 2 + 1] == -(98 << 8));
+
+  printf("  OK\n");
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_drift(uint32_t tick_us)
+{
+  static const double ppm_list[] = { 0.0, 50.0, -50.0, 300.0, -300.0 };
+
+  printf("drift (%.0f s, prefill %d samples, THD+N of %.0f Hz, "
+         "time in %u us):\n",
+         SIM_SEC, PREFILL_FRAMES * FRAME_SAMPLES, TONE_HZ, tick_us);
+
+  for (size_t i = 0; i < sizeof(ppm_list) / sizeof(ppm_list[0]); i++)
+    {
+      SimResult auto_mode;
+      SimResult legacy;
+
+      simulate(ppm_list[i], false, tick_us, &auto_mode);
+      simulate(ppm_list[i], true, tick_us, &legacy);
+
+      printf("  %+5.0f ppm: estimated %+5d ppm, fill %u..%u, "
+             "underflow %d, overflow %d, THD+N %.1f dB "
+             "(former way %.1f dB)\n",
+             ppm_list[i], auto_mode.ppm,
+             auto_mode.fill_min, auto_mode.fill_max,
+             auto_mode.underflow, auto_mode.overflow,
+             auto_mode.thdn_db, legacy.thdn_db);
+
+      CHECK(auto_mode.underflow == 0);
+      CHECK(auto_mode.overflow == 0);
+      CHECK(auto_mode.fill_min + FILL_RANGE >= auto_mode.target);
+      CHECK(auto_mode.fill_max <= auto_mode.target + FILL_RANGE);
+      CHECK(abs(auto_mode.ppm - (int32_t)ppm_list[i]) <= PPM_TOLERANCE);
+      CHECK(tick_us > 1 || auto_mode.thdn_db < THDN_LIMIT_DB);
+    }
+
+  printf("  OK\n");
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static double now_sec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/*--------------------------------------------------------------------------*/
+static int bench(void)
+{
+  FractionalResampler r16;
+  FractionalResampler r32;
+  std::vector<int16_t> b16(FRAME_ROOM * 2);
+  std::vector<int32_t> b32(FRAME_ROOM * 2);
+  const int loops = 20000;
+
+  for (size_t i = 0; i < b16.size(); i++)
+    {
+      b16[i] = (int16_t)(rand() % 20000 - 10000);
+      b32[i] = (int32_t)b16[i] << 16;
+    }
+
+  double t0 = now_sec();
+
+  for (int i = 0; i < loops; i++)
+    {
+      r16.exec(&b16[0], FRAME_SAMPLES, FRAME_ROOM, 1.0001f);
+    }
+
+  double t1 = now_sec();
+
+  for (int i = 0; i < loops; i++)
+    {
+      r32.exec(&b32[0], FRAME_SAMPLES, FRAME_ROOM, 0.9999f);
+    }
+
+  double t2 = now_sec();
+
+  printf("bench (%d frames of %d samples):\n", loops, FRAME_SAMPLES);
+  printf("  16bit: %.1f Msample/s\n",
+         (double)loops * FRAME_SAMPLES / (t1 - t0) / 1e6);
+  printf("  32bit: %.1f Msample/s\n",
+         (double)loops * FRAME_SAMPLES / (t2 - t1) / 1e6);
+
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  bool test_only = (argc > 1 && strcmp(argv[1], "-t") == 0);
+
+  srand(1);
+
+  if (test_resampler() != 0 || test_drift(1) != 0 ||
+      test_drift(TICK_US) != 0)
+    {
+      printf("Test NG\n");
+      return 1;
+    }
+
+  printf("All tests OK\n");
+
+  if (!test_only && bench() != 0)
+    {
+      return 1;
+    }
+
+  return 0;
+}
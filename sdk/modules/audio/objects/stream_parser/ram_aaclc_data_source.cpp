@@ -174,7 +174,9 @@ InputDataManagerObject::GetEsResult
 
       InfoStreamMuxConfig stream_mux_config;
       memset(&stream_mux_config, 0, sizeof(InfoStreamMuxConfig));
-      uint8_t *rest = AACLC_getNextLatm(peek_data, &stream_mux_config);
+      uint8_t *rest = AACLC_getNextLatm(peek_data,
+                                        payload_size,
+                                        &stream_mux_config);
       if (rest != 0)
         {
           *es_size = stream_mux_config.info_stream_frame[0].frame_length;
@@ -271,7 +273,9 @@ bool RamAACLCDataSource::getSamplingRate(FAR uint32_t *p_sampling_rate)
       InfoStreamMuxConfig stream_mux_config;
       memset(&stream_mux_config, 0, sizeof(InfoStreamMuxConfig));
 
-      uint8_t *rest = AACLC_getNextLatm(peek_data, &stream_mux_config);
+      uint8_t *rest = AACLC_getNextLatm(peek_data,
+                                        payload_size,
+                                        &stream_mux_config);
       if (rest == 0)
         {
           return false;
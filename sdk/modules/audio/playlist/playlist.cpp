@@ -44,6 +44,86 @@
 
 #include <audio/utilities/playlist.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define INDEX_MAGIC         0x58494c50  /* "PLIX" */
+#define INDEX_VERSION       2
+#define INDEX_READ_RECORDS  16
+
+/* FNV-1a */
+
+#define HASH_INIT           2166136261u
+#define HASH_PRIME          16777619u
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/*--------------------------------------------------------------------------*/
+static uint32_t hash_bytes(uint32_t hash, FAR const void *buf, size_t size)
+{
+  FAR const uint8_t *ptr = static_cast<FAR const uint8_t *>(buf);
+
+  while (size-- > 0)
+    {
+      hash ^= *ptr++;
+      hash *= HASH_PRIME;
+    }
+
+  return hash;
+}
+
+/*--------------------------------------------------------------------------*/
+static uint32_t hash_string(FAR const char *str)
+{
+  return hash_bytes(HASH_INIT, str, strlen(str));
+}
+
+/*--------------------------------------------------------------------------*/
+static bool append_string(FAR FILE       *fp,
+                          FAR const char *str,
+                          FAR uint32_t   *table_size,
+                          FAR uint32_t   *offset)
+{
+  size_t len = strlen(str) + 1;
+
+  if (fwrite(str, 1, len, fp) != len)
+    {
+      return false;
+    }
+
+  *offset = *table_size;
+  *table_size += len;
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool read_string(FAR FILE *fp,
+                        uint32_t offset,
+                        FAR char *str,
+                        uint32_t size)
+{
+  if (fseek(fp, offset, SEEK_SET) != 0)
+    {
+      return false;
+    }
+
+  /* Strings are shorter than the buffer, and terminated in the table. */
+
+  size_t read_size = fread(str, 1, size - 1, fp);
+  str[read_size] = '\0';
+
+  return (read_size > 0);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+
 /*--------------------------------------------------------------------------*/
 bool Playlist::init(const char *playlist_path)
 {
@@ -58,9 +138,12 @@ bool Playlist::init(const char *playlist_path)
 
   snprintf(m_playlist_path, sizeof(m_playlist_path), "%s", playlist_path);
 
-  /* Open track database. */
+  /* Open track database. The index is made if it is not up to date. */
 
-  this->open("r");
+  if (!this->open())
+    {
+      return false;
+    }
 
   /* Create alias list. */
 
@@ -77,47 +160,332 @@ bool Playlist::init(const char *playlist_path)
 }
 
 /*--------------------------------------------------------------------------*/
-bool Playlist::open(FAR const char *mode)
+bool Playlist::open(void)
 {
-  char absolute_path[FileNameMaxLength];
+  char db_name[FileNameMaxLength];
+  struct stat db_stat;
 
-  /* Check argument */
+  this->closeIndex();
+
+  this->getDbFileName(db_name, sizeof(db_name));
 
-  if (mode == NULL)
+  if (stat(db_name, &db_stat) != 0)
     {
+      printf("Track db(playlist) %s open error. check paths and files!\n",
+             db_name);
       return false;
     }
 
-  snprintf(absolute_path,
-           sizeof(absolute_path),
-           "%s/%s", m_playlist_path,
-           this->m_track_db_file_name);
-  this->m_track_db_fp = fopen(absolute_path, mode);
+  /* Use the index if it is made from the current track database.
+   * Else the index is updated, from the valid one if there is.
+   */
 
-  if (this->m_track_db_fp == NULL)
+  for (int retry = 0; retry < 2; retry++)
     {
-      printf("Track db(playlist) %s open error. check paths and files!\n",
-             absolute_path);
-      return false;
+      bool        valid = this->openIndex();
+      IndexHeader base  = this->m_index_header;
+
+      if (valid &&
+          base.db_size == static_cast<uint32_t>(db_stat.st_size) &&
+          base.db_mtime == static_cast<uint32_t>(db_stat.st_mtime))
+        {
+          return true;
+        }
+
+      this->closeIndex();
+
+      if (retry == 0 && !this->buildIndex(valid ? &base : NULL))
+        {
+          break;
+        }
     }
 
-  return true;
+  printf("Track index of %s cannot be made.\n", db_name);
+  return false;
 }
 
 /*--------------------------------------------------------------------------*/
 bool Playlist::close(void)
 {
-  if (this->m_track_db_fp != NULL)
-  {
-    if (fclose(this->m_track_db_fp) != 0)
-      {
-        return false;
-      }
-  }
+  bool ret = this->closeIndex();
+
+  free(this->m_alias_list);
+  this->m_alias_list  = NULL;
+  this->m_alias_num   = 0;
+  this->m_list_loaded = false;
+
+  return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+bool Playlist::openIndex(void)
+{
+  char db_name[FileNameMaxLength];
+  char file_name[FileNameMaxLength];
+
+  this->getDbFileName(db_name, sizeof(db_name));
+
+  snprintf(file_name, sizeof(file_name), "%s.idx", db_name);
+  this->m_index_fp = fopen(file_name, "r");
+
+  snprintf(file_name, sizeof(file_name), "%s.str", db_name);
+  this->m_string_fp = fopen(file_name, "r");
+
+  if (this->m_index_fp == NULL || this->m_string_fp == NULL)
+    {
+      return false;
+    }
+
+  FAR IndexHeader *header = &this->m_index_header;
+
+  if (fread(header, sizeof(IndexHeader), 1, this->m_index_fp) != 1 ||
+      header->magic != INDEX_MAGIC ||
+      header->version != INDEX_VERSION ||
+      header->record_size != sizeof(IndexRecord))
+    {
+      return false;
+    }
+
+  /* Both files have to have all of the indexed data. */
+
+  long index_size = sizeof(IndexHeader) +
+                    header->record_num * sizeof(IndexRecord);
+
+  return (fseek(this->m_index_fp, 0, SEEK_END) == 0 &&
+          ftell(this->m_index_fp) >= index_size &&
+          fseek(this->m_string_fp, 0, SEEK_END) == 0 &&
+          ftell(this->m_string_fp) >= static_cast<long>(header->string_size));
+}
+
+/*--------------------------------------------------------------------------*/
+bool Playlist::closeIndex(void)
+{
+  bool ret = true;
+
+  if (this->m_index_fp != NULL)
+    {
+      if (fclose(this->m_index_fp) != 0)
+        {
+          ret = false;
+        }
+      this->m_index_fp = NULL;
+    }
+
+  if (this->m_string_fp != NULL)
+    {
+      if (fclose(this->m_string_fp) != 0)
+        {
+          ret = false;
+        }
+      this->m_string_fp = NULL;
+    }
+
+  return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+bool Playlist::buildIndex(FAR const IndexHeader *base)
+{
+  char db_name[FileNameMaxLength];
+  char index_name[FileNameMaxLength];
+  char string_name[FileNameMaxLength];
+  struct stat db_stat;
+
+  this->getDbFileName(db_name, sizeof(db_name));
+  snprintf(index_name, sizeof(index_name), "%s.idx", db_name);
+  snprintf(string_name, sizeof(string_name), "%s.str", db_name);
+
+  if (stat(db_name, &db_stat) != 0)
+    {
+      return false;
+    }
+
+  FAR FILE *db_fp = fopen(db_name, "r");
+  if (db_fp == NULL)
+    {
+      return false;
+    }
+
+  /* If only lines are added to the track database, the tracks of them
+   * are added to the index. Else the index is made from the top.
+   */
+
+  IndexHeader header;
+  memset(&header, 0, sizeof(header));
+  header.db_hash = HASH_INIT;
+
+  if (base != NULL && this->checkDbPrefix(db_fp, base))
+    {
+      header = *base;
+    }
+  else
+    {
+      base = NULL;
+      rewind(db_fp);
+    }
+
+  /* Records are written to the index file and strings are written to
+   * the string file. Added ones are written just after the indexed
+   * data, over the data left by an aborted update.
+   */
+
+  FAR FILE *index_fp  = fopen(index_name, (base != NULL) ? "r+" : "w");
+  FAR FILE *string_fp = fopen(string_name, (base != NULL) ? "r+" : "w");
+  if (index_fp == NULL || string_fp == NULL)
+    {
+      if (index_fp != NULL)
+        {
+          fclose(index_fp);
+        }
+      if (string_fp != NULL)
+        {
+          fclose(string_fp);
+        }
+      fclose(db_fp);
+      return false;
+    }
+
+  /* Same artist or album continues in most of track databases,
+   * so the previous string is shared.
+   */
+
+  char        line[LineMaxLength];
+  Track       track;
+  Track       prev;
+  IndexRecord record;
+  uint32_t    base_num = header.record_num;
+  bool        ret;
+
+  memset(&prev, 0, sizeof(prev));
+  memset(&record, 0, sizeof(record));
+
+  if (base_num > 0)
+    {
+      ret = (fseek(index_fp,
+                   sizeof(IndexHeader) + (base_num - 1) * sizeof(IndexRecord),
+                   SEEK_SET) == 0) &&
+            (fread(&record, sizeof(record), 1, index_fp) == 1) &&
+            read_string(string_fp, record.author,
+                        prev.author, sizeof(prev.author)) &&
+            read_string(string_fp, record.album,
+                        prev.album, sizeof(prev.album));
+    }
+  else
+    {
+      ret = (fwrite(&header, sizeof(header), 1, index_fp) == 1);
+    }
+
+  ret = ret &&
+        (fseek(index_fp,
+               sizeof(IndexHeader) + base_num * sizeof(IndexRecord),
+               SEEK_SET) == 0) &&
+        (fseek(string_fp, header.string_size, SEEK_SET) == 0);
+
+  while (ret && this->readLine(db_fp, line, sizeof(line), &header.db_hash))
+    {
+      if (!this->parseTrackInfo(&track, line, sizeof(line)))
+        {
+          continue;
+        }
+
+      ret = append_string(string_fp, track.title,
+                          &header.string_size, &record.title);
+
+      if (header.record_num == 0 || strcmp(track.author, prev.author) != 0)
+        {
+          ret = ret && append_string(string_fp, track.author,
+                                     &header.string_size, &record.author);
+        }
+
+      if (header.record_num == 0 || strcmp(track.album, prev.album) != 0)
+        {
+          ret = ret && append_string(string_fp, track.album,
+                                     &header.string_size, &record.album);
+        }
+
+      record.author_hash    = hash_string(track.author);
+      record.album_hash     = hash_string(track.album);
+      record.sampling_rate  = track.sampling_rate;
+      record.channel_number = track.channel_number;
+      record.bit_length     = track.bit_length;
+      record.codec_type     = track.codec_type;
+
+      ret = ret && (fwrite(&record, sizeof(record), 1, index_fp) == 1);
+
+      header.record_num++;
+      prev = track;
+    }
+
+  long db_size = ftell(db_fp);
+
+  fclose(db_fp);
+
+  if (fclose(string_fp) != 0 || db_size < 0)
+    {
+      ret = false;
+    }
+
+  /* Write header at last, so that a broken index is not used. */
+
+  header.magic       = INDEX_MAGIC;
+  header.version     = INDEX_VERSION;
+  header.record_size = sizeof(IndexRecord);
+  header.db_size     = db_size;
+  header.db_mtime    = db_stat.st_mtime;
+
+  if (ret)
+    {
+      ret = (fseek(index_fp, 0, SEEK_SET) == 0) &&
+            (fwrite(&header, sizeof(header), 1, index_fp) == 1);
+    }
+
+  if (fclose(index_fp) != 0)
+    {
+      ret = false;
+    }
+
+  if (!ret)
+    {
+      unlink(index_name);
+      unlink(string_name);
+      return false;
+    }
+
+  _info("Track index is updated. %d tracks are added, %d tracks in all\n",
+        header.record_num - base_num, header.record_num);
 
   return true;
 }
 
+/*--------------------------------------------------------------------------*/
+bool Playlist::checkDbPrefix(FAR FILE *db_fp, FAR const IndexHeader *base)
+{
+  /* The indexed part of the track database must be the same, and must
+   * end with a line feed so that the last track is not changed.
+   */
+
+  char     buf[LineMaxLength];
+  uint32_t hash   = HASH_INIT;
+  uint32_t remain = base->db_size;
+  char     last   = '\n';
+
+  while (remain > 0)
+    {
+      size_t size = (remain > sizeof(buf)) ? sizeof(buf) : remain;
+
+      if (fread(buf, 1, size, db_fp) != size)
+        {
+          return false;
+        }
+
+      hash    = hash_bytes(hash, buf, size);
+      last    = buf[size - 1];
+      remain -= size;
+    }
+
+  return (hash == base->db_hash && last == '\n');
+}
+
 /*--------------------------------------------------------------------------*/
 bool Playlist::setPlayMode(PlayMode play_mode)
 {
@@ -132,6 +500,8 @@ bool Playlist::setPlayMode(PlayMode play_mode)
     }
   else
     {
+      /* Reload to get the original order. */
+
       if (!this->loadAliasList())
         {
           return false;
@@ -160,6 +530,15 @@ bool Playlist::select(ListType type, FAR const char *key_str)
       return false;
     }
 
+  /* The list on memory is used if the same list is selected again. */
+
+  if (this->m_list_loaded &&
+      this->m_list_type == type &&
+      strncmp(this->m_list_key, key_str, sizeof(this->m_list_key)) == 0)
+    {
+      return true;
+    }
+
   this->m_list_type = type;
   strncpy(this->m_list_key, key_str, sizeof(this->m_list_key));
 
@@ -191,7 +570,7 @@ bool Playlist::getNextTrack(FAR Track *track)
       return false;
     }
 
-  if (this->m_alias_list.empty())
+  if (this->m_alias_num == 0)
     {
       _err("no playlist.\n");
       return false;
@@ -199,7 +578,7 @@ bool Playlist::getNextTrack(FAR Track *track)
 
   /* Get track info, according to active list. */
 
-  if (this->m_play_idx >= (this->m_alias_list.size() - 1))
+  if (this->m_play_idx >= (this->m_alias_num - 1))
     {
       if (this->m_repeat_mode == RepeatModeOn)
         {
@@ -216,37 +595,19 @@ bool Playlist::getNextTrack(FAR Track *track)
         }
     }
 
-  /* Clear EOF indicator. (Calling fseek() dows not clear them.) */
-
-  clearerr(this->m_track_db_fp);
-
   /* Increment index. */
 
   this->m_play_idx++;
 
-  /* Move a file pointer of track database to the head of next track. */
+  /* Get track info from the record of index. */
 
-  int seek_rst = fseek(this->m_track_db_fp,
-                       this->m_alias_list.at(this->m_play_idx),
-                       SEEK_SET);
-  if (seek_rst != 0)
+  if (!this->readTrack(this->m_alias_list[this->m_play_idx], track))
     {
       this->m_play_idx--;
       return false;
     }
 
-
-  /* Get track info. */
-
-  char line[LineMaxLength] = { '\0' };
-  bool ret = this->readLine(line, sizeof(line));
-  if (ret != true)
-    {
-      this->m_play_idx--;
-      return false;
-    }
-
-  return this->parseTrackInfo(track, line, sizeof(line));
+  return true;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -259,7 +620,7 @@ bool Playlist::getPrevTrack(Track *track)
       return false;
     }
 
-  if (this->m_alias_list.empty())
+  if (this->m_alias_num == 0)
     {
       _err("no playlist.\n");
       return false;
@@ -271,7 +632,7 @@ bool Playlist::getPrevTrack(Track *track)
     {
       if (this->m_repeat_mode == RepeatModeOn)
         {
-          this->m_play_idx = this->m_alias_list.size();
+          this->m_play_idx = this->m_alias_num;
 
           if (this->m_play_mode == PlayModeShuffle)
             {
@@ -284,39 +645,19 @@ bool Playlist::getPrevTrack(Track *track)
         }
     }
 
-  /* Clear EOF indicator. (Calling fseek() dows not clear them.) */
-
-  clearerr(this->m_track_db_fp);
-
   /* Decrement index. */
 
   this->m_play_idx--;
 
-  /* Move a file pointer of track database to the head of next track. */
-
-  int seek_rst = fseek(this->m_track_db_fp,
-                       this->m_alias_list.at(this->m_play_idx),
-                       SEEK_SET);
-  if (seek_rst != 0)
-    {
-      this->m_play_idx++;
-      return false;
-    }
-
-  /* Get track info. */
+  /* Get track info from the record of index. */
 
-  char line[LineMaxLength] =
-    {
-      '\0'
-    };
-  bool ret = this->readLine(line, sizeof(line));
-  if (ret != true)
+  if (!this->readTrack(this->m_alias_list[this->m_play_idx], track))
     {
       this->m_play_idx++;
       return false;
     }
 
-  return this->parseTrackInfo(track, line, sizeof(line));
+  return true;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -350,6 +691,11 @@ bool Playlist::updatePlaylist(ListType type, FAR const char *key_str)
       return true;
     }
 
+  if (this->m_index_fp == NULL)
+    {
+      return false;
+    }
+
   /* Open list corresponding to type. */
 
   char file_name[FileNameMaxLength];
@@ -361,54 +707,51 @@ bool Playlist::updatePlaylist(ListType type, FAR const char *key_str)
       return false;
     }
 
-  /* Move file pointer to top of file. */
+  /* Check records of the index by some records, and write the record
+   * numbers of the target tracks to alias list.
+   */
 
-  if (fseek(this->m_track_db_fp, 0, SEEK_SET) != 0)
-    {
-      printf("Cannot move file pointer.\n", file_name);
-      fclose(list_fp);
-      return false;
-    }
+  uint32_t    key_hash = hash_string(key_str);
+  uint32_t    record_num = this->m_index_header.record_num;
+  IndexRecord records[INDEX_READ_RECORDS];
 
-  while (true)
+  for (uint32_t record_no = 0; record_no < record_num; )
     {
-      /* Data for insertion. */
+      uint32_t num = record_num - record_no;
+      num = (num > INDEX_READ_RECORDS) ? INDEX_READ_RECORDS : num;
 
-      fpos_t fp_offset = 0;
-      fgetpos(this->m_track_db_fp, &fp_offset);
+      /* Seek every time, because checking string moves file pointer. */
 
-      char line[LineMaxLength] =
-        {
-          '\0'
-        };
-      bool ret = this->readLine(line, sizeof(line));
-      if (ret != true)
+      if (fseek(this->m_index_fp,
+                sizeof(IndexHeader) + record_no * sizeof(IndexRecord),
+                SEEK_SET) != 0 ||
+          fread(records, sizeof(IndexRecord), num, this->m_index_fp) != num)
         {
+          printf("Cannot read track index.\n");
           break;
         }
 
-      Track track;
-      this->parseTrackInfo(&track, line, sizeof(line));
-
-      /* Check, and write to alias list. */
-
-      if (this->isTargetTrack(type, key_str, &track))
+      for (uint32_t i = 0; i < num; i++)
         {
-          size_t wsize = fwrite(&fp_offset, sizeof(fp_offset), 1, list_fp);
-          if (wsize != 1)
+          if (this->isTargetTrack(type, key_str, key_hash, &records[i]))
             {
-              printf("File write error. [%d]\n", wsize);
+              uint32_t data = record_no + i;
+              size_t wsize = fwrite(&data, sizeof(data), 1, list_fp);
+              if (wsize != 1)
+                {
+                  printf("File write error. [%d]\n", wsize);
+                }
             }
         }
+
+      record_no += num;
     }
 
   /* Close list. */
 
   fclose(list_fp);
 
-  /* Move file pointer back to top of file. */
-
-  fseek(this->m_track_db_fp, 0, SEEK_SET);
+  this->m_list_loaded = false;
 
   return true;
 }
@@ -479,6 +822,8 @@ bool Playlist::addTrack(FAR const char *key_str, int track_no)
 
       fwrite(&data, sizeof(data), 1, fp);
       fclose(fp);
+
+      this->m_list_loaded = false;
     }
   else
     {
@@ -500,58 +845,57 @@ bool Playlist::removeTrack(FAR const char *key_str, uint32_t remove_pos)
       return false;
     }
 
-  char file_name_org[FileNameMaxLength];
+  char file_name[FileNameMaxLength];
   this->getFileName(ListTypeUser,
                     key_str,
-                    file_name_org,
-                    sizeof(file_name_org));
-  FAR FILE *fp_org = fopen(file_name_org, "r");
-  if (fp_org == NULL)
+                    file_name,
+                    sizeof(file_name));
+  FAR FILE *fp = fopen(file_name, "r+");
+  if (fp == NULL)
     {
       return false;
     }
 
-  char file_name_tmp[FileNameMaxLength];
-  snprintf(file_name_tmp, sizeof(file_name_tmp), "%s_tmp", file_name_org);
-  FAR FILE *fp_tmp = fopen(file_name_tmp, "w");
-  if (fp_tmp == NULL)
+  /* Move the entries after the removed one forward, and cut the last
+   * entry. No temporary file is needed.
+   */
+
+  struct stat file_stat;
+  if (stat(file_name, &file_stat) != 0)
     {
-      fclose(fp_org);
+      fclose(fp);
       return false;
     }
 
-  /* Copy track from original to tmp except to be removed. */
+  uint32_t num = file_stat.st_size / sizeof(uint32_t);
+  if (remove_pos >= num)
+    {
+      fclose(fp);
+      return true;
+    }
 
-  for (uint32_t idx = 0; ; idx++)
+  for (uint32_t idx = remove_pos + 1; idx < num; idx++)
     {
       uint32_t data;
-      fread(&data, 1, sizeof(data), fp_org);
 
-      if (feof(fp_org) != 0)
+      if (fseek(fp, idx * sizeof(data), SEEK_SET) != 0 ||
+          fread(&data, sizeof(data), 1, fp) != 1 ||
+          fseek(fp, (idx - 1) * sizeof(data), SEEK_SET) != 0 ||
+          fwrite(&data, sizeof(data), 1, fp) != 1)
         {
+          printf("Cannot update file. %s\n", file_name);
           break;
         }
-
-      if (idx != remove_pos)
-        {
-          fwrite(&data, sizeof(data), 1, fp_tmp);
-        }
     }
 
-  fclose(fp_org);
-  fclose(fp_tmp);
-
-  /* Delete original and rename tmp to original. */
+  fclose(fp);
 
-  if (unlink(file_name_org) != 0)
+  if (truncate(file_name, (num - 1) * sizeof(uint32_t)) != 0)
     {
-      printf("Cannot delete file. %s\n", file_name_org);
+      printf("Cannot truncate file. %s\n", file_name);
     }
 
-  if (rename(file_name_tmp, file_name_org) != 0)
-    {
-      printf("Cannot rename file. %s -> %s\n", file_name_tmp, file_name_org);
-    }
+  this->m_list_loaded = false;
 
   return true;
 }
@@ -566,10 +910,18 @@ bool Playlist::updateTrackDb(const char *audiofile_root_path)
       return false;
     }
 
-  /* Reopen track database with write mode. */
+  /* Recreate track database. */
 
-  this->close();
-  this->open("w");
+  char db_name[FileNameMaxLength];
+  this->getDbFileName(db_name, sizeof(db_name));
+
+  FAR FILE *db_fp = fopen(db_name, "w");
+  if (db_fp == NULL)
+    {
+      printf("Track db(playlist) %s open error. check paths and files!\n",
+             db_name);
+      return false;
+    }
 
   FAR DIR *dir_descriptor = opendir(audiofile_root_path);
   if (dir_descriptor == NULL)
@@ -627,7 +979,7 @@ bool Playlist::updateTrackDb(const char *audiofile_root_path)
               size_t wsize = fwrite(const_cast<char*>(line),
                                     strnlen(line, sizeof(line)),
                                     1,
-                                    this->m_track_db_fp);
+                                    db_fp);
               if (wsize != 1)
                 {
                   printf("File write error. [%d]\n", wsize);
@@ -643,15 +995,19 @@ bool Playlist::updateTrackDb(const char *audiofile_root_path)
         }
     }
 
-  /* Reopen track database with read mode. */
-
-  this->close();
-  this->open("r");
+  fclose(db_fp);
 
   /* Delete all playlist. */
 
   this->deleteAll();
 
+  /* Remake index from the new track database. */
+
+  if (!this->open())
+    {
+      return false;
+    }
+
   /* Update playlist(type All). */
 
   this->updatePlaylist(ListTypeAllTrack, "");
@@ -684,14 +1040,18 @@ bool Playlist::deleteAll(void)
           int idx = sizeof(this->m_track_db_file_name) - 1;
           this->m_track_db_file_name[idx] = '\0';
 
-          /* Exclude track database file from deletion. */
+          /* Exclude track database file and its index files from deletion. */
 
           int ret = strncmp(dir_ent->d_name,
                             this->m_track_db_file_name,
                             strlen(this->m_track_db_file_name));
           if (ret != 0)
             {
-              if (unlink(dir_ent->d_name) != 0)
+              char file_name[FileNameMaxLength];
+              snprintf(file_name, sizeof(file_name), "%s/%s",
+                       m_playlist_path, dir_ent->d_name);
+
+              if (unlink(file_name) != 0)
                 {
                   printf("Cannot delete.\n");
                   closedir(dir_descriptor);
@@ -703,6 +1063,8 @@ bool Playlist::deleteAll(void)
 
   closedir(dir_descriptor);
 
+  this->m_list_loaded = false;
+
   return true;
 }
 
@@ -730,24 +1092,29 @@ bool Playlist::deleteOne(ListType type, FAR const char *key_str)
       return false;
     }
 
+  this->m_list_loaded = false;
+
   return true;
 }
 
 /*--------------------------------------------------------------------------*/
-bool Playlist::isTargetTrack(ListType       type,
-                             FAR const char *key_str,
-                             FAR Track      *track)
+bool Playlist::isTargetTrack(ListType              type,
+                             FAR const char        *key_str,
+                             uint32_t              key_hash,
+                             FAR const IndexRecord *record)
 {
   bool rtcd;
-  int  cmp_rst;
+  char str[sizeof(((Track *)0)->author)];
 
   /* Check arguments */
 
-  if (key_str == NULL || track == NULL)
+  if (key_str == NULL || record == NULL)
     {
       return false;
     }
 
+  /* Compare the string only when the hash matches. */
+
   switch (type)
     {
       case ListTypeAllTrack:
@@ -755,13 +1122,15 @@ bool Playlist::isTargetTrack(ListType       type,
         break;
 
       case ListTypeArtist:
-        cmp_rst = strncmp(track->author, key_str, sizeof(track->author));
-        rtcd = ((cmp_rst == 0) ? true : false);
+        rtcd = (record->author_hash == key_hash) &&
+               this->readString(record->author, str, sizeof(str)) &&
+               (strncmp(str, key_str, sizeof(str)) == 0);
         break;
 
       case ListTypeAlbum:
-        cmp_rst = strncmp(track->album, key_str, sizeof(track->album));
-        rtcd = ((cmp_rst == 0) ? true : false);
+        rtcd = (record->album_hash == key_hash) &&
+               this->readString(record->album, str, sizeof(str)) &&
+               (strncmp(str, key_str, sizeof(str)) == 0);
         break;
 
       case ListTypeUser:
@@ -776,6 +1145,64 @@ bool Playlist::isTargetTrack(ListType       type,
   return rtcd;
 }
 
+/*--------------------------------------------------------------------------*/
+bool Playlist::readRecord(uint32_t record_no, FAR IndexRecord *record)
+{
+  if (this->m_index_fp == NULL ||
+      record_no >= this->m_index_header.record_num)
+    {
+      return false;
+    }
+
+  if (fseek(this->m_index_fp,
+            sizeof(IndexHeader) + record_no * sizeof(IndexRecord),
+            SEEK_SET) != 0)
+    {
+      return false;
+    }
+
+  return (fread(record, sizeof(IndexRecord), 1, this->m_index_fp) == 1);
+}
+
+/*--------------------------------------------------------------------------*/
+bool Playlist::readString(uint32_t offset, FAR char *str, uint32_t size)
+{
+  if (this->m_string_fp == NULL ||
+      offset >= this->m_index_header.string_size)
+    {
+      return false;
+    }
+
+  return read_string(this->m_string_fp, offset, str, size);
+}
+
+/*--------------------------------------------------------------------------*/
+bool Playlist::readTrack(uint32_t record_no, FAR Track *track)
+{
+  IndexRecord record;
+
+  if (!this->readRecord(record_no, &record))
+    {
+      return false;
+    }
+
+  memset(track, 0, sizeof(Track));
+
+  if (!this->readString(record.title, track->title, sizeof(track->title)) ||
+      !this->readString(record.author, track->author, sizeof(track->author)) ||
+      !this->readString(record.album, track->album, sizeof(track->album)))
+    {
+      return false;
+    }
+
+  track->channel_number = record.channel_number;
+  track->bit_length     = record.bit_length;
+  track->sampling_rate  = record.sampling_rate;
+  track->codec_type     = record.codec_type;
+
+  return true;
+}
+
 /*--------------------------------------------------------------------------*/
 bool Playlist::loadAliasList(void)
 {
@@ -797,35 +1224,47 @@ bool Playlist::loadAliasList(void)
       return false;
     }
 
-  /* Clear list. */
+  /* Read whole alias list on memory. */
 
-  this->m_alias_list.clear();
+  struct stat file_stat;
+  if (stat(file_name, &file_stat) != 0)
+    {
+      fclose(list_fp);
+      return false;
+    }
 
-  /* Read alias data from file, and push_back to vector. */
+  int       num  = file_stat.st_size / sizeof(uint32_t);
+  uint32_t *list = NULL;
 
-  while(true)
+  if (num > 0)
     {
-      uint32_t read_data;
-      fread(&read_data, sizeof(read_data), 1, list_fp);
-      if (feof(list_fp) != 0)
+      list = static_cast<uint32_t *>(malloc(num * sizeof(uint32_t)));
+      if (list == NULL)
         {
-          break;
+          _err("no memory for list of %d tracks.\n", num);
+          fclose(list_fp);
+          return false;
         }
 
-      this->m_alias_list.push(read_data);
+      num = fread(list, sizeof(uint32_t), num, list_fp);
     }
 
+  /* Close list. */
+
+  fclose(list_fp);
+
+  free(this->m_alias_list);
+  this->m_alias_list  = list;
+  this->m_alias_num   = num;
+  this->m_list_loaded = true;
+
   /* Correct index. */
 
-  if (this->m_play_idx >= (this->m_alias_list.size() - 1))
+  if (this->m_play_idx >= (this->m_alias_num - 1))
     {
       this->m_play_idx = -1;
     }
 
-  /* Close list. */
-
-  fclose(list_fp);
-
   return true;
 }
 
@@ -834,82 +1273,60 @@ bool Playlist::shuffleList(int idx_top)
 {
   uint32_t tmp;
 
-  for (int idx_src = idx_top; idx_src < this->m_alias_list.size(); idx_src++)
+  /* Fisher-Yates shuffle of the list on memory. */
+
+  for (int idx_src = this->m_alias_num - 1; idx_src > idx_top; idx_src--)
     {
-      int idx_dst = rand() % (this->m_alias_list.size() - idx_top);
-      idx_dst += idx_top;
+      int idx_dst = idx_top + rand() % (idx_src - idx_top + 1);
 
-      tmp = this->m_alias_list.at(idx_src);
-      this->m_alias_list.writable_at(idx_src) =
-        this->m_alias_list.at(idx_dst);
-      this->m_alias_list.writable_at(idx_dst) = tmp;
+      tmp = this->m_alias_list[idx_src];
+      this->m_alias_list[idx_src] = this->m_alias_list[idx_dst];
+      this->m_alias_list[idx_dst] = tmp;
     }
 
   return true;
 }
 
 /*--------------------------------------------------------------------------*/
-bool Playlist::readLine(FAR char *line, uint32_t line_size)
+bool Playlist::readLine(FAR FILE     *fp,
+                        FAR char     *line,
+                        uint32_t     line_size,
+                        FAR uint32_t *hash)
 {
-  if (this->m_track_db_fp == NULL)
+  /* Check argument */
+
+  if (fp == NULL || line == NULL || hash == NULL)
     {
-      _err("file not opened.\n");
       return false;
     }
 
-  /* Check argument */
-
-  if (line == NULL)
+  if (fgets(line, line_size, fp) == NULL)
     {
       return false;
     }
 
-  FAR char *tmp = this->m_line_buffer;
-  int read_size;
-  int idx;
+  /* All read bytes are hashed to check the change of the file. */
 
-  read_size = fread(tmp,
-                    1,
-                    sizeof(this->m_line_buffer),
-                    this->m_track_db_fp);
+  *hash = hash_bytes(*hash, line, strlen(line));
 
-  /* EOF indicator will be on when file read and read size is 0.
-   * So, check EOF after fread().
-   */
+  /* Remove line feed. If the line is too long, skip the rest. */
 
-  int ret = feof(this->m_track_db_fp);
-  if (ret != 0)
+  size_t len = strcspn(line, "\r\n");
+  if (line[len] == '\0')
     {
-      return false;
-    }
-
-  for (idx = 0; idx < read_size; idx++)
-    {
-      if (*tmp == 0x0d)
+      int c;
+      while ((c = fgetc(fp)) != EOF)
         {
-          *tmp = '\0';
-        }
-      else if (*tmp == 0x0a)
-        {
-          *tmp = '\0';
-          break;
-        }
-      else
-        {
-        }
+          uint8_t byte = c;
+          *hash = hash_bytes(*hash, &byte, 1);
 
-      tmp++;
+          if (c == '\n')
+            {
+              break;
+            }
+        }
     }
-
-  /* If read 1 line complete, set file pointer back to top of row. */
-
-  fseek(this->m_track_db_fp, -((read_size - 1) - idx), SEEK_CUR);
-
-  /* Make terminate of string to use strncpy(). */
-
-  this->m_line_buffer[sizeof(this->m_line_buffer) - 1] = '\0';
-
-  strncpy(line, this->m_line_buffer, line_size - 1);
+  line[len] = '\0';
 
   return true;
 }
@@ -936,11 +1353,16 @@ bool Playlist::parseTrackInfo(FAR Track *track,
 
   /* Get track name. */
 
-  strncpy(track->title, strtok(token_buffer, ","), sizeof(track->title) - 1);
+  FAR char *tp = strtok(token_buffer, ",");
+  if (tp == NULL)
+    {
+      return false;
+    }
+  strncpy(track->title, tp, sizeof(track->title) - 1);
 
   /* Get author. */
 
-  FAR char *tp = strtok(NULL, ",");
+  tp = strtok(NULL, ",");
   if (tp == NULL)
     {
       return false;
@@ -1116,7 +1538,7 @@ bool Playlist::getFileName(ListType       type,
       case ListTypeAllTrack:
           snprintf(file_name,
                    max_length - 1,
-                   "%s/%s%s.bin",
+                   "%s/%s%s.lst",
                    m_playlist_path,
                    prefix,
                    "alltrack");
@@ -1125,7 +1547,7 @@ bool Playlist::getFileName(ListType       type,
       case ListTypeArtist:
           snprintf(file_name,
                    max_length - 1,
-                   "%s/%s%s%s.bin",
+                   "%s/%s%s%s.lst",
                    m_playlist_path,
                    prefix,
                    "artist_",
@@ -1135,7 +1557,7 @@ bool Playlist::getFileName(ListType       type,
       case ListTypeAlbum:
           snprintf(file_name,
                    max_length - 1,
-                   "%s/%s%s%s.bin",
+                   "%s/%s%s%s.lst",
                    m_playlist_path,
                    prefix,
                    "album_",
@@ -1145,7 +1567,7 @@ bool Playlist::getFileName(ListType       type,
       case ListTypeUser:
           snprintf(file_name,
                    max_length - 1,
-                   "%s/%s%s%s.bin",
+                   "%s/%s%s%s.lst",
                    m_playlist_path,
                    prefix,
                    "user_",
@@ -1155,7 +1577,7 @@ bool Playlist::getFileName(ListType       type,
       default:
           snprintf(file_name,
                    max_length - 1,
-                   "%s/%s%s.bin",
+                   "%s/%s%s.lst",
                    m_playlist_path,
                    prefix,
                    "alltrack");
@@ -1168,3 +1590,13 @@ bool Playlist::getFileName(ListType       type,
 
   return true;
 }
+
+/*--------------------------------------------------------------------------*/
+void Playlist::getDbFileName(FAR char *file_name, uint8_t max_length)
+{
+  snprintf(file_name,
+           max_length,
+           "%s/%s",
+           m_playlist_path,
+           m_track_db_file_name);
+}
@@ -0,0 +1,802 @@
+/****************************************************************************
+ * modules/audio/playlist/tool/host/playlist_test.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test and benchmark of Playlist.
+ *
+ * A track database (csv) with valid tracks and invalid lines is made in
+ * a temporary directory under $TMPDIR (or /tmp), which is removed at
+ * exit. The index made by init() is checked by next/prev navigation
+ * in normal, repeat and shuffle mode, by artist and album playlists,
+ * and by a user playlist. Opening again is checked to use the index as
+ * it is, a database with added lines to add only their tracks, and
+ * other changes to make the index again. Then the time to make the
+ * index of a large database, to add tracks to it, to open it again and
+ * to get tracks is measured. "playlist_test -t" runs only the test.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+
+#include "audio/utilities/playlist.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WORK_DIR    "playlist_XXXXXX"
+#define DB_NAME     "TRACK_DB.CSV"
+#define PATH_SIZE   128     /* FileNameMaxLength of Playlist */
+
+#define TEST_TRACKS   200
+#define BENCH_TRACKS  5000
+#define BENCH_ADDED   100
+#define ARTIST_NUM    7     /* Artists appear in turn */
+#define ALBUM_TRACKS  10    /* Albums are continuous */
+
+/* Reserved byte of the first record in the index file, which is kept
+ * only when the tracks are added to the index. See IndexHeader and
+ * IndexRecord in playlist.h.
+ */
+
+#define MARKER_OFFSET (28 + 27)
+#define MARKER_VALUE  0xa5
+
+#define CHECK(cond) \
+  do \
+    { \
+      if (!(cond)) \
+        { \
+          printf("  NG: %s (line %d)\n", #cond, __LINE__); \
+          return 1; \
+        } \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct TestTrack
+{
+  std::string title;
+  std::string author;
+  std::string album;
+  uint8_t     channel_number;
+  uint8_t     bit_length;
+  uint32_t    sampling_rate;
+  uint8_t     codec_type;
+};
+
+typedef std::vector<TestTrack> TrackList;
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static char s_work_dir[PATH_SIZE];
+static char s_db_file[PATH_SIZE];
+static char s_index_file[PATH_SIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void remove_work_dir(void)
+{
+  DIR *dir = opendir(s_work_dir);
+
+  if (dir != NULL)
+    {
+      struct dirent *ent;
+      char path[PATH_SIZE * 2];
+
+      while ((ent = readdir(dir)) != NULL)
+        {
+          if (ent->d_name[0] != '.')
+            {
+              snprintf(path, sizeof(path), "%s/%s", s_work_dir, ent->d_name);
+              unlink(path);
+            }
+        }
+
+      closedir(dir);
+    }
+
+  rmdir(s_work_dir);
+}
+
+/*--------------------------------------------------------------------------*/
+static bool make_work_dir(void)
+{
+  const char *tmp = getenv("TMPDIR");
+
+  /* Lists of long keys are also made in the directory. */
+
+  if (tmp == NULL || tmp[0] == '\0' ||
+      strlen(tmp) + sizeof("/" WORK_DIR) > sizeof(s_work_dir) / 2)
+    {
+      tmp = "/tmp";
+    }
+
+  snprintf(s_work_dir, sizeof(s_work_dir), "%s/" WORK_DIR, tmp);
+
+  if (mkdtemp(s_work_dir) == NULL)
+    {
+      return false;
+    }
+
+  snprintf(s_db_file, PATH_SIZE, "%s/" DB_NAME, s_work_dir);
+  snprintf(s_index_file, PATH_SIZE, "%s/" DB_NAME ".idx", s_work_dir);
+
+  atexit(remove_work_dir);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static double now_ms(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/*--------------------------------------------------------------------------*/
+static TestTrack make_track(int no)
+{
+  static const uint32_t rates[] = { 44100, 48000, 16000, 96000 };
+  char buf[64];
+  TestTrack track;
+
+  snprintf(buf, sizeof(buf), "track_%05d.%s", no, (no % 3) ? "mp3" : "wav");
+  track.title = buf;
+  snprintf(buf, sizeof(buf), "artist %d", no % ARTIST_NUM);
+  track.author = buf;
+  snprintf(buf, sizeof(buf), "album %d", no / ALBUM_TRACKS);
+  track.album = buf;
+
+  track.channel_number = (no % 5) ? AS_CHANNEL_STEREO : AS_CHANNEL_MONO;
+  track.bit_length     = (no % 4) ? AS_BITLENGTH_16 : AS_BITLENGTH_24;
+  track.sampling_rate  = rates[no % 4];
+  track.codec_type     = (no % 3) ? AS_CODECTYPE_MP3 : AS_CODECTYPE_WAV;
+
+  return track;
+}
+
+/*--------------------------------------------------------------------------*/
+static void append_tracks(TrackList &tracks, int num)
+{
+  int top = tracks.size();
+
+  for (int i = 0; i < num; i++)
+    {
+      tracks.push_back(make_track(top + i));
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static std::string track_line(const TestTrack &track)
+{
+  char line[256];
+
+  snprintf(line, sizeof(line), "%s,%s,%s,%d,%d,%u,%s,0\r\n",
+           track.title.c_str(), track.author.c_str(), track.album.c_str(),
+           (track.channel_number == AS_CHANNEL_MONO) ? 1 : 2,
+           track.bit_length, track.sampling_rate,
+           (track.codec_type == AS_CODECTYPE_WAV) ? "wav" : "mp3");
+
+  return line;
+}
+
+/*--------------------------------------------------------------------------*/
+static std::string invalid_line(int no)
+{
+  switch (no % 5)
+    {
+      case 0:
+        return "\r\n";
+
+      case 1:
+        return "broken.mp3,artist,album,2,16\r\n";
+
+      case 2:
+        return "bad_codec.ogg,artist,album,2,16,44100,ogg,0\r\n";
+
+      case 3:
+        return "bad_rate.mp3,artist,album,2,16,12345,mp3,0\r\n";
+
+      default:
+
+        /* Longer than LineMaxLength, the rest is skipped. */
+
+        return std::string(400, 'x') + ",artist,album,2,16,44100,mp3,0\r\n";
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static bool write_db(const TrackList &tracks)
+{
+  FILE *fp = fopen(s_db_file, "w");
+  if (fp == NULL)
+    {
+      return false;
+    }
+
+  for (size_t i = 0; i < tracks.size(); i++)
+    {
+      if (i % 17 == 3)
+        {
+          fputs(invalid_line(i / 17).c_str(), fp);
+        }
+
+      fputs(track_line(tracks[i]).c_str(), fp);
+    }
+
+  return (fclose(fp) == 0);
+}
+
+/*--------------------------------------------------------------------------*/
+static bool same_track(const Track &track, const TestTrack &expect)
+{
+  return expect.title  == track.title &&
+         expect.author == track.author &&
+         expect.album  == track.album &&
+         expect.channel_number == track.channel_number &&
+         expect.bit_length     == track.bit_length &&
+         expect.sampling_rate  == track.sampling_rate &&
+         expect.codec_type     == track.codec_type;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool index_stat(struct stat *st)
+{
+  return (stat(s_index_file, st) == 0);
+}
+
+/*--------------------------------------------------------------------------*/
+static bool set_marker(void)
+{
+  FILE *fp = fopen(s_index_file, "r+");
+  if (fp == NULL)
+    {
+      return false;
+    }
+
+  bool ret = (fseek(fp, MARKER_OFFSET, SEEK_SET) == 0 &&
+              fputc(MARKER_VALUE, fp) == MARKER_VALUE);
+
+  return (fclose(fp) == 0) && ret;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool has_marker(void)
+{
+  FILE *fp = fopen(s_index_file, "r");
+  if (fp == NULL)
+    {
+      return false;
+    }
+
+  bool ret = (fseek(fp, MARKER_OFFSET, SEEK_SET) == 0 &&
+              fgetc(fp) == MARKER_VALUE);
+
+  fclose(fp);
+  return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool touch_db(int sec)
+{
+  struct stat st;
+  struct utimbuf times;
+
+  if (stat(s_db_file, &st) != 0)
+    {
+      return false;
+    }
+
+  times.actime  = st.st_atime;
+  times.modtime = st.st_mtime + sec;
+
+  return (utime(s_db_file, &times) == 0);
+}
+
+/*--------------------------------------------------------------------------*/
+static bool same_file_time(const struct stat &a, const struct stat &b)
+{
+  return a.st_mtim.tv_sec  == b.st_mtim.tv_sec &&
+         a.st_mtim.tv_nsec == b.st_mtim.tv_nsec;
+}
+
+/*--------------------------------------------------------------------------*/
+static int check_list(Playlist &playlist, const TrackList &tracks,
+                      const std::vector<int> &expect)
+{
+  Track track;
+
+  /* Forward to the end, backward to the top. */
+
+  for (size_t i = 0; i < expect.size(); i++)
+    {
+      CHECK(playlist.getNextTrack(&track));
+      CHECK(same_track(track, tracks[expect[i]]));
+    }
+
+  CHECK(!playlist.getNextTrack(&track));
+
+  for (int i = expect.size() - 2; i >= 0; i--)
+    {
+      CHECK(playlist.getPrevTrack(&track));
+      CHECK(same_track(track, tracks[expect[i]]));
+    }
+
+  CHECK(!playlist.getPrevTrack(&track));
+
+  CHECK(playlist.restart());
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int check_all_tracks(Playlist &playlist, const TrackList &tracks)
+{
+  std::vector<int> expect;
+
+  for (size_t i = 0; i < tracks.size(); i++)
+    {
+      expect.push_back(i);
+    }
+
+  CHECK(playlist.select(Playlist::ListTypeAllTrack, ""));
+  CHECK(check_list(playlist, tracks, expect) == 0);
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_navigation(void)
+{
+  printf("navigation\n");
+
+  TrackList tracks;
+  append_tracks(tracks, TEST_TRACKS);
+  CHECK(write_db(tracks));
+
+  Playlist playlist(DB_NAME);
+  CHECK(playlist.init(s_work_dir));
+  CHECK(access(s_index_file, F_OK) == 0);
+  CHECK(check_all_tracks(playlist, tracks) == 0);
+
+  /* Repeat mode goes round at both ends. */
+
+  Track track;
+
+  CHECK(playlist.setRepeatMode(Playlist::RepeatModeOn));
+  CHECK(playlist.getPrevTrack(&track));
+  CHECK(same_track(track, tracks[TEST_TRACKS - 1]));
+  CHECK(playlist.getNextTrack(&track));
+  CHECK(same_track(track, tracks[0]));
+  CHECK(playlist.getPrevTrack(&track));
+  CHECK(same_track(track, tracks[TEST_TRACKS - 1]));
+  CHECK(playlist.setRepeatMode(Playlist::RepeatModeOff));
+  CHECK(playlist.restart());
+
+  /* Shuffle mode plays every track once. */
+
+  std::vector<int> count(TEST_TRACKS, 0);
+  bool in_order = true;
+
+  CHECK(playlist.setPlayMode(Playlist::PlayModeShuffle));
+
+  for (int i = 0; i < TEST_TRACKS; i++)
+    {
+      CHECK(playlist.getNextTrack(&track));
+
+      int no = atoi(track.title + strlen("track_"));
+      CHECK(no >= 0 && no < TEST_TRACKS);
+      CHECK(same_track(track, tracks[no]));
+      count[no]++;
+      in_order = in_order && (no == i);
+    }
+
+  CHECK(!playlist.getNextTrack(&track));
+  CHECK(!in_order);
+
+  for (int i = 0; i < TEST_TRACKS; i++)
+    {
+      CHECK(count[i] == 1);
+    }
+
+  CHECK(playlist.setPlayMode(Playlist::PlayModeNormal));
+  CHECK(check_all_tracks(playlist, tracks) == 0);
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_filter(void)
+{
+  printf("artist/album filter\n");
+
+  TrackList tracks;
+  append_tracks(tracks, TEST_TRACKS);
+
+  Playlist playlist(DB_NAME);
+  CHECK(playlist.init(s_work_dir));
+
+  for (int i = 0; i < ARTIST_NUM; i++)
+    {
+      std::vector<int> expect;
+      char key[64];
+
+      snprintf(key, sizeof(key), "artist %d", i);
+      for (int no = i; no < TEST_TRACKS; no += ARTIST_NUM)
+        {
+          expect.push_back(no);
+        }
+
+      CHECK(playlist.updatePlaylist(Playlist::ListTypeArtist, key));
+      CHECK(playlist.select(Playlist::ListTypeArtist, key));
+      CHECK(check_list(playlist, tracks, expect) == 0);
+    }
+
+  for (int i = 0; i < TEST_TRACKS / ALBUM_TRACKS; i += 3)
+    {
+      std::vector<int> expect;
+      char key[64];
+
+      snprintf(key, sizeof(key), "album %d", i);
+      for (int no = 0; no < ALBUM_TRACKS; no++)
+        {
+          expect.push_back(i * ALBUM_TRACKS + no);
+        }
+
+      CHECK(playlist.updatePlaylist(Playlist::ListTypeAlbum, key));
+      CHECK(playlist.select(Playlist::ListTypeAlbum, key));
+      CHECK(check_list(playlist, tracks, expect) == 0);
+    }
+
+  /* Unknown key and a key which is a prefix of others make no track. */
+
+  Track track;
+
+  CHECK(playlist.updatePlaylist(Playlist::ListTypeArtist, "nobody"));
+  CHECK(playlist.select(Playlist::ListTypeArtist, "nobody"));
+  CHECK(!playlist.getNextTrack(&track));
+
+  CHECK(playlist.updatePlaylist(Playlist::ListTypeAlbum, "album 1"));
+  CHECK(playlist.select(Playlist::ListTypeAlbum, "album 1"));
+  CHECK(playlist.getNextTrack(&track));
+  CHECK(strcmp(track.album, "album 1") == 0);
+  CHECK(playlist.restart());
+
+  /* User playlist keeps the order of addition. */
+
+  std::vector<int> expect;
+
+  CHECK(playlist.addTrack("favorite", 5));
+  CHECK(playlist.addTrack("favorite", 150));
+  CHECK(playlist.addTrack("favorite", 9));
+  CHECK(playlist.addTrack("favorite", 0));
+  CHECK(!playlist.addTrack("favorite", TEST_TRACKS));
+  CHECK(playlist.removeTrack("favorite", 2));
+  expect.push_back(5);
+  expect.push_back(150);
+  expect.push_back(0);
+
+  CHECK(playlist.select(Playlist::ListTypeUser, "favorite"));
+  CHECK(check_list(playlist, tracks, expect) == 0);
+
+  CHECK(playlist.deleteOne(Playlist::ListTypeUser, "favorite"));
+  CHECK(!playlist.select(Playlist::ListTypeUser, "favorite"));
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_update(void)
+{
+  printf("index update\n");
+
+  TrackList tracks;
+  append_tracks(tracks, TEST_TRACKS);
+
+  /* Same database uses the index as it is. */
+
+  struct stat before;
+  struct stat after;
+
+  CHECK(index_stat(&before));
+  {
+    Playlist playlist(DB_NAME);
+    CHECK(playlist.init(s_work_dir));
+    CHECK(check_all_tracks(playlist, tracks) == 0);
+  }
+  CHECK(index_stat(&after));
+  CHECK(same_file_time(before, after));
+
+  /* Changed database makes the index again. */
+
+  tracks[50].author = "new artist";
+  tracks[50].album  = "new album";
+  CHECK(write_db(tracks));
+  {
+    Playlist playlist(DB_NAME);
+    CHECK(playlist.init(s_work_dir));
+    CHECK(check_all_tracks(playlist, tracks) == 0);
+
+    std::vector<int> expect(1, 50);
+
+    CHECK(playlist.updatePlaylist(Playlist::ListTypeArtist, "new artist"));
+    CHECK(playlist.select(Playlist::ListTypeArtist, "new artist"));
+    CHECK(check_list(playlist, tracks, expect) == 0);
+  }
+
+  /* A broken index is made again. */
+
+  CHECK(truncate(s_index_file, 10) == 0);
+  {
+    Playlist playlist(DB_NAME);
+    CHECK(playlist.init(s_work_dir));
+    CHECK(check_all_tracks(playlist, tracks) == 0);
+  }
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_append(void)
+{
+  printf("index append\n");
+
+  TrackList tracks;
+  append_tracks(tracks, TEST_TRACKS);
+  CHECK(write_db(tracks));
+
+  std::vector<int> expect;
+  expect.push_back(7);
+  expect.push_back(120);
+
+  {
+    Playlist playlist(DB_NAME);
+    CHECK(playlist.init(s_work_dir));
+    CHECK(playlist.addTrack("favorite", 7));
+    CHECK(playlist.addTrack("favorite", 120));
+  }
+
+  /* Added lines (the same writer makes the same top part) are added to
+   * the index, and the record numbers in the lists are kept.
+   */
+
+  CHECK(set_marker());
+  append_tracks(tracks, 50);
+  CHECK(write_db(tracks));
+  {
+    Playlist playlist(DB_NAME);
+    CHECK(playlist.init(s_work_dir));
+    CHECK(has_marker());
+    CHECK(check_all_tracks(playlist, tracks) == 0);
+    CHECK(playlist.select(Playlist::ListTypeUser, "favorite"));
+    CHECK(check_list(playlist, tracks, expect) == 0);
+
+    std::vector<int> artist;
+    for (size_t no = 2; no < tracks.size(); no += ARTIST_NUM)
+      {
+        artist.push_back(no);
+      }
+
+    CHECK(playlist.updatePlaylist(Playlist::ListTypeArtist, "artist 2"));
+    CHECK(playlist.select(Playlist::ListTypeArtist, "artist 2"));
+    CHECK(check_list(playlist, tracks, artist) == 0);
+  }
+
+  /* Only the time stamp is changed. The index is kept, and the new time
+   * is written, so the next open doesn't check the database.
+   */
+
+  struct stat before;
+  struct stat after;
+
+  CHECK(touch_db(100));
+  {
+    Playlist playlist(DB_NAME);
+    CHECK(playlist.init(s_work_dir));
+    CHECK(has_marker());
+    CHECK(check_all_tracks(playlist, tracks) == 0);
+  }
+  CHECK(index_stat(&before));
+  {
+    Playlist playlist(DB_NAME);
+    CHECK(playlist.init(s_work_dir));
+  }
+  CHECK(index_stat(&after));
+  CHECK(same_file_time(before, after));
+
+  /* Change in the indexed part, even of the same size, makes the index
+   * again.
+   */
+
+  tracks[20].title[0] = 'T';
+  CHECK(write_db(tracks));
+  CHECK(touch_db(200));
+  {
+    Playlist playlist(DB_NAME);
+    CHECK(playlist.init(s_work_dir));
+    CHECK(!has_marker());
+    CHECK(check_all_tracks(playlist, tracks) == 0);
+  }
+
+  /* Removed lines make the index again. */
+
+  CHECK(set_marker());
+  tracks.resize(150);
+  CHECK(write_db(tracks));
+  {
+    Playlist playlist(DB_NAME);
+    CHECK(playlist.init(s_work_dir));
+    CHECK(!has_marker());
+    CHECK(check_all_tracks(playlist, tracks) == 0);
+  }
+
+  /* The last line without line feed may be continued, so lines added
+   * after it make the index again. Here the codec of the last track is
+   * made invalid.
+   */
+
+  struct stat st;
+
+  CHECK(stat(s_db_file, &st) == 0);
+  CHECK(truncate(s_db_file, st.st_size - strlen(",0\r\n")) == 0);
+  {
+    Playlist playlist(DB_NAME);
+    CHECK(playlist.init(s_work_dir));
+    CHECK(check_all_tracks(playlist, tracks) == 0);
+  }
+
+  CHECK(set_marker());
+  tracks.pop_back();
+
+  FILE *fp = fopen(s_db_file, "a");
+  CHECK(fp != NULL);
+  fputs("x,0\r\n", fp);
+  for (int i = 0; i < 5; i++)
+    {
+      tracks.push_back(make_track(tracks.size()));
+      fputs(track_line(tracks.back()).c_str(), fp);
+    }
+  CHECK(fclose(fp) == 0);
+  CHECK(touch_db(300));
+  {
+    Playlist playlist(DB_NAME);
+    CHECK(playlist.init(s_work_dir));
+    CHECK(!has_marker());
+    CHECK(check_all_tracks(playlist, tracks) == 0);
+  }
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int bench(void)
+{
+  printf("benchmark (%d tracks)\n", BENCH_TRACKS);
+
+  TrackList tracks;
+  append_tracks(tracks, BENCH_TRACKS - BENCH_ADDED);
+  CHECK(write_db(tracks));
+  unlink(s_index_file);
+
+  double t0 = now_ms();
+  {
+    Playlist playlist(DB_NAME);
+    CHECK(playlist.init(s_work_dir));
+  }
+  double t1 = now_ms();
+
+  append_tracks(tracks, BENCH_ADDED);
+  CHECK(write_db(tracks));
+  CHECK(touch_db(100));
+
+  double t2 = now_ms();
+  {
+    Playlist playlist(DB_NAME);
+    CHECK(playlist.init(s_work_dir));
+  }
+  double t3 = now_ms();
+
+  Track track;
+  Playlist playlist(DB_NAME);
+  CHECK(playlist.init(s_work_dir));
+  double t4 = now_ms();
+  for (int i = 0; i < BENCH_TRACKS; i++)
+    {
+      CHECK(playlist.getNextTrack(&track));
+    }
+  double t5 = now_ms();
+  CHECK(playlist.updatePlaylist(Playlist::ListTypeArtist, "artist 3"));
+  CHECK(playlist.select(Playlist::ListTypeArtist, "artist 3"));
+  double t6 = now_ms();
+
+  printf("  init (make index) : %9.3f ms\n", t1 - t0);
+  printf("  init (add %d)    : %9.3f ms\n", BENCH_ADDED, t3 - t2);
+  printf("  init (made index) : %9.3f ms\n", t4 - t3);
+  printf("  getNextTrack      : %9.3f us/track\n",
+         (t5 - t4) * 1000 / BENCH_TRACKS);
+  printf("  artist playlist   : %9.3f ms\n", t6 - t5);
+
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  bool test_only = (argc > 1 && strcmp(argv[1], "-t") == 0);
+
+  srand(1);
+
+  if (!make_work_dir())
+    {
+      printf("Cannot make work directory\n");
+      return 1;
+    }
+
+  if (test_navigation() != 0 || test_filter() != 0 || test_update() != 0 ||
+      test_append() != 0)
+    {
+      printf("Test NG\n");
+      return 1;
+    }
+
+  printf("All tests OK\n");
+
+  if (!test_only && bench() != 0)
+    {
+      return 1;
+    }
+
+  return 0;
+}
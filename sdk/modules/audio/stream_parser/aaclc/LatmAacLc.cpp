@@ -43,6 +43,7 @@
 #include <stdlib.h>
 
 #include "common/LatmAacLc.h"
+#include "common/BitStreamReader.h"
 
 /* Syncword to use with LATM / LOAS.
  * (Compare after obtaining with 11bit value -> long value)
@@ -54,6 +55,12 @@
 #define LATM_SYNCWORD_EXT_LOAS   LATM_SYNCWORD_LOAS
 #define LATM_SYNCWORD_EXT_PS     0x548        /* -101 0100 1000 */
 
+/* LOAS syncword on byte boundary (11bit syncword + 5bit mask) */
+
+#define LATM_SYNCWORD_LOAS_16BIT  (LATM_SYNCWORD_LOAS << 5)
+#define LATM_SYNCWORD_LOAS_MASK   0xFFE0
+#define LATM_SYNCWORD_SEARCH_SIZE 2
+
 
 /* Channel_Configuration[ISO standard] */
 
@@ -143,13 +150,8 @@ typedef enum latm_flt_e LatmFlt;
 
 struct latm_local_info_s
 {
-  uint8_t  *ptr_check_latm;    /* Current pointer */
-  uint32_t  total_bit_length;  /* Cumulative bit length read in */
-  uint32_t  stream_cnt;        /* = StreamID */
-
-  /* Temporarily use for data passing purpose. */
-
-  uint32_t  temp_long;        /* long value */
+  BitStreamReader reader;      /* Current bit position in the LATM */
+  uint32_t        stream_cnt;  /* = StreamID */
 };
 typedef struct latm_local_info_s LatmLocalInfo;
 
@@ -165,158 +167,13 @@ struct use_chunk_info_s
 };
 typedef struct use_chunk_info_s UseChunkInfo;
 
-/* Mask value at bit processing. */
-
-static const uint8_t BitMaskLessByteTable[9] =
-{
-  0x00,  /* 0-bit. */
-  0x80,  /* 1-bit. */
-  0xC0,  /* 2-bit. */
-  0xE0,  /* 3-bit. */
-  0xF0,  /* 4-bit. */
-  0xF8,  /* 5-bit. */
-  0xFC,  /* 6-bit. */
-  0xFE,  /* 7-bit. */
-  0xFF   /* 8-bit. */
-};
-
-#ifdef WINDOWS
-/*--------------------------------------------------------------------------*/
-static inline uint32_t convByteToLong(uint8_t byte_value[], uint8_t max_byte)
-{
-  uint32_t rtn_value = 0;
-
-  for (int32_t i = 0, j = max_byte - 1; i < max_byte; i++, j--)
-    {
-      rtn_value |= (uint32_t)(byte_value[i] << (j * LATM_BIT_OF_BYTE));
-    }
-
-  return rtn_value;
-}
-#else
-/*--------------------------------------------------------------------------*/
-static inline uint32_t convByteToLong(uint8_t byte_value[], uint8_t max_byte)
-{
-  uint32_t rtn_value = 0;
-
-  for (int32_t i = 0; i < max_byte; i++)
-    {
-      rtn_value |= (uint32_t)(byte_value[i] << (i * LATM_BIT_OF_BYTE));
-    }
-
-  return rtn_value;
-}
-#endif
-
 /*--------------------------------------------------------------------------*/
-static uint8_t bitReadLessByte(LatmLocalInfo *ptr_info,
+static inline uint32_t bitRead(LatmLocalInfo *ptr_info,
                                uint32_t length_for_read)
 {
-  uint8_t rtn_value = 0;
-
-  uint8_t modulo_bit =
-    (uint8_t)(ptr_info->total_bit_length % LATM_BIT_OF_BYTE);
-
-  /* Check if it spans 2 bytes.(modulo_bit is the start bit) */
-
-  if ((LATM_BIT_OF_BYTE - modulo_bit) >= (uint8_t)length_for_read)
-    {
-      /* When it does not span 2 byte. */
-
-      rtn_value =
-        (*(ptr_info->ptr_check_latm) &
-          (BitMaskLessByteTable[length_for_read] >> modulo_bit));
-      ptr_info->total_bit_length += length_for_read;
-
-      if (ptr_info->total_bit_length % LATM_BIT_OF_BYTE)
-        {
-          rtn_value >>=
-            (LATM_BIT_OF_BYTE - (ptr_info->total_bit_length %
-              LATM_BIT_OF_BYTE));
-        }
-    }
-  else
-    {
-      /* Read 1st byte. */
-
-      rtn_value =
-        (*(ptr_info->ptr_check_latm) & ~BitMaskLessByteTable[modulo_bit]);
-
-      /* Since the return value is 1 byte, it shifts to the upper bit side. */
-
-      rtn_value <<= (length_for_read - (LATM_BIT_OF_BYTE - modulo_bit));
-
-      /* If total_bit_length is last added with length_for_read,
-       * this line is not needed
-       */
-
-      ptr_info->total_bit_length += (LATM_BIT_OF_BYTE - modulo_bit);
-
-      /* Advance pointer for byte again. */
-
-      (ptr_info->ptr_check_latm)++;
-
-      /* Calculate the number of bits in 2nd byte. */
-
-      modulo_bit = (length_for_read - (LATM_BIT_OF_BYTE - modulo_bit));
-
-      /* Reads the 2nd byte and sets the value combined with 1st byte
-       * as the return value.
-       */
-
-      rtn_value |=
-        ((*(ptr_info->ptr_check_latm) & BitMaskLessByteTable[modulo_bit]) >>
-          (LATM_BIT_OF_BYTE - modulo_bit));
-      ptr_info->total_bit_length += modulo_bit;
-    }
-
-  /* Advance the pointer when there are no remaining bits after processing. */
+  /* Read 1 to 32 bits. (MSB first) */
 
-  if (!(ptr_info->total_bit_length % LATM_BIT_OF_BYTE))
-    {
-      (ptr_info->ptr_check_latm)++;
-    }
-
-  return rtn_value;
-}
-
-/*--------------------------------------------------------------------------*/
-static uint32_t bitReadLessLong(LatmLocalInfo *ptr_info,
-                                uint32_t length_for_read)
-{
-  uint32_t i = 0;
-  uint8_t  byte_value[4] =
-  {
-    0
-  };
-
-  uint8_t max_byte = (length_for_read / LATM_BIT_OF_BYTE);
-  uint8_t modulo_bit = (length_for_read % LATM_BIT_OF_BYTE);
-
-  /* Read the bit remainder first. */
-
-  if (modulo_bit)
-    {
-      byte_value[0] = bitReadLessByte(ptr_info, modulo_bit);
-      i = 1;
-      max_byte++;
-    }
-
-  /* Process remaining by byte unit.
-   * (ptr_check_latm and total_bit_length are updated in bitReadLessByte ())
-   */
-
-  while ((i < (int32_t)max_byte) && (i < sizeof(byte_value)))
-    {
-      byte_value[i] = bitReadLessByte(ptr_info, LATM_BIT_OF_BYTE);
-      i++;
-    }
-
-  /* Convert byte array to long. */
-
-  uint32_t rtn_long_value = convByteToLong(&byte_value[0], max_byte);
-
-  return rtn_long_value;
+  return BitStream_Read(&ptr_info->reader, length_for_read);
 }
 
 /*--------------------------------------------------------------------------*/
@@ -445,73 +302,26 @@ static int copyAudioSpecificConfig(InfoStreamMuxConfig *ptr_stream_mux_config,
 }
 
 /*--------------------------------------------------------------------------*/
-static bool serachNextBitsForSyncWord(LatmLocalInfo *ptr_info,
-                                      uint32_t sync_length,
-                                      uint32_t search_word)
-{
-  LatmLocalInfo backup;
-
-  /* Search for syncword while bit shifting.
-   * (Avoid searching indefinitely, with 8 bits as the upper limit)
-   */
-
-  for (int32_t i = 0; i < 8; i++)
-    {
-      /* Pointers and cumulative bit are updated,
-       * so copy it temporarily and use it.
-       */
-
-      backup.total_bit_length = (ptr_info->total_bit_length + i);
-      uint32_t byte_of_total = (backup.total_bit_length / 8);
-
-      /* Fit the read pointer to the cumulative bit. */
-
-      backup.ptr_check_latm = (ptr_info->ptr_check_latm + byte_of_total);
-
-      /* Read specified bit length. */
-
-      uint32_t dummy_read = bitReadLessLong(&backup, sync_length);
-      if (dummy_read == search_word)
-        {
-          /* Set the next bit position of syncword. */
-
-          ptr_info->temp_long = backup.total_bit_length;
-          return true;
-        }
-    }
-
-  return false;
-}
-
-/*--------------------------------------------------------------------------*/
-static int32_t AACLC_checkLOAS(LatmLocalInfo *ptr_info)
+static int32_t AACLC_checkLOAS(const uint8_t *ptr_readbuff, uint32_t size)
 {
-  LatmLocalInfo temp;
+  BitStreamReader temp;
   int32_t length_latm_frame = 0;
 
-  /* Pointers and cumulative bit are updated,
-   * so copy it temporarily and use it.
+  /* AudioSyncStream() is byte aligned, so the syncword is checked
+   * only at the top byte.
    */
 
-  temp.ptr_check_latm = ptr_info->ptr_check_latm;
-  temp.total_bit_length = ptr_info->total_bit_length;
-
-  /* Search syncword. */
-
-  if (serachNextBitsForSyncWord(&temp,
-                                LATM_LENGTH_OF_SYNCWORD,
-                                LATM_SYNCWORD_LOAS))
+  if (BitStream_FindSync(ptr_readbuff,
+                         (size < LATM_SYNCWORD_SEARCH_SIZE) ?
+                           size : LATM_SYNCWORD_SEARCH_SIZE,
+                         LATM_SYNCWORD_LOAS_16BIT,
+                         LATM_SYNCWORD_LOAS_MASK) == 0)
     {
       /* In the case of syncword, get the LATM frame length. */
 
-      temp.total_bit_length = temp.temp_long;
-      temp.ptr_check_latm =
-        (ptr_info->ptr_check_latm +
-          (temp.total_bit_length / LATM_BIT_OF_BYTE));
-
-      /* Get the frame length after updating pointer and cumulative bit. */
-
-      length_latm_frame = bitReadLessLong(&temp, LATM_LENGTH_OF_FRAME);
+      BitStream_Init(&temp, ptr_readbuff, size);
+      BitStream_Skip(&temp, LATM_LENGTH_OF_SYNCWORD);
+      length_latm_frame = BitStream_Read(&temp, LATM_LENGTH_OF_FRAME);
     }
 
   return length_latm_frame;
@@ -524,12 +334,13 @@ static int32_t iso_byteAlignment(LatmLocalInfo *ptr_info)
    * bit length becomes "positive bit (no bit remainder)"
    */
 
-  uint32_t modulo_bit = (8 - (ptr_info->total_bit_length % LATM_BIT_OF_BYTE));
+  uint32_t modulo_bit =
+    (8 - (BitStream_GetPosition(&ptr_info->reader) % LATM_BIT_OF_BYTE));
   if (modulo_bit)
     {
       /* Idle read . */
 
-      bitReadLessByte(ptr_info, modulo_bit);
+      BitStream_Skip(&ptr_info->reader, modulo_bit);
     }
 
   return modulo_bit;
@@ -540,13 +351,13 @@ static uint32_t isoLatmGetValue(LatmLocalInfo *ptr_info)
 {
   uint32_t helper_value = 0;
 
-  uint8_t bytes_for_value = bitReadLessByte(ptr_info, 2);
+  uint8_t bytes_for_value = bitRead(ptr_info, 2);
 
   /* Below is the ISO standard. */
 
   for (int32_t i = 0; i <= (int32_t)bytes_for_value; i++)
     {
-      uint8_t value_tmp = bitReadLessByte(ptr_info, 8);
+      uint8_t value_tmp = bitRead(ptr_info, 8);
       helper_value *= (2 ^ 8);
       helper_value += value_tmp;
     }
@@ -567,88 +378,88 @@ static int32_t
 
   /* Element_instance_tag processing. */
 
-  uint32_t dummy_read = bitReadLessByte(ptr_info, 4);
+  uint32_t dummy_read = bitRead(ptr_info, 4);
   bit_length += 4;
 
   /* Object_type processing. */
 
   ptr_stream_mux_config->info_stream_id[ptr_info->stream_cnt].
-    asc.pce_object_type = bitReadLessByte(ptr_info, 2);
+    asc.pce_object_type = bitRead(ptr_info, 2);
   bit_length += 2;
 
   /* Sampling_frequency_index processing. */
 
   ptr_stream_mux_config->info_stream_id[ptr_info->stream_cnt].
-    asc.pce_sampling_frequency_index = bitReadLessByte(ptr_info, 4);
+    asc.pce_sampling_frequency_index = bitRead(ptr_info, 4);
   bit_length += 4;
 
   /* Num_front_channel_elements processing. */
 
-  uint32_t num_front_channel_elements = bitReadLessByte(ptr_info, 4);
+  uint32_t num_front_channel_elements = bitRead(ptr_info, 4);
   bit_length += 4;
 
   /* Num_side_channel_elements processing. */
 
-  uint32_t num_side_channel_elements = bitReadLessByte(ptr_info, 4);
+  uint32_t num_side_channel_elements = bitRead(ptr_info, 4);
   bit_length += 4;
 
   /* Num_back_channel_elements processing. */
 
-  uint32_t num_back_channel_elements = bitReadLessByte(ptr_info, 4);
+  uint32_t num_back_channel_elements = bitRead(ptr_info, 4);
   bit_length += 4;
 
   /* Bum_lfe_channel_elements processing. */
 
-  uint32_t num_lfe_channel_elements = bitReadLessByte(ptr_info, 2);
+  uint32_t num_lfe_channel_elements = bitRead(ptr_info, 2);
   bit_length += 2;
 
   /* Num_assoc_data_elements processing. */
 
-  uint32_t num_assoc_data_elements = bitReadLessByte(ptr_info, 3);
+  uint32_t num_assoc_data_elements = bitRead(ptr_info, 3);
   bit_length += 3;
 
   /* Num_valid_cc_elements processing. */
 
-  uint32_t num_valid_cc_elements = bitReadLessByte(ptr_info, 4);
+  uint32_t num_valid_cc_elements = bitRead(ptr_info, 4);
   bit_length += 4;
 
   /* Mono_mixdown_present processing. */
 
-  dummy_read = bitReadLessByte(ptr_info, 1);
+  dummy_read = bitRead(ptr_info, 1);
   bit_length++;
   if (dummy_read)
     {
       /* Mono_mixdown_element_number processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 4);
+      dummy_read = bitRead(ptr_info, 4);
       bit_length += 4;
     }
 
   /* Stereo_mixdown_present processing. */
 
-  dummy_read = bitReadLessByte(ptr_info, 1);
+  dummy_read = bitRead(ptr_info, 1);
   bit_length++;
   if (dummy_read)
     {
       /* Stereo_mixdown_element_number processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 4);
+      dummy_read = bitRead(ptr_info, 4);
       bit_length += 4;
     }
 
   /* Matrix_mixdown_idx_present processing.. */
 
-  dummy_read = bitReadLessByte(ptr_info, 1);
+  dummy_read = bitRead(ptr_info, 1);
   bit_length++;
   if (dummy_read)
     {
       /* Matrix_mixdown_idx processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 2);
+      dummy_read = bitRead(ptr_info, 2);
       bit_length += 2;
 
       /* Pseudo_surround_enable processing. */
-      dummy_read = bitReadLessByte(ptr_info, 1);
+      dummy_read = bitRead(ptr_info, 1);
       bit_length += 1;
     }
 
@@ -657,61 +468,61 @@ static int32_t
     {
       /* Front_element_is_cpe[i] processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 1);
+      dummy_read = bitRead(ptr_info, 1);
       bit_length += 1;
 
       /* Front_element_tag_select[i] processing.. */
 
-      dummy_read = bitReadLessByte(ptr_info, 4);
+      dummy_read = bitRead(ptr_info, 4);
       bit_length += 4;
     }
   for (i = 0; i < (int32_t)num_side_channel_elements; i++)
     {
       /* Side_element_is_cpe[i] processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 1);
+      dummy_read = bitRead(ptr_info, 1);
       bit_length += 1;
 
       /* Side_element_tag_select[i] processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 4);
+      dummy_read = bitRead(ptr_info, 4);
       bit_length += 4;
     }
   for (i = 0; i < (int32_t)num_back_channel_elements; i++)
     {
       /* Back_element_is_cpe[i] processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 1);
+      dummy_read = bitRead(ptr_info, 1);
       bit_length += 1;
 
       /* Back_element_tag_select[i] processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 4);
+      dummy_read = bitRead(ptr_info, 4);
       bit_length += 4;
     }
   for (i = 0; i < (int32_t)num_lfe_channel_elements; i++)
     {
       /* Lfe_element_tag_select[i] processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 4);
+      dummy_read = bitRead(ptr_info, 4);
       bit_length += 4;
     }
   for (i = 0; i < (int32_t)num_assoc_data_elements; i++)
     {
       /* Assoc_data_element_tag_select[i] processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 4);
+      dummy_read = bitRead(ptr_info, 4);
       bit_length += 4;
     }
   for (i = 0; i < (int32_t)num_valid_cc_elements; i++)
     {
       /* Cc_element_is_ind_sw[i] processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 1);
+      dummy_read = bitRead(ptr_info, 1);
       bit_length += 1;
 
       /* Valid_cc_element_tag_select[i] processing. */
-      dummy_read = bitReadLessByte(ptr_info, 4);
+      dummy_read = bitRead(ptr_info, 4);
       bit_length += 4;
     }
 
@@ -721,13 +532,13 @@ static int32_t
 
   /* Comment_field_bytes processing. */
 
-  uint32_t comment_field_bytes = bitReadLessByte(ptr_info, 8);
+  uint32_t comment_field_bytes = bitRead(ptr_info, 8);
   bit_length += 8;
   for (i = 0; i < (int32_t)comment_field_bytes; i++)
     {
       /* Comment_field_data[i] processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 8);
+      dummy_read = bitRead(ptr_info, 8);
       bit_length += 8;
     }
 
@@ -746,24 +557,24 @@ static int32_t isoGASpecificConfig(LatmLocalInfo *ptr_info,
 
   /* [ISO standard] frameLengthFlag processing. */
 
-  uint32_t dummy_read = bitReadLessByte(ptr_info, 1);
+  uint32_t dummy_read = bitRead(ptr_info, 1);
   bit_length++;
 
   /* [ISO standard] dependsOnCoreCoder processing. */
 
-  dummy_read = bitReadLessByte(ptr_info, 1);
+  dummy_read = bitRead(ptr_info, 1);
   bit_length++;
   if (dummy_read)
     {
       /* [ISO standard] coreCoderDelay processing. */
 
-      dummy_read = bitReadLessLong(ptr_info, 14);
+      dummy_read = bitRead(ptr_info, 14);
       bit_length += 14;
     }
 
   /* [ISO standard] extensionFlag processing. */
 
-  uint32_t extensionFlag = bitReadLessByte(ptr_info, 1);
+  uint32_t extensionFlag = bitRead(ptr_info, 1);
   bit_length++;
 
   /* [ISO standard] channel_configuration processing. */
@@ -836,7 +647,7 @@ static int32_t isoGASpecificConfig(LatmLocalInfo *ptr_info,
 
       /* [ISO standard] extensionFlag3 processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 1);
+      dummy_read = bitRead(ptr_info, 1);
       bit_length++;
     }
 
@@ -848,10 +659,10 @@ static uint32_t isoGetAudioObjectType(LatmLocalInfo *ptr_info)
 {
   /* According to ISO standard. */
 
-  uint32_t audioObjectType = bitReadLessByte(ptr_info, 5);
+  uint32_t audioObjectType = bitRead(ptr_info, 5);
   if (audioObjectType == LATM_VAL_OF_5BIT)
     {
-      audioObjectType += bitReadLessByte(ptr_info, 6);
+      audioObjectType += bitRead(ptr_info, 6);
     }
 
   return audioObjectType;
@@ -885,7 +696,7 @@ static int32_t
 
   ptr_stream_mux_config->
    info_stream_id[ptr_info->stream_cnt].asc.sampling_frequency_index =
-     bitReadLessByte(ptr_info, 4);
+     bitRead(ptr_info, 4);
   bit_length += 4;
 
   /* [ISO standard] Check esc_value. */
@@ -897,7 +708,7 @@ static int32_t
 
       ptr_stream_mux_config->
         info_stream_id[ptr_info->stream_cnt].asc.sampling_frequency =
-          bitReadLessLong(ptr_info, 24);
+          bitRead(ptr_info, 24);
       bit_length += 24;
     }
   else
@@ -912,7 +723,7 @@ static int32_t
 
   ptr_stream_mux_config->
     info_stream_id[ptr_info->stream_cnt].asc.channel_configuration =
-      bitReadLessByte(ptr_info, 4);
+      bitRead(ptr_info, 4);
   bit_length += 4;
   ptr_stream_mux_config->
     info_stream_id[ptr_info->stream_cnt].asc.ps_present_flag = (-1);
@@ -943,7 +754,7 @@ static int32_t
       ptr_stream_mux_config->
         info_stream_id[ptr_info->stream_cnt].
           asc.extension_sampling_frequency_index =
-            bitReadLessByte(ptr_info, 4);
+            bitRead(ptr_info, 4);
       bit_length += 4;
 
       /* [ISO standard] Check esc_value. */
@@ -956,7 +767,7 @@ static int32_t
 
           ptr_stream_mux_config->
             info_stream_id[ptr_info->stream_cnt].
-              asc.extension_sampling_frequency = bitReadLessLong(ptr_info, 24);
+              asc.extension_sampling_frequency = bitRead(ptr_info, 24);
           bit_length += 24;
         }
       else
@@ -1053,7 +864,7 @@ static int32_t
     {
       /* [ISO standard] syncExtensionType processing. */
 
-      uint32_t sync_ext_type = bitReadLessLong(ptr_info, 11);
+      uint32_t sync_ext_type = bitRead(ptr_info, 11);
       bit_length += 11;
 
       /* [ISO standard] Check extended syncword. */
@@ -1085,7 +896,7 @@ static int32_t
                 /* [ISO standard] sbrPresentFlag processing. */
 
                 ptr_stream_mux_config->info_stream_id[ptr_info->stream_cnt].
-                  asc.sbr_present_flag = bitReadLessByte(ptr_info, 1);
+                  asc.sbr_present_flag = bitRead(ptr_info, 1);
                 bit_length++;
 
                 /* [ISO standard] Check acquisition SBR flag. */
@@ -1101,7 +912,7 @@ static int32_t
                     ptr_stream_mux_config->
                       info_stream_id[ptr_info->stream_cnt].
                         asc.extension_sampling_frequency_index =
-                          bitReadLessByte(ptr_info, 4);
+                          bitRead(ptr_info, 4);
                     bit_length += 4;
                   }
                 else
@@ -1132,7 +943,7 @@ static int32_t
                     ptr_stream_mux_config->
                       info_stream_id[ptr_info->stream_cnt].
                         asc.extension_sampling_frequency =
-                          bitReadLessLong(ptr_info, 24);
+                          bitRead(ptr_info, 24);
                     bit_length += 24;
                   }
 
@@ -1146,7 +957,7 @@ static int32_t
                      * According to the ISO standard, nextbits () is not used.
                      */
 
-                    sync_ext_type = bitReadLessLong(ptr_info, 11);
+                    sync_ext_type = bitRead(ptr_info, 11);
                     bit_length += 11;
                     if (sync_ext_type == LATM_SYNCWORD_EXT_PS)
                       {
@@ -1155,7 +966,7 @@ static int32_t
                         ptr_stream_mux_config->
                           info_stream_id[ptr_info->stream_cnt].
                             asc.ps_present_flag =
-                              bitReadLessByte(ptr_info, 1);
+                              bitRead(ptr_info, 1);
                         bit_length++;
                       }
                   }
@@ -1216,7 +1027,7 @@ static int32_t isoPayloadLengthInfo(LatmLocalInfo *ptr_info,
                   uint8_t tmp = 0;
                   do
                     {
-                      tmp = bitReadLessByte(ptr_info, 8);
+                      tmp = bitRead(ptr_info, 8);
                       dummy_length += 8;
 
                       /* [ISO standard] MuxSlotLengthBytes processing*/
@@ -1255,14 +1066,14 @@ static int32_t isoPayloadLengthInfo(LatmLocalInfo *ptr_info,
     {
       /* [ISO standard] numChunk processing. */
 
-      ptr_chunk_info->num_chunk = bitReadLessByte(ptr_info, 4);
+      ptr_chunk_info->num_chunk = bitRead(ptr_info, 4);
       dummy_length += 4;
 
       for (i = 0; i <= (int32_t)ptr_chunk_info->num_chunk; i++)
         {
           /* [ISO standard] streamIndx processing. */
 
-          uint8_t tmp = bitReadLessByte(ptr_info, 4);
+          uint8_t tmp = bitRead(ptr_info, 4);
           dummy_length += 4;
           uint8_t prog = ptr_stream_mux_config->prog_stream_indx[tmp];
           uint8_t lay = ptr_stream_mux_config->lay_stream_indx[tmp];
@@ -1297,7 +1108,7 @@ static int32_t isoPayloadLengthInfo(LatmLocalInfo *ptr_info,
                     {
                       /* [ISO standard] tmp processing. */
 
-                      tmp = bitReadLessByte(ptr_info, 8);
+                      tmp = bitRead(ptr_info, 8);
                       dummy_length += 8;
                       ptr_stream_mux_config->
                         info_stream_id[(ptr_chunk_info->stream_cnt_chunk[i])].
@@ -1307,7 +1118,7 @@ static int32_t isoPayloadLengthInfo(LatmLocalInfo *ptr_info,
 
                   /* [ISO standard] AuEndFlag processing. */
 
-                  tmp = bitReadLessByte(ptr_info, 1);
+                  tmp = bitRead(ptr_info, 1);
                   dummy_length += 1;
                 }
                 break;
@@ -1348,9 +1159,7 @@ static int32_t isoPayloadMux(LatmLocalInfo *ptr_info,
   int32_t rtn_length = 0;
   uint32_t payload_length = 0;
 
-  /* We do not call the payload (raw_data), so we only update
-   * total_bit_length and ptr_check_latm.
-   */
+  /* We do not call the payload (raw_data), so we only skip it. */
 
   if (ptr_stream_mux_config->all_streams_sametime_framing)
     {
@@ -1391,11 +1200,11 @@ static int32_t isoPayloadMux(LatmLocalInfo *ptr_info,
           /* Keep offset from LATM start of each payload. */
 
           ptr_stream_mux_config->info_stream_id[i].payload_offset =
-            ptr_info->total_bit_length;
+            BitStream_GetPosition(&ptr_info->reader);
 
-          /* Add bit length for payload. */
+          /* Skip bit length for payload. */
 
-          ptr_info->total_bit_length += payload_length;
+          BitStream_Skip(&ptr_info->reader, payload_length);
           rtn_length += payload_length;
         }
     }
@@ -1441,19 +1250,15 @@ static int32_t isoPayloadMux(LatmLocalInfo *ptr_info,
 
           ptr_stream_mux_config->
             info_stream_id[(ptr_chunk_info->stream_cnt_chunk[i])].
-              payload_offset = ptr_info->total_bit_length;
+              payload_offset = BitStream_GetPosition(&ptr_info->reader);
 
-          /* Add bit length for payload. */
+          /* Skip bit length for payload. */
 
-          ptr_info->total_bit_length += payload_length;
+          BitStream_Skip(&ptr_info->reader, payload_length);
           rtn_length += payload_length;
         }
     }
 
-  /* Update ptr_check_latm. */
-
-  ptr_info->ptr_check_latm += (ptr_info->total_bit_length / LATM_BIT_OF_BYTE);
-
   return rtn_length;
 }
 
@@ -1461,7 +1266,7 @@ static int32_t isoPayloadMux(LatmLocalInfo *ptr_info,
 static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
                                   InfoStreamMuxConfig *ptr_stream_mux_config)
 {
-  uint32_t old_length = ptr_info->total_bit_length;
+  uint32_t old_length = BitStream_GetPosition(&ptr_info->reader);
 
   /* Since the new StreamMuxConfig information is set,
    * the old information is cleared.
@@ -1471,7 +1276,7 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
 
   /* [ISO standard] audioMuxVersion processing. */
 
-  ptr_stream_mux_config->audio_muxversion = bitReadLessByte(ptr_info, 1);
+  ptr_stream_mux_config->audio_muxversion = bitRead(ptr_info, 1);
 
   if (!ptr_stream_mux_config->audio_muxversion)
     {
@@ -1482,7 +1287,7 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
       /* [ISO standard] audioMuxVersionA processing. */
 
       ptr_stream_mux_config->audio_muxversion_a =
-        bitReadLessByte(ptr_info, 1);
+        bitRead(ptr_info, 1);
     }
 
   int32_t dummy_length = 0;
@@ -1506,15 +1311,15 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
       /* [ISO standard] allStreamsSameTimeFraming processing. */
 
       ptr_stream_mux_config->all_streams_sametime_framing =
-        bitReadLessByte(ptr_info, 1);
+        bitRead(ptr_info, 1);
 
       /* [ISO standard] numSubFrames processing. */
 
-      ptr_stream_mux_config->num_sub_frames = bitReadLessByte(ptr_info, 6);
+      ptr_stream_mux_config->num_sub_frames = bitRead(ptr_info, 6);
 
       /* [ISO standard] numProgram processing. */
 
-      ptr_stream_mux_config->num_program = bitReadLessByte(ptr_info, 4);
+      ptr_stream_mux_config->num_program = bitRead(ptr_info, 4);
 
       ptr_stream_mux_config->info_stream_id[ptr_info->stream_cnt].
         stream_id = (-1);
@@ -1526,7 +1331,7 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
           /* [ISO standard] numLayer processing. */
 
           ptr_stream_mux_config->num_layer[ptr_info->stream_cnt] =
-            bitReadLessByte(ptr_info, 3);
+            bitRead(ptr_info, 3);
 
           /* Although it is the upper limit value of the loop,
            * since stream_cnt changes within the loop, use another variable.
@@ -1571,7 +1376,7 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
 
                   ptr_stream_mux_config->
                     info_stream_id[ptr_info->stream_cnt].use_same_config =
-                      bitReadLessByte(ptr_info, 1);
+                      bitRead(ptr_info, 1);
                 }
 
               /* [ISO standard] When AudioSpecificConfig exists. */
@@ -1642,7 +1447,7 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
                                       LATM_BIT_OF_LONG); i++)
                                 {
                                   dummy_read =
-                                    bitReadLessLong(ptr_info,
+                                    bitRead(ptr_info,
                                                     LATM_BIT_OF_LONG);
                                 }
                             }
@@ -1652,7 +1457,7 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
                           if (asc_length % LATM_BIT_OF_LONG)
                             {
                               dummy_read =
-                                bitReadLessLong(ptr_info,
+                                bitRead(ptr_info,
                                                 (asc_length %
                                                 LATM_BIT_OF_LONG));
                             }
@@ -1681,7 +1486,7 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
 
               ptr_stream_mux_config->
                 info_stream_id[ptr_info->stream_cnt].frame_length_type =
-                  bitReadLessByte(ptr_info, 3);
+                  bitRead(ptr_info, 3);
 
               /* [ISO standard] Sort by FrameLengthType. */
 
@@ -1693,7 +1498,7 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
 
                     ptr_stream_mux_config->
                       info_stream_id[ptr_info->stream_cnt].
-                        latm_buffer_fullness = bitReadLessByte(ptr_info, 8);
+                        latm_buffer_fullness = bitRead(ptr_info, 8);
                     if (!ptr_stream_mux_config->all_streams_sametime_framing)
                       {
                         if ((ptr_stream_mux_config->
@@ -1726,7 +1531,7 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
 
                     ptr_stream_mux_config->
                       info_stream_id[ptr_info->stream_cnt].frame_length =
-                        bitReadLessLong(ptr_info, 9);
+                        bitRead(ptr_info, 9);
 
                     /* Clear unused items. */
 
@@ -1780,7 +1585,7 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
       /* [ISO standard] otherDataPresent processing. */
 
       ptr_stream_mux_config->other_data_present =
-        bitReadLessByte(ptr_info, 1);
+        bitRead(ptr_info, 1);
       if (ptr_stream_mux_config->other_data_present)
         {
           if (ptr_stream_mux_config->audio_muxversion)
@@ -1801,12 +1606,12 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
 
                   /* [ISO standard] otherDataLenEsc processing. */
 
-                  dummy_read = bitReadLessByte(ptr_info, 1);
+                  dummy_read = bitRead(ptr_info, 1);
 
                   /* [ISO standard] otherDataLenTmp processing. */
 
                   ptr_stream_mux_config->other_data_len_bits +=
-                    bitReadLessByte(ptr_info, 8);
+                    bitRead(ptr_info, 8);
                 }
               while (dummy_read);
             }
@@ -1820,12 +1625,12 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
 
       /* [ISO standard] crcCheckPresent processing. */
 
-      dummy_read = bitReadLessByte(ptr_info, 1);
+      dummy_read = bitRead(ptr_info, 1);
       if (dummy_read)
         {
           /* [ISO standard] crcCheckSum processing. */
 
-          dummy_read = bitReadLessByte(ptr_info, 8);
+          dummy_read = bitRead(ptr_info, 8);
         }
     }
   else
@@ -1835,7 +1640,7 @@ static int32_t isoStreamMuxConfig(LatmLocalInfo *ptr_info,
 
   /* Calculate isoStreamMuxConfig() length from cumulative bit. */
 
-  dummy_length = (ptr_info->total_bit_length - old_length);
+  dummy_length = (BitStream_GetPosition(&ptr_info->reader) - old_length);
 
   return dummy_length;
 }
@@ -1853,11 +1658,10 @@ static int32_t isoAudioMuxElement(LatmLocalInfo *ptr_info,
 
   /* [ISO standard] Check the first bit. */
 
-  if (!(*(ptr_info->ptr_check_latm) & 0x80))
+  if (!bitRead(ptr_info, 1))
     {
       /* UseSameStreamMux processing. */
 
-      ptr_info->total_bit_length++;
       rtn_length++;
 
       /* Set information in StreamMuxConfig to local table. */
@@ -1876,7 +1680,6 @@ static int32_t isoAudioMuxElement(LatmLocalInfo *ptr_info,
     }
   else
     {
-      ptr_info->total_bit_length++;
       rtn_length++;
 
       /* Check if there is StreamMuxConfig information for the last time. */
@@ -1931,15 +1734,10 @@ static int32_t isoAudioMuxElement(LatmLocalInfo *ptr_info,
           dummy_length = ptr_stream_mux_config->other_data_len_bits;
           rtn_length += dummy_length;
 
-          /* Add the bit length of otherData. */
-
-          ptr_info->total_bit_length +=
-            ptr_stream_mux_config->other_data_len_bits;
+          /* Skip the bit length of otherData. */
 
-          /* The current pointer ptr_check_latm is updated. */
-
-          ptr_info->ptr_check_latm +=
-            (ptr_info->total_bit_length / LATM_BIT_OF_BYTE);
+          BitStream_Skip(&ptr_info->reader,
+                         ptr_stream_mux_config->other_data_len_bits);
         }
     }
   else
@@ -1954,25 +1752,21 @@ static int32_t isoAudioMuxElement(LatmLocalInfo *ptr_info,
 
 /*--------------------------------------------------------------------------*/
 uint8_t *AACLC_getNextLatm(uint8_t *ptr_readbuff,
+                           uint32_t size,
                            InfoStreamMuxConfig *ptr_stream_mux_config)
 {
   LatmLocalInfo info;
 
-  info.total_bit_length = 0;
-  info.ptr_check_latm = ptr_readbuff;
-
   /* Check LOAS.(If LOAS 2 bytes later LATM header) */
 
-  if (AACLC_checkLOAS(&info))
+  if (AACLC_checkLOAS(ptr_readbuff, size))
     {
-      info.ptr_check_latm = (ptr_readbuff + 2);
-      return info.ptr_check_latm;
+      return (ptr_readbuff + 2);
     }
 
   /* When it is not LOAS.(syncword not found) */
 
-  info.total_bit_length = 0;
-  info.ptr_check_latm = ptr_readbuff;
+  BitStream_Init(&info.reader, ptr_readbuff, size);
 
   /* [ISO standard] AudioMuxElement () processing. */
 
@@ -1984,11 +1778,9 @@ uint8_t *AACLC_getNextLatm(uint8_t *ptr_readbuff,
       return 0;
     }
 
-  /* Update ptr_check_latm. */
-
-  info.ptr_check_latm = ((ptr_readbuff) + (dummy_length / LATM_BIT_OF_BYTE));
+  /* Top of the next LATM. */
 
-  return info.ptr_check_latm;
+  return ((ptr_readbuff) + (dummy_length / LATM_BIT_OF_BYTE));
 }
 
 #ifdef LATMTEST_BY_CUNIT
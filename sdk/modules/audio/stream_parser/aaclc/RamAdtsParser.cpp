@@ -40,6 +40,18 @@
 
 #include "common/RamAdtsParser.h"
 #include "common/RamAdtsParser_Common.h"
+#include "common/BitStreamReader.h"
+
+/* Header fields used by the parser. */
+
+struct adts_parser_header_s
+{
+  uint32_t syncword;
+  uint32_t profile;
+  uint32_t sampling_frequency_index;
+  uint32_t frame_length;
+};
+typedef struct adts_parser_header_s AdtsParserHeader;
 
 static uint8_t poll_buff[PARSER_LOCAL_POLL_BUFFERSIZE];
 
@@ -146,29 +158,73 @@ static int32_t adtsparser_peek_data(AdtsHandle *pHandle,
 }
 
 /*--------------------------------------------------------------------------*/
-static int32_t adtsparser_syncword_search(uint8_t *pReadData,
-                                          uint8_t *syncword_idx)
+static int32_t adtsparser_syncword_search(AdtsHandle *pHandle)
 {
-  for (int i = 0; i < 2; i++)
+  /* Peek a block of data from search_pos and search syncword in it.
+   * The last byte of the block is searched again with the next block,
+   * because the syncword may be across the blocks.
+   */
+
+  while (1)
     {
-      if (ADTS_CHECK_SYNCWORD(*(pReadData+(i)), *(pReadData+(i + 1))) ==
-           ADTS_OK)
+      size_t occupied_size =
+        CMN_SimpleFifoGetOccupiedSize(pHandle->pSimpleFifoHandler);
+      if (occupied_size < pHandle->search_pos + ADTS_CHECK_SYNCWORD_SIZE)
         {
-          /* Because it is conceivable that a coincident sync word matches,
-           * check the following data.
-           */
-
-          uint8_t consistency_check;
-          consistency_check = *(pReadData+(i + 1));
-          if (((consistency_check & 0x0F) == 1) ||
-               ((consistency_check & 0x0F) == 0))
-            {
-              *syncword_idx = i;
-              return AdtsParserNormal;
-            }
+          return AdtsParserConnotDataAccess;
+        }
+
+      uint32_t peek_size = occupied_size - pHandle->search_pos;
+      if (peek_size > ADTSPARSER_SYNCWORD_SEARCH_SIZE)
+        {
+          peek_size = ADTSPARSER_SYNCWORD_SEARCH_SIZE;
+        }
+
+      pHandle->current_pos = pHandle->search_pos;
+      int32_t rst = adtsparser_peek_data(pHandle, poll_buff, peek_size);
+      if (rst != AdtsParserNormal)
+        {
+          return rst;
         }
+
+      int32_t syncword_idx = BitStream_FindSync(poll_buff,
+                                                peek_size,
+                                                ADTSPARSER_SYNCWORD_16BIT,
+                                                ADTSPARSER_SYNCWORD_MASK);
+      if (syncword_idx >= 0)
+        {
+          pHandle->search_pos += syncword_idx;
+          return AdtsParserNormal;
+        }
+      pHandle->search_pos += (peek_size - 1);
     }
-  return AdtsParserCannotGetHeader;
+}
+
+/*--------------------------------------------------------------------------*/
+static void adtsparser_read_header(const uint8_t *pHeader,
+                                   AdtsParserHeader *pInfo)
+{
+  BitStreamReader reader;
+
+  BitStream_Init(&reader, pHeader, ADTS_HEADER_SIZE);
+
+  /* syncword(12), id(1), layer(2), protection_absent(1) */
+
+  pInfo->syncword = BitStream_Read(&reader, 12);
+  BitStream_Skip(&reader, 4);
+
+  /* profile(2), sampling_frequency_index(4), private_bit(1),
+   * channel_configuration(3), original_copy(1), home(1),
+   * copyright_identification_bit(1), copyright_identification_start(1)
+   */
+
+  pInfo->profile = BitStream_Read(&reader, 2);
+  pInfo->sampling_frequency_index = BitStream_Read(&reader, 4);
+  BitStream_Skip(&reader, 8);
+
+  /* frame_length(13) */
+
+  pInfo->frame_length = BitStream_Read(&reader, 13);
 }
 
 /*--------------------------------------------------------------------------*/
@@ -220,33 +276,14 @@ int32_t AdtsParser_ReadFrame(AdtsHandle *pHandle,
       size_t occupied_size = 0;
       pHandle->current_pos = 0;
       pHandle->search_pos  = 0;
-      while (1)
+      if (adtsparser_syncword_search(pHandle) != AdtsParserNormal)
         {
-          int32_t rst = adtsparser_peek_data(pHandle,
-                                             poll_buff,
-                                             ADTSPARSER_SYNCWORD_SEARCH_SIZE);
-          if (rst != AdtsParserNormal)
-            {
-              occupied_size =
-                CMN_SimpleFifoGetOccupiedSize(pHandle->pSimpleFifoHandler);
-              pHandle->parse_size = occupied_size;
-              adtsparser_skip_data(pHandle, poll_buff);
-              *uipErrDetail = AdtsParserConnotDataAccess;
-              return rc;
-            }
-          pHandle->search_pos++;
-          pHandle->current_pos = pHandle->search_pos;
-
-          uint8_t syncword_idx;
-          if (adtsparser_syncword_search(poll_buff, &syncword_idx) ==
-               AdtsParserNormal)
-            {
-              if (syncword_idx == 0)
-                {
-                  pHandle->search_pos = (pHandle->search_pos - 1);
-                }
-              break;
-            }
+          occupied_size =
+            CMN_SimpleFifoGetOccupiedSize(pHandle->pSimpleFifoHandler);
+          pHandle->parse_size = occupied_size;
+          adtsparser_skip_data(pHandle, poll_buff);
+          *uipErrDetail = AdtsParserConnotDataAccess;
+          return rc;
         }
       if (pHandle->search_pos != 0)
         {
@@ -275,30 +312,30 @@ int32_t AdtsParser_ReadFrame(AdtsHandle *pHandle,
 
       /* Check syncword. */
 
-      if (ADTS_CHECK_SYNCWORD(*poll_buff, *(poll_buff + 1)) == ADTS_OK)
+      AdtsParserHeader header;
+      adtsparser_read_header(poll_buff, &header);
+
+      if (header.syncword == ADTS_SYNCWORD)
         {
           *uipErrDetail = AdtsParserAbnormalHeader;
 
           /* Checking the profile. */
 
-          if ((*(poll_buff + 2) & ADTS_MASK_PROFILE) != ADTS_PROFILE_AACLC)
+          if (header.profile != ADTS_PROFILE_ID_AACLC)
             {
               *usResult |= HDR_PROFILE_NG;
             }
 
           /* Check sampling rate. */
 
-          if (ADTS_GET_SAMPLING_RATE(*(poll_buff + 2)) == 0)
+          if (AdtsSamplingFrequency[header.sampling_frequency_index] == 0)
             {
               *usResult |= HDR_SAMLERATE_NG;
             }
 
           /* Extract frame size.(including header) */
 
-          uint32_t frame_size =
-            ADTS_GET_FRAMELENGTH(*(poll_buff + 3),
-                                 *(poll_buff + 4),
-                                 *(poll_buff + 5));
+          uint32_t frame_size = header.frame_length;
 
           if (frame_size <= *pSize)
             {
@@ -382,26 +419,10 @@ int32_t AdtsParser_GetSamplingRate(AdtsHandle *pHandle,
     {
       pHandle->current_pos = 0;
       pHandle->search_pos  = 0;
-      while (1)
+      if (adtsparser_syncword_search(pHandle) != AdtsParserNormal)
         {
-          if (adtsparser_peek_data(pHandle, poll_buff, 3) != AdtsParserNormal)
-            {
-              *uipErrDetail = AdtsParserConnotDataAccess;
-              return rc;
-            }
-          pHandle->search_pos++;
-          pHandle->current_pos = pHandle->search_pos;
-
-          uint8_t syncword_idx;
-          if (adtsparser_syncword_search(poll_buff, &syncword_idx) ==
-               AdtsParserNormal)
-            {
-              if (syncword_idx == 0)
-                {
-                  pHandle->search_pos = (pHandle->search_pos - 1);
-                }
-              break;
-            }
+          *uipErrDetail = AdtsParserConnotDataAccess;
+          return rc;
         }
 
       /* Read header information. */
@@ -416,9 +437,13 @@ int32_t AdtsParser_GetSamplingRate(AdtsHandle *pHandle,
 
       /* Check syncword. */
 
-      if (ADTS_CHECK_SYNCWORD(*poll_buff, *(poll_buff + 1)) == ADTS_OK)
+      AdtsParserHeader header;
+      adtsparser_read_header(poll_buff, &header);
+
+      if (header.syncword == ADTS_SYNCWORD)
         {
-          *pSmplingRate = ADTS_GET_SAMPLING_RATE(*(poll_buff + 2));
+          *pSmplingRate =
+            AdtsSamplingFrequency[header.sampling_frequency_index];
           *uipErrDetail = AdtsParserNormal;
           rc = ADTS_OK;
         }
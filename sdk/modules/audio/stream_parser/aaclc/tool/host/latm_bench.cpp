@@ -0,0 +1,728 @@
+/****************************************************************************
+ * modules/audio/stream_parser/aaclc/tool/host/latm_bench.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test and benchmark of the LATM and ADTS parsers.
+ *
+ * LATM: AudioMuxElements of many kinds (new/same StreamMuxConfig,
+ * escaped sampling frequency, core coder delay, explicit SBR/PS
+ * signaling, fixed frame length, otherData, CRC, audioMuxVersion 1)
+ * are made, and the results of AACLC_getNextLatm() are checked against
+ * the former parser (latm_reference.cpp) and the values written.
+ * Random data is also given to both parsers and the results must be
+ * the same. Then frames/second of both on a long stream are measured.
+ *
+ * ADTS: Frames with garbage between them are put into a SimpleFifo
+ * by pieces, and the frames taken by AdtsParser_ReadFrame() are
+ * checked against the frames written.
+ *
+ * "latm_bench -t" runs only the test.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <vector>
+
+#include "common/LatmAacLc.h"
+#include "common/RamAdtsParser.h"
+#include "common/BitStreamReader.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TEST_FRAME_NUM   2000
+#define RANDOM_NUM       20000
+#define BENCH_FRAME_NUM  20000
+#define BENCH_LOOP       20
+#define ADTS_FRAME_NUM   3000
+
+/* Margin after the frame, because the former parser reads without
+ * knowing the size of the data.
+ */
+
+#define READ_MARGIN      (64 * 1024)
+
+#define CHECK(cond) \
+  do \
+    { \
+      if (!(cond)) \
+        { \
+          printf("  NG: %s (line %d)\n", #cond, __LINE__); \
+          return 1; \
+        } \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+class BitWriter
+{
+public:
+  BitWriter() : m_bits(0) {}
+
+  void put(uint32_t value, uint32_t length)
+  {
+    for (int32_t i = length - 1; i >= 0; i--)
+      {
+        if ((m_bits % 8) == 0)
+          {
+            m_data.push_back(0);
+          }
+        if ((value >> i) & 1)
+          {
+            m_data.back() |= (0x80 >> (m_bits % 8));
+          }
+        m_bits++;
+      }
+  }
+
+  void align(void)
+  {
+    m_bits = m_data.size() * 8;
+  }
+
+  uint32_t bits(void) const
+  {
+    return m_bits;
+  }
+
+  std::vector<uint8_t> &data(void)
+  {
+    return m_data;
+  }
+
+private:
+  std::vector<uint8_t> m_data;
+  uint32_t m_bits;
+};
+
+struct LatmFrame
+{
+  std::vector<uint8_t> data;
+  bool     new_config;
+  uint32_t config_length;  /* 0: config_length_flag is not set */
+  uint32_t payload_offset; /* [bit] */
+  uint32_t payload_size;   /* [byte] */
+  uint32_t ch;
+  uint32_t fs_index;
+};
+
+/****************************************************************************
+ * External Function Prototypes
+ ****************************************************************************/
+
+uint8_t *AACLC_getNextLatmRef(uint8_t *ptr_readbuff,
+                              InfoStreamMuxConfig *ptr_stream_mux_config);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint32_t s_seed = 1;
+
+/* Kind and channels of the last StreamMuxConfig made. */
+
+static uint32_t s_last_kind = 0;
+static uint32_t s_last_ch = 0;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t rand32(void)
+{
+  s_seed = s_seed * 1103515245 + 12345;
+  return (s_seed >> 8);
+}
+
+/*--------------------------------------------------------------------------*/
+static void make_latm(uint32_t kind, LatmFrame *frame)
+{
+  BitWriter w;
+
+  /* Kind 0 uses the last StreamMuxConfig (useSameStreamMux = 1).
+   * Use it only after the config of variable frame length without
+   * otherData, because the frame has to follow the config.
+   */
+
+  if (kind == 0 &&
+      s_last_kind != 2 && s_last_kind != 3 && s_last_kind != 5)
+    {
+      kind = 3;
+    }
+
+  uint32_t mux_version = (kind == 7) ? 1 : 0;
+  uint32_t fixed_length = (kind == 6);
+  uint32_t other_data = (kind % 3 == 1) ? (rand32() % 40) + 1 : 0;
+  uint32_t crc = (kind % 4 == 2);
+
+  frame->new_config = (kind != 0);
+  frame->config_length = 0;
+  frame->ch = (kind == 0) ? s_last_ch : (rand32() % 2) + 1;
+  frame->fs_index = 3 + (rand32() % 4);
+  frame->payload_size = fixed_length ? 20 + (rand32() % 200)
+                                     : (rand32() % 700) + 1;
+
+  /* useSameStreamMux */
+
+  w.put(frame->new_config ? 0 : 1, 1);
+
+  if (frame->new_config)
+    {
+      s_last_kind = kind;
+      s_last_ch = frame->ch;
+
+      /* StreamMuxConfig */
+
+      w.put(mux_version, 1);
+      if (mux_version)
+        {
+          w.put(0, 1);  /* audioMuxVersionA */
+          w.put(0, 2);  /* taraBufferFullness: bytesForValue */
+          w.put(0xff, 8);
+        }
+      w.put(1, 1);      /* allStreamsSameTimeFraming */
+      w.put(0, 6);      /* numSubFrames */
+      w.put(0, 4);      /* numProgram */
+      w.put(0, 3);      /* numLayer */
+
+      BitWriter asc;
+      if (kind == 4)
+        {
+          /* Explicit SBR */
+
+          asc.put(5, 5);
+          asc.put(frame->fs_index + 3, 4);
+          asc.put(frame->ch, 4);
+          asc.put(0xf, 4);  /* extensionSamplingFrequencyIndex (esc) */
+          asc.put(48000, 24);
+          asc.put(2, 5);
+        }
+      else
+        {
+          asc.put(2, 5);
+          if (kind == 3)
+            {
+              asc.put(0xf, 4);
+              asc.put(44100 + rand32() % 4000, 24);
+            }
+          else
+            {
+              asc.put(frame->fs_index, 4);
+            }
+          asc.put(frame->ch, 4);
+        }
+
+      /* GASpecificConfig */
+
+      asc.put(0, 1);    /* frameLengthFlag */
+      if (kind == 2 || kind == 5)
+        {
+          asc.put(1, 1);
+          asc.put(rand32() & 0x3fff, 14);
+        }
+      else
+        {
+          asc.put(0, 1);
+        }
+      asc.put(0, 1);    /* extensionFlag */
+
+      if (kind == 5)
+        {
+          /* Backward compatible SBR/PS signaling.
+           * It is read only when config_length is given.
+           */
+
+          asc.put(0x2b7, 11);
+          asc.put(5, 5);
+          asc.put(1, 1);
+          asc.put(frame->fs_index - 3, 4);
+          asc.put(0x548, 11);
+          asc.put(1, 1);
+          frame->config_length = asc.bits();
+        }
+
+      if (mux_version)
+        {
+          /* ascLen */
+
+          w.put(0, 2);
+          w.put(asc.bits(), 8);
+        }
+      for (uint32_t i = 0; i < asc.bits(); i++)
+        {
+          w.put((asc.data()[i / 8] >> (7 - (i % 8))) & 1, 1);
+        }
+
+      if (fixed_length)
+        {
+          w.put(1, 3);  /* frameLengthType */
+          w.put(frame->payload_size - 20, 9);
+        }
+      else
+        {
+          w.put(0, 3);
+          w.put(0xff, 8);  /* latmBufferFullness */
+        }
+
+      w.put(other_data ? 1 : 0, 1);
+      if (other_data)
+        {
+          if (mux_version)
+            {
+              w.put(0, 2);
+              w.put(other_data, 8);
+            }
+          else
+            {
+              w.put(0, 1);  /* otherDataLenEsc */
+              w.put(other_data, 8);
+            }
+        }
+
+      w.put(crc, 1);
+      if (crc)
+        {
+          w.put(rand32() & 0xff, 8);
+        }
+    }
+
+  /* PayloadLengthInfo */
+
+  if (!fixed_length)
+    {
+      uint32_t rest = frame->payload_size;
+      while (rest >= 255)
+        {
+          w.put(255, 8);
+          rest -= 255;
+        }
+      w.put(rest, 8);
+    }
+
+  /* PayloadMux */
+
+  frame->payload_offset = w.bits();
+  for (uint32_t i = 0; i < frame->payload_size; i++)
+    {
+      w.put(rand32() & 0xff, 8);
+    }
+
+  for (uint32_t i = 0; i < other_data; i++)
+    {
+      w.put(rand32() & 1, 1);
+    }
+  w.align();
+
+  frame->data = w.data();
+}
+
+/*--------------------------------------------------------------------------*/
+static int parse_both(std::vector<uint8_t> &buf,
+                      uint32_t size,
+                      InfoStreamMuxConfig *cfg,
+                      InfoStreamMuxConfig *ref_cfg,
+                      uint32_t *next)
+{
+  uint8_t *top = &buf[0];
+  uint8_t *rtn = AACLC_getNextLatm(top, size, cfg);
+  uint8_t *ref = AACLC_getNextLatmRef(top, ref_cfg);
+
+  if (ref == top + 2 && rtn != top + 2)
+    {
+      /* The former parser matched the LOAS syncword not on a byte
+       * boundary. It is not a LOAS frame, skip the comparison.
+       */
+
+      memcpy(cfg, ref_cfg, sizeof(InfoStreamMuxConfig));
+      return 2;
+    }
+
+  CHECK(rtn == ref);
+  CHECK(memcmp(cfg, ref_cfg, sizeof(InfoStreamMuxConfig)) == 0);
+
+  *next = rtn ? (uint32_t)(rtn - top) : 0;
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_bit_reader(void)
+{
+  printf("BitStreamReader\n");
+
+  std::vector<uint8_t> buf(37);
+  for (uint32_t i = 0; i < buf.size(); i++)
+    {
+      buf[i] = rand32() & 0xff;
+    }
+
+  for (uint32_t loop = 0; loop < 1000; loop++)
+    {
+      BitStreamReader reader;
+      uint32_t pos = 0;
+
+      BitStream_Init(&reader, &buf[0], buf.size());
+      while (pos < buf.size() * 8 + 40)
+        {
+          uint32_t len = (rand32() % 32) + 1;
+          uint32_t expect = 0;
+
+          for (uint32_t i = pos; i < pos + len; i++)
+            {
+              uint32_t bit = (i / 8 < buf.size()) ?
+                               (buf[i / 8] >> (7 - (i % 8))) & 1 : 0;
+              expect = (expect << 1) | bit;
+            }
+
+          if (rand32() % 4 == 0)
+            {
+              BitStream_Skip(&reader, len);
+            }
+          else
+            {
+              CHECK(BitStream_Read(&reader, len) == expect);
+            }
+          pos += len;
+          CHECK(BitStream_GetPosition(&reader) == pos);
+        }
+    }
+
+  static const uint8_t sync[] = { 0x12, 0xff, 0x34, 0xff, 0xf1, 0x56, 0xe8 };
+  CHECK(BitStream_FindSync(sync, sizeof(sync), 0xfff0, 0xfffe) == 3);
+  CHECK(BitStream_FindSync(sync, 4, 0xfff0, 0xfffe) == -1);
+  CHECK(BitStream_FindSync(sync, sizeof(sync), 0x56e0, 0xffe0) == 5);
+  CHECK(BitStream_FindSync(sync, 1, 0x1200, 0xff00) == -1);
+
+  printf("  OK\n");
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_latm(void)
+{
+  InfoStreamMuxConfig cfg;
+  InfoStreamMuxConfig ref_cfg;
+  uint32_t skipped = 0;
+
+  printf("LATM conformance (%d frames)\n", TEST_FRAME_NUM);
+
+  memset(&cfg, 0, sizeof(cfg));
+  memset(&ref_cfg, 0, sizeof(ref_cfg));
+
+  for (uint32_t n = 0; n < TEST_FRAME_NUM; n++)
+    {
+      LatmFrame frame;
+      uint32_t next = 0;
+
+      /* The 1st frame must have StreamMuxConfig. */
+
+      make_latm(n ? (rand32() % 8) : 1, &frame);
+
+      std::vector<uint8_t> buf(frame.data);
+      uint32_t size = buf.size();
+      buf.resize(size + READ_MARGIN, 0);
+
+      for (uint32_t i = 0; i < LATM_MAX_STREAM_ARRAY; i++)
+        {
+          cfg.info_stream_id[i].asc.config_length_flag =
+            frame.config_length ? LATM_ENABLE_CONFIG_LENGTH : 0;
+          cfg.info_stream_id[i].asc.config_length = frame.config_length;
+        }
+      memcpy(&ref_cfg, &cfg, sizeof(cfg));
+
+      int rst = parse_both(buf, size, &cfg, &ref_cfg, &next);
+      CHECK(rst == 0);
+
+      /* Check with the values written.
+       * (With variable frame length, the payload is skipped by
+       *  frame_length bits, so the next frame is only checked with
+       *  fixed frame length.)
+       */
+
+      CHECK(cfg.info_stream_frame[0].payload_offset ==
+            frame.payload_offset);
+      if (cfg.info_stream_frame[0].frame_length_type == 0)
+        {
+          CHECK(cfg.info_stream_frame[0].frame_length ==
+                frame.payload_size);
+        }
+      else
+        {
+          CHECK(cfg.info_stream_frame[0].frame_length + 20 ==
+                frame.payload_size);
+          CHECK(next == size);
+        }
+      CHECK(cfg.info_stream_id[0].asc.channel_configuration == frame.ch);
+    }
+
+  printf("  OK\n");
+
+  printf("LOAS\n");
+
+  std::vector<uint8_t> loas(READ_MARGIN, 0);
+  loas[0] = 0x56;
+  loas[1] = 0xe0 | 0x01;
+  loas[2] = 0x23;
+  memset(&cfg, 0, sizeof(cfg));
+  CHECK(AACLC_getNextLatm(&loas[0], 3, &cfg) == &loas[2]);
+  CHECK(AACLC_getNextLatmRef(&loas[0], &cfg) == &loas[2]);
+
+  printf("  OK\n");
+
+  printf("Random data (%d)\n", RANDOM_NUM);
+
+  for (uint32_t n = 0; n < RANDOM_NUM; n++)
+    {
+      std::vector<uint8_t> buf(READ_MARGIN, 0);
+      uint32_t size = (rand32() % 512) + 1;
+      uint32_t next = 0;
+
+      for (uint32_t i = 0; i < size; i++)
+        {
+          buf[i] = rand32() & 0xff;
+        }
+
+      /* Use the whole buffer as the size, so that both read the
+       * same data after the random part.
+       */
+
+      memset(&cfg, 0, sizeof(cfg));
+      memset(&ref_cfg, 0, sizeof(ref_cfg));
+      int rst = parse_both(buf, buf.size(), &cfg, &ref_cfg, &next);
+      CHECK(rst == 0 || rst == 2);
+      if (rst == 2)
+        {
+          skipped++;
+        }
+    }
+
+  printf("  OK (%u unaligned LOAS syncword skipped)\n", skipped);
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_adts(void)
+{
+  static uint8_t fifo_buf[4096];
+  static int8_t frame_buf[PARSER_LOCAL_POLL_BUFFERSIZE * 2];
+  CMN_SimpleFifoHandle fifo;
+  AdtsHandle handle;
+  AdtsParserErrorDetail err;
+  std::vector<uint8_t> stream;
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> lengths;
+
+  printf("ADTS (%d frames)\n", ADTS_FRAME_NUM);
+
+  /* Frames with garbage between them. */
+
+  for (uint32_t n = 0; n < ADTS_FRAME_NUM; n++)
+    {
+      uint32_t garbage = (n % 5 == 0) ? rand32() % 100 : 0;
+      for (uint32_t i = 0; i < garbage; i++)
+        {
+          /* 0xff without a following syncword is also put. */
+
+          stream.push_back((i % 7 == 0) ? 0xff : rand32() & 0x7f);
+        }
+
+      uint32_t frame_length = 7 + (rand32() % 900);
+      uint32_t fs_index = 3 + (n % 5);
+      BitWriter w;
+
+      w.put(0xfff, 12);
+      w.put(0, 1);
+      w.put(0, 2);
+      w.put(1, 1);
+      w.put(1, 2);        /* profile: AAC-LC */
+      w.put(fs_index, 4);
+      w.put(0, 1);
+      w.put(2, 3);
+      w.put(0, 4);
+      w.put(frame_length, 13);
+      w.put(0x7ff, 11);
+      w.put(0, 2);
+      for (uint32_t i = 7; i < frame_length; i++)
+        {
+          w.put(rand32() & 0x7f, 8);
+        }
+
+      offsets.push_back(stream.size());
+      lengths.push_back(frame_length);
+      stream.insert(stream.end(), w.data().begin(), w.data().end());
+    }
+
+  CHECK(CMN_SimpleFifoInitialize(&fifo, fifo_buf, sizeof(fifo_buf), NULL)
+          == 0);
+  CHECK(AdtsParser_Initialize(&handle, &fifo, &err) == ADTS_OK);
+
+  uint32_t written = 0;
+  uint32_t frame_no = 0;
+
+  while (frame_no < ADTS_FRAME_NUM)
+    {
+      /* Put data by random pieces and read while 2 frames are there. */
+
+      while (written < stream.size() &&
+             CMN_SimpleFifoGetOccupiedSize(&fifo) <
+               PARSER_LOCAL_POLL_BUFFERSIZE * 2)
+        {
+          uint32_t piece = (rand32() % 300) + 1;
+          if (piece > stream.size() - written)
+            {
+              piece = stream.size() - written;
+            }
+          if (piece > CMN_SimpleFifoGetVacantSize(&fifo))
+            {
+              break;
+            }
+          CMN_SimpleFifoOffer(&fifo, &stream[written], piece);
+          written += piece;
+        }
+
+      if (frame_no == 0)
+        {
+          uint32_t fs = 0;
+          CHECK(AdtsParser_GetSamplingRate(&handle, &fs, &err) == ADTS_OK);
+          CHECK(fs == 48000);
+        }
+
+      uint32_t size = sizeof(frame_buf);
+      uint16_t result = 0;
+      CHECK(AdtsParser_ReadFrame(&handle, frame_buf, &size, &result, &err)
+              == ADTS_OK);
+      CHECK(result == HDR_OK);
+
+      uint32_t offset = offsets[frame_no];
+
+      CHECK(size == lengths[frame_no]);
+      CHECK(memcmp(frame_buf, &stream[offset], size) == 0);
+      frame_no++;
+    }
+
+  CHECK(CMN_SimpleFifoGetOccupiedSize(&fifo) == 0);
+
+  printf("  OK\n");
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static double now_sec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*--------------------------------------------------------------------------*/
+static void bench_latm(void)
+{
+  std::vector<uint8_t> stream;
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> sizes;
+  static InfoStreamMuxConfig cfg;
+
+  /* Every frame has StreamMuxConfig, as A2DP does. */
+
+  for (uint32_t n = 0; n < BENCH_FRAME_NUM; n++)
+    {
+      LatmFrame frame;
+      make_latm(1 + (rand32() % 6), &frame);
+      offsets.push_back(stream.size());
+      sizes.push_back(frame.data.size());
+      stream.insert(stream.end(), frame.data.begin(), frame.data.end());
+    }
+  stream.resize(stream.size() + READ_MARGIN, 0);
+
+  printf("LATM parse: %d frames x %d\n", BENCH_FRAME_NUM, BENCH_LOOP);
+
+  double start = now_sec();
+  uint32_t check = 0;
+  for (uint32_t loop = 0; loop < BENCH_LOOP; loop++)
+    {
+      for (uint32_t n = 0; n < BENCH_FRAME_NUM; n++)
+        {
+          memset(&cfg, 0, sizeof(cfg));
+          uint8_t *top = &stream[offsets[n]];
+          check += AACLC_getNextLatmRef(top, &cfg) - top;
+        }
+    }
+  double ref_time = now_sec() - start;
+
+  start = now_sec();
+  for (uint32_t loop = 0; loop < BENCH_LOOP; loop++)
+    {
+      for (uint32_t n = 0; n < BENCH_FRAME_NUM; n++)
+        {
+          memset(&cfg, 0, sizeof(cfg));
+          uint8_t *top = &stream[offsets[n]];
+          check -= AACLC_getNextLatm(top, sizes[n], &cfg) - top;
+        }
+    }
+  double new_time = now_sec() - start;
+
+  double frames = (double)BENCH_FRAME_NUM * BENCH_LOOP;
+  printf("  byte reader (former) : %10.0f frames/s\n", frames / ref_time);
+  printf("  bit stream reader    : %10.0f frames/s (x%.2f)%s\n",
+         frames / new_time, ref_time / new_time,
+         check ? "  NG: result differs" : "");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  bool test_only = (argc > 1 && strcmp(argv[1], "-t") == 0);
+
+  if (test_bit_reader() || test_latm() || test_adts())
+    {
+      return 1;
+    }
+
+  if (!test_only)
+    {
+      bench_latm();
+    }
+
+  return 0;
+}
@@ -0,0 +1,760 @@
+/****************************************************************************
+ * modules/audio/stream_parser/mp3/mp3_frame_index.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "audio/utilities/mp3_frame_index.h"
+#include "common/Mp3Parser.h"
+
+/*--------------------------------------------------------------------------*/
+
+#define INDEX_FILE_MAGIC      0x5849464d  /* "MFIX" */
+#define INDEX_FILE_VERSION    1
+#define INDEX_FILE_EXT        ".mfi"
+
+/* Upper limit of search range for a frame header when the data is
+ * broken or an offset of TOC is in the middle of a frame.
+ */
+
+#define FRAME_SEARCH_MAX      (16 * 1024)
+
+/* Xing/Info tag */
+
+#define XING_FLAG_FRAMES      0x01
+#define XING_FLAG_BYTES       0x02
+#define XING_FLAG_TOC         0x04
+#define XING_TOC_NUM          100
+
+/* VBRI tag (Always 32 bytes after the frame header) */
+
+#define VBRI_TAG_OFFSET       (MP3PARSER_HEADSIZE + 32)
+#define VBRI_HEADER_SIZE      26
+
+#define MODE_MONO             3
+
+#define GET_BE16(p)  (((uint32_t)(p)[0] << 8) | (uint32_t)(p)[1])
+#define GET_BE32(p)  (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | \
+                      ((uint32_t)(p)[2] << 8) | (uint32_t)(p)[3])
+
+/*--------------------------------------------------------------------------*/
+static uint32_t samples_to_ms(uint64_t samples, uint32_t sampling_rate)
+{
+  return (uint32_t)(samples * 1000 / sampling_rate);
+}
+
+/*--------------------------------------------------------------------------*/
+bool Mp3FrameIndex::open(const char *file_path, bool save_index)
+{
+  close();
+
+  if (file_path == NULL)
+    {
+      return false;
+    }
+
+  struct stat file_stat;
+  if (stat(file_path, &file_stat) != 0)
+    {
+      return false;
+    }
+
+  m_fp = fopen(file_path, "rb");
+  if (m_fp == NULL)
+    {
+      return false;
+    }
+
+  m_data_end = file_stat.st_size;
+
+  /* Skip ID3v2 tag at the top, and ID3v1 tag at the end. */
+
+  uint8_t tag[Mp3ParserID3v2HeaderLength];
+
+  if (readAt(0, tag, Mp3ParserID3v2HeaderLength) &&
+      tag[Mp3ParserID3v2HeadIndexID1] == MP3PARSER_ID3V2_ID1 &&
+      tag[Mp3ParserID3v2HeadIndexID2] == MP3PARSER_ID3V2_ID2 &&
+      tag[Mp3ParserID3v2HeadIndexID3] == MP3PARSER_ID3V2_ID3)
+    {
+      m_data_offset =
+        MP3PARSER_ID3v2_GET_LENGTH(tag[Mp3ParserID3v2HeadIndexLen1],
+                                   tag[Mp3ParserID3v2HeadIndexLen2],
+                                   tag[Mp3ParserID3v2HeadIndexLen3],
+                                   tag[Mp3ParserID3v2HeadIndexLen4]) +
+        Mp3ParserID3v2HeaderLength;
+
+      /* Footer is there. */
+
+      if (tag[Mp3ParserID3v2HeadIndexFlag] & 0x10)
+        {
+          m_data_offset += Mp3ParserID3v2HeaderLength;
+        }
+    }
+
+  if (m_data_end >= MP3PARSER_ID3v1_FIXED_LENGTH &&
+      readAt(m_data_end - MP3PARSER_ID3v1_FIXED_LENGTH, tag, 3) &&
+      tag[Mp3ParserID3v1HeadIndexID1] == MP3PARSER_ID3V1_ID1 &&
+      tag[Mp3ParserID3v1HeadIndexID2] == MP3PARSER_ID3V1_ID2 &&
+      tag[Mp3ParserID3v1HeadIndexID3] == MP3PARSER_ID3V1_ID3)
+    {
+      m_data_end -= MP3PARSER_ID3v1_FIXED_LENGTH;
+    }
+
+  /* Use saved index if it is made from this file. The index is neither
+   * loaded nor saved when its path doesn't fit, so that a cut-off path
+   * never names the MP3 file itself.
+   */
+
+  char index_path[128];
+  int  index_len = snprintf(index_path, sizeof(index_path), "%s%s",
+                            file_path, INDEX_FILE_EXT);
+  bool use_index = (index_len > 0 &&
+                    index_len < static_cast<int>(sizeof(index_path)));
+
+  IndexFileHeader file_info;
+  memset(&file_info, 0, sizeof(file_info));
+  file_info.magic      = INDEX_FILE_MAGIC;
+  file_info.version    = INDEX_FILE_VERSION;
+  file_info.file_size  = file_stat.st_size;
+  file_info.file_mtime = file_stat.st_mtime;
+
+  if (use_index && load(index_path, file_info))
+    {
+      m_source = IndexSourceFile;
+      return true;
+    }
+
+  /* Find 1st frame. */
+
+  uint32_t  offset = m_data_offset;
+  FrameInfo info;
+
+  if (!findFrame(&offset, &info))
+    {
+      close();
+      return false;
+    }
+
+  m_sampling_rate = info.sampling_rate;
+  m_data_offset   = offset;
+
+  if (parseXing(offset, info))
+    {
+      m_source = IndexSourceXing;
+    }
+  else if (parseVbri(offset, info))
+    {
+      m_source = IndexSourceVbri;
+    }
+  else
+    {
+      /* Tag without TOC is not audio data. */
+
+      if (isInfoFrame(offset, info))
+        {
+          offset += info.size;
+        }
+
+      if (!scan(offset))
+        {
+          close();
+          return false;
+        }
+
+      m_source = IndexSourceScan;
+
+      if (save_index && use_index)
+        {
+          save(index_path, file_info);
+        }
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+void Mp3FrameIndex::close(void)
+{
+  if (m_fp != NULL)
+    {
+      fclose(m_fp);
+      m_fp = NULL;
+    }
+
+  m_source        = IndexSourceNone;
+  m_entry_num     = 0;
+  m_entry_frames  = 0;
+  m_frame_samples = 0;
+  m_duration      = 0;
+  m_sampling_rate = 0;
+  m_data_offset   = 0;
+  m_data_end      = 0;
+  m_cache_offset  = 0;
+  m_cache_size    = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+bool Mp3FrameIndex::getPosition(uint32_t time,
+                                uint32_t *offset,
+                                uint32_t *start)
+{
+  if (m_fp == NULL || m_entry_num == 0 || offset == NULL || start == NULL)
+    {
+      return false;
+    }
+
+  /* Start from the nearest entry. Entry n is the frame of
+   * (n * m_entry_frames).
+   */
+
+  uint64_t frame_no = (uint64_t)time * m_sampling_rate / 1000 /
+                      m_frame_samples;
+  uint32_t idx      = frame_no / m_entry_frames;
+  if (idx >= m_entry_num)
+    {
+      idx = m_entry_num - 1;
+    }
+
+  uint32_t pos     = m_entry[idx];
+  uint64_t samples = (uint64_t)idx * m_entry_frames * m_frame_samples;
+
+  /* Walk frame headers to the frame which includes the time.
+   * An entry of TOC may point in the middle of a frame, so the
+   * header is searched when it is not there.
+   */
+
+  FrameInfo info;
+
+  while (pos < m_data_end)
+    {
+      if (!readFrame(pos, &info) && !findFrame(&pos, &info))
+        {
+          break;
+        }
+
+      if (samples_to_ms(samples + info.samples, m_sampling_rate) > time)
+        {
+          break;
+        }
+
+      samples += info.samples;
+      pos     += info.size;
+    }
+
+  if (pos > m_data_end)
+    {
+      pos = m_data_end;
+    }
+
+  *offset = pos;
+  *start  = samples_to_ms(samples, m_sampling_rate);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+bool Mp3FrameIndex::readAt(uint32_t offset, uint8_t *buf, uint32_t size)
+{
+  /* Frame headers are read in order, so read through the cache. */
+
+  if (size <= CacheSize &&
+      (offset < m_cache_offset ||
+       offset + size > m_cache_offset + m_cache_size))
+    {
+      if (fseek(m_fp, offset, SEEK_SET) != 0)
+        {
+          return false;
+        }
+
+      m_cache_offset = offset;
+      m_cache_size   = fread(m_cache, 1, CacheSize, m_fp);
+    }
+
+  if (size <= CacheSize)
+    {
+      if (offset + size > m_cache_offset + m_cache_size)
+        {
+          return false;
+        }
+
+      memcpy(buf, &m_cache[offset - m_cache_offset], size);
+      return true;
+    }
+
+  if (fseek(m_fp, offset, SEEK_SET) != 0)
+    {
+      return false;
+    }
+
+  return (fread(buf, 1, size, m_fp) == size);
+}
+
+/*--------------------------------------------------------------------------*/
+bool Mp3FrameIndex::readFrame(uint32_t offset, FrameInfo *info)
+{
+  uint8_t head[MP3PARSER_HEADSIZE];
+
+  if (offset + MP3PARSER_HEADSIZE > m_data_end ||
+      !readAt(offset, head, MP3PARSER_HEADSIZE))
+    {
+      return false;
+    }
+
+  /* Same check as the stream parser. */
+
+  if ((head[0] & MP3PARSER_SYNCWORD_1) != MP3PARSER_SYNCWORD_1 ||
+      (head[1] & MP3PARSER_SYNCWORD_2) != MP3PARSER_SYNCWORD_2)
+    {
+      return false;
+    }
+
+  uint8_t id     = MP3PARSER_GET_ID(head[1]);
+  uint8_t layer  = MP3PARSER_GET_LAYER(head[1]);
+  uint8_t br_idx = MP3PARSER_GET_BR(head[2]);
+  uint8_t fs_idx = MP3PARSER_GET_FS(head[2]);
+
+  if (layer == Mp3ParserLayerReserved ||
+      fs_idx == MP3PARSER_FS_RESERVED ||
+      br_idx == MP3PARSER_BITRATE_FREE ||
+      br_idx == MP3PARSER_BITRATE_UNUSED ||
+      MP3PARSER_GET_EMPHAS(head[3]) == MP3PARSER_EMPHASIS_RESERVED)
+    {
+      return false;
+    }
+
+  info->size = MP3PARSER_CALC_FRAME_SIZE(id,
+                                         layer,
+                                         br_idx,
+                                         fs_idx,
+                                         MP3PARSER_GET_PADDING(head[2]));
+  info->id   = id;
+  info->mode = MP3PARSER_GET_MODE(head[3]);
+
+  if (id == Mp3ParserMpeg1)
+    {
+      info->samples       = mp3_parser_v1_num_samples_frame[layer];
+      info->sampling_rate = mp3_parser_v1_sampling_frequency[fs_idx];
+    }
+  else
+    {
+      info->samples       = mp3_parser_v2_num_samples_frame[layer];
+      info->sampling_rate = mp3_parser_v2_sampling_frequency[fs_idx];
+    }
+
+  /* Sampling rate must not change in the stream. */
+
+  if (m_sampling_rate != 0 && info->sampling_rate != m_sampling_rate)
+    {
+      return false;
+    }
+
+  return (info->size >= MP3PARSER_HEADSIZE);
+}
+
+/*--------------------------------------------------------------------------*/
+bool Mp3FrameIndex::findFrame(uint32_t *offset, FrameInfo *info)
+{
+  uint32_t limit = *offset + FRAME_SEARCH_MAX;
+  uint8_t  byte[2];
+
+  if (limit > m_data_end)
+    {
+      limit = m_data_end;
+    }
+
+  /* A header is accepted when the next frame follows, to skip
+   * fake syncwords in the data.
+   */
+
+  for (uint32_t pos = *offset; pos + MP3PARSER_HEADSIZE <= limit; pos++)
+    {
+      if (!readAt(pos, byte, 2))
+        {
+          return false;
+        }
+
+      if ((byte[0] & MP3PARSER_SYNCWORD_1) != MP3PARSER_SYNCWORD_1 ||
+          (byte[1] & MP3PARSER_SYNCWORD_2) != MP3PARSER_SYNCWORD_2 ||
+          !readFrame(pos, info))
+        {
+          continue;
+        }
+
+      FrameInfo next;
+      uint32_t  next_pos = pos + info->size;
+
+      if (next_pos + MP3PARSER_HEADSIZE > m_data_end ||
+          readFrame(next_pos, &next))
+        {
+          *offset = pos;
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/*--------------------------------------------------------------------------*/
+bool Mp3FrameIndex::isInfoFrame(uint32_t offset, const FrameInfo &info)
+{
+  uint32_t side_info;
+  uint8_t  tag[4];
+
+  if (info.id == Mp3ParserMpeg1)
+    {
+      side_info = (info.mode == MODE_MONO) ? 17 : 32;
+    }
+  else
+    {
+      side_info = (info.mode == MODE_MONO) ? 9 : 17;
+    }
+
+  if (readAt(offset + MP3PARSER_HEADSIZE + side_info, tag, sizeof(tag)) &&
+      (memcmp(tag, "Xing", 4) == 0 || memcmp(tag, "Info", 4) == 0))
+    {
+      return true;
+    }
+
+  if (readAt(offset + VBRI_TAG_OFFSET, tag, sizeof(tag)) &&
+      memcmp(tag, "VBRI", 4) == 0)
+    {
+      return true;
+    }
+
+  return false;
+}
+
+/*--------------------------------------------------------------------------*/
+bool Mp3FrameIndex::parseXing(uint32_t offset, const FrameInfo &info)
+{
+  uint32_t side_info;
+  uint8_t  tag[4 + 4 + 4 + 4 + XING_TOC_NUM];
+
+  if (info.id == Mp3ParserMpeg1)
+    {
+      side_info = (info.mode == MODE_MONO) ? 17 : 32;
+    }
+  else
+    {
+      side_info = (info.mode == MODE_MONO) ? 9 : 17;
+    }
+
+  if (!readAt(offset + MP3PARSER_HEADSIZE + side_info, tag, sizeof(tag)))
+    {
+      return false;
+    }
+
+  if (memcmp(tag, "Xing", 4) != 0 && memcmp(tag, "Info", 4) != 0)
+    {
+      return false;
+    }
+
+  uint32_t flags = GET_BE32(&tag[4]);
+  if (!(flags & XING_FLAG_FRAMES) || !(flags & XING_FLAG_TOC))
+    {
+      return false;
+    }
+
+  /* Optional fields are packed. */
+
+  const uint8_t *p = &tag[8];
+
+  uint32_t frames = GET_BE32(p);
+  p += 4;
+
+  uint32_t bytes = m_data_end - offset;
+  if (flags & XING_FLAG_BYTES)
+    {
+      if (GET_BE32(p) != 0 && GET_BE32(p) < bytes)
+        {
+          bytes = GET_BE32(p);
+        }
+      p += 4;
+    }
+
+  m_duration = samples_to_ms((uint64_t)frames * info.samples,
+                             info.sampling_rate);
+  if (frames < XING_TOC_NUM)
+    {
+      return false;
+    }
+
+  /* Entry i of TOC is the position of (i)% of the duration, in 1/256
+   * of the stream size from this frame. Entries of the index are put
+   * on every (frames / 100) frames, so interpolate TOC between.
+   */
+
+  m_frame_samples = info.samples;
+  m_entry_frames  = frames / XING_TOC_NUM;
+  m_entry_num     = XING_TOC_NUM;
+  m_entry[0]      = offset + info.size;
+
+  for (uint32_t i = 1; i < XING_TOC_NUM; i++)
+    {
+      uint64_t percent = (uint64_t)i * m_entry_frames * XING_TOC_NUM;
+      uint32_t toc_idx = percent / frames;
+      uint32_t frac    = percent % frames;
+      uint32_t next    = (toc_idx + 1 < XING_TOC_NUM) ?
+                         p[toc_idx + 1] : 256;
+      uint64_t toc     = (uint64_t)p[toc_idx] * frames;
+
+      if (next > p[toc_idx])
+        {
+          toc += (uint64_t)(next - p[toc_idx]) * frac;
+        }
+
+      uint32_t pos = offset + (uint32_t)(toc * bytes / 256 / frames);
+      m_entry[i] = (pos < m_entry[i - 1]) ? m_entry[i - 1] : pos;
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+bool Mp3FrameIndex::parseVbri(uint32_t offset, const FrameInfo &info)
+{
+  uint8_t header[VBRI_HEADER_SIZE];
+
+  if (!readAt(offset + VBRI_TAG_OFFSET, header, sizeof(header)) ||
+      memcmp(header, "VBRI", 4) != 0)
+    {
+      return false;
+    }
+
+  uint32_t frames           = GET_BE32(&header[14]);
+  uint32_t toc_num          = GET_BE16(&header[18]);
+  uint32_t toc_scale        = GET_BE16(&header[20]);
+  uint32_t entry_size       = GET_BE16(&header[22]);
+  uint32_t frames_per_entry = GET_BE16(&header[24]);
+
+  if (toc_num == 0 || entry_size == 0 || entry_size > 4 ||
+      frames_per_entry == 0)
+    {
+      return false;
+    }
+
+  m_duration = samples_to_ms((uint64_t)frames * info.samples,
+                             info.sampling_rate);
+
+  /* Entries of TOC are the sizes of every frames_per_entry frames.
+   * When TOC is bigger than the index, entries are thinned out.
+   */
+
+  m_frame_samples = info.samples;
+  m_entry_frames  = frames_per_entry;
+  m_entry_num     = 0;
+
+  uint32_t pos     = offset + info.size;
+  uint32_t toc_pos = offset + VBRI_TAG_OFFSET + VBRI_HEADER_SIZE;
+
+  addEntry(pos, 0);
+
+  for (uint32_t i = 0; i < toc_num; i++)
+    {
+      uint8_t  entry[4];
+      uint32_t size = 0;
+
+      if (!readAt(toc_pos + i * entry_size, entry, entry_size))
+        {
+          return false;
+        }
+
+      for (uint32_t j = 0; j < entry_size; j++)
+        {
+          size = (size << 8) | entry[j];
+        }
+
+      pos += size * toc_scale;
+      if (pos >= m_data_end)
+        {
+          break;
+        }
+
+      addEntry(pos, (i + 1) * frames_per_entry);
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+bool Mp3FrameIndex::scan(uint32_t offset)
+{
+  uint32_t  frame_no = 0;
+  uint32_t  pos = offset;
+  FrameInfo info;
+
+  if (!readFrame(pos, &info) && !findFrame(&pos, &info))
+    {
+      return false;
+    }
+
+  /* Samples per frame is fixed in a stream. */
+
+  m_frame_samples = info.samples;
+  m_entry_frames  = (uint64_t)DefaultEntryTime * m_sampling_rate / 1000 /
+                    m_frame_samples;
+  m_entry_frames  = (m_entry_frames == 0) ? 1 : m_entry_frames;
+  m_entry_num     = 0;
+
+  while (pos < m_data_end)
+    {
+      if (!readFrame(pos, &info))
+        {
+          /* Broken data. Resync to the next frame. */
+
+          if (!findFrame(&pos, &info))
+            {
+              break;
+            }
+        }
+
+      addEntry(pos, frame_no);
+
+      frame_no++;
+      pos += info.size;
+    }
+
+  m_duration = samples_to_ms((uint64_t)frame_no * m_frame_samples,
+                             m_sampling_rate);
+
+  return (m_entry_num > 0);
+}
+
+/*--------------------------------------------------------------------------*/
+void Mp3FrameIndex::addEntry(uint32_t offset, uint32_t frame_no)
+{
+  /* Entry n is the frame of (n * m_entry_frames). */
+
+  if (frame_no != m_entry_num * m_entry_frames)
+    {
+      return;
+    }
+
+  if (m_entry_num == MaxEntryNum)
+    {
+      /* Full. Keep even entries and double the interval. */
+
+      for (uint32_t i = 0; i < MaxEntryNum / 2; i++)
+        {
+          m_entry[i] = m_entry[i * 2];
+        }
+
+      m_entry_num     = MaxEntryNum / 2;
+      m_entry_frames *= 2;
+
+      if (frame_no != m_entry_num * m_entry_frames)
+        {
+          return;
+        }
+    }
+
+  m_entry[m_entry_num++] = offset;
+}
+
+/*--------------------------------------------------------------------------*/
+bool Mp3FrameIndex::load(const char *index_path,
+                         const IndexFileHeader &file_info)
+{
+  FILE *fp = fopen(index_path, "rb");
+  if (fp == NULL)
+    {
+      return false;
+    }
+
+  IndexFileHeader header;
+  bool ret = false;
+
+  if (fread(&header, sizeof(header), 1, fp) == 1 &&
+      header.magic == file_info.magic &&
+      header.version == file_info.version &&
+      header.file_size == file_info.file_size &&
+      header.file_mtime == file_info.file_mtime &&
+      header.entry_num > 0 &&
+      header.entry_num <= MaxEntryNum &&
+      header.entry_frames > 0 &&
+      header.frame_samples > 0 &&
+      header.sampling_rate > 0 &&
+      fread(m_entry, sizeof(uint32_t), header.entry_num, fp) ==
+        header.entry_num)
+    {
+      m_entry_num     = header.entry_num;
+      m_entry_frames  = header.entry_frames;
+      m_frame_samples = header.frame_samples;
+      m_duration      = header.duration;
+      m_sampling_rate = header.sampling_rate;
+      m_data_offset   = header.data_offset;
+      m_data_end      = header.data_end;
+      ret = true;
+    }
+
+  fclose(fp);
+
+  return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+void Mp3FrameIndex::save(const char *index_path,
+                         const IndexFileHeader &file_info)
+{
+  /* The index is only a cache. Failure (e.g. read only media) is not
+   * an error.
+   */
+
+  FILE *fp = fopen(index_path, "wb");
+  if (fp == NULL)
+    {
+      return;
+    }
+
+  IndexFileHeader header = file_info;
+
+  header.entry_num     = m_entry_num;
+  header.entry_frames  = m_entry_frames;
+  header.frame_samples = m_frame_samples;
+  header.duration      = m_duration;
+  header.sampling_rate = m_sampling_rate;
+  header.data_offset   = m_data_offset;
+  header.data_end      = m_data_end;
+
+  bool ret = (fwrite(&header, sizeof(header), 1, fp) == 1) &&
+             (fwrite(m_entry, sizeof(uint32_t), m_entry_num, fp) ==
+                m_entry_num);
+
+  if (fclose(fp) != 0 || !ret)
+    {
+      remove(index_path);
+    }
+}
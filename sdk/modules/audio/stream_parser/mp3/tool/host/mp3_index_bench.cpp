@@ -0,0 +1,709 @@
+/****************************************************************************
+ * modules/audio/stream_parser/mp3/tool/host/mp3_index_bench.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test and benchmark of Mp3FrameIndex.
+ *
+ * MP3 files of dummy frames (VBR, with ID3 tags, with Xing or VBRI
+ * TOC, with broken data, MPEG2 mono) are made in a temporary directory
+ * under $TMPDIR (or /tmp), which is removed at exit, and the position
+ * of many times are checked against the
+ * frame list made at the same time. Files whose index path doesn't fit
+ * in PATH_SIZE are checked to be left as they are, without index files
+ * of cut-off names. Then the time to find the
+ * position near the end of a long file is measured, with the former
+ * way (walk all frame headers from the top) as reference.
+ * "mp3_index_bench -t" runs only the test.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "audio/utilities/mp3_frame_index.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WORK_DIR    "mp3_index_XXXXXX"
+#define TEST_NAME   "mp3_index_test.mp3"
+#define BENCH_NAME  "mp3_index_bench.mp3"
+#define PATH_SIZE   128     /* Size of index path in Mp3FrameIndex */
+
+#define TEST_TIME   (10 * 60 * 1000)
+#define BENCH_TIME  (3 * 60 * 60 * 1000)
+#define CHECK_NUM   500
+#define INDEX_EXT   ".mfi"
+
+#define CHECK(cond) \
+  do \
+    { \
+      if (!(cond)) \
+        { \
+          printf("  NG: %s (line %d)\n", #cond, __LINE__); \
+          return 1; \
+        } \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct Frame
+{
+  uint32_t offset;
+  uint64_t samples;   /* Start time in samples */
+};
+
+struct Mp3File
+{
+  std::vector<uint8_t> data;
+  std::vector<Frame>   frames;
+  uint32_t             sampling_rate;
+  uint64_t             total_samples;
+};
+
+enum Toc
+{
+  TocNone = 0,
+  TocXing,
+  TocVbri,
+  TocInfoOnly,
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const uint32_t s_v1_bitrate[] =
+{
+  0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320
+};
+
+static const uint32_t s_v2_bitrate[] =
+{
+  0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160
+};
+
+/* Files are made in a temporary directory, and removed at exit.
+ * The directory is limited so that the longest path fits in PATH_SIZE.
+ */
+
+static char s_work_dir[PATH_SIZE - sizeof("/" BENCH_NAME ".mfi") + 1];
+static char s_test_file[PATH_SIZE];
+static char s_test_tmp[PATH_SIZE];
+static char s_test_index[PATH_SIZE];
+static char s_bench_file[PATH_SIZE];
+static char s_bench_index[PATH_SIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void remove_work_dir(void)
+{
+  unlink(s_test_file);
+  unlink(s_test_tmp);
+  unlink(s_test_index);
+  unlink(s_bench_file);
+  unlink(s_bench_index);
+  rmdir(s_work_dir);
+}
+
+/*--------------------------------------------------------------------------*/
+static bool make_work_dir(void)
+{
+  const char *tmp = getenv("TMPDIR");
+
+  if (tmp == NULL || tmp[0] == '\0' ||
+      strlen(tmp) + sizeof("/" WORK_DIR) > sizeof(s_work_dir))
+    {
+      tmp = "/tmp";
+    }
+
+  snprintf(s_work_dir, sizeof(s_work_dir), "%s/" WORK_DIR, tmp);
+
+  if (mkdtemp(s_work_dir) == NULL)
+    {
+      return false;
+    }
+
+  snprintf(s_test_file, PATH_SIZE, "%s/" TEST_NAME, s_work_dir);
+  snprintf(s_test_tmp, PATH_SIZE, "%s/" TEST_NAME ".tmp", s_work_dir);
+  snprintf(s_test_index, PATH_SIZE, "%s/" TEST_NAME ".mfi", s_work_dir);
+  snprintf(s_bench_file, PATH_SIZE, "%s/" BENCH_NAME, s_work_dir);
+  snprintf(s_bench_index, PATH_SIZE, "%s/" BENCH_NAME ".mfi", s_work_dir);
+
+  atexit(remove_work_dir);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static double now_ms(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/*--------------------------------------------------------------------------*/
+static uint32_t samples_to_ms(uint64_t samples, uint32_t sampling_rate)
+{
+  return (uint32_t)(samples * 1000 / sampling_rate);
+}
+
+/*--------------------------------------------------------------------------*/
+static void put_be(std::vector<uint8_t> &buf, uint32_t pos,
+                   uint32_t value, int size)
+{
+  for (int i = 0; i < size; i++)
+    {
+      buf[pos + i] = (uint8_t)(value >> (8 * (size - 1 - i)));
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/* Append a frame. The payload has no 0xFF, so that it has no fake sync. */
+
+static uint32_t add_frame(std::vector<uint8_t> &buf, bool mpeg1,
+                          int br_idx, bool mono, int pad)
+{
+  uint32_t size;
+
+  if (mpeg1)
+    {
+      size = 144 * s_v1_bitrate[br_idx] * 1000 / 44100 + pad;
+    }
+  else
+    {
+      size = 72 * s_v2_bitrate[br_idx] * 1000 / 22050 + pad;
+    }
+
+  uint32_t pos = buf.size();
+  buf.resize(pos + size);
+
+  buf[pos + 0] = 0xff;
+  buf[pos + 1] = mpeg1 ? 0xfb : 0xf3;
+  buf[pos + 2] = (br_idx << 4) | (pad << 1);
+  buf[pos + 3] = mono ? 0xc0 : 0x00;
+
+  for (uint32_t i = 4; i < size; i++)
+    {
+      buf[pos + i] = rand() % 0xff;
+    }
+
+  return size;
+}
+
+/*--------------------------------------------------------------------------*/
+static void make_file(Mp3File &file, uint32_t duration, bool mpeg1,
+                      bool mono, Toc toc, bool id3, bool broken)
+{
+  std::vector<uint8_t> &buf = file.data;
+  uint32_t spf = mpeg1 ? 1152 : 576;
+
+  buf.clear();
+  file.frames.clear();
+  file.sampling_rate = mpeg1 ? 44100 : 22050;
+  file.total_samples = 0;
+
+  if (id3)
+    {
+      /* ID3v2 tag of 1000 bytes (syncsafe size) */
+
+      static const uint8_t head[] =
+      {
+        'I', 'D', '3', 4, 0, 0, 0, 0, 7, 0x5e
+      };
+      buf.resize(sizeof(head) + 1000, 0xff);
+      memcpy(&buf[0], head, sizeof(head));
+    }
+
+  /* Info frame */
+
+  uint32_t info_pos = buf.size();
+  if (toc != TocNone)
+    {
+      add_frame(buf, mpeg1, 9, mono, 0);
+    }
+
+  while (samples_to_ms(file.total_samples, file.sampling_rate) < duration)
+    {
+      if (broken && file.frames.size() == 1000)
+        {
+          buf.resize(buf.size() + 333, 0x12);
+        }
+
+      Frame frame =
+        {
+          (uint32_t)buf.size(), file.total_samples
+        };
+      file.frames.push_back(frame);
+
+      add_frame(buf, mpeg1, 1 + rand() % 14, mono, rand() % 2);
+      file.total_samples += spf;
+    }
+
+  uint32_t audio_end = buf.size();
+
+  if (id3)
+    {
+      buf.resize(buf.size() + 128, 0);
+      buf[audio_end + 0] = 'T';
+      buf[audio_end + 1] = 'A';
+      buf[audio_end + 2] = 'G';
+    }
+
+  uint32_t frame_num = file.frames.size();
+  uint32_t tag_pos;
+
+  if (mpeg1)
+    {
+      tag_pos = info_pos + 4 + (mono ? 17 : 32);
+    }
+  else
+    {
+      tag_pos = info_pos + 4 + (mono ? 9 : 17);
+    }
+
+  if (toc == TocXing || toc == TocInfoOnly)
+    {
+      memcpy(&buf[tag_pos], (toc == TocXing) ? "Xing" : "Info", 4);
+      put_be(buf, tag_pos + 4, (toc == TocXing) ? 0x07 : 0x03, 4);
+      put_be(buf, tag_pos + 8, frame_num, 4);
+      put_be(buf, tag_pos + 12, audio_end - info_pos, 4);
+
+      for (int i = 0; i < 100 && toc == TocXing; i++)
+        {
+          const Frame &frame = file.frames[(uint64_t)frame_num * i / 100];
+          buf[tag_pos + 16 + i] =
+            (uint64_t)(frame.offset - info_pos) * 256 /
+            (audio_end - info_pos);
+        }
+    }
+  else if (toc == TocVbri)
+    {
+      /* The table must be in the info frame of 417 bytes. */
+
+      uint32_t vbri_pos = info_pos + 4 + 32;
+      uint32_t fpe      = frame_num / 110 + 1;
+      uint32_t toc_num  = (frame_num + fpe - 1) / fpe;
+
+      memcpy(&buf[vbri_pos], "VBRI", 4);
+      put_be(buf, vbri_pos + 4, 1, 2);
+      put_be(buf, vbri_pos + 10, audio_end - info_pos, 4);
+      put_be(buf, vbri_pos + 14, frame_num, 4);
+      put_be(buf, vbri_pos + 18, toc_num, 2);
+      put_be(buf, vbri_pos + 20, 1, 2);
+      put_be(buf, vbri_pos + 22, 3, 2);
+      put_be(buf, vbri_pos + 24, fpe, 2);
+
+      for (uint32_t i = 0; i < toc_num; i++)
+        {
+          uint32_t end = (i + 1) * fpe < frame_num ?
+                         file.frames[(i + 1) * fpe].offset : audio_end;
+          put_be(buf, vbri_pos + 26 + i * 3,
+                 end - file.frames[i * fpe].offset, 3);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static bool write_file(const char *name, const Mp3File &file)
+{
+  unlink(name);
+
+  char index_name[256];
+  snprintf(index_name, sizeof(index_name), "%s.mfi", name);
+  unlink(index_name);
+
+  FILE *fp = fopen(name, "wb");
+  if (fp == NULL)
+    {
+      return false;
+    }
+
+  size_t size = fwrite(&file.data[0], 1, file.data.size(), fp);
+  fclose(fp);
+
+  return (size == file.data.size());
+}
+
+/*--------------------------------------------------------------------------*/
+/* Index of the frame which includes the time. */
+
+static uint32_t find_frame(const Mp3File &file, uint32_t time)
+{
+  uint32_t idx = 0;
+  uint32_t spf = (file.sampling_rate == 44100) ? 1152 : 576;
+
+  while (idx + 1 < file.frames.size() &&
+         samples_to_ms(file.frames[idx].samples + spf,
+                       file.sampling_rate) <= time)
+    {
+      idx++;
+    }
+
+  return idx;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Check that the position of times are frames, and near to the time. */
+
+static int check_positions(Mp3FrameIndex &index, const Mp3File &file,
+                           uint32_t tolerance, bool exact)
+{
+  uint32_t duration = samples_to_ms(file.total_samples, file.sampling_rate);
+
+  CHECK(index.getSamplingRate() == file.sampling_rate);
+  CHECK(index.getDuration() + 1000 >= duration &&
+        index.getDuration() <= duration + 1000);
+
+  for (int i = 0; i <= CHECK_NUM; i++)
+    {
+      uint32_t time = (i == CHECK_NUM) ? duration - 1 :
+                      (uint64_t)duration * i / CHECK_NUM + rand() % 100;
+      uint32_t offset;
+      uint32_t start;
+
+      if (time >= duration)
+        {
+          time = duration - 1;
+        }
+
+      CHECK(index.getPosition(time, &offset, &start));
+
+      /* Must be a frame. */
+
+      size_t idx = 0;
+      while (idx < file.frames.size() && file.frames[idx].offset < offset)
+        {
+          idx++;
+        }
+
+      CHECK(idx < file.frames.size() && file.frames[idx].offset == offset);
+
+      uint32_t frame_time = samples_to_ms(file.frames[idx].samples,
+                                          file.sampling_rate);
+
+      if (exact)
+        {
+          CHECK(idx == find_frame(file, time));
+        }
+
+      CHECK(frame_time <= time + tolerance &&
+            time <= frame_time + tolerance);
+      CHECK(start <= frame_time + tolerance &&
+            frame_time <= start + tolerance);
+    }
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_scan(void)
+{
+  Mp3File       file;
+  Mp3FrameIndex index;
+
+  printf("scan (VBR, ID3v2/v1 tags)\n");
+
+  make_file(file, TEST_TIME, true, false, TocNone, true, false);
+  CHECK(write_file(s_test_file, file));
+
+  CHECK(index.open(s_test_file));
+  CHECK(index.getSource() == Mp3FrameIndex::IndexSourceScan);
+  CHECK(check_positions(index, file, 30, true) == 0);
+  index.close();
+
+  printf("saved index\n");
+
+  CHECK(access(s_test_index, F_OK) == 0);
+  CHECK(index.open(s_test_file));
+  CHECK(index.getSource() == Mp3FrameIndex::IndexSourceFile);
+  CHECK(check_positions(index, file, 30, true) == 0);
+  index.close();
+
+  printf("updated file\n");
+
+  make_file(file, TEST_TIME / 2, true, true, TocNone, false, false);
+  CHECK(write_file(s_test_tmp, file));
+  CHECK(rename(s_test_tmp, s_test_file) == 0);
+  CHECK(index.open(s_test_file, false));
+  CHECK(index.getSource() == Mp3FrameIndex::IndexSourceScan);
+  CHECK(check_positions(index, file, 30, true) == 0);
+  index.close();
+
+  printf("broken data\n");
+
+  make_file(file, TEST_TIME / 4, true, false, TocNone, false, true);
+  CHECK(write_file(s_test_file, file));
+  CHECK(index.open(s_test_file, false));
+  CHECK(check_positions(index, file, 30, true) == 0);
+  index.close();
+
+  printf("MPEG2 mono 22.05kHz, Info tag without TOC\n");
+
+  make_file(file, TEST_TIME / 4, false, true, TocInfoOnly, false, false);
+  CHECK(write_file(s_test_file, file));
+  CHECK(index.open(s_test_file, false));
+  CHECK(index.getSource() == Mp3FrameIndex::IndexSourceScan);
+  CHECK(check_positions(index, file, 30, true) == 0);
+  index.close();
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_toc(void)
+{
+  Mp3File       file;
+  Mp3FrameIndex index;
+
+  printf("Xing TOC\n");
+
+  make_file(file, TEST_TIME, true, false, TocXing, true, false);
+  CHECK(write_file(s_test_file, file));
+  CHECK(index.open(s_test_file));
+  CHECK(index.getSource() == Mp3FrameIndex::IndexSourceXing);
+  CHECK(access(s_test_index, F_OK) != 0);
+
+  /* TOC has 1/256 precision of the size. */
+
+  CHECK(check_positions(index, file, TEST_TIME / 256 + 1000, false) == 0);
+  index.close();
+
+  printf("Xing TOC (mono)\n");
+
+  make_file(file, TEST_TIME, true, true, TocXing, false, false);
+  CHECK(write_file(s_test_file, file));
+  CHECK(index.open(s_test_file));
+  CHECK(index.getSource() == Mp3FrameIndex::IndexSourceXing);
+  CHECK(check_positions(index, file, TEST_TIME / 256 + 1000, false) == 0);
+  index.close();
+
+  printf("VBRI TOC\n");
+
+  make_file(file, TEST_TIME, true, false, TocVbri, false, false);
+  CHECK(write_file(s_test_file, file));
+  CHECK(index.open(s_test_file));
+  CHECK(index.getSource() == Mp3FrameIndex::IndexSourceVbri);
+  CHECK(check_positions(index, file, 30, true) == 0);
+  index.close();
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_long_path(void)
+{
+  Mp3File       file;
+  Mp3FrameIndex index;
+
+  printf("long path\n");
+
+  make_file(file, TEST_TIME / 10, true, false, TocNone, false, false);
+
+  /* Around the longest path whose index path still fits. */
+
+  for (size_t len = PATH_SIZE - sizeof(INDEX_EXT) - 1; len <= PATH_SIZE;
+       len++)
+    {
+      char name[PATH_SIZE + 1];
+      char index_name[PATH_SIZE + sizeof(INDEX_EXT)];
+      int  pos = snprintf(name, sizeof(name), "%s/", s_work_dir);
+
+      memset(&name[pos], 'a', len - pos - 4);
+      strcpy(&name[len - 4], ".mp3");
+
+      CHECK(write_file(name, file));
+
+      bool opened  = index.open(name);
+      bool scanned = (index.getSource() == Mp3FrameIndex::IndexSourceScan);
+      index.close();
+
+      /* The file is kept, and an index is saved only with its full name. */
+
+      std::vector<uint8_t> data(file.data.size() + 1);
+      size_t size = 0;
+      FILE  *fp = fopen(name, "rb");
+
+      if (fp != NULL)
+        {
+          size = fread(&data[0], 1, data.size(), fp);
+          fclose(fp);
+        }
+
+      bool kept = (size == file.data.size() &&
+                   memcmp(&data[0], &file.data[0], size) == 0);
+
+      snprintf(index_name, sizeof(index_name), "%s" INDEX_EXT, name);
+      bool saved = (access(index_name, F_OK) == 0);
+      bool stray = false;
+
+      for (size_t cut = 1; cut < sizeof(INDEX_EXT) - 1; cut++)
+        {
+          index_name[len + cut] = '\0';
+          if (access(index_name, F_OK) == 0)
+            {
+              stray = true;
+              unlink(index_name);
+            }
+
+          index_name[len + cut] = INDEX_EXT[cut];
+        }
+
+      unlink(index_name);
+      unlink(name);
+
+      CHECK(opened && scanned);
+      CHECK(kept);
+      CHECK(saved == (len + sizeof(INDEX_EXT) <= PATH_SIZE));
+      CHECK(!stray);
+    }
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Former way. Parse all frame headers from the top of the file. */
+static uint32_t walk_from_top(const char *name, uint32_t time)
+{
+  FILE     *fp = fopen(name, "rb");
+  uint32_t  pos = 0;
+  uint64_t  samples = 0;
+  uint8_t   head[4];
+
+  while (fseek(fp, pos, SEEK_SET) == 0 && fread(head, 1, 4, fp) == 4)
+    {
+      if (head[0] != 0xff)
+        {
+          pos++;
+          continue;
+        }
+
+      uint32_t size = 144 * s_v1_bitrate[head[2] >> 4] * 1000 / 44100 +
+                      ((head[2] >> 1) & 1);
+
+      if (samples_to_ms(samples + 1152, 44100) > time)
+        {
+          break;
+        }
+
+      samples += 1152;
+      pos     += size;
+    }
+
+  fclose(fp);
+
+  return pos;
+}
+
+/*--------------------------------------------------------------------------*/
+static int bench(void)
+{
+  Mp3File       file;
+  Mp3FrameIndex index;
+  uint32_t      offset;
+  uint32_t      start;
+  uint32_t      time = BENCH_TIME - 60 * 1000;
+
+  printf("\nbench: seek to %u ms of %u ms VBR file\n", time, BENCH_TIME);
+
+  make_file(file, BENCH_TIME, true, false, TocNone, false, false);
+  CHECK(write_file(s_bench_file, file));
+  printf("  file size        : %u bytes, %u frames\n",
+         (uint32_t)file.data.size(), (uint32_t)file.frames.size());
+
+  double t0 = now_ms();
+  CHECK(index.open(s_bench_file));
+  double t1 = now_ms();
+  index.close();
+  CHECK(index.open(s_bench_file));
+  double t2 = now_ms();
+  CHECK(index.getPosition(time, &offset, &start));
+  double t3 = now_ms();
+  uint32_t ref = walk_from_top(s_bench_file, time);
+  double t4 = now_ms();
+
+  CHECK(offset == ref);
+
+  printf("  open (scan+save) : %9.3f ms\n", t1 - t0);
+  printf("  open (saved)     : %9.3f ms\n", t2 - t1);
+  printf("  getPosition      : %9.3f ms\n", t3 - t2);
+  printf("  walk from top    : %9.3f ms\n", t4 - t3);
+
+  index.close();
+
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  bool test_only = (argc > 1 && strcmp(argv[1], "-t") == 0);
+
+  srand(1);
+
+  if (!make_work_dir())
+    {
+      printf("Cannot make work directory\n");
+      return 1;
+    }
+
+  if (test_scan() != 0 || test_toc() != 0 || test_long_path() != 0)
+    {
+      printf("Test NG\n");
+      return 1;
+    }
+
+  printf("All tests OK\n");
+
+  if (!test_only && bench() != 0)
+    {
+      return 1;
+    }
+
+  return 0;
+}
@@ -51,6 +51,10 @@ CSRCS +=  runtime_nnabla.c
 CSRCS +=  shared_chunk.c
 CSRCS +=  affine.c
 CSRCS +=  convolution.c
+
+ifeq ($(CONFIG_DNN_RT_SCRATCH_POOL),y)
+CSRCS +=  scratch_pool.c
+endif
 CSRC_PATH += src/functions
 CSRC_PATH += src/runtime
 
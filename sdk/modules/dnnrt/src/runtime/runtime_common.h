@@ -89,14 +89,22 @@ extern "C"
                                  * variable buffers in rt_initialize_context() */
   };
 
-  typedef struct dnn_global_context
+  /* context of each dnn_runtime_t, to which dnn_runtime_t::impl_ctx points.
+   * runtimes don't share variable buffers nor scratch buffers, so that
+   * they can be initialized and forwarded by different threads at once. */
+  typedef struct dnn_runtime_context
   {
-    int rt_count;
-    int req_scratch_buf_bsize;
-    int scratch_buf_bsize;
-    void *scratch_buf;
+    rt_context_pointer rt_ctx;  /* context of nnabla-c-runtime */
+    int req_scratch_buf_bsize;  /* required minimum size of scratch_buf */
+    void *scratch_buf;          /* scratch buffer for functions. if
+                                 * CONFIG_DNN_RT_SCRATCH_POOL=y, it is
+                                 * lent from the pool only while
+                                 * dnn_runtime_forward() */
+#  ifdef CONFIG_DNN_RT_SCRATCH_POOL
+    int scratch_slot;           /* slot of the pool lent to scratch_buf */
+#  endif
     dnn_shared_chunk_t *chunks;
-    dnn_vbuffer_alloc_info_t *alloc_info;       /* allocation info of current
+    dnn_vbuffer_alloc_info_t *alloc_info;       /* allocation info of this
                                                  * network. the alloc_info is
                                                  * placed on stack of
                                                  * dnn_runtime_initialize() for
@@ -104,9 +112,9 @@ extern "C"
                                                  * shouldn't be access after
                                                  * dnn_runtime_initialize()
                                                  * stack frame inactive */
-  } dnn_global_context_t;
+  } dnn_runtime_context_t;
 
-  dnn_global_context_t *dnn_get_global_context(void);
+  dnn_runtime_context_t *dnn_current_context(void);
   rt_function_error_t dnnrt_exec_convolution(rt_function_t * f);
   rt_function_error_t dnnrt_exec_affine(rt_function_t * f);
   rt_return_value_t dnnrt_affine_alloc(nn_network_t * net,
@@ -116,15 +124,20 @@ extern "C"
 
   void dnn_req_scratch_buf(int size);
   void *dnn_scratch_buf(void);
+#  ifdef CONFIG_DNN_RT_SCRATCH_POOL
+  int dnn_scratch_pool_reserve(int bsize);
+  void dnn_scratch_pool_release(void);
+  int dnn_scratch_pool_acquire(void **buf);
+  void dnn_scratch_pool_put(int slot);
+#  endif
 
   int dnn_peek_vbuffers(const nn_network_t * net,
                         dnn_vbuffer_alloc_info_t * alloc_info);
-  void dnn_reset_chunk_usage(dnn_global_context_t * ctx);
-  int dnn_preallocate_chunks(dnn_global_context_t * ctx,
+  int dnn_preallocate_chunks(dnn_runtime_context_t * ctx,
                              dnn_vbuffer_alloc_info_t * alloc_info);
-  void dnn_deallocate_chunks(dnn_global_context_t * ctx,
+  void dnn_deallocate_chunks(dnn_runtime_context_t * ctx,
                              dnn_vbuffer_alloc_info_t * alloc_info);
-  void dnn_destroy_unused_chunks(dnn_global_context_t * ctx);
+  void dnn_destroy_unused_chunks(dnn_runtime_context_t * ctx);
   void *dnn_variable_malloc(size_t size);
   void dnn_variable_free(void *p);
 
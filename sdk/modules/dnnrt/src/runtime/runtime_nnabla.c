@@ -32,7 +32,9 @@
  *
  ****************************************************************************/
 
+#include <pthread.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <dnnrt/runtime.h>
 
@@ -45,7 +47,40 @@
 
 #define WEIGHT (1)
 
-static struct dnn_global_context s_dnn_gctx;
+#define DNN_RT_CTX(rt) (((dnn_runtime_context_t *) (rt)->impl_ctx)->rt_ctx)
+
+/* nnabla-c-runtime calls dnn_variable_malloc(), dnn_variable_free() and
+ * the callbacks of functions without any argument to know dnn_runtime_t.
+ * so the runtime which a thread is initializing, forwarding or finalizing
+ * is held in a thread-specific data, not in a global variable. */
+static pthread_once_t s_dnn_once = PTHREAD_ONCE_INIT;
+static pthread_key_t s_dnn_ctx_key;
+static int s_dnn_once_err;
+
+static void dnn_setup_once(void)
+{
+  s_dnn_once_err = -pthread_key_create(&s_dnn_ctx_key, NULL);
+  rt_set_variable_malloc(dnn_variable_malloc);
+  rt_set_variable_free(dnn_variable_free);
+}
+
+static int dnn_setup(void)
+{
+  pthread_once(&s_dnn_once, dnn_setup_once);
+  return s_dnn_once_err;
+}
+
+static dnn_runtime_context_t *dnn_enter(dnn_runtime_context_t * ctx)
+{
+  dnn_runtime_context_t *prev = dnn_current_context();
+  pthread_setspecific(s_dnn_ctx_key, ctx);
+  return prev;
+}
+
+static void dnn_leave(dnn_runtime_context_t * prev)
+{
+  pthread_setspecific(s_dnn_ctx_key, prev);
+}
 
 int dnn_initialize(dnn_config_t * config)
 {
@@ -55,7 +90,7 @@ int dnn_initialize(dnn_config_t * config)
       dnn_err("dnnrt works with dnn_config_t::cpu_num == 1u\n");
       return -EINVAL;
     }
-  return RT_RET_NOERROR;
+  return dnn_setup();
 }
 
 int dnn_finalize(void)
@@ -67,13 +102,25 @@ int dnn_runtime_initialize(dnn_runtime_t * rt, const nn_network_t * network)
 {
   DNN_CHECK_NULL_RET(rt, -EINVAL);
   DNN_CHECK_NULL_RET(network, -EINVAL);
-  void *tmp_buf;
+  dnn_runtime_context_t *ctx, *prev;
   dnn_vbuffer_alloc_info_t alloc_info = { 0 };
   int err;
 
-  /* for memory saving a stack varible alloc_info is used */
-  s_dnn_gctx.alloc_info = &alloc_info;
   rt->impl_ctx = NULL;
+  err = dnn_setup();
+  if (err != RT_RET_NOERROR)
+    {
+      return err;
+    }
+  ctx = (dnn_runtime_context_t *) calloc(1, sizeof(dnn_runtime_context_t));
+  if (!ctx)
+    {
+      return -ENOMEM;
+    }
+
+  /* for memory saving a stack varible alloc_info is used */
+  ctx->alloc_info = &alloc_info;
+  prev = dnn_enter(ctx);
 
   /* peek variable buffer sizes and pre-allocate shared chunks to them */
   err = dnn_peek_vbuffers(network, &alloc_info);
@@ -81,127 +128,165 @@ int dnn_runtime_initialize(dnn_runtime_t * rt, const nn_network_t * network)
     {
       goto peek_err;
     }
-  dnn_reset_chunk_usage(&s_dnn_gctx);
-  err = dnn_preallocate_chunks(&s_dnn_gctx, &alloc_info);
+  err = dnn_preallocate_chunks(ctx, &alloc_info);
   if (err != RT_RET_NOERROR)
     {
       goto pre_alloc_err;
     }
 
   /* register dnnrt's callback with rt_context */
-  err = (int)rt_allocate_context((rt_context_pointer *) & (rt->impl_ctx));
+  err = (int)rt_allocate_context(&ctx->rt_ctx);
   if (err != RT_RET_NOERROR)
     {
       goto rt_alloc_err;
     }
-  rt_set_variable_malloc(dnn_variable_malloc);
-  rt_set_variable_free(dnn_variable_free);
-  rt_context_pointer ctx = (rt_context_pointer) (rt->impl_ctx);
-  err =
-    (int)rt_add_callback(ctx, NN_FUNCTION_CONVOLUTION, dnnrt_convolution_alloc);
+  err = (int)rt_add_callback(ctx->rt_ctx, NN_FUNCTION_CONVOLUTION,
+                             dnnrt_convolution_alloc);
   if (err != RT_RET_NOERROR)
     {
       goto rt_init_err;
     }
-  err =
-    (int)rt_add_callback(ctx, NN_FUNCTION_CONVOLUTION_0, dnnrt_convolution_alloc);
+  err = (int)rt_add_callback(ctx->rt_ctx, NN_FUNCTION_CONVOLUTION_0,
+                             dnnrt_convolution_alloc);
   if (err != RT_RET_NOERROR)
     {
       goto rt_init_err;
     }
-  err = (int)rt_add_callback(ctx, NN_FUNCTION_AFFINE, dnnrt_affine_alloc);
+  err = (int)rt_add_callback(ctx->rt_ctx, NN_FUNCTION_AFFINE,
+                             dnnrt_affine_alloc);
   if (err != RT_RET_NOERROR)
     {
       goto rt_init_err;
     }
 
   /* initialize rt_context and count up required minimum size of scratch_buf */
-  s_dnn_gctx.req_scratch_buf_bsize = 0;
   /* remove const to use the as-is rt_initialize_context() */
-  err = (int)rt_initialize_context(ctx, (nn_network_t *) network);
+  err = (int)rt_initialize_context(ctx->rt_ctx, (nn_network_t *) network);
   if (err != RT_RET_NOERROR)
     {
       goto rt_init_err;
     }
 
-  /* resize scratch buffer */
-  if (s_dnn_gctx.req_scratch_buf_bsize > s_dnn_gctx.scratch_buf_bsize)
+  /* allocate scratch buffer */
+#ifdef CONFIG_DNN_RT_SCRATCH_POOL
+  err = dnn_scratch_pool_reserve(ctx->req_scratch_buf_bsize);
+  if (err != RT_RET_NOERROR)
     {
-      tmp_buf =
-        realloc(s_dnn_gctx.scratch_buf, s_dnn_gctx.req_scratch_buf_bsize);
-      if (!tmp_buf)
+      goto scratch_buf_err;
+    }
+#else
+  if (ctx->req_scratch_buf_bsize > 0)
+    {
+      ctx->scratch_buf = malloc(ctx->req_scratch_buf_bsize);
+      if (!ctx->scratch_buf)
         {
           err = -ENOMEM;
           goto scratch_buf_err;
         }
-      s_dnn_gctx.scratch_buf = tmp_buf;
-      s_dnn_gctx.scratch_buf_bsize = s_dnn_gctx.req_scratch_buf_bsize;
     }
-  ++s_dnn_gctx.rt_count;
+#endif
+
+  ctx->alloc_info = NULL;
+  dnn_leave(prev);
+  rt->impl_ctx = ctx;
 
   return RT_RET_NOERROR;
 
 scratch_buf_err:
 rt_init_err:
-  dnn_deallocate_chunks(&s_dnn_gctx, &alloc_info);
-  rt_free_context(&rt->impl_ctx);
+  dnn_deallocate_chunks(ctx, &alloc_info);
+  rt_free_context(&ctx->rt_ctx);
 rt_alloc_err:
-  dnn_destroy_unused_chunks(&s_dnn_gctx);
+  dnn_destroy_unused_chunks(ctx);
 pre_alloc_err:
 peek_err:
+  dnn_leave(prev);
+  free(ctx);
   return err;
 }
 
 int dnn_runtime_finalize(dnn_runtime_t * rt)
 {
   DNN_CHECK_NULL_RET(rt, -EINVAL);
+  dnn_runtime_context_t *ctx = (dnn_runtime_context_t *) rt->impl_ctx;
+  DNN_CHECK_NULL_RET(ctx, -EINVAL);
+  dnn_runtime_context_t *prev;
+  int ret;
+
+  /* variable buffers go back to ctx->chunks through dnn_variable_free() */
+  prev = dnn_enter(ctx);
+  ret = (int)rt_free_context(&ctx->rt_ctx);
+  dnn_leave(prev);
+
+#ifdef CONFIG_DNN_RT_SCRATCH_POOL
+  dnn_scratch_pool_release();
+#else
+  free(ctx->scratch_buf);
+#endif
+  free(ctx);
+  rt->impl_ctx = NULL;
 
-  if (--s_dnn_gctx.rt_count == 0)
-    {
-      free(s_dnn_gctx.scratch_buf);
-      s_dnn_gctx.scratch_buf = NULL;
-      s_dnn_gctx.scratch_buf_bsize = 0;
-      s_dnn_gctx.req_scratch_buf_bsize = 0;
-    }
-
-  return (int)rt_free_context((rt_context_pointer *) & (rt->impl_ctx));
+  return ret;
 }
 
 int dnn_runtime_forward(dnn_runtime_t * rt, const void *inputs[],
                         unsigned char input_num)
 {
   DNN_CHECK_NULL_RET(rt, -EINVAL);
-  rt_context_pointer ctx = (rt_context_pointer) rt->impl_ctx;
-  if (rt_num_of_input(ctx) != input_num)
+  dnn_runtime_context_t *ctx = (dnn_runtime_context_t *) rt->impl_ctx;
+  DNN_CHECK_NULL_RET(ctx, -EINVAL);
+  dnn_runtime_context_t *prev;
+  int ret;
+
+  if (rt_num_of_input(ctx->rt_ctx) != input_num)
     {
       return -EINVAL;
     }
-  rt_context_t *c = (rt_context_t *) ctx;
+  rt_context_t *c = (rt_context_t *) ctx->rt_ctx;
 
   for (int i = 0; i < input_num; ++i)
     {
       c->variables[c->input_variable_ids[i]].data = (void *)inputs[i];
     }
 
-  return (int)rt_forward(ctx);
+#ifdef CONFIG_DNN_RT_SCRATCH_POOL
+  if (ctx->req_scratch_buf_bsize > 0)
+    {
+      ctx->scratch_slot = dnn_scratch_pool_acquire(&ctx->scratch_buf);
+    }
+#endif
+
+  prev = dnn_enter(ctx);
+  ret = (int)rt_forward(ctx->rt_ctx);
+  dnn_leave(prev);
+
+#ifdef CONFIG_DNN_RT_SCRATCH_POOL
+  if (ctx->req_scratch_buf_bsize > 0)
+    {
+      dnn_scratch_pool_put(ctx->scratch_slot);
+      ctx->scratch_buf = NULL;
+    }
+#endif
+
+  return ret;
 }
 
 int dnn_runtime_input_num(dnn_runtime_t * rt)
 {
   DNN_CHECK_NULL_RET(rt, -EINVAL);
-  return rt_num_of_input((rt_context_pointer) rt->impl_ctx);
+  return rt_num_of_input(DNN_RT_CTX(rt));
 }
 
 int dnn_runtime_input_size(dnn_runtime_t * rt, unsigned char data_index)
 {
   DNN_CHECK_NULL_RET(rt, -EINVAL);
-  return rt_input_size((rt_context_pointer) rt->impl_ctx, data_index);
+  return rt_input_size(DNN_RT_CTX(rt), data_index);
 }
 
 int dnn_runtime_input_ndim(dnn_runtime_t * rt, unsigned char data_index)
 {
   DNN_CHECK_NULL_RET(rt, -EINVAL);
-  return rt_input_dimension((rt_context_pointer) rt->impl_ctx, data_index);
+  return rt_input_dimension(DNN_RT_CTX(rt), data_index);
 }
 
 int
@@ -209,39 +294,38 @@ dnn_runtime_input_shape(dnn_runtime_t * rt, unsigned char data_index,
                         unsigned char dim_index)
 {
   DNN_CHECK_NULL_RET(rt, -EINVAL);
-  return rt_input_shape((rt_context_pointer) rt->impl_ctx, data_index,
-                        dim_index);
+  return rt_input_shape(DNN_RT_CTX(rt), data_index, dim_index);
 }
 
 void *dnn_input_buffer(dnn_runtime_t * rt, unsigned char data_index)
 {
   DNN_CHECK_NULL_RET(rt, NULL);
-  return rt_input_buffer(rt->impl_ctx, (size_t) data_index);
+  return rt_input_buffer(DNN_RT_CTX(rt), (size_t) data_index);
 }
 
 nn_variable_t *dnn_runtime_input_variable(dnn_runtime_t * rt,
                                           unsigned char data_index)
 {
   DNN_CHECK_NULL_RET(rt, NULL);
-  return rt_input_variable(rt->impl_ctx, data_index);
+  return rt_input_variable(DNN_RT_CTX(rt), data_index);
 }
 
 int dnn_runtime_output_num(dnn_runtime_t * rt)
 {
   DNN_CHECK_NULL_RET(rt, -EINVAL);
-  return rt_num_of_output(rt->impl_ctx);
+  return rt_num_of_output(DNN_RT_CTX(rt));
 }
 
 int dnn_runtime_output_size(dnn_runtime_t * rt, unsigned char data_index)
 {
   DNN_CHECK_NULL_RET(rt, -EINVAL);
-  return rt_output_size(rt->impl_ctx, data_index);
+  return rt_output_size(DNN_RT_CTX(rt), data_index);
 }
 
 int dnn_runtime_output_ndim(dnn_runtime_t * rt, unsigned char data_index)
 {
   DNN_CHECK_NULL_RET(rt, -EINVAL);
-  return rt_output_dimension(rt->impl_ctx, data_index);
+  return rt_output_dimension(DNN_RT_CTX(rt), data_index);
 }
 
 int
@@ -249,38 +333,40 @@ dnn_runtime_output_shape(dnn_runtime_t * rt, unsigned char data_index,
                          unsigned char dim_index)
 {
   DNN_CHECK_NULL_RET(rt, -EINVAL);
-  return rt_output_shape(rt->impl_ctx, data_index, dim_index);
+  return rt_output_shape(DNN_RT_CTX(rt), data_index, dim_index);
 }
 
 void *dnn_runtime_output_buffer(dnn_runtime_t * rt, unsigned char data_index)
 {
   DNN_CHECK_NULL_RET(rt, NULL);
-  return rt_output_buffer(rt->impl_ctx, (size_t) data_index);
+  return rt_output_buffer(DNN_RT_CTX(rt), (size_t) data_index);
 }
 
 nn_variable_t *dnn_runtime_output_variable(dnn_runtime_t * rt,
                                            unsigned char data_index)
 {
   DNN_CHECK_NULL_RET(rt, NULL);
-  return rt_output_variable(rt->impl_ctx, data_index);
+  return rt_output_variable(DNN_RT_CTX(rt), data_index);
 }
 
-dnn_global_context_t *dnn_get_global_context(void)
+dnn_runtime_context_t *dnn_current_context(void)
 {
-  return &s_dnn_gctx;
+  return (dnn_runtime_context_t *) pthread_getspecific(s_dnn_ctx_key);
 }
 
 void dnn_req_scratch_buf(int size)
 {
-  if (size > s_dnn_gctx.req_scratch_buf_bsize)
+  dnn_runtime_context_t *ctx = dnn_current_context();
+
+  if (size > ctx->req_scratch_buf_bsize)
     {
-      s_dnn_gctx.req_scratch_buf_bsize = size;
+      ctx->req_scratch_buf_bsize = size;
     }
 }
 
 void *dnn_scratch_buf(void)
 {
-  return s_dnn_gctx.scratch_buf;
+  return dnn_current_context()->scratch_buf;
 }
 
 int dnn_asmp_mallinfo(unsigned char array_length, dnn_mallinfo_t * info_array)
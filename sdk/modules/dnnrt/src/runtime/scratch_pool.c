@@ -0,0 +1,165 @@
+/****************************************************************************
+ * modules/dnnrt/src/runtime/scratch_pool.c
+ *
+ *   Copyright 2018 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <dnnrt/runtime.h>
+
+#include "nnablart/runtime.h"
+#include "runtime_common.h"
+
+#define SCRATCH_POOL_NUM CONFIG_DNN_RT_SCRATCH_POOL_NUM
+
+/* pool of scratch buffers shared among dnn_runtime_t objects.
+ * every buffer is as large as the largest request of the runtimes,
+ * and is lent to one dnn_runtime_forward() at a time. */
+struct dnn_scratch_pool
+{
+  pthread_mutex_t lock;
+  pthread_cond_t cond;          /* signaled when a buffer is returned */
+  int users;                    /* number of runtimes using this pool */
+  int bsize;                    /* size of each buffer in bytes */
+  int busy_num;                 /* number of buffers lent to runtimes */
+  bool busy[SCRATCH_POOL_NUM];
+  void *buf[SCRATCH_POOL_NUM];
+};
+
+static struct dnn_scratch_pool s_scratch_pool = {
+  PTHREAD_MUTEX_INITIALIZER,
+  PTHREAD_COND_INITIALIZER
+};
+
+static void dnn_scratch_pool_free_buffers(struct dnn_scratch_pool *pool)
+{
+  for (int i = 0; i < SCRATCH_POOL_NUM; i++)
+    {
+      free(pool->buf[i]);
+      pool->buf[i] = NULL;
+    }
+  pool->bsize = 0;
+}
+
+int dnn_scratch_pool_reserve(int bsize)
+{
+  struct dnn_scratch_pool *pool = &s_scratch_pool;
+  int ret = RT_RET_NOERROR;
+  void *tmp_buf;
+
+  pthread_mutex_lock(&pool->lock);
+
+  /* the size is checked again after every wait, because another runtime
+   * may have grown the buffers meanwhile. pool->bsize is never lowered. */
+  while (bsize > pool->bsize)
+    {
+      /* buffers can't be moved while other runtimes use them */
+      if (pool->busy_num > 0)
+        {
+          pthread_cond_wait(&pool->cond, &pool->lock);
+          continue;
+        }
+
+      for (int i = 0; i < SCRATCH_POOL_NUM; i++)
+        {
+          tmp_buf = realloc(pool->buf[i], bsize);
+          if (!tmp_buf)
+            {
+              ret = -ENOMEM;
+              break;
+            }
+          pool->buf[i] = tmp_buf;
+        }
+
+      if (ret != RT_RET_NOERROR)
+        {
+          if (pool->users == 0)
+            {
+              dnn_scratch_pool_free_buffers(pool);
+            }
+          break;
+        }
+
+      pool->bsize = bsize;
+    }
+
+  if (ret == RT_RET_NOERROR)
+    {
+      ++pool->users;
+    }
+
+  pthread_mutex_unlock(&pool->lock);
+  return ret;
+}
+
+void dnn_scratch_pool_release(void)
+{
+  struct dnn_scratch_pool *pool = &s_scratch_pool;
+
+  pthread_mutex_lock(&pool->lock);
+  if (--pool->users == 0)
+    {
+      dnn_scratch_pool_free_buffers(pool);
+    }
+  pthread_mutex_unlock(&pool->lock);
+}
+
+int dnn_scratch_pool_acquire(void **buf)
+{
+  struct dnn_scratch_pool *pool = &s_scratch_pool;
+  int slot;
+
+  pthread_mutex_lock(&pool->lock);
+  while (pool->busy_num == SCRATCH_POOL_NUM)
+    {
+      pthread_cond_wait(&pool->cond, &pool->lock);
+    }
+  for (slot = 0; pool->busy[slot]; slot++);
+  pool->busy[slot] = true;
+  ++pool->busy_num;
+  *buf = pool->buf[slot];
+  pthread_mutex_unlock(&pool->lock);
+
+  return slot;
+}
+
+void dnn_scratch_pool_put(int slot)
+{
+  struct dnn_scratch_pool *pool = &s_scratch_pool;
+
+  pthread_mutex_lock(&pool->lock);
+  pool->busy[slot] = false;
+  --pool->busy_num;
+  pthread_cond_broadcast(&pool->cond);
+  pthread_mutex_unlock(&pool->lock);
+}
@@ -33,6 +33,7 @@
  ****************************************************************************/
 
 #include <limits.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -42,15 +43,16 @@
 #include "runtime_internal.h"
 #include "runtime_common.h"
 
-#define ALIGN(x, s) ((void*)((unsigned int)(((void*)(x)) + ((s) - 1)) & ~((s) - 1)))
+#define ALIGN(x, s) \
+  ((void*)((uintptr_t)(((void*)(x)) + ((s) - 1)) & ~((uintptr_t)(s) - 1)))
 
-inline uint32_t round_up(uint32_t num, uint32_t multiple)
+static inline uint32_t round_up(uint32_t num, uint32_t multiple)
 {
   uint32_t remain = num % multiple;
   return remain == 0 ? num : num + multiple - remain;
 }
 
-static void dnn_shared_chunk_update_ref_count(dnn_global_context_t * ctx,
+static void dnn_shared_chunk_update_ref_count(dnn_runtime_context_t * ctx,
                                               void *p, int delta)
 {
   dnn_shared_chunk_t *chunk = ctx->chunks;
@@ -70,7 +72,7 @@ static void dnn_shared_chunk_update_ref_count(dnn_global_context_t * ctx,
   dnn_destroy_unused_chunks(ctx);
 }
 
-void dnn_destroy_unused_chunks(dnn_global_context_t * ctx)
+void dnn_destroy_unused_chunks(dnn_runtime_context_t * ctx)
 {
   dnn_shared_chunk_t *pre = NULL;
   dnn_shared_chunk_t *chunk = ctx->chunks;
@@ -101,7 +103,7 @@ void dnn_destroy_unused_chunks(dnn_global_context_t * ctx)
 
 void *dnn_variable_malloc(size_t size)
 {
-  dnn_global_context_t *ctx = dnn_get_global_context();
+  dnn_runtime_context_t *ctx = dnn_current_context();
   void *p = ctx->alloc_info->addr_list[ctx->alloc_info->actual_alloc_count++];
   dnn_shared_chunk_update_ref_count(ctx, p, 1);
   return p;
@@ -111,7 +113,7 @@ void dnn_variable_free(void *p)
 {
   if (p)
     {
-      dnn_global_context_t *ctx = dnn_get_global_context();
+      dnn_runtime_context_t *ctx = dnn_current_context();
       dnn_shared_chunk_update_ref_count(ctx, p, -1);
     }
   else
@@ -193,7 +195,7 @@ static
 }
 
 static inline
-  dnn_shared_chunk_t * dnn_create_chunk(dnn_global_context_t * ctx,
+  dnn_shared_chunk_t * dnn_create_chunk(dnn_runtime_context_t * ctx,
                                         dnn_vbuffer_alloc_info_t * alloc_info)
 {
   /* reserve memory for new_chunk */
@@ -211,7 +213,7 @@ static inline
       size_t header_bsize = new_chunk->data - (void *)new_chunk;
       new_chunk->allocated_bsize = chunk_bsize - header_bsize;
 
-      /* add new_chunk to a linked list, dnn_global_context_t::chunks */
+      /* add new_chunk to a linked list, dnn_runtime_context_t::chunks */
       if (ctx->chunks)
         {
           for (last = ctx->chunks; last->next != NULL; last = last->next);
@@ -226,19 +228,7 @@ static inline
   return new_chunk;
 }
 
-void dnn_reset_chunk_usage(dnn_global_context_t * ctx)
-{
-  dnn_shared_chunk_t *chunk;
-  if (ctx->chunks)
-    {
-      for (chunk = ctx->chunks; chunk != NULL; chunk = chunk->next)
-        {
-          chunk->used_bsize = 0u;
-        }
-    }
-}
-
-void dnn_deallocate_chunks(dnn_global_context_t * ctx,
+void dnn_deallocate_chunks(dnn_runtime_context_t * ctx,
                            dnn_vbuffer_alloc_info_t * alloc_info)
 {
   for (uint8_t idx = 0; idx < alloc_info->actual_alloc_count; idx++)
@@ -258,7 +248,7 @@ void dnn_deallocate_chunks(dnn_global_context_t * ctx,
  *  3. slice the new single shared_chunk and allocate sliced pieces to
  *     variable buffers which didn't fit in existing shared_chunk in 1
  */
-int dnn_preallocate_chunks(dnn_global_context_t * ctx,
+int dnn_preallocate_chunks(dnn_runtime_context_t * ctx,
                            dnn_vbuffer_alloc_info_t * alloc_info)
 {
   int ret = RT_RET_NOERROR;
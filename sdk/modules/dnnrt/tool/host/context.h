@@ -0,0 +1,81 @@
+/****************************************************************************
+ * modules/dnnrt/tool/host/context.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host replacement of context.h of nnabla-c-runtime. */
+
+#ifndef __DNNRT_TOOL_HOST_CONTEXT_H
+#define __DNNRT_TOOL_HOST_CONTEXT_H
+
+#include <nnablart/functions.h>
+#include <nnablart/runtime.h>
+
+#define HOST_CALLBACK_MAX 8
+
+typedef struct
+{
+  nn_function_t *info;
+  rt_function_t func;
+} rt_function_context_t;
+
+typedef struct
+{
+  nn_function_type_t type;
+  rt_function_callback_t allocator;
+} rt_callback_t;
+
+typedef struct
+{
+  nn_network_t *network;
+
+  int num_of_buffers;
+  void **buffers;
+
+  int num_of_variables;
+  rt_variable_t *variables;
+
+  int num_of_functions;
+  rt_function_context_t *functions;
+
+  int num_of_inputs;
+  int *input_variable_ids;
+
+  int num_of_outputs;
+  int *output_variable_ids;
+
+  int num_of_callbacks;
+  rt_callback_t callbacks[HOST_CALLBACK_MAX];
+} rt_context_t;
+
+#endif /* __DNNRT_TOOL_HOST_CONTEXT_H */
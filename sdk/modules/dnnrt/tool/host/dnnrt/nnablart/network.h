@@ -0,0 +1,100 @@
+/****************************************************************************
+ * modules/dnnrt/tool/host/dnnrt/nnablart/network.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host replacement of network.h of nnabla-c-runtime, which the SDK build
+ * installs to <dnnrt/nnablart/network.h>.
+ *
+ * Only the part used by dnnrt and host_nnablart.c is given, and the
+ * layout is simplified from .nnb files: each list is an offset from the
+ * top of nn_network_t to an array of int, nn_variable_t or nn_function_t.
+ */
+
+#ifndef __DNNRT_TOOL_HOST_NNABLART_NETWORK_H
+#define __DNNRT_TOOL_HOST_NNABLART_NETWORK_H
+
+#include <stdint.h>
+
+#define NN_GET(N, X) ((void *)((uint8_t *)(N) + (X)))
+
+typedef struct
+{
+  int size;                     /* Number of elements */
+  int list;                     /* Offset of the array */
+} nn_list_t;
+
+typedef enum
+{
+  NN_DATA_TYPE_FLOAT,
+  NN_DATA_TYPE_INT16,
+  NN_DATA_TYPE_INT8,
+  NN_DATA_TYPE_SIGN
+} nn_data_type_t;
+
+typedef enum
+{
+  NN_FUNCTION_AFFINE,
+  NN_FUNCTION_CONVOLUTION,
+  NN_FUNCTION_CONVOLUTION_0,
+  NN_FUNCTION_RELU
+} nn_function_type_t;
+
+typedef struct
+{
+  nn_list_t shape;              /* int */
+  int type;                     /* nn_data_type_t */
+  int fp_pos;
+  int data_index;               /* Buffer index, or -1 for a parameter */
+  int data;                     /* Offset of the parameter */
+} nn_variable_t;
+
+typedef struct
+{
+  int type;                     /* nn_function_type_t */
+  int impl;
+  nn_list_t inputs;             /* int, index of variables */
+  nn_list_t outputs;            /* int, index of variables */
+} nn_function_t;
+
+typedef struct
+{
+  int version;
+  nn_list_t buffers;            /* int, size in bytes from version 3 */
+  nn_list_t variables;          /* nn_variable_t */
+  nn_list_t functions;          /* nn_function_t */
+  nn_list_t inputs;             /* int, index of variables */
+  nn_list_t outputs;            /* int, index of variables */
+} nn_network_t;
+
+#endif /* __DNNRT_TOOL_HOST_NNABLART_NETWORK_H */
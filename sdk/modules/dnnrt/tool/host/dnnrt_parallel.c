@@ -0,0 +1,673 @@
+/****************************************************************************
+ * modules/dnnrt/tool/host/dnnrt_parallel.c
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Test and benchmark of dnn_runtime_t objects used by threads at once.
+ *
+ * Some affine/ReLU networks are built with random parameters, and their
+ * outputs for some inputs are calculated by a plain reference. Then the
+ * networks are run through dnnrt:
+ *
+ *  - all the networks initialized at once, and forwarded in turn
+ *  - THREAD_NUM threads, each initializes its own dnn_runtime_t of one of
+ *    the networks at the same time, and forwards it repeatedly
+ *  - THREAD_NUM threads, each repeats initialize, a few forwards and
+ *    finalize of the networks in turn, so that runtimes needing scratch
+ *    buffers of different sizes come and go while others forward
+ *
+ * Every output must be identical to the reference. Affine of the host
+ * (host_functions.c) goes through the scratch buffer, so the test fails
+ * if variable buffers or scratch buffers are shared by running runtimes.
+ * Then wall time of the same forward propagations in one thread and in
+ * THREAD_NUM threads is measured. "dnnrt_parallel -t" runs only the test.
+ *
+ *   dnnrt_parallel [-t]
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <dnnrt/runtime.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define NET_NUM           3
+#define THREAD_NUM        6
+#define INPUT_NUM         8
+#define LAYER_MAX         3
+#define SIZE_MAX_ELEMS    512
+
+#define TEST_ITERATIONS   200
+#define BENCH_ITERATIONS  2000
+#define CYCLE_NUM         100
+#define CYCLE_ITERATIONS  3
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct net_spec
+{
+  int layer_num;                /* Number of affine layers */
+  int size[LAYER_MAX + 1];      /* Input size, and output size of layers */
+};
+
+struct net
+{
+  const struct net_spec *spec;
+  nn_network_t *network;
+  const float *weight[LAYER_MAX];
+  const float *bias[LAYER_MAX];
+  float *input[INPUT_NUM];
+  float *expect[INPUT_NUM];
+};
+
+struct blob
+{
+  uint8_t *top;
+  int used;
+  int capacity;
+};
+
+struct job
+{
+  int net_index;                /* Network of the 1st cycle */
+  pthread_barrier_t *barrier;   /* Start of threads, NULL in one thread */
+  int first_input;
+  int cycles;                   /* Number of initialize and finalize */
+  int iterations;               /* Forwards in each cycle */
+  int mismatch;
+  int err;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* A wake word like small network and classifier like ones. */
+
+static const struct net_spec s_specs[NET_NUM] =
+{
+  { 3, { 64, 128, 32, 10 } },
+  { 2, { 256, 64, 16 } },
+  { 2, { 32, 512, 8 } },
+};
+
+static struct net s_nets[NET_NUM];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static float rand_float(uint32_t *state)
+{
+  *state = *state * 1664525u + 1013904223u;
+  return (float)((*state >> 8) & 0xffff) / 65536.0f - 0.5f;
+}
+
+/*--------------------------------------------------------------------------*/
+static int blob_alloc(struct blob *b, int bsize)
+{
+  int offset = (b->used + 3) & ~3;
+
+  if (offset + bsize > b->capacity)
+    {
+      fprintf(stderr, "network blob overflow\n");
+      exit(1);
+    }
+
+  b->used = offset + bsize;
+  return offset;
+}
+
+/*--------------------------------------------------------------------------*/
+static void *blob_ptr(struct blob *b, int offset)
+{
+  return b->top + offset;
+}
+
+/*--------------------------------------------------------------------------*/
+static nn_list_t blob_list(struct blob *b, int size, const int *values)
+{
+  nn_list_t list;
+
+  list.size = size;
+  list.list = blob_alloc(b, size * sizeof(int));
+  memcpy(blob_ptr(b, list.list), values, size * sizeof(int));
+
+  return list;
+}
+
+/*--------------------------------------------------------------------------*/
+static float *blob_param(struct blob *b, int size, uint32_t *state,
+                         int *offset)
+{
+  float *param;
+
+  *offset = blob_alloc(b, size * sizeof(float));
+  param = (float *)blob_ptr(b, *offset);
+  for (int i = 0; i < size; i++)
+    {
+      param[i] = rand_float(state);
+    }
+
+  return param;
+}
+
+/*--------------------------------------------------------------------------*/
+static void set_variable(struct blob *b, int id, int dim0, int dim1,
+                         int data_index, int data)
+{
+  nn_network_t *n = (nn_network_t *)b->top;
+  nn_variable_t *v = (nn_variable_t *)blob_ptr(b, n->variables.list) + id;
+  int shape[2] = { dim0, dim1 };
+
+  v->shape = blob_list(b, dim1 ? 2 : 1, shape);
+  v->type = NN_DATA_TYPE_FLOAT;
+  v->fp_pos = 0;
+  v->data_index = data_index;
+  v->data = data;
+}
+
+/*--------------------------------------------------------------------------*/
+static void set_function(struct blob *b, int id, int type,
+                         int input_num, const int *inputs, int output)
+{
+  nn_network_t *n = (nn_network_t *)b->top;
+  nn_function_t *f = (nn_function_t *)blob_ptr(b, n->functions.list) + id;
+
+  f->type = type;
+  f->impl = DNNRT_IMPLEMENT;
+  f->inputs = blob_list(b, input_num, inputs);
+  f->outputs = blob_list(b, 1, &output);
+}
+
+/*--------------------------------------------------------------------------*/
+/* Layers are affine and ReLU in turn, one variable buffer for each
+ * variable except parameters.
+ */
+
+static void build_network(struct net *net, const struct net_spec *spec,
+                          uint32_t seed)
+{
+  int layers = spec->layer_num;
+  int buffer_num = 2 * layers;
+  int bsize[2 * LAYER_MAX];
+  struct blob b;
+  nn_network_t *n;
+  int var = 0;
+  int buf = 0;
+  int func = 0;
+  int prev;
+
+  b.capacity = 65536;
+  for (int l = 0; l < layers; l++)
+    {
+      b.capacity += (spec->size[l] + 1) * spec->size[l + 1] * sizeof(float);
+    }
+  b.top = (uint8_t *)calloc(1, b.capacity);
+  b.used = sizeof(nn_network_t);
+
+  n = (nn_network_t *)b.top;
+  n->version = 3;
+  n->variables.size = 4 * layers;
+  n->variables.list = blob_alloc(&b, n->variables.size *
+                                     sizeof(nn_variable_t));
+  n->functions.size = 2 * layers - 1;
+  n->functions.list = blob_alloc(&b, n->functions.size *
+                                     sizeof(nn_function_t));
+
+  bsize[buf] = spec->size[0] * sizeof(float);
+  set_variable(&b, var, 1, spec->size[0], buf++, 0);
+  n->inputs = blob_list(&b, 1, &var);
+  prev = var++;
+
+  for (int l = 0; l < layers; l++)
+    {
+      int in = spec->size[l];
+      int out = spec->size[l + 1];
+      int offset;
+      int inputs[3];
+
+      net->weight[l] = blob_param(&b, out * in, &seed, &offset);
+      set_variable(&b, var, out, in, -1, offset);
+      inputs[0] = prev;
+      inputs[1] = var++;
+
+      net->bias[l] = blob_param(&b, out, &seed, &offset);
+      set_variable(&b, var, out, 0, -1, offset);
+      inputs[2] = var++;
+
+      bsize[buf] = out * sizeof(float);
+      set_variable(&b, var, 1, out, buf++, 0);
+      set_function(&b, func++, NN_FUNCTION_AFFINE, 3, inputs, var);
+      prev = var++;
+
+      if (l < layers - 1)
+        {
+          bsize[buf] = out * sizeof(float);
+          set_variable(&b, var, 1, out, buf++, 0);
+          set_function(&b, func++, NN_FUNCTION_RELU, 1, &prev, var);
+          prev = var++;
+        }
+    }
+
+  n->outputs = blob_list(&b, 1, &prev);
+  n->buffers = blob_list(&b, buffer_num, bsize);
+
+  net->spec = spec;
+  net->network = n;
+}
+
+/*--------------------------------------------------------------------------*/
+static void reference_forward(const struct net *net, const float *input,
+                              float *output)
+{
+  const struct net_spec *spec = net->spec;
+  float buf[2][SIZE_MAX_ELEMS];
+  float *x = buf[0];
+  float *y = buf[1];
+  float *tmp;
+
+  memcpy(x, input, spec->size[0] * sizeof(float));
+
+  for (int l = 0; l < spec->layer_num; l++)
+    {
+      int in = spec->size[l];
+      int out = spec->size[l + 1];
+
+      for (int i = 0; i < out; i++)
+        {
+          float sum = net->bias[l][i];
+
+          for (int j = 0; j < in; j++)
+            {
+              sum += net->weight[l][i * in + j] * x[j];
+            }
+          y[i] = (l < spec->layer_num - 1 && sum < 0.0f) ? 0.0f : sum;
+        }
+
+      tmp = x;
+      x = y;
+      y = tmp;
+    }
+
+  memcpy(output, x, spec->size[spec->layer_num] * sizeof(float));
+}
+
+/*--------------------------------------------------------------------------*/
+static void setup_nets(void)
+{
+  uint32_t seed = 1;
+
+  for (int k = 0; k < NET_NUM; k++)
+    {
+      struct net *net = &s_nets[k];
+      const struct net_spec *spec = &s_specs[k];
+      int in = spec->size[0];
+      int out = spec->size[spec->layer_num];
+
+      build_network(net, spec, 100 + k);
+
+      for (int i = 0; i < INPUT_NUM; i++)
+        {
+          net->input[i] = (float *)malloc(in * sizeof(float));
+          net->expect[i] = (float *)malloc(out * sizeof(float));
+          for (int j = 0; j < in; j++)
+            {
+              net->input[i][j] = rand_float(&seed) * 4.0f;
+            }
+          reference_forward(net, net->input[i], net->expect[i]);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static void cleanup_nets(void)
+{
+  for (int k = 0; k < NET_NUM; k++)
+    {
+      for (int i = 0; i < INPUT_NUM; i++)
+        {
+          free(s_nets[k].input[i]);
+          free(s_nets[k].expect[i]);
+        }
+      free(s_nets[k].network);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static int forward_check(dnn_runtime_t *rt, const struct net *net, int idx)
+{
+  const void *inputs[1] = { net->input[idx] };
+  int out = net->spec->size[net->spec->layer_num];
+  int ret;
+
+  ret = dnn_runtime_forward(rt, inputs, 1);
+  if (ret != 0)
+    {
+      return ret;
+    }
+
+  return memcmp(dnn_runtime_output_buffer(rt, 0), net->expect[idx],
+                out * sizeof(float)) == 0 ? 0 : 1;
+}
+
+/*--------------------------------------------------------------------------*/
+static int check_shape(dnn_runtime_t *rt, const struct net *net)
+{
+  const struct net_spec *spec = net->spec;
+
+  return dnn_runtime_input_num(rt) == 1 &&
+         dnn_runtime_input_size(rt, 0) == spec->size[0] &&
+         dnn_runtime_output_num(rt) == 1 &&
+         dnn_runtime_output_size(rt, 0) == spec->size[spec->layer_num];
+}
+
+/*--------------------------------------------------------------------------*/
+static void run_cycle(struct job *job, struct net *net)
+{
+  dnn_runtime_t rt;
+  int ret;
+
+  job->err = dnn_runtime_initialize(&rt, net->network);
+  if (job->err != 0)
+    {
+      return;
+    }
+
+  if (!check_shape(&rt, net))
+    {
+      job->err = -1;
+    }
+
+  for (int k = 0; k < job->iterations && job->err == 0; k++)
+    {
+      ret = forward_check(&rt, net, (job->first_input + k) % INPUT_NUM);
+      if (ret < 0)
+        {
+          job->err = ret;
+        }
+      job->mismatch += ret > 0;
+    }
+
+  dnn_runtime_finalize(&rt);
+}
+
+/*--------------------------------------------------------------------------*/
+static void *run_job(void *arg)
+{
+  struct job *job = (struct job *)arg;
+
+  if (job->barrier)
+    {
+      pthread_barrier_wait(job->barrier);
+    }
+
+  for (int c = 0; c < job->cycles && job->err == 0; c++)
+    {
+      run_cycle(job, &s_nets[(job->net_index + c) % NET_NUM]);
+    }
+
+  return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+static void setup_jobs(struct job *jobs, int cycles, int iterations,
+                       pthread_barrier_t *barrier)
+{
+  for (int t = 0; t < THREAD_NUM; t++)
+    {
+      jobs[t].net_index = t % NET_NUM;
+      jobs[t].barrier = barrier;
+      jobs[t].first_input = t;
+      jobs[t].cycles = cycles;
+      jobs[t].iterations = iterations;
+      jobs[t].mismatch = 0;
+      jobs[t].err = 0;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static int check_jobs(const struct job *jobs)
+{
+  int result = 0;
+
+  for (int t = 0; t < THREAD_NUM; t++)
+    {
+      if (jobs[t].err != 0 || jobs[t].mismatch != 0)
+        {
+          printf("  NG: job %d, error %d, mismatch %d/%d\n",
+                 t, jobs[t].err, jobs[t].mismatch,
+                 jobs[t].cycles * jobs[t].iterations);
+          result = 1;
+        }
+    }
+
+  return result;
+}
+
+/*--------------------------------------------------------------------------*/
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_alive_at_once(void)
+{
+  dnn_runtime_t rt[NET_NUM];
+  int result = 0;
+  int ret;
+
+  printf("networks alive at once:\n");
+
+  for (int k = 0; k < NET_NUM; k++)
+    {
+      ret = dnn_runtime_initialize(&rt[k], s_nets[k].network);
+      if (ret != 0)
+        {
+          printf("  NG: initialize network %d, error %d\n", k, ret);
+          while (k-- > 0)
+            {
+              dnn_runtime_finalize(&rt[k]);
+            }
+          return 1;
+        }
+    }
+
+  for (int i = 0; i < INPUT_NUM; i++)
+    {
+      for (int k = 0; k < NET_NUM; k++)
+        {
+          ret = forward_check(&rt[k], &s_nets[k], i);
+          if (ret != 0)
+            {
+              printf("  NG: network %d, input %d, result %d\n", k, i, ret);
+              result = 1;
+            }
+        }
+    }
+
+  /* The rest must work after the first one is finalized. */
+
+  dnn_runtime_finalize(&rt[0]);
+  for (int k = 1; k < NET_NUM; k++)
+    {
+      if (forward_check(&rt[k], &s_nets[k], 0) != 0)
+        {
+          printf("  NG: network %d after finalize of network 0\n", k);
+          result = 1;
+        }
+      dnn_runtime_finalize(&rt[k]);
+    }
+
+  if (result == 0)
+    {
+      printf("  OK\n");
+    }
+  return result;
+}
+
+/*--------------------------------------------------------------------------*/
+static int run_parallel(int cycles, int iterations, double *elapsed)
+{
+  pthread_t threads[THREAD_NUM];
+  pthread_barrier_t barrier;
+  struct job jobs[THREAD_NUM];
+  double start;
+
+  pthread_barrier_init(&barrier, NULL, THREAD_NUM);
+  setup_jobs(jobs, cycles, iterations, &barrier);
+
+  start = now();
+  for (int t = 0; t < THREAD_NUM; t++)
+    {
+      pthread_create(&threads[t], NULL, run_job, &jobs[t]);
+    }
+  for (int t = 0; t < THREAD_NUM; t++)
+    {
+      pthread_join(threads[t], NULL);
+    }
+  *elapsed = now() - start;
+
+  pthread_barrier_destroy(&barrier);
+  return check_jobs(jobs);
+}
+
+/*--------------------------------------------------------------------------*/
+static int run_sequential(int iterations, double *elapsed)
+{
+  struct job jobs[THREAD_NUM];
+  double start;
+
+  setup_jobs(jobs, 1, iterations, NULL);
+
+  start = now();
+  for (int t = 0; t < THREAD_NUM; t++)
+    {
+      run_job(&jobs[t]);
+    }
+  *elapsed = now() - start;
+
+  return check_jobs(jobs);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  dnn_config_t config = { .cpu_num = 1 };
+  bool test_only = false;
+  int iterations;
+  double sequential;
+  double parallel;
+  double cycle;
+  int result = 0;
+
+  for (int i = 1; i < argc; i++)
+    {
+      if (strcmp(argv[i], "-t") == 0)
+        {
+          test_only = true;
+        }
+      else
+        {
+          printf("usage: %s [-t]\n", argv[0]);
+          return 1;
+        }
+    }
+
+  iterations = test_only ? TEST_ITERATIONS : BENCH_ITERATIONS;
+
+  setup_nets();
+  if (dnn_initialize(&config) != 0)
+    {
+      printf("Test NG\n");
+      return 1;
+    }
+
+  result |= test_alive_at_once();
+
+  printf("%d threads on %d networks:\n", THREAD_NUM, NET_NUM);
+  result |= run_parallel(1, iterations, &parallel);
+  result |= run_sequential(iterations, &sequential);
+  if (result == 0)
+    {
+      printf("  OK\n");
+    }
+
+  printf("%d threads, %d cycles of initialize/forward/finalize:\n",
+         THREAD_NUM, CYCLE_NUM);
+  if (run_parallel(CYCLE_NUM, CYCLE_ITERATIONS, &cycle) == 0)
+    {
+      printf("  OK\n");
+    }
+  else
+    {
+      result = 1;
+    }
+
+  dnn_finalize();
+  cleanup_nets();
+
+  if (result != 0)
+    {
+      printf("Test NG\n");
+      return 1;
+    }
+  printf("All tests OK\n");
+
+  if (!test_only)
+    {
+      int forwards = THREAD_NUM * iterations;
+
+      printf("bench (%d forward propagations, wall time):\n", forwards);
+      printf("  1 thread %7.1f ms, %d threads %7.1f ms\n",
+             sequential * 1e3, THREAD_NUM, parallel * 1e3);
+    }
+
+  return 0;
+}
@@ -0,0 +1,103 @@
+/****************************************************************************
+ * modules/dnnrt/tool/host/host_functions.c
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host replacement of functions/affine.c and functions/convolution.c,
+ * which need CMSIS-NN and nnabla-c-runtime.
+ *
+ * Affine of float is calculated from a copy of the input in the scratch
+ * buffer of the runtime, so that a scratch buffer used by two runtimes
+ * at once breaks the output. Convolution is not implemented.
+ */
+
+#include <string.h>
+#include <dnnrt/runtime.h>
+
+#include <context.h>
+#include <runtime/runtime_common.h>
+#include <runtime_internal.h>
+
+#define X (0)                   // x input
+#define WEIGHT (1)              // weight
+#define BIAS (2)                // bias
+#define Y (0)                   // y output
+
+static rt_function_error_t host_exec_affine(rt_function_t * f)
+{
+  int input_size = calc_shape_size(f->inputs[X]->shape);
+  int output_size = calc_shape_size(f->outputs[Y]->shape);
+  float *weight = (float *)f->inputs[WEIGHT]->data;
+  float *bias = f->num_of_inputs > BIAS ? (float *)f->inputs[BIAS]->data : 0;
+  float *y = (float *)f->outputs[Y]->data;
+  float *x = (float *)dnn_scratch_buf();
+
+  memcpy(x, f->inputs[X]->data, sizeof(float) * input_size);
+
+  for (int i = 0; i < output_size; i++)
+    {
+      float sum = bias ? bias[i] : 0.0f;
+
+      for (int j = 0; j < input_size; j++)
+        {
+          sum += weight[i * input_size + j] * x[j];
+        }
+      y[i] = sum;
+    }
+
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_return_value_t dnnrt_affine_alloc(nn_network_t * net,
+                                     void *function_context)
+{
+  rt_function_context_t *func = (rt_function_context_t *) function_context;
+
+  if (func->info->impl != DNNRT_IMPLEMENT ||
+      func->func.inputs[X]->type != NN_DATA_TYPE_FLOAT)
+    {
+      return RT_RET_FUNCTION_DONT_MATCH;
+    }
+
+  func->func.exec_func = host_exec_affine;
+
+  dnn_req_scratch_buf(sizeof(float) *
+                      calc_shape_size(func->func.inputs[X]->shape));
+  return RT_RET_FUNCTION_MATCH;
+}
+
+rt_return_value_t dnnrt_convolution_alloc(nn_network_t * net,
+                                          void *function_context)
+{
+  return RT_RET_FUNCTION_DONT_MATCH;
+}
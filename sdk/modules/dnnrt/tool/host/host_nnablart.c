@@ -0,0 +1,430 @@
+/****************************************************************************
+ * modules/dnnrt/tool/host/host_nnablart.c
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host replacement of nnabla-c-runtime, for the network layout given by
+ * dnnrt/nnablart/network.h of this directory.
+ *
+ * Same as nnabla-c-runtime, variable buffers are allocated in the order
+ * of their index by the allocator given by rt_set_variable_malloc(),
+ * which is global. Functions are allocated by the callbacks added to the
+ * context, and only ReLU is implemented here.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sdk/config.h>
+
+#include "context.h"
+#include "runtime_internal.h"
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static void *(*s_variable_malloc)(size_t size) = malloc;
+static void (*s_variable_free)(void *ptr) = free;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static rt_function_error_t host_exec_relu(rt_function_t *f)
+{
+  float *x = (float *)f->inputs[0]->data;
+  float *y = (float *)f->outputs[0]->data;
+  int size = calc_shape_size(f->inputs[0]->shape);
+
+  for (int i = 0; i < size; i++)
+    {
+      y[i] = x[i] > 0.0f ? x[i] : 0.0f;
+    }
+
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+/*--------------------------------------------------------------------------*/
+static rt_return_value_t host_allocate_function(rt_context_t *c,
+                                                rt_function_context_t *func)
+{
+  for (int i = 0; i < c->num_of_callbacks; i++)
+    {
+      if (c->callbacks[i].type == (nn_function_type_t)func->info->type &&
+          c->callbacks[i].allocator(c->network, func) ==
+            RT_RET_FUNCTION_MATCH)
+        {
+          return RT_RET_NOERROR;
+        }
+    }
+
+  if (func->info->type == NN_FUNCTION_RELU)
+    {
+      func->func.exec_func = host_exec_relu;
+      return RT_RET_NOERROR;
+    }
+
+  return RT_RET_ERROR_NO_MATCHING_FUNCTION;
+}
+
+/*--------------------------------------------------------------------------*/
+static rt_variable_t **host_variable_list(rt_context_t *c, nn_list_t list)
+{
+  int *ids = (int *)NN_GET(c->network, list.list);
+  rt_variable_t **vars =
+    (rt_variable_t **)calloc(list.size, sizeof(rt_variable_t *));
+
+  if (vars)
+    {
+      for (int i = 0; i < list.size; i++)
+        {
+          vars[i] = &c->variables[ids[i]];
+        }
+    }
+
+  return vars;
+}
+
+/*--------------------------------------------------------------------------*/
+static rt_context_t *host_context(rt_context_pointer context)
+{
+  return (rt_context_t *)context;
+}
+
+/*--------------------------------------------------------------------------*/
+static nn_variable_t *host_nn_variable(rt_context_pointer context, int id)
+{
+  nn_network_t *n = host_context(context)->network;
+
+  return (nn_variable_t *)NN_GET(n, n->variables.list) + id;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int calc_shape_size(rt_list_t shape)
+{
+  int size = 1;
+
+  for (int i = 0; i < shape.size; i++)
+    {
+      size *= shape.data[i];
+    }
+
+  return size;
+}
+
+/*--------------------------------------------------------------------------*/
+void rt_set_variable_malloc(void *(*user_malloc)(size_t size))
+{
+  s_variable_malloc = user_malloc;
+}
+
+/*--------------------------------------------------------------------------*/
+void rt_set_variable_free(void (*user_free)(void *ptr))
+{
+  s_variable_free = user_free;
+}
+
+/*--------------------------------------------------------------------------*/
+rt_return_value_t rt_allocate_context(rt_context_pointer *context)
+{
+  *context = calloc(1, sizeof(rt_context_t));
+
+  return *context ? RT_RET_NOERROR : RT_RET_ERROR_ALLOCATE_CONTEXT;
+}
+
+/*--------------------------------------------------------------------------*/
+rt_return_value_t rt_add_callback(rt_context_pointer context,
+                                  nn_function_type_t type,
+                                  rt_function_callback_t allocator)
+{
+  rt_context_t *c = host_context(context);
+
+  if (c->num_of_callbacks == HOST_CALLBACK_MAX)
+    {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+
+  c->callbacks[c->num_of_callbacks].type = type;
+  c->callbacks[c->num_of_callbacks].allocator = allocator;
+  c->num_of_callbacks++;
+
+  return RT_RET_NOERROR;
+}
+
+/*--------------------------------------------------------------------------*/
+rt_return_value_t rt_initialize_context(rt_context_pointer context,
+                                        nn_network_t *n)
+{
+  rt_context_t *c = host_context(context);
+  int *bsize = (int *)NN_GET(n, n->buffers.list);
+  nn_variable_t *vars = (nn_variable_t *)NN_GET(n, n->variables.list);
+  nn_function_t *funcs = (nn_function_t *)NN_GET(n, n->functions.list);
+  rt_return_value_t ret;
+
+  c->network = n;
+
+  c->buffers = (void **)calloc(n->buffers.size, sizeof(void *));
+  if (!c->buffers)
+    {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+  c->num_of_buffers = n->buffers.size;
+  for (int i = 0; i < c->num_of_buffers; i++)
+    {
+      c->buffers[i] = s_variable_malloc(n->version >= 3 ? bsize[i] :
+                                        bsize[i] * sizeof(float));
+      if (!c->buffers[i])
+        {
+          return RT_RET_ERROR_ALLOCATE_CONTEXT;
+        }
+    }
+
+  c->variables =
+    (rt_variable_t *)calloc(n->variables.size, sizeof(rt_variable_t));
+  if (!c->variables)
+    {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+  c->num_of_variables = n->variables.size;
+  for (int i = 0; i < c->num_of_variables; i++)
+    {
+      rt_variable_t *v = &c->variables[i];
+
+      if (vars[i].data_index >= c->num_of_buffers)
+        {
+          return RT_RET_ERROR_INVALID_BUFFER_INDEX;
+        }
+
+      v->type = (nn_data_type_t)vars[i].type;
+      v->fp_pos = vars[i].fp_pos;
+      v->shape.size = vars[i].shape.size;
+      v->shape.data = (int *)NN_GET(n, vars[i].shape.list);
+      v->data = vars[i].data_index >= 0 ? c->buffers[vars[i].data_index] :
+                                          NN_GET(n, vars[i].data);
+    }
+
+  c->functions = (rt_function_context_t *)
+    calloc(n->functions.size, sizeof(rt_function_context_t));
+  if (!c->functions)
+    {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+  c->num_of_functions = n->functions.size;
+  for (int i = 0; i < c->num_of_functions; i++)
+    {
+      rt_function_context_t *func = &c->functions[i];
+
+      func->info = &funcs[i];
+      func->func.num_of_inputs = funcs[i].inputs.size;
+      func->func.inputs = host_variable_list(c, funcs[i].inputs);
+      func->func.num_of_outputs = funcs[i].outputs.size;
+      func->func.outputs = host_variable_list(c, funcs[i].outputs);
+      if (!func->func.inputs || !func->func.outputs)
+        {
+          return RT_RET_ERROR_ALLOCATE_CONTEXT;
+        }
+
+      ret = host_allocate_function(c, func);
+      if (ret != RT_RET_NOERROR)
+        {
+          return ret;
+        }
+    }
+
+  c->num_of_inputs = n->inputs.size;
+  c->input_variable_ids = (int *)NN_GET(n, n->inputs.list);
+  c->num_of_outputs = n->outputs.size;
+  c->output_variable_ids = (int *)NN_GET(n, n->outputs.list);
+
+  return RT_RET_NOERROR;
+}
+
+/*--------------------------------------------------------------------------*/
+rt_return_value_t rt_free_context(rt_context_pointer *context)
+{
+  rt_context_t *c = host_context(*context);
+
+  if (c->functions)
+    {
+      for (int i = 0; i < c->num_of_functions; i++)
+        {
+          free(c->functions[i].func.inputs);
+          free(c->functions[i].func.outputs);
+        }
+      free(c->functions);
+    }
+  free(c->variables);
+
+  if (c->buffers)
+    {
+      for (int i = 0; i < c->num_of_buffers; i++)
+        {
+          if (c->buffers[i])
+            {
+              s_variable_free(c->buffers[i]);
+            }
+        }
+      free(c->buffers);
+    }
+
+  free(c);
+  *context = NULL;
+
+  return RT_RET_NOERROR;
+}
+
+/*--------------------------------------------------------------------------*/
+rt_return_value_t rt_forward(rt_context_pointer context)
+{
+  rt_context_t *c = host_context(context);
+
+  for (int i = 0; i < c->num_of_functions; i++)
+    {
+      rt_function_t *f = &c->functions[i].func;
+
+      if (f->exec_func(f) != RT_FUNCTION_ERROR_NOERROR)
+        {
+          return RT_RET_ERROR_FUNCTION_FAILED;
+        }
+    }
+
+  return RT_RET_NOERROR;
+}
+
+/*--------------------------------------------------------------------------*/
+int rt_num_of_input(rt_context_pointer context)
+{
+  return host_context(context)->num_of_inputs;
+}
+
+/*--------------------------------------------------------------------------*/
+int rt_input_size(rt_context_pointer context, size_t index)
+{
+  rt_context_t *c = host_context(context);
+
+  return calc_shape_size(c->variables[c->input_variable_ids[index]].shape);
+}
+
+/*--------------------------------------------------------------------------*/
+int rt_input_dimension(rt_context_pointer context, size_t index)
+{
+  rt_context_t *c = host_context(context);
+
+  return c->variables[c->input_variable_ids[index]].shape.size;
+}
+
+/*--------------------------------------------------------------------------*/
+int rt_input_shape(rt_context_pointer context, size_t index,
+                   size_t shape_index)
+{
+  rt_context_t *c = host_context(context);
+
+  return c->variables[c->input_variable_ids[index]].shape.data[shape_index];
+}
+
+/*--------------------------------------------------------------------------*/
+float *rt_input_buffer(rt_context_pointer context, size_t index)
+{
+  rt_context_t *c = host_context(context);
+
+  return (float *)c->variables[c->input_variable_ids[index]].data;
+}
+
+/*--------------------------------------------------------------------------*/
+nn_variable_t *rt_input_variable(rt_context_pointer context, size_t index)
+{
+  rt_context_t *c = host_context(context);
+
+  return host_nn_variable(context, c->input_variable_ids[index]);
+}
+
+/*--------------------------------------------------------------------------*/
+int rt_num_of_output(rt_context_pointer context)
+{
+  return host_context(context)->num_of_outputs;
+}
+
+/*--------------------------------------------------------------------------*/
+int rt_output_size(rt_context_pointer context, size_t index)
+{
+  rt_context_t *c = host_context(context);
+
+  return calc_shape_size(c->variables[c->output_variable_ids[index]].shape);
+}
+
+/*--------------------------------------------------------------------------*/
+int rt_output_dimension(rt_context_pointer context, size_t index)
+{
+  rt_context_t *c = host_context(context);
+
+  return c->variables[c->output_variable_ids[index]].shape.size;
+}
+
+/*--------------------------------------------------------------------------*/
+int rt_output_shape(rt_context_pointer context, size_t index,
+                    size_t shape_index)
+{
+  rt_context_t *c = host_context(context);
+
+  return c->variables[c->output_variable_ids[index]].shape.data[shape_index];
+}
+
+/*--------------------------------------------------------------------------*/
+float *rt_output_buffer(rt_context_pointer context, size_t index)
+{
+  rt_context_t *c = host_context(context);
+
+  return (float *)c->variables[c->output_variable_ids[index]].data;
+}
+
+/*--------------------------------------------------------------------------*/
+nn_variable_t *rt_output_variable(rt_context_pointer context, size_t index)
+{
+  rt_context_t *c = host_context(context);
+
+  return host_nn_variable(context, c->output_variable_ids[index]);
+}
+
+/*--------------------------------------------------------------------------*/
+/* mallinfo() of NuttX, see sdk/config.h */
+
+struct mallinfo mallinfo(void)
+{
+  struct mallinfo info;
+
+  memset(&info, 0, sizeof(info));
+  return info;
+}
@@ -0,0 +1,91 @@
+/****************************************************************************
+ * modules/dnnrt/tool/host/nnablart/runtime.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host replacement of <nnablart/runtime.h> of nnabla-c-runtime,
+ * implemented in host_nnablart.c.
+ */
+
+#ifndef __DNNRT_TOOL_HOST_NNABLART_RUNTIME_H
+#define __DNNRT_TOOL_HOST_NNABLART_RUNTIME_H
+
+#include <stddef.h>
+
+#include <dnnrt/nnablart/network.h>
+
+typedef void *rt_context_pointer;
+
+typedef enum
+{
+  RT_RET_NOERROR = 0,
+  RT_RET_ERROR_ALLOCATE_CONTEXT,
+  RT_RET_ERROR_INVALID_BUFFER_INDEX,
+  RT_RET_ERROR_NO_MATCHING_FUNCTION,
+  RT_RET_ERROR_FUNCTION_FAILED,
+  RT_RET_FUNCTION_MATCH,
+  RT_RET_FUNCTION_DONT_MATCH
+} rt_return_value_t;
+
+typedef rt_return_value_t (*rt_function_callback_t)(nn_network_t *net,
+                                                    void *function_context);
+
+void rt_set_variable_malloc(void *(*user_malloc)(size_t size));
+void rt_set_variable_free(void (*user_free)(void *ptr));
+
+rt_return_value_t rt_allocate_context(rt_context_pointer *context);
+rt_return_value_t rt_add_callback(rt_context_pointer context,
+                                  nn_function_type_t type,
+                                  rt_function_callback_t allocator);
+rt_return_value_t rt_initialize_context(rt_context_pointer context,
+                                        nn_network_t *network);
+rt_return_value_t rt_free_context(rt_context_pointer *context);
+rt_return_value_t rt_forward(rt_context_pointer context);
+
+int rt_num_of_input(rt_context_pointer context);
+int rt_input_size(rt_context_pointer context, size_t index);
+int rt_input_dimension(rt_context_pointer context, size_t index);
+int rt_input_shape(rt_context_pointer context, size_t index,
+                   size_t shape_index);
+float *rt_input_buffer(rt_context_pointer context, size_t index);
+nn_variable_t *rt_input_variable(rt_context_pointer context, size_t index);
+
+int rt_num_of_output(rt_context_pointer context);
+int rt_output_size(rt_context_pointer context, size_t index);
+int rt_output_dimension(rt_context_pointer context, size_t index);
+int rt_output_shape(rt_context_pointer context, size_t index,
+                    size_t shape_index);
+float *rt_output_buffer(rt_context_pointer context, size_t index);
+nn_variable_t *rt_output_variable(rt_context_pointer context, size_t index);
+
+#endif /* __DNNRT_TOOL_HOST_NNABLART_RUNTIME_H */
@@ -335,7 +335,7 @@ typedef struct
 
 typedef struct
 {
-  /*! \brief [in] Recovery direction (advance or delay) */
+  /*! \brief [in] Recovery direction (advance, delay or auto) */
 
   int8_t   direction;
 
@@ -261,6 +261,13 @@ typedef enum
   /*! \brief Adjust to the - direction */
 
   OutputMixDelay = 1,
+
+  /*! \brief Adjust automatically.
+   *         The drift is estimated from the level of the render queue,
+   *         and corrected by resampling. "times" is not used.
+   */
+
+  OutputMixAutoAdjust = 2,
 } AsClkRecoveryDirection;
 
 /**< Decodec PCM data send path  */
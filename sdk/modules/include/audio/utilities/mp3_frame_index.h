@@ -0,0 +1,215 @@
+/****************************************************************************
+ * modules/include/audio/utilities/mp3_frame_index.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef MODULES_INCLUDE_AUDIO_UTILITIES_MP3_FRAME_INDEX_H
+#define MODULES_INCLUDE_AUDIO_UTILITIES_MP3_FRAME_INDEX_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/* MP3 frame index class definition
+ *
+ * Maps a play time to the file offset of an MP3 frame, so that the
+ * playback can be started from any position without parsing the
+ * preceding data. The index is made from the Xing/Info or VBRI TOC
+ * when the file has it. Otherwise the frame headers are scanned once,
+ * and a sparse table is saved to "<file>.mfi" next to the file, to be
+ * loaded at the next time.
+ *
+ * The offset is given to PlayerFileSource::seek() (or the file
+ * position of the application's own feeder) before the player starts.
+ */
+
+class Mp3FrameIndex
+{
+public:
+  /*! \brief Max number of index entries. */
+
+  static const uint32_t MaxEntryNum = 256;
+
+  /*! \brief Initial time interval of entries made by scan. [ms] */
+
+  static const uint32_t DefaultEntryTime = 1000;
+
+  /*! \brief Size of read cache of the file. */
+
+  static const uint32_t CacheSize = 1024;
+
+  /** Where the index came from */
+
+  enum IndexSource
+  {
+    IndexSourceNone = 0,
+    IndexSourceXing,
+    IndexSourceVbri,
+    IndexSourceScan,
+    IndexSourceFile,
+  };
+
+  Mp3FrameIndex() :
+    m_fp(NULL),
+    m_source(IndexSourceNone),
+    m_entry_num(0),
+    m_entry_frames(0),
+    m_frame_samples(0),
+    m_duration(0),
+    m_sampling_rate(0),
+    m_data_offset(0),
+    m_data_end(0),
+    m_cache_offset(0),
+    m_cache_size(0)
+  {}
+
+  ~Mp3FrameIndex()
+  {
+    close();
+  }
+
+  /**
+   * @brief Open MP3 file and make frame index
+   *
+   * @details Load "<file_path>.mfi" if it is made from the same file,
+   *          or make the index from the TOC or by scan of the file.
+   *          The index made by scan is saved if "save_index" is true.
+   *
+   * @param[in] file_path:  Path of MP3 file
+   * @param[in] save_index: Save the index made by scan
+   *
+   * @retval result
+   */
+
+  bool open(const char *file_path, bool save_index = true);
+
+  /**
+   * @brief Close MP3 file
+   */
+
+  void close(void);
+
+  /**
+   * @brief Get the frame position of the time
+   *
+   * @details Get the file offset of the frame which includes the time.
+   *          The nearest index entry before the time is used, and the
+   *          frame headers from there are walked to the frame.
+   *
+   * @param[in]  time:   Play time from the top of the file [ms]
+   * @param[out] offset: File offset of the frame
+   * @param[out] start:  Play time of the frame [ms]
+   *
+   * @retval result
+   */
+
+  bool getPosition(uint32_t time, uint32_t *offset, uint32_t *start);
+
+  /**
+   * @brief Get duration of the file [ms]
+   */
+
+  uint32_t getDuration(void) const
+  {
+    return m_duration;
+  }
+
+  /**
+   * @brief Get sampling rate of the file [Hz]
+   */
+
+  uint32_t getSamplingRate(void) const
+  {
+    return m_sampling_rate;
+  }
+
+  /**
+   * @brief Get where the index came from
+   */
+
+  IndexSource getSource(void) const
+  {
+    return m_source;
+  }
+
+private:
+  struct FrameInfo
+  {
+    uint32_t size;
+    uint32_t samples;
+    uint32_t sampling_rate;
+    uint8_t  id;
+    uint8_t  mode;
+  };
+
+  struct IndexFileHeader
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t file_size;
+    uint32_t file_mtime;
+    uint32_t entry_num;
+    uint32_t entry_frames;
+    uint32_t frame_samples;
+    uint32_t duration;
+    uint32_t sampling_rate;
+    uint32_t data_offset;
+    uint32_t data_end;
+  };
+
+  bool readAt(uint32_t offset, uint8_t *buf, uint32_t size);
+  bool readFrame(uint32_t offset, FrameInfo *info);
+  bool findFrame(uint32_t *offset, FrameInfo *info);
+  bool isInfoFrame(uint32_t offset, const FrameInfo &info);
+  bool parseXing(uint32_t offset, const FrameInfo &info);
+  bool parseVbri(uint32_t offset, const FrameInfo &info);
+  bool scan(uint32_t offset);
+  void addEntry(uint32_t offset, uint32_t frame_no);
+  bool load(const char *index_path, const IndexFileHeader &file_info);
+  void save(const char *index_path, const IndexFileHeader &file_info);
+
+  FILE        *m_fp;
+  IndexSource  m_source;
+  uint32_t     m_entry_num;
+  uint32_t     m_entry_frames;
+  uint32_t     m_frame_samples;
+  uint32_t     m_duration;
+  uint32_t     m_sampling_rate;
+  uint32_t     m_data_offset;
+  uint32_t     m_data_end;
+  uint32_t     m_cache_offset;
+  uint32_t     m_cache_size;
+  uint32_t     m_entry[MaxEntryNum];
+  uint8_t      m_cache[CacheSize];
+};
+
+#endif /* MODULES_INCLUDE_AUDIO_UTILITIES_MP3_FRAME_INDEX_H */
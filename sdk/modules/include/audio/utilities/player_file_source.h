@@ -0,0 +1,229 @@
+/****************************************************************************
+ * modules/include/audio/utilities/player_file_source.h
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef MODULES_INCLUDE_AUDIO_UTILITIES_PLAYER_FILE_SOURCE_H
+#define MODULES_INCLUDE_AUDIO_UTILITIES_PLAYER_FILE_SOURCE_H
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <sys/types.h>
+#include "memutils/simple_fifo/CMN_SimpleFifo.h"
+#include "audio/audio_high_level_api.h"
+
+/* File source class definition
+ *
+ * Feeds the ES data of a file to the player through the SimpleFifo.
+ * The data is read by an own reader thread in units of read_size,
+ * directly into the FIFO buffer, so the application does not need
+ * to refill the FIFO. The reader thread sleeps while the FIFO has
+ * less than read_size bytes of space, and is woken by the low
+ * watermark of the FIFO when the player consumes the data.
+ */
+
+class PlayerFileSource
+{
+public:
+  /*! \brief Default read size. Multiple of the sector size. */
+
+  static const uint32_t DefaultReadSize = 4096;
+
+  /*! \brief Default priority of the reader thread. */
+
+  static const int DefaultPriority = 150;
+
+  /*! \brief Default stack size of the reader thread. */
+
+  static const int DefaultStackSize = 1024 * 2;
+
+  struct Param
+  {
+    /*! \brief [in] Buffer used as the SimpleFifo area.
+     *
+     * Should be 4 bytes aligned. To read N times ahead, give
+     * (N + 1) * read_size bytes. Multiple of read_size keeps every
+     * read aligned in the buffer.
+     */
+
+    void     *buffer;
+
+    /*! \brief [in] Size of buffer. */
+
+    uint32_t  buffer_size;
+
+    /*! \brief [in] Size of one read from the file.
+     *
+     * Multiple of 512 (sector size) is recommended.
+     */
+
+    uint32_t  read_size;
+
+    /*! \brief [in] Priority of the reader thread. */
+
+    int       priority;
+
+    /*! \brief [in] Stack size of the reader thread. */
+
+    int       stack_size;
+  };
+
+  PlayerFileSource() :
+    m_fd(-1),
+    m_eof(true),
+    m_error(false),
+    m_quit(false),
+    m_running(false),
+    m_read_size(0),
+    m_read_total(0)
+  {
+  }
+
+  /**
+   * @brief PlayerFileSource Destructor
+   */
+
+  ~PlayerFileSource()
+  {
+    deinit();
+  }
+
+  /**
+   * @brief Initialize the FIFO and start the reader thread
+   *
+   * @param[in] param: Buffer, read size and reader thread parameters.
+   *
+   * @retval     true  : success
+   * @retval     false : failure
+   */
+
+  bool init(const Param &param);
+
+  /**
+   * @brief Stop the reader thread
+   */
+
+  void deinit(void);
+
+  /**
+   * @brief Start to read a file
+   * @details The FIFO is filled before return, so the player can be
+   *          started right after this. The file descriptor is not
+   *          closed by this class.
+   *
+   * @param[in] fd: File descriptor opened for reading.
+   *
+   * @retval     true  : success
+   * @retval     false : failure
+   */
+
+  bool open(int fd);
+
+  /**
+   * @brief Stop to read the file and discard the data in the FIFO
+   */
+
+  void close(void);
+
+  /**
+   * @brief Move the read position of the file
+   * @details The data in the FIFO is discarded and the FIFO is filled
+   *          from the new position before return.
+   * @note Call this while the player is stopped.
+   *
+   * @param[in] offset: Offset from the top of the file in bytes.
+   *
+   * @retval     true  : success
+   * @retval     false : failure
+   */
+
+  bool seek(off_t offset);
+
+  /**
+   * @brief Whether the whole file is read into the FIFO
+   * @note Also true after a read error. Use hasError() to tell them.
+   *
+   * @retval     true  : reached the end of file
+   * @retval     false : not yet
+   */
+
+  bool isEof(void) const { return m_eof; }
+
+  /**
+   * @brief Whether a read error occurred
+   */
+
+  bool hasError(void) const { return m_error; }
+
+  /**
+   * @brief Read position of the file in bytes
+   */
+
+  off_t tell(void) const { return m_read_total; }
+
+  /**
+   * @brief Input device handler to set to the player
+   * @details Set to ram_handler of AsActivatePlayer or
+   *          AsSetPlayerStsParam.
+   */
+
+  AsPlayerInputDeviceHdlrForRAM *getInputDeviceHdlr(void)
+  {
+    return &m_input_device;
+  }
+
+private:
+  int                           m_fd;
+  volatile bool                 m_eof;
+  volatile bool                 m_error;
+  bool                          m_quit;
+  bool                          m_running;
+  uint32_t                      m_read_size;
+  off_t                         m_read_total;
+  CMN_SimpleFifoHandle          m_fifo;
+  AsPlayerInputDeviceHdlrForRAM m_input_device;
+  pthread_t                     m_pid;
+  pthread_mutex_t               m_lock;
+  sem_t                         m_space_sem;
+
+  void fill(void);
+  void run(void);
+
+  static void *entry(void *arg);
+  static void notifySpace(void *arg,
+                          CMN_SimpleFifoWatermarkEvent event,
+                          size_t occupied);
+  static void readDone(uint32_t size);
+};
+
+#endif /* MODULES_INCLUDE_AUDIO_UTILITIES_PLAYER_FILE_SOURCE_H */
@@ -36,7 +36,8 @@
 #ifndef MODULES_INCLUDE_AUDIO_UTILITIES_PLAYLIST_H
 #define MODULES_INCLUDE_AUDIO_UTILITIES_PLAYLIST_H
 
-#include "memutils/s_stl/queue.h"
+#include <stdio.h>
+#include <string.h>
 #include "audio/audio_high_level_api.h"
 
 /* Track information */
@@ -72,7 +73,19 @@ struct Track
   uint8_t   codec_type;
 };
 
-/* Playlist class definition */
+/* Playlist class definition
+ *
+ * The track database (csv) is converted to a binary index file
+ * "<track database>.idx" of fixed-size records and a string table
+ * "<track database>.str" at init() and updateTrackDb(). Any track is
+ * read with one seek, and playlists by artist or album are made by
+ * comparing hashes in the records without parsing the csv. When the
+ * csv is changed, only the added lines are indexed if the indexed part
+ * is not changed (checked by its hash), else the index is made again.
+ *
+ * Playlists (alias lists) are files of record numbers, and the
+ * selected one is loaded on memory.
+ */
 
 class Playlist
 {
@@ -135,10 +148,15 @@ public:
     m_repeat_mode(RepeatModeOff),
     m_list_type(ListTypeAllTrack),
     m_play_idx(-1),
-    m_track_db_fp(NULL)
+    m_list_loaded(false),
+    m_index_fp(NULL),
+    m_string_fp(NULL),
+    m_alias_list(NULL),
+    m_alias_num(0)
   {
     strncpy(m_track_db_file_name, file_name, sizeof(m_track_db_file_name));
     memset(m_playlist_path, 0, sizeof(m_playlist_path));
+    memset(m_list_key, 0, sizeof(m_list_key));
   }
 
   /**
@@ -306,12 +324,55 @@ public:
   bool restart(void);
 
 private:
-  bool open(FAR const char *mode);
+  /* Header of the index file */
+
+  struct IndexHeader
+  {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t record_num;
+    uint32_t string_size;
+    uint32_t db_size;
+    uint32_t db_mtime;
+    uint32_t db_hash;   /* Hash of the indexed part (db_size) of the csv */
+  };
+
+  /* Track record of the index file. Strings are the offsets in the
+   * string table, and author/album have their hash to filter.
+   */
+
+  struct IndexRecord
+  {
+    uint32_t title;
+    uint32_t author;
+    uint32_t album;
+    uint32_t author_hash;
+    uint32_t album_hash;
+    uint32_t sampling_rate;
+    uint8_t  channel_number;
+    uint8_t  bit_length;
+    uint8_t  codec_type;
+    uint8_t  reserved;
+  };
+
+  bool open(void);
   bool close(void);
-  bool readLine(FAR char *line, uint32_t line_size);
-  bool isTargetTrack(ListType       type,
-                     FAR const char *key_str,
-                     FAR Track      *track);
+  bool openIndex(void);
+  bool closeIndex(void);
+  bool buildIndex(FAR const IndexHeader *base);
+  bool checkDbPrefix(FAR FILE *db_fp, FAR const IndexHeader *base);
+  bool readLine(FAR FILE     *fp,
+                FAR char     *line,
+                uint32_t     line_size,
+                FAR uint32_t *hash);
+  bool readRecord(uint32_t record_no, FAR IndexRecord *record);
+  bool readString(uint32_t offset, FAR char *str, uint32_t size);
+  bool readTrack(uint32_t record_no, FAR Track *track);
+  bool isTargetTrack(ListType            type,
+                     FAR const char      *key_str,
+                     uint32_t            key_hash,
+                     FAR const IndexRecord *record);
   bool loadAliasList(void);
   bool shuffleList(int idx_top);
   bool parseTrackInfo(FAR Track *track, FAR char *line, uint32_t line_size);
@@ -319,6 +380,7 @@ private:
                    FAR const char *key_str,
                    FAR char       *file_name,
                    uint8_t        max_length);
+  void getDbFileName(FAR char *file_name, uint8_t max_length);
 
   static const int  FileNameMaxLength = 128;
   static const int  LineMaxLength     = 256;
@@ -328,12 +390,15 @@ private:
   RepeatMode m_repeat_mode;
   ListType   m_list_type;
   int        m_play_idx;
+  bool       m_list_loaded;
   char       m_list_key[64];
-  char       m_line_buffer[LineMaxLength];
   char       m_track_db_file_name[FileNameMaxLength];
-  FAR FILE   *m_track_db_fp;
+  FAR FILE   *m_index_fp;
+  FAR FILE   *m_string_fp;
+  IndexHeader m_index_header;
 
-  s_std::Queue<uint32_t, 256> m_alias_list;
+  FAR uint32_t *m_alias_list;
+  int           m_alias_num;
 };
 
 #endif /* MODULES_INCLUDE_AUDIO_UTILITIES_PLAYLIST_H */
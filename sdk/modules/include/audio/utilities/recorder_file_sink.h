@@ -0,0 +1,288 @@
+/****************************************************************************
+ * modules/include/audio/utilities/recorder_file_sink.h
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef MODULES_INCLUDE_AUDIO_UTILITIES_RECORDER_FILE_SINK_H
+#define MODULES_INCLUDE_AUDIO_UTILITIES_RECORDER_FILE_SINK_H
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <sys/types.h>
+#include "memutils/simple_fifo/CMN_SimpleFifo.h"
+#include "audio/audio_high_level_api.h"
+#include "audio/utilities/wav_containerformat.h"
+
+/* File sink class definition
+ *
+ * Writes the data which the recorder puts into the SimpleFifo to a
+ * file. A writer thread writes the data directly from the FIFO in
+ * batches of write_size, so that the file offset of every batch is
+ * a multiple of write_size. The writer thread sleeps until the high
+ * watermark of the FIFO tells that one batch is ready.
+ *
+ * For WAV files, the header is rewritten with the current data size
+ * and the file is synced every header_interval batches, so that the
+ * file is playable up to the last update even if the recording is
+ * interrupted.
+ */
+
+class RecorderFileSink
+{
+public:
+  /*! \brief Default write size. Multiple of the sector size. */
+
+  static const uint32_t DefaultWriteSize = 8192;
+
+  /*! \brief Default number of batches between the WAV header updates.
+   *
+   * Every batch, so that an interrupted recording loses at most the
+   * batch being written.
+   */
+
+  static const uint32_t DefaultHeaderInterval = 1;
+
+  /*! \brief Default priority of the writer thread. */
+
+  static const int DefaultPriority = 150;
+
+  /*! \brief Default stack size of the writer thread. */
+
+  static const int DefaultStackSize = 1024 * 2;
+
+  struct Param
+  {
+    /*! \brief [in] Buffer used as the SimpleFifo area.
+     *
+     * Should be 4 bytes aligned. Give several times of write_size so
+     * that the recorder can continue while a write is stalled.
+     */
+
+    void     *buffer;
+
+    /*! \brief [in] Size of buffer. Must be larger than write_size. */
+
+    uint32_t  buffer_size;
+
+    /*! \brief [in] Size of one write to the file.
+     *
+     * Multiple of 512 (sector size) is recommended.
+     */
+
+    uint32_t  write_size;
+
+    /*! \brief [in] Number of batches between the WAV header updates.
+     *
+     * DefaultHeaderInterval is recommended. A larger value saves the
+     * header writes and syncs, but an interrupted recording loses up
+     * to that number of batches. 0 updates the header only when the
+     * file is closed.
+     */
+
+    uint32_t  header_interval;
+
+    /*! \brief [in] Priority of the writer thread. */
+
+    int       priority;
+
+    /*! \brief [in] Stack size of the writer thread. */
+
+    int       stack_size;
+  };
+
+  struct Stats
+  {
+    /*! \brief Number of writes to the file */
+
+    uint32_t write_count;
+
+    /*! \brief Total size of the data written */
+
+    uint32_t write_bytes;
+
+    /*! \brief Total time spent in the writes in micro seconds */
+
+    uint32_t write_time_us;
+
+    /*! \brief Longest time of a write in micro seconds */
+
+    uint32_t max_write_time_us;
+
+    /*! \brief Sustained write bandwidth in bytes per second */
+
+    uint32_t bandwidth;
+
+    /*! \brief Maximum occupied size of the FIFO seen by the writer */
+
+    uint32_t max_occupied_size;
+  };
+
+  RecorderFileSink() :
+    m_fd(-1),
+    m_error(false),
+    m_quit(false),
+    m_running(false),
+    m_buffer(NULL),
+    m_write_size(0),
+    m_header_interval(DefaultHeaderInterval),
+    m_batch_cnt(0),
+    m_data_offset(0),
+    m_data_size(0),
+    m_prealloc_size(0),
+    m_container(NULL)
+  {
+  }
+
+  /**
+   * @brief RecorderFileSink Destructor
+   */
+
+  ~RecorderFileSink()
+  {
+    deinit();
+  }
+
+  /**
+   * @brief Initialize the FIFO and start the writer thread
+   *
+   * @param[in] param: Buffer, write size and writer thread parameters.
+   *
+   * @retval     true  : success
+   * @retval     false : failure
+   */
+
+  bool init(const Param &param);
+
+  /**
+   * @brief Stop the writer thread
+   */
+
+  void deinit(void);
+
+  /**
+   * @brief Start to write a file
+   * @details The data in the FIFO is discarded. If container is given,
+   *          the WAV header is written first. If prealloc_size is not
+   *          0, the file is extended to the size in advance, so that
+   *          no cluster is allocated while recording. The file
+   *          descriptor is not closed by this class.
+   *
+   * @param[in] fd:            File descriptor opened for writing.
+   * @param[in] container:     WAV container to make the header, or NULL
+   *                           for raw data.
+   * @param[in] prealloc_size: Size of the file to allocate in advance.
+   *
+   * @retval     true  : success
+   * @retval     false : failure
+   */
+
+  bool open(int fd, WavContainerFormat *container, uint32_t prealloc_size);
+
+  /**
+   * @brief Finish to write the file
+   * @details Call this after the recorder is stopped. The rest of the
+   *          data in the FIFO is written, the WAV header is updated and
+   *          the preallocated area which is not used is truncated.
+   *
+   * @retval     true  : success
+   * @retval     false : failure
+   */
+
+  bool close(void);
+
+  /**
+   * @brief Whether a write error occurred
+   * @note The data after the error is discarded.
+   */
+
+  bool hasError(void) const { return m_error; }
+
+  /**
+   * @brief Size of the data written to the file (without header)
+   */
+
+  uint32_t getDataSize(void) const { return m_data_size; }
+
+  /**
+   * @brief Get write statistics
+   *
+   * @param[out] stats: Statistics since the last open().
+   *
+   * Waits for the write in progress, if any.
+   */
+
+  void getStats(Stats *stats);
+
+  /**
+   * @brief Output device handler to set to the recorder
+   * @details Set to output_device_handler of AsSetRecorderStatusParam.
+   */
+
+  AsRecorderOutputDeviceHdlr *getOutputDeviceHdlr(void)
+  {
+    return &m_output_device;
+  }
+
+private:
+  int                        m_fd;
+  volatile bool              m_error;
+  bool                       m_quit;
+  bool                       m_running;
+  void                      *m_buffer;
+  uint32_t                   m_write_size;
+  uint32_t                   m_header_interval;
+  uint32_t                   m_batch_cnt;
+  uint32_t                   m_data_offset;
+  uint32_t                   m_data_size;
+  uint32_t                   m_prealloc_size;
+  WavContainerFormat        *m_container;
+  Stats                      m_stats;
+  CMN_SimpleFifoHandle       m_fifo;
+  AsRecorderOutputDeviceHdlr m_output_device;
+  pthread_t                  m_pid;
+  pthread_mutex_t            m_lock;
+  sem_t                      m_data_sem;
+
+  bool writeBatch(size_t size);
+  bool writeHeader(void);
+  void flush(bool all);
+  void run(void);
+
+  static void *entry(void *arg);
+  static void notifyData(void *arg,
+                         CMN_SimpleFifoWatermarkEvent event,
+                         size_t occupied);
+  static void writeDone(uint32_t size);
+};
+
+#endif /* MODULES_INCLUDE_AUDIO_UTILITIES_RECORDER_FILE_SINK_H */
@@ -128,7 +128,10 @@ struct handel_wav_parser_s
   uint32_t      file_size;
   uint32_t      data_size;
   uint32_t      read_size;
+  uint16_t      block;
   FILE          *fd;
+  const uint8_t *mem;
+  uint32_t      mem_size;
 };
 typedef struct handel_wav_parser_s handel_wav_parser_t;
 
@@ -153,6 +156,25 @@ public:
    */
   
   handel_wav_parser parseChunk(const char *file_path, fmt_chunk_t *fmt);
+
+  /**
+   * @brief Parse WAV container on memory
+   *
+   * @details Same as parseChunk() with file path, but parse the WAV
+   *          data on the buffer given by the caller, such as a whole
+   *          file loaded or memory-mapped. The buffer must be kept
+   *          until resetParser() is called.
+   *
+   * @param[in]  buffer: Address of WAV format data
+   * @param[in]  size:   Size of the data
+   * @param[out] fmt:    Information of FMT chunk
+   *
+   * @retval handle of the parser
+   */
+
+  handel_wav_parser parseChunk(const uint8_t *buffer,
+                               uint32_t size,
+                               fmt_chunk_t *fmt);
   
   /**
    * @brief Get Chunk List
@@ -195,6 +217,32 @@ public:
    */
   
   int32_t getDataChunk(handel_wav_parser handle, uint16_t format, int8_t *buffer, uint32_t size);
+
+  /**
+   * @brief Seek Data Chunk
+   *
+   * @details Move the read position of data chunk to the sample.
+   *          The position is sample accurate (block aligned).
+   *
+   * @param[in] handle: Handle of the parser
+   * @param[in] sample: Sample (frame) number from the top of data
+   *
+   * @retval result
+   */
+
+  bool seekDataChunk(handel_wav_parser handle, uint32_t sample);
+
+  /**
+   * @brief Tell Data Chunk
+   *
+   * @details Get the read position of data chunk.
+   *
+   * @param[in] handle: Handle of the parser
+   *
+   * @retval Sample (frame) number from the top of data
+   */
+
+  uint32_t tellDataChunk(handel_wav_parser handle);
   
   /**
    * @brief Reset Parser
@@ -136,6 +136,9 @@ int dnn_finalize(void);
   *       so applications don't have to give the network object to the other functions except this. <br>
   *       However, the runtime holds reference to the network object. <br>
   *       Applications must NOT free it until dnn_runtime_finalize().
+  * @note Each dnn_runtime_t has its own buffers, so different dnn_runtime_t objects <br>
+  *       can be initialized, forwarded and finalized by different threads at the same time. <br>
+  *       A dnn_runtime_t object must NOT be used by two threads at once.
   */
 int dnn_runtime_initialize(dnn_runtime_t * rt, const nn_network_t * network);
 
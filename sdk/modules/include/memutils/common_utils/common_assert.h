@@ -39,6 +39,15 @@
 #include "memutils/common_utils/common_macro.h"
 #include "assert.h"
 
+/* The host (Linux) assert.h does not have NuttX ASSERT().
+ * It must be evaluated even if NDEBUG, same as NuttX.
+ */
+
+#if defined(_LINUX_HOST) && !defined(ASSERT)
+#include <stdlib.h>
+#define ASSERT(exp) ((exp) ? (void)0 : abort())
+#endif
+
 /* static assert.
  * When exp evaluates to false, a compile error occurs.
  * Exp can describe only constant expressions
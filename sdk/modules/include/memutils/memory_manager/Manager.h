@@ -54,6 +54,7 @@
 
 #include "memutils/common_utils/common_errcode.h"
 #include "memutils/memory_manager/MemPool.h"
+#include "memutils/memory_manager/PoolStats.h"
 
 /**
  * @namespace MemMgrLite
@@ -161,6 +162,32 @@ public:
   static LockId  getPoolLockId(PoolId id) { return findPool(id)->getPoolLockId(); }
 #endif
 
+  /** Get the statistics of a memory pool.
+    * Number of segments and used segments are always available.
+    * Counters and used time are counted with
+    * CONFIG_MEMUTILS_MEMORY_MANAGER_STATS.
+    * @param[in]  id    The pool id.
+    * @param[out] stats The statistics.
+    * @return ERR_OK  : success
+    * @return ERR_ARG : error, the pool does not exist
+    */
+  static err_t  getPoolStats(PoolId id, PoolStats& stats);
+  static err_t  clearPoolStats(PoolId id);
+  static void   clearStaticPoolsStats(uint8_t sec);
+
+  /** Get the log of allocation errors from the oldest.
+    * @param[out] log The area to store the log.
+    * @param[in]  num Number of entries of the area.
+    * @return Number of stored entries.
+    */
+  static uint32_t  getAllocFailLog(AllocFailLog* log, uint32_t num);
+  static void  clearAllocFailLog();
+
+  /** Print the statistics of the pools of the section and
+    * the log of allocation errors.
+    */
+  static void  dumpPoolStats(uint8_t sec);
+
 #ifdef USE_MEMMGR_DEBUG_OUTPUT
 //  void    printInfo(PoolId id);
 #endif
@@ -214,9 +241,17 @@ private:
   static void      freeSeg(MemHandleBase& mh);
   static PoolAddr  getSegAddr(const MemHandleBase& mh);
   static PoolSize  getSegSize(const MemHandleBase& mh);
+  static err_t     shrinkSeg(MemHandleBase& mh, size_t size);
   static SegRefCnt getSegRefCnt(PoolId id, NumSeg seg_no) { return findPool(id)->getSegRefCnt(seg_no); }
   static void      incSegRefCnt(PoolId id, NumSeg seg_no) { findPool(id)->incSegRefCnt(seg_no); }
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS
+  /* Update the statistics after allocation and free. */
+
+  static void      countAllocStats(MemPool* pool, size_t size, err_t err);
+  static void      countFreeStats(MemPool* pool);
+#endif
+
 private:
   static Manager*  theManager;    /* for singleton */
 
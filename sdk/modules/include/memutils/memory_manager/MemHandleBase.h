@@ -129,10 +129,31 @@ public:
 #endif
   PoolAddr  getAddr() const { return Manager::getSegAddr(*this); }
   PoolSize  getSize() const { return Manager::getSegSize(*this); }
+
+  /** Shrink the segment to the size actually used.
+    * In RingBuf pool, the rest area is returned to the pool
+    * if the segment is the last allocated one.
+    * In other pools, the segment size does not change.
+    * @param[in] size The size to be used.
+    *  @return ERR_OK        : success
+    *  @return ERR_DATA_SIZE : error, size is over segment size
+    */
+  err_t   shrinkSeg(size_t size) { return Manager::shrinkSeg(*this, size); }
   SegRefCnt  getRefCnt() const { return Manager::getSegRefCnt(getPoolId(), getSegNo()); }
 
+  /* Hand over the reference without changing the reference count.
+   * (For passing the segment by message without copy)
+   * detach() makes this handle empty and returns the reference,
+   * attach() takes the reference returned by detach().
+   */
+
+  MemHandleProxy detach() { MemHandleProxy proxy = m_proxy; clear(); return proxy; }
+  void    attach(MemHandleProxy proxy) { freeSeg(); m_proxy = proxy; }
+
 private:
   friend class MemPool;
+  friend class BitmapPool;
+  friend class RingBufPool;
 
   struct SegInfo {
     PoolId    pool_id;
@@ -85,14 +85,14 @@ static inline void* translateVaToPa(void* addr)
       uint32_t pa;
       uint32_t va;
 
-      va = (uint32_t)addr;
+      va = (uint32_t)(uintptr_t)addr;
       tileId = (va >> 16) & 0xf;
-      cpuId  = *(volatile uint32_t *)((0x4c000000 | 0x02002000) + 0x40);
+      cpuId  = *(volatile uint32_t *)(uintptr_t)((0x4c000000 | 0x02002000) + 0x40);
       reg = (0x02012000 + 0x04) + (0x04 * (tileId / 2)) + ((cpuId - 2) * 0x20);
-      pa = *(volatile uint32_t *)(reg);
+      pa = *(volatile uint32_t *)(uintptr_t)(reg);
       tileVal = ((pa >> ((tileId & 0x1) * 16)) & 0x01ff) << 16;
 
-      return (void *)(0x0c000000 | tileVal | (va & 0xffff));
+      return (void *)(uintptr_t)(0x0c000000 | tileVal | (va & 0xffff));
     }
 
   return addr;
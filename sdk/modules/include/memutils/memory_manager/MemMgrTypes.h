@@ -104,7 +104,10 @@ enum
 
   /** the type number of fixed pools. (Now only support this type.) */
   BasicType,
+  /** the type number of pools of variable size segments in FIFO order. */
   RingBufType,
+  /** the type number of fixed pools managed by free segment bitmap. */
+  BitmapType,
   /** Number of types. */
   NumPoolTypes  /* number of pool types */
 };
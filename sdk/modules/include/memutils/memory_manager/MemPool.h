@@ -70,7 +70,11 @@ protected:
 	PoolAddr	getPoolAddr() const { return m_attr.addr; }
 	PoolSize	getPoolSize() const { return m_attr.size; }
 	NumSeg		getPoolNumSegs() const { return m_attr.num_segs; }
+#if defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL) || defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL)
+	NumSeg		getPoolNumAvailSegs() const;
+#else
 	NumSeg		getPoolNumAvailSegs() const { return m_seg_no_que.size(); }
+#endif
 #ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_FENCE
 	bool		isPoolFenceEnable() const { return m_attr.fence; }
 	void		initPoolFence();
@@ -95,6 +99,25 @@ protected:
 
 	uint32_t	getUsedSegs(MemHandleBase* mhs, uint32_t num_mhs);
 
+  /* Depth of the segment number queue.
+   * BitmapPool manages the usable segments by bitmap and RingBufPool
+   * uses the segment numbers in order, so they do not use the queue.
+   */
+
+	static NumSeg	getSegNoQueDepth(const PoolSectionAttr& attr) {
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+		if (attr.type == BitmapType) {
+			return 0;
+		}
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+		if (attr.type == RingBufType) {
+			return 0;
+		}
+#endif
+		return attr.num_segs;
+	}
+
   /* Get a segment from the memory pool.
    * Exclusive control should be done on the caller side.
    */
@@ -0,0 +1,74 @@
+/****************************************************************************
+ * modules/include/memutils/memory_manager/PoolStats.h
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef POOLSTATS_H_INCLUDED
+#define POOLSTATS_H_INCLUDED
+
+#include "memutils/common_utils/common_errcode.h"
+#include "memutils/memory_manager/MemMgrTypes.h"
+
+namespace MemMgrLite {
+
+/*****************************************************************
+ * Statistics of memory pool (snapshot)
+ * Average number of used segments is used_time / elapsed_time.
+ * Times are summed up on each allocation, free and getPoolStats(),
+ * so they are right as long as one of them is done in 71 minutes.
+ *****************************************************************/
+struct PoolStats {
+	uint32_t	alloc_count;	/* Number of allocated segments. */
+	uint32_t	free_count;	/* Number of segments returned to the pool. */
+	uint32_t	fail_count;	/* Number of allocation errors. */
+	NumSeg		num_segs;	/* Number of segments of the pool. */
+	NumSeg		cur_used;	/* Number of used segments. */
+	NumSeg		peak_used;	/* Max number of used segments. */
+	uint64_t	elapsed_time;	/* Time(us) from creation or clear. */
+	uint64_t	used_time;	/* Sum of used segments * time(us). */
+}; /* struct PoolStats */
+
+/*****************************************************************
+ * Log of allocation error
+ *****************************************************************/
+struct AllocFailLog {
+	uint32_t	time;		/* Time(us) of the error. */
+	uint32_t	size;		/* Requested size. */
+	int32_t		pid;		/* Task ID of the caller. */
+	PoolId		id;		/* Pool ID. */
+	err_t		err;		/* ERR_MEM_EMPTY or ERR_DATA_SIZE. */
+}; /* struct AllocFailLog */
+
+} /* namespace MemMgrLite */
+
+#endif /* POOLSTATS_H_INCLUDED */
@@ -119,7 +119,7 @@ public:
 	AssertLocationLog(const char* filename, int line, void* ret_addr) :
 		AssertInfoBase(AssertIdLocation, sizeof(*this)),
 		m_line(line),
-		m_ret_addr(reinterpret_cast<uint32_t>(ret_addr)),
+		m_ret_addr(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(ret_addr))),
 		m_filename()
 	{
 		size_t n = strlen(filename);
@@ -162,7 +162,7 @@ public:
 		m_epc(epc),
 		m_sr(sr),
 		m_bad_vaddr(bad_vaddr),
-		m_user_sp(reinterpret_cast<uint32_t>(uStk))
+		m_user_sp(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(uStk)))
 	{
 		if (uStk) {
 			memcpy(m_uStk, uStk, sizeof(m_uStk));
@@ -48,7 +48,7 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define DRM_TO_CACHED_VA(drm) (void*)(drm)
+#define DRM_TO_CACHED_VA(drm) (void*)(uintptr_t)(drm)
 
 /*****************************************************************
  * Type characteristic
@@ -183,6 +183,56 @@ public:
 		return true;
 	}
 
+  /* Get the element area following the specified element area. */
+
+	void* next_addr(const void* addr) const {
+		void* next = static_cast<uint8_t*>(const_cast<void*>(addr)) + elem_size();
+		return (next == getAddr(capacity())) ? getAddr(0) : next;
+	}
+
+  /* Single producer / single consumer operations without lock.
+   * The producer only updates m_put and the consumer only updates m_get.
+   * m_count is the only variable written by both, so it is updated
+   * atomically. Do not mix with the locked push/pop on the same queue.
+   */
+
+	NumT spsc_size() const { return __atomic_load_n(&m_count, __ATOMIC_SEQ_CST); }
+
+  /* Producer: get the tail element area, or NULL if full. */
+
+	void* spsc_reserve() const {
+		return (spsc_size() == capacity()) ? NULL : getAddr(m_put);
+	}
+
+  /* Producer: publish the element written at spsc_reserve() area. */
+
+	void spsc_commit() {
+		if (++m_put == capacity()) {
+			m_put = 0;
+		}
+		__atomic_fetch_add(&m_count, 1, __ATOMIC_SEQ_CST);
+	}
+
+  /* Consumer: get the head element area, or NULL if empty. */
+
+	void* spsc_front() const {
+		return (spsc_size() == 0) ? NULL : getAddr(m_get);
+	}
+
+  /* Consumer: release the head element. */
+
+	bool spsc_pop() {
+		if (spsc_size() == 0) return false;
+		if (FillAfterPop) {
+			memset(getAddr(m_get), FillAfterPop, elem_size());
+		}
+		if (++m_get == capacity()) {
+			m_get = 0;
+		}
+		__atomic_fetch_sub(&m_count, 1, __ATOMIC_SEQ_CST);
+		return true;
+	}
+
   /* Refer to the data at the head of the queue. */
 
 	template<typename T>
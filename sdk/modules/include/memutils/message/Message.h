@@ -54,7 +54,7 @@
 #include "memutils/message/MsgQueBlock.h"
 
 #define MSG_LIB_NAME  "MsgLib"
-#define MSG_LIB_VER   "2.03"
+#define MSG_LIB_VER   "2.04"
 #define MSG_QUE_NULL  0
 
 /*****************************************************************
@@ -74,6 +74,7 @@ struct MsgQueDef {
 #else
   uint16_t  spinlock;
 #endif
+  uint8_t   mode;     /* MsgQueMode. 0(MsgQueModeNormal) if omitted. */
 }; /* MsgQueDef */
 
 /*****************************************************************
@@ -159,6 +160,56 @@ public:
   /* Transmission of message packet.(task context, address range parameter) */
   static err_t send(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, const void* param, size_t param_size);
 
+#ifdef CONFIG_MEMUTILS_MESSAGE_MEMHANDLE
+  /* Transmission of message packet.(task context, reference of MemHandle) */
+  /** Send a memory segment to another task without copy.
+   *  The reference of mh is moved to the message and mh becomes empty
+   *  when this method succeeds. The receiver takes the reference by
+   *  MsgPacket::popMemHandle(), or it is released by pop().
+   *  The element size of the queue needs only 12 bytes.
+   *  @param[in] dest   Destination id
+   *  @param[in] pri    Priority
+   *  @param[in] type   Message Type
+   *  @param[in] reply  Reply id
+   *  @param[in,out] mh MemHandle to send
+   *  @return err_t error code.
+   */
+  static err_t sendMemHandle(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, MemMgrLite::MemHandle& mh);
+
+  /* Transmission of message packet.(non task context, reference of MemHandle) */
+  static err_t sendMemHandleIsr(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, MemMgrLite::MemHandle& mh);
+#endif
+
+  /* Transmission of multiple message packets.(task context, with parameters) */
+  /** Send Objects to another task at once.
+   *  This method sends num messages of the same type with one
+   *  queue lock. All messages are queued or nothing is queued.
+   *  @param[in] dest   Destination id
+   *  @param[in] pri    Priority
+   *  @param[in] type   Message Type
+   *  @param[in] reply  Reply id
+   *  @param[in] params Array of objects to send
+   *  @param[in] num    Number of objects
+   *  @return err_t error code.
+   */
+  template<typename T>
+  static err_t sendBatch(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, const T* params, uint32_t num)
+    {
+      FAR MsgQueBlock* que;
+      err_t            err_code = ERR_OK;
+
+      err_code = referMsgQueBlock(dest, &que);
+      if (err_code == ERR_OK)
+        {
+          return que->sendBatch(pri, type, reply, MsgBatchParam<T>(params), num);
+        }
+
+      return err_code;
+    }
+
+  /* Transmission of multiple message packets.(task context, address range parameters of the same size) */
+  static err_t sendBatch(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, const void* params, size_t param_size, uint32_t num);
+
   /* Transmission of message packet.(non task context, no parameters) */
   static err_t sendIsr(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply);
 
@@ -181,6 +232,22 @@ public:
   /* Transmission of message packet.(non task context, address range parameter) */
   static err_t sendIsr(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, const void* param, size_t param_size);
 
+  /** Get the statistics of message queue.
+   *  Occupancy and high-water mark are always available. Counters
+   *  and latency histogram need CONFIG_MEMUTILS_MESSAGE_STATS,
+   *  otherwise they are 0. Counters are of the calling CPU.
+   *  @param[in]  id     Message queue id
+   *  @param[out] stats  Snapshot of the statistics
+   *  @return err_t error code.
+   */
+  static err_t getStats(MsgQueId id, MsgQueStats& stats);
+
+  /* Clear the statistics and high-water mark of message queue. */
+  static err_t clearStats(MsgQueId id);
+
+  /* Print the statistics of all message queues. */
+  static void dumpStats();
+
   /* Notify message reception (call this API from inter-processor communication interrupt handler) */
   static err_t notifyRecv(MsgQueId dest);
 
@@ -42,6 +42,12 @@
 #include "memutils/common_utils/common_assert.h"	/* D_ASSERT */
 //#include "SpinLock.h"		/* MEMORY_BARRIER */
 #include "memutils/message/type_holder.h"	/* TypeHolder */
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+#include "memutils/os_utils/chateau_osal.h"	/* Chateau_GetTimeUs */
+#endif
+#ifdef CONFIG_MEMUTILS_MESSAGE_MEMHANDLE
+#include "memutils/memory_manager/MemHandle.h"	/* MemHandle */
+#endif
 
 #ifdef USE_MULTI_CORE
 #include "get_cpu_id.h"		/* GET_CPU_ID */
@@ -66,6 +72,16 @@ enum MsgPri
 	NumMsgPri /* Number of priority. */
 };
 
+enum MsgQueMode
+{
+  /* Access mode of message queue. */
+
+	MsgQueModeNormal,	/* Any task/ISR sends with lock. */
+	MsgQueModeSpsc		/* Single sender task and single receiver task.
+				 * Send and receive without lock.
+				 */
+};
+
 /* Message parameter type match check */
 #define MSG_PARAM_TYPE_MATCH_CHECK	false
 
@@ -87,12 +103,20 @@ public:
   /* Parameter is formatted with type. */
 
 	static const MsgFlags MsgFlagTypedParam = 0x40;
+
+  /* Parameter is a reference of memory segment (MemHandle). */
+
+	static const MsgFlags MsgFlagMemHandle	= 0x20;
 	MsgPacketHeader(MsgType type, MsgQueId reply, MsgFlags flags, uint16_t size = 0) :
 		m_type(type),
 		m_reply(reply),
 		m_src_cpu(GET_CPU_ID()),
 		m_flags(flags),
-		m_param_size(size) {}
+		m_param_size(size)
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+		, m_timestamp(Chateau_GetTimeUs())
+#endif
+		{}
 
 	MsgType  getType() const { return m_type; }
 	MsgQueId getReply() const { return m_reply; }
@@ -100,6 +124,9 @@ public:
 	MsgFlags getFlags() const { return m_flags; }
 	uint16_t getParamSize() const { return m_param_size; }
 	void     popParamNoDestruct() { m_param_size = 0; }
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+	uint32_t getTimestamp() const { return m_timestamp; }
+#endif
 
 protected:
 	bool isSelfCpu() const { return GET_CPU_ID() == getSrcCpu(); }
@@ -111,6 +138,9 @@ protected:
 	MsgCpuId	m_src_cpu;
 	MsgFlags	m_flags;
 	uint16_t	m_param_size;
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+	uint32_t	m_timestamp;	/* Send time(us). The header is 12 bytes. */
+#endif
 }; /* class MsgPacketHeader */
 
 /*****************************************************************
@@ -134,6 +164,57 @@ private:
 	size_t		m_param_size;
 };
 
+#ifdef CONFIG_MEMUTILS_MESSAGE_MEMHANDLE
+/*****************************************************************
+ * Class indicating that the reference of MemHandle is moved
+ * to the message parameter
+ * Only the reference (4 bytes) is queued, the segment data is
+ * not copied and the reference count is not changed.
+ *****************************************************************/
+class MsgMemHandleParam {
+public:
+	explicit MsgMemHandleParam(MemMgrLite::MemHandle& mh) :
+		m_mh(mh) {}
+	MemMgrLite::MemHandle& getMemHandle() const { return m_mh; }
+
+private:
+	MemMgrLite::MemHandle&	m_mh;
+};
+#endif
+
+/*****************************************************************
+ * Parameter array classes for batch sending
+ *****************************************************************/
+/* Array of typed parameters. */
+
+template<typename T>
+class MsgBatchParam {
+public:
+	typedef T ParamType;
+	explicit MsgBatchParam(const T* params) : m_params(params) {}
+	const T& operator[](uint32_t n) const { return m_params[n]; }
+
+private:
+	const T*	m_params;
+};
+
+/* Array of fixed size address range parameters. */
+
+class MsgBatchRangedParam {
+public:
+	typedef MsgRangedParam ParamType;
+	MsgBatchRangedParam(const void* params, size_t param_size) :
+		m_params(params),
+		m_param_size(param_size) {}
+	MsgRangedParam operator[](uint32_t n) const {
+		return MsgRangedParam(static_cast<const uint8_t*>(m_params) + n * m_param_size, m_param_size);
+	}
+
+private:
+	const void*	m_params;
+	size_t		m_param_size;
+};
+
 /*****************************************************************
  * Message Packet Class
  * In the instance copy of this class,
@@ -178,6 +259,22 @@ public:
 		m_param_size = 0;
 	}
 
+#ifdef CONFIG_MEMUTILS_MESSAGE_MEMHANDLE
+  /* Move the reference of MemHandle parameter to mh.
+   * The reference count is not changed.
+   */
+
+	void popMemHandle(MemMgrLite::MemHandle& mh) {
+		D_ASSERT(isMemHandleParam());
+		mh.attach(peekParamAny<MemMgrLite::MemHandleProxy>());
+		m_param_size = 0;
+	}
+
+	bool isMemHandleParam() const {
+		return (m_flags & MsgFlagMemHandle) && getParamSize() == sizeof(MemMgrLite::MemHandleProxy);
+	}
+#endif
+
 	void dump() const {
 		printf("T:%04x, R:%04x, C:%02x, F:%02x, S:%04x, P:",
 			m_type, m_reply, m_src_cpu, m_flags, m_param_size);
@@ -217,6 +314,23 @@ protected:
 		m_flags &= ~MsgFlagWaitParam; /* Clear the parameter write wait flag. */
 	}
 
+#ifdef CONFIG_MEMUTILS_MESSAGE_MEMHANDLE
+	void setParam(const MsgMemHandleParam& param, bool /* type_check */) {
+		*reinterpret_cast<MemMgrLite::MemHandleProxy*>(&m_param[0]) = param.getMemHandle().detach();
+		m_param_size = sizeof(MemMgrLite::MemHandleProxy);
+		m_flags |= MsgFlagMemHandle;
+		MEMORY_BARRIER();
+		m_flags &= ~MsgFlagWaitParam; /* Clear the parameter write wait flag. */
+	}
+
+  /* Release the reference which is not received. */
+
+	void releaseMemHandle() {
+		MemMgrLite::MemHandle mh;
+		popMemHandle(mh);
+	}
+#endif
+
 	bool isTypeCheckEnable() const { return MSG_PARAM_TYPE_MATCH_CHECK && isTypedParam(); }
 
   /* Reference parameters with arbitrary types without error checking. */
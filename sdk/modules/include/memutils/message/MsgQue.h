@@ -81,6 +81,26 @@ public:
 
 	MsgPacket* frontMsg() { return &front<MsgPacket>(); }
 	MsgPacket* backMsg()  { return &back<MsgPacket>(); }
+
+  /* Get the message packet following the specified one. */
+
+	MsgPacket* nextMsg(const MsgPacket* msg) const { return static_cast<MsgPacket*>(next_addr(msg)); }
+
+  /* Lock-free single producer / single consumer interface.
+   * The message becomes visible to the consumer by commitMsg().
+   */
+
+	using Base::spsc_size;
+	using Base::spsc_pop;
+
+	MsgPacket* reserveHeader(const MsgPacketHeader& header) {
+		void* area = spsc_reserve();
+		return (area) ? static_cast<MsgPacket*>(::new(area) MsgPacketHeader(header)) : NULL;
+	}
+
+	void commitMsg() { spsc_commit(); }
+
+	MsgPacket* peekMsg() { return static_cast<MsgPacket*>(spsc_front()); }
 }; /* class MsgQue */
 
 #endif /* MSG_QUE_H_INCLUDED */
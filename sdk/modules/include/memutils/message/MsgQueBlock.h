@@ -56,6 +56,7 @@
 #include "memutils/message/cache.h"
 #include "memutils/message/MsgQue.h"
 #include "memutils/message/MsgLog.h"
+#include "memutils/message/MsgStats.h"
 #ifdef USE_MULTI_CORE
 #include "SpinLockManager.h"	/* InterCpuLock::SpinLockId */
 #endif
@@ -85,10 +86,26 @@ public:
    */
   err_t recv(uint32_t ms, FAR MsgPacket **packet);
 
+  /** Receive multiple Objects at once.
+   * this method waits for a message like recv() and then takes
+   * the following messages in the same priority queue which are
+   * already sent, without waiting.
+   * @param[in] ms timeout time(millisecond)
+   * @param[out] **packets array of the pointers of Message packets.
+   * @param[in] max number of elements of packets.
+   * @param[out] *num number of received packets.
+   * @return err_t error code
+   */
+  err_t recvBatch(uint32_t ms, FAR MsgPacket **packets, uint32_t max, FAR uint32_t *num);
+
   /* Discard message packet. */
 
   err_t pop();
 
+  /* Discard num message packets received by recvBatch() at once. */
+
+  err_t popBatch(uint32_t num);
+
   /* Get CPU-ID of queue owner (recipient). */
 
 	MsgCpuId getOwner() const { return m_owner; }
@@ -97,6 +114,10 @@ public:
 
 	bool isShare() const { return m_spinlock != 0; }
 
+  /* Get whether it is a lock-free single producer/consumer queue or not. */
+
+	bool isSpsc() const { return m_mode == MsgQueModeSpsc; }
+
   /* Get message packet count. */
 
 	uint16_t getNumMsg(MsgPri pri) const;
@@ -107,6 +128,14 @@ public:
 
 	uint16_t getRest(MsgPri pri) const;
 
+  /* Get the peak number of message packets (high-water mark). */
+
+	uint16_t getMaxQueuing(MsgPri pri) const;
+
+  /* Clear the measurement values. */
+
+	void clearTally();
+
   /* Reset the information of message. */
 
   void reset()
@@ -115,6 +144,7 @@ public:
 
       Chateau_DeleteSemaphore(m_count_sem);
       Chateau_CreateSemaphore(&m_count_sem, 0, 0);
+      m_waiting = 0;
     }
 
   /* Debug only. */
@@ -132,7 +162,8 @@ protected:
   /* Dynamic initialization. */
 
   err_t setup(drm_t n_drm, uint16_t n_size, uint16_t n_num,
-    drm_t h_drm, uint16_t h_size, uint16_t h_num);
+    drm_t h_drm, uint16_t h_size, uint16_t h_num,
+    MsgQueMode mode = MsgQueModeNormal);
 
   /* Get queue element size. */
 
@@ -164,6 +195,33 @@ protected:
 	template<typename T>
 	err_t sendIsr(MsgPri pri, MsgType type, MsgQueId reply, const T& param);
 
+  /* Sending process of multiple messages from task context.
+   * (One lock for all messages. All or nothing is queued)
+   */
+
+	template<typename S>
+	err_t sendBatch(MsgPri pri, MsgType type, MsgQueId reply, const S& params, uint32_t num);
+
+  /* Message sending process of SPSC queue.
+   * (Without lock. Only one sender task or ISR per queue)
+   */
+
+	template<typename T>
+	err_t sendSpsc(MsgPri pri, MsgType type, MsgQueId reply, const T& param,
+		bool type_check, bool isr);
+
+  /* Update tally and wake up the receiver of SPSC queue. */
+
+	void notifySpsc(MsgPri pri, bool isr);
+
+  /* Message receiving process of SPSC queue. */
+
+	err_t recvSpsc(uint32_t ms, FAR MsgPacket **packet);
+
+  /* Wait for the message count semaphore. */
+
+	bool waitSem(uint32_t ms);
+
   /* Notify other CPU that sending message.
    * (H/W dependent part. User implements for each CPU)
    */
@@ -211,6 +269,10 @@ private:
 	uint16_t		m_pendingMsgCount;  /* Number of messages waiting
                                    * for parameter write.
                                    */
+	uint8_t			m_mode;             /* MsgQueMode. */
+	uint8_t			m_waiting;          /* Receiver of SPSC queue is waiting
+                                   * for the semaphore.
+                                   */
 	MsgQue			m_que[NumMsgPri]; /* Queue by priority. */
 	MsgQue*			m_cur_que;        /* Queue during message processing. */
 	Tally			m_tally;            /* Various measurement values. */
@@ -227,17 +289,23 @@ inline MsgQueBlock::MsgQueBlock(MsgQueId id, MsgCpuId owner, SpinLockId spinlock
 //	m_count_sem(0),
 	m_spinlock(spinlock),
 	m_pendingMsgCount(0),
+	m_mode(MsgQueModeNormal),
+	m_waiting(0),
 	m_cur_que(NULL),
 	m_tally()
 {
+#ifdef _LINUX_HOST
+	memset(&m_count_sem, 0, sizeof(m_count_sem));
+#else
 	m_count_sem.semcount = 0;
+#endif
 }
 
 /*****************************************************************
  * Dynamic initialization
  *****************************************************************/
 inline err_t MsgQueBlock::setup(drm_t n_drm, uint16_t n_size, uint16_t n_num,
-  drm_t h_drm, uint16_t h_size, uint16_t h_num)
+  drm_t h_drm, uint16_t h_size, uint16_t h_num, MsgQueMode mode)
 {
   /* What has not been initialized yet. */
 
@@ -246,6 +314,14 @@ inline err_t MsgQueBlock::setup(drm_t n_drm, uint16_t n_size, uint16_t n_num,
       return ERR_STS;
     }
 
+  /* SPSC queue is available only for nonshared queue. */
+
+  if (mode == MsgQueModeSpsc && isShare())
+    {
+      return ERR_STS;
+    }
+  m_mode = static_cast<uint8_t>(mode);
+
   /* Set queue address, element length, number of elements. */
 
   m_que[MsgPriNormal].init(n_drm, n_size, n_num);
@@ -312,6 +388,29 @@ inline uint16_t MsgQueBlock::getRest(MsgPri pri) const
 	return m_que[pri].rest();
 }
 
+/*****************************************************************
+ * Get the peak number of message packets
+ *****************************************************************/
+inline uint16_t MsgQueBlock::getMaxQueuing(MsgPri pri) const
+{
+	D_ASSERT2(pri == MsgPriNormal || pri == MsgPriHigh, AssertParamLog(AssertIdBadParam, pri));
+
+	if (!isOwn()) {
+		Dcache_clear_sync(this, sizeof(*this));
+	}
+	return m_tally.max_queuing[pri];
+}
+
+/*****************************************************************
+ * Clear the measurement values
+ *****************************************************************/
+inline void MsgQueBlock::clearTally()
+{
+	lock();
+	m_tally.clear();
+	unlock();
+}
+
 /*****************************************************************
  * Get the size of the transmitted message
  *****************************************************************/
@@ -340,6 +439,16 @@ inline size_t MsgQueBlock::getSendSize<MsgRangedParam>(const MsgRangedParam& par
 	return sizeof(MsgPacketHeader) + param.getParamSize();
 }
 
+#ifdef CONFIG_MEMUTILS_MESSAGE_MEMHANDLE
+/* Send message size(Reference of MemHandle). */
+
+template<>
+inline size_t MsgQueBlock::getSendSize<MsgMemHandleParam>(const MsgMemHandleParam& /* param */, bool /* type_check */)
+{
+	return sizeof(MsgPacketHeader) + sizeof(MemMgrLite::MemHandleProxy);
+}
+#endif
+
 
 /*****************************************************************
  * Class for acquiring message packet information
@@ -362,6 +471,14 @@ struct MsgPacketInfo<MsgRangedParam> {
 	static const bool null_param = false;
 };
 
+#ifdef CONFIG_MEMUTILS_MESSAGE_MEMHANDLE
+template<>
+struct MsgPacketInfo<MsgMemHandleParam> {
+	static const bool typed_param = false;
+	static const bool null_param = false;
+};
+#endif
+
 /*****************************************************************
  * Message sending process from task context
  *****************************************************************/
@@ -374,9 +491,17 @@ err_t MsgQueBlock::send(MsgPri pri, MsgType type, MsgQueId reply, MsgFlags flags
   size_t send_size = getSendSize(param, type_check);
   if (send_size > getElemSize(pri))
     {
+      MSG_STATS_SEND(m_id, pri, ERR_DATA_SIZE, 1);
       return ERR_DATA_SIZE;
     }
 
+  /* SPSC queue sends without lock. */
+
+  if (isSpsc())
+    {
+      return sendSpsc(pri, type, reply, param, type_check, false);
+    }
+
   /* Put the message packet header in the queue
    * and add the parameter after the interrupt is enabled.
    */
@@ -444,6 +569,7 @@ err_t MsgQueBlock::send(MsgPri pri, MsgType type, MsgQueId reply, MsgFlags flags
 
       unlock();
     }
+  MSG_STATS_SEND(m_id, pri, (msg) ? ERR_OK : ERR_QUE_FULL, 1);
   return (msg) ? ERR_OK : ERR_QUE_FULL;
 }
 
@@ -463,9 +589,17 @@ err_t MsgQueBlock::sendIsr(MsgPri pri, MsgType type, MsgQueId reply, const T& pa
   bool type_check = MSG_PARAM_TYPE_MATCH_CHECK && MsgPacketInfo<T>::typed_param;
   if (getSendSize(param, type_check) > getElemSize(pri))
     {
+      MSG_STATS_SEND(m_id, pri, ERR_DATA_SIZE, 1);
       return ERR_DATA_SIZE;
     }
 
+  /* SPSC queue sends without lock. */
+
+  if (isSpsc())
+    {
+      return sendSpsc(pri, type, reply, param, type_check, true);
+    }
+
   /* Queue the message packet header. */
 
   MsgPacket* msg = pushHeader(pri, MsgPacketHeader(type, reply, MsgPacket::MsgFlagNull));
@@ -482,9 +616,201 @@ err_t MsgQueBlock::sendIsr(MsgPri pri, MsgType type, MsgQueId reply, const T& pa
       Chateau_SignalSemaphoreIsr(m_count_sem);
       DUMP_MSG_SEQ(MsgSeqLog('i', m_id, pri, m_que[pri].size(), msg));
     }
+  MSG_STATS_SEND(m_id, pri, (msg) ? ERR_OK : ERR_QUE_FULL, 1);
   return (msg) ? ERR_OK : ERR_QUE_FULL;
 }
 
+/*****************************************************************
+ * Message sending process of SPSC queue
+ * The sender owns the put position and the receiver owns the get
+ * position, so the queue is not locked. The message is published
+ * by commitMsg() after the parameter is written, so that
+ * MsgFlagWaitParam handling is not needed.
+ *****************************************************************/
+template<typename T>
+err_t MsgQueBlock::sendSpsc(MsgPri pri, MsgType type, MsgQueId reply, const T& param,
+  bool type_check, bool isr)
+{
+  D_ASSERT2(pri == MsgPriNormal || pri == MsgPriHigh, AssertParamLog(AssertIdBadParam, pri));
+  D_ASSERT2(m_que[pri].is_init(), AssertParamLog(AssertIdBadMsgQueState, m_id, pri));
+  D_ASSERT2(isOwn(), AssertParamLog(AssertIdBadParam, m_id));
+
+  MsgPacket* msg = m_que[pri].reserveHeader(MsgPacketHeader(type, reply, MsgPacket::MsgFlagNull));
+  if (msg == NULL)
+    {
+      MSG_STATS_SEND(m_id, pri, ERR_QUE_FULL, 1);
+      return ERR_QUE_FULL;
+    }
+
+  /* Add parameter. (When there is no parameter, empty function) */
+
+  msg->setParam(param, type_check);
+
+  /* Publish the message to the receiver. */
+
+  m_que[pri].commitMsg();
+
+  DUMP_MSG_SEQ(MsgSeqLog((isr) ? 'i' : 's', m_id, pri, m_que[pri].spsc_size(), msg));
+
+  notifySpsc(pri, isr);
+
+  MSG_STATS_SEND(m_id, pri, ERR_OK, 1);
+
+  return ERR_OK;
+}
+
+/*****************************************************************
+ * Update tally and wake up the receiver of SPSC queue
+ *****************************************************************/
+inline void MsgQueBlock::notifySpsc(MsgPri pri, bool isr)
+{
+  uint16_t num = m_que[pri].spsc_size();
+  if (num > m_tally.max_queuing[pri])
+    {
+      m_tally.max_queuing[pri] = num;
+    }
+
+  /* Update total message count only when the receiver waits. */
+
+  if (__atomic_exchange_n(&m_waiting, 0, __ATOMIC_SEQ_CST))
+    {
+      if (isr)
+        {
+          Chateau_SignalSemaphoreIsr(m_count_sem);
+        }
+      else
+        {
+          Chateau_SignalSemaphoreTask(m_count_sem);
+        }
+    }
+}
+
+/*****************************************************************
+ * Sending process of multiple messages from task context
+ * The headers of all messages are queued under one lock, and the
+ * parameters are written after unlock in the same way as send().
+ * The message count is updated after all parameters are written,
+ * so the receiver does not wake up for a message waiting for
+ * parameter write.
+ *****************************************************************/
+template<typename S>
+err_t MsgQueBlock::sendBatch(MsgPri pri, MsgType type, MsgQueId reply, const S& params, uint32_t num)
+{
+  typedef typename S::ParamType T;
+
+  if (num == 0)
+    {
+      return ERR_OK;
+    }
+
+  /* Check that all messages fit in the element size of the queue. */
+
+  bool type_check = MSG_PARAM_TYPE_MATCH_CHECK && MsgPacketInfo<T>::typed_param && isOwn();
+  for (uint32_t i = 0; i < num; i++)
+    {
+      if (getSendSize(params[i], type_check) > getElemSize(pri))
+        {
+          MSG_STATS_SEND(m_id, pri, ERR_DATA_SIZE, num);
+          return ERR_DATA_SIZE;
+        }
+    }
+
+  /* SPSC queue sends without lock, and wakes up the receiver once. */
+
+  if (isSpsc())
+    {
+      /* Only the sender increases the number of messages,
+       * so the free space does not decrease after the check.
+       */
+
+      if (static_cast<uint32_t>(m_que[pri].capacity() - m_que[pri].spsc_size()) < num)
+        {
+          MSG_STATS_SEND(m_id, pri, ERR_QUE_FULL, num);
+          return ERR_QUE_FULL;
+        }
+
+      for (uint32_t i = 0; i < num; i++)
+        {
+          MsgPacket* msg = m_que[pri].reserveHeader(MsgPacketHeader(type, reply, MsgPacket::MsgFlagNull));
+          msg->setParam(params[i], type_check);
+          m_que[pri].commitMsg();
+        }
+
+      notifySpsc(pri, false);
+
+      MSG_STATS_SEND(m_id, pri, ERR_OK, num);
+      return ERR_OK;
+    }
+
+  MsgFlags flags = (MsgPacketInfo<T>::null_param) ?
+                   MsgPacket::MsgFlagNull : MsgPacket::MsgFlagWaitParam;
+
+  lock(); /* In the shared queue,
+           * the cache of the queue management area is also cleared.
+           */
+
+  if (m_que[pri].rest() < num)
+    {
+      unlock();
+      MSG_STATS_SEND(m_id, pri, ERR_QUE_FULL, num);
+      return ERR_QUE_FULL;
+    }
+
+  MsgPacket* top = NULL;
+  for (uint32_t i = 0; i < num; i++)
+    {
+      MsgPacket* msg = pushHeader(pri, MsgPacketHeader(type, reply, flags));
+      if (top == NULL)
+        {
+          top = msg;
+        }
+
+      if (isShare())
+        {
+          Dcache_flush_clear(msg, ROUND_UP(sizeof(MsgPacketHeader), CACHE_BLOCK_SIZE));
+        }
+    }
+
+  unlock(); /* In the shared queue, the cache flush
+             * of the queue management area is also performed.
+             */
+
+  /* Add parameters. (When there is no parameter, empty function) */
+
+  MsgPacket* msg = top;
+  for (uint32_t i = 0; i < num; i++)
+    {
+      msg->setParam(params[i], type_check);
+
+      if (!MsgPacketInfo<T>::null_param && isShare())
+        {
+          Dcache_flush_clear_sync(msg, ROUND_UP(getSendSize(params[i], type_check), CACHE_BLOCK_SIZE));
+        }
+
+      msg = m_que[pri].nextMsg(msg);
+    }
+
+  DUMP_MSG_SEQ_LOCK(MsgSeqLog('s', m_id, pri, m_que[pri].size(), top));
+
+  /* Update total message count. */
+
+  for (uint32_t i = 0; i < num; i++)
+    {
+      if (isShare() == false || isOwn())
+        {
+          Chateau_SignalSemaphoreTask(m_count_sem);
+        }
+      else
+        {
+          notifySend(m_owner, m_id);
+        }
+    }
+
+  MSG_STATS_SEND(m_id, pri, ERR_OK, num);
+
+  return ERR_OK;
+}
+
 /*****************************************************************
  * Insert a message packet header at the end of the queue
  * and return that address
@@ -537,20 +863,15 @@ inline err_t MsgQueBlock::recv(uint32_t ms, FAR MsgPacket **packet)
       return ERR_QUE_FULL;
     }
 
-retry:  /* Wait to receive. */
-
-  if (ms != TIME_FOREVER)
-    {
-      timespec tm;
-      tm.tv_sec = ms / 1000;
-      tm.tv_nsec = ms % 1000;
-      result = Chateau_TimedWaitSemaphore(m_count_sem, tm);
-    }
-  else
+  if (isSpsc())
     {
-      result = Chateau_WaitSemaphore(m_count_sem);
+      return recvSpsc(ms, packet);
     }
 
+retry:  /* Wait to receive. */
+
+  result = waitSem(ms);
+
   if (result == false)
     {
       return ERR_SEM_TAKE;
@@ -638,11 +959,239 @@ retry:  /* Wait to receive. */
 
   DUMP_MSG_SEQ_LOCK(MsgSeqLog('r', m_id, pri, m_que[pri].size(), msg));
 
+  MSG_STATS_RECV(m_id, msg);
+
   *packet = msg;
 
   return ERR_OK;
 }
 
+/*****************************************************************
+ * Wait for the message count semaphore
+ *****************************************************************/
+inline bool MsgQueBlock::waitSem(uint32_t ms)
+{
+  if (ms != TIME_FOREVER)
+    {
+      timespec tm;
+      tm.tv_sec = ms / 1000;
+      tm.tv_nsec = ms % 1000;
+      return Chateau_TimedWaitSemaphore(m_count_sem, tm);
+    }
+
+  return Chateau_WaitSemaphore(m_count_sem);
+}
+
+/*****************************************************************
+ * Receive message packet of SPSC queue
+ * The semaphore is signaled only when m_waiting is set, so
+ * the receiver checks the queues again after setting it.
+ * A surplus semaphore count only causes a spurious wakeup.
+ *****************************************************************/
+inline err_t MsgQueBlock::recvSpsc(uint32_t ms, FAR MsgPacket **packet)
+{
+  for (;;)
+    {
+      /* Get a pointer to the message packet of the queue
+       * with the highest priority.
+       */
+
+      MsgPri pri = (m_que[MsgPriHigh].is_init() && m_que[MsgPriHigh].spsc_size()) ?
+                   MsgPriHigh : MsgPriNormal;
+      MsgPacket* msg = m_que[pri].peekMsg();
+
+      if (msg != NULL)
+        {
+          m_cur_que = &m_que[pri];
+
+          DUMP_MSG_SEQ(MsgSeqLog('r', m_id, pri, m_que[pri].spsc_size(), msg));
+
+          MSG_STATS_RECV(m_id, msg);
+
+          *packet = msg;
+
+          return ERR_OK;
+        }
+
+      __atomic_store_n(&m_waiting, 1, __ATOMIC_SEQ_CST);
+
+      /* Check again, because the message may be sent
+       * before m_waiting is set.
+       */
+
+      if (m_que[MsgPriNormal].spsc_size() ||
+          (m_que[MsgPriHigh].is_init() && m_que[MsgPriHigh].spsc_size()))
+        {
+          __atomic_store_n(&m_waiting, 0, __ATOMIC_SEQ_CST);
+          continue;
+        }
+
+      if (waitSem(ms) == false)
+        {
+          __atomic_store_n(&m_waiting, 0, __ATOMIC_SEQ_CST);
+          return ERR_SEM_TAKE;
+        }
+    }
+}
+
+/*****************************************************************
+ * Receive multiple message packets
+ * The following messages are taken only while the message count
+ * can be taken without waiting, so that the count is kept equal
+ * to the number of messages which are not received yet.
+ *****************************************************************/
+inline err_t MsgQueBlock::recvBatch(uint32_t ms, FAR MsgPacket **packets, uint32_t max, FAR uint32_t *num)
+{
+  *num = 0;
+
+  if (max == 0)
+    {
+      return ERR_STS;
+    }
+
+  err_t err = recv(ms, &packets[0]);
+  if (err != ERR_OK)
+    {
+      return err;
+    }
+
+  if (isShare())
+    {
+      lock();
+    }
+
+  MsgQue* que = m_cur_que;
+  uint32_t avail = (isSpsc()) ? que->spsc_size() : que->size();
+  uint32_t n = 1;
+
+  while (n < max && n < avail)
+    {
+      MsgPacket* msg = que->nextMsg(packets[n - 1]);
+
+      if (msg->getFlags() & MsgPacket::MsgFlagWaitParam)
+        {
+          break;
+        }
+
+      /* SPSC queue does not count messages by the semaphore. */
+
+      if (!isSpsc() && !Chateau_PollingWaitSemaphore(m_count_sem))
+        {
+          break;
+        }
+
+      MSG_STATS_RECV(m_id, msg);
+      packets[n++] = msg;
+    }
+
+  if (isShare())
+    {
+      unlock();
+    }
+
+  *num = n;
+
+  return ERR_OK;
+}
+
+/*****************************************************************
+ * Discard message packets received by recvBatch
+ *****************************************************************/
+inline err_t MsgQueBlock::popBatch(uint32_t num)
+{
+  /* Check if own CPU is owned, and check Packet Received */
+
+  if (!(isOwn() && m_cur_que != NULL))
+    {
+      return ERR_STS;
+    }
+
+  uint32_t size = (isSpsc()) ? m_cur_que->spsc_size() : m_cur_que->size();
+  if (num == 0 || num > size)
+    {
+      return ERR_STS;
+    }
+
+  /* Check that the parameter length of all message packets
+   * to be discarded is 0.
+   */
+
+  MsgPacket* msg = m_cur_que->frontMsg();
+  for (uint32_t i = 0; i < num; i++)
+    {
+#ifdef CONFIG_MEMUTILS_MESSAGE_MEMHANDLE
+      if (msg->getParamSize() != 0 && !msg->isMemHandleParam())
+#else
+      if (msg->getParamSize() != 0)
+#endif
+        {
+          return ERR_MEM_BUSY;
+        }
+      msg = m_cur_que->nextMsg(msg);
+    }
+
+#ifdef CONFIG_MEMUTILS_MESSAGE_MEMHANDLE
+  /* Release the references of MemHandle which are not received.
+   * This is done after all packets are checked, so that nothing is
+   * released when the batch can not be discarded.
+   */
+
+  msg = m_cur_que->frontMsg();
+  for (uint32_t i = 0; i < num; i++)
+    {
+      if (msg->isMemHandleParam())
+        {
+          msg->releaseMemHandle();
+        }
+      msg = m_cur_que->nextMsg(msg);
+    }
+#endif
+
+  /* SPSC queue discards the packets without lock. */
+
+  if (isSpsc())
+    {
+      for (uint32_t i = 0; i < num; i++)
+        {
+          if (m_cur_que->spsc_pop() == false)
+            {
+              return ERR_QUE_FREE;
+            }
+        }
+      m_cur_que = NULL;
+      return ERR_OK;
+    }
+
+  lock();
+
+  for (uint32_t i = 0; i < num; i++)
+    {
+      msg = m_cur_que->frontMsg();
+
+      if (m_cur_que->pop() == false)
+        {
+          unlock();
+          return ERR_QUE_FREE;
+        }
+
+      /* In case of shared queue, clear cache of discarded packet area. */
+
+      if (isShare())
+        {
+#if MSG_FILL_VALUE_AFTER_POP == 0x00
+          Dcache_clear(msg, m_cur_que->elem_size());
+#else
+          Dcache_flush_clear(msg, m_cur_que->elem_size());
+#endif
+        }
+    }
+
+  m_cur_que = NULL; /* Make the packet unreceived state. */
+  unlock();
+
+  return ERR_OK;
+}
+
 /*****************************************************************
  * Discard message packet
  *****************************************************************/
@@ -661,11 +1210,32 @@ inline err_t MsgQueBlock::pop()
 
   MsgPacket* msg = m_cur_que->frontMsg();
 
+#ifdef CONFIG_MEMUTILS_MESSAGE_MEMHANDLE
+  /* Release the reference of MemHandle which is not received. */
+
+  if (msg->isMemHandleParam())
+    {
+      msg->releaseMemHandle();
+    }
+#endif
+
   if (msg->getParamSize() != 0)
     {
       return ERR_MEM_BUSY;
     }
 
+  /* SPSC queue discards the packet without lock. */
+
+  if (isSpsc())
+    {
+      if (m_cur_que->spsc_pop() == false)
+        {
+          return ERR_QUE_FREE;
+        }
+      m_cur_que = NULL;
+      return ERR_OK;
+    }
+
   lock();
 
   /* Discard the packet from the queue. */
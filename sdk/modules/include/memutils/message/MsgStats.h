@@ -0,0 +1,127 @@
+/****************************************************************************
+ * modules/include/memutils/message/MsgStats.h
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef MSG_STATS_H_INCLUDED
+#define MSG_STATS_H_INCLUDED
+
+#include "memutils/common_utils/common_types.h"
+#include "memutils/common_utils/common_errcode.h"
+#include "memutils/os_utils/chateau_osal.h"
+#include "memutils/message/MsgPacket.h"
+
+/* Number of latency histogram bins.
+ * Bin 0 is less than 1us, bin n (n >= 1) is [2^(n-1), 2^n) us,
+ * and the last bin includes all larger values.
+ */
+
+#define MSG_STATS_LATENCY_BINS	20
+
+/*****************************************************************
+ * Statistics of message queue (snapshot)
+ *****************************************************************/
+struct MsgQueStats {
+	uint32_t	send_count[NumMsgPri];	/* Number of sent messages. */
+	uint32_t	recv_count;		/* Number of received messages. */
+	uint32_t	err_que_full;		/* Number of ERR_QUE_FULL of send. */
+	uint32_t	err_data_size;		/* Number of ERR_DATA_SIZE of send. */
+	uint16_t	capacity[NumMsgPri];	/* Number of queue elements. */
+	uint16_t	cur_num[NumMsgPri];	/* Number of stored messages. */
+	uint16_t	high_water[NumMsgPri];	/* Max number of stored messages. */
+	uint16_t	param_max;		/* Max parameter size of received messages. */
+	uint32_t	latency_max;		/* Max send-to-recv time(us). */
+	uint32_t	latency_total;		/* Total send-to-recv time(us). */
+	uint32_t	latency_hist[MSG_STATS_LATENCY_BINS];
+};
+
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+#ifndef CONFIG_MEMUTILS_MESSAGE_STATS_MAX_QUEUES
+#define CONFIG_MEMUTILS_MESSAGE_STATS_MAX_QUEUES 32
+#endif
+
+/*****************************************************************
+ * Statistics counter table
+ * The table is per CPU. Send counters are counted by the sender
+ * CPU and receive counters by the owner CPU.
+ *****************************************************************/
+class MsgStats {
+public:
+	static MsgQueStats* get(MsgQueId id) {
+		return (id < CONFIG_MEMUTILS_MESSAGE_STATS_MAX_QUEUES) ? &m_stats[id] : NULL;
+	}
+
+	static void countSend(MsgQueId id, MsgPri pri, err_t err, uint32_t num) {
+		MsgQueStats* p = get(id);
+		if (p == NULL) return;
+		uint32_t* cnt = (err == ERR_OK)        ? &p->send_count[pri] :
+				(err == ERR_QUE_FULL)  ? &p->err_que_full :
+				(err == ERR_DATA_SIZE) ? &p->err_data_size : NULL;
+		if (cnt) {
+			__atomic_fetch_add(cnt, (err == ERR_OK) ? num : 1, __ATOMIC_RELAXED);
+		}
+	}
+
+  /* Called only by the receiver task of the queue. */
+
+	static void countRecv(MsgQueId id, const MsgPacket* msg) {
+		MsgQueStats* p = get(id);
+		if (p == NULL) return;
+		p->recv_count++;
+		p->param_max = MAX(p->param_max, msg->getParamSize());
+		if (msg->getSrcCpu() != GET_CPU_ID()) return; /* Clock is per CPU. */
+
+		uint32_t lat = Chateau_GetTimeUs() - msg->getTimestamp();
+		uint32_t bin = (lat == 0) ? 0 : 32 - __builtin_clz(lat);
+		p->latency_hist[MIN(bin, MSG_STATS_LATENCY_BINS - 1)]++;
+		p->latency_total += lat;
+		p->latency_max = MAX(p->latency_max, lat);
+	}
+
+	static void clear(MsgQueId id) {
+		MsgQueStats* p = get(id);
+		if (p) memset(p, 0x00, sizeof(*p));
+	}
+
+private:
+	static MsgQueStats	m_stats[CONFIG_MEMUTILS_MESSAGE_STATS_MAX_QUEUES];
+}; /* class MsgStats */
+
+#define MSG_STATS_SEND(id, pri, err, num)	MsgStats::countSend((id), (pri), (err), (num))
+#define MSG_STATS_RECV(id, msg)		MsgStats::countRecv((id), (msg))
+#else
+#define MSG_STATS_SEND(id, pri, err, num)
+#define MSG_STATS_RECV(id, msg)
+#endif /* CONFIG_MEMUTILS_MESSAGE_STATS */
+
+#endif /* MSG_STATS_H_INCLUDED */
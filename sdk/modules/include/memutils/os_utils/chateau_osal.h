@@ -222,6 +222,96 @@ static INLINE size_t Chateau_CountSemaphore(Chateau_sem_handle_t h) {
 #define Chateau_StartCyclicHandler(h) F_ASSERT(SYS_StartCyclicHandler(h) == 0)
 #define Chateau_StopCyclicHandler(h) F_ASSERT(SYS_StopCyclicHandler(h) == 0)
 
+#elif defined(_LINUX_HOST) /* For host (Linux/pthreads) build */
+#include <sys/types.h>
+#include <unistd.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <pthread.h>
+#include <errno.h>
+#include <time.h>
+#include "memutils/os_utils/os_wrapper.h"
+
+#ifndef FAR
+#define FAR
+#endif
+
+/* There is no interrupt on the host, so "interrupt lock" is emulated
+ * by one process wide recursive mutex. It keeps the same semantics
+ * as disabling interrupts on the target (all queues are serialized).
+ * Not static, so that all translation units (C++ only) share one lock.
+ */
+
+inline pthread_mutex_t* Chateau_HostLockObject(void) {
+	static pthread_mutex_t s_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+	return &s_lock;
+}
+
+#define Chateau_DelayTask(ms)  (usleep((ms)*1000))
+#define Chateau_EnableInterrupt(irq)
+#define Chateau_DisableInterrupt(irq)
+
+#define Chateau_GetInterruptMask() (0)
+#define Chateau_IsTaskContext() (1)
+
+#define Chateau_LockInterrupt(pContext)					\
+    do {                                                                \
+        F_ASSERT(pthread_mutex_lock(Chateau_HostLockObject()) == 0);    \
+        (void)pContext;                                                 \
+    } while(0)
+#define Chateau_LockInterruptIsr(pContext)  Chateau_LockInterrupt(pContext)
+#define Chateau_UnlockInterrupt(pContext)                               \
+    do {                                                                \
+        F_ASSERT(pthread_mutex_unlock(Chateau_HostLockObject()) == 0);  \
+        (void)pContext;                                                 \
+    } while(0)
+#define Chateau_UnlockInterruptIsr(pContext) Chateau_UnlockInterrupt(pContext)
+
+#define TIME_FOREVER	(unsigned)TMO_FEVR
+typedef sem_t	Chateau_sem_handle_t;
+#define Chateau_CreateSemaphore(pH, ini, max)				\
+	do {    F_ASSERT((sem_init(pH, 0, ini)) == 0);	\
+	} while(0)
+#define Chateau_DeleteSemaphore(h)  F_ASSERT(sem_destroy(&h) == 0)
+#define Chateau_SignalSemaphore(h)      F_ASSERT(sem_post(&h)		== 0)
+#define Chateau_SignalSemaphoreTask(h)  F_ASSERT(sem_post(&h)		== 0)
+#define Chateau_SignalSemaphoreIsr(h)   F_ASSERT(sem_post(&h)		== 0)
+#define Chateau_WaitSemaphore(h)        Chateau_HostWaitSemaphore(&h)
+#define Chateau_PollingWaitSemaphore(h) (sem_trywait(&h)	== 0)
+#define Chateau_TimedWaitSemaphore(h, tm) Chateau_HostTimedWaitSemaphore(&h, &tm)
+
+/* Free running time in microseconds. (wraps around in 71 minutes) */
+
+static INLINE uint32_t Chateau_GetTimeUs(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)ts.tv_sec * 1000000u + (uint32_t)(ts.tv_nsec / 1000);
+}
+
+/* Retry on EINTR, which never happens on the target. */
+
+static INLINE bool Chateau_HostWaitSemaphore(sem_t* h) {
+	int ret;
+	while ((ret = sem_wait(h)) != 0 && errno == EINTR) ;
+	return ret == 0;
+}
+
+/* The timeout is given as relative time, convert it to absolute time. */
+
+static INLINE bool Chateau_HostTimedWaitSemaphore(sem_t* h, const struct timespec* tm) {
+	struct timespec abs;
+	int ret;
+	clock_gettime(CLOCK_REALTIME, &abs);
+	abs.tv_sec += tm->tv_sec;
+	abs.tv_nsec += tm->tv_nsec;
+	if (abs.tv_nsec >= 1000000000L) {
+		abs.tv_sec++;
+		abs.tv_nsec -= 1000000000L;
+	}
+	while ((ret = sem_timedwait(h, &abs)) != 0 && errno == EINTR) ;
+	return ret == 0;
+}
+
 #elif defined(_POSIX)
 #include <sys/types.h>
 #include <unistd.h>
@@ -229,6 +319,9 @@ static INLINE size_t Chateau_CountSemaphore(Chateau_sem_handle_t h) {
 #include <semaphore.h>
 #include <time.h>
 #include <nuttx/arch.h>
+#ifdef CONFIG_ARCH_CHIP_CXD56XX
+#include <arch/chip/cxd56_hrtime.h>
+#endif
 #include "memutils/os_utils/os_wrapper.h"
 #define Chateau_DelayTask(ms)  (usleep((ms)*1000))
 #define Chateau_EnableInterrupt(irq) up_enable_irq(irq)
@@ -274,6 +367,22 @@ typedef sem_t	Chateau_sem_handle_t;
 #define Chateau_SignalSemaphoreIsr(h)   F_ASSERT(sem_post(&h)		== 0)
 #define Chateau_TimedWaitSemaphore(h, tm)        (sem_timedwait(&h, &tm)	== 0)
 #define Chateau_WaitSemaphore(h)        (sem_wait(&h)	== 0)
+#define Chateau_PollingWaitSemaphore(h) (sem_trywait(&h)	== 0)
+
+/* Free running time in microseconds. (wraps around in 71 minutes)
+ * clock_gettime() only advances once per system tick (CONFIG_USEC_PER_TICK),
+ * so use the SysTick based clock where the chip provides one.
+ */
+
+static INLINE uint32_t Chateau_GetTimeUs(void) {
+#ifdef CONFIG_ARCH_CHIP_CXD56XX
+	return cxd56_hrtime_us();
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)ts.tv_sec * 1000000u + (uint32_t)(ts.tv_nsec / 1000);
+#endif
+}
 //static INLINE bool Chateau_TimedWaitSemaphore(Chateau_sem_handle_t h,uint32_t ms) {
 //	if(ms != TIME_FOREVER){
 //		timespec t;
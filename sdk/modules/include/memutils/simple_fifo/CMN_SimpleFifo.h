@@ -67,6 +67,38 @@
 #include <stddef.h>
 #include <stdint.h>
 
+/*!
+ * @brief Watermark events notified by CMN_SimpleFifoNotifyFunc.
+ *
+ * @sa CMN_SimpleFifoSetWatermark
+ */
+typedef enum {
+    CMN_SIMPLE_FIFO_HIGH_WATERMARK = 0, //!< Occupied size has reached the high watermark by offer/commit.
+    CMN_SIMPLE_FIFO_LOW_WATERMARK = 1 //!< Occupied size has fallen to the low watermark by poll/release.
+} CMN_SimpleFifoWatermarkEvent;
+
+/*!
+ * @brief Watermark value which disables the notification.
+ */
+#define CMN_SIMPLE_FIFO_NO_WATERMARK ((size_t)-1)
+
+/*!
+ * @brief Definition of watermark notification function.
+ *
+ * It is called in the context of the writer (high watermark) or the
+ * reader (low watermark) which updated the FIFO. It should return
+ * quickly, e.g. post a semaphore or send a message to the task which
+ * handles the event.
+ *
+ * @param[in] pNotifyExtInfo Info set by CMN_SimpleFifoSetWatermark().
+ * @param[in] event Notified event.
+ * @param[in] szOccupied Occupied size of the FIFO seen by the caller.
+ */
+typedef void (*CMN_SimpleFifoNotifyFunc)(
+        void* pNotifyExtInfo,
+        CMN_SimpleFifoWatermarkEvent event,
+        size_t szOccupied);
+
 /*!
  * @brief FIFO handle which holds data required to manipulate FIFO.
  * 
@@ -81,6 +113,10 @@ typedef struct {
     size_t m_size; //!< Size of the internal ring buffer. Available size if m_size - 1 because one element is used as a separator of RP and WP.
     size_t m_wp; //!< Write Pointer. Index of the m_pBuf.
     size_t m_rp; //!< Read Pointer. Index of the m_pBuf.
+    CMN_SimpleFifoNotifyFunc m_notifyFunc; //!< Watermark notification function. NULL if not set.
+    void* m_pNotifyExtInfo; //!< Info passed to m_notifyFunc.
+    size_t m_szHighWatermark; //!< Occupied size to notify CMN_SIMPLE_FIFO_HIGH_WATERMARK.
+    size_t m_szLowWatermark; //!< Occupied size to notify CMN_SIMPLE_FIFO_LOW_WATERMARK.
 } CMN_SimpleFifoHandle;
 
 /*!
@@ -95,6 +131,9 @@ typedef struct {
  * CMN_SimpleFifoCopyFromPeekHandleWithSpecificCopier() to copy data
  * from a peek handle.
  *
+ * It is also used to return the regions of CMN_SimpleFifoReserve() and
+ * CMN_SimpleFifoAcquire().
+ *
  * @sa CMN_SimpleFifoCopyFromPeekHandle
  * @sa CMN_SimpleFifoCopyFromPeekHandleWithSpecificCopier
  */
@@ -353,6 +392,58 @@ size_t CMN_SimpleFifoOfferContinuousWithSpecificCopier(
         size_t* pGap,
         CMN_SimpleFifoCopierFunc copierFunc,
         void* pCopierFuncExtInfo);
+
+/*!
+ * @brief Reserve the vacant region of the FIFO to write data in place.
+ *
+ * The region just after WP is returned without copy. It may be split
+ * into 2 pieces at the end of the internal buffer. The client writes
+ * data to the region and then calls CMN_SimpleFifoCommit() to insert it
+ * to the FIFO. The FIFO is not modified by this API.
+ *
+ * Only the writer of the FIFO can use this API, and the region must not
+ * be used after the commit.
+ *
+ * @param[in] pHandle Pointer to the control block of the FIFO. NULL is
+ *            NOT allowed.
+ *            - Assertion Failure
+ *              - NULL
+ *
+ * @param[out] pRegion Pointer to the handle in which the reserved
+ *             region is stored. If the vacant size is 0, cleared with
+ *             values meaning empty. NULL is NOT allowed.
+ *            - Assertion Failure
+ *              - NULL
+ *
+ * @param[in] sz Size to reserve. If the vacant size is smaller, the
+ *            vacant size is reserved.
+ *
+ * @return Size of the reserved region. 0 if the FIFO is full.
+ */
+size_t CMN_SimpleFifoReserve(
+        CMN_SimpleFifoHandle* pHandle,
+        CMN_SimpleFifoPeekHandle* pRegion,
+        size_t sz);
+
+/*!
+ * @brief Insert data written to the region of CMN_SimpleFifoReserve().
+ *
+ * @param[in] pHandle Pointer to the control block of the FIFO. NULL is
+ *            NOT allowed.
+ *            - Assertion Failure
+ *              - NULL
+ *
+ * @param[in] sz Size of the written data from the top of the reserved
+ *            region. It must be equal to or less than the reserved
+ *            size.
+ *            - Assertion Failure
+ *              - Larger than the vacant size
+ *
+ * @return Size of inserted data.
+ */
+size_t CMN_SimpleFifoCommit(
+        CMN_SimpleFifoHandle* pHandle,
+        size_t sz);
 //@}
 
 /*!
@@ -426,6 +517,57 @@ size_t CMN_SimpleFifoPollWithSpecificCopier(
         size_t sz,
         CMN_SimpleFifoCopierFunc copierFunc,
         void* pCopierFuncExtInfo);
+
+/*!
+ * @brief Acquire the data on the head of the FIFO to read it in place.
+ *
+ * The region from RP is returned without copy. It may be split into 2
+ * pieces at the end of the internal buffer. The client reads the data
+ * in the region and then calls CMN_SimpleFifoRelease() to remove it
+ * from the FIFO. The FIFO is not modified by this API.
+ *
+ * Only the reader of the FIFO can use this API, and the region must not
+ * be used after the release.
+ *
+ * @param[in] pHandle Pointer to the control block of the FIFO. NULL is
+ *            NOT allowed.
+ *            - Assertion Failure
+ *              - NULL
+ *
+ * @param[out] pRegion Pointer to the handle in which the acquired
+ *             region is stored. If the FIFO is empty, cleared with
+ *             values meaning empty. NULL is NOT allowed.
+ *            - Assertion Failure
+ *              - NULL
+ *
+ * @param[in] sz Size to acquire. If the occupied size is smaller, the
+ *            occupied size is acquired.
+ *
+ * @return Size of the acquired data. 0 if the FIFO is empty.
+ */
+size_t CMN_SimpleFifoAcquire(
+        const CMN_SimpleFifoHandle* pHandle,
+        CMN_SimpleFifoPeekHandle* pRegion,
+        size_t sz);
+
+/*!
+ * @brief Remove data acquired by CMN_SimpleFifoAcquire().
+ *
+ * @param[in] pHandle Pointer to the control block of the FIFO. NULL is
+ *            NOT allowed.
+ *            - Assertion Failure
+ *              - NULL
+ *
+ * @param[in] sz Size of the data to remove. It must be equal to or less
+ *            than the acquired size.
+ *            - Assertion Failure
+ *              - Larger than the occupied size
+ *
+ * @return Size of removed data.
+ */
+size_t CMN_SimpleFifoRelease(
+        CMN_SimpleFifoHandle* pHandle,
+        size_t sz);
 //@}
 
 /*!
@@ -511,6 +653,50 @@ static inline size_t CMN_SimpleFifoPeek(
  */
 void CMN_SimpleFifoClear(
         CMN_SimpleFifoHandle* pHandle);
+
+/*!
+ * @brief Set watermarks and the notification function.
+ *
+ * notifyFunc is called with CMN_SIMPLE_FIFO_HIGH_WATERMARK when an
+ * offer or a commit makes the occupied size reach szHigh from below,
+ * and with CMN_SIMPLE_FIFO_LOW_WATERMARK when a poll or a release makes
+ * it fall to szLow from above. Because the other side may update the
+ * FIFO at the same time, the notification is a hint to check the FIFO
+ * and not a guarantee of its size.
+ *
+ * Call it before the writer and the reader start to use the FIFO.
+ * CMN_SimpleFifoInitialize() clears the setting.
+ *
+ * @param[in] pHandle Pointer to the control block of the FIFO. NULL is
+ *            NOT allowed.
+ *            - Assertion Failure
+ *                - NULL
+ *
+ * @param[in] szHigh High watermark. 1 to (buffer size - 1), or
+ *            CMN_SIMPLE_FIFO_NO_WATERMARK not to notify.
+ *            - API call Failure
+ *                - Out of range
+ *
+ * @param[in] szLow Low watermark. 0 to (buffer size - 2), or
+ *            CMN_SIMPLE_FIFO_NO_WATERMARK not to notify.
+ *            - API call Failure
+ *                - Out of range
+ *
+ * @param[in] notifyFunc Pointer to the notification function. NULL
+ *            disables the notification.
+ *
+ * @param[in] pNotifyExtInfo An argument passed to the notifyFunc.
+ *
+ * @return Result of the API call.
+ *           - 0 on success
+ *           - -1 on failures.
+ */
+int CMN_SimpleFifoSetWatermark(
+        CMN_SimpleFifoHandle* pHandle,
+        size_t szHigh,
+        size_t szLow,
+        CMN_SimpleFifoNotifyFunc notifyFunc,
+        void* pNotifyExtInfo);
 //@}
 
 /*!
@@ -46,6 +46,7 @@
  ****************************************************************************/
 
 #include <sdk/config.h>
+#include <pthread.h>
 #include <asmp/mpmq.h>
 #include <asmp/mptask.h>
 #include <nuttx/sensors/bmp280.h>
@@ -53,6 +54,7 @@
 #include "sensing/sensor_api.h"
 #include "sensing/sensor_id.h"
 #include "memutils/s_stl/queue.h"
+#include "sensing/logical_sensor/barometer_compensation.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -109,13 +111,21 @@ public:
   int write(sensor_command_data_mh_t*);
   void setAdjustParam(struct bmp280_press_adj_s* param);
   void setAdjustParam(struct bmp280_temp_adj_s* param);
+  void setCompensationMode(BarometerCompensationMode mode);
+  void setSeaLevelPressure(uint32_t pressure);
+  void getTrend(FAR BarometerTrend* trend);
         
   BarometerClass(SensorClientID id)
     : m_id(id), isReceivedPressureData(false), isReceivedTemperatureData(false)
+    , m_pressure_num(0), m_pressure_fs(0), m_temperature_num(0), m_trend()
   {
+    pthread_mutex_init(&m_trend_lock, NULL);
   };
 
-  ~BarometerClass(){};
+  ~BarometerClass()
+  {
+    pthread_mutex_destroy(&m_trend_lock);
+  };
 
 private:
 
@@ -123,17 +133,20 @@ private:
 
   SensorClientID m_id;
 
-  struct bmp280_press_adj_s press_adj;
-  struct bmp280_temp_adj_s temp_adj;
+  BarometerCompensation m_compensation;
 
   bool isReceivedPressureData;
   bool isReceivedTemperatureData;
   MemMgrLite::MemHandle  pressureDate;
   MemMgrLite::MemHandle  temperatureData;
-  
-  void compemsate(void);
-  uint32_t compensatePressure(int32_t adc_P, int32_t comp_T);
-  int32_t compensateTemperature(int32_t adc_T);
+  uint32_t m_pressure_num;
+  uint32_t m_pressure_fs;
+  uint32_t m_temperature_num;
+
+  /* Trend of the last block, read by the subscribers. */
+
+  BarometerTrend  m_trend;
+  pthread_mutex_t m_trend_lock;
 
 };
 
@@ -184,6 +197,34 @@ int BarometerStop(BarometerClass* ins);
  */
 int BarometerWrite(BarometerClass* ins, sensor_command_data_mh_t* command);
 
+/**
+ * @brief     Select the formula of the pressure compensation.
+ * @param[in] ins : instance address of BarometerClass
+ * @param[in] mode : BarometerCompensationExact (default) or
+ *                   BarometerCompensationFloat
+ * @return    result of process
+ */
+int BarometerSetCompensationMode(FAR BarometerClass* ins,
+                                 BarometerCompensationMode mode);
+
+/**
+ * @brief     Set the sea level pressure for the altitude.
+ * @param[in] ins : instance address of BarometerClass
+ * @param[in] pressure : sea level pressure[Pa],
+ *                       BAROMETER_SEA_LEVEL_PRESSURE by default
+ * @return    result of process
+ */
+int BarometerSetSeaLevelPressure(FAR BarometerClass* ins, uint32_t pressure);
+
+/**
+ * @brief     Get the mean pressure, altitude and trend of the last block
+ *            of compensated pressure.
+ * @param[in] ins : instance address of BarometerClass
+ * @param[out] trend : trend of the last block
+ * @return    result of process
+ */
+int BarometerGetTrend(FAR BarometerClass* ins, FAR BarometerTrend* trend);
+
 /**
  * @brief     Set sensor predefined adjustment values for pressure.
  * @param[in] param : adjustment values
@@ -0,0 +1,165 @@
+/****************************************************************************
+ * modules/include/sensing/logical_sensor/barometer_compensation.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_SENSING_BAROMETER_COMPENSATION_H
+#define __INCLUDE_SENSING_BAROMETER_COMPENSATION_H
+
+/**
+ * @defgroup logical_barometer_compensation Barometer Compensation API
+ * @{
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sdk/config.h>
+#include <stdint.h>
+#include <nuttx/sensors/bmp280.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define BAROMETER_SEA_LEVEL_PRESSURE 101325 /**< Sea level pressure[Pa] */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/**
+ * @enum BarometerCompensationMode
+ * @brief Formula of the pressure compensation.
+ */
+
+typedef enum
+{
+  BarometerCompensationExact = 0, /**< 32bit integer formula of the
+                                   *   BMP280 datasheet, bit exact.
+                                   */
+  BarometerCompensationFloat,     /**< Single precision float formula,
+                                   *   no division per sample, and
+                                   *   closer to the double precision
+                                   *   formula than the exact one.
+                                   */
+} BarometerCompensationMode;
+
+/**
+ * @struct BarometerTrend
+ * @brief Pressure and altitude of a block of samples.
+ */
+
+typedef struct
+{
+  uint32_t num;      /**< Number of samples of the block */
+  uint32_t pressure; /**< Mean pressure of the block[Pa] */
+  float    altitude; /**< Altitude of the mean pressure[m] */
+  float    trend;    /**< Pressure change of the block, least squares[Pa/s] */
+} BarometerTrend;
+
+/*--------------------------------------------------------------------*/
+/*  Barometer Compensation Class                                      */
+/*--------------------------------------------------------------------*/
+
+/* Compensates blocks of BMP280 raw data in place.
+ *
+ * The terms of the pressure formula which depend only on the temperature
+ * are calculated when the raw temperature changes, and are kept over the
+ * blocks. The trend is accumulated in the same pass as the compensation.
+ */
+
+class BarometerCompensation
+{
+public:
+
+  /* public methods */
+  void setAdjustParam(FAR const struct bmp280_press_adj_s *param);
+  void setAdjustParam(FAR const struct bmp280_temp_adj_s *param);
+  void setMode(BarometerCompensationMode mode);
+  void setSeaLevelPressure(uint32_t pressure);
+  void compensate(FAR const int32_t *temp,
+                  FAR uint32_t *press,
+                  uint32_t num,
+                  uint32_t fs,
+                  FAR BarometerTrend *trend);
+  int32_t compensateTemperature(int32_t adc_T) const;
+  uint32_t compensatePressure(int32_t adc_P, int32_t comp_T) const;
+
+  BarometerCompensation()
+    : m_press_adj()
+    , m_temp_adj()
+    , m_mode(BarometerCompensationExact)
+    , m_sea_level(BAROMETER_SEA_LEVEL_PRESSURE)
+    , m_cached(false)
+    , m_adc_T(0)
+    , m_offset(0)
+    , m_divisor(0)
+    , m_offset_f(0.0F)
+    , m_scale_f(0.0F)
+  {
+  };
+
+  ~BarometerCompensation(){};
+
+private:
+
+  /* private members */
+
+  struct bmp280_press_adj_s m_press_adj;
+  struct bmp280_temp_adj_s  m_temp_adj;
+
+  BarometerCompensationMode m_mode;
+  uint32_t                  m_sea_level;
+
+  /* Terms of the last raw temperature. */
+
+  bool     m_cached;
+  int32_t  m_adc_T;
+  int32_t  m_offset;    /* var2 >> 12 of the exact formula */
+  uint32_t m_divisor;   /* var1 of the exact formula */
+  float    m_offset_f;  /* 1048576 - var2 / 4096 of the float formula */
+  float    m_scale_f;   /* 6250 / var1 of the float formula */
+
+  void exactTerms(int32_t adc_T,
+                  FAR int32_t *offset,
+                  FAR uint32_t *divisor) const;
+  void floatTerms(int32_t adc_T, FAR float *offset, FAR float *scale) const;
+};
+
+/**
+ * @}
+ */
+
+#endif /* __INCLUDE_SENSING_BAROMETER_COMPENSATION_H */
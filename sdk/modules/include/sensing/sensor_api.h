@@ -94,6 +94,9 @@ typedef struct
  * @struct sensor_command_data_t
  * @brief  The command of send some sensor data
  *         without MemHandle to the sensor manager.
+ * @note   When is_ptr is true, only the address in adr is passed on.
+ *         With CONFIG_SENSING_MANAGER_ASYNC_DELIVERY, such data is not
+ *         accepted (SS_ECODE_PARAM_ERROR). Use sensor_command_data_mh_t.
  */
 typedef struct
 {
@@ -297,6 +300,23 @@ typedef struct
 
 #endif /* CONFIG_SENSING_MANAGER_POWERCTRL */
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @struct sensor_delivery_stats_t
+ * @brief  Statistics of the data delivery to a sensor client.
+ *         The latency is the time from the reception by the sensor manager
+ *         to the return of the client callback.
+ */
+typedef struct
+{
+  uint32_t delivered;      /**< number of delivered data                  */
+  uint32_t dropped;        /**< number of dropped data by queue full      */
+  uint32_t queued_max;     /**< max number of queued data                 */
+  uint32_t latency_last;   /**< latency of the last delivery [us]         */
+  uint32_t latency_max;    /**< max latency [us]                          */
+  uint64_t latency_total;  /**< total latency for average [us]            */
+} sensor_delivery_stats_t;
+
 /*--------------------------------------------------------------------------*/
 /*--------------------------------------------------------------------
     Command(Evant) Code.
@@ -366,6 +386,9 @@ extern bool SS_DeactivateSensorSubSystem();
  * @brief     Sender function to Sensor Manager without MemHandle.
  *            Send data is publish to own subscriber.
  * @note      This API send address of publish data.
+ *            If packet->is_ptr is true, the data at packet->adr must
+ *            stay valid until every subscriber has received it. With
+ *            CONFIG_SENSING_MANAGER_ASYNC_DELIVERY, it is rejected.
  * @param[in] packet
  * @return    void
  */
@@ -420,6 +443,22 @@ extern void SS_SendSensorRelease(FAR sensor_command_release_t *packet);
  */
 extern void SS_SendSensorChangeSubscription(FAR sensor_command_change_subscription_t *packet);
 
+/**
+ * @brief      Get the delivery statistics of the sensor client.
+ * @param[in]  id    : sensor ID of the client
+ * @param[out] stats : statistics
+ * @return     true: success, false: invalid sensor ID
+ */
+extern bool SS_GetSensorDeliveryStats(unsigned int id,
+                                      FAR sensor_delivery_stats_t *stats);
+
+/**
+ * @brief     Clear the delivery statistics of the sensor client.
+ * @param[in] id : sensor ID of the client
+ * @return    true: success, false: invalid sensor ID
+ */
+extern bool SS_ClearSensorDeliveryStats(unsigned int id);
+
 #ifdef __cplusplus
 
 /**
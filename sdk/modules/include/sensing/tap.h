@@ -48,6 +48,7 @@
   Included Files
    -------------------------------------------------------------------------- */
 
+#include <stdint.h>
 #include <sys/time.h>
 
 #ifdef __cplusplus
@@ -152,6 +153,18 @@ typedef struct
   float accel_z;    /**< (G) Z axis standard gravity acceleration. */
 } ST_TAP_ACCEL;
 
+/**
+ * @struct ST_TAP_EVENT
+ * @brief tap event detected in a block of accel data
+ */
+typedef struct
+{
+  int      tap_cnt;     /**< Number of taps. */
+  uint64_t time_stamp;  /**< (microsec) Time stamp of the sample
+                         *   which the taps are notified at.
+                         */
+} ST_TAP_EVENT;
+
 /** @} tap_lib_datatypes */
 
 /*--------------------------------------------------------------------
@@ -172,6 +185,7 @@ public:
   int close(void);
   int write(ST_TAP_ACCEL*);
   int write(ST_TAP_ACCEL*, uint64_t);
+  int write(ST_TAP_ACCEL*, int, uint64_t, uint32_t, ST_TAP_EVENT*);
 
   TapClass();
   ~TapClass(){};
@@ -190,11 +204,13 @@ private:
   int         mStabFrame;  /* (64Hz frame num) time of PEAK_THRES -> LONG_THRES. 
                        *   range 0 - 32
                        */
+  float       mPeakThres2; /* Squared mPeakThres to compare with mR */
+  float       mLongThres2; /* Squared mLongThres to compare with calcR2() */
 
   int          mTapCnt;          /**< Detect tap Count. */
   E_TAP_STATE  mState;           /**< Holds IDLE or TAP state */
 
-  float        mR[TAP_BUF_LEN];  /**< Set sqrt value */
+  float        mR[TAP_BUF_LEN];  /**< Squared magnitude */
   float        mX[TAP_BUF_LEN];  /**< Accel Data(x)  */
   float        mY[TAP_BUF_LEN];  /**< Accel Data(y)  */
   float        mZ[TAP_BUF_LEN];  /**< Accel Data(z)  */
@@ -208,9 +224,11 @@ private:
   uint64_t     mStartTime;        /**< Time to use for continuous tap detection. */
 
   /* private methods */
-  float calcR(int i0, int j0);
+  float calcR2(int i0, int j0);
   bool detect(float x, float y, float z);
-  float getIndex(int idx);
+  bool detect(float x, float y, float z, float r2);
+  int judge(bool detectflg, uint64_t endTime);
+  int getIndex(int idx);
 
 };
 
@@ -258,6 +276,20 @@ int TapWrite(FAR TapClass *ins, FAR ST_TAP_ACCEL *accelData);
 int TapWrite_timestamp(FAR TapClass *ins, FAR ST_TAP_ACCEL *accelData, 
                        uint64_t time_stamp);
 
+/**
+ * @brief     Detect tap in a block of accel data
+ * @param[in] ins : instance address of TapClass
+ * @param[in] accelData : Accel Data of num samples
+ * @param[in] num : Number of samples
+ * @param[in] time_stamp : Time Stamp of the first sample
+ * @param[in] interval : (microsec) Sampling interval
+ * @param[out] events : Detected tap events, num entries at most
+ * @return    number of events or error code
+ */
+int TapWrite_block(FAR TapClass *ins, FAR ST_TAP_ACCEL *accelData, int num,
+                   uint64_t time_stamp, uint32_t interval,
+                   FAR ST_TAP_EVENT *events);
+
 /** @} tap_lib_funcs */
 /** @} tap_lib */
 
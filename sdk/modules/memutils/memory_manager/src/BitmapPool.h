@@ -0,0 +1,96 @@
+/****************************************************************************
+ * modules/memutils/memory_manager/src/BitmapPool.h
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#ifndef BITMAPPOOL_H_INCLUDED
+#define BITMAPPOOL_H_INCLUDED
+
+#include "memutils/common_utils/common_errcode.h"
+#include "memutils/memory_manager/MemPool.h"
+
+namespace MemMgrLite {
+
+/*****************************************************************
+ * Bitmap memory pool class (24 or 28bytes)
+ *
+ * Fixed size segments like BasicPool, but the usable segments are
+ * managed by bitmap instead of the segment number queue.
+ * The bit of segment number n (1 origin) is the bit (31 - (n-1)%32)
+ * of the word (n-1)/32, 1 means usable. The summary bitmap has a bit
+ * for each bitmap word, 1 means the word has an usable segment.
+ * So a segment is found by two count-leading-zeros. Up to 1024
+ * segments, the summary is only one word.
+ *****************************************************************/
+class BitmapPool : public MemPool {
+	friend class Manager;
+	friend class MemPool;
+protected:
+	BitmapPool(const PoolSectionAttr& attr, FastMemAlloc& fma);
+	~BitmapPool();
+
+	bool isFailed() {
+		return MemPool::isFailed() || m_free_map == NULL;
+	}
+
+  /* allocate a memory segment */
+  err_t allocSeg(size_t size_for_check, MemHandleProxy &proxy);
+
+	/* free a memory segment */
+	void 		freeSeg(MemHandleBase& mh);
+
+	PoolAddr	getSegAddr(const MemHandleBase& mh) const;
+	PoolSize	getSegSize() const { return getPoolSize() / getPoolNumSegs(); }
+	NumSeg		getPoolNumAvailSegs() const { return m_num_avail; }
+	uint32_t	getUsedSegs(MemHandleBase* mhs, uint32_t num_mhs);
+
+  /* Number of words of bitmap and summary bitmap. */
+
+	static uint32_t	getMapWords(NumSeg num_segs) { return (num_segs + 31) / 32; }
+	static uint32_t	getSummaryWords(NumSeg num_segs) { return (getMapWords(num_segs) + 31) / 32; }
+
+private:
+	static uint32_t	bitOf(uint32_t idx) { return 0x80000000u >> (idx & 31); }
+
+	uint32_t*	getSummary() const { return m_free_map + getMapWords(getPoolNumSegs()); }
+
+  /* Bitmap and summary bitmap are allocated continuously. */
+
+	uint32_t* const	m_free_map;
+	NumSeg		m_num_avail;
+}; /* class BitmapPool */
+
+} /* namespace MemMgrLite */
+
+#endif /* BITMAPPOOL_H_INCLUDED */
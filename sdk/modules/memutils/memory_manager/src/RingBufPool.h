@@ -0,0 +1,110 @@
+/****************************************************************************
+ * modules/memutils/memory_manager/src/RingBufPool.h
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef RINGBUFPOOL_H_INCLUDED
+#define RINGBUFPOOL_H_INCLUDED
+
+#include "memutils/common_utils/common_errcode.h"
+#include "memutils/memory_manager/MemPool.h"
+
+namespace MemMgrLite {
+
+/*****************************************************************
+ * Ring buffer memory pool class (32 or 36bytes)
+ *
+ * Variable size segments are cut out from the pool area in FIFO
+ * order. The number of segments of the pool is the number of
+ * segments which can be used at the same time.
+ * The area of a segment is returned when it and all the segments
+ * allocated before it are freed. If the rest area at the end of the
+ * pool is not enough, the segment is allocated from the top of the
+ * pool and the rest area is not used until the ring wraps around.
+ *****************************************************************/
+class RingBufPool : public MemPool {
+	friend class Manager;
+	friend class MemPool;
+protected:
+	RingBufPool(const PoolSectionAttr& attr, FastMemAlloc& fma);
+	~RingBufPool();
+
+	bool isFailed() {
+		return MemPool::isFailed() || m_seg_desc == NULL;
+	}
+
+  /* allocate a memory segment of size_for_check bytes */
+  err_t allocSeg(size_t size_for_check, MemHandleProxy &proxy);
+
+	/* free a memory segment */
+	void 		freeSeg(MemHandleBase& mh);
+
+  /* Shrink the segment to the size. The area is returned to
+   * the pool only when it is the last allocated segment.
+   */
+
+	err_t		shrinkSeg(MemHandleBase& mh, size_t size);
+
+	PoolAddr	getSegAddr(const MemHandleBase& mh) const;
+	PoolSize	getSegSize(const MemHandleBase& mh) const;
+	NumSeg		getPoolNumAvailSegs() const { return getPoolNumSegs() - m_num_used; }
+
+private:
+	struct SegDesc {
+		PoolSize	offset;	/* offset from the pool address */
+		PoolSize	size;	/* requested size */
+	}; /* struct SegDesc */
+
+  /* Segments are cut out with this alignment. */
+
+	static PoolSize	getAreaSize(size_t size) {
+		return (size == 0) ? sizeof(uint32_t) :
+			static_cast<PoolSize>((size + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1));
+	}
+
+	NumSeg		getSegIndex(const MemHandleBase& mh) const;
+	bool		isLastSeg(NumSeg idx) const {
+		return (m_first + m_num_used - 1) % getPoolNumSegs() == idx;
+	}
+	PoolSize	findArea(PoolSize area_size) const;
+
+	SegDesc* const	m_seg_desc;	/* descriptor for each segment number */
+	PoolSize	m_rd;		/* offset of the oldest segment */
+	PoolSize	m_wr;		/* offset for the next segment */
+	NumSeg		m_first;	/* index of the oldest segment */
+	NumSeg		m_num_used;	/* number of segments in the ring */
+}; /* class RingBufPool */
+
+} /* namespace MemMgrLite */
+
+#endif /* RINGBUFPOOL_H_INCLUDED */
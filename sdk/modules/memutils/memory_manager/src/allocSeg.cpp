@@ -36,6 +36,12 @@
 #include "ScopedLock.h"
 #include "memutils/memory_manager/MemHandleBase.h"
 #include "BasicPool.h"
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+#include "BitmapPool.h"
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+#include "RingBufPool.h"
+#endif
 
 namespace MemMgrLite {
 
@@ -55,22 +61,37 @@ err_t MemHandleBase::allocSeg(PoolId id, size_t size_for_check)
 err_t Manager::allocSeg(PoolId id, size_t size_for_check, MemHandleProxy &proxy)
 {
   MemPool* pool = findPool(id);
+  err_t    err;
 
-#ifdef USE_MEMMGR_RINGBUF_POOL
+#if defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL) || defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL)
   /* 仮想関数を使用しない方針なので、該当プール型にダウンキャストする */
   switch (pool->getPoolType()) {
   case BasicType:
-    return static_cast<BasicPool*>(pool)->allocSeg(size_for_check);
+    err = static_cast<BasicPool*>(pool)->allocSeg(size_for_check, proxy);
+    break;
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
   case RingBufType:
-    return static_cast<RingBufPool*>(pool)->allocSeg(size_for_check);
+    err = static_cast<RingBufPool*>(pool)->allocSeg(size_for_check, proxy);
+    break;
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+  case BitmapType:
+    err = static_cast<BitmapPool*>(pool)->allocSeg(size_for_check, proxy);
+    break;
+#endif
   default:
     D_ASSERT(false);
-    return MemHandleProxy();  /* default constructor */
+    return ERR_ARG;
   }
 #else
   /* BasicPoolのみ使用時は、各種チェックを省略する */
-  return static_cast<BasicPool*>(pool)->allocSeg(size_for_check, proxy);
+  err = static_cast<BasicPool*>(pool)->allocSeg(size_for_check, proxy);
 #endif
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS
+  countAllocStats(pool, size_for_check, err);
+#endif
+  return err;
 }
 
 /*****************************************************************
@@ -94,6 +115,117 @@ err_t BasicPool::allocSeg(size_t size_for_check, MemHandleProxy &proxy)
   return ERR_OK;
 }
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+/*****************************************************************
+ * Bitmapプールのセグメントハンドルを取得する
+ * サマリと該当ワードの先頭の1ビットから、空きセグメントを求める
+ *****************************************************************/
+err_t BitmapPool::allocSeg(size_t size_for_check, MemHandleProxy &proxy)
+{
+  if (size_for_check > getSegSize())
+    {
+      return ERR_DATA_SIZE;
+    }
+
+  uint32_t* summary   = getSummary();
+  uint32_t  sum_words = getSummaryWords(getPoolNumSegs());
+
+  ScopedLock lock;
+
+  for (uint32_t s = 0; s < sum_words; ++s)
+    {
+      if (summary[s] == 0)
+        {
+          continue;
+        }
+
+      uint32_t w   = s * 32 + __builtin_clz(summary[s]);
+      uint32_t idx = w * 32 + __builtin_clz(m_free_map[w]);
+
+      m_free_map[w] &= ~bitOf(idx);
+      if (m_free_map[w] == 0)
+        {
+          summary[s] &= ~bitOf(w);
+        }
+      --m_num_avail;
+
+      D_ASSERT(m_ref_cnt_array[idx] == 0);  /* 未使用のはず */
+      m_ref_cnt_array[idx] = 1;
+
+      proxy = MemHandleBase::makeMemHandleProxy(getPoolId(), static_cast<NumSeg>(idx + 1), 0);
+      return ERR_OK;
+    }
+
+  proxy = 0;
+  return ERR_MEM_EMPTY;
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL */
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+/*****************************************************************
+ * RingBufプールのセグメントハンドルを取得する
+ * 指定サイズの領域を、前回取得したセグメントの直後から切り出す
+ *****************************************************************/
+err_t RingBufPool::allocSeg(size_t size_for_check, MemHandleProxy &proxy)
+{
+  if (size_for_check == 0 || size_for_check > getPoolSize())
+    {
+      return ERR_DATA_SIZE;
+    }
+
+  PoolSize area_size = getAreaSize(size_for_check);
+
+  ScopedLock lock;
+
+  PoolSize offset = findArea(area_size);
+  if (m_num_used == getPoolNumSegs() || offset == BadPoolAddr)
+    {
+      proxy = 0;
+      return ERR_MEM_EMPTY;
+    }
+
+  NumSeg idx = (m_first + m_num_used) % getPoolNumSegs();
+  m_seg_desc[idx].offset = offset;
+  m_seg_desc[idx].size   = static_cast<PoolSize>(size_for_check);
+  m_wr = offset + area_size;
+  ++m_num_used;
+
+  D_ASSERT(m_ref_cnt_array[idx] == 0);  /* 未使用のはず */
+  m_ref_cnt_array[idx] = 1;
+
+  proxy = MemHandleBase::makeMemHandleProxy(getPoolId(), idx + 1, 0);
+  return ERR_OK;
+}
+
+/*****************************************************************
+ * RingBufプールから、指定サイズの連続した空き領域を探す
+ * 見つからない場合は、BadPoolAddrを返す
+ * 排他制御は呼出し側で行うこと
+ *****************************************************************/
+PoolSize RingBufPool::findArea(PoolSize area_size) const
+{
+  if (m_num_used == 0)
+    {
+      return (area_size <= getPoolSize()) ? 0 : BadPoolAddr;
+    }
+
+  if (m_wr > m_rd)
+    {
+      /* 末尾に空きがなければ、先頭から切り出す */
+
+      if (getPoolSize() - m_wr >= area_size)
+        {
+          return m_wr;
+        }
+      return (m_rd >= area_size) ? 0 : BadPoolAddr;
+    }
+
+  /* 折り返し中。m_wr == m_rdは満杯 */
+
+  return (m_rd - m_wr >= area_size) ? m_wr : BadPoolAddr;
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL */
+
 /*****************************************************************
  * メモリプールからセグメントハンドルを取得する
  * 排他制御は呼出し側で行うこと
@@ -37,6 +37,12 @@
 #include "FastMemAlloc.h"  /* FastMemAlloc class */
 #include "memutils/memory_manager/Manager.h"
 #include "BasicPool.h"
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+#include "BitmapPool.h"
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+#include "RingBufPool.h"
+#endif
 
 namespace MemMgrLite {
 
@@ -46,14 +52,27 @@ namespace MemMgrLite {
 MemPool* Manager::createPool(const PoolSectionAttr& attr, FastMemAlloc& fma)
 {
   MemPool* pool = NULL;
-#ifdef USE_MEMMGR_RINGBUF_POOL
+#if defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL) || defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL)
   switch (attr.type) {
   case BasicType:
     pool = new(fma, sizeof(uint32_t)) BasicPool(attr, fma);
     break;
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
   case RingBufType:
-    pool = new(fma, sizeof(uint32_t)) RingBufPool(attr, fma);
+    {
+      RingBufPool* rbp = new(fma, sizeof(uint32_t)) RingBufPool(attr, fma);
+      pool = (rbp && rbp->isFailed()) ? NULL : rbp;
+    }
     break;
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+  case BitmapType:
+    {
+      BitmapPool* bmp = new(fma, sizeof(uint32_t)) BitmapPool(attr, fma);
+      pool = (bmp && bmp->isFailed()) ? NULL : bmp;
+    }
+    break;
+#endif
   default:
     D_ASSERT(false);  /* Unsupport pool type */
     break;
@@ -85,17 +104,66 @@ BasicPool::BasicPool(const PoolSectionAttr& attr, FastMemAlloc& fma) :
 #endif
 }
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+/*****************************************************************
+ * Bitmapプールのコンストラクタ
+ *****************************************************************/
+BitmapPool::BitmapPool(const PoolSectionAttr& attr, FastMemAlloc& fma) :
+  MemPool(attr, fma),
+  m_free_map(static_cast<uint32_t*>(fma.alloc(sizeof(uint32_t) *
+    (getMapWords(attr.num_segs) + getSummaryWords(attr.num_segs)), sizeof(uint32_t)))),
+  m_num_avail(attr.num_segs)
+{
+  if (m_free_map) {
+    uint32_t map_words = getMapWords(attr.num_segs);
+    uint32_t* summary  = getSummary();
+
+    /* 全セグメントを使用可能にする。末尾の存在しないセグメントは0のまま */
+    memset(m_free_map, 0x00, sizeof(uint32_t) * (map_words + getSummaryWords(attr.num_segs)));
+    for (uint32_t i = 0; i < static_cast<uint32_t>(attr.num_segs); ++i) {
+      m_free_map[i / 32] |= bitOf(i);
+    }
+    for (uint32_t w = 0; w < map_words; ++w) {
+      summary[w / 32] |= bitOf(w);
+    }
+  }
+#ifdef USE_MEMMGR_DEBUG_OUTPUT
+  printf("BitmapPool: created. [fma.rest=%08x] ", fma.rest());
+  attr.printInfo();
+#endif
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL */
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+/*****************************************************************
+ * RingBufプールのコンストラクタ
+ *****************************************************************/
+RingBufPool::RingBufPool(const PoolSectionAttr& attr, FastMemAlloc& fma) :
+  MemPool(attr, fma),
+  m_seg_desc(static_cast<SegDesc*>(fma.alloc(sizeof(SegDesc) * attr.num_segs, sizeof(uint32_t)))),
+  m_rd(0),
+  m_wr(0),
+  m_first(0),
+  m_num_used(0)
+{
+#ifdef USE_MEMMGR_DEBUG_OUTPUT
+  printf("RingBufPool: created. [fma.rest=%08x] ", fma.rest());
+  attr.printInfo();
+#endif
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL */
+
 /*****************************************************************
  * メモリプールのコンストラクタ
  *****************************************************************/
 MemPool::MemPool(const PoolSectionAttr& attr, FastMemAlloc& fma) :
   m_attr(attr),
-  m_seg_no_que(fma.alloc(sizeof(NumSeg) * attr.num_segs, sizeof(NumSeg)), attr.num_segs),
+  m_seg_no_que(fma.alloc(sizeof(NumSeg) * getSegNoQueDepth(attr), sizeof(NumSeg)), getSegNoQueDepth(attr)),
   m_ref_cnt_array(static_cast<SegRefCnt*>(fma.alloc(sizeof(SegRefCnt) * attr.num_segs, sizeof(SegRefCnt))))
 {
   if (m_seg_no_que.que_area() && m_ref_cnt_array) { /* alloc成功 ? */
     /* 使用可能なセグメント番号(1 origin)を設定 */
-    for (uint32_t i = 1; i <= static_cast<uint32_t>(attr.num_segs); ++i) {
+    for (uint32_t i = 1; i <= static_cast<uint32_t>(m_seg_no_que.capacity()); ++i) {
       (void)m_seg_no_que.push(static_cast<NumSeg>(i));
     }
 
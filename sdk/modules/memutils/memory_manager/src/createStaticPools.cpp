@@ -48,7 +48,7 @@ err_t Manager::createStaticPools(uint8_t sec_no, NumLayout layout_no, void* work
   printf("Manager::createStaticPools(layout_no=%d, work_area=%08x, area_size=%08x)\n",
     layout_no, work_area, area_size);
 #endif
-  if (reinterpret_cast<uint32_t>(work_area) % sizeof(uint32_t) != 0)
+  if (reinterpret_cast<uintptr_t>(work_area) % sizeof(uint32_t) != 0)
     {
       return ERR_ADR_ALIGN;
     }
@@ -91,6 +91,9 @@ err_t Manager::createStaticPools(uint8_t sec_no, NumLayout layout_no, void* work
     if (theManager->m_static_pools[sec_no][pool_attr[i].id.pool] == NULL) {
       return ERR_DATA_SIZE; /* work_areaのサイズ不足 */
     }
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS
+    clearPoolStats(pool_attr[i].id);  /* 新しいプールの統計を開始する */
+#endif
   }
   theManager->m_layout_no[sec_no] = layout_no;  /* 生成に成功したのでレイアウト番号を設定する */
 
@@ -35,6 +35,12 @@
 
 #include "memutils/memory_manager/Manager.h"
 #include "BasicPool.h"
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+#include "BitmapPool.h"
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+#include "RingBufPool.h"
+#endif
 
 namespace MemMgrLite {
 
@@ -44,15 +50,22 @@ namespace MemMgrLite {
  *****************************************************************/
 void Manager::destroyPool(MemPool* pool)
 {
-#ifdef USE_MEMMGR_RINGBUF_POOL
+#if defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL) || defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL)
 	/* 仮想関数を使用しない方針なので、該当プール型にダウンキャストする */
 	switch (pool->getPoolType()) {
 	case BasicType:
 		static_cast<BasicPool*>(pool)->~BasicPool();
 		break;
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
 	case RingBufType:
 		static_cast<RingBufPool*>(pool)->~RingBufPool();
 		break;
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+	case BitmapType:
+		static_cast<BitmapPool*>(pool)->~BitmapPool();
+		break;
+#endif
 	default:
 		D_ASSERT(false);	/* Unsupport pool type */
 		break;
@@ -73,6 +86,42 @@ BasicPool::~BasicPool()
 #endif
 }
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+/*****************************************************************
+ * Bitmapプールのデストラクタ
+ *****************************************************************/
+BitmapPool::~BitmapPool()
+{
+#ifdef USE_MEMMGR_DEBUG_OUTPUT
+	printf("~BitmapPool: PoolId=%d\n", getPoolId());
+#endif
+	if (m_num_avail != getPoolNumSegs()) {
+#ifdef USE_MEMMGR_DEBUG_OUTPUT
+		printf("~BitmapPool: Segment leak found. PoolId=%d\n", getPoolId());
+#endif
+		F_ASSERT(0);	/* memory segment leaked */
+	}
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL */
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+/*****************************************************************
+ * RingBufプールのデストラクタ
+ *****************************************************************/
+RingBufPool::~RingBufPool()
+{
+#ifdef USE_MEMMGR_DEBUG_OUTPUT
+	printf("~RingBufPool: PoolId=%d\n", getPoolId());
+#endif
+	if (m_num_used != 0) {
+#ifdef USE_MEMMGR_DEBUG_OUTPUT
+		printf("~RingBufPool: Segment leak found. PoolId=%d\n", getPoolId());
+#endif
+		F_ASSERT(0);	/* memory segment leaked */
+	}
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL */
+
 /*****************************************************************
  * メモリプールのデストラクタ
  *****************************************************************/
@@ -36,6 +36,12 @@
 #include "ScopedLock.h"
 #include "memutils/memory_manager/MemHandleBase.h"
 #include "BasicPool.h"
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+#include "BitmapPool.h"
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+#include "RingBufPool.h"
+#endif
 
 namespace MemMgrLite {
 
@@ -46,15 +52,22 @@ void Manager::freeSeg(MemHandleBase& mh)
 {
 	MemPool* pool = findPool(mh.getPoolId());
 
-#ifdef USE_MEMMGR_RINGBUF_POOL
+#if defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL) || defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL)
 	/* 仮想関数を使用しない方針なので、該当プール型にダウンキャストする */
 	switch (pool->getPoolType()) {
 	case BasicType:
 		static_cast<BasicPool*>(pool)->freeSeg(mh);
 		break;
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
 	case RingBufType:
 		static_cast<RingBufPool*>(pool)->freeSeg(mh);
 		break;
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+	case BitmapType:
+		static_cast<BitmapPool*>(pool)->freeSeg(mh);
+		break;
+#endif
 	default:
 		D_ASSERT(false);
 		break;
@@ -63,6 +76,10 @@ void Manager::freeSeg(MemHandleBase& mh)
 	/* BasicPoolのみ使用時は、各種チェックを省略する */
 	static_cast<BasicPool*>(pool)->freeSeg(mh);
 #endif
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS
+	countFreeStats(pool);
+#endif
 }
 
 /*****************************************************************
@@ -74,6 +91,59 @@ void BasicPool::freeSeg(MemHandleBase& mh)
 	MemPool::freeSeg(mh);
 }
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+/*****************************************************************
+ * Bitmapプールのセグメントを解放する（可能性がある）
+ *****************************************************************/
+void BitmapPool::freeSeg(MemHandleBase& mh)
+{
+	NumSeg seg_no = mh.getSegNo();
+	D_ASSERT(seg_no != NullSegNo && seg_no <= getPoolNumSegs());
+
+	uint32_t idx = seg_no - 1;
+	uint32_t w   = idx / 32;
+
+	ScopedLock lock;
+	D_ASSERT(m_ref_cnt_array[idx] != 0);	/* 使用中のはず */
+
+	if (--m_ref_cnt_array[idx] == 0) {
+		D_ASSERT((m_free_map[w] & bitOf(idx)) == 0);
+		if (m_free_map[w] == 0) {
+			getSummary()[w / 32] |= bitOf(w);
+		}
+		m_free_map[w] |= bitOf(idx);
+		++m_num_avail;
+	}
+	mh.clear();	/* メモリハンドルを初期状態に戻す */
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL */
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+/*****************************************************************
+ * RingBufプールのセグメントを解放する（可能性がある）
+ * 先頭から連続して解放済みのセグメントの領域をまとめて返却する
+ *****************************************************************/
+void RingBufPool::freeSeg(MemHandleBase& mh)
+{
+	NumSeg idx = getSegIndex(mh);
+
+	ScopedLock lock;
+
+	if (--m_ref_cnt_array[idx] == 0 && idx == m_first) {
+		while (m_num_used != 0 && m_ref_cnt_array[m_first] == 0) {
+			m_first = (m_first + 1) % getPoolNumSegs();
+			--m_num_used;
+		}
+		if (m_num_used != 0) {
+			m_rd = m_seg_desc[m_first].offset;
+		} else {
+			m_rd = m_wr = 0;	/* 空になったら先頭から使用する */
+		}
+	}
+	mh.clear();	/* メモリハンドルを初期状態に戻す */
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL */
+
 /*****************************************************************
  * 参照カウンタを減算し、参照がなくなった場合はセグメントを返却する
  * 排他制御は呼出し側で行うこと
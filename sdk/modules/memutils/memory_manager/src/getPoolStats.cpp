@@ -0,0 +1,321 @@
+/****************************************************************************
+ * modules/memutils/memory_manager/src/getPoolStats.cpp
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "ScopedLock.h"
+#include "memutils/memory_manager/Manager.h"
+
+namespace MemMgrLite {
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS
+#ifndef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_MAX_SECTIONS
+#define CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_MAX_SECTIONS 1
+#endif
+#ifndef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_MAX_POOLS
+#define CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_MAX_POOLS 16
+#endif
+#ifndef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_FAIL_LOG
+#define CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_FAIL_LOG 8
+#endif
+
+/*****************************************************************
+ * 統計カウンタ
+ * 解放数は、確保数と使用中セグメント数から求める
+ *****************************************************************/
+struct PoolStatsCounter {
+	uint32_t	alloc_count;
+	uint32_t	fail_count;
+	NumSeg		base_used;	/* クリア時の使用中セグメント数 */
+	NumSeg		cur_used;
+	NumSeg		peak_used;
+	uint32_t	last_time;
+	uint64_t	elapsed_time;
+	uint64_t	used_time;
+};
+
+static PoolStatsCounter s_stats[CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_MAX_SECTIONS]
+                               [CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_MAX_POOLS];
+
+static AllocFailLog s_fail_log[CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_FAIL_LOG];
+static uint32_t     s_fail_head;	/* 最も古いログの位置 */
+static uint32_t     s_fail_num;
+
+static PoolStatsCounter* getCounter(PoolId id)
+{
+	if (id.sec < CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_MAX_SECTIONS &&
+	    id.pool < CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_MAX_POOLS) {
+		return &s_stats[id.sec][id.pool];
+	}
+	return NULL;
+}
+
+/*****************************************************************
+ * 使用中セグメント数を更新する。前回の更新からの時間を積算する
+ * 時刻は71分で一周するため、経過時間も更新の度に64bitで積算する
+ * 排他制御は呼出し側で行うこと
+ *****************************************************************/
+static void updateUsed(PoolStatsCounter* p, NumSeg used, uint32_t now)
+{
+	uint32_t delta = now - p->last_time;
+
+	p->elapsed_time += delta;
+	p->used_time    += static_cast<uint64_t>(p->cur_used) * delta;
+	p->last_time     = now;
+	p->cur_used      = used;
+	if (used > p->peak_used) {
+		p->peak_used = used;
+	}
+}
+
+/*****************************************************************
+ * セグメント確保の統計を更新する
+ *****************************************************************/
+void Manager::countAllocStats(MemPool* pool, size_t size, err_t err)
+{
+	PoolStatsCounter* p = getCounter(pool->getPoolId());
+	uint32_t now = Chateau_GetTimeUs();
+
+	ScopedLock lock;
+
+	if (p) {
+		if (err == ERR_OK) {
+			p->alloc_count++;
+		} else {
+			p->fail_count++;
+		}
+		updateUsed(p, pool->getPoolNumSegs() - pool->getPoolNumAvailSegs(), now);
+	}
+
+	if (err != ERR_OK) {
+		/* 満杯の場合は、最も古いログを上書きする */
+		uint32_t pos = (s_fail_head + s_fail_num) % CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_FAIL_LOG;
+		if (s_fail_num < CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_FAIL_LOG) {
+			s_fail_num++;
+		} else {
+			s_fail_head = (s_fail_head + 1) % CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_FAIL_LOG;
+		}
+		s_fail_log[pos].time = now;
+		s_fail_log[pos].size = static_cast<uint32_t>(size);
+		s_fail_log[pos].pid  = static_cast<int32_t>(getpid());
+		s_fail_log[pos].id   = pool->getPoolId();
+		s_fail_log[pos].err  = err;
+	}
+}
+
+/*****************************************************************
+ * セグメント解放の統計を更新する
+ *****************************************************************/
+void Manager::countFreeStats(MemPool* pool)
+{
+	PoolStatsCounter* p = getCounter(pool->getPoolId());
+	if (p == NULL) {
+		return;
+	}
+
+	uint32_t now = Chateau_GetTimeUs();
+
+	ScopedLock lock;
+	updateUsed(p, pool->getPoolNumSegs() - pool->getPoolNumAvailSegs(), now);
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_STATS */
+
+/*****************************************************************
+ * メモリプールの統計を取得する
+ *****************************************************************/
+err_t Manager::getPoolStats(PoolId id, PoolStats& stats)
+{
+	MemPool* pool = getPoolObject(id);
+	if (pool == NULL) {
+		return ERR_ARG;
+	}
+
+	memset(&stats, 0x00, sizeof(stats));
+
+	ScopedLock lock;
+
+	stats.num_segs  = pool->getPoolNumSegs();
+	stats.cur_used  = stats.num_segs - pool->getPoolNumAvailSegs();
+	stats.peak_used = stats.cur_used;
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS
+	PoolStatsCounter* p = getCounter(id);
+	if (p) {
+		uint32_t now = Chateau_GetTimeUs();
+
+		updateUsed(p, stats.cur_used, now);
+		stats.alloc_count  = p->alloc_count;
+		stats.free_count   = p->alloc_count + p->base_used - p->cur_used;
+		stats.fail_count   = p->fail_count;
+		stats.peak_used    = p->peak_used;
+		stats.elapsed_time = p->elapsed_time;
+		stats.used_time    = p->used_time;
+	}
+#endif
+	return ERR_OK;
+}
+
+/*****************************************************************
+ * メモリプールの統計をクリアする
+ * 使用中セグメント数はクリアしない
+ *****************************************************************/
+err_t Manager::clearPoolStats(PoolId id)
+{
+	MemPool* pool = getPoolObject(id);
+	if (pool == NULL) {
+		return ERR_ARG;
+	}
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS
+	PoolStatsCounter* p = getCounter(id);
+	if (p) {
+		uint32_t now = Chateau_GetTimeUs();
+
+		ScopedLock lock;
+
+		memset(p, 0x00, sizeof(*p));
+		p->base_used  = pool->getPoolNumSegs() - pool->getPoolNumAvailSegs();
+		p->cur_used   = p->base_used;
+		p->peak_used  = p->base_used;
+		p->last_time  = now;
+	}
+#endif
+	return ERR_OK;
+}
+
+/*****************************************************************
+ * セクションの全プールの統計をクリアする
+ *****************************************************************/
+void Manager::clearStaticPoolsStats(uint8_t sec)
+{
+	if (theManager == NULL || !isStaticPoolAvailable(sec)) {
+		return;
+	}
+
+	/* プールID=0は予約 */
+	for (uint8_t id = 1; id < theManager->m_pool_num[sec]; ++id) {
+		if (theManager->m_static_pools[sec][id] != NULL) {
+			PoolId pool_id;
+			pool_id.sec  = sec;
+			pool_id.pool = id;
+			clearPoolStats(pool_id);
+		}
+	}
+}
+
+/*****************************************************************
+ * セグメント確保エラーのログを古い順に取得する
+ *****************************************************************/
+uint32_t Manager::getAllocFailLog(AllocFailLog* log, uint32_t num)
+{
+	uint32_t n = 0;
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS
+	ScopedLock lock;
+
+	for (; n < num && n < s_fail_num; ++n) {
+		log[n] = s_fail_log[(s_fail_head + n) % CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_FAIL_LOG];
+	}
+#else
+	(void)log;
+	(void)num;
+#endif
+	return n;
+}
+
+void Manager::clearAllocFailLog()
+{
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS
+	ScopedLock lock;
+
+	s_fail_head = 0;
+	s_fail_num  = 0;
+#endif
+}
+
+/*****************************************************************
+ * セクションの全プールの統計と、確保エラーのログを表示する
+ *****************************************************************/
+void Manager::dumpPoolStats(uint8_t sec)
+{
+	PoolStats stats;
+
+	if (theManager == NULL || !isStaticPoolAvailable(sec)) {
+		return;
+	}
+
+	/* プールIDとプール名の対応付けのため、レイアウト番号も表示する */
+	printf("section %u layout %u\n", sec, getCurrentLayoutNo(sec));
+	printf(" id  segs  used  peak  avg.used      alloc       free   fail\n");
+
+	/* プールID=0は予約 */
+	for (uint8_t id = 1; id < theManager->m_pool_num[sec]; ++id) {
+		PoolId pool_id;
+		pool_id.sec  = sec;
+		pool_id.pool = id;
+
+		if (theManager->m_static_pools[sec][id] == NULL ||
+		    getPoolStats(pool_id, stats) != ERR_OK) {
+			continue;
+		}
+
+		/* 平均使用セグメント数は、小数点以下2桁まで表示する */
+		uint32_t avg = (stats.elapsed_time == 0) ? stats.cur_used * 100 :
+			static_cast<uint32_t>(stats.used_time * 100 / stats.elapsed_time);
+
+		printf("%3u  %4u  %4u  %4u  %5u.%02u  %9u  %9u  %5u\n",
+		       id, stats.num_segs, stats.cur_used, stats.peak_used,
+		       avg / 100, avg % 100,
+		       stats.alloc_count, stats.free_count, stats.fail_count);
+	}
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS
+	AllocFailLog log[CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_FAIL_LOG];
+	uint32_t num = getAllocFailLog(log, CONFIG_MEMUTILS_MEMORY_MANAGER_STATS_FAIL_LOG);
+
+	printf("allocation errors (oldest first)\n");
+	printf("    time(us)  sec  id   size   pid  err\n");
+	for (uint32_t i = 0; i < num; ++i) {
+		printf("%12u  %3u  %2u  %5u  %4d  %s\n",
+		       log[i].time, log[i].id.sec, log[i].id.pool, log[i].size,
+		       log[i].pid, (log[i].err == ERR_MEM_EMPTY) ? "empty" : "size");
+	}
+#endif
+}
+
+} /* end of namespace MemMgrLite */
+
+/* getPoolStats.cxx */
@@ -35,6 +35,12 @@
 
 #include "memutils/memory_manager/MemHandleBase.h"
 #include "BasicPool.h"
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+#include "BitmapPool.h"
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+#include "RingBufPool.h"
+#endif
 
 namespace MemMgrLite {
 
@@ -45,13 +51,19 @@ PoolAddr Manager::getSegAddr(const MemHandleBase& mh)
 {
 	MemPool* pool = findPool(mh.getPoolId());
 
-#ifdef USE_MEMMGR_RINGBUF_POOL
+#if defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL) || defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL)
 	/* 仮想関数を使用しない方針なので、該当プール型にダウンキャストする */
 	switch (pool->getPoolType()) {
 	case BasicType:
 		return static_cast<BasicPool*>(pool)->getSegAddr(mh);
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
 	case RingBufType:
 		return static_cast<RingBufPool*>(pool)->getSegAddr(mh);
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+	case BitmapType:
+		return static_cast<BitmapPool*>(pool)->getSegAddr(mh);
+#endif
 	default:
 		D_ASSERT(false);
 		return BadPoolAddr;
@@ -73,6 +85,41 @@ PoolAddr BasicPool::getSegAddr(const MemHandleBase& mh) const
 	return getPoolAddr() + ((seg_no - 1) * getSegSize());
 }
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+/*****************************************************************
+ * Bitmapプールのセグメントのアドレスを取得する
+ *****************************************************************/
+PoolAddr BitmapPool::getSegAddr(const MemHandleBase& mh) const
+{
+	NumSeg seg_no = mh.getSegNo();
+	D_ASSERT(seg_no != NullSegNo && seg_no <= getPoolNumSegs());
+
+	return getPoolAddr() + ((seg_no - 1) * getSegSize());
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL */
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+/*****************************************************************
+ * RingBufプールのセグメント番号からインデックスを求める
+ *****************************************************************/
+NumSeg RingBufPool::getSegIndex(const MemHandleBase& mh) const
+{
+	NumSeg seg_no = mh.getSegNo();
+	D_ASSERT(seg_no != NullSegNo && seg_no <= getPoolNumSegs());
+	D_ASSERT(m_ref_cnt_array[seg_no - 1] != 0);	/* 使用中のはず */
+
+	return seg_no - 1;
+}
+
+/*****************************************************************
+ * RingBufプールのセグメントのアドレスを取得する
+ *****************************************************************/
+PoolAddr RingBufPool::getSegAddr(const MemHandleBase& mh) const
+{
+	return getPoolAddr() + m_seg_desc[getSegIndex(mh)].offset;
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL */
+
 } /* end of namespace MemMgrLite */
 
 /* getSegAddr.cxx */
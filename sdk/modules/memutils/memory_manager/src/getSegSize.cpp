@@ -35,6 +35,12 @@
 
 #include "memutils/memory_manager/MemHandleBase.h"
 #include "BasicPool.h"
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+#include "BitmapPool.h"
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+#include "RingBufPool.h"
+#endif
 
 namespace MemMgrLite {
 
@@ -45,15 +51,23 @@ PoolSize Manager::getSegSize(const MemHandleBase& mh)
 {
 	MemPool* pool = findPool(mh.getPoolId());
 
-#ifdef USE_MEMMGR_RINGBUF_POOL
+#if defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL) || defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL)
 	/* 仮想関数を使用しない方針なので、該当プール型にダウンキャストする */
 	PoolSize size = 0;
 	switch (pool->getPoolType()) {
 	case BasicType:
 		size = static_cast<BasicPool*>(pool)->getSegSize();
 		break;
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
 	case RingBufType:
-		size = static_cast<RingBufPool*>(pool)->getSegSize();
+		size = static_cast<RingBufPool*>(pool)->getSegSize(mh);
+		break;
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+	case BitmapType:
+		size = static_cast<BitmapPool*>(pool)->getSegSize();
+		break;
+#endif
 	default:
 		D_ASSERT(false);
 		break;
@@ -65,6 +79,16 @@ PoolSize Manager::getSegSize(const MemHandleBase& mh)
 #endif
 }
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+/*****************************************************************
+ * RingBufプールのセグメントのサイズを取得する
+ *****************************************************************/
+PoolSize RingBufPool::getSegSize(const MemHandleBase& mh) const
+{
+	return m_seg_desc[getSegIndex(mh)].size;
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL */
+
 } /* end of namespace MemMgrLite */
 
 /* getSegSize.cxx */
@@ -34,6 +34,12 @@
  ****************************************************************************/
 
 #include "memutils/memory_manager/MemHandleBase.h"
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+#include "BitmapPool.h"
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+#include "RingBufPool.h"
+#endif
 
 namespace MemMgrLite {
 
@@ -65,6 +71,12 @@ uint32_t MemPool::getUsedSegs(MemHandleBase* mhs, uint32_t num_mhs)
 {
 	D_ASSERT(mhs && num_mhs);
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+	if (getPoolType() == BitmapType) {
+		return static_cast<BitmapPool*>(this)->getUsedSegs(mhs, num_mhs);
+	}
+#endif
+
 #if 0 /* 効率化のため、生成直後の空のハンドル群を渡すよう仕様書に記載済み */
 	for (uint32_t i = 0; i < num_mhs; ++i) {
 		mhs[i].freeSeg();
@@ -83,6 +95,56 @@ uint32_t MemPool::getUsedSegs(MemHandleBase* mhs, uint32_t num_mhs)
 	return n;
 }
 
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+/********************************************************************************
+ * Bitmapプールの使用中のセグメントをメモリハンドルに格納し、格納した数を返す
+ * ビットマップのワード単位で、未使用のセグメントを読み飛ばす
+ ********************************************************************************/
+uint32_t BitmapPool::getUsedSegs(MemHandleBase* mhs, uint32_t num_mhs)
+{
+	uint32_t n = 0;
+	uint32_t map_words = getMapWords(getPoolNumSegs());
+
+	for (uint32_t w = 0; w < map_words && n < num_mhs; ++w) {
+		/* 末尾の存在しないセグメントは除く */
+		uint32_t rest = getPoolNumSegs() - w * 32;
+		uint32_t used = ~m_free_map[w];
+		if (rest < 32) {
+			used &= ~(0xffffffffu >> rest);
+		}
+
+		while (used != 0 && n < num_mhs) {
+			uint32_t idx = w * 32 + __builtin_clz(used);
+			used &= ~bitOf(idx);
+			incSegRefCnt(static_cast<NumSeg>(idx + 1));	/* セグメント番号は、1 origin */
+			mhs[n++].m_proxy = MemHandleBase::makeMemHandleProxy(getPoolId(), static_cast<NumSeg>(idx + 1), 0);
+		}
+	}
+	return n;
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL */
+
+#if defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL) || defined(CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL)
+/********************************************************************************
+ * メモリプールの使用可能なセグメント数を返す
+ ********************************************************************************/
+NumSeg MemPool::getPoolNumAvailSegs() const
+{
+	switch (getPoolType()) {
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+	case RingBufType:
+		return static_cast<const RingBufPool*>(this)->getPoolNumAvailSegs();
+#endif
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+	case BitmapType:
+		return static_cast<const BitmapPool*>(this)->getPoolNumAvailSegs();
+#endif
+	default:
+		return m_seg_no_que.size();
+	}
+}
+#endif
+
 } /* end of namespace MemMgrLite */
 
 /* getUsedSegs.cxx */
@@ -48,7 +48,7 @@ err_t Manager::initFirst(void* manager_area, uint32_t area_size)
   printf("Manager::initFirst(addr=%08x, size=%08x)\n", manager_area, area_size);
 #endif
 
-  if (reinterpret_cast<uint32_t>(manager_area) % sizeof(uint32_t) != 0)
+  if (reinterpret_cast<uintptr_t>(manager_area) % sizeof(uint32_t) != 0)
     {
       return ERR_ADR_ALIGN;
     }
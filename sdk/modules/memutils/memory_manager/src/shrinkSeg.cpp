@@ -0,0 +1,89 @@
+/****************************************************************************
+ * modules/memutils/memory_manager/src/shrinkSeg.cpp
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "ScopedLock.h"
+#include "memutils/memory_manager/MemHandleBase.h"
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+#include "RingBufPool.h"
+#endif
+
+namespace MemMgrLite {
+
+/*****************************************************************
+ * メモリセグメントを使用するサイズに縮小する
+ * RingBufプール以外は、セグメントサイズのチェックのみ行う
+ *****************************************************************/
+err_t Manager::shrinkSeg(MemHandleBase& mh, size_t size)
+{
+	MemPool* pool = findPool(mh.getPoolId());
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+	/* 仮想関数を使用しない方針なので、該当プール型にダウンキャストする */
+	if (pool->getPoolType() == RingBufType) {
+		return static_cast<RingBufPool*>(pool)->shrinkSeg(mh, size);
+	}
+#else
+	(void)pool;
+#endif
+	return (size <= getSegSize(mh)) ? ERR_OK : ERR_DATA_SIZE;
+}
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
+/*****************************************************************
+ * RingBufプールのセグメントを縮小する
+ * 最後に取得したセグメントならば、余った領域を返却する
+ *****************************************************************/
+err_t RingBufPool::shrinkSeg(MemHandleBase& mh, size_t size)
+{
+	NumSeg idx = getSegIndex(mh);
+
+	ScopedLock lock;
+
+	if (size > m_seg_desc[idx].size) {
+		return ERR_DATA_SIZE;
+	}
+
+	m_seg_desc[idx].size = static_cast<PoolSize>(size);
+	if (isLastSeg(idx)) {
+		m_wr = m_seg_desc[idx].offset + getAreaSize(size);
+	}
+	return ERR_OK;
+}
+#endif /* CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL */
+
+} /* end of namespace MemMgrLite */
+
+/* shrinkSeg.cxx */
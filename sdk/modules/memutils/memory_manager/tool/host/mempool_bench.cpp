@@ -0,0 +1,476 @@
+/****************************************************************************
+ * modules/memutils/memory_manager/tool/host/mempool_bench.cpp
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/* Segment allocator benchmark of MemMgrLite on the host.
+ *
+ * The same pools are created as BasicType (segment number queue) and
+ * BitmapType (free segment bitmap), and the following are measured.
+ *  - work area size needed to create the pool
+ *  - fill : allocate all segments, then free all of them
+ *  - churn: free or allocate a random segment, half of pool is in use
+ *  - used : Manager::getUsedSegs() with half of pool in use
+ *
+ * Then ES frames of random size are streamed in FIFO order through a
+ * BasicType pool of the worst case frame size segments and a
+ * RingBufType pool of the same area, allocated as the worst case and
+ * shrunk to the frame size. The average number of frames which can be
+ * queued and the time of alloc + shrink + free are measured.
+ *
+ * Segment memory is not accessed, so pool address is a dummy.
+ * Built with STATS=1, the statistics of the ES pools are shown.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "memutils/memory_manager/MemHandleBase.h"
+
+using namespace MemMgrLite;
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define BENCH_POOL_ADDR   0x10000000
+#define BENCH_SEG_SIZE    64
+#define BENCH_MAX_SEGS    255
+#define BENCH_WORK_SIZE   0x4000
+
+/* MP3 frame of 44.1kHz, from 64kbps to 320kbps */
+
+#define ES_MIN_FRAME      208
+#define ES_MAX_FRAME      1044
+#define ES_BASIC_SEGS     8
+#define ES_POOL_SIZE      (ES_BASIC_SEGS * ES_MAX_FRAME)
+#define ES_RING_SEGS      64
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+enum
+{
+  NULL_POOL = 0,
+  BASIC_8_POOL,
+  BASIC_32_POOL,
+  BASIC_255_POOL,
+  BITMAP_8_POOL,
+  BITMAP_32_POOL,
+  BITMAP_255_POOL,
+  ES_BASIC_POOL,
+  ES_RING_POOL,
+  NUM_MEM_POOLS
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Each layout has one pool. The pool refers to the attribute while it
+ * exists, so the layouts are static.
+ */
+
+#define BENCH_LAYOUT(id, type, seg) \
+  { { { id, 0 }, type, seg, BENCH_POOL_ADDR, (seg) * BENCH_SEG_SIZE }, \
+    { { 0, 0 }, 0, 0, 0, 0 } }
+
+static const PoolSectionAttr s_layouts[][2] =
+{
+  BENCH_LAYOUT(BASIC_8_POOL,    BasicType,  8),
+  BENCH_LAYOUT(BASIC_32_POOL,   BasicType,  32),
+  BENCH_LAYOUT(BASIC_255_POOL,  BasicType,  255),
+  BENCH_LAYOUT(BITMAP_8_POOL,   BitmapType, 8),
+  BENCH_LAYOUT(BITMAP_32_POOL,  BitmapType, 32),
+  BENCH_LAYOUT(BITMAP_255_POOL, BitmapType, 255),
+};
+
+static const PoolSectionAttr s_es_layouts[][2] =
+{
+  { { { ES_BASIC_POOL, 0 }, BasicType, ES_BASIC_SEGS, BENCH_POOL_ADDR,
+      ES_POOL_SIZE },
+    { { 0, 0 }, 0, 0, 0, 0 } },
+  { { { ES_RING_POOL, 0 }, RingBufType, ES_RING_SEGS, BENCH_POOL_ADDR,
+      ES_POOL_SIZE },
+    { { 0, 0 }, 0, 0, 0, 0 } },
+};
+
+static uint32_t s_manager_area[64];
+static uint32_t s_work_area[BENCH_WORK_SIZE / sizeof(uint32_t)];
+
+static MemPool *s_pools_block[NUM_MEM_POOLS];
+static MemPool **s_pools[1] = { s_pools_block };
+static uint8_t  s_pool_num[1] = { NUM_MEM_POOLS };
+static uint8_t  s_layout_no[1] = { BadLayoutNo };
+
+static MemHandleBase s_mh[BENCH_MAX_SEGS];
+static MemHandleBase s_used[BENCH_MAX_SEGS];
+
+static uint32_t s_rand = 2463534242u;
+
+namespace MemMgrLite
+{
+  MemPool *static_pools[NUM_MEM_POOLS];
+}
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint64_t now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint32_t xorshift(void)
+{
+  s_rand ^= s_rand << 13;
+  s_rand ^= s_rand >> 17;
+  s_rand ^= s_rand << 5;
+  return s_rand;
+}
+
+static err_t create_layout(const PoolSectionAttr *layout, uint32_t work_size)
+{
+  return Manager::createStaticPools(0, 0, s_work_area, work_size, layout);
+}
+
+/* Smallest work area size which can create the pool. */
+
+static uint32_t measure_work_size(const PoolSectionAttr *layout)
+{
+  for (uint32_t size = sizeof(uint32_t); size <= BENCH_WORK_SIZE;
+       size += sizeof(uint32_t))
+    {
+      if (create_layout(layout, size) == ERR_OK)
+        {
+          Manager::destroyStaticPools(0);
+          return size;
+        }
+    }
+
+  return 0;
+}
+
+static void alloc_seg(MemHandleBase &mh, PoolId id)
+{
+  if (mh.allocSeg(id, BENCH_SEG_SIZE) != ERR_OK)
+    {
+      printf("allocSeg error\n");
+      exit(EXIT_FAILURE);
+    }
+}
+
+static double bench_fill(PoolId id, uint32_t num_segs, uint32_t loops)
+{
+  uint64_t start = now_ns();
+
+  for (uint32_t l = 0; l < loops; l++)
+    {
+      for (uint32_t i = 0; i < num_segs; i++)
+        {
+          alloc_seg(s_mh[i], id);
+        }
+
+      for (uint32_t i = num_segs; i > 0; i--)
+        {
+          s_mh[i - 1].freeSeg();
+        }
+    }
+
+  return (double)(now_ns() - start) / ((uint64_t)loops * num_segs * 2);
+}
+
+static void fill_half(PoolId id, uint32_t num_segs)
+{
+  for (uint32_t i = 0; i < num_segs; i++)
+    {
+      if (xorshift() & 1)
+        {
+          alloc_seg(s_mh[i], id);
+        }
+    }
+}
+
+static void free_all(uint32_t num_segs)
+{
+  for (uint32_t i = 0; i < num_segs; i++)
+    {
+      s_mh[i].freeSeg();
+    }
+}
+
+static double bench_churn(PoolId id, uint32_t num_segs, uint32_t loops)
+{
+  fill_half(id, num_segs);
+
+  uint64_t start = now_ns();
+
+  for (uint32_t l = 0; l < loops; l++)
+    {
+      MemHandleBase &mh = s_mh[xorshift() % num_segs];
+
+      if (mh.isAvail())
+        {
+          mh.freeSeg();
+        }
+      else
+        {
+          alloc_seg(mh, id);
+        }
+    }
+
+  double ns = (double)(now_ns() - start) / loops;
+
+  free_all(num_segs);
+  return ns;
+}
+
+static double bench_used(PoolId id, uint32_t num_segs, uint32_t loops)
+{
+  uint64_t elapsed = 0;
+
+  fill_half(id, num_segs);
+
+  for (uint32_t l = 0; l < loops; l++)
+    {
+      uint64_t start = now_ns();
+      uint32_t n = Manager::getUsedSegs(0, id, s_used, num_segs);
+      elapsed += now_ns() - start;
+
+      /* Release the references taken by getUsedSegs. */
+
+      for (uint32_t i = 0; i < n; i++)
+        {
+          s_used[i].freeSeg();
+        }
+    }
+
+  free_all(num_segs);
+  return (double)elapsed / loops;
+}
+
+/* The segment must be in the pool and must not overlap the queued ones. */
+
+static void check_es_seg(const MemHandleBase &mh, uint32_t head,
+                         uint32_t num)
+{
+  PoolAddr addr = mh.getAddr();
+  PoolSize size = mh.getSize();
+
+  if (addr < BENCH_POOL_ADDR ||
+      addr + size > BENCH_POOL_ADDR + ES_POOL_SIZE)
+    {
+      printf("segment out of pool\n");
+      exit(EXIT_FAILURE);
+    }
+
+  for (uint32_t i = 0; i < num; i++)
+    {
+      const MemHandleBase &q = s_mh[(head + i) % BENCH_MAX_SEGS];
+
+      if (addr < q.getAddr() + q.getSize() && q.getAddr() < addr + size)
+        {
+          printf("segment overlap\n");
+          exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/* Queue frames until the pool is full, then dequeue the oldest one. */
+
+static double bench_stream(PoolId id, uint32_t loops, double *ns)
+{
+  uint32_t head  = 0;
+  uint32_t num   = 0;
+  uint64_t depth = 0;
+  uint64_t elapsed = 0;
+
+  for (uint32_t l = 0; l < loops; l++)
+    {
+      for (; ; )
+        {
+          MemHandleBase &mh = s_mh[(head + num) % BENCH_MAX_SEGS];
+          uint32_t frame =
+            ES_MIN_FRAME + xorshift() % (ES_MAX_FRAME - ES_MIN_FRAME + 1);
+
+          uint64_t start = now_ns();
+          err_t    err   = mh.allocSeg(id, ES_MAX_FRAME);
+          if (err == ERR_OK)
+            {
+              err = mh.shrinkSeg(frame);
+            }
+          elapsed += now_ns() - start;
+
+          if (err != ERR_OK)
+            {
+              break;
+            }
+
+          check_es_seg(mh, head, num);
+          num++;
+        }
+
+      depth += num;
+
+      uint64_t start = now_ns();
+      s_mh[head].freeSeg();
+      elapsed += now_ns() - start;
+
+      head = (head + 1) % BENCH_MAX_SEGS;
+      num--;
+    }
+
+  while (num > 0)
+    {
+      s_mh[head].freeSeg();
+      head = (head + 1) % BENCH_MAX_SEGS;
+      num--;
+    }
+
+  /* In the steady state, one frame is allocated and freed per loop.
+   * The failed allocation which detects the full pool is included.
+   */
+
+  *ns = (double)elapsed / loops;
+  return (double)depth / loops;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  uint32_t loops = 20000;
+  int      opt;
+
+  while ((opt = getopt(argc, argv, "n:")) != -1)
+    {
+      switch (opt)
+        {
+          case 'n':
+            loops = strtoul(optarg, NULL, 0);
+            break;
+
+          default:
+            printf("Usage: %s [-n loops]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+  if (Manager::initFirst(s_manager_area, sizeof(s_manager_area)) != ERR_OK ||
+      Manager::initPerCpu(s_manager_area, s_pools, s_pool_num, s_layout_no)
+        != ERR_OK)
+    {
+      printf("Manager initialize error\n");
+      return EXIT_FAILURE;
+    }
+
+  printf("type    segs  work(bytes)  fill(ns/op)  churn(ns/op)  used(ns/call)\n");
+
+  for (size_t i = 0; i < COUNT_OF(s_layouts); i++)
+    {
+      const PoolSectionAttr &attr = s_layouts[i][0];
+      uint32_t work_size = measure_work_size(s_layouts[i]);
+
+      if (create_layout(s_layouts[i], BENCH_WORK_SIZE) != ERR_OK)
+        {
+          printf("createStaticPools error\n");
+          return EXIT_FAILURE;
+        }
+
+      double fill  = bench_fill(attr.id, attr.num_segs, loops / 8 + 1);
+      double churn = bench_churn(attr.id, attr.num_segs, loops * 16);
+      double used  = bench_used(attr.id, attr.num_segs, loops / 8 + 1);
+
+      if (Manager::getPoolNumAvailSegs(attr.id) != attr.num_segs)
+        {
+          printf("segment leak\n");
+          return EXIT_FAILURE;
+        }
+
+      Manager::destroyStaticPools(0);
+
+      printf("%-6s  %4u  %11u  %11.1f  %12.1f  %13.1f\n",
+             attr.type == BasicType ? "basic" : "bitmap", attr.num_segs,
+             work_size, fill, churn, used);
+    }
+
+  printf("\nES stream, frame %u-%u bytes, pool %u bytes\n",
+         ES_MIN_FRAME, ES_MAX_FRAME, ES_POOL_SIZE);
+  printf("type     segs  work(bytes)  queued(frames)  alloc+free(ns/frame)\n");
+
+  for (size_t i = 0; i < COUNT_OF(s_es_layouts); i++)
+    {
+      const PoolSectionAttr &attr = s_es_layouts[i][0];
+      uint32_t work_size = measure_work_size(s_es_layouts[i]);
+      double   ns;
+
+      if (create_layout(s_es_layouts[i], BENCH_WORK_SIZE) != ERR_OK)
+        {
+          printf("createStaticPools error\n");
+          return EXIT_FAILURE;
+        }
+
+      double queued = bench_stream(attr.id, loops, &ns);
+
+#ifdef CONFIG_MEMUTILS_MEMORY_MANAGER_STATS
+      Manager::dumpPoolStats(0);
+      Manager::clearAllocFailLog();
+#endif
+
+      if (Manager::getPoolNumAvailSegs(attr.id) != attr.num_segs)
+        {
+          printf("segment leak\n");
+          return EXIT_FAILURE;
+        }
+
+      Manager::destroyStaticPools(0);
+
+      printf("%-7s  %4u  %11u  %14.1f  %20.1f\n",
+             attr.type == BasicType ? "basic" : "ringbuf", attr.num_segs,
+             work_size, queued, ns);
+    }
+
+  Manager::finalize();
+
+  return EXIT_SUCCESS;
+}
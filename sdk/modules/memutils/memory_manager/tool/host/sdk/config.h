@@ -0,0 +1,11 @@
+/* Host configuration of the memory manager (see Makefile). */
+
+#ifndef __SDK_CONFIG_H
+#define __SDK_CONFIG_H
+
+#define CONFIG_MEMUTILS_MEMORY_MANAGER 1
+#define CONFIG_MEMUTILS_MEMORY_MANAGER_NUM_FIXED_AREA_FENCES 0
+#define CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL 1
+#define CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL 1
+
+#endif /* __SDK_CONFIG_H */
@@ -79,6 +79,8 @@ EnableOutputMacro = false
 
 Basic   = "BasicType"
 RingBuf = "RingBufType"
+Bitmap  = "BitmapType"   # Needs CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+                         # RingBuf needs CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
 
 MinNameSize   = 3
 FenceSize     = 4
@@ -360,7 +362,7 @@ class PoolEntry < BaseEntry
     abort("Area not found at #{name}")         if !area_entry
     abort("Not RAM area found at #{name}")     if !area_entry.dev_entry.ram
     abort("Redefine name found at #{name}")    if MemoryDevices[name]
-    abort("Bad pool type found at #{name}")    if type != Basic and type != RingBuf
+    abort("Bad pool type found at #{name}")    if type != Basic and type != RingBuf and type != Bitmap
     abort("Don't use RingBuf type at #{name}") if type == RingBuf and !UseRingBufPool
     abort("Bad pool align found at #{name}")   if align % MinAlign != 0 or align == 0
     abort("Too big pool align at #{name}")     if align >= area_entry.last_addr
@@ -383,9 +385,9 @@ end
 
 #######################################################################
 class PoolEntryFixParam < BaseEntry
-  def initialize(name, area, align, size, seg, fence)
+  def initialize(name, area, align, size, seg, fence, type = Basic)
     @area_entry = FixedAreas[area]
-    @type = Basic
+    @type = type
     @align = align
     @num_seg = seg
     @skip_size = 0
@@ -396,6 +398,7 @@ class PoolEntryFixParam < BaseEntry
     abort("Area not found at #{name}")         if !area_entry
     abort("Not RAM area found at #{name}")     if !area_entry.dev_entry.ram
     abort("Redefine name found at #{name}")    if MemoryDevices[name]
+    abort("Bad pool type found at #{name}")    if type != Basic and type != RingBuf and type != Bitmap
     abort("Bad pool align found at #{name}")   if align % MinAlign != 0 or align == 0
     abort("Too big pool align at #{name}")     if align >= area_entry.last_addr
     if size != RemainderSize
@@ -418,16 +421,36 @@ end
 #  - Alignment adjustment of MemPool area         : 0-3
 #  - Pool attribute area(Usually in static pool 0): 0, 12 or 16
 #  - BasicPool(=MemPool) area                      : 12 + 4 * sizeof(NumSeg)
-#  - RingBufPool area                              : To be determined(MemPool Area+alpha)
+#  - RingBufPool area                              : MemPool area + 16
+#  - BitmapPool area                               : MemPool area + 8
 #  - Data area of the segment number queue         : Number of segments * sizeof(NumSeg)
+#                                                    (BitmapPool and RingBufPool do not have it)
+#  - Data area of the bitmap and summary bitmap     : 4 * (ceil(segs/32) + ceil(segs/1024))
+#                                                    (Only BitmapPool)
+#  - Data area of the segment descriptors          : Number of segments * 8
+#                                                    (Only RingBufPool)
 #  - Reference counter area                        : Number of segments * sizeof(SegRefCnt)
 NumSegSize              = UseOver255Segments ? 2 : 1
 SegRefCntSize           = 1
 PoolAttrSize            = round_up(10 + NumSegSize + (UseFence ? 1 : 0) + (UseMultiCore ? 1 : 0), 4)
 MemPoolDataSize         = 12 + 4 * NumSegSize   # 16 or 20
 BasicPoolDataSize       = MemPoolDataSize
-RingBufPoolDataSize     = MemPoolDataSize + 32  # Tentative value for details unexamined
-RingBufPoolSegDataSize  = 8                     # Tentative value for details unexamined
+RingBufPoolDataSize     = MemPoolDataSize + 16  # 32 or 36
+RingBufPoolSegDataSize  = 8                     # offset and size of a segment
+BitmapPoolDataSize      = MemPoolDataSize + 8   # 24 or 28
+
+def bitmap_size(num_seg)
+  map_words = (num_seg + 31) / 32
+  return 4 * (map_words + (map_words + 31) / 32)
+end
+
+def pool_data_size(pool)
+  case pool.type
+  when Basic  then BasicPoolDataSize + pool.num_seg * NumSegSize
+  when Bitmap then BitmapPoolDataSize + bitmap_size(pool.num_seg)
+  else             RingBufPoolDataSize + pool.num_seg * RingBufPoolSegDataSize
+  end
+end
 
 #######################################################################
 class PoolLayout
@@ -460,8 +483,7 @@ class PoolLayout
     layout_work_size = 0
     @pools.each do |pool|
       pool_work_size = (UseCopiedPoolAttr) ? PoolAttrSize : 0
-      pool_work_size += (pool.type == Basic) ? BasicPoolDataSize : RingBufPoolDataSize
-      pool_work_size += pool.num_seg * NumSegSize    # Data area of the segment number queue
+      pool_work_size += pool_data_size(pool)         # Pool object and free segment management
       pool_work_size += pool.num_seg * SegRefCntSize # Reference counter area
       # Round up to the MinAlign unit and integrate
       layout_work_size += round_up(pool_work_size, MinAlign)
@@ -528,7 +550,7 @@ class PoolAreas
         io.printf("#define L#{index}_#{pool.name}_SIZE     0x%08x\n", pool.size)
         io.printf("#define L#{index}_#{pool.name}_U_FENCE  0x%08x\n", pool.begin_addr + pool.size) if pool.fence_flag
         io.printf("#define L#{index}_#{pool.name}_NUM_SEG  0x%08x\n", pool.num_seg)
-        io.printf("#define L#{index}_#{pool.name}_SEG_SIZE 0x%08x\n", pool.size / pool.num_seg) if pool.type == Basic
+        io.printf("#define L#{index}_#{pool.name}_SEG_SIZE 0x%08x\n", pool.size / pool.num_seg) if pool.type == Basic or pool.type == Bitmap
         io.print("\n")
       end
       layout.used_area_info.each do |name_remainder|
@@ -38,6 +38,10 @@
 uint32_t	MsgLib::num_msg_pools;
 uint32_t	MsgLib::msgq_top_drm = 0;
 
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+MsgQueStats	MsgStats::m_stats[CONFIG_MEMUTILS_MESSAGE_STATS_MAX_QUEUES];
+#endif
+
 /*****************************************************************
  * メッセージキューブロックの0番は未使用なので、ヘッダとして使用する
  *****************************************************************/
@@ -169,7 +173,8 @@ err_t MsgLib::initPerCpu()
             {
               /* 自CPU所有キューの初期化(アドレス設定、セマフォ生成、キャッシュ操作など) */
 
-              err_code = mqb[id].setup(src[id].n_drm, src[id].n_size, src[id].n_num, src[id].h_drm, src[id].h_size, src[id].h_num);
+              err_code = mqb[id].setup(src[id].n_drm, src[id].n_size, src[id].n_num, src[id].h_drm, src[id].h_size, src[id].h_num,
+                                       static_cast<MsgQueMode>(src[id].mode));
               if (err_code != ERR_OK)
                 {
                   break;
@@ -326,6 +331,50 @@ err_t MsgLib::send(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, cons
   return err_code;
 }
 
+#ifdef CONFIG_MEMUTILS_MESSAGE_MEMHANDLE
+err_t MsgLib::sendMemHandle(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, MemMgrLite::MemHandle& mh)
+{
+  FAR MsgQueBlock* que;
+  err_t            err_code = ERR_OK;
+
+  err_code = referMsgQueBlock(dest, &que);
+  if (err_code == ERR_OK)
+    {
+      return que->send(pri, type, reply, MsgPacket::MsgFlagWaitParam, MsgMemHandleParam(mh));
+    }
+
+  return err_code;
+}
+
+err_t MsgLib::sendMemHandleIsr(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, MemMgrLite::MemHandle& mh)
+{
+  FAR MsgQueBlock* que;
+  err_t            err_code = ERR_OK;
+
+  err_code = referMsgQueBlock(dest, &que);
+  if (err_code == ERR_OK)
+    {
+      return que->sendIsr(pri, type, reply, MsgMemHandleParam(mh));
+    }
+
+  return err_code;
+}
+#endif
+
+err_t MsgLib::sendBatch(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply, const void* params, size_t param_size, uint32_t num)
+{
+  FAR MsgQueBlock* que;
+  err_t            err_code = ERR_OK;
+
+  err_code = referMsgQueBlock(dest, &que);
+  if (err_code == ERR_OK)
+    {
+      return que->sendBatch(pri, type, reply, MsgBatchRangedParam(params, param_size), num);
+    }
+
+  return err_code;
+}
+
 err_t MsgLib::sendIsr(MsgQueId dest, MsgPri pri, MsgType type, MsgQueId reply)
 {
   FAR MsgQueBlock* que;
@@ -371,6 +420,99 @@ err_t MsgLib::notifyRecv(MsgQueId dest)
   return err_code;
 }
 
+/*****************************************************************
+ * Get the statistics of message queue.
+ *****************************************************************
+ */
+err_t MsgLib::getStats(MsgQueId id, MsgQueStats& stats)
+{
+  FAR MsgQueBlock* que;
+  err_t            err_code;
+
+  err_code = referMsgQueBlock(id, &que);
+  if (err_code != ERR_OK)
+    {
+      return err_code;
+    }
+
+  memset(&stats, 0x00, sizeof(stats));
+
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+  FAR MsgQueStats* counter = MsgStats::get(id);
+  if (counter != NULL)
+    {
+      stats = *counter;
+    }
+#endif
+
+  for (uint32_t pri = MsgPriNormal; pri < NumMsgPri; pri++)
+    {
+      MsgPri p = static_cast<MsgPri>(pri);
+
+      stats.cur_num[pri]    = que->getNumMsg(p);
+      stats.capacity[pri]   = stats.cur_num[pri] + que->getRest(p);
+      stats.high_water[pri] = que->getMaxQueuing(p);
+    }
+
+  return ERR_OK;
+}
+
+/*****************************************************************
+ * Clear the statistics of message queue.
+ *****************************************************************
+ */
+err_t MsgLib::clearStats(MsgQueId id)
+{
+  FAR MsgQueBlock* que;
+  err_t            err_code;
+
+  err_code = referMsgQueBlock(id, &que);
+  if (err_code == ERR_OK)
+    {
+      que->clearTally();
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+      MsgStats::clear(id);
+#endif
+    }
+
+  return err_code;
+}
+
+/*****************************************************************
+ * Print the statistics of all message queues.
+ *****************************************************************
+ */
+void MsgLib::dumpStats()
+{
+  MsgQueStats stats;
+
+  printf(" id  num(n/h)   max(n/h)   cap(n/h)      send(n/h)       recv  full  size"
+         "  param  lat_avg  lat_max(us)\n");
+
+  for (uint32_t id = 1; id < num_msg_pools; ++id)
+    {
+      if (getStats(id, stats) != ERR_OK)
+        {
+          continue;
+        }
+
+      uint32_t lat_avg = 0;
+      if (stats.recv_count != 0)
+        {
+          lat_avg = stats.latency_total / stats.recv_count;
+        }
+
+      printf("%3u  %4u/%-4u  %4u/%-4u  %4u/%-4u  %7u/%-7u  %9u  %4u  %4u  %5u  %7u  %7u\n",
+             id,
+             stats.cur_num[MsgPriNormal], stats.cur_num[MsgPriHigh],
+             stats.high_water[MsgPriNormal], stats.high_water[MsgPriHigh],
+             stats.capacity[MsgPriNormal], stats.capacity[MsgPriHigh],
+             stats.send_count[MsgPriNormal], stats.send_count[MsgPriHigh],
+             stats.recv_count, stats.err_que_full, stats.err_data_size,
+             stats.param_max, lat_avg, stats.latency_max);
+    }
+}
+
 /*****************************************************************
  * 全てのメッセージキューブロックのダンプ表示
  * 本関数の実行により、メッセージパケットがキャッシュに載るため
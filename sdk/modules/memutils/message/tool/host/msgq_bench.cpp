@@ -0,0 +1,487 @@
+/****************************************************************************
+ * modules/memutils/message/tool/host/msgq_bench.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Message throughput / latency benchmark of MsgLib on the host.
+ *
+ * N producer threads send messages to one queue and one consumer
+ * thread (queue owner) receives them. Each message carries the send
+ * time, so the consumer can record send-to-recv latency.
+ * Single producer cases are also measured with the lock-free SPSC queue
+ * (MsgQueModeSpsc). With batch size > 1, messages are sent by
+ * MsgLib::sendBatch() and received by MsgQueBlock::recvBatch().
+ * Built with STATS=1, the statistics of each queue are shown at the end.
+ */
+
+#include <sys/mman.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <algorithm>
+#include <vector>
+
+#include "memutils/message/Message.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Message area. DRM address is 32bit, so map it under 4GB. */
+
+#define BENCH_TOP_DRM     0x20000000
+#define BENCH_AREA_SIZE   0x00100000
+
+#define BENCH_QUE_N_NUM   64
+#define BENCH_QUE_H_NUM   16
+#define BENCH_MSG_TYPE    0x1234
+#define BENCH_MAX_THREADS 8
+#define BENCH_MAX_BATCH   BENCH_QUE_H_NUM
+
+#define BENCH_QUE_AREA_DRM \
+  ROUND_UP(BENCH_TOP_DRM + NUM_MSGQ_POOLS * sizeof(MsgQueBlock), sizeof(int))
+
+#define BENCH_N_DRM(top, size) (top)
+#define BENCH_H_DRM(top, size) ((top) + (size) * BENCH_QUE_N_NUM)
+#define BENCH_NEXT_DRM(top, size) \
+  ((top) + (size) * (BENCH_QUE_N_NUM + BENCH_QUE_H_NUM))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+enum
+{
+  MSGQ_BENCH_NULL = 0,
+  MSGQ_BENCH_16,
+  MSGQ_BENCH_64,
+  MSGQ_BENCH_256,
+  MSGQ_BENCH_16_SPSC,
+  MSGQ_BENCH_64_SPSC,
+  MSGQ_BENCH_256_SPSC,
+  NUM_MSGQ_POOLS
+};
+
+enum BenchPri
+{
+  BenchPriNormal,
+  BenchPriHigh,
+  BenchPriMixed,
+};
+
+struct BenchConfig
+{
+  MsgQueId  id;
+  uint16_t  elem_size;
+  BenchPri  pri;
+  uint32_t  producers;
+  uint32_t  batch;
+  uint32_t  count;
+};
+
+struct BenchProducer
+{
+  const BenchConfig *cfg;
+  uint32_t           count;
+  uint32_t           full_retry;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#define DRM_16   BENCH_QUE_AREA_DRM
+#define DRM_64   BENCH_NEXT_DRM(DRM_16, 16)
+#define DRM_256  BENCH_NEXT_DRM(DRM_64, 64)
+#define DRM_16S  BENCH_NEXT_DRM(DRM_256, 256)
+#define DRM_64S  BENCH_NEXT_DRM(DRM_16S, 16)
+#define DRM_256S BENCH_NEXT_DRM(DRM_64S, 64)
+#define DRM_END  BENCH_NEXT_DRM(DRM_256S, 256)
+
+extern const MsgQueDef MsgqPoolDefs[NUM_MSGQ_POOLS] =
+{
+  /* n_drm, n_size, n_num, h_drm, h_size, h_num, owner, spinlock, mode */
+
+  { 0x00000000, 0, 0, 0x00000000, 0, 0, 0, 0 }, /* MSGQ_NULL */
+  { BENCH_N_DRM(DRM_16, 16), 16, BENCH_QUE_N_NUM,
+    BENCH_H_DRM(DRM_16, 16), 16, BENCH_QUE_H_NUM, 0, 0 },
+  { BENCH_N_DRM(DRM_64, 64), 64, BENCH_QUE_N_NUM,
+    BENCH_H_DRM(DRM_64, 64), 64, BENCH_QUE_H_NUM, 0, 0 },
+  { BENCH_N_DRM(DRM_256, 256), 256, BENCH_QUE_N_NUM,
+    BENCH_H_DRM(DRM_256, 256), 256, BENCH_QUE_H_NUM, 0, 0 },
+  { BENCH_N_DRM(DRM_16S, 16), 16, BENCH_QUE_N_NUM,
+    BENCH_H_DRM(DRM_16S, 16), 16, BENCH_QUE_H_NUM, 0, 0, MsgQueModeSpsc },
+  { BENCH_N_DRM(DRM_64S, 64), 64, BENCH_QUE_N_NUM,
+    BENCH_H_DRM(DRM_64S, 64), 64, BENCH_QUE_H_NUM, 0, 0, MsgQueModeSpsc },
+  { BENCH_N_DRM(DRM_256S, 256), 256, BENCH_QUE_N_NUM,
+    BENCH_H_DRM(DRM_256S, 256), 256, BENCH_QUE_H_NUM, 0, 0, MsgQueModeSpsc },
+};
+
+static const char *s_pri_name[] = { "normal", "high", "mixed" };
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint64_t now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static MsgPri select_pri(BenchPri pri, uint32_t seq)
+{
+  switch (pri)
+    {
+      case BenchPriHigh:
+        return MsgPriHigh;
+
+      case BenchPriMixed:
+        return (seq & 1) ? MsgPriHigh : MsgPriNormal;
+
+      default:
+        return MsgPriNormal;
+    }
+}
+
+static void *producer_main(void *arg)
+{
+  BenchProducer *prod = static_cast<BenchProducer *>(arg);
+  const BenchConfig *cfg = prod->cfg;
+  uint8_t param[BENCH_MAX_BATCH][256];
+  size_t param_size = cfg->elem_size - sizeof(MsgPacketHeader);
+
+  memset(param, 0x5a, sizeof(param));
+
+  for (uint32_t i = 0; i < prod->count; i += cfg->batch)
+    {
+      MsgPri pri = select_pri(cfg->pri, i / cfg->batch);
+      err_t  err;
+
+      do
+        {
+          uint64_t stamp = now_ns();
+
+          if (cfg->batch == 1)
+            {
+              memcpy(param[0], &stamp, sizeof(stamp));
+              err = MsgLib::send(cfg->id, pri, BENCH_MSG_TYPE, MSG_QUE_NULL,
+                                 param[0], param_size);
+            }
+          else
+            {
+              /* Parameters are packed by param_size in the array. */
+
+              uint8_t *p = param[0];
+              for (uint32_t j = 0; j < cfg->batch; j++, p += param_size)
+                {
+                  memcpy(p, &stamp, sizeof(stamp));
+                }
+
+              err = MsgLib::sendBatch(cfg->id, pri, BENCH_MSG_TYPE,
+                                      MSG_QUE_NULL, param[0], param_size,
+                                      cfg->batch);
+            }
+          if (err == ERR_QUE_FULL)
+            {
+              prod->full_retry++;
+              sched_yield();
+            }
+        }
+      while (err == ERR_QUE_FULL);
+
+      if (err != ERR_OK)
+        {
+          printf("send error %d\n", err);
+          exit(EXIT_FAILURE);
+        }
+    }
+
+  return NULL;
+}
+
+static void run_bench(const BenchConfig &cfg)
+{
+  BenchProducer prod[BENCH_MAX_THREADS];
+  pthread_t     tid[BENCH_MAX_THREADS];
+  std::vector<uint32_t> lat;
+  MsgQueBlock  *que;
+  uint32_t      total = 0;
+  uint32_t      retry = 0;
+
+  if (MsgLib::referMsgQueBlock(cfg.id, &que) != ERR_OK)
+    {
+      printf("bad queue id %d\n", cfg.id);
+      exit(EXIT_FAILURE);
+    }
+
+  for (uint32_t i = 0; i < cfg.producers; i++)
+    {
+      prod[i].cfg        = &cfg;
+      prod[i].count      = cfg.count / cfg.producers / cfg.batch * cfg.batch;
+      prod[i].full_retry = 0;
+      total += prod[i].count;
+    }
+
+  lat.reserve(total);
+
+  uint64_t start = now_ns();
+
+  for (uint32_t i = 0; i < cfg.producers; i++)
+    {
+      pthread_create(&tid[i], NULL, producer_main, &prod[i]);
+    }
+
+  /* This thread is the queue owner (consumer). */
+
+  for (uint32_t i = 0; i < total; )
+    {
+      MsgPacket *msg[BENCH_MAX_BATCH];
+      uint32_t   num = 1;
+      err_t      err;
+
+      if (cfg.batch == 1)
+        {
+          err = que->recv(TIME_FOREVER, &msg[0]);
+        }
+      else
+        {
+          err = que->recvBatch(TIME_FOREVER, msg, cfg.batch, &num);
+        }
+
+      if (err != ERR_OK)
+        {
+          printf("recv error\n");
+          exit(EXIT_FAILURE);
+        }
+
+      uint64_t now = now_ns();
+
+      for (uint32_t j = 0; j < num; j++)
+        {
+          uint64_t sent = msg[j]->peekParamOther<uint64_t>();
+          lat.push_back(static_cast<uint32_t>(now - sent));
+          msg[j]->popParamNoDestruct();
+        }
+
+      if (cfg.batch == 1)
+        {
+          que->pop();
+        }
+      else
+        {
+          que->popBatch(num);
+        }
+
+      i += num;
+    }
+
+  uint64_t elapsed = now_ns() - start;
+
+  for (uint32_t i = 0; i < cfg.producers; i++)
+    {
+      pthread_join(tid[i], NULL);
+      retry += prod[i].full_retry;
+    }
+
+  std::sort(lat.begin(), lat.end());
+
+  printf("%5u  %-6s  %-6s  %9u  %5u  %12.0f  %9.2f  %9.2f  %9u\n",
+         cfg.elem_size,
+         s_pri_name[cfg.pri],
+         que->isSpsc() ? "spsc" : "lock",
+         cfg.producers,
+         cfg.batch,
+         (double)total * 1000000000.0 / elapsed,
+         lat[total / 2] / 1000.0,
+         lat[(uint64_t)total * 99 / 100] / 1000.0,
+         retry);
+}
+
+static void usage(const char *prog)
+{
+  printf("Usage: %s [-n count] [-s 16|64|256] [-p producers] [-P n|h|m] "
+         "[-b batch]\n", prog);
+  printf("  Without -s/-p/-P/-b, all combinations are measured.\n");
+  exit(EXIT_FAILURE);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  static const uint16_t sizes[] = { 16, 64, 256 };
+  static const MsgQueId ids[]   = { MSGQ_BENCH_16, MSGQ_BENCH_64,
+                                    MSGQ_BENCH_256 };
+  static const MsgQueId spsc_ids[] = { MSGQ_BENCH_16_SPSC, MSGQ_BENCH_64_SPSC,
+                                       MSGQ_BENCH_256_SPSC };
+  static const uint32_t producers[] = { 1, 2, 4 };
+  static const uint32_t batches[]   = { 1, 8 };
+
+  uint32_t count     = 100000;
+  int      sel_size  = -1;
+  int      sel_prod  = -1;
+  int      sel_pri   = -1;
+  int      sel_batch = -1;
+  int      opt;
+
+  while ((opt = getopt(argc, argv, "n:s:p:P:b:")) != -1)
+    {
+      switch (opt)
+        {
+          case 'n':
+            count = strtoul(optarg, NULL, 0);
+            break;
+
+          case 's':
+            sel_size = atoi(optarg);
+            break;
+
+          case 'p':
+            sel_prod = atoi(optarg);
+            if (sel_prod < 1 || sel_prod > BENCH_MAX_THREADS)
+              {
+                usage(argv[0]);
+              }
+            break;
+
+          case 'b':
+            sel_batch = atoi(optarg);
+            if (sel_batch < 1 || sel_batch > BENCH_MAX_BATCH)
+              {
+                usage(argv[0]);
+              }
+            break;
+
+          case 'P':
+            sel_pri = (optarg[0] == 'h') ? BenchPriHigh :
+                      (optarg[0] == 'm') ? BenchPriMixed : BenchPriNormal;
+            break;
+
+          default:
+            usage(argv[0]);
+        }
+    }
+
+  void *area = mmap(reinterpret_cast<void *>(BENCH_TOP_DRM), BENCH_AREA_SIZE,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                    -1, 0);
+  if (area != reinterpret_cast<void *>(BENCH_TOP_DRM))
+    {
+      printf("Cannot map message area at 0x%08x\n", BENCH_TOP_DRM);
+      return EXIT_FAILURE;
+    }
+
+  if (DRM_END > BENCH_TOP_DRM + BENCH_AREA_SIZE)
+    {
+      printf("Lack of message area\n");
+      return EXIT_FAILURE;
+    }
+
+  if (MsgLib::initFirst(NUM_MSGQ_POOLS, BENCH_TOP_DRM) != ERR_OK ||
+      MsgLib::initPerCpu() != ERR_OK)
+    {
+      printf("MsgLib initialize error\n");
+      return EXIT_FAILURE;
+    }
+
+  printf(" size  pri     queue   producers  batch      msgs/sec   p50(us)   p99(us)  que_full\n");
+
+  for (size_t s = 0; s < COUNT_OF(sizes); s++)
+    {
+      if (sel_size != -1 && sel_size != sizes[s])
+        {
+          continue;
+        }
+
+      for (int pri = BenchPriNormal; pri <= BenchPriMixed; pri++)
+        {
+          if (sel_pri != -1 && sel_pri != pri)
+            {
+              continue;
+            }
+
+          for (size_t p = 0; p < COUNT_OF(producers); p++)
+            {
+              for (size_t b = 0; b < COUNT_OF(batches); b++)
+                {
+                  BenchConfig cfg;
+
+                  cfg.id        = ids[s];
+                  cfg.elem_size = sizes[s];
+                  cfg.pri       = static_cast<BenchPri>(pri);
+                  cfg.producers = (sel_prod != -1) ? sel_prod : producers[p];
+                  cfg.batch     = (sel_batch != -1) ? sel_batch : batches[b];
+                  cfg.count     = count;
+
+                  run_bench(cfg);
+
+                  /* Same case with the lock-free queue. */
+
+                  if (cfg.producers == 1)
+                    {
+                      cfg.id = spsc_ids[s];
+                      run_bench(cfg);
+                    }
+
+                  if (sel_batch != -1)
+                    {
+                      break;
+                    }
+                }
+
+              if (sel_prod != -1)
+                {
+                  break;
+                }
+            }
+        }
+    }
+
+#ifdef CONFIG_MEMUTILS_MESSAGE_STATS
+  MsgLib::dumpStats();
+#endif
+
+  MsgLib::finalize();
+  munmap(area, BENCH_AREA_SIZE);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,395 @@
+/****************************************************************************
+ * modules/memutils/message/tool/host/msgq_memhandle_test.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/* Host test of the MemHandle messages of MsgLib
+ * (CONFIG_MEMUTILS_MESSAGE_MEMHANDLE).
+ *
+ * Segments are sent by MsgLib::sendMemHandle()/sendMemHandleIsr(), and
+ * the reference count and the number of available segments are checked
+ * when the receiver takes the reference by popMemHandle(), when it is
+ * released by pop() and popBatch(), and when popBatch() fails because
+ * a packet in the batch still has a parameter.
+ */
+
+#include <sys/mman.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "memutils/message/Message.h"
+#include "memutils/memory_manager/MemHandle.h"
+
+using namespace MemMgrLite;
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Message area. DRM address is 32bit, so map it under 4GB. */
+
+#define TEST_TOP_DRM      0x20000000
+#define TEST_AREA_SIZE    0x00010000
+
+#define TEST_QUE_SIZE     16
+#define TEST_QUE_NUM      4
+#define TEST_QUE_AREA_DRM \
+  ROUND_UP(TEST_TOP_DRM + NUM_MSGQ_POOLS * sizeof(MsgQueBlock), sizeof(int))
+
+/* Segment memory is not accessed, so pool address is a dummy. */
+
+#define TEST_POOL_ADDR    0x10000000
+#define TEST_SEG_SIZE     1024
+#define TEST_SEG_NUM      4
+#define TEST_WORK_SIZE    0x400
+
+#define TEST_MSG_TYPE     0x1234
+
+#define CHECK(cond) \
+  do \
+    { \
+      if (!(cond)) \
+        { \
+          printf("  NG: %s (line %d)\n", #cond, __LINE__); \
+          return 1; \
+        } \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+enum
+{
+  MSGQ_TEST_NULL = 0,
+  MSGQ_TEST,
+  NUM_MSGQ_POOLS
+};
+
+enum
+{
+  NULL_POOL = 0,
+  TEST_POOL,
+  NUM_MEM_POOLS
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+extern const MsgQueDef MsgqPoolDefs[NUM_MSGQ_POOLS] =
+{
+  /* n_drm, n_size, n_num, h_drm, h_size, h_num, owner, spinlock, mode */
+
+  { 0x00000000, 0, 0, 0x00000000, 0, 0, 0, 0 }, /* MSGQ_NULL */
+  { TEST_QUE_AREA_DRM, TEST_QUE_SIZE, TEST_QUE_NUM,
+    INVALID_DRM, 0, 0, 0, 0 },                   /* MSGQ_TEST */
+};
+
+static const PoolSectionAttr s_layout[] =
+{
+  { { TEST_POOL, 0 }, BasicType, TEST_SEG_NUM, TEST_POOL_ADDR,
+    TEST_SEG_SIZE * TEST_SEG_NUM },
+  { { 0, 0 }, 0, 0, 0, 0 }
+};
+
+static const PoolId s_pool = { TEST_POOL, 0 };
+
+static uint32_t s_manager_area[64];
+static uint32_t s_work_area[TEST_WORK_SIZE / sizeof(uint32_t)];
+
+static MemPool *s_pools_block[NUM_MEM_POOLS];
+static MemPool **s_pools[1] = { s_pools_block };
+static uint8_t  s_pool_num[1] = { NUM_MEM_POOLS };
+static uint8_t  s_layout_no[1] = { BadLayoutNo };
+
+static MsgQueBlock *s_que;
+
+namespace MemMgrLite
+{
+  MemPool *static_pools[NUM_MEM_POOLS];
+}
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static NumSeg avail_segs(void)
+{
+  return Manager::getPoolNumAvailSegs(s_pool);
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_receive(void)
+{
+  MemHandle  mh(s_pool, TEST_SEG_SIZE);
+  MemHandle  rcv;
+  MsgPacket *msg;
+
+  printf("sendMemHandle + popMemHandle\n");
+
+  CHECK(mh.isAvail());
+  CHECK(avail_segs() == TEST_SEG_NUM - 1);
+
+  PoolAddr addr = mh.getAddr();
+
+  /* The reference moves from the sender to the message. */
+
+  CHECK(MsgLib::sendMemHandle(MSGQ_TEST, MsgPriNormal, TEST_MSG_TYPE,
+                              MSG_QUE_NULL, mh) == ERR_OK);
+  CHECK(mh.isNull());
+  CHECK(avail_segs() == TEST_SEG_NUM - 1);
+
+  /* And from the message to the receiver. */
+
+  CHECK(s_que->recv(TIME_FOREVER, &msg) == ERR_OK);
+  CHECK(msg->getType() == TEST_MSG_TYPE);
+  CHECK(msg->isMemHandleParam());
+
+  msg->popMemHandle(rcv);
+
+  CHECK(rcv.isAvail());
+  CHECK(rcv.getAddr() == addr);
+  CHECK(rcv.getRefCnt() == 1);
+  CHECK(s_que->pop() == ERR_OK);
+  CHECK(rcv.getRefCnt() == 1);
+  CHECK(avail_segs() == TEST_SEG_NUM - 1);
+
+  rcv.freeSeg();
+  CHECK(avail_segs() == TEST_SEG_NUM);
+
+  /* A handle with other references keeps the count as it is. */
+
+  printf("sendMemHandleIsr with 2 references\n");
+
+  mh.allocSeg(s_pool, TEST_SEG_SIZE);
+
+  MemHandle copy = mh;
+
+  CHECK(copy.getRefCnt() == 2);
+  CHECK(MsgLib::sendMemHandleIsr(MSGQ_TEST, MsgPriNormal, TEST_MSG_TYPE,
+                                 MSG_QUE_NULL, mh) == ERR_OK);
+  CHECK(mh.isNull());
+  CHECK(copy.getRefCnt() == 2);
+  CHECK(s_que->recv(TIME_FOREVER, &msg) == ERR_OK);
+
+  msg->popMemHandle(rcv);
+
+  CHECK(s_que->pop() == ERR_OK);
+  CHECK(rcv.isSame(copy));
+  CHECK(copy.getRefCnt() == 2);
+
+  rcv.freeSeg();
+  CHECK(copy.getRefCnt() == 1);
+
+  copy.freeSeg();
+  CHECK(avail_segs() == TEST_SEG_NUM);
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_pop(void)
+{
+  MemHandle  mh(s_pool, TEST_SEG_SIZE);
+  MsgPacket *msg;
+
+  printf("sendMemHandle + pop\n");
+
+  CHECK(MsgLib::sendMemHandle(MSGQ_TEST, MsgPriNormal, TEST_MSG_TYPE,
+                              MSG_QUE_NULL, mh) == ERR_OK);
+  CHECK(s_que->recv(TIME_FOREVER, &msg) == ERR_OK);
+  CHECK(avail_segs() == TEST_SEG_NUM - 1);
+
+  /* The reference which is not received is released. */
+
+  CHECK(s_que->pop() == ERR_OK);
+  CHECK(avail_segs() == TEST_SEG_NUM);
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_send_error(void)
+{
+  MemHandle  mh[TEST_QUE_NUM];
+  MemHandle  extra(s_pool, TEST_SEG_SIZE);
+  MsgPacket *msg[TEST_QUE_NUM];
+  uint32_t   num;
+
+  printf("sendMemHandle to full queue\n");
+
+  /* Fill the queue with plain messages. */
+
+  for (int i = 0; i < TEST_QUE_NUM; i++)
+    {
+      CHECK(MsgLib::send(MSGQ_TEST, MsgPriNormal, TEST_MSG_TYPE,
+                         MSG_QUE_NULL) == ERR_OK);
+    }
+
+  /* The caller keeps the handle when the send fails. */
+
+  CHECK(MsgLib::sendMemHandle(MSGQ_TEST, MsgPriNormal, TEST_MSG_TYPE,
+                              MSG_QUE_NULL, extra) == ERR_QUE_FULL);
+  CHECK(extra.isAvail());
+  CHECK(extra.getRefCnt() == 1);
+
+  CHECK(s_que->recvBatch(TIME_FOREVER, msg, TEST_QUE_NUM, &num) == ERR_OK);
+  CHECK(num == TEST_QUE_NUM);
+  CHECK(s_que->popBatch(num) == ERR_OK);
+
+  extra.freeSeg();
+  CHECK(avail_segs() == TEST_SEG_NUM);
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_pop_batch(void)
+{
+  MemHandle  mh;
+  MsgPacket *msg[TEST_QUE_NUM];
+  uint32_t   num;
+  uint32_t   value = 0x12345678;
+
+  printf("sendMemHandle + popBatch\n");
+
+  for (int i = 0; i < TEST_SEG_NUM - 1; i++)
+    {
+      CHECK(mh.allocSeg(s_pool, TEST_SEG_SIZE) == ERR_OK);
+      CHECK(MsgLib::sendMemHandle(MSGQ_TEST, MsgPriNormal, TEST_MSG_TYPE,
+                                  MSG_QUE_NULL, mh) == ERR_OK);
+    }
+
+  CHECK(avail_segs() == 1);
+  CHECK(s_que->recvBatch(TIME_FOREVER, msg, TEST_QUE_NUM, &num) == ERR_OK);
+  CHECK(num == TEST_SEG_NUM - 1);
+  CHECK(s_que->popBatch(num) == ERR_OK);
+  CHECK(avail_segs() == TEST_SEG_NUM);
+
+  /* If a packet of the batch still has a parameter, popBatch() fails
+   * and no reference of the batch is released.
+   */
+
+  printf("popBatch with a parameter not received\n");
+
+  CHECK(mh.allocSeg(s_pool, TEST_SEG_SIZE) == ERR_OK);
+  CHECK(MsgLib::sendMemHandle(MSGQ_TEST, MsgPriNormal, TEST_MSG_TYPE,
+                              MSG_QUE_NULL, mh) == ERR_OK);
+  CHECK(MsgLib::send<uint32_t>(MSGQ_TEST, MsgPriNormal, TEST_MSG_TYPE,
+                               MSG_QUE_NULL, value) == ERR_OK);
+  CHECK(mh.allocSeg(s_pool, TEST_SEG_SIZE) == ERR_OK);
+  CHECK(MsgLib::sendMemHandle(MSGQ_TEST, MsgPriNormal, TEST_MSG_TYPE,
+                              MSG_QUE_NULL, mh) == ERR_OK);
+
+  CHECK(s_que->recvBatch(TIME_FOREVER, msg, TEST_QUE_NUM, &num) == ERR_OK);
+  CHECK(num == 3);
+  CHECK(avail_segs() == TEST_SEG_NUM - 2);
+  CHECK(s_que->popBatch(num) == ERR_MEM_BUSY);
+  CHECK(avail_segs() == TEST_SEG_NUM - 2);
+  CHECK(msg[0]->isMemHandleParam());
+  CHECK(msg[2]->isMemHandleParam());
+
+  /* The handles can still be received after the failure. */
+
+  msg[0]->popMemHandle(mh);
+  CHECK(mh.getRefCnt() == 1);
+  CHECK(msg[1]->moveParam<uint32_t>() == value);
+  CHECK(s_que->popBatch(num) == ERR_OK);
+  CHECK(avail_segs() == TEST_SEG_NUM - 1);
+
+  mh.freeSeg();
+  CHECK(avail_segs() == TEST_SEG_NUM);
+
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  void *area = mmap(reinterpret_cast<void *>(TEST_TOP_DRM), TEST_AREA_SIZE,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                    -1, 0);
+  if (area != reinterpret_cast<void *>(TEST_TOP_DRM))
+    {
+      printf("Cannot map message area at 0x%08x\n", TEST_TOP_DRM);
+      return EXIT_FAILURE;
+    }
+
+  if (TEST_QUE_AREA_DRM + TEST_QUE_SIZE * TEST_QUE_NUM >
+      TEST_TOP_DRM + TEST_AREA_SIZE)
+    {
+      printf("Lack of message area\n");
+      return EXIT_FAILURE;
+    }
+
+  if (MsgLib::initFirst(NUM_MSGQ_POOLS, TEST_TOP_DRM) != ERR_OK ||
+      MsgLib::initPerCpu() != ERR_OK ||
+      MsgLib::referMsgQueBlock(MSGQ_TEST, &s_que) != ERR_OK)
+    {
+      printf("MsgLib initialize error\n");
+      return EXIT_FAILURE;
+    }
+
+  if (Manager::initFirst(s_manager_area, sizeof(s_manager_area)) != ERR_OK ||
+      Manager::initPerCpu(s_manager_area, s_pools, s_pool_num,
+                          s_layout_no) != ERR_OK ||
+      Manager::createStaticPools(0, 0, s_work_area, sizeof(s_work_area),
+                                 s_layout) != ERR_OK)
+    {
+      printf("MemMgrLite initialize error\n");
+      return EXIT_FAILURE;
+    }
+
+  if (test_receive() != 0 || test_pop() != 0 || test_send_error() != 0 ||
+      test_pop_batch() != 0)
+    {
+      printf("Test NG\n");
+      return EXIT_FAILURE;
+    }
+
+  printf("All tests OK\n");
+
+  Manager::destroyStaticPools(0);
+  Manager::finalize();
+  MsgLib::finalize();
+
+  return 0;
+}
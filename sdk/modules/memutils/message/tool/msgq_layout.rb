@@ -37,10 +37,11 @@
 # constants
 
 ALINGMENT_SIZE = 4			# ACgTCY
-QUE_BLOCK_SIZE =  68			# bZ[WL[ubNTCY sizeof(MsgQueBlock)
+QUE_BLOCK_SIZE =  72			# bZ[WL[ubNTCY sizeof(MsgQueBlock)
 MIN_PACKET_SIZE = 8			# ŏbZ[WpPbgTCY
 MAX_PACKET_SIZE = 512			# ő僁bZ[WpPbgTCY
 MAX_PACKET_NUM = 16384			# ő僁bZ[WpPbg
+QUE_MODES = ["normal", "spsc"]		# Queue mode names (MsgQueMode)
 INVALID_DRM = 0xffffffff		# sDRMAhX
 
 # false:Not Support multi core , ture: Support multi core
@@ -183,6 +184,7 @@ def getMsgQueParam(line, dup_chk)
 	n_size	= line[1];
 	raise("Bad n_size at #{id}") if n_size < MIN_PACKET_SIZE or n_size > MAX_PACKET_SIZE or n_size % 4 != 0
 	n_size += 4 if MsgParamTypeMatchCheck == true and n_size > MIN_PACKET_SIZE
+	n_size += 4 if MsgTimestampEnable == true
 
 	n_num	= line[2];
 	raise("Bad n_num at #{id}") if n_num == 0 or n_num > MAX_PACKET_NUM
@@ -190,6 +192,7 @@ def getMsgQueParam(line, dup_chk)
 	h_size	= line[3];
 	raise("Bad h_size at #{id}") if h_size != 0 and (h_size < MIN_PACKET_SIZE or h_size > MAX_PACKET_SIZE or h_size % 4 != 0)
 	h_size += 4 if MsgParamTypeMatchCheck == true and h_size > MIN_PACKET_SIZE
+	h_size += 4 if MsgTimestampEnable == true and h_size > 0
 
 	h_num	= line[4];
 	raise("Bad h_num at #{id}") if h_num > MAX_PACKET_NUM or (h_size > 0 and h_num == 0) or (h_size == 0 and h_num > 0)
@@ -213,10 +216,15 @@ def getMsgQueParam(line, dup_chk)
 		end
 	end
 
+	# Optional last column: "normal"(default) or "spsc"(lock-free, nonshared only)
+	mode = line[(USE_MULTI_CORE == true) ? 7 : 5] || "normal"
+	raise("Bad mode at #{id}") if QUE_MODES.include?(mode) == false
+	raise("spsc mode is not available for shared queue at #{id}") if mode == "spsc" and USE_MULTI_CORE == true and spinlock != "SPL_NULL"
+
 	if (USE_MULTI_CORE == true)
-		return id, spinlock, n_size, n_num, h_size, h_num, owner
+		return id, spinlock, n_size, n_num, h_size, h_num, owner, mode
 	else
-		return id, n_size, n_num, h_size, h_num
+		return id, n_size, n_num, h_size, h_num, mode
 	end
 end
 
@@ -238,9 +246,16 @@ def parseMsgQuePool()
 		break if line == nil
 
 		if (USE_MULTI_CORE == true)
-			id, spinlock, n_size, n_num, h_size, h_num, owner = getMsgQueParam(line, dup_chk)
+			id, spinlock, n_size, n_num, h_size, h_num, owner, mode = getMsgQueParam(line, dup_chk)
+		else
+			id, n_size, n_num, h_size, h_num, mode = getMsgQueParam(line, dup_chk)
+		end
+
+		# Normal mode entry keeps the zero-initialized mode field
+		if (mode == "spsc")
+			mode_str = (USE_MULTI_CORE == true) ? ", MsgQueModeSpsc" : ", 0, 0, MsgQueModeSpsc"
 		else
-			id, n_size, n_num, h_size, h_num = getMsgQueParam(line, dup_chk)
+			mode_str = ""
 		end
 
 		if ((USE_MULTI_CORE == true && TargetCore == owner) || TargetCore == nil)
@@ -267,9 +282,9 @@ def parseMsgQuePool()
 
 			# create pool entry
 			if (USE_MULTI_CORE == true)
-				pools.push("  { 0x#{n_drm.to_s(16)}, #{n_size}, #{n_num}, 0x#{h_drm.to_s(16)}, #{h_size}, #{h_num}, #{owner}, #{spinlock} }, /* #{id} */\n")
+				pools.push("  { 0x#{n_drm.to_s(16)}, #{n_size}, #{n_num}, 0x#{h_drm.to_s(16)}, #{h_size}, #{h_num}, #{owner}, #{spinlock}#{mode_str} }, /* #{id} */\n")
 			else
-				pools.push("  { 0x#{n_drm.to_s(16)}, #{n_size}, #{n_num}, 0x#{h_drm.to_s(16)}, #{h_size}, #{h_num} }, /* #{id} */\n")
+				pools.push("  { 0x#{n_drm.to_s(16)}, #{n_size}, #{n_num}, 0x#{h_drm.to_s(16)}, #{h_size}, #{h_num}#{mode_str} }, /* #{id} */\n")
 			end
 
 			que_area_drm += QUE_BLOCK_SIZE
@@ -394,6 +409,8 @@ begin
 
 	(MsgFillValueAfterPop <= 0xff) or raise("Bad MsgFillValueAfterPop.")
 	[true, false].include?(MsgParamTypeMatchCheck) or raise("Bad MsgParamTypeMatchCheck.")
+	MsgTimestampEnable = defined?(MsgTimestamp) ? MsgTimestamp : false
+	[true, false].include?(MsgTimestampEnable) or raise("Bad MsgTimestamp.")
 
 	macros, pools, end_addr = parseMsgQuePool()
 	make_msgq_id_header(macros, end_addr)
@@ -124,6 +124,34 @@ static inline size_t getVacantSizeContinuous(size_t sz, size_t wp, size_t rp) {
     return szVacant;
 }
 
+/*!
+ * @brief Notify the high watermark if the occupied size reaches it.
+ */
+static inline void notifyHigh(
+        volatile CMN_SimpleFifoHandle* pHandle,
+        size_t szBefore,
+        size_t szAfter) {
+    CMN_SimpleFifoNotifyFunc notifyFunc = pHandle->m_notifyFunc;
+    const size_t szHigh = pHandle->m_szHighWatermark;
+    if (notifyFunc != NULL && szBefore < szHigh && szHigh <= szAfter) {
+        (*notifyFunc)(pHandle->m_pNotifyExtInfo, CMN_SIMPLE_FIFO_HIGH_WATERMARK, szAfter);
+    }
+}
+
+/*!
+ * @brief Notify the low watermark if the occupied size falls to it.
+ */
+static inline void notifyLow(
+        volatile CMN_SimpleFifoHandle* pHandle,
+        size_t szBefore,
+        size_t szAfter) {
+    CMN_SimpleFifoNotifyFunc notifyFunc = pHandle->m_notifyFunc;
+    const size_t szLow = pHandle->m_szLowWatermark;
+    if (notifyFunc != NULL && szLow < szBefore && szAfter <= szLow) {
+        (*notifyFunc)(pHandle->m_pNotifyExtInfo, CMN_SIMPLE_FIFO_LOW_WATERMARK, szAfter);
+    }
+}
+
 /*!
  * @brief Internal peek implementation.
  */
@@ -214,6 +242,10 @@ int CMN_SimpleFifoInitialize(
     pHandle->m_size = szFifoBuffer;
     pHandle->m_pExtInfo = pExtInfo;
     pHandle->m_wp = pHandle->m_rp = 0;
+    pHandle->m_notifyFunc = NULL;
+    pHandle->m_pNotifyExtInfo = NULL;
+    pHandle->m_szHighWatermark = CMN_SIMPLE_FIFO_NO_WATERMARK;
+    pHandle->m_szLowWatermark = CMN_SIMPLE_FIFO_NO_WATERMARK;
     __DSB();
     return 0;
 }
@@ -273,6 +305,7 @@ size_t CMN_SimpleFifoOfferWithSpecificCopier(
     __DMB();
     pHandle->m_wp = newWp;
     __DSB();
+    notifyHigh(pHandle, getOccupiedSize(bufsz, wp, rp), getOccupiedSize(bufsz, newWp, rp));
     return sz;
 }
 
@@ -323,6 +356,7 @@ size_t CMN_SimpleFifoOfferContinuousWithSpecificCopier(
 		__DMB();
 		pHandle->m_wp = newWp;
 		__DSB();
+		notifyHigh(pHandle, getOccupiedSize(bufsz, wp, rp), getOccupiedSize(bufsz, newWp, rp));
 		return sz;
     }
 
@@ -334,6 +368,7 @@ size_t CMN_SimpleFifoOfferContinuousWithSpecificCopier(
         __DMB();
         pHandle->m_wp = sz;
         __DSB();
+        notifyHigh(pHandle, getOccupiedSize(bufsz, wp, rp), getOccupiedSize(bufsz, sz, rp));
         return sz;
     }
 
@@ -345,6 +380,56 @@ size_t CMN_SimpleFifoOfferContinuousWithSpecificCopier(
     return 0; // no fallback and fail
 }
 
+size_t CMN_SimpleFifoReserve(
+        CMN_SimpleFifoHandle* pHandle0,
+        CMN_SimpleFifoPeekHandle* pRegion,
+        size_t sz) {
+    assert(pHandle0 != NULL);
+    assert(pRegion != NULL);
+
+    volatile CMN_SimpleFifoHandle* pHandle = pHandle0;
+    const size_t rp = pHandle->m_rp;
+    const size_t wp = pHandle->m_wp;
+    const size_t bufsz = pHandle->m_size;
+    const size_t szVacant = getVacantSize(bufsz, wp, rp);
+    if (szVacant < sz) {
+        sz = szVacant;
+    }
+
+    // the first region is just after wp, and the rest wraps to the top
+    size_t szRegion1 = getVacantSizeContinuous(bufsz, wp, rp);
+    if (sz < szRegion1) {
+        szRegion1 = sz;
+    }
+    pRegion->m_szChunk[0] = szRegion1;
+    pRegion->m_pChunk[0] = szRegion1 == 0 ? NULL : &pHandle->m_pBuf[wp];
+    pRegion->m_szChunk[1] = sz - szRegion1;
+    pRegion->m_pChunk[1] = sz == szRegion1 ? NULL : &pHandle->m_pBuf[0];
+    return sz;
+}
+
+size_t CMN_SimpleFifoCommit(
+        CMN_SimpleFifoHandle* pHandle0,
+        size_t sz) {
+    assert(pHandle0 != NULL);
+
+    volatile CMN_SimpleFifoHandle* pHandle = pHandle0;
+    const size_t rp = pHandle->m_rp;
+    const size_t wp = pHandle->m_wp;
+    const size_t bufsz = pHandle->m_size;
+    assert(sz <= getVacantSize(bufsz, wp, rp));
+
+    size_t newWp = wp + sz;
+    if (bufsz <= newWp) {
+        newWp -= bufsz;
+    }
+    __DMB();
+    pHandle->m_wp = newWp;
+    __DSB();
+    notifyHigh(pHandle, getOccupiedSize(bufsz, wp, rp), getOccupiedSize(bufsz, newWp, rp));
+    return sz;
+}
+
 size_t CMN_SimpleFifoPoll(
         CMN_SimpleFifoHandle* pHandle,
         void* pElement,
@@ -384,10 +469,52 @@ size_t CMN_SimpleFifoPollWithSpecificCopier(
         __DMB();
         pHandle->m_rp = peekHandle.m_newRp;
         __DSB();
+        const size_t wp = pHandle->m_wp;
+        const size_t bufsz = pHandle->m_size;
+        notifyLow(pHandle,
+                getOccupiedSize(bufsz, wp, peekHandle.m_idxChunk[0]),
+                getOccupiedSize(bufsz, wp, peekHandle.m_newRp));
     }
     return ret;
 }                
 
+size_t CMN_SimpleFifoAcquire(
+        const CMN_SimpleFifoHandle* pHandle0,
+        CMN_SimpleFifoPeekHandle* pRegion,
+        size_t sz) {
+    assert(pHandle0 != NULL);
+    assert(pRegion != NULL);
+
+    volatile const CMN_SimpleFifoHandle* pHandle = pHandle0;
+    const size_t szOccupied = getOccupiedSize(pHandle->m_size, pHandle->m_wp, pHandle->m_rp);
+    if (szOccupied < sz) {
+        sz = szOccupied;
+    }
+    return CMN_SimpleFifoPeekWithOffset(pHandle0, pRegion, sz, 0);
+}
+
+size_t CMN_SimpleFifoRelease(
+        CMN_SimpleFifoHandle* pHandle0,
+        size_t sz) {
+    assert(pHandle0 != NULL);
+
+    volatile CMN_SimpleFifoHandle* pHandle = pHandle0;
+    const size_t rp = pHandle->m_rp;
+    const size_t wp = pHandle->m_wp;
+    const size_t bufsz = pHandle->m_size;
+    assert(sz <= getOccupiedSize(bufsz, wp, rp));
+
+    size_t newRp = rp + sz;
+    if (bufsz <= newRp) {
+        newRp -= bufsz;
+    }
+    __DMB();
+    pHandle->m_rp = newRp;
+    __DSB();
+    notifyLow(pHandle, getOccupiedSize(bufsz, wp, rp), getOccupiedSize(bufsz, wp, newRp));
+    return sz;
+}
+
 size_t CMN_SimpleFifoPeekWithOffset(
         const CMN_SimpleFifoHandle* pHandle0,
         CMN_SimpleFifoPeekHandle* pPeekHandle,
@@ -452,6 +579,32 @@ void CMN_SimpleFifoClear(
     __DSB();
 }
 
+int CMN_SimpleFifoSetWatermark(
+        CMN_SimpleFifoHandle* pHandle0,
+        size_t szHigh,
+        size_t szLow,
+        CMN_SimpleFifoNotifyFunc notifyFunc,
+        void* pNotifyExtInfo) {
+    assert(pHandle0 != NULL);
+
+    volatile CMN_SimpleFifoHandle* pHandle = pHandle0;
+    if ((szHigh != CMN_SIMPLE_FIFO_NO_WATERMARK
+         && (szHigh == 0 || pHandle->m_size - 1 < szHigh))
+        || (szLow != CMN_SIMPLE_FIFO_NO_WATERMARK
+         && pHandle->m_size - 1 <= szLow)) {
+        return -1;
+    }
+    pHandle->m_notifyFunc = NULL;
+    __DMB();
+    pHandle->m_szHighWatermark = szHigh;
+    pHandle->m_szLowWatermark = szLow;
+    pHandle->m_pNotifyExtInfo = pNotifyExtInfo;
+    __DMB();
+    pHandle->m_notifyFunc = notifyFunc;
+    __DSB();
+    return 0;
+}
+
 size_t CMN_SimpleFifoGetVacantSize(
         const CMN_SimpleFifoHandle* pHandle0) {
     assert(pHandle0 != NULL);
@@ -123,6 +123,8 @@ int BarometerClass::write(sensor_command_data_mh_t* command)
       case pressureID:
         {
           this->pressureDate = command->mh;
+          this->m_pressure_num = command->size;
+          this->m_pressure_fs = command->fs;
           this->isReceivedPressureData = true;
         }
         break;
@@ -130,6 +132,7 @@ int BarometerClass::write(sensor_command_data_mh_t* command)
       case tempID:
         {
           this->temperatureData = command->mh;
+          this->m_temperature_num = command->size;
           this->isReceivedTemperatureData = true;
         }
         break;
@@ -140,15 +143,39 @@ int BarometerClass::write(sensor_command_data_mh_t* command)
 
   if (this->isReceivedPressureData && this->isReceivedTemperatureData)
     {
-      this->compemsate();
+      /* Compensate the whole block in place, pressure data is
+       * overwritten with the compensated one.
+       * Publishers which leave size or fs at 0 send the default
+       * watermark at the default frequency.
+       */
+
+      uint32_t press_num = (m_pressure_num != 0) ?
+                             m_pressure_num : BAROMETER_PRESSURE_WATERMARK_NUM;
+      uint32_t temp_num = (m_temperature_num != 0) ?
+                            m_temperature_num :
+                            BAROMETER_TEMPERATURE_WATERMARK_NUM;
+      uint32_t num = (press_num < temp_num) ? press_num : temp_num;
+      uint32_t fs = (m_pressure_fs != 0) ?
+                      m_pressure_fs : BAROMETER_PRESSURE_SAMPLING_FREQUENCY;
+      BarometerTrend trend;
+
+      m_compensation.compensate((int32_t*)this->temperatureData.getVa(),
+                                (uint32_t*)this->pressureDate.getVa(),
+                                num,
+                                fs,
+                                &trend);
+
+      pthread_mutex_lock(&m_trend_lock);
+      m_trend = trend;
+      pthread_mutex_unlock(&m_trend_lock);
 
       sensor_command_data_mh_t packet;
       packet.header.size = 0;
       packet.header.code = SendData;
       packet.self        = barometerID;
       packet.time        = command->time;
-      packet.fs          = BAROMETER_PRESSURE_SAMPLING_FREQUENCY;
-      packet.size        = BAROMETER_PRESSURE_WATERMARK_NUM;
+      packet.fs          = fs;
+      packet.size        = num;
       packet.mh          = this->pressureDate;
 
       SS_SendSensorDataMH(&packet);
@@ -162,118 +189,37 @@ int BarometerClass::write(sensor_command_data_mh_t* command)
   return 0;
 }
 
-/*--------------------------------------------------------------------*/
-void BarometerClass::compemsate(void)
-{
-  int32_t* p_temp = (int32_t*)this->temperatureData.getVa();
-  uint32_t* p_pres = (uint32_t*)this->pressureDate.getVa();
-  
-  for (int i = 0; i < BAROMETER_PRESSURE_WATERMARK_NUM; i++, p_temp++, p_pres++)
-    {
-      int t = this->compensateTemperature(*p_temp);
-      *p_pres = this->compensatePressure(*p_pres, t);
-    }
- }
-
 /*--------------------------------------------------------------------*/
 void BarometerClass::setAdjustParam(struct bmp280_press_adj_s* param)
 {
-  this->press_adj = *param;
+  m_compensation.setAdjustParam(param);
 }
   
 /*--------------------------------------------------------------------*/
 void BarometerClass::setAdjustParam(struct bmp280_temp_adj_s* param)
 {
-  this->temp_adj = *param;
+  m_compensation.setAdjustParam(param);
 }
-  
-/****************************************************************************
- * Name: compensateTemperature
- *
- * Description:
- *   calculate compensated tempreture
- *
- * Input Parameters:
- *   adc_T - uncompensated value of tempreture.
- *
- * Returned Value:
- *   result of compensated tempreture.
- *   to get in 0.01 degree Centigrade, calulate as below.
- *   (T * 5 + 128) >> 8 [0.01 C]
- *
- ****************************************************************************/
 
-int32_t BarometerClass::compensateTemperature(int32_t adc_T)
+/*--------------------------------------------------------------------*/
+void BarometerClass::setCompensationMode(BarometerCompensationMode mode)
 {
-  int32_t var1;
-  int32_t var2;
-  int32_t T;
-
-  var1 = ((((adc_T >> 3) - ((int32_t)temp_adj.dig_T1 << 1))) *
-          ((int32_t)temp_adj.dig_T2)) >> 11;
-  var2 = (((((adc_T >> 4) - ((int32_t)temp_adj.dig_T1)) *
-          ((adc_T >> 4) - ((int32_t)temp_adj.dig_T1))) >> 12) *
-            ((int32_t)temp_adj.dig_T3)) >> 14;
-
-  T = var1 + var2;
-
-  return T;
+  m_compensation.setMode(mode);
 }
 
-/****************************************************************************
- * Name: compensatePressure
- *
- * Description:
- *   calculate compensated pressure
- *
- * Input Parameters:
- *   adc_P - uncompensated value of pressure.
- *   comp_T - compensated value of temperature.
- *
- * Returned Value:
- *   result of compensated pressure.
- *
- ****************************************************************************/
-
-uint32_t BarometerClass::compensatePressure(int32_t adc_P, int32_t comp_T)
+/*--------------------------------------------------------------------*/
+void BarometerClass::setSeaLevelPressure(uint32_t pressure)
 {
-  int32_t var1;
-  int32_t var2;
-  uint32_t p;
-
-  var1 = (((int32_t)comp_T) >> 1) - (int32_t)64000;
-  var2 = (((var1 >> 2) * (var1 >> 2)) >> 11 ) * ((int32_t)press_adj.dig_P6);
-  var2 = var2 + ((var1 * ((int32_t)press_adj.dig_P5)) << 1);
-  var2 = (var2 >> 2) + (((int32_t)press_adj.dig_P4) << 16);
-  var1 = (((press_adj.dig_P3 * (((var1 >> 2) * (var1 >> 2)) >> 13 )) >> 3) +
-          ((((int32_t)press_adj.dig_P2) * var1) >> 1)) >> 18;
-  var1 = ((((32768 + var1)) * ((int32_t)press_adj.dig_P1)) >> 15);
-
-  /* avoid exception caused by division by zero */
-
-  if (var1 == 0)
-    {
-      return 0;
-    }
-
-  p = (((uint32_t)(((int32_t)1048576) - adc_P) - (var2 >> 12))) * 3125;
-
-  if (p < 0x80000000)
-    {
-      p = (p << 1) / ((uint32_t)var1);
-    }
-  else
-    {
-      p = (p / (uint32_t)var1) * 2;
-    }
-
-  var1 = (((int32_t)press_adj.dig_P9) * ((int32_t)(((p >> 3) * (p >> 3)) >> 13))) >> 12;
-  var2 = (((int32_t)(p >> 2)) * ((int32_t)press_adj.dig_P8)) >> 13;
-  p = (uint32_t)((int32_t)p + ((var1 + var2 + press_adj.dig_P7) >> 4));
-
-  return p;
+  m_compensation.setSeaLevelPressure(pressure);
 }
 
+/*--------------------------------------------------------------------*/
+void BarometerClass::getTrend(FAR BarometerTrend* trend)
+{
+  pthread_mutex_lock(&m_trend_lock);
+  *trend = m_trend;
+  pthread_mutex_unlock(&m_trend_lock);
+}
 
 /****************************************************************************
  * Public Functions
@@ -330,3 +276,25 @@ int BarometerWrite(FAR BarometerClass *ins, FAR sensor_command_data_mh_t *comman
   return ret;
 }
 
+int BarometerSetCompensationMode(FAR BarometerClass *ins,
+                                 BarometerCompensationMode mode)
+{
+  ins->setCompensationMode(mode);
+
+  return 0;
+}
+
+int BarometerSetSeaLevelPressure(FAR BarometerClass *ins, uint32_t pressure)
+{
+  ins->setSeaLevelPressure(pressure);
+
+  return 0;
+}
+
+int BarometerGetTrend(FAR BarometerClass *ins, FAR BarometerTrend *trend)
+{
+  ins->getTrend(trend);
+
+  return 0;
+}
+
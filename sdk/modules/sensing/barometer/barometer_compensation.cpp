@@ -0,0 +1,381 @@
+/****************************************************************************
+ * modules/sensing/barometer/barometer_compensation.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <math.h>
+
+#include "sensing/logical_sensor/barometer_compensation.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Altitude from pressure, international barometric formula. */
+
+#define ALTITUDE_SCALE    44330.0F
+#define ALTITUDE_EXPONENT 0.1903F
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Terms of compensatePressure() by the temperature. */
+
+void BarometerCompensation::exactTerms(int32_t adc_T,
+                                       FAR int32_t *offset,
+                                       FAR uint32_t *divisor) const
+{
+  int32_t t_fine = this->compensateTemperature(adc_T);
+  int32_t var1;
+  int32_t var2;
+
+  var1 = (((int32_t)t_fine) >> 1) - (int32_t)64000;
+  var2 = (((var1 >> 2) * (var1 >> 2)) >> 11 ) *
+         ((int32_t)m_press_adj.dig_P6);
+  var2 = var2 + (var1 * ((int32_t)m_press_adj.dig_P5) * 2);
+  var2 = (var2 >> 2) + (((int32_t)m_press_adj.dig_P4) << 16);
+  var1 = (((m_press_adj.dig_P3 *
+            (((var1 >> 2) * (var1 >> 2)) >> 13 )) >> 3) +
+          ((((int32_t)m_press_adj.dig_P2) * var1) >> 1)) >> 18;
+  var1 = ((((32768 + var1)) * ((int32_t)m_press_adj.dig_P1)) >> 15);
+
+  *offset  = var2 >> 12;
+  *divisor = (uint32_t)var1;
+}
+
+/*--------------------------------------------------------------------*/
+/* Same terms of the floating point formula of the datasheet. */
+
+void BarometerCompensation::floatTerms(int32_t adc_T,
+                                      FAR float *offset,
+                                      FAR float *scale) const
+{
+  int32_t t_fine = this->compensateTemperature(adc_T);
+  float   var1;
+  float   var2;
+
+  var1 = (float)t_fine / 2.0F - 64000.0F;
+  var2 = var1 * var1 * (float)m_press_adj.dig_P6 / 32768.0F;
+  var2 = var2 + var1 * (float)m_press_adj.dig_P5 * 2.0F;
+  var2 = var2 / 4.0F + (float)m_press_adj.dig_P4 * 65536.0F;
+  var1 = ((float)m_press_adj.dig_P3 * var1 * var1 / 524288.0F +
+          (float)m_press_adj.dig_P2 * var1) / 524288.0F;
+  var1 = (1.0F + var1 / 32768.0F) * (float)m_press_adj.dig_P1;
+
+  *offset = 1048576.0F - var2 / 4096.0F;
+  *scale  = (var1 == 0.0F) ? 0.0F : 6250.0F / var1;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void BarometerCompensation::setAdjustParam(
+  FAR const struct bmp280_press_adj_s *param)
+{
+  m_press_adj = *param;
+  m_cached    = false;
+}
+
+/*--------------------------------------------------------------------*/
+void BarometerCompensation::setAdjustParam(
+  FAR const struct bmp280_temp_adj_s *param)
+{
+  m_temp_adj = *param;
+  m_cached   = false;
+}
+
+/*--------------------------------------------------------------------*/
+void BarometerCompensation::setMode(BarometerCompensationMode mode)
+{
+  m_mode   = mode;
+  m_cached = false;
+}
+
+/*--------------------------------------------------------------------*/
+void BarometerCompensation::setSeaLevelPressure(uint32_t pressure)
+{
+  m_sea_level = pressure;
+}
+
+/*--------------------------------------------------------------------*/
+/* Compensate num samples of raw pressure in press, with the raw
+ * temperature of the same index in temp. The result is written over
+ * press in Pa, and the mean, altitude and trend of the block in trend.
+ */
+
+void BarometerCompensation::compensate(FAR const int32_t *temp,
+                                       FAR uint32_t *press,
+                                       uint32_t num,
+                                       uint32_t fs,
+                                       FAR BarometerTrend *trend)
+{
+  /* Sums for the mean and the least squares slope. */
+
+  uint64_t sum   = 0;
+  uint64_t sum_i = 0;
+
+  /* The cache is kept in locals during the loop, as press may alias
+   * the members for the compiler.
+   */
+
+  bool    cached = m_cached;
+  int32_t last_T = m_adc_T;
+
+  if (m_mode == BarometerCompensationExact)
+    {
+      int32_t  dig_P7  = m_press_adj.dig_P7;
+      int32_t  dig_P8  = m_press_adj.dig_P8;
+      int32_t  dig_P9  = m_press_adj.dig_P9;
+      int32_t  offset  = m_offset;
+      uint32_t divisor = m_divisor;
+
+      for (uint32_t i = 0; i < num; i++)
+        {
+          int32_t  adc_P = (int32_t)press[i];
+          int32_t  var1;
+          int32_t  var2;
+          uint32_t p;
+
+          if (!cached || temp[i] != last_T)
+            {
+              this->exactTerms(temp[i], &offset, &divisor);
+              last_T = temp[i];
+              cached = true;
+            }
+
+          /* avoid exception caused by division by zero */
+
+          if (divisor == 0)
+            {
+              press[i] = 0;
+              continue;
+            }
+
+          p = (((uint32_t)(((int32_t)1048576) - adc_P) - offset)) * 3125;
+
+          if (p < 0x80000000)
+            {
+              p = (p << 1) / divisor;
+            }
+          else
+            {
+              p = (p / divisor) * 2;
+            }
+
+          var1 = (dig_P9 * ((int32_t)(((p >> 3) * (p >> 3)) >> 13))) >> 12;
+          var2 = (((int32_t)(p >> 2)) * dig_P8) >> 13;
+          p = (uint32_t)((int32_t)p + ((var1 + var2 + dig_P7) >> 4));
+
+          press[i] = p;
+          sum     += p;
+          sum_i   += (uint64_t)i * p;
+        }
+
+      m_offset  = offset;
+      m_divisor = divisor;
+    }
+  else
+    {
+      /* p + (dig_P9 * p * p / 2^31 + dig_P8 * p / 2^15 + dig_P7) / 16 */
+
+      float c9     = (float)m_press_adj.dig_P9 / 2147483648.0F / 16.0F;
+      float c8     = (float)m_press_adj.dig_P8 / 32768.0F / 16.0F;
+      float c7     = (float)m_press_adj.dig_P7 / 16.0F;
+      float offset = m_offset_f;
+      float scale  = m_scale_f;
+
+      for (uint32_t i = 0; i < num; i++)
+        {
+          float    p;
+          uint32_t result;
+
+          if (!cached || temp[i] != last_T)
+            {
+              this->floatTerms(temp[i], &offset, &scale);
+              last_T = temp[i];
+              cached = true;
+            }
+
+          if (scale == 0.0F)
+            {
+              press[i] = 0;
+              continue;
+            }
+
+          p = (offset - (float)(int32_t)press[i]) * scale;
+          p = p + p * (c9 * p + c8) + c7;
+
+          result   = (p > 0.0F) ? (uint32_t)(p + 0.5F) : 0;
+          press[i] = result;
+          sum     += result;
+          sum_i   += (uint64_t)i * result;
+        }
+
+      m_offset_f = offset;
+      m_scale_f  = scale;
+    }
+
+  m_cached = cached;
+  m_adc_T  = last_T;
+
+  if (trend == NULL)
+    {
+      return;
+    }
+
+  trend->num      = num;
+  trend->pressure = 0;
+  trend->altitude = 0.0F;
+  trend->trend    = 0.0F;
+
+  if (num == 0)
+    {
+      return;
+    }
+
+  float mean = (float)sum / (float)num;
+
+  trend->pressure = (uint32_t)(mean + 0.5F);
+  trend->altitude = ALTITUDE_SCALE *
+                    (1.0F - powf(mean / (float)m_sea_level,
+                                 ALTITUDE_EXPONENT));
+
+  if (num > 1)
+    {
+      /* Slope of the least squares line, from sum(p) and sum(i * p).
+       * The numerator cancels, so it is calculated in integer.
+       */
+
+      int64_t numerator = (int64_t)(12 * sum_i) -
+                          (int64_t)(6 * (uint64_t)(num - 1) * sum);
+      float   n         = (float)num;
+      float   slope     = (float)numerator / (n * (n * n - 1.0F));
+
+      trend->trend = slope * (float)fs;
+    }
+}
+
+/****************************************************************************
+ * Name: compensateTemperature
+ *
+ * Description:
+ *   calculate compensated tempreture
+ *
+ * Input Parameters:
+ *   adc_T - uncompensated value of tempreture.
+ *
+ * Returned Value:
+ *   result of compensated tempreture.
+ *   to get in 0.01 degree Centigrade, calulate as below.
+ *   (T * 5 + 128) >> 8 [0.01 C]
+ *
+ ****************************************************************************/
+
+int32_t BarometerCompensation::compensateTemperature(int32_t adc_T) const
+{
+  int32_t var1;
+  int32_t var2;
+  int32_t T;
+
+  var1 = ((((adc_T >> 3) - ((int32_t)m_temp_adj.dig_T1 << 1))) *
+          ((int32_t)m_temp_adj.dig_T2)) >> 11;
+  var2 = (((((adc_T >> 4) - ((int32_t)m_temp_adj.dig_T1)) *
+          ((adc_T >> 4) - ((int32_t)m_temp_adj.dig_T1))) >> 12) *
+            ((int32_t)m_temp_adj.dig_T3)) >> 14;
+
+  T = var1 + var2;
+
+  return T;
+}
+
+/****************************************************************************
+ * Name: compensatePressure
+ *
+ * Description:
+ *   calculate compensated pressure of a sample, by the exact formula.
+ *
+ * Input Parameters:
+ *   adc_P - uncompensated value of pressure.
+ *   comp_T - compensated value of temperature.
+ *
+ * Returned Value:
+ *   result of compensated pressure.
+ *
+ ****************************************************************************/
+
+uint32_t BarometerCompensation::compensatePressure(int32_t adc_P,
+                                                   int32_t comp_T) const
+{
+  int32_t var1;
+  int32_t var2;
+  uint32_t p;
+
+  var1 = (((int32_t)comp_T) >> 1) - (int32_t)64000;
+  var2 = (((var1 >> 2) * (var1 >> 2)) >> 11 ) * ((int32_t)m_press_adj.dig_P6);
+  var2 = var2 + (var1 * ((int32_t)m_press_adj.dig_P5) * 2);
+  var2 = (var2 >> 2) + (((int32_t)m_press_adj.dig_P4) << 16);
+  var1 = (((m_press_adj.dig_P3 * (((var1 >> 2) * (var1 >> 2)) >> 13 )) >> 3) +
+          ((((int32_t)m_press_adj.dig_P2) * var1) >> 1)) >> 18;
+  var1 = ((((32768 + var1)) * ((int32_t)m_press_adj.dig_P1)) >> 15);
+
+  /* avoid exception caused by division by zero */
+
+  if (var1 == 0)
+    {
+      return 0;
+    }
+
+  p = (((uint32_t)(((int32_t)1048576) - adc_P) - (var2 >> 12))) * 3125;
+
+  if (p < 0x80000000)
+    {
+      p = (p << 1) / ((uint32_t)var1);
+    }
+  else
+    {
+      p = (p / (uint32_t)var1) * 2;
+    }
+
+  var1 = (((int32_t)m_press_adj.dig_P9) *
+          ((int32_t)(((p >> 3) * (p >> 3)) >> 13))) >> 12;
+  var2 = (((int32_t)(p >> 2)) * ((int32_t)m_press_adj.dig_P8)) >> 13;
+  p = (uint32_t)((int32_t)p + ((var1 + var2 + m_press_adj.dig_P7) >> 4));
+
+  return p;
+}
@@ -0,0 +1,705 @@
+/****************************************************************************
+ * modules/sensing/barometer/tool/host/barometer_bench.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/* Test and benchmark of the block compensation of BarometerClass on the
+ * host.
+ *
+ * Raw data are given by CSV files, one sample per line as "adc_P,adc_T".
+ * Each trace is compensated in blocks, by the exact and the float formula
+ * of BarometerCompensation. The exact one must be identical to the 32bit
+ * integer formula of the datasheet, and the float one must be within
+ * FLOAT_TOLERANCE of the double precision formula. The mean, altitude and
+ * trend of each block are checked with the ones calculated from the
+ * result. Then CPU time per sample is measured, with the former per
+ * sample compensation.
+ *
+ * Without files, synthetic traces with some adjustment parameters are
+ * used. "barometer_bench -t" runs only the test.
+ *
+ *   barometer_bench [-t] [-b block] [file.csv ...]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <vector>
+
+#include "sensing/logical_sensor/barometer_compensation.h"
+#include "barometer_reference.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define DEFAULT_BLOCK     40      /* Samples, watermark of BarometerClass */
+#define DEFAULT_FS        8       /* Hz, same as BarometerClass */
+#define SYNTH_SAMPLES     20000
+#define BENCH_MIN_SEC     0.2
+
+#define FLOAT_TOLERANCE    0.6     /* Pa, from the double formula */
+
+#define CHECK(cond) \
+  do \
+    { \
+      if (!(cond)) \
+        { \
+          printf("  NG: %s (line %d)\n", #cond, __LINE__); \
+          return 1; \
+        } \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct Trace
+{
+  std::vector<int32_t> press;
+  std::vector<int32_t> temp;
+};
+
+struct Param
+{
+  struct bmp280_press_adj_s press;
+  struct bmp280_temp_adj_s  temp;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Example of the datasheet. */
+
+static const Param s_datasheet =
+{
+  { 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000 },
+  { 27504, 26435, -1000 }
+};
+
+static const int s_blocks[] = { 1, 7, 40, 256 };
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int32_t irand(int32_t min, int32_t max)
+{
+  return min + (int32_t)((double)rand() / ((double)RAND_MAX + 1.0) *
+                         (max - min + 1));
+}
+
+/*--------------------------------------------------------------------------*/
+/* Adjustment parameters around the ones of the datasheet, as the parts
+ * differ from each other.
+ */
+
+static Param make_param(void)
+{
+  Param p = s_datasheet;
+
+  p.temp.dig_T1  += irand(-2000, 2000);
+  p.temp.dig_T2  += irand(-2000, 2000);
+  p.temp.dig_T3  += irand(-100, 100);
+  p.press.dig_P1 += irand(-3000, 3000);
+  p.press.dig_P2 += irand(-1000, 1000);
+  p.press.dig_P3 += irand(-300, 300);
+  p.press.dig_P4 += irand(-1000, 1000);
+  p.press.dig_P5 += irand(-50, 50);
+  p.press.dig_P6 += irand(-3, 3);
+  p.press.dig_P7 += irand(-1500, 1500);
+  p.press.dig_P8 += irand(-1500, 1500);
+  p.press.dig_P9 += irand(-600, 600);
+
+  return p;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Raw data of a sensor at rest, which the temperature changes slowly and
+ * the pressure has noise. The level moves as going up and down stairs.
+ */
+
+static Trace make_steady(int samples)
+{
+  Trace   trace;
+  int32_t adc_T = 519888;
+  double  adc_P = 415148.0;
+  double  slope = 0.0;
+
+  for (int i = 0; i < samples; i++)
+    {
+      if (rand() % 8 == 0)
+        {
+          adc_T += irand(-16, 16);
+        }
+
+      if (i % 200 == 0)
+        {
+          slope = (double)irand(-40, 40) / 10.0;
+        }
+
+      adc_P += slope;
+      trace.press.push_back((int32_t)adc_P + irand(-20, 20));
+      trace.temp.push_back(adc_T);
+    }
+
+  return trace;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Raw data over the whole range of the sensor, the temperature changes
+ * at every sample.
+ */
+
+static Trace make_sweep(int samples)
+{
+  Trace trace;
+
+  for (int i = 0; i < samples; i++)
+    {
+      /* 300 to 1100 hPa, -40 to 85 C with the datasheet parameters. */
+
+      trace.press.push_back(irand(150000, 650000));
+      trace.temp.push_back(irand(380000, 640000));
+    }
+
+  return trace;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool load_csv(const char *path, Trace *trace)
+{
+  FILE *fp = fopen(path, "r");
+  char  line[256];
+
+  if (fp == NULL)
+    {
+      printf("  cannot open %s\n", path);
+      return false;
+    }
+
+  while (fgets(line, sizeof(line), fp) != NULL)
+    {
+      long p;
+      long t;
+
+      /* Comment or header line */
+
+      if (sscanf(line, "%ld,%ld", &p, &t) != 2)
+        {
+          continue;
+        }
+
+      trace->press.push_back((int32_t)p);
+      trace->temp.push_back((int32_t)t);
+    }
+
+  fclose(fp);
+
+  return !trace->press.empty();
+}
+
+/*--------------------------------------------------------------------------*/
+static void setup(BarometerCompensation &comp,
+                  const Param &param,
+                  BarometerCompensationMode mode)
+{
+  comp.setAdjustParam(&param.press);
+  comp.setAdjustParam(&param.temp);
+  comp.setMode(mode);
+}
+
+/*--------------------------------------------------------------------------*/
+/* Check the trend with the one calculated from the result. */
+
+static int check_trend(const BarometerTrend &trend,
+                       const uint32_t *press,
+                       uint32_t num,
+                       uint32_t fs)
+{
+  double mean = 0.0;
+  double slope = 0.0;
+
+  for (uint32_t i = 0; i < num; i++)
+    {
+      mean += press[i];
+    }
+
+  mean /= num;
+
+  if (num > 1)
+    {
+      double mean_i = (num - 1) / 2.0;
+      double sxy = 0.0;
+      double sxx = 0.0;
+
+      for (uint32_t i = 0; i < num; i++)
+        {
+          sxy += (i - mean_i) * (press[i] - mean);
+          sxx += (i - mean_i) * (i - mean_i);
+        }
+
+      slope = sxy / sxx * fs;
+    }
+
+  double altitude = 44330.0 *
+                    (1.0 - pow(mean / BAROMETER_SEA_LEVEL_PRESSURE, 0.1903));
+
+  CHECK(trend.num == num);
+  CHECK(fabs(trend.pressure - mean) <= 0.5 + 1e-6 * mean);
+  CHECK(fabs(trend.altitude - altitude) <= 0.05);
+  CHECK(fabs(trend.trend - slope) <= 1e-3 + 1e-4 * fabs(slope));
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int compare(const Trace &trace, const Param &param, int block)
+{
+  BarometerCompensation exact;
+  BarometerCompensation flt;
+  std::vector<uint32_t> press_exact(block);
+  std::vector<uint32_t> press_float(block);
+  double                max_diff = 0.0;
+  double                max_exact = 0.0;
+
+  setup(exact, param, BarometerCompensationExact);
+  setup(flt, param, BarometerCompensationFloat);
+
+  for (size_t top = 0; top < trace.press.size(); top += block)
+    {
+      uint32_t num = (uint32_t)std::min((size_t)block,
+                                        trace.press.size() - top);
+      BarometerTrend trend_exact;
+      BarometerTrend trend_float;
+
+      memcpy(&press_exact[0], &trace.press[top], sizeof(uint32_t) * num);
+      memcpy(&press_float[0], &trace.press[top], sizeof(uint32_t) * num);
+
+      exact.compensate(&trace.temp[top], &press_exact[0], num,
+                       DEFAULT_FS, &trend_exact);
+      flt.compensate(&trace.temp[top], &press_float[0], num,
+                     DEFAULT_FS, &trend_float);
+
+      for (uint32_t i = 0; i < num; i++)
+        {
+          int32_t t_fine = ref_t_fine(param.temp, trace.temp[top + i]);
+          double  ref = ref_pressure_double(param.press,
+                                            trace.press[top + i],
+                                            t_fine);
+
+          CHECK(press_exact[i] ==
+                ref_pressure32(param.press, trace.press[top + i], t_fine));
+
+          max_diff  = std::max(max_diff, fabs(press_float[i] - ref));
+          max_exact = std::max(max_exact, fabs(press_exact[i] - ref));
+        }
+
+      if (check_trend(trend_exact, &press_exact[0], num, DEFAULT_FS) ||
+          check_trend(trend_float, &press_float[0], num, DEFAULT_FS))
+        {
+          return 1;
+        }
+    }
+
+  printf("  block %3d: exact is bit exact, "
+         "max error from double: exact %.2f Pa, float %.2f Pa\n",
+         block, max_exact, max_diff);
+
+  CHECK(max_diff <= FLOAT_TOLERANCE);
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_datasheet(void)
+{
+  BarometerCompensation comp;
+  int32_t               t_fine;
+
+  printf("datasheet:\n");
+
+  setup(comp, s_datasheet, BarometerCompensationExact);
+
+  /* The 32bit integer formula gives 100656 Pa, where the 64bit and
+   * the floating point ones give 100653 Pa. The datasheet shows 100653.27
+   * with t_fine of the floating point formula, 0.01 higher than the
+   * integer one.
+   */
+
+  t_fine = ref_t_fine(s_datasheet.temp, 519888);
+  CHECK(((t_fine * 5 + 128) >> 8) == 2508);
+  CHECK(ref_pressure32(s_datasheet.press, 415148, t_fine) == 100656);
+  CHECK(fabs(ref_pressure_double(s_datasheet.press, 415148, t_fine) -
+             100653.27) < 0.05);
+
+  CHECK(comp.compensateTemperature(519888) == t_fine);
+  CHECK(comp.compensatePressure(415148, t_fine) == 100656);
+
+  int32_t        temp = 519888;
+  uint32_t       press = 415148;
+  BarometerTrend trend;
+
+  comp.compensate(&temp, &press, 1, DEFAULT_FS, &trend);
+  CHECK(press == 100656);
+  CHECK(trend.num == 1 && trend.pressure == 100656 && trend.trend == 0.0F);
+
+  press = 415148;
+  comp.setMode(BarometerCompensationFloat);
+  comp.compensate(&temp, &press, 1, DEFAULT_FS, NULL);
+  CHECK(press == 100653);
+
+  printf("  OK\n");
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Terms of the last temperature are kept over the blocks. They must be
+ * updated by the parameters and the mode.
+ */
+
+static int test_cache(void)
+{
+  BarometerCompensation comp;
+  Param                 param = make_param();
+  int32_t               temp = 519888;
+  uint32_t              press;
+  int32_t               t_fine;
+
+  printf("cache:\n");
+
+  setup(comp, s_datasheet, BarometerCompensationExact);
+  press = 415148;
+  comp.compensate(&temp, &press, 1, DEFAULT_FS, NULL);
+  CHECK(press == 100656);
+
+  comp.setMode(BarometerCompensationFloat);
+  press = 415148;
+  comp.compensate(&temp, &press, 1, DEFAULT_FS, NULL);
+  CHECK(press == 100653);
+
+  comp.setMode(BarometerCompensationExact);
+  press = 415148;
+  comp.compensate(&temp, &press, 1, DEFAULT_FS, NULL);
+  CHECK(press == 100656);
+
+  /* Pressure parameters only. */
+
+  comp.setAdjustParam(&param.press);
+  t_fine = ref_t_fine(s_datasheet.temp, temp);
+  press = 415148;
+  comp.compensate(&temp, &press, 1, DEFAULT_FS, NULL);
+  CHECK(press == ref_pressure32(param.press, 415148, t_fine));
+
+  /* Temperature parameters only. */
+
+  comp.setAdjustParam(&param.temp);
+  t_fine = ref_t_fine(param.temp, temp);
+  press = 415148;
+  comp.compensate(&temp, &press, 1, DEFAULT_FS, NULL);
+  CHECK(press == ref_pressure32(param.press, 415148, t_fine));
+
+  printf("  OK\n");
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_special(void)
+{
+  BarometerCompensation comp;
+  Param                 param = s_datasheet;
+  int32_t               temp[4] = { 519888, 519888, 519900, 519900 };
+  uint32_t              press[4];
+  BarometerTrend        trend;
+
+  printf("special cases:\n");
+
+  /* No sample. */
+
+  setup(comp, s_datasheet, BarometerCompensationExact);
+  comp.compensate(temp, press, 0, DEFAULT_FS, &trend);
+  CHECK(trend.num == 0 && trend.pressure == 0);
+
+  /* Sea level. */
+
+  for (int i = 0; i < 4; i++)
+    {
+      press[i] = 415148;
+    }
+
+  comp.setSeaLevelPressure(100656);
+  comp.compensate(temp, press, 2, DEFAULT_FS, &trend);
+  CHECK(trend.pressure == 100656);
+  CHECK(fabsf(trend.altitude) < 0.01F);
+  CHECK(trend.trend == 0.0F);
+
+  /* Division by zero of the formula gives 0. */
+
+  param.press.dig_P1 = 0;
+
+  for (int mode = 0; mode < 2; mode++)
+    {
+      for (int i = 0; i < 4; i++)
+        {
+          press[i] = 415148;
+        }
+
+      setup(comp, param, (BarometerCompensationMode)mode);
+      comp.compensate(temp, press, 4, DEFAULT_FS, &trend);
+
+      for (int i = 0; i < 4; i++)
+        {
+          CHECK(press[i] == 0);
+        }
+
+      CHECK(trend.pressure == 0);
+    }
+
+  printf("  OK\n");
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_trace(const char *name,
+                      const Trace &trace,
+                      const Param &param,
+                      int block)
+{
+  printf("%s (%zu samples):\n", name, trace.press.size());
+
+  if (block > 0)
+    {
+      return compare(trace, param, block);
+    }
+
+  for (size_t i = 0; i < sizeof(s_blocks) / sizeof(s_blocks[0]); i++)
+    {
+      if (compare(trace, param, s_blocks[i]))
+        {
+          return 1;
+        }
+    }
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static double now_sec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Former BarometerClass::compemsate(), both formulas for each sample. */
+
+static void run_sample(BarometerCompensation &comp,
+                       const int32_t *temp,
+                       uint32_t *press,
+                       uint32_t num)
+{
+  for (uint32_t i = 0; i < num; i++)
+    {
+      int t = comp.compensateTemperature(temp[i]);
+      press[i] = comp.compensatePressure(press[i], t);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/* CPU time per sample, mode < 0 is the former per sample one. */
+
+static double measure(const Trace &trace, const Param &param, int mode,
+                      int block)
+{
+  BarometerCompensation comp;
+  std::vector<uint32_t> press(block);
+  BarometerTrend        trend;
+  double                start = now_sec();
+  double                elapsed;
+  int                   loop = 0;
+
+  setup(comp, param, (mode < 0) ? BarometerCompensationExact :
+                                  (BarometerCompensationMode)mode);
+
+  do
+    {
+      for (size_t top = 0; top < trace.press.size(); top += block)
+        {
+          uint32_t num = (uint32_t)std::min((size_t)block,
+                                            trace.press.size() - top);
+
+          memcpy(&press[0], &trace.press[top], sizeof(uint32_t) * num);
+
+          if (mode < 0)
+            {
+              run_sample(comp, &trace.temp[top], &press[0], num);
+            }
+          else
+            {
+              comp.compensate(&trace.temp[top], &press[0], num,
+                              DEFAULT_FS, &trend);
+            }
+        }
+
+      loop++;
+      elapsed = now_sec() - start;
+    }
+  while (elapsed < BENCH_MIN_SEC);
+
+  return elapsed / loop / trace.press.size();
+}
+
+/*--------------------------------------------------------------------------*/
+static void bench(const char *name, const Trace &trace, const Param &param,
+                  int block)
+{
+  printf("bench %s (block %d, CPU time per sample):\n", name, block);
+  printf("  sample %6.1f ns, exact %6.1f ns, float %6.1f ns\n",
+         measure(trace, param, -1, block) * 1e9,
+         measure(trace, param, BarometerCompensationExact, block) * 1e9,
+         measure(trace, param, BarometerCompensationFloat, block) * 1e9);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  bool test_only = false;
+  int  block = 0;
+  int  i;
+
+  for (i = 1; i < argc && argv[i][0] == '-'; i++)
+    {
+      if (strcmp(argv[i], "-t") == 0)
+        {
+          test_only = true;
+        }
+      else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+        {
+          block = atoi(argv[++i]);
+        }
+      else
+        {
+          printf("usage: %s [-t] [-b block] [file.csv ...]\n", argv[0]);
+          return 1;
+        }
+    }
+
+  if (block < 0)
+    {
+      printf("invalid block\n");
+      return 1;
+    }
+
+  srand(1);
+
+  if (test_datasheet() || test_cache() || test_special())
+    {
+      printf("Test NG\n");
+      return 1;
+    }
+
+  std::vector<const char *> names;
+  std::vector<Trace>        traces;
+  std::vector<Param>        params;
+
+  if (i == argc)
+    {
+      names.push_back("steady");
+      traces.push_back(make_steady(SYNTH_SAMPLES));
+      params.push_back(s_datasheet);
+
+      names.push_back("sweep");
+      traces.push_back(make_sweep(SYNTH_SAMPLES));
+      params.push_back(s_datasheet);
+
+      /* Other parts. */
+
+      for (int p = 0; p < 4; p++)
+        {
+          names.push_back("sweep, other parameters");
+          traces.push_back(make_sweep(SYNTH_SAMPLES / 4));
+          params.push_back(make_param());
+        }
+    }
+
+  for (; i < argc; i++)
+    {
+      Trace trace;
+
+      if (!load_csv(argv[i], &trace))
+        {
+          printf("Test NG\n");
+          return 1;
+        }
+
+      names.push_back(argv[i]);
+      traces.push_back(trace);
+      params.push_back(s_datasheet);
+    }
+
+  for (size_t t = 0; t < traces.size(); t++)
+    {
+      if (test_trace(names[t], traces[t], params[t], block))
+        {
+          printf("Test NG\n");
+          return 1;
+        }
+    }
+
+  printf("All tests OK\n");
+
+  if (!test_only)
+    {
+      for (size_t t = 0; t < traces.size() && t < 2; t++)
+        {
+          bench(names[t], traces[t], params[t],
+                (block > 0) ? block : DEFAULT_BLOCK);
+        }
+    }
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+/****************************************************************************
+ * modules/sensing/barometer/tool/host/barometer_reference.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/* Compensation formulas of the BMP280 datasheet as they are written in it,
+ * for the reference of barometer_bench.
+ */
+
+#include "barometer_reference.h"
+
+/*--------------------------------------------------------------------------*/
+int32_t ref_t_fine(const struct bmp280_temp_adj_s &adj, int32_t adc_T)
+{
+  int32_t var1;
+  int32_t var2;
+
+  var1 = ((((adc_T >> 3) - ((int32_t)adj.dig_T1 << 1))) *
+          ((int32_t)adj.dig_T2)) >> 11;
+  var2 = (((((adc_T >> 4) - ((int32_t)adj.dig_T1)) *
+            ((adc_T >> 4) - ((int32_t)adj.dig_T1))) >> 12) *
+          ((int32_t)adj.dig_T3)) >> 14;
+
+  return var1 + var2;
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t ref_pressure32(const struct bmp280_press_adj_s &adj,
+                        int32_t adc_P,
+                        int32_t t_fine)
+{
+  int32_t  var1;
+  int32_t  var2;
+  uint32_t p;
+
+  var1 = (((int32_t)t_fine) >> 1) - (int32_t)64000;
+  var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * ((int32_t)adj.dig_P6);
+  var2 = var2 + ((var1 * ((int32_t)adj.dig_P5)) << 1);
+  var2 = (var2 >> 2) + (((int32_t)adj.dig_P4) << 16);
+  var1 = (((adj.dig_P3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) +
+          ((((int32_t)adj.dig_P2) * var1) >> 1)) >> 18;
+  var1 = ((((32768 + var1)) * ((int32_t)adj.dig_P1)) >> 15);
+
+  if (var1 == 0)
+    {
+      return 0;
+    }
+
+  p = (((uint32_t)(((int32_t)1048576) - adc_P) - (var2 >> 12))) * 3125;
+
+  if (p < 0x80000000)
+    {
+      p = (p << 1) / ((uint32_t)var1);
+    }
+  else
+    {
+      p = (p / (uint32_t)var1) * 2;
+    }
+
+  var1 = (((int32_t)adj.dig_P9) *
+          ((int32_t)(((p >> 3) * (p >> 3)) >> 13))) >> 12;
+  var2 = (((int32_t)(p >> 2)) * ((int32_t)adj.dig_P8)) >> 13;
+  p = (uint32_t)((int32_t)p + ((var1 + var2 + adj.dig_P7) >> 4));
+
+  return p;
+}
+
+/*--------------------------------------------------------------------------*/
+double ref_pressure_double(const struct bmp280_press_adj_s &adj,
+                           int32_t adc_P,
+                           int32_t t_fine)
+{
+  double var1;
+  double var2;
+  double p;
+
+  var1 = ((double)t_fine / 2.0) - 64000.0;
+  var2 = var1 * var1 * ((double)adj.dig_P6) / 32768.0;
+  var2 = var2 + var1 * ((double)adj.dig_P5) * 2.0;
+  var2 = (var2 / 4.0) + (((double)adj.dig_P4) * 65536.0);
+  var1 = (((double)adj.dig_P3) * var1 * var1 / 524288.0 +
+          ((double)adj.dig_P2) * var1) / 524288.0;
+  var1 = (1.0 + var1 / 32768.0) * ((double)adj.dig_P1);
+
+  if (var1 == 0.0)
+    {
+      return 0.0;
+    }
+
+  p = 1048576.0 - (double)adc_P;
+  p = (p - (var2 / 4096.0)) * 6250.0 / var1;
+  var1 = ((double)adj.dig_P9) * p * p / 2147483648.0;
+  var2 = p * ((double)adj.dig_P8) / 32768.0;
+  p = p + (var1 + var2 + ((double)adj.dig_P7)) / 16.0;
+
+  return p;
+}
@@ -0,0 +1,64 @@
+/****************************************************************************
+ * modules/sensing/barometer/tool/host/barometer_reference.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#ifndef __SENSING_BAROMETER_TOOL_HOST_BAROMETER_REFERENCE_H
+#define __SENSING_BAROMETER_TOOL_HOST_BAROMETER_REFERENCE_H
+
+#include <sdk/config.h>
+#include <stdint.h>
+#include <nuttx/sensors/bmp280.h>
+
+/* Compensation formulas of the BMP280 datasheet, one sample at a time.
+ * These are kept only as the reference of barometer_bench.
+ */
+
+/* t_fine of the 32bit integer formula. */
+
+int32_t ref_t_fine(const struct bmp280_temp_adj_s &adj, int32_t adc_T);
+
+/* Pressure [Pa] by the 32bit integer formula. */
+
+uint32_t ref_pressure32(const struct bmp280_press_adj_s &adj,
+                        int32_t adc_P,
+                        int32_t t_fine);
+
+/* Pressure [Pa] by the double precision floating point formula. */
+
+double ref_pressure_double(const struct bmp280_press_adj_s &adj,
+                           int32_t adc_P,
+                           int32_t t_fine);
+
+#endif /* __SENSING_BAROMETER_TOOL_HOST_BAROMETER_REFERENCE_H */
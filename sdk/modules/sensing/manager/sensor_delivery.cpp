@@ -0,0 +1,340 @@
+/****************************************************************************
+ * modules/sensing/manager/sensor_delivery.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sdk/config.h>
+#include <sdk/debug.h>
+
+#include <string.h>
+
+#include "memutils/os_utils/chateau_osal.h"
+#include "sensor_delivery.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SENSING_MANAGER_DEBUG_ERROR
+#  define sensor_err(fmt, ...)   logerr(fmt, ## __VA_ARGS__)
+#else
+#  define sensor_err(fmt, ...)
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+SensorDelivery::SensorDelivery()
+  : m_id(0)
+  , m_callback(NULL)
+  , m_callback_mh(NULL)
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  , m_running(false)
+  , m_stop(false)
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+{
+  pthread_mutex_init(&m_lock, NULL);
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  pthread_cond_init(&m_cond, NULL);
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+
+  memset(&m_stats, 0, sizeof(m_stats));
+}
+
+/*--------------------------------------------------------------------*/
+SensorDelivery::~SensorDelivery()
+{
+  stop();
+
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  pthread_cond_destroy(&m_cond);
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+  pthread_mutex_destroy(&m_lock);
+}
+
+/*--------------------------------------------------------------------*/
+bool SensorDelivery::start(unsigned int id,
+                           sensor_data_callback_t callback,
+                           sensor_data_mh_callback_t callback_mh)
+{
+  /* Registered again, stop the previous delivery at first. */
+
+  stop();
+
+  m_id          = id;
+  m_callback    = callback;
+  m_callback_mh = callback_mh;
+
+  clear_stats();
+
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  /* A client which has no callback only publishes,
+   * the delivery thread is not necessary.
+   */
+
+  if (!callback && !callback_mh)
+    {
+      return true;
+    }
+
+  pthread_attr_t     attr;
+  struct sched_param sch_param;
+
+  pthread_attr_init(&attr);
+  sch_param.sched_priority = CONFIG_SENSING_MANAGER_DELIVERY_PRIORITY;
+  pthread_attr_setstacksize(&attr,
+                            CONFIG_SENSING_MANAGER_DELIVERY_STACK_SIZE);
+  pthread_attr_setschedparam(&attr, &sch_param);
+
+  m_stop = false;
+
+  int ret = pthread_create(&m_pid,
+                           &attr,
+                           delivery_entry,
+                           static_cast<FAR void *>(this));
+  if (ret != 0)
+    {
+      sensor_err("ERROR delivery thread of %d create failed\n", id);
+      m_callback    = NULL;
+      m_callback_mh = NULL;
+      return false;
+    }
+
+  m_running = true;
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+void SensorDelivery::stop(void)
+{
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  if (m_running)
+    {
+      pthread_mutex_lock(&m_lock);
+      m_stop = true;
+      pthread_cond_signal(&m_cond);
+      pthread_mutex_unlock(&m_lock);
+
+      pthread_join(m_pid, NULL);
+      m_running = false;
+    }
+
+  /* Release the MemHandles which are not delivered yet. */
+
+  pthread_mutex_lock(&m_lock);
+  m_que.clear();
+  pthread_mutex_unlock(&m_lock);
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+
+  m_callback    = NULL;
+  m_callback_mh = NULL;
+}
+
+/*--------------------------------------------------------------------*/
+bool SensorDelivery::deliver(sensor_command_data_t &data, uint32_t recv_time)
+{
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  entry_t entry;
+
+  entry.is_mh     = false;
+  entry.recv_time = recv_time;
+  entry.data      = data;
+
+  return push(entry);
+#else
+  m_callback(data);
+  update_stats(recv_time);
+
+  return true;
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+}
+
+/*--------------------------------------------------------------------*/
+bool SensorDelivery::deliver(sensor_command_data_mh_t &data,
+                             uint32_t recv_time)
+{
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  entry_t entry;
+
+  entry.is_mh     = true;
+  entry.recv_time = recv_time;
+  entry.data_mh   = data;
+
+  return push(entry);
+#else
+  m_callback_mh(data);
+  update_stats(recv_time);
+
+  return true;
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+}
+
+/*--------------------------------------------------------------------*/
+void SensorDelivery::get_stats(FAR sensor_delivery_stats_t *stats)
+{
+  pthread_mutex_lock(&m_lock);
+  *stats = m_stats;
+  pthread_mutex_unlock(&m_lock);
+}
+
+/*--------------------------------------------------------------------*/
+void SensorDelivery::clear_stats(void)
+{
+  pthread_mutex_lock(&m_lock);
+  memset(&m_stats, 0, sizeof(m_stats));
+  pthread_mutex_unlock(&m_lock);
+}
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+void SensorDelivery::update_stats(uint32_t recv_time)
+{
+  uint32_t latency = Chateau_GetTimeUs() - recv_time;
+
+  pthread_mutex_lock(&m_lock);
+
+  m_stats.delivered++;
+  m_stats.latency_last   = latency;
+  m_stats.latency_total += latency;
+
+  if (latency > m_stats.latency_max)
+    {
+      m_stats.latency_max = latency;
+    }
+
+  pthread_mutex_unlock(&m_lock);
+}
+
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+/*--------------------------------------------------------------------*/
+bool SensorDelivery::push(entry_t &entry)
+{
+  bool result;
+
+  pthread_mutex_lock(&m_lock);
+
+  result = m_que.push(entry);
+  if (result)
+    {
+      if ((uint32_t)m_que.size() > m_stats.queued_max)
+        {
+          m_stats.queued_max = m_que.size();
+        }
+
+      pthread_cond_signal(&m_cond);
+    }
+  else
+    {
+      m_stats.dropped++;
+    }
+
+  pthread_mutex_unlock(&m_lock);
+
+  if (!result)
+    {
+      sensor_err("delivery queue of %d is full, data dropped\n", m_id);
+    }
+
+  return result;
+}
+
+/*--------------------------------------------------------------------*/
+void SensorDelivery::run(void)
+{
+  pthread_mutex_lock(&m_lock);
+
+  while (1)
+    {
+      while (m_que.empty() && !m_stop)
+        {
+          pthread_cond_wait(&m_cond, &m_lock);
+        }
+
+      if (m_stop)
+        {
+          break;
+        }
+
+      /* Take the entry out of the queue before the callback, the producer
+       * can push the next data while the client is processing.
+       * Copy of the entry takes a reference of the MemHandle,
+       * and the reference is released when the local entry is destroyed.
+       */
+
+      {
+        entry_t entry = m_que.top();
+        m_que.pop();
+
+        pthread_mutex_unlock(&m_lock);
+
+        if (entry.is_mh)
+          {
+            if (m_callback_mh)
+              {
+                m_callback_mh(entry.data_mh);
+              }
+          }
+        else
+          {
+            if (m_callback)
+              {
+                m_callback(entry.data);
+              }
+          }
+
+        update_stats(entry.recv_time);
+      }
+
+      pthread_mutex_lock(&m_lock);
+    }
+
+  pthread_mutex_unlock(&m_lock);
+}
+
+/*--------------------------------------------------------------------*/
+FAR void *SensorDelivery::delivery_entry(FAR void *arg)
+{
+  static_cast<SensorDelivery *>(arg)->run();
+
+  return NULL;
+}
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
@@ -0,0 +1,120 @@
+/****************************************************************************
+ * modules/sensing/manager/sensor_delivery.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __SENSING_MANAGER_SENSOR_DELIVERY_H
+#define __SENSING_MANAGER_SENSOR_DELIVERY_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sdk/config.h>
+
+#include <pthread.h>
+
+#include "sensing/sensor_api.h"
+
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+#include "memutils/s_stl/queue.h"
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Delivery of the published data to one client.
+ *
+ * Without CONFIG_SENSING_MANAGER_ASYNC_DELIVERY, the callback of the client
+ * is called on the manager thread as before.
+ * With it, the data is pushed to a bounded queue of the client and the
+ * callback is called on the delivery thread of the client, so that a slow
+ * client doesn't delay the other clients. The data with MemHandle is held
+ * by a copy of the handle (reference count), the payload is not copied.
+ * When the queue is full, the data is dropped and counted.
+ */
+
+class SensorDelivery
+{
+public:
+  SensorDelivery();
+  ~SensorDelivery();
+
+  bool start(unsigned int id,
+             sensor_data_callback_t callback,
+             sensor_data_mh_callback_t callback_mh);
+  void stop(void);
+
+  bool deliver(sensor_command_data_t &data, uint32_t recv_time);
+  bool deliver(sensor_command_data_mh_t &data, uint32_t recv_time);
+
+  void get_stats(FAR sensor_delivery_stats_t *stats);
+  void clear_stats(void);
+
+private:
+  unsigned int              m_id;
+  sensor_data_callback_t    m_callback;
+  sensor_data_mh_callback_t m_callback_mh;
+
+  pthread_mutex_t           m_lock;
+  sensor_delivery_stats_t   m_stats;
+
+  void update_stats(uint32_t recv_time);
+
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  typedef struct
+  {
+    bool                     is_mh;     /* Which of data is valid */
+    uint32_t                 recv_time; /* Received time by manager [us] */
+    sensor_command_data_t    data;
+    sensor_command_data_mh_t data_mh;
+  } entry_t;
+
+  typedef s_std::Queue<entry_t,
+                       CONFIG_SENSING_MANAGER_DELIVERY_QUEUE_DEPTH> EntryQue;
+
+  EntryQue                  m_que;
+  pthread_cond_t            m_cond;
+  pthread_t                 m_pid;
+  bool                      m_running;
+  bool                      m_stop;
+
+  bool push(entry_t &entry);
+  void run(void);
+
+  static FAR void *delivery_entry(FAR void *arg);
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+};
+
+#endif /* __SENSING_MANAGER_SENSOR_DELIVERY_H */
@@ -41,6 +41,7 @@
 #include <sdk/debug.h>
 #include <nuttx/arch.h>
 
+#include "memutils/os_utils/chateau_osal.h"
 #include "sensor_manager.h"
 
 /****************************************************************************
@@ -153,6 +154,20 @@ void SensorManager::register_client(MsgPacket* packet)
 {
   sensor_command_register_t reg = packet->moveParam<sensor_command_register_t>();
 
+  if (reg.get_self() >= 24)
+    {
+      response(reg.header.code, SS_ECODE_PARAM_ERROR, reg.get_self());
+      return;
+    }
+
+  if (!m_delivery[reg.get_self()].start(reg.get_self(),
+                                        reg.callback,
+                                        reg.callback_mh))
+    {
+      response(reg.header.code, SS_ECODE_TASK_CREATE_ERROR, reg.get_self());
+      return;
+    }
+
   client_table[reg.get_self()].status = 0x01;
   client_table[reg.get_self()].callback = reg.callback;
   client_table[reg.get_self()].callback_mh = reg.callback_mh;
@@ -212,6 +227,10 @@ void SensorManager::release_client(MsgPacket* packet)
 #endif /* CONFIG_SENSING_MANAGER_POWERCTRL */
     }
 
+  /* Stop the delivery, the data not delivered yet is discarded. */
+
+  m_delivery[rel.get_self()].stop();
+
   client_table[rel.get_self()].status      = 0x00;
   client_table[rel.get_self()].subscribers = 0x00;
   client_table[rel.get_self()].callback    = 0x00;
@@ -269,6 +288,7 @@ void SensorManager::change_subscription(MsgPacket* packet)
 void SensorManager::send_data(MsgPacket* packet)
 {
   sensor_command_data_t data = packet->moveParam<sensor_command_data_t>();
+  uint32_t recv_time = Chateau_GetTimeUs();
 
   if (client_table[data.get_self()].status == 0x00)
     {
@@ -278,6 +298,19 @@ void SensorManager::send_data(MsgPacket* packet)
       return;
     }
 
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  /* Data of is_ptr is queued by its address, and the publisher cannot
+   * know when the clients have received it. It is not accepted.
+   */
+
+  if (data.is_ptr)
+    {
+      sensor_err("is_ptr data is not supported by async delivery.\n");
+      response(data.header.code, SS_ECODE_PARAM_ERROR, data.get_self());
+      return;
+    }
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+
   for (int i = 0, j = client_table[data.get_self()].subscribers;
         (j != 0) || (i < 24); i++)
     {
@@ -291,7 +324,11 @@ void SensorManager::send_data(MsgPacket* packet)
               return;
             }
 
-          client_table[i].callback(data);/* callback */
+          /* Data which is over the queue is dropped and counted
+           * in the statistics of the subscriber.
+           */
+
+          m_delivery[i].deliver(data, recv_time);
           j &= ~(0x01 << i);
         }
     }
@@ -304,6 +341,7 @@ void SensorManager::send_data(MsgPacket* packet)
 void SensorManager::send_data_mh(MsgPacket* packet)
 {
   sensor_command_data_mh_t data = packet->moveParam<sensor_command_data_mh_t>();
+  uint32_t recv_time = Chateau_GetTimeUs();
 
   if (client_table[data.get_self()].status == 0x00)
     {
@@ -326,7 +364,7 @@ void SensorManager::send_data_mh(MsgPacket* packet)
               return;
             }
 
-          client_table[i].callback_mh(data);/* callback */
+          m_delivery[i].deliver(data, recv_time);
           j &= ~(0x01 << i);
         }
     }
@@ -481,7 +519,7 @@ bool SS_ActivateSensorSubSystem(MsgQueId selfMId,
   int                ret = 0;
   pthread_attr_init(&attr);
   sch_param.sched_priority = SS_TASK_PRIORITY;
-  attr.stacksize           = SS_TASK_MANAGER_STACK_SIZE;
+  pthread_attr_setstacksize(&attr, SS_TASK_MANAGER_STACK_SIZE);
   pthread_attr_setschedparam(&attr, &sch_param);
 
   ret = pthread_create(&s_smng_pid,
@@ -533,6 +571,29 @@ void SS_SendSensorData(FAR sensor_command_data_t *packet)
   F_ASSERT(er == ERR_OK);
 }
 
+/*--------------------------------------------------------------------*/
+bool SS_GetSensorDeliveryStats(unsigned int id,
+                               FAR sensor_delivery_stats_t *stats)
+{
+  if ((TheSensorManager == NULL) || (stats == NULL))
+    {
+      return false;
+    }
+
+  return TheSensorManager->get_delivery_stats(id, stats);
+}
+
+/*--------------------------------------------------------------------*/
+bool SS_ClearSensorDeliveryStats(unsigned int id)
+{
+  if (TheSensorManager == NULL)
+    {
+      return false;
+    }
+
+  return TheSensorManager->clear_delivery_stats(id);
+}
+
 /*--------------------------------------------------------------------*/
 void SS_SendSensorResult(FAR sensor_command_result_t *packet)
 {
@@ -47,6 +47,7 @@
 #include "sensing/sensor_id.h"
 #include "sensing/sensor_api.h"
 #include "sensing/sensor_ecode.h"
+#include "sensor_delivery.h"
 
 /****************************************************************************
  * Public Types
@@ -65,6 +66,28 @@ public:
 
   ~SensorManager(){};
 
+  bool get_delivery_stats(unsigned int id, FAR sensor_delivery_stats_t *stats)
+  {
+    if (id >= 24)
+      {
+        return false;
+      }
+
+    m_delivery[id].get_stats(stats);
+    return true;
+  }
+
+  bool clear_delivery_stats(unsigned int id)
+  {
+    if (id >= 24)
+      {
+        return false;
+      }
+
+    m_delivery[id].clear_stats();
+    return true;
+  }
+
 private:
   SensorManager(MsgQueId selfMId, api_response_callback_t callback)
       : m_selfMId(selfMId)
@@ -101,6 +124,9 @@ private:
   /** subscriber database*/
   client_info_t client_table[24]; /* 24 must be config.*/
 
+  /** delivery to each subscriber */
+  SensorDelivery m_delivery[24];
+
   /*** private mathods ***/
   void    run(void);
 
@@ -184,7 +184,7 @@ int StepCounterClass::open(void)
 
   ret = pthread_create(&m_thread_id, NULL,
                        receiver_thread_entry,
-                       static_cast<pthread_addr_t>(this));
+                       static_cast<FAR void *>(this));
   if (ret != 0)
     {
       sc_err("Failed to create receiver_thread_entry, error=%d\n", ret);
@@ -268,7 +268,8 @@ int StepCounterClass::sendInit(void)
   dsp_cmd->header.event_type  = InitEvent;
 
   int ret = mpmq_send(&m_mq, (StepCounterMode << 4) + (InitEvent << 1),
-                      reinterpret_cast<int32_t>(mh.getPa()));
+                      static_cast<uint32_t>(
+                        reinterpret_cast<uintptr_t>(mh.getPa())));
   if (ret < 0)
     {
       sc_err("mpmq_send() failure. %d\n", ret);
@@ -369,7 +370,8 @@ int StepCounterClass::write(FAR sensor_command_data_mh_t *command)
 
   int ret = mpmq_send(&m_mq,
                       (StepCounterMode << 4) + (ExecEvent << 1),
-                      reinterpret_cast<int32_t>(exe_mh.cmd.getPa()));
+                      static_cast<uint32_t>(
+                        reinterpret_cast<uintptr_t>(exe_mh.cmd.getPa())));
   if (ret < 0)
     {
       m_exe_que.pop();
@@ -489,7 +491,8 @@ int StepCounterClass::set(FAR StepCounterSetting *set_param)
 
   int ret = mpmq_send(&m_mq,
                       (StepCounterMode << 4) + (ExecEvent << 1),
-                      reinterpret_cast<int32_t>(exe_mh.cmd.getPa()));
+                      static_cast<uint32_t>(
+                        reinterpret_cast<uintptr_t>(exe_mh.cmd.getPa())));
 
   if (ret < 0)
     {
@@ -39,6 +39,7 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <time.h>
 #include <debug.h>
 #include "sensing/tap.h"
 
@@ -61,6 +62,8 @@
  * Private Function Prototypes
  ****************************************************************************/
 
+static float squareThres(float thres);
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -204,6 +207,40 @@ int TapWrite(FAR TapClass *ins, FAR ST_TAP_ACCEL *accelData)
   return ret;
 }
 
+/****************************************************************************
+ * Name: TapWrite_block
+ *
+ * Description:
+ *   TapClass::write() call for a block of accel data.
+ *
+ * Input Parameters:
+ *   TapClass*           Object of TapClass.
+ *   ST_TAP_ACCEL*       Accel Data(x,y,z) of num samples
+ *   num                 Number of samples
+ *   time_stamp          Time stamp of the first sample
+ *   interval            Sampling interval(microsec)
+ *   ST_TAP_EVENT*       Detected tap events(num entries at most)
+ *
+ * Returned Value:
+ *   TapClass::write() result
+ *     D_SA_STATUS_E_INVALID_ARGS   Parameter error
+ *     event number                 number of detected tap events
+ *
+ * Assumptions/Limitations:
+ *   -
+ *
+ ****************************************************************************/
+int TapWrite_block(FAR TapClass *ins, FAR ST_TAP_ACCEL *accelData, int num,
+                   uint64_t time_stamp, uint32_t interval,
+                   FAR ST_TAP_EVENT *events)
+{
+  int ret = 0;
+
+  ret = ins->write(accelData, num, time_stamp, interval, events);
+
+  return ret;
+}
+
 /****************************************************************************
  *Tap Class
  ****************************************************************************/
@@ -291,6 +328,8 @@ int TapClass::open(ST_TAP_OPEN *OpenParam)
   mPeakThres  = OpenParam->peak_thres;
   mLongThres  = OpenParam->long_thres;
   mStabFrame  = OpenParam->stab_frame;
+  mPeakThres2 = squareThres(mPeakThres);
+  mLongThres2 = squareThres(mLongThres);
   mTapCnt     = 0;
   mState      = E_TAP_STATE_IDLE;
 
@@ -357,7 +396,6 @@ int TapClass::write(ST_TAP_ACCEL* accelData)
   
   bool              detectflg     = false;
   int               tapcnt        = 0;
-  uint64_t          elapsedTime   = 0;
   uint64_t          endTime       = 0;
   struct   timespec ts;
 
@@ -388,86 +426,11 @@ int TapClass::write(ST_TAP_ACCEL* accelData)
   detectflg = detect(accelData->accel_x, accelData->accel_y, accelData->accel_z);
 
   /* State determination */
-  
-  switch (mState){
-  case E_TAP_STATE_IDLE:
-    if(true == detectflg)
-      {
-
-        /* Detect Tap */
-
-        mTapCnt++;
-
-        /* Transition to tap state */
 
-        mState = E_TAP_STATE_TAP;
-
-        /* Time update */
-
-        mStartTime = endTime;
-      }
-    else
-      {
-
-        /* Notify number of taps */
-
-        tapcnt = mTapCnt;
-        mTapCnt = 0;
-      }
-    break;
-
-  case E_TAP_STATE_TAP:
-    
-    /* Calculate the time difference (Unit: microseconds) */
-
-    elapsedTime = endTime - mStartTime;
-    if (true == detectflg)
-      {
-
-        /* Detect Tap */
-
-        if (elapsedTime > mTapPeriod)
-          {
-
-            /* Notify the number of previous taps once and update it to 1 */
-
-            tapcnt = mTapCnt;
-            mTapCnt = 1;
-
-            /* Time update */
-
-            mStartTime = endTime;
-          } 
-        else
-          {
-
-            /* In time */
-            
-            mTapCnt++;
-
-            /* Time update */
-            
-            mStartTime = endTime;
-          }
-      }
-    else
-      {
-        if (elapsedTime > mTapPeriod)
-          {
-        
-            /* TimeOut */
-
-            tapcnt  = mTapCnt;
-            mTapCnt = 0;
-            mState  = E_TAP_STATE_IDLE;
-          }
-      }
-    break;
-  default:
-    break;
-  }
+  tapcnt = judge(detectflg, endTime);
 
   /* Return number of taps */
+
   return tapcnt;
 }
 
@@ -495,7 +458,6 @@ int TapClass::write(ST_TAP_ACCEL *accelData, uint64_t time_stamp)
 {
   bool detectflg         = false;
   int tapcnt             = 0;
-  uint64_t elapsedTime   = 0;
   uint64_t endTime       = time_stamp;
 
   _info("accel_x %.3f accel_y %.3f accel_z %.3f timestamp %llu \n",
@@ -515,7 +477,136 @@ int TapClass::write(ST_TAP_ACCEL *accelData, uint64_t time_stamp)
   detectflg = detect(accelData->accel_x, accelData->accel_y, accelData->accel_z);
 
   /* State determination */
-  
+
+  tapcnt = judge(detectflg, endTime);
+
+  return tapcnt;
+}
+
+/****************************************************************************
+ * Name: write
+ *
+ * Description:
+ *   Detect tap in a block of accel data, e.g. a FIFO batch from SCU.
+ *   The result is same as calling write(ST_TAP_ACCEL*, uint64_t) for
+ *   each sample with time_stamp + interval * n, and the tap counts which
+ *   are not 0 are stored to events with the time stamp.
+ *
+ * Input Parameters:
+ *   ST_TAP_ACCEL*       Accel Data(x,y,z) of num samples
+ *   num                 Number of samples
+ *   time_stamp          Time stamp of the first sample
+ *   interval            Sampling interval(microsec)
+ *   ST_TAP_EVENT*       Detected tap events(num entries at most)
+ *
+ * Returned Value:
+ *   D_SA_STATUS_E_INVALID_ARGS   Parameter error
+ *   event number                 number of detected tap events
+ *
+ * Assumptions/Limitations:
+ *   -
+ *
+ ****************************************************************************/
+int TapClass::write(ST_TAP_ACCEL *accelData,
+                    int num,
+                    uint64_t time_stamp,
+                    uint32_t interval,
+                    ST_TAP_EVENT *events)
+{
+  uint64_t endTime = time_stamp;
+  int      event_num = 0;
+
+  if ((NULL == accelData) || (NULL == events) || (num < 0))
+    {
+      _err("accelData or events is NULL, or num(%d) is invalid\n", num);
+      return D_SA_STATUS_E_INVALID_ARGS;
+    }
+
+  for (int i = 0; i < num; i++, endTime += interval)
+    {
+      float x = accelData[i].accel_x;
+      float y = accelData[i].accel_y;
+      float z = accelData[i].accel_z;
+
+      /* sqrt is not necessary, the squared magnitude is compared with
+       * squared thresholds.
+       */
+
+      bool detectflg = detect(x, y, z, x * x + y * y + z * z);
+      int  tapcnt = judge(detectflg, endTime);
+
+      if (tapcnt > 0)
+        {
+          events[event_num].tap_cnt    = tapcnt;
+          events[event_num].time_stamp = endTime;
+          event_num++;
+        }
+    }
+
+  return event_num;
+}
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+/****************************************************************************
+ * Name: squareThres
+ *
+ * Description:
+ *   Get the threshold to compare squared value with.
+ *   It is the minimum value whose sqrt is larger than thres, so that
+ *   "r2 >= squareThres(thres)" gives exactly same result as
+ *   "sqrt(r2) > thres" in float.
+ *
+ * Input Parameters:
+ *   thres   - threshold (0 or larger)
+ *
+ * Returned Value:
+ *   Squared threshold.
+ *
+ * Assumptions/Limitations:
+ *   -
+ *
+ ****************************************************************************/
+static float squareThres(float thres)
+{
+  float t = thres * thres;
+
+  while ((t > 0.0F) && (sqrtf(nextafterf(t, 0.0F)) > thres))
+    {
+      t = nextafterf(t, 0.0F);
+    }
+
+  while (sqrtf(t) <= thres)
+    {
+      t = nextafterf(t, INFINITY);
+    }
+
+  return t;
+}
+
+/****************************************************************************
+ * Name: judge
+ *
+ * Description:
+ *   Update the tap state by the detection result of a sample.
+ *
+ * Input Parameters:
+ *   detectflg   - detection result of the sample
+ *   endTime     - time of the sample(microsec)
+ *
+ * Returned Value:
+ *   Number of taps to notify, or 0.
+ *
+ * Assumptions/Limitations:
+ *   -
+ *
+ ****************************************************************************/
+int TapClass::judge(bool detectflg, uint64_t endTime)
+{
+  int      tapcnt      = 0;
+  uint64_t elapsedTime = 0;
+
   switch (mState){
   case E_TAP_STATE_IDLE:
     if (true == detectflg)
@@ -526,11 +617,11 @@ int TapClass::write(ST_TAP_ACCEL *accelData, uint64_t time_stamp)
         mTapCnt++;
 
         /* Transition to tap state */
-        
+
         mState = E_TAP_STATE_TAP;
-        
+
         /* Time update */
-        
+
         mStartTime = endTime;
       }
     else
@@ -544,7 +635,7 @@ int TapClass::write(ST_TAP_ACCEL *accelData, uint64_t time_stamp)
     break;
 
   case E_TAP_STATE_TAP:
-    
+
     /* Calculate the time difference (Unit: microseconds) */
 
     elapsedTime = endTime - mStartTime;
@@ -564,16 +655,16 @@ int TapClass::write(ST_TAP_ACCEL *accelData, uint64_t time_stamp)
             /* Time update */
 
             mStartTime = endTime;
-          } 
+          }
         else
           {
 
             /* In time */
-            
+
             mTapCnt++;
 
             /* Time update */
-            
+
             mStartTime = endTime;
           }
       }
@@ -581,7 +672,7 @@ int TapClass::write(ST_TAP_ACCEL *accelData, uint64_t time_stamp)
       {
         if (elapsedTime > mTapPeriod)
           {
-        
+
             /* TimeOut */
 
             tapcnt  = mTapCnt;
@@ -598,35 +689,31 @@ int TapClass::write(ST_TAP_ACCEL *accelData, uint64_t time_stamp)
 }
 
 /****************************************************************************
- * Private Functions
- ****************************************************************************/
-/****************************************************************************
- * Name: calcR
+ * Name: calcR2
  *
  * Description:
- *   
+ *   Squared distance between two samples.
  *
  * Input Parameters:
  *   i0   - 0
  *   j0   - detection count
  *
  * Returned Value:
- *   Sqrt Result.
+ *   Squared distance.
  *
  * Assumptions/Limitations:
  *   -
  *
  ****************************************************************************/
-float TapClass::calcR(int i0, int j0)
+float TapClass::calcR2(int i0, int j0)
 {
   int i    = getIndex(i0);
   int j    = getIndex(j0);
   float dx = mX[i] - mX[j];
   float dy = mY[i] - mY[j];
   float dz = mY[i] - mY[j];
-  float r  = sqrt(dx * dx + dy * dy + dz * dz);
 
-  return r;
+  return dx * dx + dy * dy + dz * dz;
 }
 
 /****************************************************************************
@@ -649,6 +736,32 @@ float TapClass::calcR(int i0, int j0)
  *
  ****************************************************************************/
 bool TapClass::detect(float x, float y, float z)
+{
+  return detect(x, y, z, x * x + y * y + z * z);
+}
+
+/****************************************************************************
+ * Name: detect
+ *
+ * Description:
+ *   It judges whether it detects tap with the squared magnitude
+ *   calculated already.
+ *
+ * Input Parameters:
+ *   x   - accel data(x)
+ *   y   - accel data(y)
+ *   z   - accel data(z)
+ *   r2  - squared magnitude of accel data
+ *
+ * Returned Value:
+ *   true   - detect tap
+ *   false  - not detect tap
+ *
+ * Assumptions/Limitations:
+ *   -
+ *
+ ****************************************************************************/
+bool TapClass::detect(float x, float y, float z, float r2)
 {
 
   int index = mIndex;
@@ -660,11 +773,11 @@ bool TapClass::detect(float x, float y, float z)
   mX[index] = x;
   mY[index] = y;
   mZ[index] = z;
-  mR[index] = sqrt(x * x + y * y + z * z);
+  mR[index] = r2;
 
   if (mDetectionCount == 0)
     {
-      if (mR[index] > mPeakThres)
+      if (mR[index] >= mPeakThres2)
         {
           mDetectionCount = TAP_DETECTION_COUNT;
         }
@@ -672,12 +785,12 @@ bool TapClass::detect(float x, float y, float z)
     }
 
   mDetectionCount--;
-  if (mR[index] > mPeakThres)
+  if (mR[index] >= mPeakThres2)
     {
       return false;
     }
 
-  if (calcR(0, TAP_DETECTION_COUNT - mDetectionCount) > mLongThres)
+  if (calcR2(0, TAP_DETECTION_COUNT - mDetectionCount) >= mLongThres2)
     {
       mStab = 0;
       return false;
@@ -707,7 +820,7 @@ bool TapClass::detect(float x, float y, float z)
  *   -
  *
  ****************************************************************************/
-float TapClass::getIndex(int idx)
+int TapClass::getIndex(int idx)
 {
   int i = mIndex - idx - 1;
 
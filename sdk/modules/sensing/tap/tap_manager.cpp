@@ -127,12 +127,8 @@ struct tap_mng_acc_data_buf
 {
   struct    tap_mng_three_axis_s acc_data[(TAP_MNG_ACC_SAMPLING_FREQ * TAP_MNG_FIFO_NUM)];
   uint64_t  time_stamp;
-};
-
-struct tap_mng_inlibdata
-{
-  ST_TAP_ACCEL  accel;
-  uint64_t      timestamp;
+  ST_TAP_ACCEL  accel[(TAP_MNG_ACC_SAMPLING_FREQ * TAP_MNG_FIFO_NUM)];
+  ST_TAP_EVENT  events[(TAP_MNG_ACC_SAMPLING_FREQ * TAP_MNG_FIFO_NUM)];
 };
 
 static sem_t                 g_tap_mng_node_lock;
@@ -254,14 +250,15 @@ static void TapMngTapLibRun(void)
 {
   struct tap_mng_node         *p_node      = NULL;
   int                         fd           = -1;
-  int                         tapCnt       = 0;
+  int                         evcnt        = 0;
   int                         icnt         = 0;
+  int                         run          = 0;
   int                         ret          = 0;
   int                         rsize        = 0;
   int                         acc_data_num = 0;
   struct tap_mng_acc_data_buf *data        = NULL;
   struct tap_mng_three_axis_s *ta          = NULL;
-  struct tap_mng_inlibdata    indata       = {0};
+  uint64_t                    timestamp    = 0;
   sigset_t                    set          = {0};
   struct siginfo              siginfo      = {0};
   struct timespec             ts           = {0};
@@ -355,40 +352,62 @@ static void TapMngTapLibRun(void)
           data->time_stamp = (ts.tv_sec * SEC_PER_US) + (ts.tv_nsec / NS_PER_US);
 
           ta = (struct tap_mng_three_axis_s *)&data->acc_data;
-          for (icnt = 0; icnt < acc_data_num; icnt++, ta++)
+          for (icnt = 0; icnt < acc_data_num; icnt += run)
             {
-              if (ta->x && ta->y && ta->z)
+              /* Convert the continuous valid samples, and pass them to
+               * the tap library at once. A sample which has 0 is skipped.
+               */
+
+              for (run = 0; (icnt + run) < acc_data_num; run++)
                 {
-                  memset(&indata, 0, sizeof(struct tap_mng_inlibdata));
-                  indata.accel.accel_x = TAP_MNG_ACCEL_CONVERT(ta->x);
-                  indata.accel.accel_y = TAP_MNG_ACCEL_CONVERT(ta->y);
-                  indata.accel.accel_z = TAP_MNG_ACCEL_CONVERT(ta->z);
+                  if (!(ta[icnt + run].x && ta[icnt + run].y &&
+                        ta[icnt + run].z))
+                    {
+                      break;
+                    }
 
-                  indata.timestamp = data->time_stamp - (1000000 / TAP_MNG_ACC_SAMPLING_FREQ) * (acc_data_num - icnt + 1);
+                  data->accel[run].accel_x =
+                    TAP_MNG_ACCEL_CONVERT(ta[icnt + run].x);
+                  data->accel[run].accel_y =
+                    TAP_MNG_ACCEL_CONVERT(ta[icnt + run].y);
+                  data->accel[run].accel_z =
+                    TAP_MNG_ACCEL_CONVERT(ta[icnt + run].z);
+                }
 
-                  TAP_MNG_NODE_LOCK();
+              if (run == 0)
+                {
+                  run = 1;
+                  continue;
+                }
 
-                  if (NULL == g_head)
-                    {
-                      _err("L%d g_head is NULL \n", __LINE__);
-                      TAP_MNG_NODE_UNLOCK();
-                      continue;
-                    }
+              timestamp = data->time_stamp - (1000000 / TAP_MNG_ACC_SAMPLING_FREQ) * (acc_data_num - icnt + 1);
 
-                  p_node = g_head;
-                  do
-                    {
-                      /* Tap Library call */
-                      tapCnt = TapWrite_timestamp(p_node->tap, &indata.accel, indata.timestamp);
-                      if (tapCnt > 0)
-                        {
-                          p_node->cbs(tapCnt);
-                        }
-                      p_node = p_node->next;
-                    } while (NULL != p_node);
+              TAP_MNG_NODE_LOCK();
 
+              if (NULL == g_head)
+                {
+                  _err("L%d g_head is NULL \n", __LINE__);
                   TAP_MNG_NODE_UNLOCK();
+                  continue;
                 }
+
+              p_node = g_head;
+              do
+                {
+                  /* Tap Library call */
+
+                  evcnt = TapWrite_block(p_node->tap, data->accel, run,
+                                         timestamp,
+                                         1000000 / TAP_MNG_ACC_SAMPLING_FREQ,
+                                         data->events);
+                  for (int i = 0; i < evcnt; i++)
+                    {
+                      p_node->cbs(data->events[i].tap_cnt);
+                    }
+                  p_node = p_node->next;
+                } while (NULL != p_node);
+
+              TAP_MNG_NODE_UNLOCK();
             }
         }
       /* receive signal from tap manager api */
@@ -0,0 +1,603 @@
+/****************************************************************************
+ * modules/sensing/tap/tool/host/tap_bench.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/* Replay test and benchmark of the tap detection on the host.
+ *
+ * Accel traces are given by CSV files, one sample per line as
+ * "time_us,x,y,z" or "x,y,z" in G. Samples are cut to FIFO batches and
+ * the time stamp of the n-th sample of a batch is the one of the first
+ * sample + n / rate, same as tap_manager. Each trace is processed by the
+ * former sqrt based detection, TapClass::write() for each sample, and the
+ * block TapClass::write() for each batch, and the detected tap events
+ * must be identical. Then CPU time per second of data is measured.
+ *
+ * Without files, a synthetic trace with taps and samples just on the
+ * thresholds is used. "tap_bench -t" runs only the test. "-b" gives the
+ * batch size for both, otherwise the test runs several batch sizes and
+ * the bench uses the watermark of tap_manager.
+ *
+ *   tap_bench [-t] [-r rate] [-b batch] [file.csv ...]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <vector>
+
+#include "sensing/tap.h"
+#include "tap_reference.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define DEFAULT_RATE      64      /* Hz, same as tap_manager */
+#define DEFAULT_BATCH     4       /* Samples, watermark of tap_manager */
+#define SYNTH_SEC         600
+#define BENCH_MIN_SEC     0.1     /* Minimum time of a round */
+#define BENCH_ROUNDS      5       /* The fastest round is taken */
+
+#define CHECK(cond) \
+  do \
+    { \
+      if (!(cond)) \
+        { \
+          printf("  NG: %s (line %d)\n", #cond, __LINE__); \
+          return 1; \
+        } \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct Trace
+{
+  std::vector<ST_TAP_ACCEL> accel;
+  std::vector<uint64_t>     time;   /* Empty if the trace has no time */
+};
+
+struct Event
+{
+  int      tap_cnt;
+  uint64_t time_stamp;
+
+  bool operator==(const Event &e) const
+  {
+    return (tap_cnt == e.tap_cnt) && (time_stamp == e.time_stamp);
+  }
+};
+
+typedef std::vector<Event> Events;
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const ST_TAP_OPEN s_param =
+{
+  500000.0F,  /* tap_period */
+  1.5F,       /* peak_thres */
+  0.5F,       /* long_thres */
+  1           /* stab_frame */
+};
+
+static const int s_batches[] = { 1, 4, 7, 16, 64, 128 };
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static float frand(float min, float max)
+{
+  return min + (max - min) * (float)rand() / (float)RAND_MAX;
+}
+
+/*--------------------------------------------------------------------------*/
+static ST_TAP_ACCEL make_accel(float x, float y, float z)
+{
+  ST_TAP_ACCEL accel;
+
+  accel.accel_x = x;
+  accel.accel_y = y;
+  accel.accel_z = z;
+
+  return accel;
+}
+
+/*--------------------------------------------------------------------------*/
+static Trace make_synthetic(int rate, int sec)
+{
+  Trace trace;
+  int   samples = rate * sec;
+  int   next_tap = rate;
+
+  for (int i = 0; i < samples; i++)
+    {
+      if (i == next_tap)
+        {
+          /* Single, double or triple tap, 0.2s apart. */
+
+          int taps = 1 + rand() % 3;
+
+          for (int t = 0; t < taps && i < samples; t++)
+            {
+              trace.accel.push_back(make_accel(frand(-0.5F, 0.5F),
+                                               frand(-0.5F, 0.5F),
+                                               frand(1.8F, 3.0F)));
+              i++;
+
+              for (int k = 1; k < rate / 5 && i < samples; k++, i++)
+                {
+                  trace.accel.push_back(make_accel(frand(-0.02F, 0.02F),
+                                                   frand(-0.02F, 0.02F),
+                                                   frand(0.98F, 1.02F)));
+                }
+            }
+
+          next_tap = i + rate + rand() % (rate * 2);
+          i--;
+          continue;
+        }
+
+      switch (rand() % 64)
+        {
+          case 0:
+            {
+              /* Magnitude just on the peak threshold, to check that
+               * the squared comparison gives the same result as sqrt.
+               */
+
+              float p = s_param.peak_thres;
+              float s = nextafterf(p, (rand() & 1) ? 0.0F : INFINITY);
+
+              trace.accel.push_back(make_accel(0.0F, 0.0F, s));
+            }
+            break;
+
+          case 1:
+            {
+              /* Jump of about the long threshold from the previous. */
+
+              ST_TAP_ACCEL prev = trace.accel.empty() ?
+                                  make_accel(0.0F, 0.0F, 1.0F) :
+                                  trace.accel.back();
+              float d = s_param.long_thres * frand(0.5F, 0.8F);
+
+              trace.accel.push_back(make_accel(prev.accel_x + d,
+                                               prev.accel_y,
+                                               prev.accel_z));
+            }
+            break;
+
+          default:
+            trace.accel.push_back(make_accel(frand(-0.05F, 0.05F),
+                                             frand(-0.05F, 0.05F),
+                                             frand(0.9F, 1.1F)));
+            break;
+        }
+    }
+
+  return trace;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool load_csv(const char *path, Trace *trace)
+{
+  FILE *fp = fopen(path, "r");
+  char  line[256];
+
+  if (fp == NULL)
+    {
+      printf("  cannot open %s\n", path);
+      return false;
+    }
+
+  while (fgets(line, sizeof(line), fp) != NULL)
+    {
+      double v[4];
+      int    n = sscanf(line, "%lf,%lf,%lf,%lf", &v[0], &v[1], &v[2], &v[3]);
+
+      /* Comment or header line */
+
+      if (n < 3)
+        {
+          continue;
+        }
+
+      if (n == 4)
+        {
+          trace->time.push_back((uint64_t)v[0]);
+          trace->accel.push_back(make_accel(v[1], v[2], v[3]));
+        }
+      else
+        {
+          trace->accel.push_back(make_accel(v[0], v[1], v[2]));
+        }
+    }
+
+  fclose(fp);
+
+  if (!trace->time.empty() && trace->time.size() != trace->accel.size())
+    {
+      printf("  %s: some lines have no time\n", path);
+      return false;
+    }
+
+  return !trace->accel.empty();
+}
+
+/*--------------------------------------------------------------------------*/
+static uint64_t batch_time(const Trace &trace, size_t top, uint32_t interval)
+{
+  return trace.time.empty() ? (uint64_t)top * interval : trace.time[top];
+}
+
+/*--------------------------------------------------------------------------*/
+static Events run_reference(const Trace &trace, int rate, int batch)
+{
+  TapReference tap(s_param);
+  Events       events;
+  uint32_t     interval = 1000000 / rate;
+
+  for (size_t top = 0; top < trace.accel.size(); top += batch)
+    {
+      uint64_t time = batch_time(trace, top, interval);
+
+      for (size_t i = top; i < top + batch && i < trace.accel.size(); i++)
+        {
+          uint64_t ts = time + (uint64_t)interval * (i - top);
+          int      cnt = tap.write(trace.accel[i], ts);
+
+          if (cnt > 0)
+            {
+              Event e = { cnt, ts };
+              events.push_back(e);
+            }
+        }
+    }
+
+  return events;
+}
+
+/*--------------------------------------------------------------------------*/
+static Events run_sample(const Trace &trace, int rate, int batch)
+{
+  TapClass     tap;
+  ST_TAP_OPEN  param = s_param;
+  Events       events;
+  uint32_t     interval = 1000000 / rate;
+
+  tap.open(&param);
+
+  for (size_t top = 0; top < trace.accel.size(); top += batch)
+    {
+      uint64_t time = batch_time(trace, top, interval);
+
+      for (size_t i = top; i < top + batch && i < trace.accel.size(); i++)
+        {
+          ST_TAP_ACCEL accel = trace.accel[i];
+          uint64_t     ts = time + (uint64_t)interval * (i - top);
+          int          cnt = tap.write(&accel, ts);
+
+          if (cnt > 0)
+            {
+              Event e = { cnt, ts };
+              events.push_back(e);
+            }
+        }
+    }
+
+  tap.close();
+
+  return events;
+}
+
+/*--------------------------------------------------------------------------*/
+static Events run_block(const Trace &trace, int rate, int batch)
+{
+  TapClass                  tap;
+  ST_TAP_OPEN               param = s_param;
+  Events                    events;
+  uint32_t                  interval = 1000000 / rate;
+  std::vector<ST_TAP_ACCEL> accel(batch);
+  std::vector<ST_TAP_EVENT> ev(batch);
+
+  tap.open(&param);
+
+  for (size_t top = 0; top < trace.accel.size(); top += batch)
+    {
+      int num = (int)std::min((size_t)batch, trace.accel.size() - top);
+
+      memcpy(&accel[0], &trace.accel[top], sizeof(ST_TAP_ACCEL) * num);
+
+      int evnum = tap.write(&accel[0], num, batch_time(trace, top, interval),
+                            interval, &ev[0]);
+
+      for (int i = 0; i < evnum; i++)
+        {
+          Event e = { ev[i].tap_cnt, ev[i].time_stamp };
+          events.push_back(e);
+        }
+    }
+
+  tap.close();
+
+  return events;
+}
+
+/*--------------------------------------------------------------------------*/
+static int compare(const Trace &trace, int rate, int batch, size_t *taps)
+{
+  Events ref    = run_reference(trace, rate, batch);
+  Events sample = run_sample(trace, rate, batch);
+  Events block  = run_block(trace, rate, batch);
+
+  printf("  batch %3d: %zu events (reference %zu, sample %zu)\n",
+         batch, block.size(), ref.size(), sample.size());
+
+  CHECK(sample == ref);
+  CHECK(block == ref);
+
+  *taps = 0;
+  for (size_t i = 0; i < ref.size(); i++)
+    {
+      *taps += ref[i].tap_cnt;
+    }
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_args(void)
+{
+  TapClass     tap;
+  ST_TAP_OPEN  param = s_param;
+  ST_TAP_ACCEL accel = make_accel(0.0F, 0.0F, 1.0F);
+  ST_TAP_EVENT ev;
+
+  printf("arguments:\n");
+
+  CHECK(tap.open(&param) == D_SA_STATUS_OK);
+  CHECK(tap.write(NULL, 1, 0, 15625, &ev) == D_SA_STATUS_E_INVALID_ARGS);
+  CHECK(tap.write(&accel, 1, 0, 15625, NULL) == D_SA_STATUS_E_INVALID_ARGS);
+  CHECK(tap.write(&accel, -1, 0, 15625, &ev) == D_SA_STATUS_E_INVALID_ARGS);
+  CHECK(tap.write(&accel, 0, 0, 15625, &ev) == 0);
+  CHECK(TapWrite_block(&tap, &accel, 1, 0, 15625, &ev) == 0);
+
+  printf("  OK\n");
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int test_trace(const char *name,
+                      const Trace &trace,
+                      int rate,
+                      int batch,
+                      size_t *taps)
+{
+  printf("%s (%zu samples, %d Hz):\n", name, trace.accel.size(), rate);
+
+  if (batch > 0)
+    {
+      return compare(trace, rate, batch, taps);
+    }
+
+  for (size_t i = 0; i < sizeof(s_batches) / sizeof(s_batches[0]); i++)
+    {
+      if (compare(trace, rate, s_batches[i], taps))
+        {
+          return 1;
+        }
+    }
+
+  printf("  %zu taps detected\n", *taps);
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static double now_sec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/*--------------------------------------------------------------------------*/
+template<typename F> static double measure(const Trace &trace,
+                                           int rate,
+                                           int batch,
+                                           F run)
+{
+  double best = 0.0;
+
+  for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+      double start = now_sec();
+      double elapsed;
+      int    loop = 0;
+
+      do
+        {
+          run(trace, rate, batch);
+          loop++;
+          elapsed = now_sec() - start;
+        }
+      while (elapsed < BENCH_MIN_SEC);
+
+      if (round == 0 || elapsed / loop < best)
+        {
+          best = elapsed / loop;
+        }
+    }
+
+  /* CPU time per second of data */
+
+  return best / ((double)trace.accel.size() / rate);
+}
+
+/*--------------------------------------------------------------------------*/
+static void bench(const char *name, const Trace &trace, int rate, int batch)
+{
+  batch = (batch > 0) ? batch : DEFAULT_BATCH;
+
+  printf("bench %s (batch %d, CPU time per second of data):\n",
+         name, batch);
+  printf("  reference %7.3f us, sample %7.3f us, block %7.3f us\n",
+         measure(trace, rate, batch, run_reference) * 1e6,
+         measure(trace, rate, batch, run_sample) * 1e6,
+         measure(trace, rate, batch, run_block) * 1e6);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  bool test_only = false;
+  int  rate = DEFAULT_RATE;
+  int  batch = 0;
+  int  i;
+
+  for (i = 1; i < argc && argv[i][0] == '-'; i++)
+    {
+      if (strcmp(argv[i], "-t") == 0)
+        {
+          test_only = true;
+        }
+      else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+        {
+          rate = atoi(argv[++i]);
+        }
+      else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+        {
+          batch = atoi(argv[++i]);
+        }
+      else
+        {
+          printf("usage: %s [-t] [-r rate] [-b batch] [file.csv ...]\n",
+                 argv[0]);
+          return 1;
+        }
+    }
+
+  if (rate <= 0 || rate > 1000000 || batch < 0)
+    {
+      printf("invalid rate or batch\n");
+      return 1;
+    }
+
+  srand(1);
+
+  if (test_args())
+    {
+      printf("Test NG\n");
+      return 1;
+    }
+
+  std::vector<const char *> names;
+  std::vector<Trace>        traces;
+  std::vector<int>          rates;
+  bool                      synthetic = (i == argc);
+
+  if (synthetic)
+    {
+      /* Production rate, and 10 times of it. */
+
+      names.push_back("synthetic");
+      traces.push_back(make_synthetic(rate, SYNTH_SEC));
+      rates.push_back(rate);
+
+      names.push_back("synthetic x10");
+      traces.push_back(make_synthetic(rate * 10, SYNTH_SEC / 10));
+      rates.push_back(rate * 10);
+    }
+
+  for (; i < argc; i++)
+    {
+      Trace trace;
+
+      if (!load_csv(argv[i], &trace))
+        {
+          printf("Test NG\n");
+          return 1;
+        }
+
+      names.push_back(argv[i]);
+      traces.push_back(trace);
+      rates.push_back(rate);
+    }
+
+  for (size_t t = 0; t < traces.size(); t++)
+    {
+      size_t taps = 0;
+
+      if (test_trace(names[t], traces[t], rates[t], batch, &taps))
+        {
+          printf("Test NG\n");
+          return 1;
+        }
+
+      /* Synthetic trace has taps surely. */
+
+      if (synthetic && taps == 0)
+        {
+          printf("  NG: no tap detected\n");
+          printf("Test NG\n");
+          return 1;
+        }
+    }
+
+  printf("All tests OK\n");
+
+  if (!test_only)
+    {
+      for (size_t t = 0; t < traces.size(); t++)
+        {
+          bench(names[t], traces[t], rates[t], batch);
+        }
+    }
+
+  return 0;
+}
@@ -0,0 +1,193 @@
+/****************************************************************************
+ * modules/sensing/tap/tool/host/tap_reference.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/* Former tap detection of TapClass, which calculates sqrt of every sample
+ * and compares the magnitudes with the thresholds.
+ * This is kept only as the reference of tap_bench.
+ */
+
+#include <math.h>
+
+#include "tap_reference.h"
+
+#define TAP_DETECTION_COUNT 8
+
+/*--------------------------------------------------------------------------*/
+TapReference::TapReference(const ST_TAP_OPEN &param)
+{
+  mTapPeriod      = param.tap_period;
+  mPeakThres      = param.peak_thres;
+  mLongThres      = param.long_thres;
+  mStabFrame      = param.stab_frame;
+  mTapCnt         = 0;
+  mState          = E_TAP_STATE_IDLE;
+
+  for (int i = 0; i < TAP_BUF_LEN; i++)
+    {
+      mX[i] = 0;
+      mY[i] = 0;
+      mZ[i] = 0;
+      mR[i] = 0;
+    }
+
+  mIndex          = 0;
+  mDetectionCount = 0;
+  mStab           = 0;
+  mStartTime      = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+int TapReference::write(const ST_TAP_ACCEL &accel, uint64_t time_stamp)
+{
+  int tapcnt           = 0;
+  uint64_t elapsedTime = 0;
+  uint64_t endTime     = time_stamp;
+  bool detectflg       = detect(accel.accel_x, accel.accel_y, accel.accel_z);
+
+  switch (mState)
+    {
+      case E_TAP_STATE_IDLE:
+        if (detectflg)
+          {
+            mTapCnt++;
+            mState = E_TAP_STATE_TAP;
+            mStartTime = endTime;
+          }
+        else
+          {
+            tapcnt = mTapCnt;
+            mTapCnt = 0;
+          }
+        break;
+
+      case E_TAP_STATE_TAP:
+        elapsedTime = endTime - mStartTime;
+        if (detectflg)
+          {
+            if (elapsedTime > mTapPeriod)
+              {
+                tapcnt = mTapCnt;
+                mTapCnt = 1;
+              }
+            else
+              {
+                mTapCnt++;
+              }
+            mStartTime = endTime;
+          }
+        else if (elapsedTime > mTapPeriod)
+          {
+            tapcnt  = mTapCnt;
+            mTapCnt = 0;
+            mState  = E_TAP_STATE_IDLE;
+          }
+        break;
+
+      default:
+        break;
+    }
+
+  return tapcnt;
+}
+
+/*--------------------------------------------------------------------------*/
+float TapReference::calcR(int i0, int j0)
+{
+  int i    = getIndex(i0);
+  int j    = getIndex(j0);
+  float dx = mX[i] - mX[j];
+  float dy = mY[i] - mY[j];
+  float dz = mY[i] - mY[j];
+  float r  = sqrt(dx * dx + dy * dy + dz * dz);
+
+  return r;
+}
+
+/*--------------------------------------------------------------------------*/
+bool TapReference::detect(float x, float y, float z)
+{
+  int index = mIndex;
+  if (++mIndex == TAP_BUF_LEN)
+    {
+      mIndex = 0;
+    }
+
+  mX[index] = x;
+  mY[index] = y;
+  mZ[index] = z;
+  mR[index] = sqrt(x * x + y * y + z * z);
+
+  if (mDetectionCount == 0)
+    {
+      if (mR[index] > mPeakThres)
+        {
+          mDetectionCount = TAP_DETECTION_COUNT;
+        }
+      return false;
+    }
+
+  mDetectionCount--;
+  if (mR[index] > mPeakThres)
+    {
+      return false;
+    }
+
+  if (calcR(0, TAP_DETECTION_COUNT - mDetectionCount) > mLongThres)
+    {
+      mStab = 0;
+      return false;
+    }
+  if (++mStab <= mStabFrame)
+    {
+      return false;
+    }
+
+  mDetectionCount = 0;
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+float TapReference::getIndex(int idx)
+{
+  int i = mIndex - idx - 1;
+
+  if (i < 0)
+    {
+      i += TAP_BUF_LEN;
+    }
+
+  return i;
+}
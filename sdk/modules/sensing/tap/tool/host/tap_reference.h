@@ -0,0 +1,79 @@
+/****************************************************************************
+ * modules/sensing/tap/tool/host/tap_reference.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#ifndef __SENSING_TAP_TOOL_HOST_TAP_REFERENCE_H
+#define __SENSING_TAP_TOOL_HOST_TAP_REFERENCE_H
+
+#include <stdint.h>
+
+#include "sensing/tap.h"
+
+/* Former tap detection, which calculates sqrt of every sample.
+ * This is kept only as the reference of tap_bench.
+ */
+
+class TapReference
+{
+public:
+  TapReference(const ST_TAP_OPEN &param);
+
+  int write(const ST_TAP_ACCEL &accel, uint64_t time_stamp);
+
+private:
+  uint64_t     mTapPeriod;
+  float        mPeakThres;
+  float        mLongThres;
+  int          mStabFrame;
+
+  int          mTapCnt;
+  E_TAP_STATE  mState;
+
+  float        mR[TAP_BUF_LEN];
+  float        mX[TAP_BUF_LEN];
+  float        mY[TAP_BUF_LEN];
+  float        mZ[TAP_BUF_LEN];
+
+  int          mIndex;
+  int          mDetectionCount;
+  int          mStab;
+  uint64_t     mStartTime;
+
+  float calcR(int i0, int j0);
+  bool detect(float x, float y, float z);
+  float getIndex(int idx);
+};
+
+#endif /* __SENSING_TAP_TOOL_HOST_TAP_REFERENCE_H */
@@ -0,0 +1,69 @@
+/****************************************************************************
+ * modules/sensing/tool/host/asmp/mpmq.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host replacement of <asmp/mpmq.h>, implemented in host_asmp.cpp.
+ * The supervisor and the worker of a key share one pair of queues in
+ * the process.
+ */
+
+#ifndef __SENSING_TOOL_HOST_ASMP_MPMQ_H
+#define __SENSING_TOOL_HOST_ASMP_MPMQ_H
+
+#include <sys/types.h>
+#include <stdint.h>
+
+typedef int cpuid_t;
+
+typedef struct mpmq
+{
+  key_t    key;     /* Unique object ID */
+  cpuid_t  cpuid;   /* Target CPU ID */
+} mpmq_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+int mpmq_init(mpmq_t *mq, key_t key, cpuid_t cpuid);
+int mpmq_destroy(mpmq_t *mq);
+int mpmq_send(mpmq_t *mq, int8_t msgid, uint32_t data);
+int mpmq_receive(mpmq_t *mq, uint32_t *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSING_TOOL_HOST_ASMP_MPMQ_H */
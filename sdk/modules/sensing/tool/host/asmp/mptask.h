@@ -0,0 +1,72 @@
+/****************************************************************************
+ * modules/sensing/tool/host/asmp/mptask.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host replacement of <asmp/mptask.h>, implemented in host_asmp.cpp.
+ * A worker is a thread of the function registered for the file name
+ * by host_mptask_register().
+ */
+
+#ifndef __SENSING_TOOL_HOST_ASMP_MPTASK_H
+#define __SENSING_TOOL_HOST_ASMP_MPTASK_H
+
+#include <pthread.h>
+#include <stdbool.h>
+
+#include <asmp/mpmq.h>
+
+typedef struct mptask
+{
+  const char *filename;   /* Name of the worker */
+  cpuid_t     cpuid;      /* Assigned CPU ID */
+  pthread_t   thread;     /* Worker thread */
+  bool        running;    /* Worker thread is running */
+} mptask_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+int mptask_init_secure(mptask_t *task, const char *filename);
+int mptask_assign(mptask_t *task);
+cpuid_t mptask_getcpuid(mptask_t *task);
+int mptask_exec(mptask_t *task);
+int mptask_destroy(mptask_t *task, bool force, int *exitcode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSING_TOOL_HOST_ASMP_MPTASK_H */
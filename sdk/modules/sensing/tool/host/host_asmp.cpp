@@ -0,0 +1,384 @@
+/****************************************************************************
+ * modules/sensing/tool/host/host_asmp.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* In-process emulation of mptask/mpmq for the sensing replay.
+ *
+ * Each key has two queues, supervisor to worker and worker to
+ * supervisor. A queue is a ring of messages under a mutex, and the
+ * number of messages is counted by a semaphore. Only the semaphore is
+ * waited, so a receiver can be cancelled safely by pthread_cancel()
+ * as StepCounterClass::close() does.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <string.h>
+
+#include "host_asmp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define HOST_ASMP_FIRST_CPUID  3
+#define HOST_ASMP_MSGID_STOP   (-1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct host_msg_s
+{
+  int8_t   msgid;
+  uint32_t data;
+};
+
+struct host_queue_s
+{
+  pthread_mutex_t   lock;
+  sem_t             count;
+  uint32_t          head;
+  uint32_t          num;
+  struct host_msg_s msg[HOST_ASMP_QUEUE_DEPTH];
+};
+
+struct host_channel_s
+{
+  bool                used;
+  cpuid_t             cpuid;
+  struct host_queue_s to_worker;
+  struct host_queue_s to_supervisor;
+};
+
+struct host_worker_s
+{
+  const char    *filename;
+  host_worker_t  entry;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct host_channel_s s_channel[HOST_ASMP_MAX_KEYS];
+static struct host_worker_s  s_worker[HOST_ASMP_MAX_WORKERS];
+static cpuid_t               s_next_cpuid = HOST_ASMP_FIRST_CPUID;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void queue_init(struct host_queue_s *que)
+{
+  pthread_mutex_init(&que->lock, NULL);
+  sem_init(&que->count, 0, 0);
+  que->head = 0;
+  que->num  = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static void queue_destroy(struct host_queue_s *que)
+{
+  sem_destroy(&que->count);
+  pthread_mutex_destroy(&que->lock);
+}
+
+/*--------------------------------------------------------------------------*/
+static int queue_send(struct host_queue_s *que, int8_t msgid, uint32_t data)
+{
+  pthread_mutex_lock(&que->lock);
+
+  if (que->num == HOST_ASMP_QUEUE_DEPTH)
+    {
+      pthread_mutex_unlock(&que->lock);
+      return -EAGAIN;
+    }
+
+  struct host_msg_s *msg =
+    &que->msg[(que->head + que->num) % HOST_ASMP_QUEUE_DEPTH];
+
+  msg->msgid = msgid;
+  msg->data  = data;
+  que->num++;
+
+  pthread_mutex_unlock(&que->lock);
+  sem_post(&que->count);
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+static int queue_receive(struct host_queue_s *que, uint32_t *data)
+{
+  while (sem_wait(&que->count) != 0)
+    {
+      if (errno != EINTR)
+        {
+          return -errno;
+        }
+    }
+
+  pthread_mutex_lock(&que->lock);
+
+  struct host_msg_s msg = que->msg[que->head];
+
+  que->head = (que->head + 1) % HOST_ASMP_QUEUE_DEPTH;
+  que->num--;
+
+  pthread_mutex_unlock(&que->lock);
+
+  *data = msg.data;
+  return msg.msgid;
+}
+
+/*--------------------------------------------------------------------------*/
+static struct host_channel_s *get_channel(key_t key)
+{
+  if ((key < 0) || (key >= HOST_ASMP_MAX_KEYS) || !s_channel[key].used)
+    {
+      return NULL;
+    }
+
+  return &s_channel[key];
+}
+
+/*--------------------------------------------------------------------------*/
+static void *worker_entry(void *arg)
+{
+  struct host_worker_s *worker = (struct host_worker_s *)arg;
+
+  return (void *)(intptr_t)worker->entry();
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int host_mptask_register(const char *filename, host_worker_t entry)
+{
+  for (int i = 0; i < HOST_ASMP_MAX_WORKERS; i++)
+    {
+      if (s_worker[i].filename == NULL)
+        {
+          s_worker[i].filename = filename;
+          s_worker[i].entry    = entry;
+          return 0;
+        }
+    }
+
+  return -ENOMEM;
+}
+
+/*--------------------------------------------------------------------------*/
+int host_mpmq_worker_send(key_t key, int8_t msgid, uint32_t data)
+{
+  struct host_channel_s *ch = get_channel(key);
+
+  if (ch == NULL)
+    {
+      return -EINVAL;
+    }
+
+  return queue_send(&ch->to_supervisor, msgid, data);
+}
+
+/*--------------------------------------------------------------------------*/
+int host_mpmq_worker_receive(key_t key, uint32_t *data)
+{
+  struct host_channel_s *ch = get_channel(key);
+
+  if (ch == NULL)
+    {
+      return -EINVAL;
+    }
+
+  int msgid = queue_receive(&ch->to_worker, data);
+
+  return (msgid == HOST_ASMP_MSGID_STOP) ? -EINTR : msgid;
+}
+
+/*--------------------------------------------------------------------------*/
+int mptask_init_secure(mptask_t *task, const char *filename)
+{
+  memset(task, 0, sizeof(mptask_t));
+  task->filename = filename;
+  task->cpuid    = -1;
+
+  for (int i = 0; i < HOST_ASMP_MAX_WORKERS; i++)
+    {
+      if ((s_worker[i].filename != NULL) &&
+          (strcmp(s_worker[i].filename, filename) == 0))
+        {
+          return 0;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/*--------------------------------------------------------------------------*/
+int mptask_assign(mptask_t *task)
+{
+  task->cpuid = s_next_cpuid++;
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+cpuid_t mptask_getcpuid(mptask_t *task)
+{
+  return task->cpuid;
+}
+
+/*--------------------------------------------------------------------------*/
+int mptask_exec(mptask_t *task)
+{
+  for (int i = 0; i < HOST_ASMP_MAX_WORKERS; i++)
+    {
+      if ((s_worker[i].filename != NULL) &&
+          (strcmp(s_worker[i].filename, task->filename) == 0))
+        {
+          int ret = pthread_create(&task->thread, NULL, worker_entry,
+                                   &s_worker[i]);
+          if (ret != 0)
+            {
+              return -ret;
+            }
+
+          task->running = true;
+          return 0;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/*--------------------------------------------------------------------------*/
+int mptask_destroy(mptask_t *task, bool force, int *exitcode)
+{
+  if (!task->running)
+    {
+      return 0;
+    }
+
+  /* Stop the worker by the queues bound to its CPU. */
+
+  for (int i = 0; i < HOST_ASMP_MAX_KEYS; i++)
+    {
+      if (s_channel[i].used && (s_channel[i].cpuid == task->cpuid))
+        {
+          queue_send(&s_channel[i].to_worker, HOST_ASMP_MSGID_STOP, 0);
+        }
+    }
+
+  void *ret;
+  pthread_join(task->thread, &ret);
+  task->running = false;
+
+  if (exitcode != NULL)
+    {
+      *exitcode = (int)(intptr_t)ret;
+    }
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+int mpmq_init(mpmq_t *mq, key_t key, cpuid_t cpuid)
+{
+  if ((key < 0) || (key >= HOST_ASMP_MAX_KEYS) || s_channel[key].used)
+    {
+      return -EINVAL;
+    }
+
+  struct host_channel_s *ch = &s_channel[key];
+
+  queue_init(&ch->to_worker);
+  queue_init(&ch->to_supervisor);
+  ch->cpuid = cpuid;
+  ch->used  = true;
+
+  mq->key   = key;
+  mq->cpuid = cpuid;
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+int mpmq_destroy(mpmq_t *mq)
+{
+  struct host_channel_s *ch = get_channel(mq->key);
+
+  if (ch == NULL)
+    {
+      return -EINVAL;
+    }
+
+  ch->used = false;
+  queue_destroy(&ch->to_worker);
+  queue_destroy(&ch->to_supervisor);
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+int mpmq_send(mpmq_t *mq, int8_t msgid, uint32_t data)
+{
+  struct host_channel_s *ch = get_channel(mq->key);
+
+  if (ch == NULL)
+    {
+      return -EINVAL;
+    }
+
+  return queue_send(&ch->to_worker, msgid, data);
+}
+
+/*--------------------------------------------------------------------------*/
+int mpmq_receive(mpmq_t *mq, uint32_t *data)
+{
+  struct host_channel_s *ch = get_channel(mq->key);
+
+  if (ch == NULL)
+    {
+      return -EINVAL;
+    }
+
+  return queue_receive(&ch->to_supervisor, data);
+}
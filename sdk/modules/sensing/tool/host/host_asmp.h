@@ -0,0 +1,84 @@
+/****************************************************************************
+ * modules/sensing/tool/host/host_asmp.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Worker side of the host ASMP emulation.
+ *
+ * The worker (DSP) of a logical sensor is emulated by a thread of the
+ * host. It is started by mptask_exec() of the supervisor, and talks with
+ * the supervisor through the queue of a known key, same as the DSP.
+ */
+
+#ifndef __SENSING_TOOL_HOST_HOST_ASMP_H
+#define __SENSING_TOOL_HOST_HOST_ASMP_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <asmp/mpmq.h>
+#include <asmp/mptask.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define HOST_ASMP_MAX_KEYS    8
+#define HOST_ASMP_MAX_WORKERS 4
+#define HOST_ASMP_QUEUE_DEPTH 32
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Entry of a worker. Return value is the exit code of the worker. */
+
+typedef int (*host_worker_t)(void);
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* Register a worker for the file name given to mptask_init_secure(). */
+
+int host_mptask_register(const char *filename, host_worker_t entry);
+
+/* Send to / receive from the supervisor. The receive returns the message
+ * ID, or -EINTR when the worker task is destroyed.
+ */
+
+int host_mpmq_worker_send(key_t key, int8_t msgid, uint32_t data);
+int host_mpmq_worker_receive(key_t key, uint32_t *data);
+
+#endif /* __SENSING_TOOL_HOST_HOST_ASMP_H */
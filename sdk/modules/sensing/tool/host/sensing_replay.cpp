@@ -0,0 +1,1645 @@
+/****************************************************************************
+ * modules/sensing/tool/host/sensing_replay.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Replay of recorded sensor data through the sensor manager on the host.
+ *
+ * The sensor manager, the memory manager and the message library of the
+ * SDK run on the host with the same client graph as the examples:
+ *
+ *   accel ---+--> step counter (stand-in DSP) --> app0 (steps)
+ *   gnss  ---+
+ *   accel ------> app2 (tap detection)
+ *   press ---+--> barometer --> app1 (compensated pressure)
+ *   temp  ---+
+ *   mag, gnss --> app3
+ *
+ * The trace is sent in batches of the watermark, as fast as possible or
+ * at "speed" times the real time. A batch holds a segment of the pool
+ * until all clients release it, so the replay waits for a free segment
+ * as the drivers do.
+ *
+ * Detections, processing time of each client callback and the delivery
+ * statistics of the sensor manager are reported. Processing time is of
+ * the host, use it to compare changes, not as the time of the target.
+ * With -t, a synthetic trace is replayed and the detections are checked
+ * against the libraries called directly and the reference formulas.
+ * Then data without MemHandle is sent by value and by pointer, and the
+ * pointer is checked to be rejected with the asynchronous delivery.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sys/mman.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+#include "memutils/message/Message.h"
+#include "memutils/memory_manager/MemHandle.h"
+#include "sensing/sensor_api.h"
+#include "sensing/sensor_id.h"
+#include "sensing/sensor_ecode.h"
+#include "sensing/tap.h"
+#include "sensing/logical_sensor/barometer.h"
+#include "sensing/logical_sensor/step_counter.h"
+
+#include "host_asmp.h"
+#include "step_counter_worker.h"
+
+using namespace MemMgrLite;
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Message queue and memory pools. DRM and pool address are 32bit, so
+ * map them under 4GB. Pools must be over 1MB, see translateVaToPa().
+ */
+
+#define REPLAY_TOP_DRM      0x20000000
+#define REPLAY_AREA_SIZE    0x00100000
+#define REPLAY_POOL_ADDR    (REPLAY_TOP_DRM + 0x00008000)
+
+#define REPLAY_QUE_SIZE     64
+#define REPLAY_QUE_NUM      64
+#define REPLAY_QUE_AREA_DRM \
+  ROUND_UP(REPLAY_TOP_DRM + NUM_MSGQ_POOLS * sizeof(MsgQueBlock), sizeof(int))
+
+/* Watermark of the sensors. */
+
+#define ACCEL_WATERMARK_NUM STEP_COUNTER_SAMPLING_MAX
+#define MAG_WATERMARK_NUM   STEP_COUNTER_SAMPLING_MAX
+#define GNSS_WATERMARK_NUM  1
+
+/* Segments of the pools. A batch of accel holds a command segment of the
+ * step counter until the result is received by app0.
+ */
+
+#define CMD_SEG_SIZE    ROUND_UP(sizeof(SensorCmdStepCounter), 8)
+#define CMD_SEG_NUM     16
+#define ACCEL_SEG_SIZE  (sizeof(ThreeAxisSample) * ACCEL_WATERMARK_NUM)
+#define ACCEL_SEG_NUM   8
+#define MAG_SEG_SIZE    (sizeof(ThreeAxisSample) * MAG_WATERMARK_NUM)
+#define MAG_SEG_NUM     4
+#define PRESS_SEG_SIZE  (sizeof(uint32_t) * BAROMETER_PRESSURE_WATERMARK_NUM)
+#define PRESS_SEG_NUM   4
+#define TEMP_SEG_SIZE   (sizeof(int32_t) * BAROMETER_TEMPERATURE_WATERMARK_NUM)
+#define TEMP_SEG_NUM    4
+#define GNSS_SEG_SIZE   ROUND_UP(sizeof(GnssSampleData), 8)
+#define GNSS_SEG_NUM    4
+
+#define CMD_POOL_ADDR   REPLAY_POOL_ADDR
+#define ACCEL_POOL_ADDR (CMD_POOL_ADDR + CMD_SEG_SIZE * CMD_SEG_NUM)
+#define MAG_POOL_ADDR   (ACCEL_POOL_ADDR + ACCEL_SEG_SIZE * ACCEL_SEG_NUM)
+#define PRESS_POOL_ADDR (MAG_POOL_ADDR + MAG_SEG_SIZE * MAG_SEG_NUM)
+#define TEMP_POOL_ADDR  (PRESS_POOL_ADDR + PRESS_SEG_SIZE * PRESS_SEG_NUM)
+#define GNSS_POOL_ADDR  (TEMP_POOL_ADDR + TEMP_SEG_SIZE * TEMP_SEG_NUM)
+#define POOL_END_ADDR   (GNSS_POOL_ADDR + GNSS_SEG_SIZE * GNSS_SEG_NUM)
+
+#define REPLAY_WORK_SIZE  0x400
+
+/* Timeout of waiting a free segment, and of the drain at the end. */
+
+#define REPLAY_ALLOC_TIMEOUT_MS  5000
+#define REPLAY_DRAIN_TIMEOUT_MS  5000
+
+/* Synthetic trace. */
+
+#define SYN_SEC         60
+#define SYN_ACCEL_FS    64
+#define SYN_MAG_FS      32
+#define SYN_BARO_FS     BAROMETER_PRESSURE_SAMPLING_FREQUENCY
+#define SYN_GNSS_FS     1
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+enum
+{
+  MSGQ_NULL = 0,
+  MSGQ_SEN_MGR,
+  NUM_MSGQ_POOLS
+};
+
+enum
+{
+  NULL_POOL = 0,
+  CMD_POOL,
+  ACCEL_POOL,
+  MAG_POOL,
+  PRESS_POOL,
+  TEMP_POOL,
+  GNSS_POOL,
+  NUM_MEM_POOLS
+};
+
+enum SampleType
+{
+  TypeAccel = 0,
+  TypeMag,
+  TypePress,
+  TypeTemp,
+  TypeGnss,
+  NumSampleTypes
+};
+
+struct Sample
+{
+  uint64_t    time;   /* [us] */
+  SampleType  type;
+  double      v[3];   /* x,y,z [G][uT], raw ADC, or lat,lon,velocity */
+
+  bool operator < (const Sample &s) const { return time < s.time; }
+};
+
+typedef std::vector<Sample> Trace;
+
+struct Event
+{
+  int       tap_cnt;
+  uint64_t  time_stamp;
+
+  bool operator == (const Event &e) const
+  {
+    return (tap_cnt == e.tap_cnt) && (time_stamp == e.time_stamp);
+  }
+};
+
+typedef std::vector<Event> Events;
+
+/* Processing time of a client callback. */
+
+struct Stage
+{
+  const char     *name;
+  SensorClientID  id;
+  uint32_t        count;
+  uint64_t        total_ns;
+  uint64_t        max_ns;
+};
+
+/* What is sent, and what the clients received. */
+
+struct Record
+{
+  uint32_t               sent[NumSampleTypes];   /* number of batches */
+  std::vector<ThreeAxisSample> accel;            /* sent accel samples */
+  std::vector<uint64_t>  accel_time;             /* [us] of each batch */
+  std::vector<uint32_t>  accel_fs;
+  std::vector<uint32_t>  pressure;               /* reference values */
+
+  Events                 taps;
+  uint32_t               step_results;
+  uint32_t               steps;
+  float                  distance;
+  std::vector<uint32_t>  compensated;
+  uint32_t               mag;
+  uint32_t               gnss;
+  std::vector<uint32_t>  plain;                  /* data without MH */
+  uint32_t               api_errors;
+  uint32_t               write_errors;
+  uint32_t               alloc_waits;
+  bool                   power[NumOfSensorClientID];
+  uint32_t               power_on[NumOfSensorClientID];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+extern const MsgQueDef MsgqPoolDefs[NUM_MSGQ_POOLS] =
+{
+  /* n_drm, n_size, n_num, h_drm, h_size, h_num, owner, spinlock, mode */
+
+  { 0x00000000, 0, 0, 0x00000000, 0, 0, 0, 0 }, /* MSGQ_NULL */
+  { REPLAY_QUE_AREA_DRM, REPLAY_QUE_SIZE, REPLAY_QUE_NUM,
+    INVALID_DRM, 0, 0, 0, 0 },                   /* MSGQ_SEN_MGR */
+};
+
+static const PoolSectionAttr s_layout[] =
+{
+  { { CMD_POOL, 0 },   BasicType, CMD_SEG_NUM,   CMD_POOL_ADDR,
+    CMD_SEG_SIZE * CMD_SEG_NUM },
+  { { ACCEL_POOL, 0 }, BasicType, ACCEL_SEG_NUM, ACCEL_POOL_ADDR,
+    ACCEL_SEG_SIZE * ACCEL_SEG_NUM },
+  { { MAG_POOL, 0 },   BasicType, MAG_SEG_NUM,   MAG_POOL_ADDR,
+    MAG_SEG_SIZE * MAG_SEG_NUM },
+  { { PRESS_POOL, 0 }, BasicType, PRESS_SEG_NUM, PRESS_POOL_ADDR,
+    PRESS_SEG_SIZE * PRESS_SEG_NUM },
+  { { TEMP_POOL, 0 },  BasicType, TEMP_SEG_NUM,  TEMP_POOL_ADDR,
+    TEMP_SEG_SIZE * TEMP_SEG_NUM },
+  { { GNSS_POOL, 0 },  BasicType, GNSS_SEG_NUM,  GNSS_POOL_ADDR,
+    GNSS_SEG_SIZE * GNSS_SEG_NUM },
+  { { 0, 0 }, 0, 0, 0, 0 }
+};
+
+static uint32_t s_manager_area[64];
+static uint32_t s_work_area[REPLAY_WORK_SIZE / sizeof(uint32_t)];
+
+static MemPool *s_pools_block[NUM_MEM_POOLS];
+static MemPool **s_pools[1] = { s_pools_block };
+static uint8_t  s_pool_num[1] = { NUM_MEM_POOLS };
+static uint8_t  s_layout_no[1] = { BadLayoutNo };
+
+namespace MemMgrLite
+{
+  MemPool *static_pools[NUM_MEM_POOLS];
+}
+
+static const char *s_type_name[NumSampleTypes] =
+{
+  "accel", "mag", "press", "temp", "gnss"
+};
+
+static const PoolId s_type_pool[NumSampleTypes] =
+{
+  { ACCEL_POOL, 0 }, { MAG_POOL, 0 }, { PRESS_POOL, 0 }, { TEMP_POOL, 0 },
+  { GNSS_POOL, 0 }
+};
+
+static const SensorClientID s_type_id[NumSampleTypes] =
+{
+  accelID, magID, pressureID, tempID, gnssID
+};
+
+static const uint32_t s_type_watermark[NumSampleTypes] =
+{
+  ACCEL_WATERMARK_NUM, MAG_WATERMARK_NUM, BAROMETER_PRESSURE_WATERMARK_NUM,
+  BAROMETER_TEMPERATURE_WATERMARK_NUM, GNSS_WATERMARK_NUM
+};
+
+/* Tap parameter, same as tap_bench. */
+
+static const ST_TAP_OPEN s_tap_param =
+{
+  500000.0F,  /* tap_period */
+  1.5F,       /* peak_thres */
+  0.5F,       /* long_thres */
+  1           /* stab_frame */
+};
+
+/* Adjustment parameters, the example of the BMP280 datasheet. */
+
+static const struct bmp280_temp_adj_s s_temp_adj =
+{
+  27504, 26435, -1000
+};
+
+static const struct bmp280_press_adj_s s_press_adj =
+{
+  36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000
+};
+
+static Stage s_stage[] =
+{
+  { "step_counter write", stepcounterID, 0, 0, 0 },
+  { "barometer write",    barometerID,   0, 0, 0 },
+  { "app0 step result",   app0ID,        0, 0, 0 },
+  { "app1 pressure",      app1ID,        0, 0, 0 },
+  { "app2 tap",           app2ID,        0, 0, 0 },
+  { "app3 mag/gnss",      app3ID,        0, 0, 0 },
+};
+
+enum
+{
+  StageStepCounter = 0,
+  StageBarometer,
+  StageApp0,
+  StageApp1,
+  StageApp2,
+  StageApp3,
+  NumStages
+};
+
+static pthread_mutex_t   s_lock = PTHREAD_MUTEX_INITIALIZER;
+static sem_t             s_sync;
+static Record            s_rec;
+static StepCounterClass *s_step_counter;
+static BarometerClass   *s_barometer;
+static TapClass         *s_tap;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint64_t now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*--------------------------------------------------------------------------*/
+static uint64_t cpu_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*--------------------------------------------------------------------------*/
+static void stage_end(int stage, uint64_t start)
+{
+  uint64_t ns = now_ns() - start;
+  Stage   *s = &s_stage[stage];
+
+  /* Each stage is called by one thread. */
+
+  s->count++;
+  s->total_ns += ns;
+  s->max_ns = std::max(s->max_ns, ns);
+}
+
+/*--------------------------------------------------------------------------*/
+/* Reference of the compensation, the 32bit integer formula of the BMP280
+ * datasheet.
+ */
+
+static int32_t ref_t_fine(int32_t adc_T)
+{
+  const struct bmp280_temp_adj_s &a = s_temp_adj;
+  int32_t var1;
+  int32_t var2;
+
+  var1 = ((((adc_T >> 3) - ((int32_t)a.dig_T1 << 1))) *
+          ((int32_t)a.dig_T2)) >> 11;
+  var2 = (((((adc_T >> 4) - ((int32_t)a.dig_T1)) *
+            ((adc_T >> 4) - ((int32_t)a.dig_T1))) >> 12) *
+          ((int32_t)a.dig_T3)) >> 14;
+
+  return var1 + var2;
+}
+
+/*--------------------------------------------------------------------------*/
+static uint32_t ref_pressure(int32_t adc_P, int32_t t_fine)
+{
+  const struct bmp280_press_adj_s &a = s_press_adj;
+  int32_t  var1;
+  int32_t  var2;
+  uint32_t p;
+
+  var1 = (((int32_t)t_fine) >> 1) - (int32_t)64000;
+  var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * ((int32_t)a.dig_P6);
+  var2 = var2 + ((var1 * ((int32_t)a.dig_P5)) << 1);
+  var2 = (var2 >> 2) + (((int32_t)a.dig_P4) << 16);
+  var1 = (((a.dig_P3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) +
+          ((((int32_t)a.dig_P2) * var1) >> 1)) >> 18;
+  var1 = ((((32768 + var1)) * ((int32_t)a.dig_P1)) >> 15);
+
+  if (var1 == 0)
+    {
+      return 0;
+    }
+
+  p = (((uint32_t)(((int32_t)1048576) - adc_P) - (var2 >> 12))) * 3125;
+
+  if (p < 0x80000000)
+    {
+      p = (p << 1) / ((uint32_t)var1);
+    }
+  else
+    {
+      p = (p / (uint32_t)var1) * 2;
+    }
+
+  var1 = (((int32_t)a.dig_P9) *
+          ((int32_t)(((p >> 3) * (p >> 3)) >> 13))) >> 12;
+  var2 = (((int32_t)(p >> 2)) * ((int32_t)a.dig_P8)) >> 13;
+  p = (uint32_t)((int32_t)p + ((var1 + var2 + a.dig_P7) >> 4));
+
+  return p;
+}
+
+/****************************************************************************
+ * Sensor Manager Clients
+ ****************************************************************************/
+
+static void api_response(unsigned int code,
+                         unsigned int ercd,
+                         unsigned int self_id)
+{
+  if (code == ChangeSubscription)
+    {
+      sem_post(&s_sync);
+    }
+
+  if (ercd != SS_ECODE_OK)
+    {
+      printf("  API error: code %u, ercd %u, id %u\n", code, ercd, self_id);
+
+      pthread_mutex_lock(&s_lock);
+      s_rec.api_errors++;
+      pthread_mutex_unlock(&s_lock);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static bool power_callback(SensorClientID id, bool on)
+{
+  pthread_mutex_lock(&s_lock);
+  s_rec.power[id] = on;
+  s_rec.power_on[id] += on ? 1 : 0;
+  pthread_mutex_unlock(&s_lock);
+
+  return true;
+}
+
+static bool press_power(bool on) { return power_callback(pressureID, on); }
+static bool temp_power(bool on)  { return power_callback(tempID, on); }
+
+/*--------------------------------------------------------------------------*/
+static bool step_counter_receive_data(sensor_command_data_mh_t &data)
+{
+  uint64_t start = now_ns();
+
+  if (StepCounterWrite(s_step_counter, &data) != SS_ECODE_OK)
+    {
+      pthread_mutex_lock(&s_lock);
+      s_rec.write_errors++;
+      pthread_mutex_unlock(&s_lock);
+    }
+
+  stage_end(StageStepCounter, start);
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool barometer_receive_data(sensor_command_data_mh_t &data)
+{
+  uint64_t start = now_ns();
+
+  BarometerWrite(s_barometer, &data);
+
+  stage_end(StageBarometer, start);
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool app0_receive_steps(sensor_command_data_mh_t &data)
+{
+  uint64_t start = now_ns();
+  FAR SensorResultStepCounter *result =
+    reinterpret_cast<SensorResultStepCounter *>(data.mh.getVa());
+
+  pthread_mutex_lock(&s_lock);
+  s_rec.step_results++;
+  if (result->exec_result == SensorOK)
+    {
+      s_rec.steps    = result->steps.step;
+      s_rec.distance = result->steps.distance;
+    }
+  pthread_mutex_unlock(&s_lock);
+
+  stage_end(StageApp0, start);
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool app1_receive_pressure(sensor_command_data_mh_t &data)
+{
+  uint64_t start = now_ns();
+  const uint32_t *p = static_cast<const uint32_t *>(data.mh.getVa());
+
+  pthread_mutex_lock(&s_lock);
+  s_rec.compensated.insert(s_rec.compensated.end(), p, p + data.size);
+  pthread_mutex_unlock(&s_lock);
+
+  stage_end(StageApp1, start);
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool app2_detect_tap(sensor_command_data_mh_t &data)
+{
+  uint64_t     start = now_ns();
+  ST_TAP_EVENT events[ACCEL_WATERMARK_NUM];
+  uint32_t     interval = 1000000 / data.fs;
+
+  /* ThreeAxisSample is same as ST_TAP_ACCEL. */
+
+  int num = TapWrite_block(s_tap,
+                           static_cast<ST_TAP_ACCEL *>(data.mh.getVa()),
+                           data.size,
+                           (uint64_t)data.time * 1000,
+                           interval,
+                           events);
+
+  pthread_mutex_lock(&s_lock);
+  for (int i = 0; i < num; i++)
+    {
+      Event e = { events[i].tap_cnt, events[i].time_stamp };
+      s_rec.taps.push_back(e);
+    }
+  pthread_mutex_unlock(&s_lock);
+
+  stage_end(StageApp2, start);
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool app3_receive_data(sensor_command_data_mh_t &data)
+{
+  uint64_t start = now_ns();
+
+  pthread_mutex_lock(&s_lock);
+  if (data.self == magID)
+    {
+      s_rec.mag++;
+    }
+  else
+    {
+      s_rec.gnss++;
+    }
+  pthread_mutex_unlock(&s_lock);
+
+  stage_end(StageApp3, start);
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool plain_receive_data(sensor_command_data_t &data)
+{
+  pthread_mutex_lock(&s_lock);
+  s_rec.plain.push_back(data.is_ptr ? *(uint32_t *)data.adr : data.data);
+  pthread_mutex_unlock(&s_lock);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static void register_client(SensorClientID id,
+                            uint32_t subscriptions,
+                            sensor_data_mh_callback_t callback_mh,
+                            sensor_power_callback_t callback_pw)
+{
+  sensor_command_register_t reg;
+
+  reg.header.size   = 0;
+  reg.header.code   = ResisterClient;
+  reg.self          = id;
+  reg.subscriptions = subscriptions;
+  reg.callback      = NULL;
+  reg.callback_mh   = callback_mh;
+  reg.callback_pw   = callback_pw;
+  SS_SendSensorResister(&reg);
+}
+
+/*--------------------------------------------------------------------------*/
+/* Wait until the manager processed the commands sent so far. A change of
+ * no subscription is used as the barrier.
+ */
+
+static void sync_manager(void)
+{
+  sensor_command_change_subscription_t chg;
+
+  chg.header.size   = 0;
+  chg.header.code   = ChangeSubscription;
+  chg.self          = app0ID;
+  chg.subscriptions = 0;
+  chg.add           = true;
+  SS_SendSensorChangeSubscription(&chg);
+
+  while (sem_wait(&s_sync) != 0 && errno == EINTR);
+}
+
+/*--------------------------------------------------------------------------*/
+static void release_client(SensorClientID id)
+{
+  sensor_command_release_t rel;
+
+  rel.header.size = 0;
+  rel.header.code = ReleaseClient;
+  rel.self        = id;
+  SS_SendSensorRelease(&rel);
+}
+
+/****************************************************************************
+ * Trace
+ ****************************************************************************/
+
+static Sample make_sample(uint64_t time, SampleType type,
+                          double v0, double v1, double v2)
+{
+  Sample s;
+
+  s.time = time;
+  s.type = type;
+  s.v[0] = v0;
+  s.v[1] = v1;
+  s.v[2] = v2;
+
+  return s;
+}
+
+/*--------------------------------------------------------------------------*/
+/* 10s still with taps, 30s walking, 10s running, then still with taps.
+ * Pressure goes down as climbing, and position moves along the way.
+ */
+
+static Trace make_synthetic(void)
+{
+  static const double taps[] = { 3.0, 6.0, 6.2, 53.0, 53.2, 53.4, 57.0 };
+  Trace trace;
+
+  for (uint32_t i = 0; i < SYN_SEC * SYN_ACCEL_FS; i++)
+    {
+      double t = (double)i / SYN_ACCEL_FS;
+      double z = 1.0;
+
+      if (t >= 10.0 && t < 40.0)
+        {
+          z += 0.35 * sin(2.0 * M_PI * 1.8 * t);
+        }
+      else if (t >= 40.0 && t < 50.0)
+        {
+          z += 0.6 * sin(2.0 * M_PI * 2.8 * t);
+        }
+      else
+        {
+          for (size_t k = 0; k < sizeof(taps) / sizeof(taps[0]); k++)
+            {
+              if ((uint32_t)(taps[k] * SYN_ACCEL_FS) == i)
+                {
+                  z = 2.4;
+                }
+            }
+        }
+
+      trace.push_back(make_sample((uint64_t)i * 1000000 / SYN_ACCEL_FS,
+                                  TypeAccel,
+                                  0.01 * sin(t * 7.0),
+                                  0.01 * cos(t * 5.0),
+                                  z));
+    }
+
+  for (uint32_t i = 0; i < SYN_SEC * SYN_MAG_FS; i++)
+    {
+      trace.push_back(make_sample((uint64_t)i * 1000000 / SYN_MAG_FS,
+                                  TypeMag, 20.0, 5.0, -40.0));
+    }
+
+  for (uint32_t i = 0; i < SYN_SEC * SYN_BARO_FS; i++)
+    {
+      uint64_t time = (uint64_t)i * 1000000 / SYN_BARO_FS;
+
+      trace.push_back(make_sample(time, TypePress,
+                                  415148 + i * 2 + (i * 7) % 13, 0, 0));
+      trace.push_back(make_sample(time, TypeTemp,
+                                  519888 + (i % 32) * 16, 0, 0));
+    }
+
+  for (uint32_t i = 0; i < SYN_SEC * SYN_GNSS_FS; i++)
+    {
+      trace.push_back(make_sample((uint64_t)i * 1000000 / SYN_GNSS_FS,
+                                  TypeGnss,
+                                  35.6 + i * 1e-5, 139.7 + i * 1e-5, 1.3));
+    }
+
+  std::stable_sort(trace.begin(), trace.end());
+
+  return trace;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Line is "time_us,type,v1[,v2,v3]", type is one of s_type_name.
+ * Lines starting with '#' are ignored.
+ */
+
+static bool load_csv(const char *path, Trace *trace)
+{
+  FILE *fp = fopen(path, "r");
+  char  line[256];
+  int   lineno = 0;
+
+  if (fp == NULL)
+    {
+      printf("  cannot open %s\n", path);
+      return false;
+    }
+
+  while (fgets(line, sizeof(line), fp) != NULL)
+    {
+      unsigned long long time;
+      char   type[16];
+      double v[3] = { 0, 0, 0 };
+      int    t;
+
+      lineno++;
+
+      if (line[0] == '#' || line[0] == '\n' || line[0] == '\r')
+        {
+          continue;
+        }
+
+      if (sscanf(line, "%llu,%15[^,],%lf,%lf,%lf",
+                 &time, type, &v[0], &v[1], &v[2]) < 3)
+        {
+          printf("  %s:%d: bad line\n", path, lineno);
+          fclose(fp);
+          return false;
+        }
+
+      for (t = 0; t < NumSampleTypes; t++)
+        {
+          if (strcmp(type, s_type_name[t]) == 0)
+            {
+              break;
+            }
+        }
+
+      if (t == NumSampleTypes)
+        {
+          printf("  %s:%d: unknown type %s\n", path, lineno, type);
+          fclose(fp);
+          return false;
+        }
+
+      trace->push_back(make_sample(time, (SampleType)t, v[0], v[1], v[2]));
+    }
+
+  fclose(fp);
+
+  std::stable_sort(trace->begin(), trace->end());
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Sampling rate of each type, from the average interval. */
+
+static void get_rates(const Trace &trace, uint32_t fs[NumSampleTypes])
+{
+  uint64_t first[NumSampleTypes];
+  uint64_t last[NumSampleTypes];
+  uint32_t num[NumSampleTypes] = { 0 };
+
+  for (size_t i = 0; i < trace.size(); i++)
+    {
+      SampleType t = trace[i].type;
+
+      if (num[t]++ == 0)
+        {
+          first[t] = trace[i].time;
+        }
+      last[t] = trace[i].time;
+    }
+
+  for (int t = 0; t < NumSampleTypes; t++)
+    {
+      fs[t] = (num[t] < 2 || last[t] == first[t]) ? 1 :
+              (uint32_t)((uint64_t)(num[t] - 1) * 1000000 /
+                         (last[t] - first[t]) + 0.5);
+      fs[t] = std::max(fs[t], 1u);
+    }
+
+  fs[TypePress] = BAROMETER_PRESSURE_SAMPLING_FREQUENCY;
+  fs[TypeTemp]  = BAROMETER_TEMPERATURE_SAMPLING_FREQUENCY;
+}
+
+/****************************************************************************
+ * Replay
+ ****************************************************************************/
+
+static bool alloc_seg(MemHandle &mh, PoolId id, size_t size)
+{
+  uint64_t start = now_ns();
+
+  while (mh.allocSeg(id, size) != ERR_OK)
+    {
+      /* All segments are in the pipeline. Wait as a driver does. */
+
+      if (now_ns() - start > (uint64_t)REPLAY_ALLOC_TIMEOUT_MS * 1000000)
+        {
+          printf("  no free segment of pool %d\n", id.pool);
+          return false;
+        }
+
+      s_rec.alloc_waits++;
+      usleep(100);
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+/* The step counter queues up to MAX_EXEC_COUNT requests to the DSP, and
+ * fails over it. On the target, the sensors are slow enough to keep under
+ * it, so keep the requests in flight under it here too. A request is
+ * popped after its result is sent, so one more is kept free.
+ */
+
+static bool wait_step_counter(void)
+{
+  uint64_t start = now_ns();
+
+  for (; ; )
+    {
+      pthread_mutex_lock(&s_lock);
+      uint32_t in_flight = s_rec.sent[TypeAccel] + s_rec.sent[TypeGnss] -
+                           s_rec.step_results;
+      pthread_mutex_unlock(&s_lock);
+
+      if (in_flight < MAX_EXEC_COUNT - 1)
+        {
+          return true;
+        }
+
+      if (now_ns() - start > (uint64_t)REPLAY_ALLOC_TIMEOUT_MS * 1000000)
+        {
+          printf("  step counter does not respond\n");
+          return false;
+        }
+
+      s_rec.alloc_waits++;
+      usleep(100);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/* Same pairing as BarometerClass::write(), for the reference values. */
+
+static void expect_pressure(SampleType type, const std::vector<Sample> &batch)
+{
+  static std::vector<Sample> press;
+  static std::vector<Sample> temp;
+
+  ((type == TypePress) ? press : temp) = batch;
+
+  if (!press.empty() && !temp.empty())
+    {
+      for (size_t i = 0; i < press.size(); i++)
+        {
+          int32_t t_fine = ref_t_fine((int32_t)temp[i].v[0]);
+
+          s_rec.pressure.push_back(ref_pressure((int32_t)press[i].v[0],
+                                                t_fine));
+        }
+
+      press.clear();
+      temp.clear();
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static bool send_batch(SampleType type, const std::vector<Sample> &batch,
+                       uint32_t fs)
+{
+  MemHandle mh;
+  size_t    size;
+
+  switch (type)
+    {
+      case TypeAccel:
+      case TypeMag:
+        size = sizeof(ThreeAxisSample) * batch.size();
+        break;
+
+      case TypePress:
+      case TypeTemp:
+        size = sizeof(uint32_t) * batch.size();
+        break;
+
+      default:
+        size = sizeof(GnssSampleData);
+        break;
+    }
+
+  if ((type == TypeAccel || type == TypeGnss) && !wait_step_counter())
+    {
+      return false;
+    }
+
+  if (!alloc_seg(mh, s_type_pool[type], size))
+    {
+      return false;
+    }
+
+  void *va = mh.getVa();
+
+  switch (type)
+    {
+      case TypeAccel:
+      case TypeMag:
+        {
+          ThreeAxisSample *p = static_cast<ThreeAxisSample *>(va);
+
+          for (size_t i = 0; i < batch.size(); i++)
+            {
+              p[i].ax = (float)batch[i].v[0];
+              p[i].ay = (float)batch[i].v[1];
+              p[i].az = (float)batch[i].v[2];
+            }
+
+          if (type == TypeAccel)
+            {
+              s_rec.accel.insert(s_rec.accel.end(), p, p + batch.size());
+              s_rec.accel_time.push_back(batch[0].time / 1000 * 1000);
+              s_rec.accel_fs.push_back(fs);
+            }
+        }
+        break;
+
+      case TypePress:
+      case TypeTemp:
+        {
+          uint32_t *p = static_cast<uint32_t *>(va);
+
+          for (size_t i = 0; i < batch.size(); i++)
+            {
+              p[i] = (uint32_t)(int32_t)batch[i].v[0];
+            }
+
+          expect_pressure(type, batch);
+        }
+        break;
+
+      default:
+        {
+          GnssSampleData *p = static_cast<GnssSampleData *>(va);
+
+          memset(p, 0, sizeof(GnssSampleData));
+          p->raw_latitude  = batch[0].v[0];
+          p->raw_longitude = batch[0].v[1];
+          p->latitude      = batch[0].v[0];
+          p->longitude     = batch[0].v[1];
+          p->velocity      = (float)batch[0].v[2];
+          p->time_stamp    = (uint32_t)(batch[0].time / 1000);
+          p->pos_fix_mode  = 2;
+          p->vel_fix_mode  = 2;
+        }
+        break;
+    }
+
+  /* Every other barometer input is sent with fs and size left at 0, as
+   * the publishers did when the barometer had a fixed watermark.
+   */
+
+  bool legacy = ((type == TypePress || type == TypeTemp) &&
+                 (s_rec.sent[type] & 1) != 0);
+
+  sensor_command_data_mh_t packet;
+
+  packet.header.size = 0;
+  packet.header.code = SendData;
+  packet.self        = s_type_id[type];
+  packet.time        = (uint32_t)(batch[0].time / 1000) & 0xffffff;
+  packet.fs          = legacy ? 0 : fs;
+  packet.size        = legacy ? 0 : batch.size();
+  packet.mh          = mh;
+
+  SS_SendSensorDataMH(&packet);
+
+  s_rec.sent[type]++;
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Send the trace in batches of the watermark. Samples which do not fill
+ * a batch at the end are not sent.
+ */
+
+static bool replay(const Trace &trace, double speed)
+{
+  std::vector<Sample> batch[NumSampleTypes];
+  uint32_t            fs[NumSampleTypes];
+  uint64_t            start = now_ns();
+  uint64_t            top = trace.empty() ? 0 : trace[0].time;
+
+  get_rates(trace, fs);
+
+  for (size_t i = 0; i < trace.size(); i++)
+    {
+      SampleType type = trace[i].type;
+
+      batch[type].push_back(trace[i]);
+
+      if (batch[type].size() < s_type_watermark[type])
+        {
+          continue;
+        }
+
+      if (speed > 0.0)
+        {
+          /* Send when the last sample is ready. */
+
+          uint64_t due = start +
+                         (uint64_t)((trace[i].time - top) * 1000 / speed);
+          uint64_t now = now_ns();
+
+          if (due > now)
+            {
+              usleep((due - now) / 1000);
+            }
+        }
+
+      if (!send_batch(type, batch[type], fs[type]))
+        {
+          return false;
+        }
+
+      batch[type].clear();
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static uint32_t used_segs(void)
+{
+  uint32_t used = 0;
+
+  for (int id = CMD_POOL; id < NUM_MEM_POOLS; id++)
+    {
+      PoolId pool = { (uint8_t)id, 0 };
+
+      used += Manager::getPoolNumSegs(pool) -
+              Manager::getPoolNumAvailSegs(pool);
+    }
+
+  return used;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Wait until all segments are released by the clients. */
+
+static bool drain(void)
+{
+  uint64_t start = now_ns();
+
+  while (used_segs() != 0)
+    {
+      if (now_ns() - start > (uint64_t)REPLAY_DRAIN_TIMEOUT_MS * 1000000)
+        {
+          printf("  %u segments are not released\n", used_segs());
+          return false;
+        }
+
+      usleep(1000);
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Setup
+ ****************************************************************************/
+
+static bool init_libraries(void)
+{
+  void *area = mmap(reinterpret_cast<void *>(REPLAY_TOP_DRM),
+                    REPLAY_AREA_SIZE,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                    -1, 0);
+  if (area != reinterpret_cast<void *>(REPLAY_TOP_DRM))
+    {
+      printf("Cannot map the area at 0x%08x\n", REPLAY_TOP_DRM);
+      return false;
+    }
+
+  if ((REPLAY_QUE_AREA_DRM + REPLAY_QUE_SIZE * REPLAY_QUE_NUM >
+       REPLAY_POOL_ADDR) ||
+      (POOL_END_ADDR > REPLAY_TOP_DRM + REPLAY_AREA_SIZE))
+    {
+      printf("Lack of the area\n");
+      return false;
+    }
+
+  if (MsgLib::initFirst(NUM_MSGQ_POOLS, REPLAY_TOP_DRM) != ERR_OK ||
+      MsgLib::initPerCpu() != ERR_OK)
+    {
+      printf("MsgLib initialize error\n");
+      return false;
+    }
+
+  if (Manager::initFirst(s_manager_area, sizeof(s_manager_area)) != ERR_OK ||
+      Manager::initPerCpu(s_manager_area, s_pools, s_pool_num,
+                          s_layout_no) != ERR_OK ||
+      Manager::createStaticPools(0, 0, s_work_area, sizeof(s_work_area),
+                                 s_layout) != ERR_OK)
+    {
+      printf("MemMgrLite initialize error\n");
+      return false;
+    }
+
+  host_mptask_register(STEP_COUNTER_WORKER_NAME, step_counter_worker);
+  sem_init(&s_sync, 0, 0);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool start_sensors(void)
+{
+  if (!SS_ActivateSensorSubSystem(MSGQ_SEN_MGR, api_response))
+    {
+      printf("SS_ActivateSensorSubSystem error\n");
+      return false;
+    }
+
+  /* The manager is created by its task, which runs first by the priority
+   * on the target. Wait for it here.
+   */
+
+  sensor_delivery_stats_t stats;
+
+  while (!SS_GetSensorDeliveryStats(accelID, &stats))
+    {
+      usleep(100);
+    }
+
+  /* Physical sensors, then logical sensors and applications. */
+
+  register_client(accelID,    0, NULL, NULL);
+  register_client(magID,      0, NULL, NULL);
+  register_client(pressureID, 0, NULL, press_power);
+  register_client(tempID,     0, NULL, temp_power);
+  register_client(gnssID,     0, NULL, NULL);
+
+  register_client(stepcounterID, (1 << accelID) | (1 << gnssID),
+                  step_counter_receive_data, NULL);
+  register_client(barometerID, (1 << pressureID) | (1 << tempID),
+                  barometer_receive_data, NULL);
+
+  register_client(app0ID, 1 << stepcounterID, app0_receive_steps, NULL);
+  register_client(app1ID, 1 << barometerID, app1_receive_pressure, NULL);
+  register_client(app2ID, 1 << accelID, app2_detect_tap, NULL);
+  register_client(app3ID, (1 << magID) | (1 << gnssID),
+                  app3_receive_data, NULL);
+
+  s_step_counter = StepCounterCreate(CMD_POOL);
+  if (StepCounterOpen(s_step_counter) != SS_ECODE_OK)
+    {
+      printf("StepCounterOpen error\n");
+      return false;
+    }
+
+  StepCounterSetting set;
+  set.walking.step_length = STEP_COUNTER_INITIAL_WALK_STEP_LENGTH;
+  set.walking.step_mode   = STEP_COUNTER_MODE_FIXED_LENGTH;
+  set.running.step_length = STEP_COUNTER_INITIAL_RUN_STEP_LENGTH;
+  set.running.step_mode   = STEP_COUNTER_MODE_FIXED_LENGTH;
+  if (StepCounterSet(s_step_counter, &set) != SS_ECODE_OK)
+    {
+      printf("StepCounterSet error\n");
+      return false;
+    }
+
+  s_barometer = BarometerCreate();
+  s_barometer->setAdjustParam(const_cast<bmp280_press_adj_s *>(&s_press_adj));
+  s_barometer->setAdjustParam(const_cast<bmp280_temp_adj_s *>(&s_temp_adj));
+  BarometerOpen(s_barometer);
+  BarometerStart(s_barometer);
+
+  ST_TAP_OPEN param = s_tap_param;
+  s_tap = TapCreate();
+  TapOpen(s_tap, &param);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static void close_sensors(void)
+{
+  BarometerClose(s_barometer);
+  StepCounterClose(s_step_counter);
+  TapClose(s_tap);
+
+  /* Release from the subscribers, the manager processes them in order. */
+
+  static const SensorClientID ids[] =
+  {
+    app0ID, app1ID, app2ID, app3ID, stepcounterID, barometerID,
+    accelID, magID, pressureID, tempID, gnssID
+  };
+
+  for (size_t i = 0; i < sizeof(ids) / sizeof(ids[0]); i++)
+    {
+      release_client(ids[i]);
+    }
+
+  sync_manager();
+}
+
+/****************************************************************************
+ * Report and Test
+ ****************************************************************************/
+
+static void report(const Trace &trace, uint64_t wall_ns, uint64_t cpu)
+{
+  double sec = trace.empty() ? 0.0 :
+               (double)(trace.back().time - trace.front().time) / 1e6;
+
+  printf("trace: %.1f sec, %zu samples\n", sec, trace.size());
+  for (int t = 0; t < NumSampleTypes; t++)
+    {
+      printf("  %-5s %6u batches\n", s_type_name[t], s_rec.sent[t]);
+    }
+
+  printf("replay: %.3f sec (x%.0f of real time), cpu %.3f sec, "
+         "%u waits for the pipeline\n",
+         wall_ns / 1e9, (wall_ns != 0) ? sec * 1e9 / wall_ns : 0.0,
+         cpu / 1e9, s_rec.alloc_waits);
+
+  printf("detections:\n");
+  printf("  taps          %zu events\n", s_rec.taps.size());
+  printf("  steps         %u (%u results, %.1f m)\n",
+         s_rec.steps, s_rec.step_results, s_rec.distance);
+  if (!s_rec.compensated.empty())
+    {
+      printf("  pressure      %zu samples, %u .. %u Pa\n",
+             s_rec.compensated.size(),
+             *std::min_element(s_rec.compensated.begin(),
+                               s_rec.compensated.end()),
+             *std::max_element(s_rec.compensated.begin(),
+                               s_rec.compensated.end()));
+
+      BarometerTrend trend;
+
+      BarometerGetTrend(s_barometer, &trend);
+      printf("  last block    %u Pa, %.1f m, %.2f Pa/s\n",
+             trend.pressure, trend.altitude, trend.trend);
+    }
+  printf("  mag/gnss      %u / %u\n", s_rec.mag, s_rec.gnss);
+
+  printf("client               calls   avg(us)   max(us)  "
+         "latency avg/max(us)  queued_max  dropped\n");
+  for (int i = 0; i < NumStages; i++)
+    {
+      const Stage            &s = s_stage[i];
+      sensor_delivery_stats_t d;
+
+      memset(&d, 0, sizeof(d));
+      SS_GetSensorDeliveryStats(s.id, &d);
+
+      printf("  %-18s %6u %9.2f %9.2f %10.1f/%-9u %10u %8u\n",
+             s.name, s.count,
+             (s.count != 0) ? s.total_ns / 1e3 / s.count : 0.0,
+             s.max_ns / 1e3,
+             (d.delivered != 0) ? (double)d.latency_total / d.delivered : 0.0,
+             d.latency_max, d.queued_max, d.dropped);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static Events reference_taps(void)
+{
+  TapClass    tap;
+  ST_TAP_OPEN param = s_tap_param;
+  Events      events;
+  size_t      n = 0;
+
+  tap.open(&param);
+
+  for (size_t b = 0; b < s_rec.accel_time.size(); b++)
+    {
+      uint32_t interval = 1000000 / s_rec.accel_fs[b];
+
+      for (uint32_t i = 0; i < ACCEL_WATERMARK_NUM; i++, n++)
+        {
+          ST_TAP_ACCEL accel;
+          uint64_t     ts = s_rec.accel_time[b] + (uint64_t)interval * i;
+
+          accel.accel_x = s_rec.accel[n].ax;
+          accel.accel_y = s_rec.accel[n].ay;
+          accel.accel_z = s_rec.accel[n].az;
+
+          int cnt = tap.write(&accel, ts);
+          if (cnt > 0)
+            {
+              Event e = { cnt, ts };
+              events.push_back(e);
+            }
+        }
+    }
+
+  tap.close();
+
+  return events;
+}
+
+/*--------------------------------------------------------------------------*/
+#define CHECK(exp) \
+  do { \
+    if (!(exp)) \
+      { \
+        printf("  FAIL: %s (line %d)\n", #exp, __LINE__); \
+        ok = false; \
+      } \
+  } while (0)
+
+static bool check(void)
+{
+  bool ok = true;
+
+  printf("test:\n");
+
+  /* Reference formula, the example of the datasheet. The 32bit integer
+   * formula gives 100656 Pa, where the 64bit one gives 100653 Pa.
+   */
+
+  int32_t t_fine = ref_t_fine(519888);
+  CHECK(((t_fine * 5 + 128) >> 8) == 2508);
+  CHECK(ref_pressure(415148, t_fine) == 100656);
+
+  CHECK(s_rec.api_errors == 0);
+  CHECK(s_rec.write_errors == 0);
+  CHECK(s_rec.power_on[pressureID] == 1 && s_rec.power_on[tempID] == 1);
+  CHECK(!s_rec.power[pressureID] && !s_rec.power[tempID]);
+
+  /* Taps are same as the library called directly. */
+
+  Events ref = reference_taps();
+  CHECK(!ref.empty());
+  CHECK(s_rec.taps == ref);
+
+  /* Steps are same as the detector called directly. */
+
+  HostStepDetector detector;
+  detector.update(&s_rec.accel[0], s_rec.accel.size(), SYN_ACCEL_FS);
+  CHECK(detector.get_steps() > 0);
+  CHECK(s_rec.steps == detector.get_steps());
+  CHECK(s_rec.step_results == s_rec.sent[TypeAccel] + s_rec.sent[TypeGnss]);
+
+  /* Pressure is same as the reference formula. */
+
+  CHECK(!s_rec.pressure.empty());
+  CHECK(s_rec.compensated == s_rec.pressure);
+
+  /* Trend is of the last block. */
+
+  BarometerTrend trend;
+  double         mean = 0.0;
+  size_t         last;
+
+  BarometerGetTrend(s_barometer, &trend);
+  CHECK(trend.num == BAROMETER_PRESSURE_WATERMARK_NUM);
+
+  last = (s_rec.pressure.size() > trend.num) ?
+         s_rec.pressure.size() - trend.num : 0;
+  for (size_t i = last; i < s_rec.pressure.size(); i++)
+    {
+      mean += s_rec.pressure[i] / (double)trend.num;
+    }
+  CHECK(fabs(trend.pressure - mean) <= 1.0);
+
+  CHECK(s_rec.mag == s_rec.sent[TypeMag]);
+  CHECK(s_rec.gnss == s_rec.sent[TypeGnss]);
+
+  /* Delivery statistics of each client. */
+
+  uint32_t expected[NumStages] =
+  {
+    s_rec.sent[TypeAccel] + s_rec.sent[TypeGnss],
+    s_rec.sent[TypePress] + s_rec.sent[TypeTemp],
+    s_rec.sent[TypeAccel] + s_rec.sent[TypeGnss],
+    (uint32_t)(s_rec.pressure.size() / BAROMETER_PRESSURE_WATERMARK_NUM),
+    s_rec.sent[TypeAccel],
+    s_rec.sent[TypeMag] + s_rec.sent[TypeGnss],
+  };
+
+  for (int i = 0; i < NumStages; i++)
+    {
+      sensor_delivery_stats_t d;
+
+      CHECK(SS_GetSensorDeliveryStats(s_stage[i].id, &d));
+      CHECK(d.delivered == expected[i]);
+      CHECK(d.dropped == 0);
+      CHECK(s_stage[i].count == expected[i]);
+    }
+
+  printf("  %s\n", ok ? "OK" : "NG");
+
+  return ok;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Data without MemHandle, by value and by pointer. The asynchronous
+ * delivery doesn't accept the pointer, which may be released before the
+ * client receives it.
+ */
+
+static void send_plain(bool is_ptr, uint32_t *value)
+{
+  sensor_command_data_t packet;
+
+  packet.header.size = 0;
+  packet.header.code = SendData;
+  packet.self        = lightID;
+  packet.time        = 0;
+  packet.fs          = 1;
+  packet.size        = 1;
+  packet.is_ptr      = is_ptr;
+
+  if (is_ptr)
+    {
+      packet.adr = value;
+    }
+  else
+    {
+      packet.data = *value;
+    }
+
+  SS_SendSensorData(&packet);
+}
+
+/*--------------------------------------------------------------------------*/
+static bool check_plain(void)
+{
+  bool ok = true;
+  static uint32_t by_value = 0x1234;
+  static uint32_t by_ptr   = 0x5678;
+
+  printf("test of data without MemHandle:\n");
+
+  sensor_command_register_t reg;
+
+  register_client(lightID, 0, NULL, NULL);
+  reg.header.size   = 0;
+  reg.header.code   = ResisterClient;
+  reg.self          = reserve19ID;
+  reg.subscriptions = 1 << lightID;
+  reg.callback      = plain_receive_data;
+  reg.callback_mh   = NULL;
+  reg.callback_pw   = NULL;
+  SS_SendSensorResister(&reg);
+  sync_manager();
+
+  uint32_t errors = s_rec.api_errors;
+
+  send_plain(false, &by_value);
+  send_plain(true, &by_ptr);
+  sync_manager();
+
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  std::vector<uint32_t> expected(1, by_value);
+  uint32_t              rejected = 1;
+#else
+  std::vector<uint32_t> expected(1, by_value);
+  uint32_t              rejected = 0;
+
+  expected.push_back(by_ptr);
+#endif
+
+  sensor_delivery_stats_t d;
+
+  for (int retry = 0; retry < 1000; retry++)
+    {
+      if (SS_GetSensorDeliveryStats(reserve19ID, &d) &&
+          d.delivered >= expected.size())
+        {
+          break;
+        }
+
+      usleep(1000);
+    }
+
+  release_client(reserve19ID);
+  release_client(lightID);
+  sync_manager();
+
+  pthread_mutex_lock(&s_lock);
+  CHECK(s_rec.plain == expected);
+  CHECK(s_rec.api_errors == errors + rejected);
+  pthread_mutex_unlock(&s_lock);
+
+  printf("  %s\n", ok ? "OK" : "NG");
+
+  return ok;
+}
+
+/*--------------------------------------------------------------------------*/
+static void usage(const char *name)
+{
+  printf("usage: %s [-t] [-s speed] [file.csv ...]\n"
+         "  -t        test with the synthetic trace\n"
+         "  -s speed  replay at speed times real time (default: no wait)\n"
+         "  file.csv  trace of \"time_us,type,v1[,v2,v3]\" lines, type is\n"
+         "            accel,mag [G][uT], press,temp [raw ADC],\n"
+         "            gnss [lat,lon,velocity]\n",
+         name);
+  exit(EXIT_FAILURE);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  bool   test = false;
+  double speed = 0.0;
+  Trace  trace;
+  int    opt;
+
+  while ((opt = getopt(argc, argv, "ts:")) != -1)
+    {
+      switch (opt)
+        {
+          case 't':
+            test = true;
+            break;
+
+          case 's':
+            speed = atof(optarg);
+            break;
+
+          default:
+            usage(argv[0]);
+        }
+    }
+
+  if (test && optind < argc)
+    {
+      usage(argv[0]);
+    }
+
+  if (optind < argc)
+    {
+      for (int i = optind; i < argc; i++)
+        {
+          if (!load_csv(argv[i], &trace))
+            {
+              return EXIT_FAILURE;
+            }
+        }
+
+      std::stable_sort(trace.begin(), trace.end());
+    }
+  else
+    {
+      trace = make_synthetic();
+    }
+
+  if (!init_libraries() || !start_sensors())
+    {
+      return EXIT_FAILURE;
+    }
+
+  uint64_t cpu = cpu_ns();
+  uint64_t start = now_ns();
+  bool     ok = replay(trace, speed) && drain();
+  uint64_t wall = now_ns() - start;
+
+  cpu = cpu_ns() - cpu;
+
+  BarometerStop(s_barometer);
+  sync_manager();
+
+  report(trace, wall, cpu);
+
+  if (ok && test)
+    {
+      ok = check() && check_plain();
+    }
+
+  close_sensors();
+  SS_DeactivateSensorSubSystem();
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,223 @@
+/****************************************************************************
+ * modules/sensing/tool/host/step_counter_worker.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "host_asmp.h"
+#include "step_counter_worker.h"
+#include "dsp_sensor_version.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Same as step_counter.cpp. */
+
+#define STEPCOUNTER_MQ_ID   1
+#define DSP_BOOTED_CMD_ID   1
+#define STEPCOUNTER_CMD_ID  2
+
+/* Step is a peak of the magnitude over STEP_HIGH_G after it went under
+ * STEP_LOW_G, and steps closer than 1/STEP_MAX_TEMPO second are ignored.
+ */
+
+#define STEP_HIGH_G         1.15F
+#define STEP_LOW_G          1.05F
+#define STEP_MAX_TEMPO      4
+#define STEP_STILL_SEC      2
+#define STEP_RUN_TEMPO      2.5F
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static HostStepDetector   s_detector;
+static StepCounterSetting s_setting;
+static float              s_distance;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void update_acceleration(FAR SensorCmdStepCounter *cmd)
+{
+  FAR ThreeAxisSampleData *acc = &cmd->exec_cmd.update_acc;
+  uint32_t prev = s_detector.get_steps();
+  uint32_t steps = s_detector.update(acc->p_data,
+                                     acc->sample_num,
+                                     acc->sampling_rate);
+  float tempo = s_detector.get_tempo();
+  bool  still = (s_detector.get_since() >=
+                 (uint32_t)acc->sampling_rate * STEP_STILL_SEC);
+  bool  run = (tempo >= STEP_RUN_TEMPO);
+  float stride = (float)(run ? s_setting.running.step_length :
+                               s_setting.walking.step_length);
+
+  s_distance += (float)(steps - prev) * stride / 100.0F;
+
+  FAR StepCounterStepInfo *info = &cmd->result.steps;
+
+  info->tempo    = still ? 0.0F : tempo;
+  info->stride   = stride;
+  info->speed    = info->tempo * stride / 100.0F;
+  info->distance = s_distance;
+  info->step     = steps;
+  info->movement_type = still ? STEP_COUNTER_MOVEMENT_TYPE_STILL :
+                        run   ? STEP_COUNTER_MOVEMENT_TYPE_RUN :
+                                STEP_COUNTER_MOVEMENT_TYPE_WALK;
+  info->time_stamp = acc->time_stamp +
+                     ((acc->sampling_rate != 0) ?
+                      (uint64_t)acc->sample_num * 1000 / acc->sampling_rate :
+                      0);
+}
+
+/*--------------------------------------------------------------------------*/
+static void execute(FAR SensorCmdStepCounter *cmd)
+{
+  switch (cmd->exec_cmd.cmd_type)
+    {
+      case STEP_COUNTER_CMD_UPDATE_ACCELERATION:
+        update_acceleration(cmd);
+        break;
+
+      case STEP_COUNTER_CMD_UPDATE_GPS:
+
+        /* GNSS is not used for the stride. Return the last steps. */
+
+        memset(&cmd->result.steps, 0, sizeof(cmd->result.steps));
+        cmd->result.steps.step     = s_detector.get_steps();
+        cmd->result.steps.distance = s_distance;
+        break;
+
+      case STEP_COUNTER_CMD_STEP_SET:
+        s_setting = cmd->exec_cmd.setting;
+        break;
+
+      default:
+        cmd->result.exec_result = SensorError;
+        return;
+    }
+
+  cmd->result.exec_result = SensorOK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void HostStepDetector::reset(void)
+{
+  m_steps = 0;
+  m_since = 0;
+  m_armed = false;
+  m_tempo = 0.0F;
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t HostStepDetector::update(const ThreeAxisSample *data,
+                                  uint32_t num,
+                                  uint32_t fs)
+{
+  const float high2 = STEP_HIGH_G * STEP_HIGH_G;
+  const float low2  = STEP_LOW_G * STEP_LOW_G;
+  uint32_t    min_interval = fs / STEP_MAX_TEMPO;
+  uint32_t    still = fs * STEP_STILL_SEC;
+
+  for (uint32_t i = 0; i < num; i++)
+    {
+      float r2 = data[i].ax * data[i].ax +
+                 data[i].ay * data[i].ay +
+                 data[i].az * data[i].az;
+
+      m_since++;
+
+      if (r2 < low2)
+        {
+          m_armed = true;
+        }
+      else if (m_armed && (r2 > high2) && (m_since >= min_interval))
+        {
+          /* The first step after still has no tempo. */
+
+          m_tempo = (m_since >= still) ? 0.0F : (float)fs / (float)m_since;
+          m_steps++;
+          m_since = 0;
+          m_armed = false;
+        }
+    }
+
+  return m_steps;
+}
+
+/*--------------------------------------------------------------------------*/
+int step_counter_worker(void)
+{
+  int      id;
+  uint32_t data;
+
+  s_detector.reset();
+  s_distance = 0.0F;
+
+  host_mpmq_worker_send(STEPCOUNTER_MQ_ID,
+                        DSP_BOOTED_CMD_ID,
+                        DSP_STEP_COUNTER_VERSION);
+
+  while ((id = host_mpmq_worker_receive(STEPCOUNTER_MQ_ID, &data)) >= 0)
+    {
+      /* Data is the address of the command in the pool (under 4GB). */
+
+      FAR SensorCmdStepCounter *cmd =
+        reinterpret_cast<FAR SensorCmdStepCounter *>((uintptr_t)data);
+
+      if (cmd->header.event_type == InitEvent)
+        {
+          s_setting = cmd->init_cmd.setting;
+          cmd->result.exec_result = SensorOK;
+        }
+      else
+        {
+          execute(cmd);
+        }
+
+      host_mpmq_worker_send(STEPCOUNTER_MQ_ID, STEPCOUNTER_CMD_ID, data);
+    }
+
+  return 0;
+}
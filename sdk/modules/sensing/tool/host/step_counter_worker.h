@@ -0,0 +1,101 @@
+/****************************************************************************
+ * modules/sensing/tool/host/step_counter_worker.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host stand-in of the step counter worker (DSP).
+ *
+ * The step counter algorithm runs on the DSP and is not available on
+ * the host. This worker speaks the same protocol as the DSP, so that
+ * StepCounterClass and the data flow through the sensor manager are
+ * exercised, and counts the steps by a simple peak detection of the
+ * magnitude of acceleration. The step count is not comparable with the
+ * DSP, and the processing time of the worker is not of the target.
+ */
+
+#ifndef __SENSING_TOOL_HOST_STEP_COUNTER_WORKER_H
+#define __SENSING_TOOL_HOST_STEP_COUNTER_WORKER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+
+#include "sensing/logical_sensor/step_counter_command.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* File name of the worker given to mptask_init_secure(). */
+
+#define STEP_COUNTER_WORKER_NAME  "AESM"
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+class HostStepDetector
+{
+public:
+
+  HostStepDetector() { reset(); }
+
+  void reset(void);
+
+  /* Update by accel data, and return the total number of steps. */
+
+  uint32_t update(const ThreeAxisSample *data, uint32_t num, uint32_t fs);
+
+  uint32_t get_steps(void) const { return m_steps; }
+  float    get_tempo(void) const { return m_tempo; }
+  uint32_t get_since(void) const { return m_since; }
+
+private:
+
+  uint32_t m_steps;    /* Total number of steps */
+  uint32_t m_since;    /* Samples since the last step */
+  bool     m_armed;    /* Magnitude went under the low threshold */
+  float    m_tempo;    /* Tempo of the last step [Hz] */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* Entry of the worker, register it by host_mptask_register(). */
+
+int step_counter_worker(void);
+
+#endif /* __SENSING_TOOL_HOST_STEP_COUNTER_WORKER_H */
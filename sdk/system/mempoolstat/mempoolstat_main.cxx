@@ -0,0 +1,115 @@
+/****************************************************************************
+ * system/mempoolstat/mempoolstat_main.cxx
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sdk/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "memutils/memory_manager/Manager.h"
+
+using namespace MemMgrLite;
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MEMPOOLSTAT_MAX_SECTIONS 4
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void mempoolstat_usage(void)
+{
+  printf("Usage: mempoolstat [-c] [-s sec]\n");
+  printf("  -c      Clear the statistics after showing\n");
+  printf("  -s sec  Show the pools of the section (default: 0)\n");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+extern "C" int main(int argc, FAR char *argv[])
+#else
+extern "C" int mempoolstat_main(int argc, char *argv[])
+#endif
+{
+  bool clear = false;
+  int  sec   = 0;
+  int  opt;
+
+  while ((opt = getopt(argc, argv, "cs:")) != -1)
+    {
+      switch (opt)
+        {
+          case 'c':
+            clear = true;
+            break;
+
+          case 's':
+            sec = atoi(optarg);
+            break;
+
+          default:
+            mempoolstat_usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+  if (sec < 0 || sec >= MEMPOOLSTAT_MAX_SECTIONS ||
+      !Manager::isStaticPoolAvailable(sec))
+    {
+      printf("No memory pools in section %d\n", sec);
+      return EXIT_FAILURE;
+    }
+
+  Manager::dumpPoolStats(sec);
+
+  if (clear)
+    {
+      Manager::clearStaticPoolsStats(sec);
+      Manager::clearAllocFailLog();
+    }
+
+  return EXIT_SUCCESS;
+}
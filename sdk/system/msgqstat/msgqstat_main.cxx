@@ -0,0 +1,135 @@
+/****************************************************************************
+ * system/msgqstat/msgqstat_main.cxx
+ *
+ *   Copyright 2019 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sdk/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "memutils/message/Message.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void msgqstat_usage(void)
+{
+  printf("Usage: msgqstat [-c] [-i id]\n");
+  printf("  -c     Clear the statistics after showing\n");
+  printf("  -i id  Show the latency histogram of the queue\n");
+}
+
+static void msgqstat_hist(MsgQueId id)
+{
+  MsgQueStats stats;
+
+  if (MsgLib::getStats(id, stats) != ERR_OK)
+    {
+      printf("Bad queue id: %d\n", id);
+      return;
+    }
+
+  printf("=== Latency histogram of queue %d\n", id);
+  printf("      <1us: %u\n", stats.latency_hist[0]);
+
+  for (uint32_t bin = 1; bin < MSG_STATS_LATENCY_BINS; bin++)
+    {
+      printf("%8uus-: %u\n", 1u << (bin - 1), stats.latency_hist[bin]);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+extern "C" int main(int argc, FAR char *argv[])
+#else
+extern "C" int msgqstat_main(int argc, char *argv[])
+#endif
+{
+  bool clear = false;
+  int  id    = -1;
+  int  opt;
+
+  while ((opt = getopt(argc, argv, "ci:")) != -1)
+    {
+      switch (opt)
+        {
+          case 'c':
+            clear = true;
+            break;
+
+          case 'i':
+            id = atoi(optarg);
+            break;
+
+          default:
+            msgqstat_usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+  if (id < 0)
+    {
+      MsgLib::dumpStats();
+    }
+  else
+    {
+      msgqstat_hist(id);
+    }
+
+  if (clear)
+    {
+      if (id < 0)
+        {
+          for (id = 1; MsgLib::clearStats(id) == ERR_OK; id++)
+            {
+            }
+        }
+      else
+        {
+          MsgLib::clearStats(id);
+        }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,345 @@
+#!/usr/bin/env python3
+############################################################################
+# tools/layout_solver.py
+#
+#   Copyright 2019 Sony Semiconductor Solutions Corporation
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+#    the names of its contributors may be used to endorse or promote
+#    products derived from this software without specific prior written
+#    permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+#
+# Shrink mem_layout.conf / msgq_layout.conf to the usage recorded on target.
+#
+# The usage trace is the console log of the "mempoolstat" and "msgqstat"
+# NSH commands (CONFIG_MEMUTILS_MEMORY_MANAGER_STATS and
+# CONFIG_MEMUTILS_MESSAGE_STATS), captured after running the application
+# through its worst case scenario. Several logs may be given, and the
+# maximum of all of them is used.
+#
+# Pools and queues are resized to the recorded peak plus the margin.
+# Sizes and numbers are never increased, and pools with allocation
+# errors are left as they are because their peak is not the real demand.
+#
+# Queue element sizes are kept as configured, because message types not
+# sent while the log was captured would fail with ERR_DATA_SIZE. They are
+# trimmed to the largest received parameter only with --trim-queue-size.
+#
+
+import os
+import re
+import sys
+import math
+import argparse
+import importlib
+
+ToolDir = os.path.dirname(os.path.abspath(__file__))
+
+MSG_HEADER_SIZE = 8     # Fixed header length of message packet
+MSG_STAMP_SIZE  = 4     # Added by MsgTimestamp
+MSG_TYPE_SIZE   = 4     # Added by MsgParamTypeMatchCheck
+
+#
+# Usage trace
+#
+
+class PoolTrace:
+    def __init__(self):
+        self.segs = 0
+        self.peak = 0
+        self.fail = 0
+
+class QueueTrace:
+    def __init__(self):
+        self.max   = [0, 0]
+        self.param = 0
+        self.full  = 0
+        self.size  = 0
+
+RePoolSection = re.compile(r"^section\s+(\d+)\s+layout\s+(\d+)\s*$")
+RePoolRow     = re.compile(r"^\s*(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+\d+\.\d+\s+(\d+)\s+(\d+)\s+(\d+)\s*$")
+ReQueueRow    = re.compile(r"^\s*(\d+)\s+\d+/\s*\d+\s+(\d+)/\s*(\d+)\s+\d+/\s*\d+\s+\d+/\s*\d+"
+                           r"\s+\d+\s+(\d+)\s+(\d+)\s+(\d+)\s+\d+\s+\d+\s*$")
+
+def read_trace(files):
+    pools  = {}   # (section, layout, id) -> PoolTrace
+    queues = {}   # id -> QueueTrace
+    for name in files:
+        section = None
+        with open(name, errors='replace') as f:
+            for line in f:
+                line = line.rstrip('\r\n')
+                m = RePoolSection.match(line)
+                if m:
+                    section = (int(m.group(1)), int(m.group(2)))
+                    continue
+                m = RePoolRow.match(line)
+                if m and section is not None:
+                    key = section + (int(m.group(1)),)
+                    t = pools.setdefault(key, PoolTrace())
+                    t.segs  = int(m.group(2))
+                    t.peak  = max(t.peak, int(m.group(4)))
+                    t.fail += int(m.group(7))
+                    continue
+                m = ReQueueRow.match(line)
+                if m:
+                    t = queues.setdefault(int(m.group(1)), QueueTrace())
+                    t.max[0] = max(t.max[0], int(m.group(2)))
+                    t.max[1] = max(t.max[1], int(m.group(3)))
+                    t.full  += int(m.group(4))
+                    t.size  += int(m.group(5))
+                    t.param  = max(t.param, int(m.group(6)))
+    return pools, queues
+
+#
+# Layout configuration
+#
+# The configuration file is executed with generate_files() replaced,
+# so that only the parsed layout remains in the module.
+#
+
+def load_conf(module_name, conf, argv):
+    sys.path.insert(0, ToolDir)
+    save_argv, save_cwd = sys.argv, os.getcwd()
+    sys.argv = [module_name] + argv
+    try:
+        module = importlib.import_module(module_name)
+        module.generate_files = lambda: None
+        os.chdir(os.path.dirname(os.path.abspath(conf)))
+        with open(os.path.basename(conf)) as f:
+            code = compile(f.read(), conf, 'exec')
+        exec(code, {'__name__': '__main__', '__file__': conf})
+    finally:
+        sys.argv = save_argv
+        os.chdir(save_cwd)
+    return module
+
+def ceil_margin(value, margin):
+    return max(1, int(math.ceil(value * (100 + margin) / 100.0)))
+
+def round_up4(value):
+    return (value + 3) & ~3
+
+#
+# Memory pool solver
+#
+
+def solve_pools(ml, traces, margin):
+    result  = []
+    type_names = {ml.Basic: "Basic", ml.RingBuf: "RingBuf", ml.Bitmap: "Bitmap"}
+    for layout in ml.PoolAreas.layouts:
+
+        # Pool IDs are given in order of appearance in the section
+
+        ids = []
+        for other in ml.PoolAreas.layouts:
+            if other.section == layout.section:
+                for pool in other.pools:
+                    if pool.name not in ids:
+                        ids.append(pool.name)
+
+        for pool in layout.pools:
+            r = {'pool': pool, 'segs': pool.num_seg, 'size': pool.size,
+                 'peak': None, 'note': ""}
+            t = traces.get((layout.section, layout.layout, ids.index(pool.name) + 1))
+            if t is None:
+                r['note'] = "no trace"
+            elif t.segs != pool.num_seg:
+                r['note'] = "segs mismatch ({0} on target)".format(t.segs)
+            else:
+                r['peak'] = t.peak
+                if t.fail:
+                    r['note'] = "{0} alloc errors, kept".format(t.fail)
+                elif pool.type == ml.RingBuf:
+                    r['note'] = "RingBuf, kept"
+                else:
+                    seg_size  = pool.size // pool.num_seg
+                    r['segs'] = min(pool.num_seg, ceil_margin(t.peak, margin))
+                    r['size'] = seg_size * r['segs']
+            r['type'] = type_names.get(pool.type, "?")
+            result.append((layout, r))
+    return result
+
+def report_pools(out, result):
+    out.write("Memory pools\n")
+    out.write("  sec lay name                      type     segs  peak   new      size       new     saved  note\n")
+    total = 0
+    for layout, r in result:
+        pool  = r['pool']
+        saved = pool.size - r['size']
+        total += saved
+        out.write("  {0:3d} {1:3d} {2:<25s} {3:<7s} {4:5d} {5:>5s} {6:5d}  {7:8d}  {8:8d}  {9:8d}  {10}\n".format(
+            layout.section, layout.layout, pool.name, r['type'], pool.num_seg,
+            "-" if r['peak'] is None else str(r['peak']), r['segs'],
+            pool.size, r['size'], saved, r['note']))
+    out.write("  total saved: {0} bytes\n\n".format(total))
+
+def output_pools(out, result):
+    out.write("# Suggested pool layout (section/layout order as mem_layout.conf)\n")
+    cur = None
+    for layout, r in result:
+        pool = r['pool']
+        if cur is None or cur.section != layout.section:
+            if cur is not None:
+                out.write("  ], # end of layout {0}\n  None # end of definition\n)\n".format(cur.layout))
+            out.write("PoolAreas.init(\n  [ # layout {0}\n".format(layout.layout))
+        elif cur.layout != layout.layout:
+            out.write("  ], # end of layout {0}\n  [ # layout {1}\n".format(cur.layout, layout.layout))
+        cur = layout
+        out.write("    [{0:<24s} {1:<20s} 0x{2:x}, 0x{3:08x}, {4:5d}, {5}, {6}],\n".format(
+            "\"" + pool.name + "\",", "\"" + pool.area_entry.name + "\",",
+            pool.align, r['size'], r['segs'], pool.fence_flag, r['type']))
+    if cur is not None:
+        out.write("  ], # end of layout {0}\n  None # end of definition\n)\n\n".format(cur.layout))
+
+#
+# Message queue solver
+#
+
+def solve_queues(mq, traces, margin, trim_size):
+    extra  = MSG_STAMP_SIZE if mq.MsgTimestamp else 0
+    result = []
+    for index, line in enumerate(mq.MsgQuePool):
+        if line is None:
+            break
+        qid, n_size, n_num, h_size, h_num = line[0:5]
+        r = {'line': line, 'n_size': n_size, 'n_num': n_num,
+             'h_size': h_size, 'h_num': h_num, 'trace': None, 'note': ""}
+        t = traces.get(index + 1)
+        if t is None:
+            r['note'] = "no trace"
+        elif t.full or t.size:
+            r['trace'] = t
+            r['note']  = "send errors, kept"
+        else:
+            r['trace']  = t
+            r['n_num']  = min(n_num, ceil_margin(t.max[0], margin))
+            if h_num:
+                r['h_num'] = min(h_num, ceil_margin(t.max[1], margin))
+
+            # Only the received types are known, so the packet size is
+            # trimmed only on request and if a parameter was seen.
+
+            if trim_size and t.param:
+                size = max(mq.MIN_PACKET_SIZE, round_up4(MSG_HEADER_SIZE + t.param))
+                r['n_size'] = min(n_size, size)
+                if h_size:
+                    r['h_size'] = min(h_size, size)
+                if r['n_size'] != n_size:
+                    r['note'] = "size from received params"
+
+        def area(size, num):
+            if size == 0:
+                return 0
+            if mq.MsgParamTypeMatchCheck and size > mq.MIN_PACKET_SIZE:
+                size += MSG_TYPE_SIZE
+            return (size + extra) * num
+
+        r['old'] = area(n_size, n_num) + area(h_size, h_num)
+        r['new'] = area(r['n_size'], r['n_num']) + area(r['h_size'], r['h_num'])
+        result.append(r)
+    return result
+
+def report_queues(out, result):
+    out.write("Message queues\n")
+    out.write("  id name                           n_size n_num h_size h_num  max(n/h) param   new(size/num n, h)      old    saved  note\n")
+    total = 0
+    for index, r in enumerate(result):
+        line, t = r['line'], r['trace']
+        saved = r['old'] - r['new']
+        total += saved
+        out.write("  {0:2d} {1:<30s} {2:6d} {3:5d} {4:6d} {5:5d} {6:>9s} {7:>5s}  {8:4d}/{9:<5d} {10:4d}/{11:<5d} {12:8d} {13:8d}  {14}\n".format(
+            index + 1, line[0], line[1], line[2], line[3], line[4],
+            "-" if t is None else "{0}/{1}".format(t.max[0], t.max[1]),
+            "-" if t is None else str(t.param),
+            r['n_size'], r['n_num'], r['h_size'], r['h_num'],
+            r['old'], saved, r['note']))
+    out.write("  total saved: {0} bytes\n\n".format(total))
+
+def output_queues(out, result):
+    out.write("# Suggested message queue pool\n")
+    out.write("msgq_layout.MsgQuePool = [\n")
+    out.write("# [ ID,                                             n_size  n_num  h_size  h_num\n")
+    for r in result:
+        line = r['line']
+        rest = "".join(", {0!r}".format(v) for v in line[5:])
+        out.write("  [{0:<50s} {1:5d}, {2:5d}, {3:5d}, {4:5d}{5}],\n".format(
+            "\"" + line[0] + "\",", r['n_size'], r['n_num'], r['h_size'], r['h_num'], rest))
+    out.write("  None # end of user definition\n] # end of MsgQuePool\n")
+
+#
+# Main routine
+#
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Minimize mem_layout/msgq_layout from mempoolstat and msgqstat logs")
+    parser.add_argument("-m", "--margin", type=int, default=25,
+                        help="safety margin added to the recorded peaks in percent (default: 25)")
+    parser.add_argument("--mem", metavar="CONF", help="mem_layout.conf of the application")
+    parser.add_argument("--msgq", metavar="CONF", help="msgq_layout.conf of the application")
+    parser.add_argument("--trim-queue-size", action="store_true",
+                        help="also trim queue element sizes to the largest received parameter")
+    parser.add_argument("-o", "--output", metavar="FILE",
+                        help="write the suggested layout to FILE instead of stdout")
+    parser.add_argument("trace", nargs="+", help="console log of mempoolstat/msgqstat")
+    args = parser.parse_args()
+
+    if args.mem is None and args.msgq is None:
+        parser.error("--mem and/or --msgq is required")
+    if args.margin < 0:
+        parser.error("margin must be 0 or more")
+
+    pool_traces, queue_traces = read_trace(args.trace)
+    out = open(args.output, "w") if args.output else sys.stdout
+
+    if args.mem:
+        ml = load_conf("mem_layout", args.mem, [])
+        if not ml.UseFixedPoolLayout:
+            sys.exit("Only fixed pool layout is supported.")
+        result = solve_pools(ml, pool_traces, args.margin)
+        report_pools(sys.stdout, result)
+        output_pools(out, result)
+
+    if args.msgq:
+        mq = load_conf("msgq_layout", args.msgq, ["-n"])
+        if mq.USE_MULTI_CORE:
+            sys.exit("Multi core message queue is not supported.")
+        if args.trim_queue_size:
+            sys.stderr.write("warning: queue element sizes are trimmed to the received parameters. "
+                             "Messages not sent while logging will fail with ERR_DATA_SIZE.\n")
+        result = solve_queues(mq, queue_traces, args.margin, args.trim_queue_size)
+        report_queues(sys.stdout, result)
+        output_queues(out, result)
+
+    if out is not sys.stdout:
+        out.close()
+
+if __name__ == "__main__":
+    main()
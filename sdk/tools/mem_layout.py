@@ -85,6 +85,8 @@ EnableOutputMacro = False
 
 Basic   = "BasicType"
 RingBuf = "RingBufType"
+Bitmap  = "BitmapType"   # Needs CONFIG_MEMUTILS_MEMORY_MANAGER_USE_BITMAP_POOL
+                         # RingBuf needs CONFIG_MEMUTILS_MEMORY_MANAGER_USE_RINGBUF_POOL
 
 MinNameSize   = 3
 FenceSize     = 4
@@ -426,7 +428,7 @@ class PoolEntry(BaseEntry):
         if MemoryDevices.at[name]:
             sys.stderr.write("Redefine name found at {0}".format(name))
             sys.exit()
-        if type != Basic and type != RingBuf:
+        if type != Basic and type != RingBuf and type != Bitmap:
             sys.stderr.write("Bad pool type found at {0}".format(name))
             sys.exit()
         if type == RingBuf and not UseRingBufPool:
@@ -463,9 +465,9 @@ class PoolEntry(BaseEntry):
 
 
 class PoolEntryFixParam(BaseEntry):
-    def __init__(self, section, layout_no, name, area, align, size, seg, fence):
+    def __init__(self, section, layout_no, name, area, align, size, seg, fence, type = Basic):
         self.area_entry = FixedAreas.at(area)
-        self.type       = Basic
+        self.type       = type
         self.align      = align
         self.num_seg    = seg
         self.skip_size  = 0
@@ -486,6 +488,9 @@ class PoolEntryFixParam(BaseEntry):
         if MemoryDevices.at(name):
             sys.stderr.write("Redefine name found at {0}".format(name))
             sys.exit()
+        if type != Basic and type != RingBuf and type != Bitmap:
+            sys.stderr.write("Bad pool type found at {0}".format(name))
+            sys.exit()
         if (align % MinAlign) != 0 or align == 0:
             sys.stderr.write("Bad pool align found at {0}".format(name))
             sys.exit()
@@ -519,8 +524,14 @@ class PoolEntryFixParam(BaseEntry):
 #  - Alignment adjustment of MemPool area         : 0-3
 #  - Pool attribute area(Usually in static pool 0): 0, 12 or 16
 #  - BasicPool(=MemPool) area                      : 12 + 4 * sizeof(NumSeg)
-#  - RingBufPool area                              : To be determined(MemPool Area+alpha)
+#  - RingBufPool area                              : MemPool area + 16
+#  - BitmapPool area                               : MemPool area + 8
 #  - Data area of the segment number queue         : Number of segments * sizeof(NumSeg)
+#                                                    (BitmapPool and RingBufPool do not have it)
+#  - Data area of the bitmap and summary bitmap     : 4 * (ceil(segs/32) + ceil(segs/1024))
+#                                                    (Only BitmapPool)
+#  - Data area of the segment descriptors          : Number of segments * 8
+#                                                    (Only RingBufPool)
 #  - Reference counter area                        : Number of segments * sizeof(SegRefCnt)
 
 NumSegSize              = 2 if UseOver255Segments else 1
@@ -528,8 +539,23 @@ SegRefCntSize           = 1
 PoolAttrSize            = round_up(10 + NumSegSize + (1 if UseFence else 0) + (1 if UseMultiCore else 0), 4)
 MemPoolDataSize         = 12 + 4 * NumSegSize   # 16 or 20
 BasicPoolDataSize       = MemPoolDataSize
-RingBufPoolDataSize     = MemPoolDataSize + 32  # Tentative value for details unexamined
-RingBufPoolSegDataSize  = 8                     # Tentative value for details unexamined
+RingBufPoolDataSize     = MemPoolDataSize + 16  # 32 or 36
+RingBufPoolSegDataSize  = 8                     # offset and size of a segment
+BitmapPoolDataSize      = MemPoolDataSize + 8   # 24 or 28
+
+
+def bitmap_size(num_seg):
+    map_words = (num_seg + 31) // 32
+    return 4 * (map_words + (map_words + 31) // 32)
+
+
+def pool_data_size(pool):
+    if pool.type == Basic:
+        return BasicPoolDataSize + pool.num_seg * NumSegSize
+    elif pool.type == Bitmap:
+        return BitmapPoolDataSize + bitmap_size(pool.num_seg)
+    else:
+        return RingBufPoolDataSize + pool.num_seg * RingBufPoolSegDataSize
 
 
 class PoolLayout:
@@ -567,8 +593,7 @@ class PoolLayout:
         for pool in self.pools:
             if section == pool.section:
                 pool_work_size  = PoolAttrSize if UseCopiedPoolAttr else 0
-                pool_work_size += BasicPoolDataSize if pool.type == Basic else RingBufPoolDataSize
-                pool_work_size += pool.num_seg * NumSegSize    # Data area of the segment number queue
+                pool_work_size += pool_data_size(pool)         # Pool object and free segment management
                 pool_work_size += pool.num_seg * SegRefCntSize # Reference counter area
 
                 # Round up to the MinAlign unit and integrate
@@ -716,7 +741,7 @@ class PoolAreas:
                 if pool.fence_flag:
                     io.write("#define S{0}_L{1}_{2}_U_FENCE  0x{3:08x}\n".format(pool.section, pool.layout, pool.name, pool.begin_addr + pool.size))
                 io.write("#define S{0}_L{1}_{2}_NUM_SEG  0x{3:08x}\n".format(pool.section, pool.layout, pool.name, pool.num_seg))
-                if pool.type == Basic:
+                if pool.type == Basic or pool.type == Bitmap:
                     io.write("#define S{0}_L{1}_{2}_SEG_SIZE 0x{3:08x}\n".format(pool.section, pool.layout, pool.name, int(pool.size / pool.num_seg)))
                 io.write("\n")
             for name_remainder in layout.used_area_info:
@@ -41,11 +41,12 @@ import traceback
 # constants
 
 ALINGMENT_SIZE  = 4             # Alignment size
-QUE_BLOCK_SIZE  = 68            # Message queue block size sizeof (MsgQueBlock)
+QUE_BLOCK_SIZE  = 72            # Message queue block size sizeof (MsgQueBlock)
 MIN_PACKET_SIZE = 8             # Minimum message packet size
 MAX_PACKET_SIZE = 512           # Maximum message packet size
 MAX_PACKET_NUM  = 16384         # Maximum number of message packets
 INVALID_DRM     = 0xffffffff    # Invalid DRM address
+QUE_MODES       = ["normal", "spsc"]    # Queue mode names (MsgQueMode)
 
 # false:Not Support multi core , ture: Support multi core
 
@@ -55,6 +56,7 @@ USE_MULTI_CORE = False
 
 MsgFillValueAfterPop   = 0x00
 MsgParamTypeMatchCheck = False
+MsgTimestamp           = False
 MsgQuePool             = []
 SpinLockPool           = []
 
@@ -228,6 +230,11 @@ def cache_align(addr):
 #
 # Message queue size and stage number analysis
 #
+# An optional last column selects the queue mode.
+#   "normal": Default. Any task/ISR can send with lock.
+#   "spsc":   Single sender and single receiver. Send and receive
+#             without lock. Not available for shared queue.
+#
 
 def getMsgQueParam(line, dup_chk):
     resv_ids = ["MSGQ_NULL", "MSGQ_TOP", "MSGQ_END"]
@@ -247,6 +254,8 @@ def getMsgQueParam(line, dup_chk):
         raise ValueError("Bad n_size at {0}".format(id))
     if MsgParamTypeMatchCheck == True and n_size > MIN_PACKET_SIZE:
         n_size += 4
+    if MsgTimestamp == True:
+        n_size += 4
 
     n_num   = line[2]
     if n_num == 0 or n_num > MAX_PACKET_NUM:
@@ -258,6 +267,8 @@ def getMsgQueParam(line, dup_chk):
 
     if MsgParamTypeMatchCheck == True and h_size > MIN_PACKET_SIZE:
         h_size += 4
+    if MsgTimestamp == True and h_size > 0:
+        h_size += 4
 
     h_num = line[4]
     if h_num > MAX_PACKET_NUM or (h_size > 0 and h_num == 0) or (h_size == 0 and h_num > 0):
@@ -280,10 +291,17 @@ def getMsgQueParam(line, dup_chk):
             n_size = (n_size + ALINGMENT_SIZE - 1) & ~(ALINGMENT_SIZE - 1)
             h_size = (h_size + ALINGMENT_SIZE - 1) & ~(ALINGMENT_SIZE - 1)
 
+    mode_index = 7 if USE_MULTI_CORE == True else 5
+    mode = line[mode_index] if len(line) > mode_index else "normal"
+    if not mode in QUE_MODES:
+        raise ValueError("Bad mode at {0}".format(id))
+    if USE_MULTI_CORE == True and mode == "spsc" and spinlock != "SPL_NULL":
+        raise ValueError("spsc mode is not available for shared queue at {0}".format(id))
+
     if USE_MULTI_CORE == True:
-        return id, spinlock, n_size, n_num, h_size, h_num, owner
+        return id, spinlock, n_size, n_num, h_size, h_num, owner, mode
     else:
-        return id, n_size, n_num, h_size, h_num
+        return id, n_size, n_num, h_size, h_num, mode
 
 #
 # Create message pool list
@@ -306,9 +324,19 @@ def parseMsgQuePool():
             break
 
         if USE_MULTI_CORE == True:
-            id, spinlock, n_size, n_num, h_size, h_num, owner = getMsgQueParam(line, dup_chk)
+            id, spinlock, n_size, n_num, h_size, h_num, owner, mode = getMsgQueParam(line, dup_chk)
+        else:
+            id, n_size, n_num, h_size, h_num, mode = getMsgQueParam(line, dup_chk)
+
+        # Normal mode entry keeps the zero-initialized mode field
+
+        if mode == "spsc":
+            if USE_MULTI_CORE == True:
+                mode_str = ", MsgQueModeSpsc"
+            else:
+                mode_str = ", 0, 0, MsgQueModeSpsc"
         else:
-            id, n_size, n_num, h_size, h_num = getMsgQueParam(line, dup_chk)
+            mode_str = ""
 
         if (USE_MULTI_CORE == True and TargetCore == owner) or TargetCore is None:
             n_drm = cache_align(msg_area_drm)
@@ -334,14 +362,14 @@ def parseMsgQuePool():
             # create pool entry
             if not IsAutoGenBuff:
                 if USE_MULTI_CORE == True:
-                    pools.append("  { 0x%x, %d, %d, 0x%x, %d, %d, %d, %d }, /* %s */\n" % (n_drm, n_size, n_num, h_drm, h_size, h_num, owner, spinlock, id))
+                    pools.append("  { 0x%x, %d, %d, 0x%x, %d, %d, %s, %s%s }, /* %s */\n" % (n_drm, n_size, n_num, h_drm, h_size, h_num, owner, spinlock, mode_str, id))
                 else:
-                    pools.append("  { 0x%x, %d, %d, 0x%x, %d, %d }, /* %s */\n" % (n_drm, n_size, n_num, h_drm, h_size, h_num, id))
+                    pools.append("  { 0x%x, %d, %d, 0x%x, %d, %d%s }, /* %s */\n" % (n_drm, n_size, n_num, h_drm, h_size, h_num, mode_str, id))
             else:
                 if USE_MULTI_CORE == True:
-                    pools.append("  { (drm_t)%s + 0x%x, %d, %d, 0x%x, %d, %d, %d, %d }, /* %s */\n" % (MsgBufferName, n_drm, n_size, n_num, h_drm, h_size, h_num, owner, spinlock, id))
+                    pools.append("  { (drm_t)%s + 0x%x, %d, %d, 0x%x, %d, %d, %s, %s%s }, /* %s */\n" % (MsgBufferName, n_drm, n_size, n_num, h_drm, h_size, h_num, owner, spinlock, mode_str, id))
                 else:
-                    pools.append("  { (drm_t)%s + 0x%x, %d, %d, 0x%x, %d, %d }, /* %s */\n" % (MsgBufferName, n_drm, n_size, n_num, h_drm, h_size, h_num, id))
+                    pools.append("  { (drm_t)%s + 0x%x, %d, %d, 0x%x, %d, %d%s }, /* %s */\n" % (MsgBufferName, n_drm, n_size, n_num, h_drm, h_size, h_num, mode_str, id))
 
             que_area_drm += QUE_BLOCK_SIZE
     return macros, pools, msg_area_drm
@@ -592,6 +620,9 @@ try:
     if not MsgParamTypeMatchCheck in [True, False]:
         raise ValueError("Bad MsgParamTypeMatchCheck.")
 
+    if not MsgTimestamp in [True, False]:
+        raise ValueError("Bad MsgTimestamp.")
+
 except Exception as e:
     die(e)
 except ValueError as e: